@@ -0,0 +1,396 @@
+#include "asset_query.h"
+
+#include "assets_model.h"
+#include "db.h"
+#include "tag_index.h"
+
+#include <QDate>
+#include <QDateTime>
+#include <QRegularExpression>
+
+namespace {
+
+struct Token {
+    QString text;
+    bool negated = false;
+    bool quoted = false;
+};
+
+// Splits on whitespace outside quotes; quotes are dropped, a leading '-' negates
+QVector<Token> tokenize(const QString& input)
+{
+    QVector<Token> tokens;
+    int i = 0;
+    const int n = input.size();
+    while (i < n) {
+        while (i < n && input[i].isSpace()) ++i;
+        if (i >= n) break;
+        Token t;
+        if (input[i] == u'-' && i + 1 < n && !input[i + 1].isSpace()) {
+            t.negated = true;
+            ++i;
+        }
+        bool inQuotes = false;
+        while (i < n && (inQuotes || !input[i].isSpace())) {
+            if (input[i] == u'"') {
+                inQuotes = !inQuotes;
+                t.quoted = true;
+            } else {
+                t.text.append(input[i]);
+            }
+            ++i;
+        }
+        tokens.append(t);
+    }
+    return tokens;
+}
+
+bool isAscii(const QString& s)
+{
+    for (QChar c : s) {
+        if (c.unicode() >= 0x80) return false;
+    }
+    return true;
+}
+
+// Strips a leading comparison from `value`; plain values compare for equality
+AssetQuery::Op takeOp(QString& value)
+{
+    static const struct { const char* text; AssetQuery::Op op; } ops[] = {
+        {">=", AssetQuery::Op::Ge}, {"<=", AssetQuery::Op::Le}, {"!=", AssetQuery::Op::Ne},
+        {">", AssetQuery::Op::Gt}, {"<", AssetQuery::Op::Lt}, {"=", AssetQuery::Op::Eq},
+    };
+    for (const auto& o : ops) {
+        if (value.startsWith(QLatin1String(o.text))) {
+            value = value.mid(int(qstrlen(o.text))).trimmed();
+            return o.op;
+        }
+    }
+    return AssetQuery::Op::Eq;
+}
+
+bool compareNumbers(qint64 a, AssetQuery::Op op, qint64 b)
+{
+    switch (op) {
+        case AssetQuery::Op::Eq: return a == b;
+        case AssetQuery::Op::Ne: return a != b;
+        case AssetQuery::Op::Lt: return a < b;
+        case AssetQuery::Op::Le: return a <= b;
+        case AssetQuery::Op::Gt: return a > b;
+        case AssetQuery::Op::Ge: return a >= b;
+    }
+    return false;
+}
+
+const char* sqlOp(AssetQuery::Op op)
+{
+    switch (op) {
+        case AssetQuery::Op::Eq: return "=";
+        case AssetQuery::Op::Ne: return "!=";
+        case AssetQuery::Op::Lt: return "<";
+        case AssetQuery::Op::Le: return "<=";
+        case AssetQuery::Op::Gt: return ">";
+        case AssetQuery::Op::Ge: return ">=";
+    }
+    return "=";
+}
+
+// "older than 7d" is "modified before now - 7d": the comparison flips
+AssetQuery::Op ageToTimeOp(AssetQuery::Op op)
+{
+    switch (op) {
+        case AssetQuery::Op::Lt: return AssetQuery::Op::Gt;
+        case AssetQuery::Op::Le: return AssetQuery::Op::Ge;
+        case AssetQuery::Op::Gt: return AssetQuery::Op::Lt;
+        case AssetQuery::Op::Ge: return AssetQuery::Op::Le;
+        case AssetQuery::Op::Ne: return AssetQuery::Op::Lt;
+        case AssetQuery::Op::Eq: return AssetQuery::Op::Ge; // "modified:7d" = within the last 7 days
+    }
+    return AssetQuery::Op::Ge;
+}
+
+bool parseSize(const QString& value, qint64* bytes)
+{
+    static const QRegularExpression re(QStringLiteral("^(\\d+(?:\\.\\d+)?)\\s*([kmgt]?)b?$"),
+                                       QRegularExpression::CaseInsensitiveOption);
+    const QRegularExpressionMatch m = re.match(value);
+    if (!m.hasMatch()) return false;
+    double v = m.captured(1).toDouble();
+    const QString unit = m.captured(2).toLower();
+    for (const char* u = "kmgt"; *u && !unit.isEmpty(); ++u) {
+        v *= 1024.0;
+        if (unit.at(0) == QLatin1Char(*u)) break;
+    }
+    *bytes = qint64(v);
+    return true;
+}
+
+bool parseAge(const QString& value, qint64* msecs)
+{
+    static const QRegularExpression re(QStringLiteral("^(\\d+)\\s*([hdwmy])$"), QRegularExpression::CaseInsensitiveOption);
+    const QRegularExpressionMatch m = re.match(value);
+    if (!m.hasMatch()) return false;
+    const qint64 hour = 3600 * 1000;
+    const QChar unit = m.captured(2).toLower().at(0);
+    const qint64 per = unit == u'h' ? hour : unit == u'd' ? 24 * hour : unit == u'w' ? 7 * 24 * hour
+                     : unit == u'm' ? 30 * 24 * hour : 365 * 24 * hour;
+    *msecs = m.captured(1).toLongLong() * per;
+    return true;
+}
+
+QString fileExtension(const QString& fileName)
+{
+    const int dot = fileName.lastIndexOf(u'.');
+    return dot >= 0 ? fileName.mid(dot + 1).toLower() : QString();
+}
+
+QString likeContains(const QString& text)
+{
+    QString escaped = text;
+    escaped.replace(QLatin1Char('\\'), QLatin1String("\\\\"));
+    escaped.replace(QLatin1Char('%'), QLatin1String("\\%"));
+    escaped.replace(QLatin1Char('_'), QLatin1String("\\_"));
+    return QLatin1Char('%') + escaped + QLatin1Char('%');
+}
+
+// Columns read back through COALESCE(col, 0) count NULL as 0; when 0 itself passes the
+// comparison the NULL rows have to pass in SQL too, which costs the index
+QString numericSql(const QString& column, AssetQuery::Op op, qint64 value, QVariantList* binds)
+{
+    binds->append(value);
+    if (compareNumbers(0, op, value)) return QString("MAX(COALESCE(%1,0),0) %2 ?").arg(column, QLatin1String(sqlOp(op)));
+    return QString("%1 %2 ?").arg(column, QLatin1String(sqlOp(op)));
+}
+
+} // namespace
+
+AssetQuery AssetQuery::parse(const QString& text, QString* errorOut)
+{
+    static const QHash<QString, Field> fields = {
+        {"ext", Field::Ext}, {"name", Field::Name}, {"path", Field::Path}, {"tag", Field::Tag},
+        {"rating", Field::Rating}, {"size", Field::Size}, {"frames", Field::Frames}, {"modified", Field::Modified},
+    };
+    auto fail = [errorOut](const QString& message) {
+        if (errorOut && errorOut->isEmpty()) *errorOut = message;
+    };
+
+    AssetQuery query;
+    bool joinNext = false;
+    for (const Token& token : tokenize(text)) {
+        if (token.text == QLatin1String("OR") && !token.quoted && !token.negated) {
+            joinNext = !query.m_clauses.isEmpty();
+            continue;
+        }
+
+        if (token.text.isEmpty()) continue;
+
+        Predicate p;
+        p.negated = token.negated;
+        p.field = Field::Text;
+        p.text = token.text;
+
+        const int colon = token.text.indexOf(u':');
+        const auto field = colon > 0 ? fields.constFind(token.text.left(colon).toLower()) : fields.constEnd();
+        if (field != fields.constEnd()) {
+            QString value = token.text.mid(colon + 1).trimmed();
+            // Still being typed ("tag:"): ignore rather than match nothing
+            if (value.isEmpty()) continue;
+            const Field f = field.value();
+            bool ok = true;
+            switch (f) {
+                case Field::Ext:
+                    for (const QString& e : value.split(u',', Qt::SkipEmptyParts)) {
+                        p.values.append(e.startsWith(u'.') ? e.mid(1).toLower() : e.toLower());
+                    }
+                    ok = !p.values.isEmpty();
+                    break;
+                case Field::Name:
+                case Field::Tag:
+                    p.text = value;
+                    break;
+                case Field::Path:
+                    p.text = QString(value).replace(u'\\', u'/');
+                    p.prefix = p.text.startsWith(u'/')
+                               || (p.text.size() >= 3 && p.text[0].isLetter() && p.text[1] == u':' && p.text[2] == u'/');
+                    break;
+                case Field::Rating:
+                case Field::Frames:
+                    p.op = takeOp(value);
+                    p.number = value.toLongLong(&ok);
+                    if (ok && f == Field::Rating && (p.number < 0 || p.number > 5)) ok = false;
+                    break;
+                case Field::Size:
+                    p.op = takeOp(value);
+                    ok = parseSize(value, &p.number);
+                    break;
+                case Field::Modified: {
+                    p.op = takeOp(value);
+                    qint64 age = 0;
+                    const QDate date = QDate::fromString(value, Qt::ISODate);
+                    if (parseAge(value, &age)) {
+                        p.number = QDateTime::currentMSecsSinceEpoch() - age;
+                        p.op = ageToTimeOp(p.op);
+                    } else if (date.isValid()) {
+                        p.number = date.toJulianDay();
+                        p.dayOnly = true;
+                    } else {
+                        ok = false;
+                    }
+                    break;
+                }
+                case Field::Text:
+                    break;
+            }
+            if (ok) {
+                p.field = f;
+            } else {
+                fail(QString("Could not read \"%1\"; searching for it as text").arg(token.text));
+                p = Predicate();
+                p.negated = token.negated;
+                p.text = token.text;
+            }
+        }
+
+        if (joinNext) query.m_clauses.last().append(p);
+        else query.m_clauses.append(Clause{p});
+        joinNext = false;
+    }
+    return query;
+}
+
+bool AssetQuery::hasTagTerms() const
+{
+    for (const Clause& clause : m_clauses) {
+        for (const Predicate& p : clause) {
+            if (p.field == Field::Tag) return true;
+        }
+    }
+    return false;
+}
+
+QString AssetQuery::sqlWhere(QVariantList* binds) const
+{
+    QStringList conjuncts;
+    QVariantList allBinds;
+    for (const Clause& clause : m_clauses) {
+        QStringList alternatives;
+        QVariantList clauseBinds;
+        bool pushable = true;
+        for (const Predicate& p : clause) {
+            // A negated term that is looser in SQL than in memory would drop rows; only
+            // positive terms go down, the rest is left to matches()
+            if (p.negated) { pushable = false; break; }
+            switch (p.field) {
+                case Field::Ext: {
+                    // SQLite lower() folds ASCII only
+                    if (!isAscii(p.values.join(QString()))) { pushable = false; break; }
+                    QStringList marks;
+                    for (const QString& e : p.values) { marks << "?"; clauseBinds << e; }
+                    alternatives << QString("%1 IN (%2)").arg(DB::fileExtensionExpr(), marks.join(','));
+                    break;
+                }
+                case Field::Text:
+                case Field::Name:
+                case Field::Path:
+                    // LIKE and NOCASE fold ASCII only; other text is matched in memory
+                    if (!isAscii(p.text)) { pushable = false; break; }
+                    if (p.field == Field::Path && p.prefix) {
+                        // Range scan over idx_assets_file_path_nocase
+                        const QString low = p.text.toLower();
+                        QString high = low;
+                        high[high.size() - 1] = QChar(high.at(high.size() - 1).unicode() + 1);
+                        alternatives << "(file_path >= ? COLLATE NOCASE AND file_path < ? COLLATE NOCASE)";
+                        clauseBinds << low << high;
+                    } else if (p.field == Field::Path) {
+                        alternatives << "file_path LIKE ? ESCAPE '\\'";
+                        clauseBinds << likeContains(p.text);
+                    } else if (p.field == Field::Name) {
+                        alternatives << "file_name LIKE ? ESCAPE '\\'";
+                        clauseBinds << likeContains(p.text);
+                    } else {
+                        alternatives << "(file_name LIKE ? ESCAPE '\\' OR file_path LIKE ? ESCAPE '\\')";
+                        clauseBinds << likeContains(p.text) << likeContains(p.text);
+                    }
+                    break;
+                case Field::Tag:
+                    alternatives << "id IN (SELECT asset_id FROM asset_tags WHERE tag_id IN (SELECT id FROM tags WHERE name = ?))";
+                    clauseBinds << p.text;
+                    break;
+                case Field::Rating:
+                    alternatives << numericSql("rating", p.op, p.number, &clauseBinds);
+                    break;
+                case Field::Size:
+                    alternatives << numericSql("file_size", p.op, p.number, &clauseBinds);
+                    break;
+                case Field::Frames:
+                    // is_sequence=1 lets SQLite use the partial idx_assets_sequence_frames
+                    alternatives << "(is_sequence=1 AND " + numericSql("sequence_frame_count", p.op, p.number, &clauseBinds) + ")";
+                    break;
+                case Field::Modified:
+                    // Filesystem time, only known once the row is loaded
+                    pushable = false;
+                    break;
+            }
+            if (!pushable) break;
+        }
+        if (!pushable || alternatives.isEmpty()) continue;
+        conjuncts << (alternatives.size() == 1 ? alternatives.first() : "(" + alternatives.join(" OR ") + ")");
+        allBinds << clauseBinds;
+    }
+    if (binds) *binds << allBinds;
+    return conjuncts.join(" AND ");
+}
+
+void AssetQuery::resolveTags(const TagIndex& index)
+{
+    m_tagAssets.clear();
+    for (const Clause& clause : m_clauses) {
+        for (const Predicate& p : clause) {
+            if (p.field != Field::Tag || m_tagAssets.contains(p.text)) continue;
+            const int id = index.tagId(p.text);
+            m_tagAssets.insert(p.text, id < 0 ? RoaringBitmap() : index.assetsWithTag(id));
+        }
+    }
+}
+
+bool AssetQuery::matches(const AssetRow& row) const
+{
+    for (const Clause& clause : m_clauses) {
+        bool any = false;
+        for (const Predicate& p : clause) {
+            if (matches(p, row) != p.negated) { any = true; break; }
+        }
+        if (!any) return false;
+    }
+    return true;
+}
+
+bool AssetQuery::matches(const Predicate& p, const AssetRow& row) const
+{
+    const Qt::CaseSensitivity cs = Qt::CaseInsensitive;
+    switch (p.field) {
+        case Field::Text:
+            return row.fileName.contains(p.text, cs) || row.filePath.contains(p.text, cs);
+        case Field::Name:
+            return row.fileName.contains(p.text, cs);
+        case Field::Path:
+            return p.prefix ? row.filePath.startsWith(p.text, cs) : row.filePath.contains(p.text, cs);
+        case Field::Ext:
+            return p.values.contains(fileExtension(row.fileName));
+        case Field::Tag: {
+            const auto it = m_tagAssets.constFind(p.text);
+            return it != m_tagAssets.constEnd() && it->contains(quint32(row.id));
+        }
+        case Field::Rating:
+            return compareNumbers(qMax(0, row.rating), p.op, p.number);
+        case Field::Size:
+            return compareNumbers(row.fileSize, p.op, p.number);
+        case Field::Frames:
+            return row.isSequence && compareNumbers(row.sequenceFrameCount, p.op, p.number);
+        case Field::Modified:
+            if (!row.lastModified.isValid()) return false;
+            if (p.dayOnly) return compareNumbers(row.lastModified.date().toJulianDay(), p.op, p.number);
+            return compareNumbers(row.lastModified.toMSecsSinceEpoch(), p.op, p.number);
+    }
+    return false;
+}
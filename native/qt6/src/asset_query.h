@@ -0,0 +1,77 @@
+#pragma once
+#include <QHash>
+#include <QString>
+#include <QStringList>
+#include <QVariantList>
+#include <QVector>
+
+#include "roaring_bitmap.h"
+
+struct AssetRow;
+class TagIndex;
+
+/**
+ * AssetQuery - the search box language for assets
+ *
+ * Space-separated terms that must all match; "OR" between terms makes them
+ * alternatives and a leading '-' negates a term. Field terms:
+ *
+ *   ext:exr,dpx      extension (comma = any of)
+ *   name:plate       file name contains
+ *   path:/shows/abc  path starts with (absolute) or contains (relative)
+ *   tag:hero         carries the tag
+ *   rating:>=4       stars, 0 = unrated
+ *   size:>2GB        bytes, with B/KB/MB/GB/TB (1024-based)
+ *   frames:>100      sequences with that many frames
+ *   modified:<7d     age in h/d/w/m/y, or a yyyy-MM-dd date
+ *
+ * Comparisons are =, !=, <, <=, >, >= (default =). Anything else, including
+ * unknown fields and malformed values, is plain text matched against the file
+ * name and path. Quotes keep spaces: tag:"hero shot".
+ *
+ * sqlWhere() compiles the clauses SQLite can answer from indexed columns into a
+ * pre-filter over `assets`; matches() is the exact test and is applied to
+ * whatever that returns, so the SQL part may only ever be looser than matches().
+ */
+class AssetQuery {
+public:
+    enum class Field { Text, Name, Path, Ext, Tag, Rating, Size, Frames, Modified };
+    enum class Op { Eq, Ne, Lt, Le, Gt, Ge };
+
+    struct Predicate {
+        Field field = Field::Text;
+        Op op = Op::Eq;
+        bool negated = false;
+        QString text;        // Text/Name/Path/Tag; lower-case for Ext
+        QStringList values;  // Ext alternatives
+        qint64 number = 0;   // Rating/Size/Frames; msecs since epoch for Modified
+        bool prefix = false; // Path: absolute, match from the start
+        bool dayOnly = false; // Modified: compared by calendar date
+    };
+    // Predicates of a clause are OR-ed, clauses are AND-ed
+    using Clause = QVector<Predicate>;
+
+    AssetQuery() = default;
+    // Never fails; terms that do not parse become text terms and are reported
+    // through `errorOut` (first problem only) when given
+    static AssetQuery parse(const QString& text, QString* errorOut = nullptr);
+
+    bool isEmpty() const { return m_clauses.isEmpty(); }
+    const QVector<Clause>& clauses() const { return m_clauses; }
+    bool hasTagTerms() const;
+
+    // WHERE expression over `assets` (no leading WHERE) with `?` placeholders
+    // appended to `binds`; empty when no clause can be pushed down
+    QString sqlWhere(QVariantList* binds) const;
+
+    // Looks up the assets of every tag term; call before matches() and again
+    // whenever tag assignments change
+    void resolveTags(const TagIndex& index);
+    bool matches(const AssetRow& row) const;
+
+private:
+    bool matches(const Predicate& p, const AssetRow& row) const;
+
+    QVector<Clause> m_clauses;
+    QHash<QString, RoaringBitmap> m_tagAssets;
+};
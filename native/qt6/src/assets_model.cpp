@@ -2,6 +2,7 @@
 #include "db.h"
 #include "progress_manager.h"
 #include "log_manager.h"
+#include "tag_index.h"
 #include <QSet>
 #include <QRegularExpression>
 #include <QSqlQuery>
@@ -15,9 +16,11 @@
 #include <QMimeData>
 #include <QFile>
 #include <QTextStream>
+#include <algorithm>
 
 #include "file_utils.h"
 #include "sequence_detector.h"
+#include "natural_sort.h"
 
 static QStringList buildSequencePaths(const QString& firstFramePath, int startFrame, int endFrame)
 {
@@ -54,12 +57,13 @@ static QStringList buildSequencePaths(const QString& firstFramePath, int startFr
 
 namespace {
 
+// Suffixes are stored lower-case (AssetRow::fileType), so no per-call toLower()
 bool isImageExtension(const QString& suffix) {
     static const QSet<QString> extensions = {
         "png","jpg","jpeg","bmp","tga","tif","tiff","gif","webp",
         "ico","heic","heif","avif","psd","svg","dds"
     };
-    return extensions.contains(suffix.toLower());
+    return extensions.contains(suffix);
 }
 
 bool isVideoExtension(const QString& suffix) {
@@ -67,7 +71,34 @@ bool isVideoExtension(const QString& suffix) {
         "mp4","mov","m4v","mkv","avi","mpg","mpeg","mp2","mpg2",
         "wmv","flv","webm","mxf","r3d","ogv","mts","m2ts"
     };
-    return extensions.contains(suffix.toLower());
+    return extensions.contains(suffix);
+}
+
+// Above this many separate insert/remove runs a reset is cheaper for the views
+constexpr int kMaxIncrementalRuns = 128;
+
+// Walks two ascending row lists and reports each run of rows to remove from or insert
+// into `from` to turn it into `to`. `pos` is the view row the run starts at once the
+// earlier runs have been applied; `first`/`count` index into `from` (remove) or `to` (insert).
+template <typename Fn>
+void forEachChangeRun(const QVector<int>& from, const QVector<int>& to, Fn&& fn) {
+    const int fromSize = from.size();
+    const int toSize = to.size();
+    int i = 0, j = 0, pos = 0;
+    while (i < fromSize || j < toSize) {
+        if (i < fromSize && j < toSize && from[i] == to[j]) {
+            ++i; ++j; ++pos;
+        } else if (j >= toSize || (i < fromSize && from[i] < to[j])) {
+            const int first = i;
+            while (i < fromSize && (j >= toSize || from[i] < to[j])) ++i;
+            fn(false, pos, first, i - first);
+        } else {
+            const int first = j;
+            while (j < toSize && (i >= fromSize || to[j] < from[i])) ++j;
+            fn(true, pos, first, j - first);
+            pos += j - first;
+        }
+    }
 }
 
 bool looksLikeSequence(const QString& filePath) {
@@ -86,6 +117,7 @@ AssetsModel::AssetsModel(QObject* parent): QAbstractListModel(parent){
     connect(&m_reloadTimer, &QTimer::timeout, this, &AssetsModel::triggerDebouncedReload);
 
     connect(&DB::instance(), &DB::assetsChanged, this, &AssetsModel::onAssetsChangedForFolder);
+    connect(&TagIndex::instance(), &TagIndex::changed, this, &AssetsModel::onTagIndexChanged);
 
     rebuildFilter();
 }
@@ -114,7 +146,7 @@ QVariant AssetsModel::data(const QModelIndex& idx, int role) const{
             QVariantMap preview;
             preview["filePath"] = r.filePath;
             preview["fileType"] = r.fileType;
-            preview["isVideo"] = isVideoExtension(r.fileType);
+            preview["isVideo"] = r.typeClass == VideoClass;
             preview["isSequence"] = r.isSequence;
             preview["sequencePattern"] = r.sequencePattern;
             preview["sequenceStart"] = r.sequenceStartFrame;
@@ -243,50 +275,69 @@ void AssetsModel::setSearchQuery(const QString& query) {
     QString normalized = query;
     if (normalized == m_searchQuery)
         return;
+    const bool wasGlobal = globalScope();
     m_searchQuery = normalized;
-    // Reload; scope (folder vs global) is controlled by m_searchEntireDatabase
-    reload();
+    QString parseError;
+    m_query = AssetQuery::parse(m_searchQuery, &parseError);
+    if (!parseError.isEmpty()) qDebug() << "[AssetsModel] Search:" << parseError;
+    // Folder scope filters the loaded rows in memory. Across the whole catalog the
+    // indexed part of the query picks the rows to load, so a change there needs new rows
+    bool needsReload = globalScope() != wasGlobal;
+    if (!needsReload && globalScope()) {
+        QVariantList binds;
+        needsReload = m_query.sqlWhere(&binds) != m_pushedWhere || binds != m_pushedBinds;
+    }
+    if (needsReload) {
+        reload();
+    } else {
+        markFilterDirty(SearchDimension);
+        performFilterUpdate();
+    }
     emit searchQueryChanged();
 }
 
 void AssetsModel::setTypeFilter(int f) {
     if (m_typeFilter == f) return;
     m_typeFilter = f;
-    scheduleFilterReset();
+    markFilterDirty(TypeDimension);
+    scheduleFilterUpdate();
     emit typeFilterChanged();
 }
 
 void AssetsModel::setRatingFilter(int f) {
     if (m_ratingFilter == f) return;
     m_ratingFilter = f;
-    scheduleFilterReset();
+    markFilterDirty(RatingDimension);
+    scheduleFilterUpdate();
 }
 
 void AssetsModel::setSelectedTagNames(const QStringList& tags) {
     if (m_selectedTagNames == tags) return;
     m_selectedTagNames = tags;
     // Changing tag selection may require loading assets across folders
-    scheduleFilterReset();
+    markFilterDirty(TagDimension);
+    scheduleFilterUpdate();
     emit selectedTagNamesChanged();
 }
 
 void AssetsModel::setTagFilterMode(int mode) {
     if (m_tagFilterMode == mode) return;
     m_tagFilterMode = mode;
-    scheduleFilterReset();
+    markFilterDirty(TagDimension);
+    scheduleFilterUpdate();
     emit tagFilterModeChanged();
 }
 
 
 void AssetsModel::setFilters(int typeFilter, int ratingFilter, const QStringList& tagNames, int tagMode) {
     bool anyChanged = false;
-    if (m_typeFilter != typeFilter) { m_typeFilter = typeFilter; anyChanged = true; emit typeFilterChanged(); }
-    if (m_ratingFilter != ratingFilter) { m_ratingFilter = ratingFilter; anyChanged = true; }
-    if (m_selectedTagNames != tagNames) { m_selectedTagNames = tagNames; anyChanged = true; emit selectedTagNamesChanged(); }
-    if (m_tagFilterMode != tagMode) { m_tagFilterMode = tagMode; anyChanged = true; emit tagFilterModeChanged(); }
+    if (m_typeFilter != typeFilter) { m_typeFilter = typeFilter; markFilterDirty(TypeDimension); anyChanged = true; emit typeFilterChanged(); }
+    if (m_ratingFilter != ratingFilter) { m_ratingFilter = ratingFilter; markFilterDirty(RatingDimension); anyChanged = true; }
+    if (m_selectedTagNames != tagNames) { m_selectedTagNames = tagNames; markFilterDirty(TagDimension); anyChanged = true; emit selectedTagNamesChanged(); }
+    if (m_tagFilterMode != tagMode) { m_tagFilterMode = tagMode; markFilterDirty(TagDimension); anyChanged = true; emit tagFilterModeChanged(); }
     if (!anyChanged) return;
-    // Apply a single reset for all filter changes
-    performFilterReset();
+    // Apply all filter changes in one update
+    performFilterUpdate();
 }
 
 void AssetsModel::setRecursiveMode(bool recursive) {
@@ -310,6 +361,7 @@ void AssetsModel::reload(){
     beginResetModel();
 
     query();
+    buildRowBitsets();
 
     rebuildFilter();
 
@@ -321,13 +373,20 @@ void AssetsModel::reload(){
 
 void AssetsModel::query(){
     m_rows.clear();
-
-    const bool globalScope = !m_selectedTagNames.isEmpty() || (m_searchEntireDatabase && !m_searchQuery.trimmed().isEmpty());
+    m_pushedWhere.clear();
+    m_pushedBinds.clear();
 
     QSqlQuery q(DB::instance().database());
-    if (globalScope) {
-        LogManager::instance().addLog("DB query (all assets) started", "DEBUG");
-        q.prepare("SELECT id,file_name,file_path,file_size,COALESCE(rating,-1),virtual_folder_id,COALESCE(is_sequence,0),sequence_pattern,sequence_start_frame,sequence_end_frame,sequence_frame_count,COALESCE(sequence_has_gaps,0),COALESCE(sequence_gap_count,0),sequence_version FROM assets ORDER BY file_name");
+    if (globalScope()) {
+        // Let SQLite narrow the catalog with whatever the search can say through its
+        // indexes; the search mask then applies the full query to what comes back
+        m_pushedWhere = m_query.sqlWhere(&m_pushedBinds);
+        QString sql = "SELECT id,file_name,file_path,file_size,COALESCE(rating,-1),virtual_folder_id,COALESCE(is_sequence,0),sequence_pattern,sequence_start_frame,sequence_end_frame,sequence_frame_count,COALESCE(sequence_has_gaps,0),COALESCE(sequence_gap_count,0),sequence_version FROM assets";
+        if (!m_pushedWhere.isEmpty()) sql += " WHERE " + m_pushedWhere;
+        q.prepare(sql + " ORDER BY " + DB::instance().fileNameOrderBy());
+        for (const QVariant& v : m_pushedBinds) q.addBindValue(v);
+        LogManager::instance().addLog(m_pushedWhere.isEmpty() ? QString("DB query (all assets) started")
+                                                              : QString("DB query (assets where %1) started").arg(m_pushedWhere), "DEBUG");
     } else {
         if (m_folderId<=0) {
             m_filteredRowIndexes.clear();
@@ -347,14 +406,14 @@ void AssetsModel::query(){
             for (int i = 0; i < assetIds.size(); ++i) marks << "?";
             const QString placeholders = marks.join(',');
 
-            q.prepare(QString("SELECT id,file_name,file_path,file_size,COALESCE(rating,-1),virtual_folder_id,COALESCE(is_sequence,0),sequence_pattern,sequence_start_frame,sequence_end_frame,sequence_frame_count,COALESCE(sequence_has_gaps,0),COALESCE(sequence_gap_count,0),sequence_version FROM assets WHERE id IN (%1) ORDER BY file_name").arg(placeholders));
+            q.prepare(QString("SELECT id,file_name,file_path,file_size,COALESCE(rating,-1),virtual_folder_id,COALESCE(is_sequence,0),sequence_pattern,sequence_start_frame,sequence_end_frame,sequence_frame_count,COALESCE(sequence_has_gaps,0),COALESCE(sequence_gap_count,0),sequence_version FROM assets WHERE id IN (%1) ORDER BY %2").arg(placeholders, DB::instance().fileNameOrderBy()));
             LogManager::instance().addLog(QString("DB query (assets by folder %1, recursive) started - %2 assets").arg(m_folderId).arg(assetIds.size()), "DEBUG");
             for (int assetId : assetIds) {
                 q.addBindValue(assetId);
             }
         } else {
             // Non-recursive: just get assets in this folder
-            q.prepare("SELECT id,file_name,file_path,file_size,COALESCE(rating,-1),virtual_folder_id,COALESCE(is_sequence,0),sequence_pattern,sequence_start_frame,sequence_end_frame,sequence_frame_count,COALESCE(sequence_has_gaps,0),COALESCE(sequence_gap_count,0),sequence_version FROM assets WHERE virtual_folder_id=? ORDER BY file_name");
+            q.prepare("SELECT id,file_name,file_path,file_size,COALESCE(rating,-1),virtual_folder_id,COALESCE(is_sequence,0),sequence_pattern,sequence_start_frame,sequence_end_frame,sequence_frame_count,COALESCE(sequence_has_gaps,0),COALESCE(sequence_gap_count,0),sequence_version FROM assets WHERE virtual_folder_id=? ORDER BY " + DB::instance().fileNameOrderBy());
             LogManager::instance().addLog(QString("DB query (assets by folder %1) started").arg(m_folderId), "DEBUG");
             q.addBindValue(m_folderId);
         }
@@ -384,7 +443,9 @@ void AssetsModel::query(){
         QFileInfo fi(r.filePath);
         const bool exists = fi.exists();
         r.fileType = exists ? fi.suffix().toLower() : QString();
+        r.typeClass = isImageExtension(r.fileType) ? ImageClass : isVideoExtension(r.fileType) ? VideoClass : OtherClass;
         r.lastModified = exists ? fi.lastModified() : QDateTime();
+        r.nameKey = NaturalSort::key(r.fileName);
         m_rows.push_back(r);
         ++rows;
     }
@@ -410,71 +471,228 @@ bool AssetsModel::assignTags(const QVariantList& assetIds, const QVariantList& t
     return ok;
 }
 
-void AssetsModel::rebuildFilter() {
-    m_filteredRowIndexes.clear();
-    m_filteredRowIndexes.reserve(m_rows.size());
-
-    // Pre-fetch tags map to avoid N+1 queries when tag filtering is active
-    if (!m_selectedTagNames.isEmpty()) {
-        QList<int> ids; ids.reserve(m_rows.size());
-        for (const auto& r : m_rows) ids << r.id;
-        m_prefetchedTags = DB::instance().tagsForAssets(ids);
-    } else {
-        m_prefetchedTags.clear();
+void AssetsModel::onTagIndexChanged() {
+    updateTagFacet();
+    emit facetCountsChanged();
+    // Rows loaded through a pushed-down tag: term may no longer be the right ones
+    if (globalScope() && m_query.hasTagTerms()) {
+        scheduleReload();
+        return;
     }
+    // Only the tag-dependent masks change with assignments; other dimensions stay as they are
+    bool dirty = false;
+    if (!m_selectedTagNames.isEmpty()) { markFilterDirty(TagDimension); dirty = true; }
+    if (m_query.hasTagTerms()) { markFilterDirty(SearchDimension); dirty = true; }
+    if (dirty) scheduleFilterUpdate();
+}
 
+bool AssetsModel::globalScope() const {
+    return !m_selectedTagNames.isEmpty() || (m_searchEntireDatabase && !m_searchQuery.trimmed().isEmpty());
+}
 
-    for (int i = 0; i < m_rows.size(); ++i) {
-        if (matchesFilter(m_rows[i])) {
-            m_filteredRowIndexes.append(i);
+void AssetsModel::buildRowBitsets() {
+    const int n = m_rows.size();
+    for (auto& bits : m_typeClassBits) bits.resize(n);
+    for (auto& bits : m_ratingBits) bits.resize(n);
+    m_extensionBits.clear();
+    m_sequenceBits.resize(n);
+    m_scopeIds.clear();
+    m_rowOfId.clear();
+    m_rowOfId.reserve(n);
+    for (int i = 0; i < n; ++i) {
+        const AssetRow& row = m_rows[i];
+        m_typeClassBits[row.typeClass].set(i);
+        m_ratingBits[qBound(0, row.rating, 5)].set(i);
+        if (!row.fileType.isEmpty()) {
+            FilterBitset& ext = m_extensionBits[row.fileType];
+            if (ext.size() != n) ext.resize(n);
+            ext.set(i);
         }
+        if (row.isSequence) m_sequenceBits.set(i);
+        m_scopeIds.add(quint32(row.id));
+        m_rowOfId.insert(row.id, i);
     }
+    // New rows: every dimension is stale
+    m_dirtyDimensions = ~0u;
 }
 
-bool AssetsModel::matchesFilter(const AssetRow& row) const {
-    if (m_typeFilter == Images) {
-        if (!isImageExtension(row.fileType)) return false;
-    } else if (m_typeFilter == Videos) {
-        if (!isVideoExtension(row.fileType)) return false;
+void AssetsModel::rebuildDimension(FilterDimension dimension) {
+    const int n = m_rows.size();
+    FilterBitset& bits = m_dimensionBits[dimension];
+    switch (dimension) {
+    case TypeDimension:
+        if (m_typeFilter == Images) bits = m_typeClassBits[ImageClass];
+        else if (m_typeFilter == Videos) bits = m_typeClassBits[VideoClass];
+        else bits.resize(n, true);
+        break;
+    case RatingDimension:
+        // Rating buckets OR'd together; "unrated" covers -1 and 0
+        if (m_ratingFilter == FiveStars || m_ratingFilter == FourPlusStars || m_ratingFilter == ThreePlusStars) {
+            bits = m_ratingBits[5];
+            if (m_ratingFilter != FiveStars) bits |= m_ratingBits[4];
+            if (m_ratingFilter == ThreePlusStars) bits |= m_ratingBits[3];
+        } else if (m_ratingFilter == Unrated) {
+            bits = m_ratingBits[0];
+        } else {
+            bits.resize(n, true);
+        }
+        break;
+    case TagDimension: {
+        if (m_selectedTagNames.isEmpty()) {
+            bits.resize(n, true);
+            break;
+        }
+        // Resolve names once, then intersect the per-tag asset bitmaps with this scope
+        const TagIndex& index = TagIndex::instance();
+        QList<int> tagIds;
+        bool unknownTag = false;
+        for (const QString& name : m_selectedTagNames) {
+            const int id = index.tagId(name);
+            if (id < 0) unknownTag = true;
+            else tagIds << id;
+        }
+        bits.resize(n, false);
+        // AND with a tag nobody has matches nothing; OR just skips it
+        if ((m_tagFilterMode == And && unknownTag) || tagIds.isEmpty()) break;
+        const RoaringBitmap matched = m_tagFilterMode == And ? index.match(m_scopeIds, tagIds, {})
+                                                             : index.match(m_scopeIds, {}, tagIds);
+        matched.forEach([&](quint32 id) { bits.set(m_rowOfId.value(int(id))); });
+        break;
     }
-
-    if (m_ratingFilter == FiveStars) {
-        if (row.rating != 5) return false;
-    } else if (m_ratingFilter == FourPlusStars) {
-        if (row.rating < 4) return false;
-    } else if (m_ratingFilter == ThreePlusStars) {
-        if (row.rating < 3) return false;
-    } else if (m_ratingFilter == Unrated) {
-        if (row.rating > 0) return false;
+    case SearchDimension: {
+        if (m_query.isEmpty()) {
+            bits.resize(n, true);
+            break;
+        }
+        bits.resize(n, false);
+        m_query.resolveTags(TagIndex::instance());
+        for (int i = 0; i < n; ++i) {
+            if (m_query.matches(m_rows[i])) bits.set(i);
+        }
+        break;
     }
+    case DimensionCount:
+        break;
+    }
+}
 
-    if (!m_selectedTagNames.isEmpty()) {
-        const QStringList assetTags = m_prefetchedTags.value(row.id);
-        bool hasAnyTag = false;
-        bool hasAllTags = true;
-        for (const QString& selectedTag : m_selectedTagNames) {
-            const bool assetHasTag = assetTags.contains(selectedTag);
-            if (assetHasTag) {
-                hasAnyTag = true;
-            } else {
-                hasAllTags = false;
-            }
-        }
-        if (m_tagFilterMode == And) {
-            if (!hasAllTags) return false;
-        } else {
-            if (!hasAnyTag) return false;
+QVector<int> AssetsModel::computeVisibleRows() {
+    quint32 rebuilt = 0;
+    for (int d = 0; d < DimensionCount; ++d) {
+        if ((m_dirtyDimensions & (1u << d)) || m_dimensionBits[d].size() != m_rows.size()) {
+            rebuildDimension(FilterDimension(d));
+            rebuilt |= 1u << d;
         }
     }
+    m_dirtyDimensions = 0;
+
+    FilterBitset visible = m_dimensionBits[TypeDimension];
+    for (int d = TypeDimension + 1; d < DimensionCount; ++d) visible &= m_dimensionBits[d];
+    if (rebuilt) updateFacets(rebuilt, visible);
+    return visible.indexes();
+}
+
+FilterBitset AssetsModel::facetBase(FilterDimension except) const {
+    FilterBitset base(m_rows.size(), true);
+    for (int d = 0; d < DimensionCount; ++d) {
+        if (d != except) base &= m_dimensionBits[d];
+    }
+    return base;
+}
+
+void AssetsModel::updateFacets(quint32 rebuiltDimensions, const FilterBitset& visible) {
+    // A facet only moves when a dimension other than its own was rebuilt
+    auto stale = [rebuiltDimensions](FilterDimension own) { return (rebuiltDimensions & ~(1u << own)) != 0; };
+    if (stale(RatingDimension)) {
+        const FilterBitset base = facetBase(RatingDimension);
+        for (int r = 0; r < 6; ++r) m_facets.ratings[r] = m_ratingBits[r].andCount(base);
+    }
+    if (stale(TypeDimension)) {
+        const FilterBitset base = facetBase(TypeDimension);
+        m_facets.images = m_typeClassBits[ImageClass].andCount(base);
+        m_facets.videos = m_typeClassBits[VideoClass].andCount(base);
+        m_facets.others = m_typeClassBits[OtherClass].andCount(base);
+    }
+    if (stale(TagDimension)) updateTagFacet();
+
+    m_facets.extensions.clear();
+    for (auto it = m_extensionBits.constBegin(); it != m_extensionBits.constEnd(); ++it) {
+        const int n = it->andCount(visible);
+        if (n > 0) m_facets.extensions.insert(it.key(), n);
+    }
+    m_facets.sequences = m_sequenceBits.andCount(visible);
+    m_facets.singles = visible.count() - m_facets.sequences;
+    emit facetCountsChanged();
+}
+
+void AssetsModel::updateTagFacet() {
+    if (m_dimensionBits[TypeDimension].size() != m_rows.size()) return; // filter not built yet
+    const FilterBitset base = facetBase(TagDimension);
+    if (base.isAllSet()) {
+        m_facets.tags = TagIndex::instance().countsWithin(m_scopeIds);
+        return;
+    }
+    RoaringBitmap ids;
+    for (int i : base.indexes()) ids.add(quint32(m_rows[i].id));
+    m_facets.tags = TagIndex::instance().countsWithin(ids);
+}
+
+QVariantMap AssetsModel::facetCountsMap() const {
+    QVariantList ratings;
+    for (int n : m_facets.ratings) ratings << n;
+    QVariantMap extensions;
+    for (auto it = m_facets.extensions.constBegin(); it != m_facets.extensions.constEnd(); ++it)
+        extensions.insert(it.key(), it.value());
+    QVariantMap tags;
+    for (auto it = m_facets.tags.constBegin(); it != m_facets.tags.constEnd(); ++it)
+        tags.insert(QString::number(it.key()), it.value());
+    QVariantMap map;
+    map.insert("ratings", ratings);
+    map.insert("images", m_facets.images);
+    map.insert("videos", m_facets.videos);
+    map.insert("others", m_facets.others);
+    map.insert("extensions", extensions);
+    map.insert("tags", tags);
+    map.insert("sequences", m_facets.sequences);
+    map.insert("singles", m_facets.singles);
+    return map;
+}
+
+void AssetsModel::rebuildFilter() {
+    m_filteredRowIndexes = computeVisibleRows();
+}
+
+void AssetsModel::applyVisibleRows(const QVector<int>& next) {
+    if (m_isResetting) {
+        m_filteredRowIndexes = next;
+        return;
+    }
+    int runs = 0;
+    forEachChangeRun(m_filteredRowIndexes, next, [&runs](bool, int, int, int) { ++runs; });
+    if (runs == 0) return;
+    if (runs > kMaxIncrementalRuns) {
+        m_isResetting = true;
+        beginResetModel();
+        m_filteredRowIndexes = next;
+        endResetModel();
+        m_isResetting = false;
+        return;
+    }
 
-    const QString needle = m_searchQuery.trimmed();
-    if (needle.isEmpty()) return true;
-    const Qt::CaseSensitivity cs = Qt::CaseInsensitive;
-    if (row.fileName.contains(needle, cs)) return true;
-    if (row.filePath.contains(needle, cs)) return true;
-    if (!row.fileType.isEmpty() && row.fileType.contains(needle, cs)) return true;
-    if (row.lastModified.isValid() && row.lastModified.toString("yyyy-MM-dd hh:mm").toLower().contains(needle.toLower())) return true;
-    return false;
+    const QVector<int> previous = m_filteredRowIndexes;
+    forEachChangeRun(previous, next, [this, &next](bool insert, int pos, int first, int count) {
+        if (insert) {
+            beginInsertRows(QModelIndex(), pos, pos + count - 1);
+            m_filteredRowIndexes.insert(pos, count, 0);
+            std::copy(next.constBegin() + first, next.constBegin() + first + count, m_filteredRowIndexes.begin() + pos);
+            endInsertRows();
+        } else {
+            beginRemoveRows(QModelIndex(), pos, pos + count - 1);
+            m_filteredRowIndexes.remove(pos, count);
+            endRemoveRows();
+        }
+    });
+    Q_ASSERT(m_filteredRowIndexes == next);
 }
 
 QVariantMap AssetsModel::get(int row) const {
@@ -491,7 +709,7 @@ QVariantMap AssetsModel::get(int row) const {
     QVariantMap preview;
     preview["filePath"] = r.filePath;
     preview["fileType"] = r.fileType;
-    preview["isVideo"] = isVideoExtension(r.fileType);
+    preview["isVideo"] = r.typeClass == VideoClass;
     preview["isSequence"] = r.isSequence;
     preview["sequencePattern"] = r.sequencePattern;
     preview["sequenceStart"] = r.sequenceStartFrame;
@@ -526,23 +744,23 @@ void AssetsModel::scheduleReload() {
 }
 
 
-void AssetsModel::scheduleFilterReset() {
-    if (m_filterResetPending)
+void AssetsModel::scheduleFilterUpdate() {
+    if (m_filterUpdatePending)
         return;
-    m_filterResetPending = true;
+    m_filterUpdatePending = true;
     // Coalesce multiple calls within the same event loop turn
     QMetaObject::invokeMethod(this, [this]{
-        if (!m_filterResetPending)
+        if (!m_filterUpdatePending)
             return;
-        m_filterResetPending = false;
-        performFilterReset();
+        m_filterUpdatePending = false;
+        performFilterUpdate();
     }, Qt::QueuedConnection);
 }
 
-void AssetsModel::performFilterReset() {
-    m_isResetting = true;
-    beginResetModel();
-    rebuildFilter();
-    endResetModel();
-    m_isResetting = false;
+void AssetsModel::performFilterUpdate() {
+    QElapsedTimer t; t.start();
+    const int before = m_filteredRowIndexes.size();
+    applyVisibleRows(computeVisibleRows());
+    LogManager::instance().addLog(QString("AssetsModel filter: %1 -> %2 of %3 rows in %4 ms")
+                                      .arg(before).arg(m_filteredRowIndexes.size()).arg(m_rows.size()).arg(t.elapsed()), "DEBUG");
 }
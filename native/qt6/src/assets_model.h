@@ -10,6 +10,10 @@
 
 #include <QHash>
 
+#include "asset_query.h"
+#include "filter_bitset.h"
+#include "roaring_bitmap.h"
+
 struct AssetRow {
     int id = 0;
     QString fileName;
@@ -27,6 +31,8 @@ struct AssetRow {
     bool sequenceHasGaps = false;
     int sequenceGapCount = 0;
     QString sequenceVersion;
+    quint8 typeClass = 0; // AssetsModel::TypeClass of fileType, derived at load
+    QByteArray nameKey;   // NaturalSort::key(fileName), derived at load
 };
 
 class AssetsModel : public QAbstractListModel {
@@ -106,6 +112,23 @@ public:
     Q_INVOKABLE bool assignTags(const QVariantList& assetIds, const QVariantList& tagIds);
     Q_INVOKABLE QVariantMap get(int row) const;
     Q_INVOKABLE QStringList tagsForAsset(int assetId) const;
+    // Row behind a visible row; for models layered on top (AssetsTableModel)
+    const AssetRow& assetRow(int row) const { return m_rows[m_filteredRowIndexes[row]]; }
+    // Option counts over the loaded scope. Each facet applies every active filter
+    // but its own, so a count is what picking that option would leave visible;
+    // extension and sequence counts cover the visible rows.
+    struct FacetCounts {
+        int ratings[6] = {}; // [0] unrated, [1..5] stars
+        int images = 0;
+        int videos = 0;
+        int others = 0;
+        QHash<QString, int> extensions; // lower-case suffix
+        QHash<int, int> tags;           // tag id
+        int sequences = 0;
+        int singles = 0;
+    };
+    const FacetCounts& facetCounts() const { return m_facets; }
+    Q_INVOKABLE QVariantMap facetCountsMap() const;
 
 public slots:
     void reload();
@@ -119,24 +142,48 @@ signals:
     void recursiveModeChanged();
     void searchEntireDatabaseChanged();
     void tagsChangedForAsset(int assetId);
+    void facetCountsChanged();
 
 private slots:
     void onAssetsChangedForFolder(int folderId);
+    void onTagIndexChanged();
     void triggerDebouncedReload();
 
 private:
+    // Each filter dimension keeps its own mask over m_rows; a filter change only
+    // recomputes the masks of the dimensions it touched, then ANDs them together
+    enum FilterDimension { TypeDimension = 0, RatingDimension, TagDimension, SearchDimension, DimensionCount };
+    enum TypeClass : quint8 { OtherClass = 0, ImageClass, VideoClass, TypeClassCount };
+
     void query();
+    bool globalScope() const;
+    // Per-type-class and per-rating row masks, built once per load
+    void buildRowBitsets();
+    void markFilterDirty(FilterDimension dimension) { m_dirtyDimensions |= 1u << dimension; }
+    void rebuildDimension(FilterDimension dimension);
+    QVector<int> computeVisibleRows();
+    // Recounts the facets that depend on the rebuilt dimensions (bit mask)
+    void updateFacets(quint32 rebuiltDimensions, const FilterBitset& visible);
+    void updateTagFacet();
+    // Rows passing every filter dimension except `except`
+    FilterBitset facetBase(FilterDimension except) const;
     void rebuildFilter();
-    bool matchesFilter(const AssetRow& row) const;
+    // Moves the visible rows to `next` (ascending) with row insert/remove signals;
+    // falls back to a reset when the change is too scattered for that to pay off
+    void applyVisibleRows(const QVector<int>& next);
     void scheduleReload();
 
-    // Coalesced filter reset helpers
-    void scheduleFilterReset();
-    void performFilterReset();
+    // Coalesced filter update helpers
+    void scheduleFilterUpdate();
+    void performFilterUpdate();
 
     int m_folderId = 0;
     QVector<AssetRow> m_rows;
     QString m_searchQuery;
+    AssetQuery m_query; // m_searchQuery, parsed
+    // Part of m_query the last global load handed to SQLite (empty in folder scope)
+    QString m_pushedWhere;
+    QVariantList m_pushedBinds;
     int m_typeFilter = All;
     int m_ratingFilter = AllRatings;
     QStringList m_selectedTagNames;
@@ -145,13 +192,22 @@ private:
     bool m_searchEntireDatabase = false;
     QVector<int> m_filteredRowIndexes;
 
+    FilterBitset m_typeClassBits[TypeClassCount];
+    FilterBitset m_ratingBits[6]; // [0] unrated (rating <= 0), [1..5] stars
+    FilterBitset m_dimensionBits[DimensionCount];
+    QHash<QString, FilterBitset> m_extensionBits;
+    FilterBitset m_sequenceBits;
+    FacetCounts m_facets;
+    quint32 m_dirtyDimensions = ~0u;
+    // Asset ids of m_rows, for intersecting with TagIndex bitmaps
+    RoaringBitmap m_scopeIds;
+    QHash<int, int> m_rowOfId;
+
     // Guard to avoid emitting dataChanged while the model is resetting
     bool m_isResetting = false;
 
-    QHash<int, QStringList> m_prefetchedTags; // cache for current filter pass
-
     QTimer m_reloadTimer;
     bool m_reloadScheduled = false;
 
-    bool m_filterResetPending = false;
+    bool m_filterUpdatePending = false;
 };
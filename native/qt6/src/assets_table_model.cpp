@@ -0,0 +1,305 @@
+#include "assets_table_model.h"
+
+#include <QThread>
+#include <QtConcurrent>
+#include <QElapsedTimer>
+#include <QDebug>
+#include <algorithm>
+#include <array>
+#include <numeric>
+
+namespace {
+// Below this many rows sorting is cheaper than handing it to a worker
+constexpr int kParallelSortThreshold = 20000;
+// Older sort columns kept as tie-breakers
+constexpr int kMaxSortColumns = 3;
+// Past this many inserted rows or removed runs a reset is cheaper than row signals
+constexpr int kMaxIncrementalRows = 128;
+
+template <typename T>
+int compareValues(const T& a, const T& b)
+{
+    return a < b ? -1 : (b < a ? 1 : 0);
+}
+}
+
+AssetsTableModel::AssetsTableModel(AssetsModel* sourceModel, QObject* parent)
+    : QAbstractTableModel(parent), m_sourceModel(sourceModel)
+{
+    connect(m_sourceModel, &QAbstractItemModel::modelAboutToBeReset, this, &AssetsTableModel::onSourceAboutToBeReset);
+    connect(m_sourceModel, &QAbstractItemModel::modelReset, this, &AssetsTableModel::onSourceReset);
+    connect(m_sourceModel, &QAbstractItemModel::dataChanged, this, &AssetsTableModel::onSourceDataChanged);
+    connect(m_sourceModel, &QAbstractItemModel::rowsInserted, this, [this](const QModelIndex&, int first, int last) {
+        onSourceRowsInserted(first, last);
+    });
+    connect(m_sourceModel, &QAbstractItemModel::rowsRemoved, this, [this](const QModelIndex&, int first, int last) {
+        onSourceRowsRemoved(first, last);
+    });
+    connect(&m_sortWatcher, &QFutureWatcher<SortResult>::finished, this, [this]() {
+        const SortResult result = m_sortWatcher.result();
+        if (result.generation != m_sortGeneration) return;
+        m_sortPending = false;
+        applyOrder(result.order);
+    });
+
+    rebuildFromSource();
+}
+
+AssetsTableModel::~AssetsTableModel()
+{
+    m_sortWatcher.waitForFinished();
+}
+
+AssetsTableModel::SortEntry AssetsTableModel::entryFor(int sourceRow) const
+{
+    const AssetRow& row = m_sourceModel->assetRow(sourceRow);
+    SortEntry e;
+    e.name = row.nameKey;
+    e.type = row.fileType.toUtf8();
+    e.size = row.fileSize;
+    e.modified = row.lastModified.isValid() ? row.lastModified.toMSecsSinceEpoch() : 0;
+    e.rating = qMax(0, row.rating);
+    e.id = row.id;
+    return e;
+}
+
+bool AssetsTableModel::lessThan(const SortEntry& a, const SortEntry& b, const SortSpec& spec)
+{
+    for (const SortColumn& sc : spec) {
+        int c = 0;
+        switch (sc.column) {
+            case NameColumn: c = compareValues(a.name, b.name); break;
+            case ExtensionColumn: c = compareValues(a.type, b.type); break;
+            case SizeColumn: c = compareValues(a.size, b.size); break;
+            case DateColumn: c = compareValues(a.modified, b.modified); break;
+            case RatingColumn: c = compareValues(a.rating, b.rating); break;
+        }
+        if (c != 0) return sc.order == Qt::AscendingOrder ? c < 0 : c > 0;
+    }
+    // Total order, so the parallel and serial sorts agree
+    if (const int c = compareValues(a.name, b.name)) return c < 0;
+    return a.id < b.id;
+}
+
+QVector<int> AssetsTableModel::sortedOrder(const QVector<SortEntry>& entries, const SortSpec& spec)
+{
+    const int n = entries.size();
+    QVector<int> order(n);
+    int* data = order.data(); // detach once, before any worker touches it
+    std::iota(data, data + n, 0);
+    auto less = [&entries, &spec](int a, int b) { return lessThan(entries[a], entries[b], spec); };
+
+    if (n < kParallelSortThreshold) {
+        std::sort(data, data + n, less);
+        return order;
+    }
+
+    // Sort one chunk per core, then merge neighbours pairwise until one run is left
+    const int chunks = qBound(2, QThread::idealThreadCount(), 64);
+    QVector<std::array<int, 2>> runs;
+    for (int i = 0; i < chunks; ++i) runs.append({int(qint64(n) * i / chunks), int(qint64(n) * (i + 1) / chunks)});
+    QtConcurrent::blockingMap(runs, [&](const std::array<int, 2>& r) { std::sort(data + r[0], data + r[1], less); });
+    while (runs.size() > 1) {
+        QVector<std::array<int, 3>> merges;
+        QVector<std::array<int, 2>> merged;
+        for (int i = 0; i + 1 < runs.size(); i += 2) {
+            merges.append({runs[i][0], runs[i][1], runs[i + 1][1]});
+            merged.append({runs[i][0], runs[i + 1][1]});
+        }
+        if (runs.size() % 2) merged.append(runs.last());
+        QtConcurrent::blockingMap(merges, [&](const std::array<int, 3>& m) {
+            std::inplace_merge(data + m[0], data + m[1], data + m[2], less);
+        });
+        runs = merged;
+    }
+    return order;
+}
+
+void AssetsTableModel::sort(int column, Qt::SortOrder order)
+{
+    if (column < 0 || column >= ColumnCount) return;
+    m_sortSpec.erase(std::remove_if(m_sortSpec.begin(), m_sortSpec.end(),
+                                    [column](const SortColumn& sc) { return sc.column == column; }),
+                     m_sortSpec.end());
+    m_sortSpec.prepend({column, order});
+    if (m_sortSpec.size() > kMaxSortColumns) m_sortSpec.resize(kMaxSortColumns);
+    startSort();
+}
+
+void AssetsTableModel::startSort()
+{
+    if (m_sortSpec.isEmpty()) return;
+    // Whatever is still in flight was sorted from older rows or an older spec
+    const quint64 generation = ++m_sortGeneration;
+    if (m_entries.size() < kParallelSortThreshold) {
+        m_sortPending = false;
+        applyOrder(sortedOrder(m_entries, m_sortSpec));
+        return;
+    }
+    m_sortPending = true;
+    // Snapshot the keys (implicitly shared) so the worker never sees later edits
+    const QVector<SortEntry> entries = m_entries;
+    const SortSpec spec = m_sortSpec;
+    m_sortWatcher.setFuture(QtConcurrent::run([entries, spec, generation]() {
+        QElapsedTimer timer;
+        timer.start();
+        SortResult result{generation, sortedOrder(entries, spec)};
+        qDebug() << "[AssetsTableModel] Sorted" << entries.size() << "rows in" << timer.elapsed() << "ms";
+        return result;
+    }));
+}
+
+void AssetsTableModel::restartPendingSort()
+{
+    if (m_sortPending) startSort();
+}
+
+void AssetsTableModel::applyOrder(const QVector<int>& order)
+{
+    if (order.size() != m_order.size() || order.size() != m_entries.size()) return;
+
+    emit layoutAboutToBeChanged({}, QAbstractItemModel::VerticalSortHint);
+    const QModelIndexList before = persistentIndexList();
+    QVector<int> sourceRows;
+    sourceRows.reserve(before.size());
+    for (const QModelIndex& idx : before) sourceRows.append(mapToSource(idx.row()));
+    m_order = order;
+    rebuildRowOfSource();
+    QModelIndexList after;
+    after.reserve(before.size());
+    for (int i = 0; i < before.size(); ++i) {
+        const int row = mapFromSource(sourceRows[i]);
+        after.append(row >= 0 ? index(row, before[i].column()) : QModelIndex());
+    }
+    changePersistentIndexList(before, after);
+    emit layoutChanged({}, QAbstractItemModel::VerticalSortHint);
+}
+
+void AssetsTableModel::rebuildRowOfSource()
+{
+    m_rowOfSource.resize(m_order.size());
+    for (int row = 0; row < m_order.size(); ++row) {
+        if (m_order[row] >= 0) m_rowOfSource[m_order[row]] = row;
+    }
+}
+
+void AssetsTableModel::onSourceAboutToBeReset()
+{
+    beginResetModel();
+}
+
+void AssetsTableModel::onSourceReset()
+{
+    rebuildFromSource();
+    endResetModel();
+    if (!m_sortSpec.isEmpty() && m_entries.size() >= kParallelSortThreshold) startSort();
+}
+
+void AssetsTableModel::rebuildFromSource()
+{
+    ++m_sortGeneration;
+    m_sortPending = false;
+    const int n = m_sourceModel->rowCount(QModelIndex());
+    m_entries.resize(n);
+    for (int i = 0; i < n; ++i) m_entries[i] = entryFor(i);
+    m_order.resize(n);
+    std::iota(m_order.begin(), m_order.end(), 0);
+    // Small folders come back already sorted; large ones show source order until the worker lands
+    if (!m_sortSpec.isEmpty() && n < kParallelSortThreshold) m_order = sortedOrder(m_entries, m_sortSpec);
+    rebuildRowOfSource();
+}
+
+void AssetsTableModel::onSourceDataChanged(const QModelIndex& topLeft, const QModelIndex& bottomRight)
+{
+    const int first = topLeft.row();
+    const int last = bottomRight.row();
+    for (int s = first; s <= last && s < m_entries.size(); ++s) m_entries[s] = entryFor(s);
+    if (m_sortSpec.isEmpty()) {
+        emit dataChanged(index(first, 0), index(last, ColumnCount - 1));
+        return;
+    }
+    // Rows stay where they are until the next sort, as in a file browser
+    if (last - first >= kMaxIncrementalRows) {
+        emit dataChanged(index(0, 0), index(rowCount() - 1, ColumnCount - 1));
+        return;
+    }
+    for (int s = first; s <= last; ++s) {
+        const int row = mapFromSource(s);
+        if (row >= 0) emit dataChanged(index(row, 0), index(row, ColumnCount - 1));
+    }
+}
+
+void AssetsTableModel::onSourceRowsInserted(int first, int last)
+{
+    const int count = last - first + 1;
+    // Renumber existing rows first so data() stays right while rows are announced
+    for (int& s : m_order) {
+        if (s >= first) s += count;
+    }
+    QVector<SortEntry> added;
+    added.reserve(count);
+    for (int s = first; s <= last; ++s) added.append(entryFor(s));
+    m_entries.insert(first, count, SortEntry());
+    std::copy(added.cbegin(), added.cend(), m_entries.begin() + first);
+
+    if (m_sortSpec.isEmpty()) {
+        beginInsertRows(QModelIndex(), first, last);
+        for (int s = first; s <= last; ++s) m_order.insert(s, s);
+        rebuildRowOfSource();
+        endInsertRows();
+        return;
+    }
+    if (count > kMaxIncrementalRows) {
+        beginResetModel();
+        m_order = sortedOrder(m_entries, m_sortSpec);
+        rebuildRowOfSource();
+        endResetModel();
+        restartPendingSort();
+        return;
+    }
+    // Each new row goes straight to its sorted place
+    auto less = [this](int a, int b) { return lessThan(m_entries[a], m_entries[b], m_sortSpec); };
+    for (int s = first; s <= last; ++s) {
+        const int row = int(std::upper_bound(m_order.cbegin(), m_order.cend(), s, less) - m_order.cbegin());
+        beginInsertRows(QModelIndex(), row, row);
+        m_order.insert(row, s);
+        endInsertRows();
+    }
+    rebuildRowOfSource();
+    restartPendingSort();
+}
+
+void AssetsTableModel::onSourceRowsRemoved(int first, int last)
+{
+    const int count = last - first + 1;
+    // Mark the removed rows (-1) and renumber the rest before announcing anything
+    QVector<int> gone;
+    for (int row = 0; row < m_order.size(); ++row) {
+        int& s = m_order[row];
+        if (s > last) s -= count;
+        else if (s >= first) { s = -1; gone.append(row); }
+    }
+    m_entries.remove(first, count);
+
+    // Contiguous table runs, removed back to front so earlier rows keep their numbers
+    QVector<std::array<int, 2>> runs;
+    for (int row : gone) {
+        if (!runs.isEmpty() && runs.last()[1] + 1 == row) runs.last()[1] = row;
+        else runs.append({row, row});
+    }
+    if (runs.size() > kMaxIncrementalRows) {
+        beginResetModel();
+        m_order.removeIf([](int s) { return s < 0; });
+        rebuildRowOfSource();
+        endResetModel();
+        restartPendingSort();
+        return;
+    }
+    for (auto it = runs.crbegin(); it != runs.crend(); ++it) {
+        beginRemoveRows(QModelIndex(), (*it)[0], (*it)[1]);
+        m_order.remove((*it)[0], (*it)[1] - (*it)[0] + 1);
+        endRemoveRows();
+    }
+    rebuildRowOfSource();
+    restartPendingSort();
+}
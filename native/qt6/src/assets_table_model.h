@@ -4,6 +4,7 @@
 #include "assets_model.h"
 #include <QMimeData>
 #include <QSet>
+#include <QFutureWatcher>
 
 class AssetsTableModel : public QAbstractTableModel
 {
@@ -18,31 +19,14 @@ public:
         ColumnCount
     };
 
-    explicit AssetsTableModel(AssetsModel* sourceModel, QObject* parent = nullptr)
-        : QAbstractTableModel(parent), m_sourceModel(sourceModel)
-    {
-        connect(m_sourceModel, &QAbstractItemModel::modelReset, this, [this]() {
-            beginResetModel();
-            endResetModel();
-        });
-        connect(m_sourceModel, &QAbstractItemModel::dataChanged, this, [this](const QModelIndex& topLeft, const QModelIndex& bottomRight) {
-            emit dataChanged(index(topLeft.row(), 0), index(bottomRight.row(), ColumnCount - 1));
-        });
-        connect(m_sourceModel, &QAbstractItemModel::rowsInserted, this, [this](const QModelIndex&, int first, int last) {
-            beginInsertRows(QModelIndex(), first, last);
-            endInsertRows();
-        });
-        connect(m_sourceModel, &QAbstractItemModel::rowsRemoved, this, [this](const QModelIndex&, int first, int last) {
-            beginRemoveRows(QModelIndex(), first, last);
-            endRemoveRows();
-        });
-    }
+    explicit AssetsTableModel(AssetsModel* sourceModel, QObject* parent = nullptr);
+    ~AssetsTableModel() override;
 
     int rowCount(const QModelIndex& parent = QModelIndex()) const override
     {
         if (parent.isValid())
             return 0;
-        return m_sourceModel->rowCount(QModelIndex());
+        return m_order.size();
     }
 
     int columnCount(const QModelIndex& parent = QModelIndex()) const override
@@ -57,7 +41,7 @@ public:
         if (!index.isValid() || index.row() >= rowCount() || index.column() >= ColumnCount)
             return QVariant();
 
-        QModelIndex sourceIndex = m_sourceModel->index(index.row(), 0);
+        QModelIndex sourceIndex = m_sourceModel->index(mapToSource(index.row()), 0);
 
         if (role == Qt::DisplayRole) {
             switch (index.column()) {
@@ -142,7 +126,7 @@ public:
         }
         QModelIndexList src;
         src.reserve(rows.size());
-        for (int r : rows) src << m_sourceModel->index(r, 0);
+        for (int r : rows) src << m_sourceModel->index(mapToSource(r), 0);
         return m_sourceModel->mimeData(src);
     }
 
@@ -150,22 +134,52 @@ public:
         return m_sourceModel->supportedDragActions();
     }
 
-    void sort(int column, Qt::SortOrder order = Qt::AscendingOrder) override
-    {
-        // Store sort settings for future use
-        m_sortColumn = column;
-        m_sortOrder = order;
-
-        // Trigger re-sort by emitting layoutAboutToBeChanged/layoutChanged
-        emit layoutAboutToBeChanged();
-        // Note: Actual sorting would require access to the underlying data in AssetsModel
-        // For now, we'll just emit the signal to indicate sorting is requested
-        emit layoutChanged();
-    }
+    // Sorts by `column`, keeping earlier sort columns as tie-breakers (most recent
+    // first). Large folders are sorted on a worker; the rows are permuted when it lands.
+    void sort(int column, Qt::SortOrder order = Qt::AscendingOrder) override;
+
+    // Table row <-> AssetsModel row (-1 when out of range)
+    int mapToSource(int row) const { return row >= 0 && row < m_order.size() ? m_order[row] : -1; }
+    int mapFromSource(int sourceRow) const { return sourceRow >= 0 && sourceRow < m_rowOfSource.size() ? m_rowOfSource[sourceRow] : -1; }
 
     AssetsModel* sourceModel() const { return m_sourceModel; }
 
 private:
+    // Per source row, gathered from AssetsModel's load-time keys
+    struct SortEntry {
+        QByteArray name;
+        QByteArray type;
+        qint64 size = 0;
+        qint64 modified = 0;
+        int rating = 0;
+        int id = 0;
+    };
+    struct SortColumn {
+        int column;
+        Qt::SortOrder order;
+    };
+    using SortSpec = QVector<SortColumn>;
+    struct SortResult {
+        quint64 generation = 0;
+        QVector<int> order;
+    };
+
+    static bool lessThan(const SortEntry& a, const SortEntry& b, const SortSpec& spec);
+    static QVector<int> sortedOrder(const QVector<SortEntry>& entries, const SortSpec& spec);
+
+    SortEntry entryFor(int sourceRow) const;
+    void rebuildFromSource();
+    void onSourceAboutToBeReset();
+    void onSourceReset();
+    void onSourceDataChanged(const QModelIndex& topLeft, const QModelIndex& bottomRight);
+    void onSourceRowsInserted(int first, int last);
+    void onSourceRowsRemoved(int first, int last);
+    void startSort();
+    // Rows changed under a worker sort: sort again from the current rows
+    void restartPendingSort();
+    void applyOrder(const QVector<int>& order);
+    void rebuildRowOfSource();
+
     QString formatFileSize(qint64 bytes) const
     {
         if (bytes < 1024)
@@ -179,7 +193,12 @@ private:
     }
 
     AssetsModel* m_sourceModel;
-    int m_sortColumn = 0;
-    Qt::SortOrder m_sortOrder = Qt::AscendingOrder;
+    QVector<SortEntry> m_entries;  // by source row
+    QVector<int> m_order;          // table row -> source row
+    QVector<int> m_rowOfSource;    // source row -> table row
+    SortSpec m_sortSpec;           // empty: source order
+    QFutureWatcher<SortResult> m_sortWatcher;
+    quint64 m_sortGeneration = 0;  // bumped whenever an in-flight result goes stale
+    bool m_sortPending = false;    // a worker sort has been started and not applied yet
 };
 
@@ -0,0 +1,406 @@
+#include "copy_engine.h"
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QObject>
+#include <QDebug>
+#include <QCryptographicHash>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QQueue>
+#include <thread>
+
+#ifndef _WIN32
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef Q_OS_LINUX
+#include <linux/fs.h>
+#include <sys/ioctl.h>
+#include <sys/sendfile.h>
+#endif
+
+namespace {
+
+// Kernel copies are issued in chunks so cancel/progress stay responsive
+constexpr qint64 kKernelChunk = 64LL * 1024 * 1024;
+constexpr qint64 kBufferedChunk = 8LL * 1024 * 1024;
+// Hashed copies: 4 MB blocks, at most 4 in flight between the reader and the writer
+constexpr qint64 kHashedBlock = 4LL * 1024 * 1024;
+constexpr int kHashedDepth = 4;
+
+#ifndef _WIN32
+QString errnoString(const QString& what, const QString& path, int err)
+{
+    return QObject::tr("%1 %2: %3").arg(what, path, QString::fromLocal8Bit(std::strerror(err)));
+}
+
+// Errors that mean "this mechanism is not available here", not "the copy failed"
+bool isUnsupported(int err)
+{
+    return err == ENOSYS || err == EXDEV || err == EINVAL || err == EOPNOTSUPP
+#if defined(ENOTSUP) && ENOTSUP != EOPNOTSUPP
+        || err == ENOTSUP
+#endif
+        || err == EBADF || err == ETXTBSY;
+}
+
+struct Fd {
+    int fd = -1;
+    ~Fd() { if (fd >= 0) ::close(fd); }
+};
+#endif
+
+// Opening the destination truncates it, so a copy onto the source itself (same path,
+// hard link, bind mount) must be refused before that
+bool isSameFile(const QString& src, const QString& dst)
+{
+#ifndef _WIN32
+    struct stat a {}, b {};
+    if (::stat(QFile::encodeName(src).constData(), &a) != 0) return false;
+    if (::stat(QFile::encodeName(dst).constData(), &b) != 0) return false;
+    return a.st_dev == b.st_dev && a.st_ino == b.st_ino;
+#else
+    const QString a = QFileInfo(src).canonicalFilePath();
+    return !a.isEmpty() && a.compare(QFileInfo(dst).canonicalFilePath(), Qt::CaseInsensitive) == 0;
+#endif
+}
+
+#ifndef _WIN32
+
+void dropBehind(int fd, qint64 from, qint64 to)
+{
+#if defined(POSIX_FADV_DONTNEED)
+    if (to > from) ::posix_fadvise(fd, from, to - from, POSIX_FADV_DONTNEED);
+#else
+    Q_UNUSED(fd); Q_UNUSED(from); Q_UNUSED(to);
+#endif
+}
+#endif
+
+// Bounded hand-off between the reading/hashing thread and the writing thread
+class BlockQueue {
+public:
+    void push(QByteArray block)
+    {
+        QMutexLocker lk(&m_mutex);
+        while (m_blocks.size() >= kHashedDepth && !m_aborted) m_notFull.wait(&m_mutex);
+        m_blocks.enqueue(std::move(block));
+        m_notEmpty.wakeOne();
+    }
+    // Returns false once the producer is done and the queue is drained
+    bool pop(QByteArray* out)
+    {
+        QMutexLocker lk(&m_mutex);
+        while (m_blocks.isEmpty() && !m_finished) m_notEmpty.wait(&m_mutex);
+        if (m_blocks.isEmpty()) return false;
+        *out = m_blocks.dequeue();
+        m_notFull.wakeOne();
+        return true;
+    }
+    void finish() { QMutexLocker lk(&m_mutex); m_finished = true; m_notEmpty.wakeAll(); }
+    void abort() { QMutexLocker lk(&m_mutex); m_aborted = true; m_blocks.clear(); m_notFull.wakeAll(); }
+    bool aborted() const { QMutexLocker lk(&m_mutex); return m_aborted; }
+
+private:
+    mutable QMutex m_mutex;
+    QWaitCondition m_notEmpty;
+    QWaitCondition m_notFull;
+    QQueue<QByteArray> m_blocks;
+    bool m_finished = false;
+    bool m_aborted = false;
+};
+
+void syncToDisk(QFile& f)
+{
+    f.flush();
+#if defined(Q_OS_MACOS)
+    ::fsync(f.handle());
+#elif !defined(_WIN32)
+    ::fdatasync(f.handle());
+#else
+    Q_UNUSED(f);
+#endif
+}
+
+} // namespace
+
+QString CopyEngine::methodName(Method m)
+{
+    switch (m) {
+        case Method::Reflink: return QStringLiteral("reflink");
+        case Method::CopyFileRange: return QStringLiteral("copy_file_range");
+        case Method::Sendfile: return QStringLiteral("sendfile");
+        case Method::Buffered: return QStringLiteral("buffered");
+        case Method::None: break;
+    }
+    return QStringLiteral("none");
+}
+
+bool CopyEngine::copyFile(const QString& src, const QString& dst, std::atomic_bool& cancel,
+                          const ProgressFn& onProgress, QString* errorOut, Method* methodOut)
+{
+    if (methodOut) *methodOut = Method::None;
+    if (isSameFile(src, dst)) { if (errorOut) *errorOut = QObject::tr("Source and destination are the same file: %1").arg(dst); return false; }
+    QDir().mkpath(QFileInfo(dst).absolutePath());
+
+#ifndef _WIN32
+    const QByteArray srcPath = QFile::encodeName(src);
+    const QByteArray dstPath = QFile::encodeName(dst);
+
+    Fd in;
+    in.fd = ::open(srcPath.constData(), O_RDONLY | O_CLOEXEC);
+    if (in.fd < 0) { if (errorOut) *errorOut = errnoString(QObject::tr("Failed to open"), src, errno); return false; }
+    struct stat st {};
+    if (::fstat(in.fd, &st) != 0) { if (errorOut) *errorOut = errnoString(QObject::tr("Failed to stat"), src, errno); return false; }
+    const qint64 total = st.st_size;
+
+    Fd out;
+    out.fd = ::open(dstPath.constData(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, (st.st_mode & 07777) | S_IWUSR);
+    if (out.fd < 0) { if (errorOut) *errorOut = errnoString(QObject::tr("Failed to write"), dst, errno); return false; }
+
+    auto fail = [&](const QString& msg) {
+        if (errorOut) *errorOut = msg;
+        ::close(out.fd); out.fd = -1;
+        ::unlink(dstPath.constData());
+        return false;
+    };
+    auto finish = [&](qint64 copied, Method m) {
+        if (copied != total && ::ftruncate(out.fd, copied) != 0) return fail(errnoString(QObject::tr("Failed to truncate"), dst, errno));
+        // Keep the source timestamps like the OS copy handlers do
+#if defined(Q_OS_MACOS)
+        const struct timespec times[2] = { st.st_atimespec, st.st_mtimespec };
+#else
+        const struct timespec times[2] = { st.st_atim, st.st_mtim };
+#endif
+        ::futimens(out.fd, times);
+        if (::close(out.fd) != 0) { out.fd = -1; return fail(errnoString(QObject::tr("Write error"), dst, errno)); }
+        out.fd = -1;
+        if (methodOut) *methodOut = m;
+        if (onProgress) onProgress(copied, total);
+        return true;
+    };
+
+    if (total == 0) return finish(0, Method::Buffered);
+
+#if defined(Q_OS_LINUX) && defined(FICLONE)
+    // 1. Reflink: shares extents, no data is read or written
+    if (::ioctl(out.fd, FICLONE, in.fd) == 0) return finish(total, Method::Reflink);
+#endif
+
+#if defined(POSIX_FADV_SEQUENTIAL)
+    ::posix_fadvise(in.fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+    // Preallocate so large media lands in contiguous extents and ENOSPC shows up before any data moves
+#if defined(Q_OS_LINUX)
+    if (::fallocate(out.fd, 0, 0, total) != 0 && errno == ENOSPC) return fail(errnoString(QObject::tr("Not enough space for"), dst, ENOSPC));
+#elif !defined(Q_OS_MACOS)
+    if (::posix_fallocate(out.fd, 0, total) == ENOSPC) return fail(errnoString(QObject::tr("Not enough space for"), dst, ENOSPC));
+#endif
+
+    qint64 copied = 0;
+    Method method = Method::Buffered;
+
+#if defined(Q_OS_LINUX)
+    // 2. copy_file_range
+    {
+        bool usable = true;
+        while (usable && copied < total) {
+            if (cancel.load()) return fail(QObject::tr("Cancelled"));
+            loff_t offIn = copied, offOut = copied;
+            const ssize_t n = ::copy_file_range(in.fd, &offIn, out.fd, &offOut, size_t(qMin(kKernelChunk, total - copied)), 0);
+            if (n < 0) {
+                if (errno == EINTR) continue;
+                if (isUnsupported(errno)) { usable = false; break; }
+                return fail(errnoString(QObject::tr("Write error"), dst, errno));
+            }
+            if (n == 0) break; // source shrank
+            dropBehind(in.fd, copied, copied + n);
+            copied += n;
+            method = Method::CopyFileRange;
+            if (onProgress) onProgress(copied, total);
+        }
+        if (copied >= total || (usable && copied > 0)) return finish(copied, method);
+    }
+
+    // 3. sendfile (continues from wherever copy_file_range stopped)
+    if (::lseek(out.fd, copied, SEEK_SET) == copied) {
+        bool usable = true;
+        while (usable && copied < total) {
+            if (cancel.load()) return fail(QObject::tr("Cancelled"));
+            off_t offIn = copied;
+            const ssize_t n = ::sendfile(out.fd, in.fd, &offIn, size_t(qMin(kKernelChunk, total - copied)));
+            if (n < 0) {
+                if (errno == EINTR) continue;
+                if (isUnsupported(errno)) { usable = false; break; }
+                return fail(errnoString(QObject::tr("Write error"), dst, errno));
+            }
+            if (n == 0) break;
+            dropBehind(in.fd, copied, copied + n);
+            copied += n;
+            method = Method::Sendfile;
+            if (onProgress) onProgress(copied, total);
+        }
+        if (copied >= total || (usable && copied > 0)) return finish(copied, method);
+    }
+#endif
+
+    // 4. Large-buffer user-space copy
+    QByteArray buf;
+    buf.resize(int(kBufferedChunk));
+    while (copied < total) {
+        if (cancel.load()) return fail(QObject::tr("Cancelled"));
+        const ssize_t r = ::pread(in.fd, buf.data(), size_t(qMin<qint64>(buf.size(), total - copied)), copied);
+        if (r < 0) {
+            if (errno == EINTR) continue;
+            return fail(errnoString(QObject::tr("Read error"), src, errno));
+        }
+        if (r == 0) break;
+        ssize_t written = 0;
+        while (written < r) {
+            const ssize_t w = ::pwrite(out.fd, buf.constData() + written, size_t(r - written), copied + written);
+            if (w < 0) {
+                if (errno == EINTR) continue;
+                return fail(errnoString(QObject::tr("Write error"), dst, errno));
+            }
+            written += w;
+        }
+        dropBehind(in.fd, copied, copied + r);
+        copied += r;
+        method = Method::Buffered;
+        if (onProgress) onProgress(copied, total);
+    }
+    return finish(copied, method);
+#else
+    QFile in(src); QFile out(dst);
+    if (!in.open(QIODevice::ReadOnly)) { if (errorOut) *errorOut = QObject::tr("Failed to open %1").arg(src); return false; }
+    if (!out.open(QIODevice::WriteOnly)) { if (errorOut) *errorOut = QObject::tr("Failed to write %1").arg(dst); return false; }
+    const qint64 total = in.size();
+    // Preallocate (SetEndOfFile) so the file system can allocate contiguously
+    out.resize(total);
+    qint64 copied = 0;
+    QByteArray buf; buf.resize(int(kBufferedChunk));
+    while (!in.atEnd()) {
+        if (cancel.load()) { out.close(); out.remove(); if (errorOut) *errorOut = QObject::tr("Cancelled"); return false; }
+        qint64 r = in.read(buf.data(), buf.size());
+        if (r <= 0) break;
+        qint64 w = out.write(buf.constData(), r);
+        if (w != r) { if (errorOut) *errorOut = QObject::tr("Write error %1").arg(dst); out.close(); out.remove(); return false; }
+        copied += w;
+        if (onProgress) onProgress(copied, total);
+    }
+    if (copied != total) out.resize(copied);
+    out.flush(); out.close(); in.close();
+    if (methodOut) *methodOut = Method::Buffered;
+    return true;
+#endif
+}
+
+bool CopyEngine::copyFileHashed(const QString& src, const QString& dst, std::atomic_bool& cancel,
+                                const ProgressFn& onProgress, QString* sha256Out, QString* errorOut)
+{
+    if (isSameFile(src, dst)) { if (errorOut) *errorOut = QObject::tr("Source and destination are the same file: %1").arg(dst); return false; }
+    QDir().mkpath(QFileInfo(dst).absolutePath());
+    QFile in(src);
+    QFile out(dst);
+    if (!in.open(QIODevice::ReadOnly)) { if (errorOut) *errorOut = QObject::tr("Failed to open %1").arg(src); return false; }
+    if (!out.open(QIODevice::WriteOnly | QIODevice::Truncate)) { if (errorOut) *errorOut = QObject::tr("Failed to write %1").arg(dst); return false; }
+    const qint64 total = in.size();
+    out.resize(total);
+#if defined(POSIX_FADV_SEQUENTIAL)
+    ::posix_fadvise(in.handle(), 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+
+    BlockQueue queue;
+    QCryptographicHash hasher(QCryptographicHash::Sha256);
+    QString readError;
+    std::thread reader([&] {
+        qint64 offset = 0;
+        while (!cancel.load() && !queue.aborted()) {
+            QByteArray block;
+            block.resize(int(kHashedBlock));
+            const qint64 n = in.read(block.data(), block.size());
+            if (n < 0) { readError = QObject::tr("Read error %1").arg(src); break; }
+            if (n == 0) break;
+            block.resize(int(n));
+            hasher.addData(block.constData(), int(n));
+#ifndef _WIN32
+            dropBehind(in.handle(), offset, offset + n);
+#endif
+            offset += n;
+            queue.push(std::move(block));
+        }
+        queue.finish();
+    });
+
+    qint64 copied = 0;
+    QString writeError;
+    QByteArray block;
+    while (queue.pop(&block)) {
+        if (cancel.load()) break;
+        if (out.write(block) != block.size()) { writeError = QObject::tr("Write error %1").arg(dst); break; }
+        copied += block.size();
+        if (onProgress) onProgress(copied, total);
+    }
+    queue.abort();
+    reader.join();
+
+    if (!writeError.isEmpty() || !readError.isEmpty() || cancel.load()) {
+        out.close(); out.remove();
+        if (errorOut) *errorOut = !writeError.isEmpty() ? writeError : !readError.isEmpty() ? readError : QObject::tr("Cancelled");
+        return false;
+    }
+    if (copied != total) out.resize(copied);
+    // Keep the source modification time; it lands in the manifest as well
+    out.setFileTime(in.fileTime(QFileDevice::FileModificationTime), QFileDevice::FileModificationTime);
+    syncToDisk(out);
+    out.close();
+    if (out.error() != QFileDevice::NoError) {
+        out.remove();
+        if (errorOut) *errorOut = QObject::tr("Write error %1").arg(dst);
+        return false;
+    }
+    if (sha256Out) *sha256Out = QString::fromLatin1(hasher.result().toHex());
+    return true;
+}
+
+bool CopyEngine::hashFile(const QString& path, std::atomic_bool& cancel, bool bypassCache,
+                          const ProgressFn& onProgress, QString* sha256Out, QString* errorOut)
+{
+    QFile f(path);
+    if (!f.open(QIODevice::ReadOnly)) { if (errorOut) *errorOut = QObject::tr("Failed to open %1").arg(path); return false; }
+    const qint64 total = f.size();
+#if defined(Q_OS_MACOS)
+    if (bypassCache) ::fcntl(f.handle(), F_NOCACHE, 1);
+#elif !defined(_WIN32)
+    // Clean pages are dropped by DONTNEED; the copy was synced, so none are dirty
+    if (bypassCache) ::posix_fadvise(f.handle(), 0, 0, POSIX_FADV_DONTNEED);
+    ::posix_fadvise(f.handle(), 0, 0, POSIX_FADV_SEQUENTIAL);
+#else
+    Q_UNUSED(bypassCache);
+#endif
+
+    QCryptographicHash hasher(QCryptographicHash::Sha256);
+    QByteArray buf;
+    buf.resize(int(kHashedBlock));
+    qint64 done = 0;
+    while (true) {
+        if (cancel.load()) { if (errorOut) *errorOut = QObject::tr("Cancelled"); return false; }
+        const qint64 n = f.read(buf.data(), buf.size());
+        if (n < 0) { if (errorOut) *errorOut = QObject::tr("Read error %1").arg(path); return false; }
+        if (n == 0) break;
+        hasher.addData(buf.constData(), int(n));
+#ifndef _WIN32
+        if (bypassCache) dropBehind(f.handle(), done, done + n);
+#endif
+        done += n;
+        if (onProgress) onProgress(done, total);
+    }
+    if (sha256Out) *sha256Out = QString::fromLatin1(hasher.result().toHex());
+    return true;
+}
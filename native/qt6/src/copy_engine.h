@@ -0,0 +1,49 @@
+#pragma once
+
+#include <QString>
+#include <atomic>
+#include <functional>
+
+/**
+ * CopyEngine - single-file copy with kernel offload
+ *
+ * Tries the cheapest mechanism the platform and filesystems allow:
+ *   1. FICLONE reflink (Btrfs/XFS/bcachefs same-filesystem: metadata-only, instant)
+ *   2. copy_file_range (in-kernel copy; server-side copy on NFS 4.2/SMB3)
+ *   3. sendfile (in-kernel, older kernels / cross-filesystem)
+ *   4. pread/pwrite with a large buffer
+ * The destination is preallocated and the source is read with sequential /
+ * drop-behind hints so large plates don't evict the page cache. Work is chunked
+ * so progress callbacks and cancellation keep working on every path.
+ */
+namespace CopyEngine {
+
+enum class Method { None, Reflink, CopyFileRange, Sendfile, Buffered };
+
+using ProgressFn = std::function<void(qint64 copied, qint64 total)>;
+
+// Copies src to dst (overwriting dst). On failure or cancellation the partial
+// destination is removed. methodOut reports the mechanism that finished the copy.
+bool copyFile(const QString& src, const QString& dst, std::atomic_bool& cancel,
+              const ProgressFn& onProgress, QString* errorOut, Method* methodOut = nullptr);
+
+QString methodName(Method m);
+
+// Verified-transfer building blocks. Digests are lowercase hex SHA-256, the same
+// form the catalog stores in assets.checksum.
+//
+// copyFileHashed streams the source through user space so it can be hashed: a
+// reader thread reads and hashes block N+1 while the caller writes block N, so
+// hashing costs little more than the copy itself. The destination is flushed to
+// stable storage before returning.
+bool copyFileHashed(const QString& src, const QString& dst, std::atomic_bool& cancel,
+                    const ProgressFn& onProgress, QString* sha256Out, QString* errorOut);
+
+// Hashes a file. With bypassCache the file's cached pages are dropped first
+// (posix_fadvise DONTNEED / F_NOCACHE) so a verification pass reads the media,
+// not the copy still sitting in RAM. Windows has no portable equivalent without
+// sector-aligned unbuffered I/O and reads through the cache.
+bool hashFile(const QString& path, std::atomic_bool& cancel, bool bypassCache,
+              const ProgressFn& onProgress, QString* sha256Out, QString* errorOut);
+
+} // namespace CopyEngine
@@ -8,6 +8,12 @@
 #include <QThreadPool>
 
 #include "file_utils.h"
+#include "natural_sort.h"
+
+#ifdef HAVE_SQLITE3
+#include <QSqlDriver>
+#include <sqlite3.h>
+#endif
 
 static QString lastErrorToString(const QSqlQuery& q){ return q.lastError().text(); }
 
@@ -27,6 +33,15 @@ static QString computeFileSha256(const QString& path)
     return hasher.result().toHex();
 }
 
+#ifdef HAVE_SQLITE3
+// SQLITE_UTF16 hands over native-endian UTF-16, i.e. QChar data
+static int naturalCollation(void*, int lenA, const void* a, int lenB, const void* b)
+{
+    return NaturalSort::compare(QStringView(static_cast<const QChar*>(a), lenA / 2),
+                                QStringView(static_cast<const QChar*>(b), lenB / 2));
+}
+#endif
+
 DB& DB::instance(){ static DB s; return s; }
 
 DB::DB(QObject* parent): QObject(parent) {}
@@ -44,17 +59,40 @@ bool DB::init(const QString& dbFilePath){
     m_dataDir = dbFi.absolutePath();
     QDir().mkpath(m_dataDir + "/versions");
 
+    m_naturalCollation = registerCollations();
     if (!migrate()) return false;
     m_rootId = ensureRootFolder();
     return m_rootId > 0;
 }
 
+bool DB::registerCollations(){
+#ifdef HAVE_SQLITE3
+    const QVariant handle = m_db.driver()->handle();
+    if (handle.isValid() && qstrcmp(handle.typeName(), "sqlite3*") == 0) {
+        sqlite3* sqlite = *static_cast<sqlite3* const*>(handle.constData());
+        if (sqlite && sqlite3_create_collation(sqlite, "NATURAL", SQLITE_UTF16, nullptr, naturalCollation) == SQLITE_OK)
+            return true;
+    }
+    qWarning() << "DB: NATURAL collation unavailable, name order falls back to BINARY";
+#endif
+    return false;
+}
+
+QString DB::fileNameOrderBy() const {
+    return m_naturalCollation ? QStringLiteral("file_name COLLATE NATURAL, id") : QStringLiteral("file_name, id");
+}
+
+QString DB::fileExtensionExpr() {
+    // Text after the last '.': rtrim strips every trailing character that is not a dot
+    return QStringLiteral("lower(substr(file_name, length(rtrim(file_name, replace(file_name, '.', ''))) + 1))");
+}
+
 bool DB::migrate(){
     // Always enable FK enforcement
     if (!exec("PRAGMA foreign_keys=ON;")) return false;
 
     // Schema versioning via PRAGMA user_version
-    const int kLatestVersion = 2;
+    const int kLatestVersion = 4;
     int ver = schemaUserVersion();
 
     // Base schema (idempotent with IF NOT EXISTS)
@@ -139,6 +177,16 @@ bool DB::migrate(){
         exec("ALTER TABLE assets ADD COLUMN checksum TEXT NULL");
     }
 
+    // 64-bit perceptual hash of the poster frame (stored as signed INTEGER)
+    if (!hasColumn("assets", "perceptual_hash")) {
+        exec("ALTER TABLE assets ADD COLUMN perceptual_hash INTEGER NULL");
+    }
+
+    // File mtime (ms since epoch) the checksum was taken at; a same-size rewrite changes it
+    if (!hasColumn("assets", "checksum_mtime")) {
+        exec("ALTER TABLE assets ADD COLUMN checksum_mtime INTEGER NULL");
+    }
+
     // Version history table
     exec(
         "CREATE TABLE IF NOT EXISTS asset_versions (\n"
@@ -156,10 +204,45 @@ bool DB::migrate(){
     );
     exec("CREATE INDEX IF NOT EXISTS idx_asset_versions_asset_id ON asset_versions(asset_id);");
 
+    // Duplicate finder results (v3); rewritten wholesale by each scan
+    exec(
+        "CREATE TABLE IF NOT EXISTS duplicate_groups (\n"
+        "  id INTEGER PRIMARY KEY AUTOINCREMENT,\n"
+        "  checksum TEXT NOT NULL UNIQUE,\n"
+        "  file_size INTEGER NOT NULL,\n"
+        "  file_count INTEGER NOT NULL,\n"
+        "  found_at TEXT DEFAULT CURRENT_TIMESTAMP\n"
+        ");"
+    );
+    exec(
+        "CREATE TABLE IF NOT EXISTS duplicate_files (\n"
+        "  group_id INTEGER NOT NULL REFERENCES duplicate_groups(id) ON DELETE CASCADE,\n"
+        "  asset_id INTEGER NULL REFERENCES assets(id) ON DELETE CASCADE,\n"
+        "  file_path TEXT NOT NULL,\n"
+        "  PRIMARY KEY (group_id, file_path)\n"
+        ");"
+    );
+    exec("CREATE INDEX IF NOT EXISTS idx_duplicate_files_asset_id ON duplicate_files(asset_id);");
+
+    // Playback proxies (v4); the files themselves live in ProxyManager's cache directory
+    exec(
+        "CREATE TABLE IF NOT EXISTS asset_proxies (\n"
+        "  asset_id INTEGER PRIMARY KEY REFERENCES assets(id) ON DELETE CASCADE,\n"
+        "  source_key TEXT NOT NULL,\n"
+        "  proxy_path TEXT NOT NULL,\n"
+        "  kind TEXT NOT NULL,\n"
+        "  scale INTEGER NOT NULL,\n"
+        "  byte_size INTEGER NOT NULL,\n"
+        "  created_at TEXT DEFAULT CURRENT_TIMESTAMP\n"
+        ");"
+    );
+    exec("CREATE INDEX IF NOT EXISTS idx_asset_proxies_source_key ON asset_proxies(source_key);");
+
     // PERFORMANCE: Add indexes for frequently queried columns
     exec("CREATE INDEX IF NOT EXISTS idx_assets_file_name ON assets(file_name);");
     exec("CREATE INDEX IF NOT EXISTS idx_assets_rating ON assets(rating);");
     exec("CREATE INDEX IF NOT EXISTS idx_assets_updated_at ON assets(updated_at);");
+    exec("CREATE INDEX IF NOT EXISTS idx_assets_file_size ON assets(file_size);");
     exec("CREATE INDEX IF NOT EXISTS idx_asset_tags_tag_id ON asset_tags(tag_id);");
     exec("CREATE INDEX IF NOT EXISTS idx_asset_tags_asset_id ON asset_tags(asset_id);");
 
@@ -169,6 +252,11 @@ bool DB::migrate(){
     exec("CREATE INDEX IF NOT EXISTS idx_assets_folder_mime ON assets(virtual_folder_id, mime_type);");
     exec("CREATE INDEX IF NOT EXISTS idx_assets_sequence_pattern ON assets(sequence_pattern) WHERE is_sequence=1;");
 
+    // Search terms (AssetQuery): ext:, frames: and absolute path: prefixes
+    exec("CREATE INDEX IF NOT EXISTS idx_assets_file_ext ON assets(" + fileExtensionExpr() + ");");
+    exec("CREATE INDEX IF NOT EXISTS idx_assets_sequence_frames ON assets(sequence_frame_count) WHERE is_sequence=1;");
+    exec("CREATE INDEX IF NOT EXISTS idx_assets_file_path_nocase ON assets(file_path COLLATE NOCASE);");
+
     // If we were on an older version, update user_version to latest
     if (ver < kLatestVersion) {
         setSchemaUserVersion(kLatestVersion);
@@ -218,7 +306,9 @@ bool DB::hasColumn(const QString& table, const QString& column) const {
         QStringLiteral("tags"),
         QStringLiteral("asset_tags"),
         QStringLiteral("asset_versions"),
-        QStringLiteral("project_folders")
+        QStringLiteral("project_folders"),
+        QStringLiteral("duplicate_groups"),
+        QStringLiteral("duplicate_files")
     };
     if (!validTables.contains(table)) return false;
 
@@ -518,9 +608,11 @@ void DB::scheduleChecksumJob(int assetId,
 {
     // Compute SHA-256 off the DB/UI thread and apply on DB thread
     QThreadPool::globalInstance()->start([this, assetId, filePath, newSize, oldChecksum, isNewAsset, versionNotes]{
+        // Taken before hashing, so a write during the hash leaves a mismatch behind
+        const qint64 mtimeMs = QFileInfo(filePath).lastModified().toMSecsSinceEpoch();
         const QString sum = computeFileSha256(filePath);
-        QMetaObject::invokeMethod(this, [this, assetId, filePath, newSize, sum, oldChecksum, isNewAsset, versionNotes]{
-            applyChecksumUpdate(assetId, filePath, newSize, sum, oldChecksum, isNewAsset, versionNotes);
+        QMetaObject::invokeMethod(this, [this, assetId, filePath, newSize, mtimeMs, sum, oldChecksum, isNewAsset, versionNotes]{
+            applyChecksumUpdate(assetId, filePath, newSize, mtimeMs, sum, oldChecksum, isNewAsset, versionNotes);
         }, Qt::QueuedConnection);
     });
 }
@@ -528,6 +620,7 @@ void DB::scheduleChecksumJob(int assetId,
 void DB::applyChecksumUpdate(int assetId,
                              const QString& filePath,
                              qint64 newSize,
+                             qint64 mtimeMs,
                              const QString& newChecksum,
                              const QString& oldChecksum,
                              bool isNewAsset,
@@ -538,9 +631,10 @@ void DB::applyChecksumUpdate(int assetId,
     if (isNewAsset) {
         // Initial import: write checksum and create initial version
         QSqlQuery upd(m_db);
-        upd.prepare("UPDATE assets SET file_size=?, checksum=?, updated_at=CURRENT_TIMESTAMP WHERE id=?");
+        upd.prepare("UPDATE assets SET file_size=?, checksum=?, checksum_mtime=?, updated_at=CURRENT_TIMESTAMP WHERE id=?");
         upd.addBindValue(newSize);
         upd.addBindValue(newChecksum);
+        upd.addBindValue(mtimeMs);
         upd.addBindValue(assetId);
         if (!upd.exec()) {
             qWarning() << "applyChecksumUpdate(new): UPDATE failed" << upd.lastError();
@@ -553,15 +647,27 @@ void DB::applyChecksumUpdate(int assetId,
     // Existing asset: create a new version and update checksum only when checksum differs or was missing
     if (oldChecksum.isEmpty() || (!newChecksum.isEmpty() && newChecksum != oldChecksum)) {
         createAssetVersion(assetId, filePath, versionNotes, newChecksum);
+        // Content changed: the perceptual hash is recomputed on the next preview decode
         QSqlQuery upd(m_db);
-        upd.prepare("UPDATE assets SET file_size=?, checksum=?, updated_at=CURRENT_TIMESTAMP WHERE id=?");
+        upd.prepare("UPDATE assets SET file_size=?, checksum=?, checksum_mtime=?, perceptual_hash=NULL, updated_at=CURRENT_TIMESTAMP WHERE id=?");
         upd.addBindValue(newSize);
         upd.addBindValue(newChecksum);
+        upd.addBindValue(mtimeMs);
         upd.addBindValue(assetId);
         if (!upd.exec()) {
             qWarning() << "applyChecksumUpdate(existing): UPDATE failed" << upd.lastError();
+        } else {
+            emit perceptualHashChanged(assetId, false, 0);
         }
         emit assetsChanged(m_rootId);
+    } else if (!newChecksum.isEmpty()) {
+        // Touched but unchanged: remember the new mtime so the checksum stays trusted
+        QSqlQuery upd(m_db);
+        upd.prepare("UPDATE assets SET checksum_mtime=? WHERE id=? AND checksum=?");
+        upd.addBindValue(mtimeMs);
+        upd.addBindValue(assetId);
+        upd.addBindValue(newChecksum);
+        if (!upd.exec()) qWarning() << "applyChecksumUpdate(unchanged): UPDATE failed" << upd.lastError();
     }
 }
 
@@ -587,6 +693,7 @@ bool DB::removeAssets(const QList<int>& assetIds){
         m_db.rollback();
     } else {
         m_db.commit();
+        emit assetsRemoved(assetIds);
     }
     emit assetsChanged(m_rootId);
     return ok;
@@ -716,6 +823,18 @@ QVector<QPair<int, QString>> DB::listTags() const {
     return tags;
 }
 
+QVector<QPair<int, int>> DB::listAssetTagPairs() const {
+    QVector<QPair<int, int>> pairs;
+    QSqlQuery q(m_db);
+    q.setForwardOnly(true);
+    if (!q.exec("SELECT asset_id, tag_id FROM asset_tags ORDER BY tag_id, asset_id")) {
+        qWarning() << "listAssetTagPairs:" << q.lastError();
+        return pairs;
+    }
+    while (q.next()) pairs.append({q.value(0).toInt(), q.value(1).toInt()});
+    return pairs;
+}
+
 QStringList DB::tagsForAsset(int assetId) const {
     QStringList names;
     QSqlQuery q(m_db);
@@ -756,7 +875,7 @@ bool DB::assignTagsToAssets(const QList<int>& assetIds, const QList<int>& tagIds
         if (!ok) { qWarning() << "DB::assignTagsToAssets batch failed" << q.lastError(); break; }
     }
 
-    if (!ok) { m_db.rollback(); } else { m_db.commit(); }
+    if (!ok) { m_db.rollback(); } else { m_db.commit(); emit assetTagsAssigned(assetIds, tagIds); }
     emit assetsChanged(m_rootId);
     return ok;
 }
@@ -908,9 +1027,10 @@ bool DB::revertAssetToVersion(int assetId, int versionId, bool createBackupVersi
     const qint64 newSize = dfi.size();
     const QString newChecksum = vsChecksum;
     QSqlQuery upd(m_db);
-    upd.prepare("UPDATE assets SET file_size=?, checksum=?, updated_at=CURRENT_TIMESTAMP WHERE id=?");
+    upd.prepare("UPDATE assets SET file_size=?, checksum=?, checksum_mtime=?, updated_at=CURRENT_TIMESTAMP WHERE id=?");
     upd.addBindValue(newSize);
     upd.addBindValue(newChecksum);
+    upd.addBindValue(dfi.lastModified().toMSecsSinceEpoch());
     upd.addBindValue(assetId);
     upd.exec();
 
@@ -1059,6 +1179,9 @@ bool DB::clearAllData()
 
     // Delete all data
     bool ok = true;
+    ok &= q.exec("DELETE FROM duplicate_files");
+    ok &= q.exec("DELETE FROM duplicate_groups");
+    ok &= q.exec("DELETE FROM asset_proxies");
     ok &= q.exec("DELETE FROM asset_tags");
     ok &= q.exec("DELETE FROM assets");
     ok &= q.exec("DELETE FROM tags");
@@ -1075,10 +1198,216 @@ bool DB::clearAllData()
     emit foldersChanged();
     emit assetsChanged(m_rootId);
     emit tagsChanged();
+    emit duplicatesChanged();
+
+    return true;
+}
+
+bool DB::replaceDuplicateGroups(const QVector<DuplicateGroupRow>& groups)
+{
+    if (!m_db.transaction()) { qWarning() << "replaceDuplicateGroups: begin transaction failed" << m_db.lastError(); }
+
+    QSqlQuery q(m_db);
+    bool ok = q.exec("DELETE FROM duplicate_files") && q.exec("DELETE FROM duplicate_groups");
+
+    QSqlQuery insGroup(m_db);
+    insGroup.prepare("INSERT INTO duplicate_groups(checksum,file_size,file_count) VALUES(?,?,?)");
+    QSqlQuery insFile(m_db);
+    insFile.prepare("INSERT OR IGNORE INTO duplicate_files(group_id,asset_id,file_path) VALUES(?,?,?)");
+
+    for (const DuplicateGroupRow& g : groups) {
+        if (!ok) break;
+        insGroup.addBindValue(g.checksum);
+        insGroup.addBindValue(g.fileSize);
+        insGroup.addBindValue(g.filePaths.size());
+        if (!insGroup.exec()) { qWarning() << "replaceDuplicateGroups: group insert failed" << insGroup.lastError(); ok = false; break; }
+        const int groupId = insGroup.lastInsertId().toInt();
+        for (int i = 0; i < g.filePaths.size(); ++i) {
+            const int assetId = i < g.assetIds.size() ? g.assetIds[i] : 0;
+            insFile.addBindValue(groupId);
+            insFile.addBindValue(assetId > 0 ? QVariant(assetId) : QVariant(QVariant::Int));
+            insFile.addBindValue(g.filePaths[i]);
+            if (!insFile.exec()) { qWarning() << "replaceDuplicateGroups: file insert failed" << insFile.lastError(); ok = false; break; }
+        }
+    }
+
+    if (ok) m_db.commit(); else m_db.rollback();
+    if (ok) emit duplicatesChanged();
+    return ok;
+}
+
+QVector<DuplicateGroupRow> DB::listDuplicateGroups() const
+{
+    QVector<DuplicateGroupRow> out;
+    QHash<int, int> indexById;
+    QSqlQuery q(m_db);
+    if (!q.exec("SELECT g.id, g.checksum, g.file_size, COALESCE(f.asset_id,0), f.file_path "
+                "FROM duplicate_groups g JOIN duplicate_files f ON f.group_id=g.id "
+                "ORDER BY g.file_size * (g.file_count - 1) DESC, g.id, f.file_path")) {
+        qWarning() << "DB::listDuplicateGroups failed" << q.lastError();
+        return out;
+    }
+    while (q.next()) {
+        const int gid = q.value(0).toInt();
+        auto it = indexById.find(gid);
+        if (it == indexById.end()) {
+            DuplicateGroupRow row;
+            row.id = gid;
+            row.checksum = q.value(1).toString();
+            row.fileSize = q.value(2).toLongLong();
+            out.append(row);
+            it = indexById.insert(gid, out.size() - 1);
+        }
+        DuplicateGroupRow& row = out[it.value()];
+        row.assetIds.append(q.value(3).toInt());
+        row.filePaths.append(q.value(4).toString());
+    }
+    return out;
+}
+
+bool DB::storeComputedChecksums(const QHash<int, ComputedChecksum>& checksums)
+{
+    if (checksums.isEmpty()) return true;
+
+    // Rows whose content changed are collected first and versioned outside the transaction
+    struct Changed { int assetId; QString filePath; QString oldChecksum; ComputedChecksum sum; };
+    QVector<Changed> changed;
+
+    if (!m_db.transaction()) { qWarning() << "storeComputedChecksums: begin transaction failed" << m_db.lastError(); }
+    QSqlQuery sel(m_db);
+    sel.prepare("SELECT file_path, COALESCE(file_size,0), COALESCE(checksum,'') FROM assets WHERE id=?");
+    QSqlQuery upd(m_db);
+    upd.prepare("UPDATE assets SET checksum=?, checksum_mtime=? WHERE id=?");
+    bool ok = true;
+    for (auto it = checksums.constBegin(); it != checksums.constEnd(); ++it) {
+        const ComputedChecksum& c = it.value();
+        if (c.sha256.isEmpty()) continue;
+        sel.addBindValue(it.key());
+        if (!sel.exec()) { qWarning() << "storeComputedChecksums: SELECT failed" << sel.lastError(); ok = false; break; }
+        if (!sel.next()) continue;
+        const QString filePath = sel.value(0).toString();
+        const qint64 size = sel.value(1).toLongLong();
+        const QString stored = sel.value(2).toString();
+        sel.finish();
+        // Guard on size so a file rewritten since it was hashed keeps what it has
+        if (size != c.size) continue;
+        if (!stored.isEmpty() && stored != c.sha256) {
+            changed.append({it.key(), filePath, stored, c});
+            continue;
+        }
+        upd.addBindValue(c.sha256);
+        upd.addBindValue(c.mtimeMs);
+        upd.addBindValue(it.key());
+        if (!upd.exec()) { qWarning() << "storeComputedChecksums: UPDATE failed" << upd.lastError(); ok = false; break; }
+    }
+    if (ok) m_db.commit(); else m_db.rollback();
+
+    for (const Changed& c : std::as_const(changed)) {
+        applyChecksumUpdate(c.assetId, c.filePath, c.sum.size, c.sum.mtimeMs, c.sum.sha256, c.oldChecksum,
+                            /*isNewAsset=*/false, QStringLiteral("Auto-sync: detected change on disk"));
+    }
+    return ok;
+}
+
+bool DB::setPerceptualHash(int assetId, quint64 hash)
+{
+    if (assetId <= 0) return false;
+    QSqlQuery q = prepared(QStringLiteral("setPerceptualHash"), QStringLiteral("UPDATE assets SET perceptual_hash=? WHERE id=?"));
+    q.addBindValue(static_cast<qint64>(hash));
+    q.addBindValue(assetId);
+    if (!q.exec()) {
+        qWarning() << "DB::setPerceptualHash failed" << q.lastError();
+        return false;
+    }
+    emit perceptualHashChanged(assetId, true, hash);
+    return true;
+}
+
+QHash<int, quint64> DB::perceptualHashes() const
+{
+    QHash<int, quint64> out;
+    QSqlQuery q(m_db);
+    q.setForwardOnly(true);
+    if (!q.exec("SELECT id, perceptual_hash FROM assets WHERE perceptual_hash IS NOT NULL")) {
+        qWarning() << "DB::perceptualHashes failed" << q.lastError();
+        return out;
+    }
+    while (q.next()) out.insert(q.value(0).toInt(), static_cast<quint64>(q.value(1).toLongLong()));
+    return out;
+}
+
+bool DB::setAssetProxy(const AssetProxyRow& row)
+{
+    if (row.assetId <= 0 || row.proxyPath.isEmpty()) return false;
+    QSqlQuery q = prepared(QStringLiteral("setAssetProxy"), QStringLiteral(
+        "INSERT OR REPLACE INTO asset_proxies(asset_id, source_key, proxy_path, kind, scale, byte_size) VALUES(?, ?, ?, ?, ?, ?)"));
+    q.addBindValue(row.assetId);
+    q.addBindValue(row.sourceKey);
+    q.addBindValue(row.proxyPath);
+    q.addBindValue(row.kind);
+    q.addBindValue(row.scale);
+    q.addBindValue(row.byteSize);
+    if (!q.exec()) {
+        qWarning() << "DB::setAssetProxy failed" << q.lastError();
+        return false;
+    }
+    emit assetProxyChanged(row.assetId);
+    return true;
+}
 
+bool DB::removeAssetProxy(int assetId)
+{
+    if (assetId <= 0) return false;
+    QSqlQuery q = prepared(QStringLiteral("removeAssetProxy"), QStringLiteral("DELETE FROM asset_proxies WHERE asset_id=?"));
+    q.addBindValue(assetId);
+    if (!q.exec()) {
+        qWarning() << "DB::removeAssetProxy failed" << q.lastError();
+        return false;
+    }
+    if (q.numRowsAffected() > 0) emit assetProxyChanged(assetId);
     return true;
 }
 
+bool DB::removeAssetProxyBySourceKey(const QString& sourceKey)
+{
+    QVector<int> ids;
+    {
+        QSqlQuery q = prepared(QStringLiteral("assetProxiesBySourceKey"), QStringLiteral("SELECT asset_id FROM asset_proxies WHERE source_key=?"));
+        q.addBindValue(sourceKey);
+        if (!q.exec()) {
+            qWarning() << "DB::removeAssetProxyBySourceKey failed" << q.lastError();
+            return false;
+        }
+        while (q.next()) ids.append(q.value(0).toInt());
+    }
+    bool ok = true;
+    for (int id : ids) ok &= removeAssetProxy(id);
+    return ok;
+}
+
+QVector<AssetProxyRow> DB::listAssetProxies() const
+{
+    QVector<AssetProxyRow> out;
+    QSqlQuery q(m_db);
+    q.setForwardOnly(true);
+    if (!q.exec("SELECT asset_id, source_key, proxy_path, kind, scale, byte_size, created_at FROM asset_proxies")) {
+        qWarning() << "DB::listAssetProxies failed" << q.lastError();
+        return out;
+    }
+    while (q.next()) {
+        AssetProxyRow r;
+        r.assetId = q.value(0).toInt();
+        r.sourceKey = q.value(1).toString();
+        r.proxyPath = q.value(2).toString();
+        r.kind = q.value(3).toString();
+        r.scale = q.value(4).toInt();
+        r.byteSize = q.value(5).toLongLong();
+        r.createdAt = q.value(6).toString();
+        out.append(r);
+    }
+    return out;
+}
+
 // Project folder operations
 int DB::createProjectFolder(const QString& name, const QString& path)
 {
@@ -24,6 +24,34 @@ struct AssetVersionRow {
     QString notes;              // optional user notes
 };
 
+// SHA-256 of a file computed outside the checksum job, with the size and
+// mtime it was taken at (see DB::storeComputedChecksums)
+struct ComputedChecksum {
+    qint64 size = 0;
+    qint64 mtimeMs = 0;
+    QString sha256;
+};
+
+// One group of byte-identical files found by DuplicateFinder
+struct DuplicateGroupRow {
+    int id = 0;
+    QString checksum;           // SHA-256 shared by all members
+    qint64 fileSize = 0;
+    QVector<int> assetIds;      // 0 for files outside the catalog
+    QStringList filePaths;      // parallel to assetIds
+};
+
+// Preview proxy generated for an asset by ProxyManager
+struct AssetProxyRow {
+    int assetId = 0;
+    QString sourceKey;          // ProxyManager cache key of the source
+    QString proxyPath;          // movie file, or first frame of a proxy sequence
+    QString kind;               // jpeg_sequence, exr_sequence, mjpeg, h264_intra
+    int scale = 2;              // 1/scale of the source resolution
+    qint64 byteSize = 0;
+    QString createdAt;
+};
+
 class DB : public QObject {
     Q_OBJECT
 public:
@@ -34,6 +62,13 @@ public:
 
     QSqlDatabase database() const { return m_db; }
 
+    // ORDER BY terms for asset names: the NATURAL collation (NaturalSort) when it
+    // could be registered on the connection, plain file_name otherwise; id breaks ties
+    QString fileNameOrderBy() const;
+    // Lower-case extension of file_name as SQL; idx_assets_file_ext indexes exactly
+    // this expression, so queries must spell it the same way to use the index
+    static QString fileExtensionExpr();
+
     // Folder ops
     int ensureRootFolder();
     int createFolder(const QString& name, int parentId);
@@ -76,10 +111,31 @@ public:
     bool mergeTags(int sourceTagId, int targetTagId);
     QVector<QPair<int, QString>> listTags() const;
     QHash<int, QStringList> tagsForAssets(const QList<int>& assetIds) const;
+    // Every (asset_id, tag_id) pair, ordered by tag then asset (see TagIndex)
+    QVector<QPair<int, int>> listAssetTagPairs() const;
 
     bool assignTagsToAssets(const QList<int>& assetIds, const QList<int>& tagIds);
     QStringList tagsForAsset(int assetId) const;
 
+    // Duplicate detection results (see DuplicateFinder)
+    bool replaceDuplicateGroups(const QVector<DuplicateGroupRow>& groups);
+    QVector<DuplicateGroupRow> listDuplicateGroups() const;
+    // Records checksums hashed elsewhere (duplicate scans, verified copies) for rows whose
+    // size still matches. A row without a checksum just takes it: the fast import path
+    // skipped versioning on purpose and a fill-in is not a change of content. A row whose
+    // stored checksum differs goes through applyChecksumUpdate like any detected change.
+    bool storeComputedChecksums(const QHash<int, ComputedChecksum>& checksums);
+
+    // Perceptual (dHash) signatures for similar-image search (see SimilarityIndex)
+    bool setPerceptualHash(int assetId, quint64 hash);
+    QHash<int, quint64> perceptualHashes() const;
+
+    // Playback proxies (see ProxyManager); one per asset, removed with the asset
+    bool setAssetProxy(const AssetProxyRow& row);
+    bool removeAssetProxy(int assetId);
+    bool removeAssetProxyBySourceKey(const QString& sourceKey);
+    QVector<AssetProxyRow> listAssetProxies() const;
+
     // Database management
     bool exportDatabase(const QString& filePath);
     bool importDatabase(const QString& filePath);
@@ -96,14 +152,20 @@ signals:
     void foldersChanged();
     void assetsChanged(int folderId);
     void tagsChanged();
+    void assetTagsAssigned(const QList<int>& assetIds, const QList<int>& tagIds);
     void projectFoldersChanged();
     void assetVersionsChanged(int assetId);
+    void duplicatesChanged();
+    void assetsRemoved(const QList<int>& assetIds);
+    void perceptualHashChanged(int assetId, bool hasHash, quint64 hash);
+    void assetProxyChanged(int assetId);
 
 private:
     explicit DB(QObject* parent=nullptr);
     bool migrate();
     bool exec(const QString& sql);
     bool hasColumn(const QString& table, const QString& column) const;
+    bool registerCollations();
 
     // Prepared statement cache
     QSqlQuery prepared(const QString& key, const QString& sql) const;
@@ -124,6 +186,7 @@ private slots:
     void applyChecksumUpdate(int assetId,
                              const QString& filePath,
                              qint64 newSize,
+                             qint64 mtimeMs,
                              const QString& newChecksum,
                              const QString& oldChecksum,
                              bool isNewAsset,
@@ -136,6 +199,7 @@ private:
     QSqlDatabase m_db;
     int m_rootId = 0;
     QString m_dataDir; // directory that holds the DB; used for version storage
+    bool m_naturalCollation = false;
 
     // Simple prepared statement cache keyed by a stable key name
     mutable QHash<QString, QSqlQuery> m_stmtCache;
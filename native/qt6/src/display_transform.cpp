@@ -0,0 +1,137 @@
+#include "display_transform.h"
+
+#include <QtConcurrent/QtConcurrentMap>
+#include <QVector>
+#include <qfloat16.h>
+#include <cmath>
+#include <cstring>
+
+namespace {
+
+constexpr int kHalfValues = 1 << 16;
+// Frames smaller than this are mapped on the calling thread
+constexpr qint64 kParallelPixels = 256 * 1024;
+constexpr int kBandRows = 64;
+
+float halfBitsToFloat(quint16 bits)
+{
+    qfloat16 h;
+    std::memcpy(&h, &bits, sizeof(bits));
+    return float(h);
+}
+
+uchar toByte(float value)
+{
+    if (!(value > 0.0f)) return 0; // negative and NaN
+    if (value >= 1.0f) return 255;
+    return uchar(value * 255.0f + 0.5f);
+}
+
+float transfer(float value, OIIOImageLoader::ColorSpace colorSpace)
+{
+    switch (colorSpace) {
+    case OIIOImageLoader::ColorSpace::Linear:
+        return value;
+    case OIIOImageLoader::ColorSpace::sRGB:
+        return value <= 0.0031308f ? 12.92f * value : 1.055f * std::pow(value, 1.0f / 2.4f) - 0.055f;
+    case OIIOImageLoader::ColorSpace::Rec709:
+        return value < 0.018f ? 4.5f * value : 1.099f * std::pow(value, 0.45f) - 0.099f;
+    }
+    return value;
+}
+
+} // namespace
+
+DisplayTransform::DisplayTransform()
+    : m_lut(kHalfValues)
+    , m_alpha(kHalfValues)
+{
+    for (int bits = 0; bits < kHalfValues; ++bits) {
+        m_alpha[bits] = toByte(halfBitsToFloat(quint16(bits)));
+    }
+    rebuild();
+}
+
+void DisplayTransform::setColorSpace(OIIOImageLoader::ColorSpace colorSpace)
+{
+    if (colorSpace == m_colorSpace) return;
+    m_colorSpace = colorSpace;
+    rebuild();
+}
+
+void DisplayTransform::setExposure(float stops)
+{
+    if (stops == m_exposure) return;
+    m_exposure = stops;
+    rebuild();
+}
+
+void DisplayTransform::setGamma(float gamma)
+{
+    gamma = qBound(0.1f, gamma, 10.0f);
+    if (gamma == m_gamma) return;
+    m_gamma = gamma;
+    rebuild();
+}
+
+void DisplayTransform::rebuild()
+{
+    const float scale = std::exp2(m_exposure);
+    const float invGamma = 1.0f / m_gamma;
+    for (int bits = 0; bits < kHalfValues; ++bits) {
+        float value = halfBitsToFloat(quint16(bits)) * scale;
+        if (!(value > 0.0f)) {
+            m_lut[bits] = 0;
+            continue;
+        }
+        // Same look as OIIOImageLoader::toneMapHDR: Reinhard, then the transfer curve
+        value = std::isinf(value) ? 1.0f : value / (1.0f + value);
+        value = transfer(value, m_colorSpace);
+        if (m_gamma != 1.0f) value = std::pow(value, invGamma);
+        m_lut[bits] = toByte(value);
+    }
+}
+
+bool DisplayTransform::isLinear(const QImage& image)
+{
+    return image.format() == QImage::Format_RGBA16FPx4 || image.format() == QImage::Format_RGBX16FPx4;
+}
+
+QImage DisplayTransform::apply(const QImage& image) const
+{
+    if (!isLinear(image)) return image;
+    const bool hasAlpha = image.format() == QImage::Format_RGBA16FPx4;
+    QImage out(image.size(), hasAlpha ? QImage::Format_RGBA8888 : QImage::Format_RGBX8888);
+    if (out.isNull()) return out;
+
+    const int width = image.width();
+    const uchar* srcBits = image.constBits();
+    const qsizetype srcStride = image.bytesPerLine();
+    uchar* dstBits = out.bits();
+    const qsizetype dstStride = out.bytesPerLine();
+    const uchar* lut = m_lut.data();
+    const uchar* alphaLut = m_alpha.data();
+
+    auto mapRows = [=](int y0, int y1) {
+        for (int y = y0; y < y1; ++y) {
+            const quint16* src = reinterpret_cast<const quint16*>(srcBits + y * srcStride);
+            uchar* dst = dstBits + y * dstStride;
+            for (int x = 0; x < width; ++x, src += 4, dst += 4) {
+                dst[0] = lut[src[0]];
+                dst[1] = lut[src[1]];
+                dst[2] = lut[src[2]];
+                dst[3] = hasAlpha ? alphaLut[src[3]] : 255;
+            }
+        }
+    };
+
+    const int height = image.height();
+    if (qint64(width) * height < kParallelPixels) {
+        mapRows(0, height);
+        return out;
+    }
+    QVector<int> bands;
+    for (int y = 0; y < height; y += kBandRows) bands.append(y);
+    QtConcurrent::blockingMap(bands, [&](int& y0) { mapRows(y0, qMin(height, y0 + kBandRows)); });
+    return out;
+}
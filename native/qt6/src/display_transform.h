@@ -0,0 +1,46 @@
+#pragma once
+
+#include <QImage>
+#include <vector>
+#include "oiio_image_loader.h"
+
+/**
+ * DisplayTransform - maps scene-linear frames to display values at display time
+ *
+ * HDR frames are kept as scene-linear half floats (see
+ * OIIOImageLoader::loadImageReducedLinear). The view transform is folded into one
+ * 64K-entry table indexed by the half-float bit pattern: exposure, Reinhard tone
+ * mapping, the colour space's transfer curve and an extra display gamma. Changing a
+ * setting only rebuilds the table; apply() is then a table lookup per channel, split
+ * into row bands across threads for large frames. Switching colour space or
+ * dragging exposure never decodes anything again.
+ *
+ * Display-referred (8-bit) images pass through unchanged. Setters must not run
+ * concurrently with apply().
+ */
+class DisplayTransform {
+public:
+    DisplayTransform();
+
+    void setColorSpace(OIIOImageLoader::ColorSpace colorSpace);
+    OIIOImageLoader::ColorSpace colorSpace() const { return m_colorSpace; }
+    void setExposure(float stops);
+    float exposure() const { return m_exposure; }
+    void setGamma(float gamma); // display gamma on top of the transfer curve (1.0 = none)
+    float gamma() const { return m_gamma; }
+
+    // RGBA8888/RGBX8888 display image for a scene-linear image; other images are returned as is
+    QImage apply(const QImage& image) const;
+
+    // Half-float images are treated as scene-linear
+    static bool isLinear(const QImage& image);
+
+private:
+    void rebuild();
+
+    OIIOImageLoader::ColorSpace m_colorSpace = OIIOImageLoader::ColorSpace::sRGB;
+    float m_exposure = 0.0f;
+    float m_gamma = 1.0f;
+    std::vector<uchar> m_lut;   // colour channels, by half-float bits
+    std::vector<uchar> m_alpha; // alpha (clamped only), by half-float bits
+};
@@ -0,0 +1,329 @@
+#include "duplicate_finder.h"
+
+#include <QCryptographicHash>
+#include <QDebug>
+#include <QDirIterator>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QSet>
+#include <QSettings>
+#include <QSqlQuery>
+#include <QThread>
+#include <QThreadPool>
+#include <QtConcurrent/QtConcurrent>
+#include <algorithm>
+
+namespace {
+
+constexpr int kStageSizes = 0;
+constexpr int kStagePartial = 1;
+constexpr int kStageFull = 2;
+
+// Shared MB/s cap across all hashing threads of one scan
+class ReadBudget {
+public:
+    explicit ReadBudget(int maxMBps) : m_bytesPerSec(qint64(qMax(0, maxMBps)) * 1024 * 1024) { m_clock.start(); }
+
+    void consume(qint64 bytes)
+    {
+        if (m_bytesPerSec <= 0 || bytes <= 0) return;
+        const qint64 total = m_consumed.fetch_add(bytes) + bytes;
+        const qint64 dueMs = total * 1000 / m_bytesPerSec;
+        const qint64 aheadMs = dueMs - m_clock.elapsed();
+        if (aheadMs > 0) QThread::msleep(static_cast<unsigned long>(qMin<qint64>(aheadMs, 1000)));
+    }
+
+private:
+    const qint64 m_bytesPerSec;
+    std::atomic<qint64> m_consumed{0};
+    QElapsedTimer m_clock;
+};
+
+bool isCancelled(const std::atomic_bool* cancel)
+{
+    return cancel && cancel->load(std::memory_order_relaxed);
+}
+
+QString fullSha256(const QString& path, ReadBudget& budget, const std::atomic_bool* cancel)
+{
+    QFile f(path);
+    if (!f.open(QIODevice::ReadOnly)) return QString();
+    QCryptographicHash hasher(QCryptographicHash::Sha256);
+    QByteArray buf;
+    buf.resize(1 << 20); // 1MB, same as DB checksum jobs
+    while (true) {
+        if (isCancelled(cancel)) return QString();
+        const qint64 n = f.read(buf.data(), buf.size());
+        if (n <= 0) break;
+        budget.consume(n);
+        hasher.addData(buf.constData(), (int)n);
+    }
+    return hasher.result().toHex();
+}
+
+} // namespace
+
+DuplicateFinder& DuplicateFinder::instance()
+{
+    static DuplicateFinder s;
+    return s;
+}
+
+DuplicateFinder::DuplicateFinder()
+{
+    connect(&m_watcher, &QFutureWatcher<ScanResult>::finished, this, &DuplicateFinder::applyResult);
+}
+
+DuplicateFinder::Options DuplicateFinder::optionsFromSettings()
+{
+    QSettings s("AugmentCode", "KAssetManager");
+    Options o;
+    o.maxConcurrentReads = qBound(1, s.value("Duplicates/MaxConcurrentReads", 4).toInt(), 64);
+    o.maxReadMBps = qMax(0, s.value("Duplicates/MaxReadMBps", 0).toInt());
+    return o;
+}
+
+QByteArray DuplicateFinder::partialHash(const QString& path, qint64 size, qint64 blockSize)
+{
+    QFile f(path);
+    if (!f.open(QIODevice::ReadOnly)) return QByteArray();
+    QCryptographicHash hasher(QCryptographicHash::Md5);
+    // Head, middle and tail blocks: re-encodes and truncated copies of the same
+    // plate usually differ in at least one of them
+    const qint64 offsets[3] = { 0, qMax<qint64>(0, size / 2 - blockSize / 2), qMax<qint64>(0, size - blockSize) };
+    QByteArray buf;
+    buf.resize(static_cast<int>(blockSize));
+    for (qint64 off : offsets) {
+        if (!f.seek(off)) return QByteArray();
+        const qint64 n = f.read(buf.data(), blockSize);
+        if (n < 0) return QByteArray();
+        hasher.addData(buf.constData(), (int)n);
+    }
+    return hasher.result();
+}
+
+QVector<DuplicateGroupRow> DuplicateFinder::findDuplicates(QVector<Entry>& entries,
+                                                           const Options& opts,
+                                                           const std::atomic_bool* cancel,
+                                                           const ProgressFn& progress)
+{
+    QVector<DuplicateGroupRow> groups;
+    const qint64 block = qMax<qint64>(4096, opts.partialBlockSize);
+
+    // Stage 0: size buckets; anything with a unique size cannot have a duplicate
+    QHash<qint64, QVector<int>> bySize;
+    for (int i = 0; i < entries.size(); ++i) {
+        if (entries[i].size >= opts.minFileSize) bySize[entries[i].size].append(i);
+    }
+    QVector<int> smallNeedFull;   // small enough that the full hash is as cheap as a partial one
+    QVector<int> needPartial;
+    qint64 partialBytes = 0;
+    for (auto it = bySize.constBegin(); it != bySize.constEnd(); ++it) {
+        const QVector<int>& members = it.value();
+        if (members.size() < 2) continue;
+        bool allKnown = true;
+        for (int idx : members) if (entries[idx].checksum.isEmpty()) { allKnown = false; break; }
+        if (allKnown) continue;
+        for (int idx : members) {
+            if (it.key() <= 3 * block) {
+                if (entries[idx].checksum.isEmpty()) smallNeedFull.append(idx);
+            } else {
+                needPartial.append(idx);
+                partialBytes += 3 * block;
+            }
+        }
+    }
+    if (progress) progress(kStageSizes, entries.size(), entries.size());
+    if (isCancelled(cancel)) return groups;
+
+    QThreadPool pool;
+    pool.setMaxThreadCount(qMax(1, opts.maxConcurrentReads));
+    ReadBudget budget(opts.maxReadMBps);
+
+    // Stage 1: partial hashes for large candidates
+    std::atomic<qint64> done{0};
+    QtConcurrent::blockingMap(&pool, needPartial, [&](int& idx) {
+        if (isCancelled(cancel)) return;
+        Entry& e = entries[idx];
+        budget.consume(3 * block);
+        e.partialHash = partialHash(e.filePath, e.size, block);
+        const qint64 d = done.fetch_add(3 * block) + 3 * block;
+        if (progress) progress(kStagePartial, d, partialBytes);
+    });
+    if (isCancelled(cancel)) return groups;
+
+    // Survivors: (size, partial) buckets with at least two members
+    QVector<int> needFull = smallNeedFull;
+    {
+        QHash<QPair<qint64, QByteArray>, QVector<int>> byPartial;
+        for (int idx : needPartial) {
+            if (entries[idx].partialHash.isEmpty()) continue; // unreadable
+            byPartial[qMakePair(entries[idx].size, entries[idx].partialHash)].append(idx);
+        }
+        for (const QVector<int>& members : std::as_const(byPartial)) {
+            if (members.size() < 2) continue;
+            for (int idx : members) if (entries[idx].checksum.isEmpty()) needFull.append(idx);
+        }
+    }
+
+    // Stage 2: full SHA-256, only for survivors without a stored checksum
+    qint64 fullBytes = 0;
+    for (int idx : std::as_const(needFull)) fullBytes += entries[idx].size;
+    done.store(0);
+    QtConcurrent::blockingMap(&pool, needFull, [&](int& idx) {
+        if (isCancelled(cancel)) return;
+        Entry& e = entries[idx];
+        const QString sum = fullSha256(e.filePath, budget, cancel);
+        if (!sum.isEmpty()) {
+            e.checksum = sum;
+            e.checksumComputed = true;
+        }
+        const qint64 d = done.fetch_add(e.size) + e.size;
+        if (progress) progress(kStageFull, d, fullBytes);
+    });
+    if (isCancelled(cancel)) return groups;
+
+    // Final grouping by (size, checksum) over every size-bucket member that has one
+    QHash<QPair<qint64, QString>, QVector<int>> byChecksum;
+    for (auto it = bySize.constBegin(); it != bySize.constEnd(); ++it) {
+        if (it.value().size() < 2) continue;
+        for (int idx : it.value()) {
+            if (!entries[idx].checksum.isEmpty())
+                byChecksum[qMakePair(it.key(), entries[idx].checksum)].append(idx);
+        }
+    }
+    for (auto it = byChecksum.constBegin(); it != byChecksum.constEnd(); ++it) {
+        if (it.value().size() < 2) continue;
+        DuplicateGroupRow row;
+        row.checksum = it.key().second;
+        row.fileSize = it.key().first;
+        QVector<int> members = it.value();
+        std::sort(members.begin(), members.end(), [&](int a, int b) { return entries[a].filePath < entries[b].filePath; });
+        for (int idx : members) {
+            row.assetIds.append(entries[idx].assetId);
+            row.filePaths.append(entries[idx].filePath);
+        }
+        groups.append(row);
+    }
+    std::sort(groups.begin(), groups.end(), [](const DuplicateGroupRow& a, const DuplicateGroupRow& b) {
+        const qint64 wa = a.fileSize * (a.filePaths.size() - 1);
+        const qint64 wb = b.fileSize * (b.filePaths.size() - 1);
+        if (wa != wb) return wa > wb;
+        return a.checksum < b.checksum;
+    });
+    return groups;
+}
+
+QVector<DuplicateFinder::Entry> DuplicateFinder::collectCatalogEntries() const
+{
+    QVector<Entry> out;
+    QSqlQuery q(DB::instance().database());
+    // Sequences are stored as one row pointing at the first frame; comparing those
+    // would report the first frame only, so they are left out of catalog scans
+    if (!q.exec("SELECT id, file_path, COALESCE(file_size,0), COALESCE(checksum,''), COALESCE(checksum_mtime,0) FROM assets "
+                "WHERE COALESCE(is_sequence,0)=0")) {
+        qWarning() << "[DuplicateFinder] Catalog query failed:" << q.lastError();
+        return out;
+    }
+    while (q.next()) {
+        Entry e;
+        e.assetId = q.value(0).toInt();
+        e.filePath = q.value(1).toString();
+        e.size = q.value(2).toLongLong();
+        e.checksum = q.value(3).toString();
+        e.mtimeMs = q.value(4).toLongLong();
+        out.append(e);
+    }
+    return out;
+}
+
+bool DuplicateFinder::start(bool includeCatalog, const QStringList& extraRoots)
+{
+    if (m_watcher.isRunning()) return false;
+    m_cancel.store(false);
+
+    // DB access stays on the DB thread; only paths and recorded sizes go to the worker
+    QVector<Entry> catalog = includeCatalog ? collectCatalogEntries() : QVector<Entry>();
+    const Options opts = optionsFromSettings();
+    qInfo() << "[DuplicateFinder] Starting scan:" << catalog.size() << "catalog assets," << extraRoots.size()
+            << "extra roots, readers" << opts.maxConcurrentReads << "cap MB/s" << opts.maxReadMBps;
+    emit scanStarted();
+
+    m_watcher.setFuture(QtConcurrent::run([this, catalog, extraRoots, opts]() mutable {
+        ScanResult result;
+        QVector<Entry> entries;
+        entries.reserve(catalog.size());
+        QSet<QString> seen;
+
+        // Re-stat catalog rows: drop missing files, distrust checksums whose size or mtime
+        // changed (a re-rendered frame or a metadata rewrite often keeps the size)
+        for (Entry& e : catalog) {
+            if (m_cancel.load()) break;
+            QFileInfo fi(e.filePath);
+            if (!fi.isFile()) continue;
+            const QString abs = fi.absoluteFilePath();
+            if (seen.contains(abs)) continue;
+            seen.insert(abs);
+            const qint64 mtimeMs = fi.lastModified().toMSecsSinceEpoch();
+            if (fi.size() != e.size || mtimeMs != e.mtimeMs) e.checksum.clear();
+            e.size = fi.size();
+            e.mtimeMs = mtimeMs;
+            entries.append(e);
+        }
+        for (const QString& root : extraRoots) {
+            QDirIterator it(root, QDir::Files | QDir::NoDotAndDotDot | QDir::Hidden, QDirIterator::Subdirectories);
+            while (it.hasNext() && !m_cancel.load()) {
+                it.next();
+                const QFileInfo fi = it.fileInfo();
+                if (fi.isSymLink()) continue;
+                const QString abs = fi.absoluteFilePath();
+                if (seen.contains(abs)) continue;
+                seen.insert(abs);
+                Entry e;
+                e.filePath = abs;
+                e.size = fi.size();
+                entries.append(e);
+            }
+        }
+
+        // Workers report per file; only forward whole-percent changes to the UI
+        std::atomic<int> lastStep{-1};
+        result.groups = findDuplicates(entries, opts, &m_cancel, [this, &lastStep](int stage, qint64 d, qint64 t) {
+            const int step = stage * 101 + (t > 0 ? int(d * 100 / t) : 100);
+            if (lastStep.exchange(step) != step) emit scanProgress(stage, d, t);
+        });
+        result.cancelled = m_cancel.load();
+        for (const Entry& e : std::as_const(entries)) {
+            if (e.assetId > 0 && e.checksumComputed) result.newChecksums.insert(e.assetId, {e.size, e.mtimeMs, e.checksum});
+        }
+        return result;
+    }));
+    return true;
+}
+
+void DuplicateFinder::cancel()
+{
+    m_cancel.store(true);
+}
+
+void DuplicateFinder::applyResult()
+{
+    const ScanResult result = m_watcher.result();
+
+    // Keep whatever checksums were computed, even for a cancelled scan, so the next run resumes cheaply
+    DB::instance().storeComputedChecksums(result.newChecksums);
+
+    if (result.cancelled) {
+        qInfo() << "[DuplicateFinder] Scan cancelled;" << result.newChecksums.size() << "checksums saved";
+        emit scanFinished(true, 0, 0);
+        return;
+    }
+
+    qint64 reclaimable = 0;
+    for (const DuplicateGroupRow& g : result.groups) reclaimable += g.fileSize * (g.filePaths.size() - 1);
+    DB::instance().replaceDuplicateGroups(result.groups);
+    qInfo() << "[DuplicateFinder] Found" << result.groups.size() << "duplicate groups," << reclaimable
+            << "bytes reclaimable;" << result.newChecksums.size() << "new checksums";
+    emit scanFinished(false, result.groups.size(), reclaimable);
+}
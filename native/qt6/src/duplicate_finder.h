@@ -0,0 +1,96 @@
+#pragma once
+
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <QHash>
+#include <QPair>
+#include <QFutureWatcher>
+#include <atomic>
+#include <functional>
+
+#include "db.h"
+
+/**
+ * @brief Library-wide duplicate detection job
+ *
+ * Narrows candidates in three passes so that only files which can still be
+ * duplicates are read in full:
+ *   1. group by file size (stat only, no I/O)
+ *   2. partial hash of head/middle/tail blocks within each size group
+ *   3. full SHA-256 of the survivors
+ *
+ * Catalog assets that already carry a checksum (and whose size and mtime still
+ * match the ones it was taken at) skip the full-hash pass, and checksums
+ * computed here are written back through DB::storeComputedChecksums(), so
+ * repeated scans only read new or changed files.
+ * Hashing runs on a dedicated pool bounded by an I/O budget (concurrent
+ * readers and optional MB/s cap). Results are stored in the duplicate_groups /
+ * duplicate_files tables via DB::replaceDuplicateGroups().
+ */
+class DuplicateFinder : public QObject {
+    Q_OBJECT
+
+public:
+    struct Entry {
+        int assetId = 0;            // 0 for files outside the catalog
+        QString filePath;
+        qint64 size = 0;
+        QString checksum;           // known SHA-256 (may be empty)
+        qint64 mtimeMs = 0;         // catalog: mtime the checksum was taken at; then the file's mtime
+        QByteArray partialHash;     // filled by the partial pass
+        bool checksumComputed = false;
+    };
+
+    struct Options {
+        int maxConcurrentReads = 4;     // hashing threads
+        int maxReadMBps = 0;            // 0 = unthrottled
+        qint64 minFileSize = 1;         // ignore empty files by default
+        qint64 partialBlockSize = 64 * 1024;
+    };
+
+    // Stage: 0 = sizes, 1 = partial hash, 2 = full hash
+    using ProgressFn = std::function<void(int stage, qint64 bytesDone, qint64 bytesTotal)>;
+
+    static DuplicateFinder& instance();
+
+    // Scan the catalog and/or extra filesystem roots in the background
+    bool start(bool includeCatalog, const QStringList& extraRoots = QStringList());
+    void cancel();
+    bool isRunning() const { return m_watcher.isRunning(); }
+
+    static Options optionsFromSettings();
+
+    // Synchronous pipeline (runs on the calling thread, hashes on an internal pool).
+    // Entries with newly computed checksums have checksumComputed set on return.
+    static QVector<DuplicateGroupRow> findDuplicates(QVector<Entry>& entries,
+                                                     const Options& opts,
+                                                     const std::atomic_bool* cancel = nullptr,
+                                                     const ProgressFn& progress = ProgressFn());
+
+    static QByteArray partialHash(const QString& path, qint64 size, qint64 blockSize);
+
+signals:
+    void scanStarted();
+    void scanProgress(int stage, qint64 bytesDone, qint64 bytesTotal);
+    void scanFinished(bool cancelled, int groupCount, qint64 reclaimableBytes);
+
+private:
+    DuplicateFinder();
+    ~DuplicateFinder() = default;
+    DuplicateFinder(const DuplicateFinder&) = delete;
+    DuplicateFinder& operator=(const DuplicateFinder&) = delete;
+
+    struct ScanResult {
+        bool cancelled = false;
+        QVector<DuplicateGroupRow> groups;
+        QHash<int, ComputedChecksum> newChecksums;
+    };
+
+    QVector<Entry> collectCatalogEntries() const;
+    void applyResult();
+
+    QFutureWatcher<ScanResult> m_watcher;
+    std::atomic_bool m_cancel{false};
+};
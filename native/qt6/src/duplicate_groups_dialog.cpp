@@ -0,0 +1,79 @@
+#include "duplicate_groups_dialog.h"
+#include "duplicate_finder.h"
+#include "drag_utils.h"
+#include "db.h"
+
+#include <QVBoxLayout>
+#include <QHBoxLayout>
+#include <QHeaderView>
+#include <QLocale>
+
+DuplicateGroupsDialog::DuplicateGroupsDialog(QWidget* parent) : QDialog(parent)
+{
+    setWindowTitle("Duplicate Files");
+    resize(760, 480);
+
+    QVBoxLayout* v = new QVBoxLayout(this);
+    summary = new QLabel(this);
+    v->addWidget(summary);
+
+    tree = new QTreeWidget(this);
+    tree->setHeaderLabels({"File", "Size", "Asset"});
+    tree->setRootIsDecorated(true);
+    tree->setUniformRowHeights(true);
+    tree->header()->setSectionResizeMode(0, QHeaderView::Stretch);
+    tree->header()->setSectionResizeMode(1, QHeaderView::ResizeToContents);
+    tree->header()->setSectionResizeMode(2, QHeaderView::ResizeToContents);
+    v->addWidget(tree);
+
+    QHBoxLayout* h = new QHBoxLayout(nullptr);  // Will be added to v, which manages it
+    rescanBtn = new QPushButton("Scan Again", this);
+    closeBtn = new QPushButton("Close", this);
+    h->addWidget(rescanBtn);
+    h->addStretch();
+    h->addWidget(closeBtn);
+    v->addLayout(h);
+
+    DuplicateFinder& finder = DuplicateFinder::instance();
+    connect(&DB::instance(), &DB::duplicatesChanged, this, &DuplicateGroupsDialog::refresh);
+    connect(&finder, &DuplicateFinder::scanStarted, this, [this] { rescanBtn->setEnabled(false); });
+    connect(&finder, &DuplicateFinder::scanFinished, this, [this] { rescanBtn->setEnabled(true); });
+    connect(rescanBtn, &QPushButton::clicked, this, [] { DuplicateFinder::instance().start(/*includeCatalog=*/true); });
+    connect(closeBtn, &QPushButton::clicked, this, &QDialog::close);
+    connect(tree, &QTreeWidget::itemActivated, this, &DuplicateGroupsDialog::onItemActivated);
+
+    rescanBtn->setEnabled(!finder.isRunning());
+    refresh();
+}
+
+void DuplicateGroupsDialog::refresh()
+{
+    const QVector<DuplicateGroupRow> groups = DB::instance().listDuplicateGroups();
+    const QLocale locale;
+    tree->clear();
+    qint64 reclaimable = 0;
+    for (const DuplicateGroupRow& g : groups) {
+        const qint64 extra = g.fileSize * (g.filePaths.size() - 1);
+        reclaimable += extra;
+        QTreeWidgetItem* groupItem = new QTreeWidgetItem(tree);
+        groupItem->setText(0, QString("%1 identical files (%2 reclaimable)").arg(g.filePaths.size()).arg(locale.formattedDataSize(extra)));
+        groupItem->setText(1, locale.formattedDataSize(g.fileSize));
+        groupItem->setToolTip(0, QString("SHA-256 %1").arg(g.checksum));
+        for (int i = 0; i < g.filePaths.size(); ++i) {
+            QTreeWidgetItem* fileItem = new QTreeWidgetItem(groupItem);
+            fileItem->setText(0, g.filePaths[i]);
+            fileItem->setToolTip(0, g.filePaths[i]);
+            fileItem->setText(2, g.assetIds.value(i) > 0 ? QString::number(g.assetIds[i]) : QString("-"));
+        }
+    }
+    tree->expandAll();
+    summary->setText(groups.isEmpty()
+        ? QString("No duplicates found. Run Tools > Find Duplicates to scan the library.")
+        : QString("%1 groups, %2 reclaimable").arg(groups.size()).arg(locale.formattedDataSize(reclaimable)));
+}
+
+void DuplicateGroupsDialog::onItemActivated(QTreeWidgetItem* item, int)
+{
+    if (!item || !item->parent()) return;
+    DragUtils::instance().showInExplorer(item->text(0));
+}
@@ -0,0 +1,23 @@
+#pragma once
+#include <QDialog>
+#include <QTreeWidget>
+#include <QPushButton>
+#include <QLabel>
+
+// Lists the groups stored by the last DuplicateFinder scan, largest reclaimable first.
+// Double-clicking a file shows it in the file browser.
+class DuplicateGroupsDialog : public QDialog {
+    Q_OBJECT
+public:
+    explicit DuplicateGroupsDialog(QWidget* parent=nullptr);
+
+private slots:
+    void refresh();
+    void onItemActivated(QTreeWidgetItem* item, int column);
+
+private:
+    QTreeWidget* tree;
+    QLabel* summary;
+    QPushButton* rescanBtn;
+    QPushButton* closeBtn;
+};
@@ -4,6 +4,8 @@
 #include <QDir>
 #include <QDebug>
 #include <QCoreApplication>
+
+#ifdef Q_OS_WIN
 #include <windows.h>
 
 // Everything SDK function pointer typedefs
@@ -25,6 +27,10 @@ typedef DWORD (__stdcall *Everything_GetMajorVersion_t)();
 typedef DWORD (__stdcall *Everything_GetMinorVersion_t)();
 typedef DWORD (__stdcall *Everything_GetRevision_t)();
 typedef BOOL (__stdcall *Everything_IsDBLoaded_t)();
+#else
+// No Everything service outside Windows: queries go to the built-in filename index
+#include "filename_index.h"
+#endif
 
 EverythingSearch& EverythingSearch::instance() {
     static EverythingSearch instance;
@@ -63,6 +69,13 @@ bool EverythingSearch::initialize() {
     if (m_available) {
         return true;
     }
+
+#ifndef Q_OS_WIN
+    FilenameIndex::instance().start();
+    m_available = true;
+    qInfo() << "[EverythingSearch] Using built-in filename index -" << FilenameIndex::instance().entryCount() << "entries";
+    return true;
+#endif
     
     if (!loadDLL()) {
         qWarning() << "[EverythingSearch] Failed to load Everything DLL";
@@ -137,6 +150,9 @@ void EverythingSearch::unloadDLL() {
 
 bool EverythingSearch::loadFunctions() {
     if (!m_library) return false;
+#ifndef Q_OS_WIN
+    return false;
+#else
     
     // Load all required function pointers
     m_setSearch = (Everything_SetSearchW_t)m_library->resolve("Everything_SetSearchW");
@@ -165,15 +181,23 @@ bool EverythingSearch::loadFunctions() {
     }
     
     return true;
+#endif
 }
 
 bool EverythingSearch::isEverythingRunning() const {
+#ifndef Q_OS_WIN
+    return m_available;
+#else
     if (!m_isDBLoaded) return false;
     auto func = reinterpret_cast<Everything_IsDBLoaded_t>(m_isDBLoaded);
     return func() != 0;
+#endif
 }
 
 QString EverythingSearch::getVersion() const {
+#ifndef Q_OS_WIN
+    return "Built-in index";
+#else
     if (!m_getMajorVersion || !m_getMinorVersion || !m_getRevision) {
         return "Unknown";
     }
@@ -187,6 +211,7 @@ QString EverythingSearch::getVersion() const {
     DWORD revision = getRev();
 
     return QString("%1.%2.%3").arg(major).arg(minor).arg(revision);
+#endif
 }
 
 QVector<EverythingResult> EverythingSearch::search(const QString& query, int maxResults) {
@@ -196,6 +221,10 @@ QVector<EverythingResult> EverythingSearch::search(const QString& query, int max
         qWarning() << "[EverythingSearch] Not initialized";
         return results;
     }
+
+#ifndef Q_OS_WIN
+    return FilenameIndex::instance().search(query, maxResults);
+#else
     
     // Cast function pointers
     auto setSearch = reinterpret_cast<Everything_SetSearchW_t>(m_setSearch);
@@ -282,6 +311,7 @@ QVector<EverythingResult> EverythingSearch::search(const QString& query, int max
     }
     
     return results;
+#endif
 }
 
 QVector<EverythingResult> EverythingSearch::searchWithFilter(const QString& query, const QString& fileTypes, int maxResults) {
@@ -290,7 +320,10 @@ QVector<EverythingResult> EverythingSearch::searchWithFilter(const QString& quer
     QString fullQuery = query;
     
     if (!fileTypes.isEmpty()) {
-        QStringList types = fileTypes.split(';', Qt::SkipEmptyParts);
+        // Callers pass either "exr;dpx" or a ready "ext:exr;dpx"
+        QString typeList = fileTypes;
+        if (typeList.startsWith("ext:", Qt::CaseInsensitive)) typeList = typeList.mid(4);
+        QStringList types = typeList.split(';', Qt::SkipEmptyParts);
         if (!types.isEmpty()) {
             fullQuery += " ext:" + types.join(';');
         }
@@ -10,6 +10,7 @@
 // Everything SDK function pointers
 // Download Everything SDK from: https://www.voidtools.com/support/everything/sdk/
 // Extract Everything.dll and Everything.lib to third_party/everything/
+// On other platforms the same API is answered by FilenameIndex (filename_index.h)
 
 struct EverythingResult {
     QString fullPath;
@@ -9,12 +9,20 @@
 #include <QDateTime>
 #include <QApplication>
 #include <QSqlQuery>
+#include <QFileDialog>
+#ifndef Q_OS_WIN
+#include "filename_index.h"
+#endif
 
 EverythingSearchDialog::EverythingSearchDialog(Mode mode, QWidget* parent)
     : QDialog(parent)
     , m_mode(mode)
 {
+#ifdef Q_OS_WIN
     QString title = (mode == AssetManagerMode) ? "Everything Search - Asset Manager" : "Everything Search - File Manager";
+#else
+    QString title = (mode == AssetManagerMode) ? "File Search - Asset Manager" : "File Search - File Manager";
+#endif
     setWindowTitle(title);
     resize(1000, 600);
 
@@ -32,6 +40,19 @@ EverythingSearchDialog::EverythingSearchDialog(Mode mode, QWidget* parent)
         m_searchEdit->setEnabled(false);
         m_searchButton->setEnabled(false);
     }
+
+#ifndef Q_OS_WIN
+    // Show how far the built-in index has got until there are results to show
+    auto showIndexStatus = [this]() {
+        if (!m_currentResults.isEmpty()) return;
+        const FilenameIndex& index = FilenameIndex::instance();
+        m_statusLabel->setText(QString("%1 files and folders indexed%2")
+                                   .arg(index.entryCount())
+                                   .arg(index.isIndexing() ? " (indexing...)" : ""));
+    };
+    connect(&FilenameIndex::instance(), &FilenameIndex::indexChanged, this, showIndexStatus);
+    showIndexStatus();
+#endif
 }
 
 QStringList EverythingSearchDialog::getSelectedPaths() const {
@@ -75,6 +96,21 @@ void EverythingSearchDialog::setupUI() {
     
     m_matchCaseCheck = new QCheckBox("Match Case", this);
     filterLayout->addWidget(m_matchCaseCheck);
+
+#ifndef Q_OS_WIN
+    // Project folders are always indexed; other folders are added here
+    QPushButton* addFolderButton = new QPushButton("Add Folder to Index...", this);
+    addFolderButton->setToolTip("Also index: " + (FilenameIndex::instance().userRoots().isEmpty()
+                                                      ? QString("(none)")
+                                                      : FilenameIndex::instance().userRoots().join(", ")));
+    connect(addFolderButton, &QPushButton::clicked, this, [this, addFolderButton]() {
+        const QString dir = QFileDialog::getExistingDirectory(this, "Add Folder to Index");
+        if (dir.isEmpty()) return;
+        FilenameIndex::instance().addUserRoot(dir);
+        addFolderButton->setToolTip("Also index: " + FilenameIndex::instance().userRoots().join(", "));
+    });
+    filterLayout->addWidget(addFolderButton);
+#endif
     
     filterLayout->addStretch();
     m_mainLayout->addLayout(filterLayout);
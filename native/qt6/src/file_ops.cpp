@@ -12,8 +12,9 @@
 #include <QAbstractButton>
 #include <QPushButton>
 #include <QDebug>
+#include <QDateTime>
 
-#include "file_utils.h"
+#include "transfer_scheduler.h"
 #include <QApplication>
 #include <QWidget>
 
@@ -75,6 +76,16 @@ void FileOpsQueue::enqueueCopy(const QStringList& sources, const QString& destin
     }
 }
 
+void FileOpsQueue::enqueueVerifiedCopy(const QStringList& sources, const QString& destination)
+{
+    if (sources.isEmpty()) return;
+    QMutexLocker lk(&m_mutex);
+    Item it; it.id = m_nextId++; it.type = Type::Copy; it.sources = sources; it.destination = destination; it.status = "Queued"; it.totalFiles = sources.size(); it.verify = true;
+    m_queue.push_back(it);
+    emit queueChanged();
+    if (!m_running) { lk.unlock(); startNext(); }
+}
+
 void FileOpsQueue::enqueueMove(const QStringList& sources, const QString& destination)
 {
     if (sources.isEmpty()) return;
@@ -140,6 +151,7 @@ void FileOpsQueue::startNext()
     const QStringList sources = item.sources;
     const QString dest = item.destination;
     const bool permanent = item.permanentDelete;
+    const bool verify = item.verify;
 
     emit currentItemChanged(item);
     emit queueChanged();
@@ -160,7 +172,7 @@ void FileOpsQueue::startNext()
 #endif
 
     // Run in background using OS handlers
-    m_future = QtConcurrent::run([this, itemId, type, sources, dest, permanent
+    m_future = QtConcurrent::run([this, itemId, type, sources, dest, permanent, verify
 #ifdef _WIN32
         , ownerHwnd
 #endif
@@ -172,6 +184,57 @@ void FileOpsQueue::startNext()
                 << "sources:" << sources
                 << (type != Type::Delete ? QString("dest=%1").arg(dest) : QString());
         QString codeStr;
+        const int concurrency = TransferScheduler::defaultConcurrency();
+        auto onProgress = [this, itemId](const TransferScheduler::Progress& p) {
+            {
+                QMutexLocker lk(&m_mutex);
+                for (auto& it : m_queue) if (it.id == itemId) {
+                    it.completedFiles = p.filesDone;
+                    it.totalFiles = p.filesTotal;
+                    it.completedBytes = p.bytesDone;
+                    it.totalBytes = p.bytesTotal;
+                    if (!p.currentFile.isEmpty()) it.currentFile = p.currentFile;
+                    break;
+                }
+            }
+            emit progressChanged(p.filesDone, p.filesTotal, p.currentFile);
+            emit bytesProgressChanged(p.bytesDone, p.bytesTotal, p.currentFile);
+        };
+        auto finish = [&]() {
+            emit itemFinished(itemId, success, opError);
+
+            // Update and prune queue entry
+            QMutexLocker lk2(&m_mutex);
+            for (int i=0;i<m_queue.size();++i) if (m_queue[i].id == itemId) {
+                if (!success) m_queue[i].status = aborted ? "Cancelled" : "Failed"; else m_queue[i].status = "Completed";
+                m_queue.removeAt(i);
+                break;
+            }
+            emit queueChanged();
+        };
+
+        if (verify) {
+            // Verified copies bypass the OS handlers on every platform: the source is hashed in
+            // flight, each destination is re-read from disk and compared, then an MHL manifest
+            // is written into the destination folder
+            const QDateTime startedAt = QDateTime::currentDateTime();
+            const TransferScheduler::Plan plan = TransferScheduler::planCopy(sources, dest);
+            QVector<TransferScheduler::VerifiedFile> verified;
+            success = TransferScheduler::executeVerifiedCopy(plan, m_cancel, concurrency, onProgress, &verified, &opError);
+            aborted = !success && m_cancel.load();
+            QString manifestPath;
+            if (success) {
+                manifestPath = TransferScheduler::writeManifest(dest, verified, startedAt, &opError);
+                success = !manifestPath.isEmpty();
+            }
+            if (aborted) opError.clear();
+            qInfo() << "[FileOps] Done verified" << typeToString(type) << "success=" << success << "aborted=" << aborted
+                    << "files=" << verified.size() << "manifest=" << manifestPath
+                    << (opError.isEmpty() ? QString() : QString("error=%1").arg(opError));
+            if (success) emit transferVerified(itemId, verified, manifestPath);
+            finish();
+            return;
+        }
 
 #ifdef _WIN32
         // Prefer modern IFileOperation to ensure proper OS UI dialogs
@@ -288,103 +351,32 @@ void FileOpsQueue::startNext()
                 << "success=" << success << "aborted=" << aborted << "code=" << codeStr
                 << (opError.isEmpty() ? QString() : QString("error=%1").arg(opError));
 #else
-        opError = QStringLiteral("OS-level file operations not supported on this platform");
-#endif
-
-        emit itemFinished(itemId, success, opError);
-
-        // Update and prune queue entry
-        {
-            QMutexLocker lk2(&m_mutex);
-            for (int i=0;i<m_queue.size();++i) if (m_queue[i].id == itemId) {
-                if (!success) m_queue[i].status = aborted ? "Cancelled" : "Failed"; else m_queue[i].status = "Completed";
-                m_queue.removeAt(i);
-                break;
+        // Planned, parallel transfers: one walk up front, then per-device worker pools (see TransferScheduler)
+        bool ok = false;
+        if (type == Type::Copy) {
+            const TransferScheduler::Plan plan = TransferScheduler::planCopy(sources, dest);
+            ok = TransferScheduler::executeCopy(plan, m_cancel, concurrency, onProgress, &opError);
+        } else if (type == Type::Move) {
+            ok = TransferScheduler::move(sources, dest, m_cancel, concurrency, onProgress, &opError);
+        } else if (permanent) {
+            const TransferScheduler::Plan plan = TransferScheduler::planDelete(sources);
+            ok = TransferScheduler::executeDelete(plan, m_cancel, concurrency, onProgress, &opError);
+        } else {
+            ok = true;
+            for (const QString& s : sources) {
+                if (m_cancel.load()) { ok = false; break; }
+                if (!QFile::moveToTrash(s)) { ok = false; opError = QString("Failed to move to trash: %1").arg(s); break; }
             }
-            emit queueChanged();
         }
+        aborted = !ok && m_cancel.load();
+        success = ok;
+        if (aborted) opError.clear();
+        qInfo() << "[FileOps] Done" << typeToString(type) << "success=" << success << "aborted=" << aborted
+                << (opError.isEmpty() ? QString() : QString("error=%1").arg(opError));
+#endif
+
+        finish();
     });
     m_watcher.setFuture(m_future);
 }
 
-QString FileOpsQueue::uniqueNameInDir(const QString& dir, const QString& baseName)
-{
-    QString name = baseName;
-    QString path = QDir(dir).filePath(name);
-    int i=2;
-    while (FileUtils::pathExists(path)) {
-        QString stem = QFileInfo(baseName).completeBaseName();
-        QString ext = QFileInfo(baseName).suffix();
-        if (ext.isEmpty()) name = QString("%1 (%2)").arg(stem).arg(i++);
-        else name = QString("%1 (%2).%3").arg(stem).arg(i++).arg(ext);
-        path = QDir(dir).filePath(name);
-    }
-    return path;
-}
-
-bool FileOpsQueue::copyFileWithProgress(const QString& src, const QString& dst, std::atomic_bool& cancel,
-                                        std::function<void(qint64,qint64)> onProgress, QString* errorOut)
-{
-    QFile in(src); QFile out(dst);
-    if (!in.open(QIODevice::ReadOnly)) { if (errorOut) *errorOut = QObject::tr("Failed to open %1").arg(src); return false; }
-    QDir().mkpath(QFileInfo(dst).absolutePath());
-    if (!out.open(QIODevice::WriteOnly)) { if (errorOut) *errorOut = QObject::tr("Failed to write %1").arg(dst); return false; }
-    const qint64 total = in.size();
-    qint64 copied = 0;
-    QByteArray buf; buf.resize(4*1024*1024);
-    while (!in.atEnd()) {
-        if (cancel.load()) { out.close(); out.remove(); return false; }
-        qint64 r = in.read(buf.data(), buf.size());
-        if (r <= 0) break;
-        qint64 w = out.write(buf.constData(), r);
-        if (w != r) { if (errorOut) *errorOut = QObject::tr("Write error %1").arg(dst); out.close(); return false; }
-        copied += w;
-        if (onProgress) onProgress(copied, total);
-    }
-    out.flush(); out.close(); in.close();
-    return true;
-}
-
-bool FileOpsQueue::copyRecursively(const QString& src, const QString& dstDir, std::atomic_bool& cancel,
-                                   std::function<void(const QString&, int, int)> onFile, QString* errorOut)
-{
-    QFileInfo sfi(src);
-    if (sfi.isDir()) {
-        QDir dst(dstDir);
-        if (!dst.exists()) QDir().mkpath(dstDir);
-        QDir srcDir(src);
-        QFileInfoList entries = srcDir.entryInfoList(QDir::NoDotAndDotDot | QDir::AllEntries);
-        int total = entries.size(); int count=0;
-        for (const QFileInfo &e : entries) {
-            if (cancel.load()) return false;
-            QString target = dst.filePath(e.fileName());
-            if (e.isDir()) {
-                if (!copyRecursively(e.absoluteFilePath(), target, cancel, onFile, errorOut)) return false;
-            } else {
-                if (!copyFileWithProgress(e.absoluteFilePath(), target, cancel, nullptr, errorOut)) return false;
-            }
-            if (onFile) onFile(e.absoluteFilePath(), ++count, total);
-        }
-        return true;
-    } else {
-        return copyFileWithProgress(src, QDir(dstDir).filePath(sfi.fileName()), cancel, nullptr, errorOut);
-    }
-}
-
-bool FileOpsQueue::removeRecursively(const QString& path, std::atomic_bool& cancel)
-{
-    if (!FileUtils::pathExists(path)) return true;
-    QFileInfo fi(path);
-    if (fi.isDir()) {
-        QDir dir(path);
-        QFileInfoList list = dir.entryInfoList(QDir::NoDotAndDotDot | QDir::AllEntries);
-        for (const QFileInfo &e : list) {
-            if (cancel.load()) return false;
-            if (!removeRecursively(e.absoluteFilePath(), cancel)) return false;
-        }
-        return dir.rmdir(path);
-    } else {
-        return QFile::remove(path);
-    }
-}
-
@@ -6,6 +6,8 @@
 #include <QMutex>
 #include <atomic>
 
+#include "transfer_scheduler.h"
+
 class FileOpsQueue : public QObject {
     Q_OBJECT
 public:
@@ -18,9 +20,12 @@ public:
         QString status; // Queued, In Progress, Completed, Cancelled, Failed
         int completedFiles = 0;
         int totalFiles = 0;
+        qint64 completedBytes = 0;
+        qint64 totalBytes = 0;
         QString currentFile;
         QString error;
         bool permanentDelete = false; // For Delete operations: true = permanent, false = Recycle Bin
+        bool verify = false; // For Copy: hash in flight, re-read destination, write MHL manifest
     };
 
     static FileOpsQueue& instance();
@@ -29,6 +34,8 @@ public:
     enum class ConflictAction { Rename, Overwrite, Skip };
 
     void enqueueCopy(const QStringList& sources, const QString& destination);
+    // Copy + read-back verification + MHL manifest in the destination folder
+    void enqueueVerifiedCopy(const QStringList& sources, const QString& destination);
     void enqueueMove(const QStringList& sources, const QString& destination);
     void enqueueDeletePermanent(const QStringList& sources);
 
@@ -40,8 +47,11 @@ public:
 signals:
     void queueChanged();
     void progressChanged(int current, int total, const QString& currentFile);
+    void bytesProgressChanged(qint64 done, qint64 total, const QString& currentFile);
     void currentItemChanged(const FileOpsQueue::Item& item);
     void itemFinished(int id, bool success, const QString& error);
+    // Emitted from the worker after a verified copy; files carry source/destination SHA-256
+    void transferVerified(int id, const QVector<TransferScheduler::VerifiedFile>& files, const QString& manifestPath);
 
 public slots:
     void cancelCurrent();
@@ -53,14 +63,6 @@ private:
 
     void startNext();
 
-    // Worker helpers (run in background thread)
-    static bool copyFileWithProgress(const QString& src, const QString& dst, std::atomic_bool& cancel,
-                                     std::function<void(qint64,qint64)> onProgress, QString* errorOut);
-    static bool copyRecursively(const QString& src, const QString& dstDir, std::atomic_bool& cancel,
-                                std::function<void(const QString&, int, int)> onFile, QString* errorOut);
-    static bool removeRecursively(const QString& path, std::atomic_bool& cancel);
-    static QString uniqueNameInDir(const QString& dir, const QString& baseName);
-
     mutable QMutex m_mutex;
     QList<Item> m_queue;
     int m_nextId = 1;
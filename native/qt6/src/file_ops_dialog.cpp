@@ -46,6 +46,7 @@ FileOpsProgressDialog::FileOpsProgressDialog(QWidget* parent) : QDialog(parent)
     auto &q = FileOpsQueue::instance();
     connect(&q, &FileOpsQueue::queueChanged, this, [this]{ if (!refreshTimer.isActive()) refreshTimer.start(); });
     connect(&q, &FileOpsQueue::progressChanged, this, &FileOpsProgressDialog::onProgress);
+    connect(&q, &FileOpsQueue::bytesProgressChanged, this, &FileOpsProgressDialog::onBytesProgress);
     connect(&q, &FileOpsQueue::currentItemChanged, this, &FileOpsProgressDialog::onCurrentChanged);
     connect(&q, &FileOpsQueue::itemFinished, this, &FileOpsProgressDialog::onItemFinished);
 
@@ -82,6 +83,10 @@ void FileOpsProgressDialog::refreshList()
 
 void FileOpsProgressDialog::onProgress(int current, int total, const QString& currentFile)
 {
+    if (byteProgress) {
+        if (!currentFile.isEmpty()) label->setText(QString("Processing: %1 (%2/%3 files)").arg(currentFile).arg(current).arg(total));
+        return;
+    }
     if (total <= 0) { bar->setRange(0,0); return; }
     bar->setRange(0, 1000);
     int v = int(double(current) / double(total) * 1000.0);
@@ -92,8 +97,19 @@ void FileOpsProgressDialog::onProgress(int current, int total, const QString& cu
     QCoreApplication::processEvents(QEventLoop::AllEvents, 5);
 }
 
+void FileOpsProgressDialog::onBytesProgress(qint64 done, qint64 total, const QString& currentFile)
+{
+    Q_UNUSED(currentFile);
+    if (total <= 0) return;
+    byteProgress = true;
+    bar->setRange(0, 1000);
+    int v = int(double(done) / double(total) * 1000.0);
+    bar->setValue(std::clamp(v, 0, 1000));
+}
+
 void FileOpsProgressDialog::onCurrentChanged(const FileOpsQueue::Item& item)
 {
+    byteProgress = false;
     label->setText(QString("%1: %2 item(s) -> %3").arg(
         item.type == FileOpsQueue::Type::Copy ? "Copy" : item.type == FileOpsQueue::Type::Move ? "Move" : "Delete",
         QString::number(item.totalFiles),
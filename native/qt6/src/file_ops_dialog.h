@@ -16,6 +16,7 @@ public:
 private slots:
     void refreshList();
     void onProgress(int current, int total, const QString& currentFile);
+    void onBytesProgress(qint64 done, qint64 total, const QString& currentFile);
     void onCurrentChanged(const FileOpsQueue::Item& item);
     void onItemFinished(int id, bool success, const QString& error);
 
@@ -27,5 +28,6 @@ private:
     QPushButton* cancelAllBtn;
     QPushButton* closeBtn;
     QTimer refreshTimer;
+    bool byteProgress = false; // current item reports bytes; file counts then only update the label
 };
 
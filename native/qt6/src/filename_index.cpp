@@ -0,0 +1,950 @@
+#include "filename_index.h"
+#include "project_folder_watcher.h"
+
+#include <QCoreApplication>
+#include <QDataStream>
+#include <QDebug>
+#include <QDir>
+#include <QDirIterator>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QRegularExpression>
+#include <QSaveFile>
+#include <QSettings>
+#include <QStandardPaths>
+#include <QThread>
+#include <QtConcurrent>
+#include <algorithm>
+#include <array>
+#include <cstring>
+
+namespace {
+constexpr quint32 kIndexMagic = 0x4B464E49; // "KFNI"
+constexpr quint32 kIndexVersion = 1;
+// Names live in one blob addressed by 32-bit offsets
+constexpr qint64 kMaxNameBytes = 0xFFFFFFF0LL;
+// Below this many entries one thread scans faster than a fan-out
+constexpr int kParallelScanThreshold = 200000;
+constexpr int kRefreshDelayMs = 500;
+constexpr int kSaveDelayMs = 5000;
+
+enum EntryFlag : quint8 { FolderFlag = 1, RemovedFlag = 2 };
+
+inline char foldAscii(char c)
+{
+    return (c >= 'A' && c <= 'Z') ? char(c + ('a' - 'A')) : c;
+}
+
+QByteArray foldedUtf8(const QString& text)
+{
+    QByteArray bytes = text.toUtf8();
+    for (char& c : bytes) c = foldAscii(c);
+    return bytes;
+}
+
+QString normalizedPath(const QString& path)
+{
+    return QDir::cleanPath(QDir::fromNativeSeparators(path));
+}
+
+QString joinPath(const QString& dir, const QString& name)
+{
+    return dir.endsWith(u'/') ? dir + name : dir + u'/' + name;
+}
+
+quint64 childKey(qint32 parentDir, const char* name, qsizetype length)
+{
+    return (quint64(quint32(parentDir)) << 32) | quint32(qHash(QByteArrayView(name, length)));
+}
+
+// Horspool over text folded on the fly, so the blob is kept only once, in its original case
+class FoldedSearcher {
+public:
+    FoldedSearcher() = default;
+    explicit FoldedSearcher(const QByteArray& foldedPattern) : m_pattern(foldedPattern)
+    {
+        const int m = int(m_pattern.size());
+        m_skip.fill(m);
+        for (int i = 0; i < m - 1; ++i) {
+            const char c = m_pattern[i];
+            m_skip[uchar(c)] = m - 1 - i;
+            if (c >= 'a' && c <= 'z') m_skip[uchar(c - ('a' - 'A'))] = m - 1 - i;
+        }
+    }
+
+    bool isEmpty() const { return m_pattern.isEmpty(); }
+
+    const char* find(const char* begin, const char* end) const
+    {
+        const qsizetype m = m_pattern.size();
+        const char* p = m_pattern.constData();
+        while (end - begin >= m) {
+            qsizetype i = m - 1;
+            while (i >= 0 && foldAscii(begin[i]) == p[i]) --i;
+            if (i < 0) return begin;
+            begin += m_skip[uchar(begin[m - 1])];
+        }
+        return end;
+    }
+
+    bool contains(const char* text, qsizetype length) const { return find(text, text + length) != text + length; }
+
+private:
+    QByteArray m_pattern;
+    std::array<int, 256> m_skip{};
+};
+
+inline const char* nextCodePoint(const char* s, const char* end)
+{
+    ++s;
+    while (s < end && (uchar(*s) & 0xC0) == 0x80) ++s;
+    return s;
+}
+
+// Whole-string wildcard match; '?' is one UTF-8 code point
+bool globMatch(const char* s, const char* se, const char* p, const char* pe)
+{
+    const char* star = nullptr;
+    const char* resume = nullptr;
+    while (s < se) {
+        if (p < pe && *p == '?') {
+            s = nextCodePoint(s, se);
+            ++p;
+        } else if (p < pe && *p == '*') {
+            star = ++p;
+            resume = s;
+        } else if (p < pe && *p == foldAscii(*s)) {
+            ++s;
+            ++p;
+        } else if (star) {
+            p = star;
+            s = resume = nextCodePoint(resume, se);
+        } else {
+            return false;
+        }
+    }
+    while (p < pe && *p == '*') ++p;
+    return p == pe;
+}
+
+QStringList splitTerms(const QString& query)
+{
+    QStringList terms;
+    QString current;
+    bool inQuotes = false;
+    for (QChar c : query) {
+        if (c == u'"') inQuotes = !inQuotes;
+        else if (c.isSpace() && !inQuotes) {
+            if (!current.isEmpty()) terms << current;
+            current.clear();
+        } else current.append(c);
+    }
+    if (!current.isEmpty()) terms << current;
+    return terms;
+}
+
+struct Listing {
+    bool exists = false;
+    qint64 mtime = 0;
+    QVector<QPair<QString, bool>> children; // name, folder
+};
+
+Listing listDirectory(const QString& path)
+{
+    Listing listing;
+    const QFileInfo info(path);
+    listing.exists = info.isDir();
+    if (!listing.exists) return listing;
+    listing.mtime = info.lastModified().toSecsSinceEpoch();
+    QDirIterator it(path, QDir::AllEntries | QDir::NoDotAndDotDot | QDir::Hidden | QDir::System);
+    while (it.hasNext()) {
+        it.next();
+        const QFileInfo fi = it.fileInfo();
+        // Symlinked folders are listed as files so a link cycle cannot recurse
+        listing.children.append({fi.fileName(), fi.isDir() && !fi.isSymLink()});
+    }
+    return listing;
+}
+}
+
+struct FilenameIndex::Term {
+    enum Kind { Substring, Glob, Extension };
+    Kind kind = Substring;
+    bool path = false;            // matched against the full path
+    QByteArray pattern;           // folded UTF-8
+    QList<QByteArray> extensions; // folded, with the leading dot
+    FoldedSearcher searcher;      // Substring
+};
+
+FilenameIndex& FilenameIndex::instance()
+{
+    static FilenameIndex index;
+    return index;
+}
+
+FilenameIndex::FilenameIndex(QObject* parent)
+    : QObject(parent)
+{
+    // One writer keeps scans, refreshes and saves in order without further locking
+    m_pool.setMaxThreadCount(1);
+    const QString dir = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
+    if (!dir.isEmpty()) m_indexPath = QDir(dir).filePath("filename_index.dat");
+
+    m_refreshTimer.setSingleShot(true);
+    m_refreshTimer.setInterval(kRefreshDelayMs);
+    connect(&m_refreshTimer, &QTimer::timeout, this, &FilenameIndex::flushPendingRefreshes);
+    m_saveTimer.setSingleShot(true);
+    m_saveTimer.setInterval(kSaveDelayMs);
+    connect(&m_saveTimer, &QTimer::timeout, this, [this]() {
+        const QString path = m_indexPath;
+        enqueue([this, path]() { saveOnWorker(path); });
+    });
+
+    if (QCoreApplication::instance()) {
+        connect(QCoreApplication::instance(), &QCoreApplication::aboutToQuit, this, [this]() {
+            // Unfinished directories keep mtime 0 and are picked up again on the next start
+            m_cancel = true;
+            m_refreshTimer.stop();
+            m_saveTimer.stop();
+            m_pool.waitForDone();
+            m_cancel = false;
+            if (m_dirty) saveOnWorker(m_indexPath);
+        });
+    }
+}
+
+FilenameIndex::~FilenameIndex()
+{
+    m_cancel = true;
+    m_pool.waitForDone();
+}
+
+void FilenameIndex::start()
+{
+    if (!m_userRootWatcher) {
+        m_userRootWatcher = new ProjectFolderWatcher(this);
+        connect(m_userRootWatcher, &ProjectFolderWatcher::directoryChanged, this, &FilenameIndex::refreshDirectory);
+        QSettings s("AugmentCode", "KAssetManager");
+        m_userRoots.clear();
+        for (const QString& path : s.value("FilenameIndex/UserRoots").toStringList()) m_userRoots << normalizedPath(path);
+    }
+    m_started = true;
+    syncRoots();
+    watchUserRoots(m_userRoots);
+}
+
+void FilenameIndex::setProjectRoots(const QStringList& paths)
+{
+    m_projectRoots.clear();
+    for (const QString& path : paths) m_projectRoots << normalizedPath(path);
+    syncRoots();
+}
+
+void FilenameIndex::addProjectRoot(const QString& path)
+{
+    const QString p = normalizedPath(path);
+    if (m_projectRoots.contains(p)) return;
+    m_projectRoots << p;
+    syncRoots();
+}
+
+void FilenameIndex::removeProjectRoot(const QString& path)
+{
+    if (m_projectRoots.removeAll(normalizedPath(path)) > 0) syncRoots();
+}
+
+void FilenameIndex::addUserRoot(const QString& path)
+{
+    const QString p = normalizedPath(path);
+    if (p.isEmpty() || m_userRoots.contains(p)) return;
+    m_userRoots << p;
+    QSettings s("AugmentCode", "KAssetManager");
+    s.setValue("FilenameIndex/UserRoots", m_userRoots);
+    syncRoots();
+    watchUserRoots({p});
+}
+
+void FilenameIndex::removeUserRoot(const QString& path)
+{
+    const int i = m_userRoots.indexOf(normalizedPath(path));
+    if (i < 0) return;
+    m_userRoots.removeAt(i);
+    QSettings s("AugmentCode", "KAssetManager");
+    s.setValue("FilenameIndex/UserRoots", m_userRoots);
+    const auto id = m_userRootIds.constFind(normalizedPath(path));
+    if (id != m_userRootIds.constEnd()) {
+        if (m_userRootWatcher) m_userRootWatcher->removeProjectFolder(id.value());
+        m_userRootIds.erase(id);
+    }
+    syncRoots();
+}
+
+void FilenameIndex::watchUserRoots(const QStringList& roots)
+{
+    if (!m_started || !m_userRootWatcher || roots.isEmpty()) return;
+    for (const QString& root : roots) {
+        if (!m_userRootIds.contains(root)) m_userRootIds.insert(root, m_nextUserRootId++);
+    }
+    // Queued behind the sync, so the directory table is loaded, verified and scanned;
+    // nothing walks the disk for the watches
+    enqueue([this, roots]() {
+        for (const QString& root : roots) {
+            if (m_cancel) break;
+            QStringList dirs;
+            {
+                QReadLocker lock(&m_lock);
+                dirs = dirsUnderLocked(root);
+            }
+            QMetaObject::invokeMethod(this, [this, root, dirs]() {
+                const auto id = m_userRootIds.constFind(root);
+                if (id == m_userRootIds.constEnd() || !m_userRootWatcher) return; // removed meanwhile
+                m_userRootWatcher->watchDirectories(id.value(), root, dirs);
+            }, Qt::QueuedConnection);
+        }
+    });
+}
+
+void FilenameIndex::syncRoots()
+{
+    if (!m_started) return;
+    // Roots inside another root are already covered by it
+    QStringList all = m_projectRoots + m_userRoots;
+    all.removeDuplicates();
+    QStringList roots;
+    for (const QString& root : all) {
+        const bool nested = std::any_of(all.cbegin(), all.cend(), [&root](const QString& other) {
+            return other != root && root.startsWith(other.endsWith(u'/') ? other : other + u'/');
+        });
+        if (!nested) roots << root;
+    }
+    enqueue([this, roots]() { syncRootsOnWorker(roots); });
+}
+
+void FilenameIndex::refreshDirectory(const QString& path)
+{
+    if (!m_started) return;
+    m_pendingDirs.insert(normalizedPath(path));
+    m_refreshTimer.start();
+}
+
+void FilenameIndex::flushPendingRefreshes()
+{
+    m_refreshTimer.stop();
+    if (m_pendingDirs.isEmpty()) return;
+    QStringList dirs(m_pendingDirs.cbegin(), m_pendingDirs.cend());
+    m_pendingDirs.clear();
+    // Parents first, so a removed folder is dropped before its children are looked at
+    std::sort(dirs.begin(), dirs.end());
+    enqueue([this, dirs]() {
+        for (const QString& dir : dirs) {
+            if (m_cancel) break;
+            refreshOnWorker(dir);
+        }
+    });
+}
+
+void FilenameIndex::enqueue(std::function<void()> job)
+{
+    ++m_jobs;
+    m_pool.start([this, job = std::move(job)]() {
+        job();
+        --m_jobs;
+        QMetaObject::invokeMethod(this, [this]() { onJobFinished(); }, Qt::QueuedConnection);
+    });
+}
+
+void FilenameIndex::onJobFinished()
+{
+    emit indexChanged();
+    if (m_dirty && !m_saveTimer.isActive()) m_saveTimer.start();
+}
+
+bool FilenameIndex::waitForDone(int msecs)
+{
+    flushPendingRefreshes();
+    return m_pool.waitForDone(msecs);
+}
+
+void FilenameIndex::setIndexPath(const QString& path)
+{
+    m_pool.waitForDone();
+    m_indexPath = path;
+    m_loaded = false;
+}
+
+bool FilenameIndex::load()
+{
+    m_pool.waitForDone();
+    return loadOnWorker(m_indexPath);
+}
+
+bool FilenameIndex::save()
+{
+    m_pool.waitForDone();
+    return saveOnWorker(m_indexPath);
+}
+
+qint64 FilenameIndex::entryCount() const
+{
+    QReadLocker lock(&m_lock);
+    return m_nameOffset.size() - m_removed;
+}
+
+// ---- Changes (background thread) --------------------------------------------
+
+void FilenameIndex::syncRootsOnWorker(const QStringList& roots)
+{
+    if (!m_loaded) loadOnWorker(m_indexPath);
+
+    QVector<QPair<qint32, QString>> added;
+    {
+        QWriteLocker lock(&m_lock);
+        QVector<quint32> dropped;
+        for (auto it = m_rootDirs.begin(); it != m_rootDirs.end();) {
+            if (roots.contains(it.key())) { ++it; continue; }
+            dropped.append(m_dirEntry[it.value()]);
+            it = m_rootDirs.erase(it);
+        }
+        removeEntriesLocked(dropped);
+        for (const QString& root : roots) {
+            if (m_rootDirs.contains(root) || !QFileInfo(root).isDir()) continue;
+            const qint32 dir = appendEntryLocked(-1, root.toUtf8(), true);
+            if (dir < 0) continue;
+            m_rootDirs.insert(root, dir);
+            added.append({dir, root});
+        }
+    }
+    if (m_needsVerify) {
+        m_needsVerify = false;
+        verifyDirectories();
+    }
+    if (!added.isEmpty()) {
+        QElapsedTimer timer;
+        timer.start();
+        scanDirectories(added);
+        qInfo() << "[FilenameIndex] Indexed" << added.size() << "new root(s) in" << timer.elapsed() << "ms;"
+                << entryCount() << "entries";
+    }
+}
+
+void FilenameIndex::scanDirectories(QVector<QPair<qint32, QString>> pending)
+{
+    while (!pending.isEmpty() && !m_cancel) {
+        const auto [dir, path] = pending.takeLast();
+        const Listing listing = listDirectory(path);
+        QWriteLocker lock(&m_lock);
+        // Dropped (root removed, parent refreshed) while it was being listed
+        if (m_flags[int(m_dirEntry[dir])] & RemovedFlag) continue;
+        m_dirMtime[dir] = listing.mtime;
+        for (const auto& [name, folder] : listing.children) {
+            const qint32 child = appendEntryLocked(dir, name.toUtf8(), folder);
+            if (folder && child >= 0) pending.append({child, joinPath(path, name)});
+        }
+        m_dirty = true;
+    }
+}
+
+void FilenameIndex::refreshOnWorker(const QString& path)
+{
+    qint32 dir;
+    {
+        QReadLocker lock(&m_lock);
+        dir = findDirLocked(path);
+    }
+    if (dir < 0) return;
+    const Listing listing = listDirectory(path);
+
+    QVector<QPair<qint32, QString>> newDirs;
+    {
+        QWriteLocker lock(&m_lock);
+        const quint32 self = m_dirEntry[dir];
+        if (m_flags[int(self)] & RemovedFlag) return;
+        // A vanished root stays registered (it may be an unmounted drive) but loses its contents
+        if (!listing.exists && m_parent[int(self)] >= 0) {
+            removeEntriesLocked({self});
+            m_dirty = true;
+            return;
+        }
+        QHash<QByteArray, quint32> existing;
+        for (quint32 e : std::as_const(m_dirChildren[dir])) {
+            if (!(m_flags[int(e)] & RemovedFlag)) existing.insert(QByteArray(nameLocked(e)), e);
+        }
+        for (const auto& [name, folder] : listing.children) {
+            const QByteArray utf8 = name.toUtf8();
+            const auto it = existing.constFind(utf8);
+            // Same name and kind: unchanged. A file replaced by a folder (or back) is re-added
+            if (it != existing.constEnd() && bool(m_flags[int(it.value())] & FolderFlag) == folder) {
+                existing.remove(utf8);
+                continue;
+            }
+            const qint32 child = appendEntryLocked(dir, utf8, folder);
+            if (folder && child >= 0) newDirs.append({child, joinPath(path, name)});
+        }
+        QVector<quint32> gone(existing.cbegin(), existing.cend());
+        removeEntriesLocked(gone);
+        m_dirMtime[dir] = listing.mtime;
+        m_dirty = true;
+    }
+    scanDirectories(newDirs);
+}
+
+void FilenameIndex::verifyDirectories()
+{
+    // Only directories whose mtime moved while the app was closed are listed again
+    QElapsedTimer timer;
+    timer.start();
+    QStringList stale;
+    {
+        QReadLocker lock(&m_lock);
+        for (int d = 0; d < m_dirEntry.size() && !m_cancel; ++d) {
+            if (m_flags[int(m_dirEntry[d])] & RemovedFlag) continue;
+            const QString path = QString::fromUtf8(dirPathLocked(d));
+            const QFileInfo info(path);
+            if (!info.isDir() || info.lastModified().toSecsSinceEpoch() != m_dirMtime[d]) stale << path;
+        }
+    }
+    for (const QString& path : stale) {
+        if (m_cancel) break;
+        refreshOnWorker(path);
+    }
+    qInfo() << "[FilenameIndex] Checked saved index in" << timer.elapsed() << "ms;" << stale.size()
+            << "changed folder(s) listed again";
+}
+
+qint32 FilenameIndex::appendEntryLocked(qint32 parentDir, const QByteArray& name, bool folder)
+{
+    if (m_names.size() + name.size() + 1 > kMaxNameBytes) {
+        qWarning() << "[FilenameIndex] Name storage full; not indexing" << name;
+        return -1;
+    }
+    const int entry = m_nameOffset.size();
+    m_nameOffset.append(quint32(m_names.size()));
+    m_names.append(name);
+    m_names.append('\0');
+    m_parent.append(parentDir);
+    m_flags.append(folder ? FolderFlag : 0);
+    if (parentDir >= 0) m_dirChildren[parentDir].append(quint32(entry));
+    if (!folder) return -1;
+    const qint32 dir = m_dirEntry.size();
+    m_dirEntry.append(quint32(entry));
+    m_dirMtime.append(0);
+    m_dirChildren.append(QVector<quint32>());
+    m_childDirs.insert(childKey(parentDir, name.constData(), name.size()), dir);
+    return dir;
+}
+
+void FilenameIndex::removeEntriesLocked(const QVector<quint32>& entries)
+{
+    if (entries.isEmpty()) return;
+    auto markRemoved = [this](int e) {
+        char* name = m_names.data() + m_nameOffset[e];
+        if (m_flags[e] & FolderFlag) {
+            const qsizetype length = qstrlen(name);
+            const quint64 key = childKey(m_parent[e], name, length);
+            for (qint32 d : m_childDirs.values(key)) {
+                if (m_dirEntry[d] == quint32(e)) m_childDirs.remove(key, d);
+            }
+        }
+        // Zeroed names never match a query, so scans need no flag check
+        std::memset(name, 0, qstrlen(name));
+        m_flags[e] |= RemovedFlag;
+        ++m_removed;
+    };
+    // Removed folders take their subtree along; a removed folder never has live children
+    QVector<quint32> folders;
+    for (quint32 e : entries) {
+        if (m_flags[int(e)] & RemovedFlag) continue;
+        if (m_flags[int(e)] & FolderFlag) folders.append(e);
+        markRemoved(int(e));
+    }
+    while (!folders.isEmpty()) {
+        const qint32 dir = dirOfEntryLocked(folders.takeLast());
+        for (quint32 child : std::as_const(m_dirChildren[dir])) {
+            if (m_flags[int(child)] & RemovedFlag) continue;
+            if (m_flags[int(child)] & FolderFlag) folders.append(child);
+            markRemoved(int(child));
+        }
+    }
+}
+
+qint32 FilenameIndex::dirOfEntryLocked(quint32 entry) const
+{
+    // Directory rows are appended with their entries, so m_dirEntry is ascending
+    const auto it = std::lower_bound(m_dirEntry.cbegin(), m_dirEntry.cend(), entry);
+    return it != m_dirEntry.cend() && *it == entry ? qint32(it - m_dirEntry.cbegin()) : -1;
+}
+
+void FilenameIndex::compactLocked()
+{
+    if (m_removed == 0) return;
+    QByteArray names;
+    QVector<quint32> offsets;
+    QVector<qint32> parents;
+    QVector<quint8> flags;
+    QVector<quint32> dirEntry;
+    QVector<qint64> dirMtime;
+    QVector<qint32> newDir(m_dirEntry.size(), -1);
+    const qint64 live = m_nameOffset.size() - m_removed;
+    names.reserve(m_names.size());
+    offsets.reserve(live);
+    parents.reserve(live);
+    flags.reserve(live);
+
+    int d = 0; // m_dirEntry is ascending, so folders meet their directory row in order
+    for (int e = 0; e < m_nameOffset.size(); ++e) {
+        const bool folder = m_flags[e] & FolderFlag;
+        const int dir = folder ? d++ : -1;
+        if (m_flags[e] & RemovedFlag) continue;
+        const char* name = nameLocked(e);
+        offsets.append(quint32(names.size()));
+        names.append(name, qstrlen(name) + 1);
+        parents.append(m_parent[e] >= 0 ? newDir[m_parent[e]] : -1);
+        flags.append(m_flags[e]);
+        if (folder) {
+            newDir[dir] = dirEntry.size();
+            dirEntry.append(quint32(offsets.size() - 1));
+            dirMtime.append(m_dirMtime[dir]);
+        }
+    }
+    for (auto it = m_rootDirs.begin(); it != m_rootDirs.end(); ++it) it.value() = newDir[it.value()];
+    m_names = std::move(names);
+    m_nameOffset = std::move(offsets);
+    m_parent = std::move(parents);
+    m_flags = std::move(flags);
+    m_dirEntry = std::move(dirEntry);
+    m_dirMtime = std::move(dirMtime);
+    m_removed = 0;
+    rebuildChildrenLocked();
+}
+
+void FilenameIndex::rebuildChildrenLocked()
+{
+    m_childDirs.clear();
+    m_childDirs.reserve(m_dirEntry.size());
+    for (int d = 0; d < m_dirEntry.size(); ++d) {
+        const int e = int(m_dirEntry[d]);
+        if (m_flags[e] & RemovedFlag) continue;
+        const char* name = nameLocked(e);
+        m_childDirs.insert(childKey(m_parent[e], name, qstrlen(name)), d);
+    }
+    m_dirChildren = QVector<QVector<quint32>>(m_dirEntry.size());
+    for (int e = 0; e < m_parent.size(); ++e) {
+        if (m_parent[e] >= 0 && !(m_flags[e] & RemovedFlag)) m_dirChildren[m_parent[e]].append(quint32(e));
+    }
+}
+
+bool FilenameIndex::loadOnWorker(const QString& path)
+{
+    m_loaded = true;
+    QFile f(path);
+    if (path.isEmpty() || !f.open(QIODevice::ReadOnly)) return false;
+    QDataStream in(&f);
+    in.setVersion(QDataStream::Qt_6_0);
+    quint32 magic = 0, version = 0;
+    in >> magic >> version;
+    if (magic != kIndexMagic || version != kIndexVersion) {
+        qWarning() << "[FilenameIndex] Ignoring incompatible index file" << path;
+        return false;
+    }
+    QHash<QString, qint32> rootDirs;
+    QByteArray names;
+    QVector<quint32> offsets;
+    QVector<qint32> parents;
+    QVector<quint8> flags;
+    QVector<quint32> dirEntry;
+    QVector<qint64> dirMtime;
+    in >> rootDirs >> names >> offsets >> parents >> flags >> dirEntry >> dirMtime;
+    bool consistent = in.status() == QDataStream::Ok && offsets.size() == parents.size()
+                      && offsets.size() == flags.size() && dirEntry.size() == dirMtime.size()
+                      && (offsets.isEmpty() || offsets.last() < quint32(names.size()));
+    for (int e = 0; consistent && e < parents.size(); ++e) consistent = parents[e] < dirEntry.size();
+    for (int d = 0; consistent && d < dirEntry.size(); ++d) consistent = dirEntry[d] < quint32(offsets.size());
+    for (auto it = rootDirs.cbegin(); consistent && it != rootDirs.cend(); ++it) {
+        consistent = it.value() >= 0 && it.value() < dirEntry.size();
+    }
+    if (!consistent) {
+        qWarning() << "[FilenameIndex] Index file is damaged, rebuilding:" << path;
+        return false;
+    }
+
+    QWriteLocker lock(&m_lock);
+    m_rootDirs = std::move(rootDirs);
+    m_names = std::move(names);
+    m_nameOffset = std::move(offsets);
+    m_parent = std::move(parents);
+    m_flags = std::move(flags);
+    m_dirEntry = std::move(dirEntry);
+    m_dirMtime = std::move(dirMtime);
+    m_removed = 0;
+    rebuildChildrenLocked();
+    m_needsVerify = true;
+    qInfo() << "[FilenameIndex] Loaded" << m_nameOffset.size() << "entries from" << path;
+    return true;
+}
+
+bool FilenameIndex::saveOnWorker(const QString& path)
+{
+    if (path.isEmpty()) return false;
+    QDir().mkpath(QFileInfo(path).absolutePath());
+    QSaveFile f(path);
+    if (!f.open(QIODevice::WriteOnly)) {
+        qWarning() << "[FilenameIndex] Cannot write" << path;
+        return false;
+    }
+    QHash<QString, qint32> rootDirs;
+    QByteArray names;
+    QVector<quint32> offsets;
+    QVector<qint32> parents;
+    QVector<quint8> flags;
+    QVector<quint32> dirEntry;
+    QVector<qint64> dirMtime;
+    {
+        // Exclusive: compaction renumbers entries under any reader. The copies are
+        // implicitly shared, so writing the file below keeps no lock; a change made
+        // meanwhile detaches from them
+        QWriteLocker lock(&m_lock);
+        compactLocked();
+        rootDirs = m_rootDirs;
+        names = m_names;
+        offsets = m_nameOffset;
+        parents = m_parent;
+        flags = m_flags;
+        dirEntry = m_dirEntry;
+        dirMtime = m_dirMtime;
+        m_dirty = false;
+    }
+    QDataStream out(&f);
+    out.setVersion(QDataStream::Qt_6_0);
+    out << kIndexMagic << kIndexVersion << rootDirs << names << offsets << parents << flags << dirEntry << dirMtime;
+    if (!f.commit()) {
+        qWarning() << "[FilenameIndex] Failed to save" << path;
+        m_dirty = true;
+        return false;
+    }
+    return true;
+}
+
+// ---- Lookups -----------------------------------------------------------------
+
+qint32 FilenameIndex::childDirLocked(qint32 parentDir, const QByteArray& name) const
+{
+    for (qint32 d : m_childDirs.values(childKey(parentDir, name.constData(), name.size()))) {
+        const int e = int(m_dirEntry[d]);
+        if (m_parent[e] == parentDir && name == nameLocked(e)) return d;
+    }
+    return -1;
+}
+
+qint32 FilenameIndex::findDirLocked(const QString& path) const
+{
+    const QString p = normalizedPath(path);
+    for (auto it = m_rootDirs.cbegin(); it != m_rootDirs.cend(); ++it) {
+        if (p == it.key()) return it.value();
+        const QString prefix = it.key().endsWith(u'/') ? it.key() : it.key() + u'/';
+        if (!p.startsWith(prefix)) continue;
+        qint32 dir = it.value();
+        for (const QString& part : p.mid(prefix.size()).split(u'/', Qt::SkipEmptyParts)) {
+            dir = childDirLocked(dir, part.toUtf8());
+            if (dir < 0) return -1;
+        }
+        return dir;
+    }
+    return -1;
+}
+
+QStringList FilenameIndex::dirsUnderLocked(const QString& root) const
+{
+    const QString prefix = root.endsWith(u'/') ? root : root + u'/';
+    QStringList dirs;
+    for (int d = 0; d < m_dirEntry.size(); ++d) {
+        if (m_flags[int(m_dirEntry[d])] & RemovedFlag) continue;
+        const QString path = QString::fromUtf8(dirPathLocked(d));
+        if (path == root || path.startsWith(prefix)) dirs << path;
+    }
+    return dirs;
+}
+
+QByteArray FilenameIndex::dirPathLocked(qint32 dir) const
+{
+    QVector<const char*> parts;
+    for (qint32 d = dir; d >= 0; d = m_parent[int(m_dirEntry[d])]) parts.append(nameLocked(m_dirEntry[d]));
+    QByteArray path;
+    for (auto it = parts.crbegin(); it != parts.crend(); ++it) {
+        if (!path.isEmpty() && !path.endsWith('/')) path.append('/');
+        path.append(*it);
+    }
+    return path;
+}
+
+QVector<EverythingResult> FilenameIndex::search(const QString& query, int maxResults) const
+{
+    QVector<EverythingResult> results;
+    QVector<Term> terms;
+    for (QString text : splitTerms(query)) {
+        Term t;
+        if (text.startsWith(QLatin1String("ext:"), Qt::CaseInsensitive)) {
+            t.kind = Term::Extension;
+            static const QRegularExpression separators(QStringLiteral("[;,]"));
+            for (const QString& ext : text.mid(4).split(separators, Qt::SkipEmptyParts)) {
+                t.extensions << foldedUtf8(ext.startsWith(u'.') ? ext : u'.' + ext);
+            }
+            if (t.extensions.isEmpty()) continue;
+        } else {
+            text.replace(u'\\', u'/');
+            t.path = text.contains(u'/');
+            t.pattern = foldedUtf8(text);
+            if (text.contains(u'*') || text.contains(u'?')) t.kind = Term::Glob;
+            else t.searcher = FoldedSearcher(t.pattern);
+        }
+        terms << t;
+    }
+    if (terms.isEmpty() || maxResults <= 0) return results;
+
+    QVector<QPair<QString, bool>> found;
+    {
+        QReadLocker lock(&m_lock);
+        const QVector<quint32> hits = matchLocked(terms, maxResults);
+        found.reserve(hits.size());
+        for (quint32 e : hits) {
+            const qint32 parent = m_parent[int(e)];
+            const QString name = QString::fromUtf8(nameLocked(e));
+            found.append({parent < 0 ? name : joinPath(QString::fromUtf8(dirPathLocked(parent)), name),
+                          bool(m_flags[int(e)] & FolderFlag)});
+        }
+    }
+
+    // Size and date come from the file system, for the hits only
+    results.reserve(found.size());
+    for (const auto& [path, folder] : found) {
+        const QFileInfo fi(path);
+        if (!fi.exists()) continue; // gone since the last refresh
+        EverythingResult r;
+        r.fullPath = path;
+        r.fileName = fi.fileName();
+        r.directory = fi.path();
+        r.size = folder ? 0 : fi.size();
+        r.dateModified = fi.lastModified();
+        r.isFolder = folder;
+        r.isImported = false;
+        results.append(r);
+    }
+    return results;
+}
+
+QVector<quint32> FilenameIndex::matchLocked(const QVector<Term>& terms, int maxResults) const
+{
+    // Scan for the longest literal that every hit must contain; check the rest per hit
+    QByteArray literal;
+    for (const Term& t : terms) {
+        QByteArray candidate;
+        if (t.path) continue;
+        if (t.kind == Term::Substring) candidate = t.pattern;
+        else if (t.kind == Term::Extension && t.extensions.size() == 1) candidate = t.extensions.first();
+        else if (t.kind == Term::Glob) {
+            for (const QByteArray& part : t.pattern.split('*')) {
+                for (const QByteArray& piece : part.split('?')) {
+                    if (piece.size() > candidate.size()) candidate = piece;
+                }
+            }
+        }
+        if (candidate.size() > literal.size()) literal = candidate;
+    }
+    const FoldedSearcher driver(literal);
+
+    auto matchesAll = [this, &terms](int e, QHash<qint32, QByteArray>& dirPaths) {
+        const char* name = nameLocked(quint32(e));
+        const qsizetype length = qstrlen(name);
+        for (const Term& t : terms) {
+            if (!t.path) {
+                switch (t.kind) {
+                    case Term::Substring:
+                        if (!t.searcher.contains(name, length)) return false;
+                        break;
+                    case Term::Glob:
+                        if (!globMatch(name, name + length, t.pattern.constData(), t.pattern.constEnd())) return false;
+                        break;
+                    case Term::Extension: {
+                        const bool any = std::any_of(t.extensions.cbegin(), t.extensions.cend(), [&](const QByteArray& ext) {
+                            if (length < ext.size()) return false;
+                            for (qsizetype i = 0; i < ext.size(); ++i) {
+                                if (foldAscii(name[length - ext.size() + i]) != ext[i]) return false;
+                            }
+                            return true;
+                        });
+                        if (!any) return false;
+                        break;
+                    }
+                }
+                continue;
+            }
+            // Full path: directory part (cached per scan) + '/' + name
+            const qint32 parent = m_parent[e];
+            QByteArray dir;
+            if (parent >= 0) {
+                auto it = dirPaths.find(parent);
+                if (it == dirPaths.end()) it = dirPaths.insert(parent, dirPathLocked(parent));
+                dir = it.value();
+            }
+            QByteArray full = dir;
+            if (!full.isEmpty() && !full.endsWith('/')) full.append('/');
+            if (t.kind == Term::Glob) {
+                full.append(name, length);
+                if (!globMatch(full.constData(), full.constEnd(), t.pattern.constData(), t.pattern.constEnd())) return false;
+            } else {
+                if (t.searcher.contains(dir.constData(), dir.size())) continue;
+                // A match not inside the directory part has to reach into the name
+                const qsizetype tail = qMin<qsizetype>(full.size(), t.pattern.size() - 1);
+                QByteArray window = full.right(tail);
+                window.append(name, length);
+                if (!t.searcher.contains(window.constData(), window.size())) return false;
+            }
+        }
+        return true;
+    };
+
+    const int n = m_nameOffset.size();
+    const int chunks = n < kParallelScanThreshold ? 1 : qBound(1, QThread::idealThreadCount(), 64);
+    QVector<std::array<int, 2>> ranges;
+    for (int i = 0; i < chunks; ++i) ranges.append({int(qint64(n) * i / chunks), int(qint64(n) * (i + 1) / chunks)});
+
+    // Each chunk keeps at most maxResults hits; chunks are in entry order, so the first ones win
+    auto scan = [&](const std::array<int, 2>& range) {
+        QVector<quint32> out;
+        QHash<qint32, QByteArray> dirPaths;
+        if (driver.isEmpty()) {
+            for (int e = range[0]; e < range[1] && out.size() < maxResults; ++e) {
+                if (!(m_flags[e] & RemovedFlag) && matchesAll(e, dirPaths)) out.append(quint32(e));
+            }
+            return out;
+        }
+        if (range[0] >= range[1]) return out;
+        const char* base = m_names.constData();
+        const char* pos = base + m_nameOffset[range[0]];
+        const char* end = range[1] < n ? base + m_nameOffset[range[1]] : base + m_names.size();
+        const auto first = m_nameOffset.constBegin() + range[0];
+        const auto last = m_nameOffset.constBegin() + range[1];
+        while (pos < end && out.size() < maxResults) {
+            const char* hit = driver.find(pos, end);
+            if (hit == end) break;
+            // Names are '\0'-separated and the literal has no '\0', so a hit lies inside one name
+            const int e = int(std::upper_bound(first, last, quint32(hit - base)) - m_nameOffset.constBegin()) - 1;
+            if (matchesAll(e, dirPaths)) out.append(quint32(e));
+            pos = e + 1 < n ? base + m_nameOffset[e + 1] : end;
+        }
+        return out;
+    };
+
+    QVector<quint32> hits;
+    if (chunks == 1) {
+        hits = scan(ranges.first());
+    } else {
+        const QList<QVector<quint32>> parts = QtConcurrent::blockingMapped<QList<QVector<quint32>>>(ranges, scan);
+        for (const QVector<quint32>& part : parts) {
+            hits << part;
+            if (hits.size() >= maxResults) break;
+        }
+    }
+    if (hits.size() > maxResults) hits.resize(maxResults);
+    return hits;
+}
@@ -0,0 +1,156 @@
+#pragma once
+
+#include <QByteArray>
+#include <QHash>
+#include <QMultiHash>
+#include <QObject>
+#include <QReadWriteLock>
+#include <QSet>
+#include <QStringList>
+#include <QThreadPool>
+#include <QTimer>
+#include <QVector>
+#include <atomic>
+#include <functional>
+
+#include "everything_search.h"
+
+class ProjectFolderWatcher;
+
+/**
+ * FilenameIndex - built-in filename index for EverythingSearch where the
+ * Everything service does not exist (Linux, macOS)
+ *
+ * Covers the registered project folders plus folders the user adds. Every file
+ * and folder is one entry: its UTF-8 name in a single '\0'-separated blob, the
+ * blob offset, the containing directory and a flag byte (about 10 bytes plus the
+ * name per path). Directories are entries too, with a row in a small directory
+ * table that maps them back to their entry, keeps the mtime they were listed
+ * at and lists their children. Full paths are rebuilt from the parent chain
+ * only for results.
+ *
+ * Queries are space-separated terms that must all match, case-insensitive for
+ * ASCII: plain text is a substring of the name, '*' and '?' make it a glob over
+ * the whole name, a '/' in the term matches against the full path instead, and
+ * ext:exr;dpx limits extensions. The most selective literal is found with a
+ * Horspool scan of the name blob split across cores; other terms are checked only
+ * on those hits.
+ *
+ * All changes run on one background thread: the initial scan of a root, watcher
+ * refreshes of single directories, and saving. The index is saved to
+ * AppDataLocation/filename_index.dat. After a restart only directories whose mtime
+ * moved are listed again, so there is no full rescan. Queries may come from any
+ * thread and read under a shared lock while changes are applied.
+ */
+class FilenameIndex : public QObject {
+    Q_OBJECT
+public:
+    static FilenameIndex& instance();
+
+    // Loads the folders the user added and brings the index in line with all roots;
+    // root changes made before this are only recorded
+    void start();
+    // Registered project folders; replaces the previous set
+    void setProjectRoots(const QStringList& paths);
+    void addProjectRoot(const QString& path);
+    void removeProjectRoot(const QString& path);
+    // Folders added from the search dialog, kept in QSettings and watched here
+    QStringList userRoots() const { return m_userRoots; }
+    void addUserRoot(const QString& path);
+    void removeUserRoot(const QString& path);
+
+    // Watcher notification: lists the directory again (coalesced); new subfolders are scanned
+    void refreshDirectory(const QString& path);
+
+    QVector<EverythingResult> search(const QString& query, int maxResults = 1000) const;
+
+    qint64 entryCount() const;
+    bool isIndexing() const { return m_jobs.load() > 0; }
+
+    QString indexPath() const { return m_indexPath; }
+    void setIndexPath(const QString& path);
+    // Replaces the in-memory index with the saved one (blocking)
+    bool load();
+    // Writes the index now (blocking); false when the file cannot be written
+    bool save();
+    // Flushes pending refreshes and blocks until the background work is done (tests, shutdown)
+    bool waitForDone(int msecs = -1);
+
+signals:
+    // Scans or refreshes landed; emitted on the GUI thread
+    void indexChanged();
+
+private:
+    struct Term;
+
+    explicit FilenameIndex(QObject* parent = nullptr);
+    ~FilenameIndex() override;
+    Q_DISABLE_COPY(FilenameIndex)
+
+    void enqueue(std::function<void()> job);
+    void onJobFinished();
+    void syncRoots();
+    void flushPendingRefreshes();
+    // Watches the indexed folders below each user root, listed from the directory table
+    void watchUserRoots(const QStringList& roots);
+
+    // Background thread only
+    void syncRootsOnWorker(const QStringList& roots);
+    void refreshOnWorker(const QString& path);
+    void scanDirectories(QVector<QPair<qint32, QString>> pending);
+    void verifyDirectories();
+    bool loadOnWorker(const QString& path);
+    bool saveOnWorker(const QString& path);
+
+    // m_lock held (shared for const, exclusive otherwise)
+    qint32 appendEntryLocked(qint32 parentDir, const QByteArray& name, bool folder);
+    void removeEntriesLocked(const QVector<quint32>& entries);
+    void compactLocked();
+    // Derived lookups (m_childDirs, m_dirChildren) from the entry arrays
+    void rebuildChildrenLocked();
+    qint32 dirOfEntryLocked(quint32 entry) const;
+    qint32 findDirLocked(const QString& path) const;
+    qint32 childDirLocked(qint32 parentDir, const QByteArray& name) const;
+    const char* nameLocked(quint32 entry) const { return m_names.constData() + m_nameOffset[int(entry)]; }
+    QByteArray dirPathLocked(qint32 dir) const;
+    // Live directories at or below `root`
+    QStringList dirsUnderLocked(const QString& root) const;
+    QVector<quint32> matchLocked(const QVector<Term>& terms, int maxResults) const;
+
+    mutable QReadWriteLock m_lock;
+    // Entry e: name at m_names[m_nameOffset[e]], inside directory m_parent[e] (-1 for roots)
+    QByteArray m_names;
+    QVector<quint32> m_nameOffset;
+    QVector<qint32> m_parent;
+    QVector<quint8> m_flags;
+    // Directory d is entry m_dirEntry[d] (ascending), listed when its mtime was m_dirMtime[d]
+    QVector<quint32> m_dirEntry;
+    QVector<qint64> m_dirMtime;
+    // (parent dir, name hash) -> dir, for resolving watcher paths
+    QMultiHash<quint64, qint32> m_childDirs;
+    // Entries directly inside directory d, so refreshes and removals touch only that
+    // folder's children; removed entries stay listed until the next compaction
+    QVector<QVector<quint32>> m_dirChildren;
+    QHash<QString, qint32> m_rootDirs;
+    qint64 m_removed = 0;
+
+    // Background thread state
+    bool m_loaded = false;
+    bool m_needsVerify = false;
+
+    QThreadPool m_pool;
+    std::atomic_int m_jobs{0};
+    std::atomic_bool m_cancel{false};
+    std::atomic_bool m_dirty{false};
+
+    QString m_indexPath;
+    bool m_started = false;
+    QStringList m_projectRoots;
+    QStringList m_userRoots;
+    ProjectFolderWatcher* m_userRootWatcher = nullptr;
+    QHash<QString, int> m_userRootIds; // watcher ids
+    int m_nextUserRootId = 0;
+    QSet<QString> m_pendingDirs;
+    QTimer m_refreshTimer;
+    QTimer m_saveTimer;
+};
@@ -0,0 +1,84 @@
+#include "filter_bitset.h"
+
+#include <bit>
+
+void FilterBitset::resize(int size, bool value)
+{
+    m_size = qMax(0, size);
+    m_words.resize((m_size + 63) / 64);
+    fill(value);
+}
+
+void FilterBitset::fill(bool value)
+{
+    m_words.fill(value ? ~quint64(0) : quint64(0));
+    clearTail();
+}
+
+void FilterBitset::clearTail()
+{
+    if ((m_size & 63) && !m_words.isEmpty()) m_words.last() &= (quint64(1) << (m_size & 63)) - 1;
+}
+
+FilterBitset& FilterBitset::operator&=(const FilterBitset& other)
+{
+    Q_ASSERT(other.m_size == m_size);
+    quint64* a = m_words.data();
+    const quint64* b = other.m_words.constData();
+    const qsizetype n = m_words.size();
+    for (qsizetype i = 0; i < n; ++i) a[i] &= b[i];
+    return *this;
+}
+
+FilterBitset& FilterBitset::operator|=(const FilterBitset& other)
+{
+    Q_ASSERT(other.m_size == m_size);
+    quint64* a = m_words.data();
+    const quint64* b = other.m_words.constData();
+    const qsizetype n = m_words.size();
+    for (qsizetype i = 0; i < n; ++i) a[i] |= b[i];
+    return *this;
+}
+
+FilterBitset& FilterBitset::andNot(const FilterBitset& other)
+{
+    Q_ASSERT(other.m_size == m_size);
+    quint64* a = m_words.data();
+    const quint64* b = other.m_words.constData();
+    const qsizetype n = m_words.size();
+    for (qsizetype i = 0; i < n; ++i) a[i] &= ~b[i];
+    return *this;
+}
+
+int FilterBitset::count() const
+{
+    int total = 0;
+    for (quint64 w : m_words) total += std::popcount(w);
+    return total;
+}
+
+int FilterBitset::andCount(const FilterBitset& other) const
+{
+    Q_ASSERT(other.m_size == m_size);
+    const quint64* a = m_words.constData();
+    const quint64* b = other.m_words.constData();
+    const qsizetype n = m_words.size();
+    int total = 0;
+    for (qsizetype i = 0; i < n; ++i) total += std::popcount(a[i] & b[i]);
+    return total;
+}
+
+QVector<int> FilterBitset::indexes() const
+{
+    QVector<int> out;
+    out.reserve(count());
+    for (qsizetype i = 0; i < m_words.size(); ++i) {
+        quint64 w = m_words[i];
+        const int base = int(i) * 64;
+        while (w) {
+            out.append(base + std::countr_zero(w));
+            w &= w - 1;
+        }
+    }
+    return out;
+}
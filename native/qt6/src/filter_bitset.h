@@ -0,0 +1,45 @@
+#pragma once
+#include <QVector>
+#include <QtGlobal>
+
+/**
+ * FilterBitset - dense bitset over model rows, one bit per row
+ *
+ * Used by AssetsModel to keep one mask per filter dimension and to combine them
+ * word by word. The combining loops are plain 64-bit word loops over contiguous
+ * storage so the compiler can vectorise them; bits past size() are always zero.
+ */
+class FilterBitset {
+public:
+    FilterBitset() = default;
+    explicit FilterBitset(int size, bool value = false) { resize(size, value); }
+
+    void resize(int size, bool value = false);
+    void fill(bool value);
+    int size() const { return m_size; }
+
+    void set(int i) { m_words[i >> 6] |= quint64(1) << (i & 63); }
+    void reset(int i) { m_words[i >> 6] &= ~(quint64(1) << (i & 63)); }
+    bool test(int i) const { return (m_words[i >> 6] >> (i & 63)) & 1; }
+
+    // In-place combination with a bitset of the same size
+    FilterBitset& operator&=(const FilterBitset& other);
+    FilterBitset& operator|=(const FilterBitset& other);
+    FilterBitset& andNot(const FilterBitset& other);
+
+    int count() const;
+    // count() of (*this & other) without building it
+    int andCount(const FilterBitset& other) const;
+    bool isAllSet() const { return count() == m_size; }
+    // Ascending indexes of the set bits
+    QVector<int> indexes() const;
+
+    bool operator==(const FilterBitset& other) const { return m_size == other.m_size && m_words == other.m_words; }
+    bool operator!=(const FilterBitset& other) const { return !(*this == other); }
+
+private:
+    void clearTail();
+
+    QVector<quint64> m_words;
+    int m_size = 0;
+};
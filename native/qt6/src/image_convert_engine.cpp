@@ -0,0 +1,391 @@
+#include "image_convert_engine.h"
+
+#include <QFileInfo>
+#include <QMutex>
+#include <QQueue>
+#include <QSet>
+#include <QWaitCondition>
+#include <QDebug>
+#include <algorithm>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#if defined(HAVE_OPENIMAGEIO) && HAVE_OPENIMAGEIO
+#include <OpenImageIO/imageio.h>
+#include <OpenImageIO/imagebuf.h>
+#include <OpenImageIO/imagebufalgo.h>
+using namespace OIIO;
+#else
+#include <QColorSpace>
+#include <QImage>
+#include <QImageReader>
+#include <QImageWriter>
+#endif
+
+namespace ImageConvertEngine {
+
+namespace {
+
+struct Frame {
+    int item = -1;
+#if defined(HAVE_OPENIMAGEIO) && HAVE_OPENIMAGEIO
+    ImageBuf buf;
+    bool linear = false; // float data from EXR/HDR etc.; needs a display transform
+#else
+    QImage image;
+#endif
+};
+using FramePtr = std::unique_ptr<Frame>;
+
+// Bounded hand-off between two pipeline stages. Consumers see the end of the
+// stream once every producer has called producerDone() and the queue is drained.
+class FrameQueue {
+public:
+    FrameQueue(int capacity, int producers) : m_capacity(qMax(1, capacity)), m_producers(producers) {}
+
+    bool push(FramePtr f)
+    {
+        QMutexLocker lk(&m_mutex);
+        while (m_frames.size() >= m_capacity && !m_aborted) m_notFull.wait(&m_mutex);
+        if (m_aborted) return false;
+        m_frames.enqueue(std::move(f));
+        m_notEmpty.wakeOne();
+        return true;
+    }
+    bool pop(FramePtr* out)
+    {
+        QMutexLocker lk(&m_mutex);
+        while (m_frames.isEmpty() && m_producers > 0 && !m_aborted) m_notEmpty.wait(&m_mutex);
+        if (m_frames.isEmpty() || m_aborted) return false;
+        *out = m_frames.dequeue();
+        m_notFull.wakeOne();
+        return true;
+    }
+    void producerDone() { QMutexLocker lk(&m_mutex); if (--m_producers <= 0) m_notEmpty.wakeAll(); }
+    void abort() { QMutexLocker lk(&m_mutex); m_aborted = true; m_frames.clear(); m_notFull.wakeAll(); m_notEmpty.wakeAll(); }
+
+private:
+    QMutex m_mutex;
+    QWaitCondition m_notEmpty;
+    QWaitCondition m_notFull;
+    QQueue<FramePtr> m_frames;
+    int m_capacity;
+    int m_producers;
+    bool m_aborted = false;
+};
+
+// Same rules as the ImageMagick geometry the converter used to build: WxH, Wx or xH
+void targetSize(int w, int h, const Options& opts, int& tw, int& th)
+{
+    tw = w; th = h;
+    if (opts.scaleWidth > 0 && opts.scaleHeight > 0) {
+        const double s = std::min(double(opts.scaleWidth) / w, double(opts.scaleHeight) / h);
+        tw = qMax(1, int(w * s + 0.5));
+        th = qMax(1, int(h * s + 0.5));
+    } else if (opts.scaleWidth > 0) {
+        tw = opts.scaleWidth;
+        th = qMax(1, int(double(h) * opts.scaleWidth / w + 0.5));
+    } else if (opts.scaleHeight > 0) {
+        th = opts.scaleHeight;
+        tw = qMax(1, int(double(w) * opts.scaleHeight / h + 0.5));
+    }
+    if (opts.downscale > 1) {
+        tw = qMax(1, tw / opts.downscale);
+        th = qMax(1, th / opts.downscale);
+    }
+}
+
+bool keepAlpha(const Options& opts) { return opts.includeAlpha && opts.format != Format::Jpg; }
+
+#if defined(HAVE_OPENIMAGEIO) && HAVE_OPENIMAGEIO
+
+bool readFrame(const QString& path, Frame& f, QString* err)
+{
+    auto in = ImageInput::open(path.toStdString());
+    if (!in) { if (err) *err = QString::fromStdString(OIIO::geterror()); return false; }
+    // Parallelism comes from the pipeline; no extra OIIO/OpenEXR decode threads
+    in->threads(1);
+    const ImageSpec& spec = in->spec();
+    // Keep 8/16-bit data as is; everything else is read as float
+    TypeDesc fmt = TypeDesc::FLOAT;
+    if (spec.format == TypeDesc::UINT8) fmt = TypeDesc::UINT8;
+    else if (spec.format == TypeDesc::UINT16) fmt = TypeDesc::UINT16;
+    const int nch = std::min(spec.nchannels, 4);
+
+    ImageSpec dstSpec(spec.width, spec.height, nch, fmt);
+    dstSpec.alpha_channel = (nch == 4 || nch == 2) ? nch - 1 : -1;
+    f.buf.reset(dstSpec);
+    // read_image converts to fmt, untiles and strides into our buffer in one pass
+    const stride_t xstride = stride_t(nch) * fmt.size();
+    if (!in->read_image(0, 0, 0, nch, fmt, f.buf.localpixels(), xstride, xstride * spec.width)) {
+        if (err) *err = QString::fromStdString(in->geterror());
+        return false;
+    }
+    in->close();
+    f.linear = (fmt == TypeDesc::FLOAT);
+    return true;
+}
+
+bool transformFrame(Frame& f, const Options& opts, QString* err)
+{
+    const int w = f.buf.spec().width, h = f.buf.spec().height;
+    if (f.buf.nchannels() == 4 && !keepAlpha(opts)) {
+        ImageBuf rgb;
+        if (!ImageBufAlgo::channels(rgb, f.buf, 3, {}, {}, {}, false, 1)) {
+            if (err) *err = QString::fromStdString(rgb.geterror());
+            return false;
+        }
+        f.buf = std::move(rgb);
+    }
+    int tw = 0, th = 0;
+    targetSize(w, h, opts, tw, th);
+    if (tw != w || th != h) {
+        ImageBuf resized;
+        // Parallelism comes from the pipeline; keep each operation single threaded
+        if (!ImageBufAlgo::resize(resized, f.buf, "", 0, ROI(0, tw, 0, th, 0, 1, 0, f.buf.nchannels()), 1)) {
+            if (err) *err = QString::fromStdString(resized.geterror());
+            return false;
+        }
+        f.buf = std::move(resized);
+    }
+    // EXR output stays scene linear
+    if (f.linear && opts.format != Format::Exr) {
+        ImageBuf display;
+        if (!ImageBufAlgo::colorconvert(display, f.buf, "linear", "sRGB", true, "", "", nullptr, ROI(), 1)) {
+            if (err) *err = QString::fromStdString(display.geterror());
+            return false;
+        }
+        f.buf = std::move(display);
+    }
+    return true;
+}
+
+bool writeFrame(const Frame& f, const QString& path, const Options& opts, QString* err)
+{
+    auto out = ImageOutput::create(path.toStdString());
+    if (!out) { if (err) *err = QString::fromStdString(OIIO::geterror()); return false; }
+    out->threads(1);
+    const ImageSpec& src = f.buf.spec();
+    TypeDesc fmt = TypeDesc::UINT8;
+    if (opts.format == Format::Exr) fmt = TypeDesc::HALF;
+    else if (opts.format != Format::Jpg && src.format != TypeDesc::UINT8) fmt = TypeDesc::UINT16;
+    ImageSpec spec(src.width, src.height, src.nchannels, fmt);
+    spec.alpha_channel = src.alpha_channel;
+    if (opts.format == Format::Jpg) {
+        spec.attribute("Compression", QString("jpeg:%1").arg(std::clamp(opts.quality, 1, 100)).toStdString());
+    } else if (opts.format == Format::Tif) {
+        if (!opts.compression.isEmpty()) spec.attribute("Compression", opts.compression.toLower().toStdString());
+        if (opts.tileSize > 0 && out->supports("tiles")) {
+            spec.tile_width = spec.tile_height = opts.tileSize;
+            spec.tile_depth = 1;
+        }
+    } else if (opts.format == Format::Exr) {
+        spec.attribute("Compression", opts.compression.isEmpty() ? "dwaa" : opts.compression.toLower().toStdString());
+    }
+    if (!out->open(path.toStdString(), spec)) {
+        if (err) *err = QString::fromStdString(out->geterror());
+        return false;
+    }
+    // Scanline buffer in, file format out: OIIO converts and tiles as needed
+    if (!out->write_image(src.format, f.buf.localpixels())) {
+        if (err) *err = QString::fromStdString(out->geterror());
+        out->close();
+        return false;
+    }
+    return out->close();
+}
+
+#else
+
+bool readFrame(const QString& path, Frame& f, QString* err)
+{
+    QImageReader reader(path);
+    reader.setAutoTransform(true);
+    if (!reader.read(&f.image)) {
+        if (err) *err = reader.errorString();
+        return false;
+    }
+    return true;
+}
+
+bool transformFrame(Frame& f, const Options& opts, QString* err)
+{
+    Q_UNUSED(err);
+    if (f.image.hasAlphaChannel() && !keepAlpha(opts)) f.image = f.image.convertToFormat(QImage::Format_RGB32);
+    int tw = 0, th = 0;
+    targetSize(f.image.width(), f.image.height(), opts, tw, th);
+    if (tw != f.image.width() || th != f.image.height()) f.image = f.image.scaled(tw, th, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+    if (f.image.colorSpace().isValid() && f.image.colorSpace() != QColorSpace(QColorSpace::SRgb)) {
+        f.image.convertToColorSpace(QColorSpace(QColorSpace::SRgb));
+    }
+    return true;
+}
+
+bool writeFrame(const Frame& f, const QString& path, const Options& opts, QString* err)
+{
+    if (!canWrite(opts.format)) {
+        if (err) *err = QStringLiteral("EXR output requires OpenImageIO");
+        return false;
+    }
+    QImageWriter writer(path, extensionFor(opts.format).toLatin1());
+    if (opts.format == Format::Jpg) writer.setQuality(std::clamp(opts.quality, 1, 100));
+    if (opts.format == Format::Tif) writer.setCompression(opts.compression.compare("none", Qt::CaseInsensitive) == 0 || opts.compression.isEmpty() ? 0 : 1);
+    if (!writer.write(f.image)) {
+        if (err) *err = writer.errorString();
+        return false;
+    }
+    return true;
+}
+
+#endif
+
+} // namespace
+
+bool canRead(const QString& path)
+{
+    const QString ext = QFileInfo(path).suffix().toLower();
+#if defined(HAVE_OPENIMAGEIO) && HAVE_OPENIMAGEIO
+    static const QSet<QString> exts = {
+        "exr", "hdr", "tif", "tiff", "png", "jpg", "jpeg", "dpx", "cin", "tga", "bmp",
+        "psd", "iff", "sgi", "rgb", "pnm", "ppm", "pgm", "webp", "jp2", "j2k", "dds", "ico"
+    };
+    return exts.contains(ext);
+#else
+    static const QSet<QString> exts = [] {
+        QSet<QString> s;
+        for (const QByteArray& f : QImageReader::supportedImageFormats()) s.insert(QString::fromLatin1(f).toLower());
+        return s;
+    }();
+    return exts.contains(ext);
+#endif
+}
+
+bool canWrite(Format format)
+{
+#if defined(HAVE_OPENIMAGEIO) && HAVE_OPENIMAGEIO
+    Q_UNUSED(format);
+    return true;
+#else
+    return format != Format::Exr;
+#endif
+}
+
+QString extensionFor(Format format)
+{
+    switch (format) {
+        case Format::Jpg: return QStringLiteral("jpg");
+        case Format::Png: return QStringLiteral("png");
+        case Format::Tif: return QStringLiteral("tif");
+        case Format::Exr: return QStringLiteral("exr");
+    }
+    return QString();
+}
+
+bool convert(const QString& src, const QString& dst, const Options& opts, QString* errorOut)
+{
+    Frame f;
+    return readFrame(src, f, errorOut) && transformFrame(f, opts, errorOut) && writeFrame(f, dst, opts, errorOut);
+}
+
+StageThreads stageThreads(int threads)
+{
+    threads = qMax(1, threads);
+    StageThreads s;
+    if (threads < 3) {
+        s.whole = threads;
+        return s;
+    }
+    // Decode and encode dominate; resize/colour work is lighter, so it gets fewer workers
+    s.transformers = qMax(1, threads / 4);
+    s.readers = (threads - s.transformers + 1) / 2;
+    s.writers = threads - s.transformers - s.readers;
+    return s;
+}
+
+bool run(const QVector<Item>& items, const Options& opts, int threads,
+         const std::atomic_bool& cancel, const ResultFn& onResult)
+{
+    if (items.isEmpty()) return true;
+    const StageThreads stages = stageThreads(threads);
+    const int readers = stages.readers;
+    const int transformers = stages.transformers;
+    const int writers = stages.writers;
+
+    FrameQueue decoded(2 * qMax(1, transformers), readers);
+    FrameQueue processed(2 * qMax(1, writers), transformers);
+    std::atomic_int next{0};
+    std::atomic_bool allOk{true};
+
+    auto report = [&](int index, bool ok, const QString& err) {
+        if (!ok) allOk = false;
+        if (!onResult) return;
+        Result r;
+        r.item = index;
+        r.tag = items[index].tag;
+        r.ok = ok;
+        r.error = err;
+        onResult(r);
+    };
+
+    std::vector<std::thread> pool;
+    pool.reserve(size_t(readers + transformers + writers + stages.whole));
+    // Too few threads for a pipeline: each one reads, transforms and writes whole files
+    for (int i = 0; i < stages.whole; ++i) {
+        pool.emplace_back([&] {
+            for (int idx = next++; idx < items.size() && !cancel.load(); idx = next++) {
+                Frame f;
+                f.item = idx;
+                QString err;
+                const bool ok = readFrame(items[idx].src, f, &err) && transformFrame(f, opts, &err)
+                                && writeFrame(f, items[idx].dst, opts, &err);
+                report(idx, ok, err);
+            }
+        });
+    }
+    for (int i = 0; i < readers; ++i) {
+        pool.emplace_back([&] {
+            for (int idx = next++; idx < items.size() && !cancel.load(); idx = next++) {
+                auto f = std::make_unique<Frame>();
+                f->item = idx;
+                QString err;
+                if (!readFrame(items[idx].src, *f, &err)) { report(idx, false, err); continue; }
+                if (!decoded.push(std::move(f))) break;
+            }
+            decoded.producerDone();
+        });
+    }
+    for (int i = 0; i < transformers; ++i) {
+        pool.emplace_back([&] {
+            FramePtr f;
+            while (!cancel.load() && decoded.pop(&f)) {
+                QString err;
+                const int idx = f->item;
+                if (!transformFrame(*f, opts, &err)) { report(idx, false, err); continue; }
+                if (!processed.push(std::move(f))) break;
+            }
+            processed.producerDone();
+        });
+    }
+    for (int i = 0; i < writers; ++i) {
+        pool.emplace_back([&] {
+            FramePtr f;
+            while (!cancel.load() && processed.pop(&f)) {
+                QString err;
+                const bool ok = writeFrame(*f, items[f->item].dst, opts, &err);
+                report(f->item, ok, err);
+            }
+            // A cancelled writer must not leave producers blocked on a full queue
+            if (cancel.load()) { decoded.abort(); processed.abort(); }
+        });
+    }
+    for (auto& t : pool) t.join();
+
+    if (cancel.load()) {
+        qInfo() << "[ImageConvertEngine] Cancelled after" << qMin(int(next.load()), int(items.size())) << "of" << items.size() << "items";
+        return false;
+    }
+    return allOk.load();
+}
+
+} // namespace ImageConvertEngine
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <QString>
+#include <QVector>
+#include <atomic>
+#include <functional>
+
+/**
+ * ImageConvertEngine - in-process batch still-image conversion
+ *
+ * Replaces one `magick` process per file for the common formats. Files flow
+ * through a bounded read -> resize -> colorspace -> write pipeline, each stage
+ * on its own worker threads, so decoding frame N+1 overlaps encoding frame N
+ * and only a handful of frames are ever held in memory.
+ *
+ * With OpenImageIO (HAVE_OPENIMAGEIO) inputs are read through ImageInput into a
+ * strided buffer (tiled files are untiled by OIIO, only the first four channels
+ * of multi-layer EXRs are read), float inputs are treated as scene linear and
+ * converted to sRGB, and TIFFs can be written tiled. EXR output keeps the data
+ * scene linear and stores it as half float. Without OIIO, Qt's image plugins
+ * are used and EXR cannot be written.
+ */
+namespace ImageConvertEngine {
+
+enum class Format { Jpg, Png, Tif, Exr };
+
+struct Options {
+    Format format = Format::Jpg;
+    int quality = 90;         // JPEG
+    bool includeAlpha = true; // PNG/TIF; JPEG never carries alpha
+    QString compression;      // TIF: none, lzw, zip, packbits
+    int tileSize = 0;         // TIF: > 0 writes tiled (OIIO only)
+    int scaleWidth = 0;       // 0 keeps that dimension; aspect is preserved when only one is set
+    int scaleHeight = 0;
+    int downscale = 1;        // > 1 divides the (scaled) size by this factor, e.g. 2 for half-res proxies
+};
+
+struct Item {
+    QString src;
+    QString dst;
+    int tag = -1; // caller's reference, passed back in Result
+};
+
+struct Result {
+    int item = -1; // index into the items passed to run()
+    int tag = -1;
+    bool ok = false;
+    QString error;
+};
+
+// Called from pipeline threads, possibly concurrently
+using ResultFn = std::function<void(const Result&)>;
+
+// Whether the engine can decode this file (by extension)
+bool canRead(const QString& path);
+// Whether this build can encode the format (EXR needs OIIO)
+bool canWrite(Format format);
+QString extensionFor(Format format);
+
+bool convert(const QString& src, const QString& dst, const Options& opts, QString* errorOut = nullptr);
+
+// How run() spreads `threads` over the pipeline stages; the counts add up to
+// `threads`. Below three threads there is no pipeline: `whole` workers each
+// convert complete files.
+struct StageThreads {
+    int readers = 0;
+    int transformers = 0;
+    int writers = 0;
+    int whole = 0;
+};
+StageThreads stageThreads(int threads);
+
+// Converts every item on exactly `threads` threads (OIIO's own decode/encode
+// threads are turned off per file, so callers can charge `threads` cores).
+// Returns true when all items succeeded; stops early (remaining items
+// unreported) on cancel.
+bool run(const QVector<Item>& items, const Options& opts, int threads,
+         const std::atomic_bool& cancel, const ResultFn& onResult);
+
+} // namespace ImageConvertEngine
@@ -1,6 +1,9 @@
 #include "live_preview_manager.h"
 
 #include "oiio_image_loader.h"
+#include "media_probe_cache.h"
+#include "perceptual_hash.h"
+#include "proxy_manager.h"
 #include "utils.h"
 #include "media/gstreamer_player.h"
 
@@ -181,6 +184,7 @@ void LivePreviewManager::invalidate(const QString& filePath)
             ++it;
         }
     }
+    m_hashedPaths.remove(filePath);
 }
 
 void LivePreviewManager::clear()
@@ -188,6 +192,7 @@ void LivePreviewManager::clear()
     QMutexLocker locker(&m_mutex);
     m_cache.clear();
     m_inFlight.clear();
+    m_hashedPaths.clear();
 }
 
 int LivePreviewManager::cacheEntryCount() const
@@ -307,7 +312,7 @@ void LivePreviewManager::startDecodeTask(const Request& request, const QString&
         const bool treatAsSequence = fromSequenceQueue || (seqDetectionEnabled && isImageSequence(request.filePath));
         if (treatAsSequence) {
             qDebug() << "[LivePreview] Loading as SEQUENCE:" << request.filePath << "seqDetection=" << seqDetectionEnabled;
-            image = loadSequenceFrame(request, error);
+            image = loadSequenceFrame(proxyRequest(request, true), error);
         } else {
             qDebug() << "[LivePreview] Loading as INDIVIDUAL:" << request.filePath << "seqDetection=" << seqDetectionEnabled;
             QFileInfo info(request.filePath);
@@ -315,10 +320,23 @@ void LivePreviewManager::startDecodeTask(const Request& request, const QString&
             if (isImageExtension(suffix) || isHdrExtension(suffix)) {
                 image = loadImageFrame(request, error);
             } else {
-                image = loadVideoFrame(request, error);
+                image = loadVideoFrame(proxyRequest(request, false), error);
             }
         }
 
+        // Poster decodes double as the source for the similar-image signature
+        if (!image.isNull() && request.position <= 0.0) {
+            bool report = false;
+            {
+                QMutexLocker locker(&m_mutex);
+                if (!m_hashedPaths.contains(request.filePath)) {
+                    m_hashedPaths.insert(request.filePath);
+                    report = true;
+                }
+            }
+            if (report) emit perceptualHashReady(request.filePath, PerceptualHash::dHash(image));
+        }
+
         QMetaObject::invokeMethod(this, [this, request, cacheKey, image, error, fromSequenceQueue]() {
             SequenceTask nextTask;
             bool launchNext = false;
@@ -358,6 +376,38 @@ void LivePreviewManager::startDecodeTask(const Request& request, const QString&
     Q_UNUSED(future);
 }
 
+LivePreviewManager::Request LivePreviewManager::proxyRequest(const Request& request, bool sequence)
+{
+    // Scrubbing never needs full resolution: decode the proxy when there is one.
+    // Frames are still cached and reported under the source path.
+    ProxyManager& proxies = ProxyManager::instance();
+    const QString proxy = sequence ? proxies.sequenceProxy(request.filePath) : proxies.videoProxy(request.filePath);
+    if (!proxy.isEmpty()) {
+        Request decode = request;
+        decode.filePath = proxy;
+        return decode;
+    }
+
+    // Actual scrubbing (not just a poster) of heavy media queues a proxy, once per session
+    if (request.position > 0.0 && proxies.isEnabled() && proxies.autoGenerate()
+        && (!sequence || ProxyManager::sequenceNeedsProxy(request.filePath))) {
+        const QString key = ProxyManager::sourceKey(request.filePath, sequence);
+        bool first = false;
+        {
+            QMutexLocker locker(&m_mutex);
+            if (!m_proxyRequested.contains(key)) {
+                m_proxyRequested.insert(key);
+                first = true;
+            }
+        }
+        if (first) {
+            if (sequence) proxies.requestSequence(ProxyManager::sequenceFrames(request.filePath));
+            else proxies.requestVideo(request.filePath);
+        }
+    }
+    return request;
+}
+
 void LivePreviewManager::storeFrame(const QString& key, const QPixmap& pixmap, qreal position, const QSize& size)
 {
     QMutexLocker locker(&m_mutex);
@@ -614,22 +664,12 @@ QImage LivePreviewManager::loadVideoFrame(const Request& request, QString& error
         return {};
     }
 
-    // Use a static cache to avoid repeated duration queries
-    static QHash<QString, qint64> s_durationCache;
-    static QMutex s_durationMutex;
-
-    qint64 durationMs = 0;
-
-    // Check cache first
-    {
-        QMutexLocker locker(&s_durationMutex);
-        if (s_durationCache.contains(request.filePath)) {
-            durationMs = s_durationCache[request.filePath];
-        }
-    }
-
-    // If not cached, query duration using the new lightweight function
-    if (durationMs == 0) {
+    // Duration comes from the shared probe cache (container header, persisted across runs);
+    // GStreamer is only asked when the header has no duration, and its answer is cached too
+    MediaProbeInfo probe;
+    MediaProbeCache::instance().probe(request.filePath, probe);
+    qint64 durationMs = probe.durationMs;
+    if (durationMs <= 0) {
         durationMs = GStreamerPlayer::queryDuration(request.filePath);
 
         if (durationMs <= 0) {
@@ -637,9 +677,8 @@ QImage LivePreviewManager::loadVideoFrame(const Request& request, QString& error
             return {};
         }
 
-        // Cache the duration
-        QMutexLocker locker(&s_durationMutex);
-        s_durationCache[request.filePath] = durationMs;
+        probe.durationMs = durationMs;
+        MediaProbeCache::instance().insert(request.filePath, probe);
         qDebug() << "[LivePreview] Cached duration for" << request.filePath << ":" << durationMs << "ms";
     }
 
@@ -23,7 +23,9 @@
  *
  * The manager is intentionally agnostic of any particular view; callers provide the
  * requested normalized position (0-1) and target size. Internally the manager performs
- * smart caching and throttles expensive requests so scrubbing stays responsive.
+ * smart caching and throttles expensive requests so scrubbing stays responsive. Videos and
+ * sequences with a ProxyManager proxy are decoded from the proxy; scrubbing heavy media that
+ * has none queues one.
  *
  * **Thread Safety:**
  * - All public methods are thread-safe via internal QMutex (m_mutex)
@@ -85,6 +87,8 @@ signals:
     void frameReady(const QString& filePath, qreal position, QSize targetSize, const QPixmap& pixmap);
     void frameFailed(const QString& filePath, QString errorString);
     void cacheStatus(const QString& status);
+    // Emitted (from a worker thread) once per file for poster decodes; used by SimilarityIndex
+    void perceptualHashReady(const QString& filePath, quint64 hash);
 
 private:
     explicit LivePreviewManager(QObject* parent = nullptr);
@@ -96,6 +100,8 @@ private:
     static QImage loadImageFrame(const Request& request, QString& error);
     QImage loadVideoFrame(const Request& request, QString& error);
     static QImage loadSequenceFrame(const Request& request, QString& error);
+    // Same request pointed at the source's proxy, if one is ready
+    Request proxyRequest(const Request& request, bool sequence);
     bool isImageSequence(const QString& filePath) const;
     static QString sequenceHead(const QString& filePath);
     struct SequenceMeta;
@@ -134,6 +140,8 @@ private:
     mutable QMutex m_mutex;
     QCache<QString, CachedEntry> m_cache;
     QSet<QString> m_inFlight;
+    QSet<QString> m_hashedPaths; // files whose poster dHash was already reported this session
+    QSet<QString> m_proxyRequested; // proxy sources already queued for generation this session
     QList<SequenceTask> m_sequenceQueue;
     QCache<QString, SequenceMeta> m_sequenceMetaCache;
     int m_maxCacheEntries = 256;
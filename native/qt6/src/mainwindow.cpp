@@ -21,8 +21,13 @@
 #include "context_preserver.h"
 #include "database_health_agent.h"
 #include "database_health_dialog.h"
+#include "duplicate_finder.h"
+#include "duplicate_groups_dialog.h"
+#include "similarity_index.h"
+#include "proxy_manager.h"
 #include "bulk_rename_dialog.h"
 #include "everything_search_dialog.h"
+#include "filename_index.h"
 
 #include "office_preview.h"
 
@@ -1813,12 +1818,22 @@ MainWindow::MainWindow(QWidget *parent)
 
     // Load existing project folders into watcher
     auto projectFolders = DB::instance().listProjectFolders();
+    QStringList projectFolderPaths;
     for (const auto& pf : projectFolders) {
         int projectFolderId = pf.first;
         QString path = pf.second.second;
         projectFolderWatcher->addProjectFolder(projectFolderId, path);
+        projectFolderPaths.append(path);
     }
 
+    // Project folders feed the built-in filename index (File Search where Everything is not available)
+    FilenameIndex::instance().setProjectRoots(projectFolderPaths);
+    connect(projectFolderWatcher, &ProjectFolderWatcher::directoryChanged,
+            &FilenameIndex::instance(), &FilenameIndex::refreshDirectory);
+#ifndef Q_OS_WIN
+    FilenameIndex::instance().start();
+#endif
+
     // Create import progress dialog (will be shown when needed)
     importProgressDialog = nullptr;
 
@@ -1939,6 +1954,24 @@ void MainWindow::setupUi()
     dbHealthAction->setShortcut(QKeySequence("Ctrl+H"));
     connect(dbHealthAction, &QAction::triggered, this, &MainWindow::showDatabaseHealthDialog);
 
+    QAction* findDuplicatesAction = toolsMenu->addAction("Find &Duplicates...");
+    connect(findDuplicatesAction, &QAction::triggered, this, &MainWindow::onFindDuplicates);
+    QAction* duplicateGroupsAction = toolsMenu->addAction("Duplicate &Groups...");
+    connect(duplicateGroupsAction, &QAction::triggered, this, &MainWindow::showDuplicateGroupsDialog);
+    connect(&DuplicateFinder::instance(), &DuplicateFinder::scanProgress, this, [this](int stage, qint64 done, qint64 total) {
+        static const char* kStageNames[] = { "Grouping by size", "Hashing candidates", "Verifying candidates" };
+        const int pct = total > 0 ? int(done * 100 / total) : 100;
+        statusBar()->showMessage(QString("Find duplicates: %1... %2%").arg(kStageNames[qBound(0, stage, 2)]).arg(pct));
+    });
+    connect(&DuplicateFinder::instance(), &DuplicateFinder::scanFinished, this, [this](bool cancelled, int groupCount, qint64 reclaimableBytes) {
+        if (cancelled) {
+            statusBar()->showMessage("Find duplicates: cancelled", 5000);
+            return;
+        }
+        const QString sizeStr = QString::number(reclaimableBytes / (1024.0 * 1024.0 * 1024.0), 'f', 2) + " GB";
+        statusBar()->showMessage(QString("Find duplicates: %1 groups, %2 reclaimable").arg(groupCount).arg(sizeStr), 15000);
+    });
+
     // Tabs: Asset Manager | File Manager
     mainTabs = new QTabWidget(this);
     mainTabs->setDocumentMode(true);
@@ -2146,6 +2179,8 @@ void MainWindow::setupUi()
     assetTableView->setSelectionBehavior(QAbstractItemView::SelectRows);
     assetTableView->setSelectionMode(QAbstractItemView::ExtendedSelection);
     assetTableView->setContextMenuPolicy(Qt::CustomContextMenu);
+    // Natural name order until the user picks a column (the header defaults to descending)
+    assetTableView->horizontalHeader()->setSortIndicator(AssetsTableModel::NameColumn, Qt::AscendingOrder);
     assetTableView->setSortingEnabled(true);
     assetTableView->setAlternatingRowColors(false);
     assetTableView->setShowGrid(false);
@@ -2242,6 +2277,12 @@ void MainWindow::setupUi()
 
     searchBox = new QLineEdit(this);
     searchBox->setPlaceholderText("Search... (Press Enter)");
+    searchBox->setToolTip(
+        "Words match file names and paths. Fields narrow the search:\n"
+        "ext:exr,dpx  name:plate  path:/shows/abc  tag:hero\n"
+        "rating:>=4  size:>2GB  frames:>100  modified:<7d  modified:>=2024-01-01\n"
+        "Use OR between terms for alternatives and -term to exclude."
+    );
     searchBox->setStyleSheet(
         "QLineEdit { background-color: #1a1a1a; color: #ffffff; border: 1px solid #333; padding: 6px; border-radius: 4px; }"
     );
@@ -2367,6 +2408,17 @@ void MainWindow::setupUi()
     tagsListView = new QListView(filtersPanel);
     tagsModel = new TagsModel(this);
     tagsListView->setModel(tagsModel);
+
+    // Option counts for the current scope, refreshed as filters and rows change
+    connect(assetsModel, &AssetsModel::facetCountsChanged, this, [this]() {
+        const AssetsModel::FacetCounts& facets = assetsModel->facetCounts();
+        const int* r = facets.ratings;
+        const int counts[] = {r[0] + r[1] + r[2] + r[3] + r[4] + r[5], r[5], r[4] + r[5], r[3] + r[4] + r[5], r[0]};
+        static const char* labels[] = {"All", "5 Stars", "4+ Stars", "3+ Stars", "Unrated"};
+        for (int i = 0; i < ratingFilter->count() && i < 5; ++i)
+            ratingFilter->setItemText(i, QString("%1 (%2)").arg(labels[i]).arg(counts[i]));
+        tagsModel->setCounts(facets.tags);
+    });
     tagsListView->setSelectionMode(QAbstractItemView::MultiSelection);
     tagsListView->setContextMenuPolicy(Qt::CustomContextMenu);
     tagsListView->setStyleSheet("");
@@ -2679,6 +2731,49 @@ void MainWindow::setupUi()
 
     // Schedule database health check on startup (delayed to avoid blocking UI)
     QTimer::singleShot(2000, this, &MainWindow::performStartupHealthCheck);
+
+    // Start collecting poster-frame signatures for "Find Similar Images"
+    SimilarityIndex::instance();
+
+    // Verified copies already hashed every byte: record the digests for catalogued sources and destinations
+    connect(&FileOpsQueue::instance(), &FileOpsQueue::transferVerified, this,
+            [this](int, const QVector<TransferScheduler::VerifiedFile>& files, const QString& manifestPath) {
+        QHash<int, ComputedChecksum> checksums;
+        for (const auto& f : files) {
+            for (const QString& path : {f.src, f.dst}) {
+                const int assetId = DB::instance().getAssetIdByPath(path);
+                if (assetId > 0) {
+                    checksums.insert(assetId, {f.size, QFileInfo(path).lastModified().toMSecsSinceEpoch(), f.sha256});
+                }
+            }
+        }
+        DB::instance().storeComputedChecksums(checksums);
+        statusBar()->showMessage(QString("Verified %1 file(s), manifest: %2").arg(files.size()).arg(manifestPath), 8000);
+    });
+
+    // Link finished playback proxies to their catalog assets; evicted proxies are unlinked
+    connect(&ProxyManager::instance(), &ProxyManager::proxyReady, this, [](const ProxyInfo& info) {
+        AssetProxyRow row;
+        row.assetId = info.assetId > 0 ? info.assetId : DB::instance().getAssetIdByPath(info.sourcePath);
+        if (row.assetId <= 0) return;
+        row.sourceKey = info.sourceKey;
+        row.proxyPath = info.proxyPath;
+        row.kind = ProxyInfo::kindName(info.kind);
+        row.scale = info.scale;
+        row.byteSize = info.byteSize;
+        DB::instance().setAssetProxy(row);
+    });
+    connect(&ProxyManager::instance(), &ProxyManager::proxyRemoved, this, [](const QString& sourceKey, int) {
+        DB::instance().removeAssetProxyBySourceKey(sourceKey);
+    });
+    // Drop catalog links whose proxy was cleared from the cache directory
+    QTimer::singleShot(3000, this, [] {
+        QSet<QString> live;
+        for (const ProxyInfo& p : ProxyManager::instance().proxies()) live.insert(p.sourceKey);
+        for (const AssetProxyRow& row : DB::instance().listAssetProxies()) {
+            if (!live.contains(row.sourceKey)) DB::instance().removeAssetProxy(row.assetId);
+        }
+    });
 }
 
 void MainWindow::performStartupHealthCheck()
@@ -3902,6 +3997,17 @@ void MainWindow::onFmPaste()
     fmClipboardCutMode = false;
 }
 
+void MainWindow::onFmPasteVerified()
+{
+    if (fmClipboard.isEmpty() || fmClipboardCutMode) return;
+    const QString destDir = fmDirModel->rootPath();
+    releaseAnyPreviewLocksForPaths(fmClipboard);
+    FileOpsQueue::instance().enqueueVerifiedCopy(fmClipboard, destDir);
+    if (!fileOpsDialog) fileOpsDialog = new FileOpsProgressDialog(this);
+    fileOpsDialog->show(); fileOpsDialog->raise(); fileOpsDialog->activateWindow();
+    fmClipboard.clear();
+}
+
 void MainWindow::onFmDelete()
 {
     if (qobject_cast<QShortcut*>(sender())) {
@@ -4149,6 +4255,7 @@ void MainWindow::onFmShowContextMenu(const QPoint &pos)
     QAction *copyA = menu.addAction("Copy", this, &MainWindow::onFmCopy, QKeySequence::Copy);
     QAction *cutA = menu.addAction("Cut", this, &MainWindow::onFmCut, QKeySequence::Cut);
     QAction *pasteA = menu.addAction("Paste", this, &MainWindow::onFmPaste, QKeySequence::Paste);
+    QAction *pasteVerifiedA = menu.addAction("Paste Verified (with Manifest)", this, &MainWindow::onFmPasteVerified);
     menu.addSeparator();
     QAction *renameA = menu.addAction("Rename", this, &MainWindow::onFmRename, QKeySequence(Qt::Key_F2));
     QAction *bulkRenameA = menu.addAction("Bulk Rename...", this, &MainWindow::onFmBulkRename);
@@ -4175,6 +4282,7 @@ void MainWindow::onFmShowContextMenu(const QPoint &pos)
     bulkRenameA->setEnabled(selCount >= 2);
     delA->setEnabled(hasSel);
     pasteA->setEnabled(!fmClipboard.isEmpty());
+    pasteVerifiedA->setEnabled(!fmClipboard.isEmpty() && !fmClipboardCutMode);
     addLibA->setEnabled(hasSel);
     favA->setEnabled(hasSel);
     createFolderWithSel->setEnabled(hasSel);
@@ -4738,10 +4846,18 @@ void MainWindow::onAssetSelectionChanged()
     updateInfoPanel();
 }
 
+// Views hand out indexes of their own model; the preview works in AssetsModel rows
+static int assetsModelRow(const QModelIndex& index)
+{
+    if (const auto* table = qobject_cast<const AssetsTableModel*>(index.model()))
+        return table->mapToSource(index.row());
+    return index.row();
+}
+
 void MainWindow::onAssetDoubleClicked(const QModelIndex &index)
 {
     if (!index.isValid()) return;
-    showPreview(index.row());
+    showPreview(assetsModelRow(index));
 }
 
 void MainWindow::onAssetContextMenu(const QPoint &pos)
@@ -4764,6 +4880,7 @@ void MainWindow::onAssetContextMenu(const QPoint &pos)
         // Asset context menu
         QAction *openAction = menu.addAction("Open Preview");
         QAction *showInExplorerAction = menu.addAction("Show in Explorer");
+        QAction *findSimilarAction = menu.addAction("Find Similar Images");
         menu.addSeparator();
 
 
@@ -4840,18 +4957,41 @@ void MainWindow::onAssetContextMenu(const QPoint &pos)
             }
         }
 
+        // Generate Playback Proxies for selected videos and image sequences
+        QAction *proxyAction = nullptr;
+        struct ProxySource { int id; QString path; bool sequence; int start; int end; };
+        QVector<ProxySource> proxySources;
+        if (ProxyManager::instance().isEnabled() && assetsModel) {
+            const QSet<int> ids = getSelectedAssetIds();
+            const int rows = assetsModel->rowCount(QModelIndex());
+            for (int r = 0; r < rows && !ids.isEmpty(); ++r) {
+                const QModelIndex mi = assetsModel->index(r, 0);
+                const int id = mi.data(AssetsModel::IdRole).toInt();
+                if (!ids.contains(id)) continue;
+                const QString fp = mi.data(AssetsModel::FilePathRole).toString();
+                const bool seq = mi.data(AssetsModel::IsSequenceRole).toBool();
+                if (seq || isVideoFile(QFileInfo(fp).suffix())) {
+                    proxySources.append({id, fp, seq, mi.data(AssetsModel::SequenceStartFrameRole).toInt(),
+                                         mi.data(AssetsModel::SequenceEndFrameRole).toInt()});
+                }
+            }
+            if (!proxySources.isEmpty()) proxyAction = menu.addAction("Generate Playback Proxies");
+        }
+
         QAction *removeAction = menu.addAction("Remove from App");
 
         QAction *selected = menu.exec(assetGridView->mapToGlobal(pos));
 
         if (selected == openAction) {
-            showPreview(index.row());
+            showPreview(assetsModelRow(index));
         } else if (selected == showInExplorerAction) {
             QString filePath = index.data(AssetsModel::FilePathRole).toString();
             QFileInfo fileInfo(filePath);
             QStringList args;
             args << "/select," + QDir::toNativeSeparators(fileInfo.absoluteFilePath());
             QProcess::startDetached("explorer", args);
+        } else if (selected == findSimilarAction) {
+            showSimilarAssets(index.data(AssetsModel::IdRole).toInt());
         } else if (selected == convertAction) {
             releaseAnyPreviewLocksForPaths(selectedAssetFilePaths);
             auto *dlg = new MediaConvertDialog(selectedAssetFilePaths, this);
@@ -4860,6 +5000,16 @@ void MainWindow::onAssetContextMenu(const QPoint &pos)
             connect(dlg, &QObject::destroyed, this, [this](){ QTimer::singleShot(100, this, &MainWindow::onFmRefresh); });
             dlg->show(); dlg->raise(); dlg->activateWindow();
 
+        } else if (proxyAction && selected == proxyAction) {
+            int queued = 0;
+            for (const ProxySource& src : proxySources) {
+                const bool ok = src.sequence
+                    ? ProxyManager::instance().requestSequence(reconstructSequenceFramePaths(src.path, src.start, src.end), src.id, true)
+                    : ProxyManager::instance().requestVideo(src.path, src.id, true);
+                if (ok) ++queued;
+            }
+            statusBar()->showMessage(queued > 0 ? QString("Generating %1 playback prox%2 in the background").arg(queued).arg(queued == 1 ? "y" : "ies")
+                                                : QString("Playback proxies are already up to date"), 4000);
         } else if (selected && assignTagMenu->actions().contains(selected)) {
             // Assign tag action
             int tagId = selected->data().toInt();
@@ -5051,6 +5201,7 @@ void MainWindow::onFolderContextMenu(const QPoint &pos)
 
             // Delete project folders
             for (int projFolderId : projectFolderIds) {
+                FilenameIndex::instance().removeProjectRoot(DB::instance().getProjectFolderPath(projFolderId));
                 projectFolderWatcher->removeProjectFolder(projFolderId);
                 if (DB::instance().deleteProjectFolder(projFolderId)) {
                     deletedCount++;
@@ -5106,8 +5257,9 @@ void MainWindow::showPreview(int index)
         assetGridView->scrollTo(modelIndex, QAbstractItemView::PositionAtCenter);
     }
     if (assetTableView && assetTableView->model()) {
-        // Table view may use a different model; fall back to row index
-        QModelIndex tIdx = assetTableView->model()->index(index, 0);
+        // Table rows are sorted independently of AssetsModel
+        const auto* table = qobject_cast<const AssetsTableModel*>(assetTableView->model());
+        QModelIndex tIdx = assetTableView->model()->index(table ? table->mapFromSource(index) : index, 0);
         if (tIdx.isValid()) {
             if (QItemSelectionModel* sel = assetTableView->selectionModel()) {
                 sel->setCurrentIndex(tIdx, QItemSelectionModel::ClearAndSelect | QItemSelectionModel::Rows);
@@ -5193,7 +5345,8 @@ void MainWindow::closePreview()
                 assetGridView->setFocus();
             }
         } else if (assetTableView && assetTableView->model()) {
-            QModelIndex idx = assetTableView->model()->index(lastAssetIndex, 0);
+            const auto* table = qobject_cast<const AssetsTableModel*>(assetTableView->model());
+            QModelIndex idx = assetTableView->model()->index(table ? table->mapFromSource(lastAssetIndex) : lastAssetIndex, 0);
             if (idx.isValid()) {
                 assetTableView->setCurrentIndex(idx);
                 assetTableView->setFocus();
@@ -5213,11 +5366,15 @@ void MainWindow::changePreview(int delta)
 
     const int rowCount = assetsModel->rowCount(QModelIndex());
     const int step = (delta > 0) ? 1 : -1;
-    int searchIndex = previewIndex + delta;
+    // In list mode, step through the table's sorted order
+    const AssetsTableModel* table = (!isGridMode && assetTableView)
+        ? qobject_cast<const AssetsTableModel*>(assetTableView->model()) : nullptr;
+    int searchIndex = (table ? table->mapFromSource(previewIndex) : previewIndex) + delta;
 
     // Search for next viewable file
     while (searchIndex >= 0 && searchIndex < rowCount) {
-        QModelIndex modelIndex = assetsModel->index(searchIndex, 0);
+        const int sourceRow = table ? table->mapToSource(searchIndex) : searchIndex;
+        QModelIndex modelIndex = assetsModel->index(sourceRow, 0);
         if (!modelIndex.isValid()) {
             searchIndex += step;
             continue;
@@ -5228,7 +5385,7 @@ void MainWindow::changePreview(int delta)
         QString fileType = modelIndex.data(AssetsModel::FileTypeRole).toString();
 
         if (isSequence || isPreviewOverlayViewable(fileType)) {
-            showPreview(searchIndex);
+            showPreview(sourceRow);
             return;
         }
 
@@ -6102,7 +6259,7 @@ bool MainWindow::eventFilter(QObject *watched, QEvent *event)
             if (!selected.isEmpty()) {
                 // Open preview for the first selected item
                 QModelIndex index = selected.first();
-                showPreview(index.row());
+                showPreview(assetsModelRow(index));
                 return true; // Event handled
             }
         }
@@ -7175,6 +7332,7 @@ void MainWindow::onAddProjectFolder()
 
     // Add to watcher
     projectFolderWatcher->addProjectFolder(projectFolderId, folderPath);
+    FilenameIndex::instance().addProjectRoot(folderPath);
 
     // Reload folder tree
     folderModel->reload();
@@ -8415,6 +8573,72 @@ void MainWindow::showDatabaseHealthDialog()
     dialog.exec();
 }
 
+void MainWindow::onFindDuplicates()
+{
+    DuplicateFinder& finder = DuplicateFinder::instance();
+    if (finder.isRunning()) {
+        if (QMessageBox::question(this, "Find Duplicates", "A duplicate scan is already running. Cancel it?") == QMessageBox::Yes) {
+            finder.cancel();
+        }
+        return;
+    }
+    // Catalog-wide scan; results land in the duplicate_groups/duplicate_files tables
+    finder.start(/*includeCatalog=*/true);
+}
+
+void MainWindow::showDuplicateGroupsDialog()
+{
+    DuplicateGroupsDialog dialog(this);
+    dialog.exec();
+}
+
+void MainWindow::showSimilarAssets(int assetId)
+{
+    SimilarityIndex& index = SimilarityIndex::instance();
+    if (!index.hasHash(assetId)) {
+        // Signature comes from the poster decode; queue one and let the user retry
+        const QString path = DB::instance().getAssetFilePath(assetId);
+        if (!path.isEmpty()) LivePreviewManager::instance().requestFrame(path, QSize(256, 256));
+        statusBar()->showMessage("Visual signature not ready yet for this asset; try again in a moment", 4000);
+        return;
+    }
+
+    const auto matches = index.findSimilar(assetId);
+    if (matches.isEmpty()) {
+        statusBar()->showMessage("No similar images found", 3000);
+        return;
+    }
+
+    QDialog dlg(this);
+    dlg.setWindowTitle(QString("Similar Images (%1)").arg(matches.size()));
+    dlg.resize(560, 420);
+    QVBoxLayout* layout = new QVBoxLayout(&dlg);
+    QListWidget* list = new QListWidget(&dlg);
+    list->setStyleSheet("QListWidget{background:#0a0a0a; border:none; color:#fff;} QListWidget::item:selected{background:#2f3a4a;}");
+    for (const auto& m : matches) {
+        const QString path = DB::instance().getAssetFilePath(m.id);
+        // 64-bit dHash: 0 = identical signature, <=5 near-duplicate, <=12 similar
+        auto* item = new QListWidgetItem(QString("%1    (distance %2)").arg(QFileInfo(path).fileName()).arg(m.distance), list);
+        item->setToolTip(path);
+        item->setData(Qt::UserRole, m.id);
+    }
+    layout->addWidget(list);
+    connect(list, &QListWidget::itemDoubleClicked, &dlg, [this](QListWidgetItem* item) {
+        // Select the match in the current view when it is visible there
+        const int id = item->data(Qt::UserRole).toInt();
+        const int rows = assetsModel->rowCount(QModelIndex());
+        for (int r = 0; r < rows; ++r) {
+            if (assetsModel->index(r, 0).data(AssetsModel::IdRole).toInt() == id) {
+                selectSingle(id, r);
+                assetGridView->scrollTo(assetsModel->index(r, 0));
+                return;
+            }
+        }
+        statusBar()->showMessage("Asset is not in the current folder view", 3000);
+    });
+    dlg.exec();
+}
+
 void MainWindow::onEverythingSearchAssetManager()
 {
     EverythingSearchDialog dialog(EverythingSearchDialog::AssetManagerMode, this);
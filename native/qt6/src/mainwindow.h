@@ -108,6 +108,9 @@ private slots:
     // Database health
     void showDatabaseHealthDialog();
     void performStartupHealthCheck();
+    void onFindDuplicates();
+    void showDuplicateGroupsDialog();
+    void showSimilarAssets(int assetId);
 
     // File Manager slots
     void onFmTreeCurrentChanged(const QModelIndex &current, const QModelIndex &previous);
@@ -127,6 +130,7 @@ private slots:
     void onFmCopy();
     void onFmCut();
     void onFmPaste();
+    void onFmPasteVerified();
     void onFmDelete();
     void onFmDeletePermanent();
     void onFmRename();
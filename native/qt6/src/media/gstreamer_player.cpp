@@ -12,6 +12,10 @@
 #include <QMutexLocker>
 #include <QApplication>
 #include <QScreen>
+#include <QMetaObject>
+#include <memory>
+#include <QFutureWatcher>
+#include <QtConcurrent/QtConcurrentRun>
 
 #ifdef HAVE_GSTREAMER
 #include <gst/gst.h>
@@ -26,6 +30,170 @@
 
 bool GStreamerPlayer::s_gstInitialized = false;
 
+/**
+ * GopDecoder - headless playbin + appsink that decodes a time range forward
+ *
+ * Feeds the frame ring for backward stepping. The pipeline is kept between fills
+ * and only rebuilt when the file or the decode size changes. Used from one worker
+ * thread at a time (GStreamerPlayer never runs two fills at once).
+ */
+class GStreamerPlayer::GopDecoder {
+public:
+    ~GopDecoder() { close(); }
+
+    // Frames with startMs <= t < endMs (the seek snaps back to the keyframe before startMs);
+    // at most maxFrames, keeping the latest. Stops early once generation moves on.
+    QVector<DecodedFrame> decode(const QString& uri, const QSize& size, qint64 startMs, qint64 endMs, int maxFrames,
+                                 const std::atomic<quint64>& generation, quint64 myGeneration);
+
+private:
+    bool open(const QString& uri, const QSize& size);
+    void close();
+
+#ifdef HAVE_GSTREAMER
+    bool waitAsyncDone(GstClockTime timeout);
+
+    GstElement* m_pipeline = nullptr;
+    GstElement* m_sink = nullptr;
+#endif
+    QString m_uri;
+    QSize m_size;
+};
+
+QVector<GStreamerPlayer::DecodedFrame> GStreamerPlayer::GopDecoder::decode(const QString& uri, const QSize& size,
+                                                                          qint64 startMs, qint64 endMs, int maxFrames,
+                                                                          const std::atomic<quint64>& generation,
+                                                                          quint64 myGeneration)
+{
+    QVector<DecodedFrame> frames;
+#ifdef HAVE_GSTREAMER
+    if ((uri != m_uri || size != m_size) && !open(uri, size)) return frames;
+
+    if (!gst_element_seek_simple(m_pipeline, GST_FORMAT_TIME,
+                                 static_cast<GstSeekFlags>(GST_SEEK_FLAG_FLUSH | GST_SEEK_FLAG_KEY_UNIT | GST_SEEK_FLAG_SNAP_BEFORE),
+                                 startMs * GST_MSECOND)
+        || !waitAsyncDone(2 * GST_SECOND)) {
+        qWarning() << "[GStreamerPlayer] GOP decode: seek failed at" << startMs << "ms";
+        close();
+        return frames;
+    }
+    gst_element_set_state(m_pipeline, GST_STATE_PLAYING);
+
+    int misses = 0;
+    while (generation.load() == myGeneration) {
+        GstSample* sample = gst_app_sink_try_pull_sample(GST_APP_SINK(m_sink), 250 * GST_MSECOND);
+        if (!sample) {
+            if (gst_app_sink_is_eos(GST_APP_SINK(m_sink)) || ++misses >= 8) break;
+            continue;
+        }
+        misses = 0;
+        GstBuffer* buffer = gst_sample_get_buffer(sample);
+        GstVideoInfo info;
+        const bool haveInfo = gst_video_info_from_caps(&info, gst_sample_get_caps(sample));
+        const GstSegment* segment = gst_sample_get_segment(sample);
+        qint64 timeMs = -1;
+        if (buffer && GST_BUFFER_PTS_IS_VALID(buffer)) {
+            const guint64 streamTime = segment ? gst_segment_to_stream_time(segment, GST_FORMAT_TIME, GST_BUFFER_PTS(buffer))
+                                               : GST_BUFFER_PTS(buffer);
+            if (streamTime != GST_CLOCK_TIME_NONE) timeMs = qint64(streamTime / GST_MSECOND);
+        }
+        if (timeMs >= endMs) {
+            gst_sample_unref(sample);
+            break;
+        }
+        GstMapInfo map;
+        if (timeMs >= 0 && haveInfo && gst_buffer_map(buffer, &map, GST_MAP_READ)) {
+            // BGRx is QImage::Format_RGB32 in memory on little-endian machines
+            const QImage view(map.data, GST_VIDEO_INFO_WIDTH(&info), GST_VIDEO_INFO_HEIGHT(&info),
+                              GST_VIDEO_INFO_PLANE_STRIDE(&info, 0), QImage::Format_RGB32);
+            frames.append(DecodedFrame{timeMs, view.copy()});
+            gst_buffer_unmap(buffer, &map);
+            if (frames.size() > maxFrames) frames.removeFirst();
+        }
+        gst_sample_unref(sample);
+    }
+    // Stop pushing buffers until the next fill
+    gst_element_set_state(m_pipeline, GST_STATE_PAUSED);
+#else
+    Q_UNUSED(uri);
+    Q_UNUSED(size);
+    Q_UNUSED(startMs);
+    Q_UNUSED(endMs);
+    Q_UNUSED(maxFrames);
+    Q_UNUSED(generation);
+    Q_UNUSED(myGeneration);
+#endif
+    return frames;
+}
+
+bool GStreamerPlayer::GopDecoder::open(const QString& uri, const QSize& size)
+{
+    close();
+#ifdef HAVE_GSTREAMER
+    m_pipeline = gst_element_factory_make("playbin", nullptr);
+    m_sink = gst_element_factory_make("appsink", nullptr);
+    if (!m_pipeline || !m_sink) {
+        qWarning() << "[GStreamerPlayer] GOP decode: failed to create playbin/appsink";
+        if (m_sink) gst_object_unref(m_sink);
+        m_sink = nullptr;
+        close();
+        return false;
+    }
+    // Every frame is needed, in order and as fast as it decodes
+    g_object_set(m_sink, "emit-signals", FALSE, "sync", FALSE, "drop", FALSE, "max-buffers", 4, nullptr);
+    GstCaps* caps = gst_caps_new_simple("video/x-raw",
+                                        "format", G_TYPE_STRING, "BGRx",
+                                        "width", G_TYPE_INT, size.width(),
+                                        "height", G_TYPE_INT, size.height(),
+                                        "pixel-aspect-ratio", GST_TYPE_FRACTION, 1, 1,
+                                        nullptr);
+    gst_app_sink_set_caps(GST_APP_SINK(m_sink), caps);
+    gst_caps_unref(caps);
+    // Video only (GST_PLAY_FLAG_VIDEO): no audio decoding or output
+    g_object_set(m_pipeline, "uri", uri.toUtf8().constData(), "video-sink", m_sink, "flags", 0x1, nullptr);
+
+    if (gst_element_set_state(m_pipeline, GST_STATE_PAUSED) == GST_STATE_CHANGE_FAILURE || !waitAsyncDone(2 * GST_SECOND)) {
+        qWarning() << "[GStreamerPlayer] GOP decode: preroll failed for" << uri;
+        close();
+        return false;
+    }
+    m_uri = uri;
+    m_size = size;
+    return true;
+#else
+    Q_UNUSED(uri);
+    Q_UNUSED(size);
+    return false;
+#endif
+}
+
+void GStreamerPlayer::GopDecoder::close()
+{
+#ifdef HAVE_GSTREAMER
+    if (m_pipeline) {
+        gst_element_set_state(m_pipeline, GST_STATE_NULL);
+        gst_object_unref(m_pipeline); // owns the sink once it is set as video-sink
+    }
+    m_pipeline = nullptr;
+    m_sink = nullptr;
+#endif
+    m_uri.clear();
+    m_size = QSize();
+}
+
+#ifdef HAVE_GSTREAMER
+bool GStreamerPlayer::GopDecoder::waitAsyncDone(GstClockTime timeout)
+{
+    GstBus* bus = gst_element_get_bus(m_pipeline);
+    GstMessage* msg = gst_bus_timed_pop_filtered(bus, timeout,
+        static_cast<GstMessageType>(GST_MESSAGE_ASYNC_DONE | GST_MESSAGE_ERROR));
+    const bool done = msg && GST_MESSAGE_TYPE(msg) == GST_MESSAGE_ASYNC_DONE;
+    if (msg) gst_message_unref(msg);
+    gst_object_unref(bus);
+    return done;
+}
+#endif
+
 GStreamerPlayer::~GStreamerPlayer()
 {
 #ifdef HAVE_GSTREAMER
@@ -80,12 +248,17 @@ GStreamerPlayer::GStreamerPlayer(QObject* parent)
 
     // Create timers
     m_positionTimer = new QTimer(this);
-    m_positionTimer->setInterval(33); // ~30fps for smooth position updates
+    m_positionTimer->setInterval(33); // ~30fps playhead repaint while playing; stopped otherwise
     connect(m_positionTimer, &QTimer::timeout, this, &GStreamerPlayer::onPositionUpdate);
 
-    m_busTimer = new QTimer(this);
-    m_busTimer->setInterval(10); // Check bus messages frequently for responsiveness
-    connect(m_busTimer, &QTimer::timeout, this, &GStreamerPlayer::onBusMessage);
+    m_reverseTimer = new QTimer(this);
+    m_reverseTimer->setTimerType(Qt::PreciseTimer);
+    connect(m_reverseTimer, &QTimer::timeout, this, &GStreamerPlayer::onReverseTick);
+
+    m_resyncTimer = new QTimer(this);
+    m_resyncTimer->setSingleShot(true);
+    m_resyncTimer->setInterval(250);
+    connect(m_resyncTimer, &QTimer::timeout, this, &GStreamerPlayer::onResyncTimeout);
 #endif
 }
 
@@ -98,9 +271,11 @@ void GStreamerPlayer::cleanup()
         m_positionTimer->stop();
     }
 
-    if (m_busTimer) {
-        m_busTimer->stop();
-    }
+    // The GOP decoder runs its own pipeline on a worker thread; let it finish first
+    stopReverse();
+    resetFrameRing();
+    m_ringFill.waitForFinished();
+    m_gopDecoder.reset();
 
     if (m_pipeline) {
         gst_element_set_state(m_pipeline, GST_STATE_NULL);
@@ -109,9 +284,12 @@ void GStreamerPlayer::cleanup()
     }
 
     if (m_bus) {
+        // The pipeline is in NULL, so no streaming thread can be inside the handler
+        gst_bus_set_sync_handler(m_bus, nullptr, nullptr, nullptr);
         gst_object_unref(m_bus);
         m_bus = nullptr;
     }
+    m_anchorValid = false;
 #endif
 }
 
@@ -128,6 +306,7 @@ void GStreamerPlayer::setVideoWidget(QWidget* widget)
 
         // Force creation of native window handle
         m_videoWidget->winId();
+        cacheWindowGeometry();
 
         qDebug() << "[GStreamerPlayer] Video widget configured for embedding, WId:" << m_videoWidget->winId();
     }
@@ -153,6 +332,15 @@ void GStreamerPlayer::loadMedia(const QString& filePath)
     QString uri = QUrl::fromLocalFile(filePath).toString();
     m_currentUri = uri;
 
+    m_seekInFlight = false;
+    m_queuedSeekMs = -1;
+    m_lastKeyframeSeekMs = -1;
+    stopReverse();
+    clearMemoryFrame();
+    resetFrameRing();
+    m_currentPath = fileInfo.absoluteFilePath();
+    buildKeyframeIndex(m_currentPath);
+
     qInfo() << "[GStreamerPlayer] Loading media:" << uri;
 
     // PERFORMANCE FIX: Reuse existing pipeline if available
@@ -161,6 +349,7 @@ void GStreamerPlayer::loadMedia(const QString& filePath)
     if (m_pipeline) {
         // Stop current playback
         gst_element_set_state(m_pipeline, GST_STATE_READY);
+        ++m_busGeneration;
 
         // Change URI - playbin will handle codec detection automatically
         g_object_set(m_pipeline, "uri", uri.toUtf8().constData(), nullptr);
@@ -178,6 +367,7 @@ void GStreamerPlayer::loadMedia(const QString& filePath)
         qInfo() << "[GStreamerPlayer] Reusing existing pipeline with new URI (async preroll)";
     } else {
         // First time - create pipeline
+        ++m_busGeneration;
         setupPipeline(uri);
     }
 #else
@@ -241,46 +431,38 @@ void GStreamerPlayer::setupPipeline(const QString& uri)
     // Get bus for messages
     m_bus = gst_element_get_bus(m_pipeline);
 
-    // CRITICAL: Set sync handler for prepare-window-handle message
-    // This must be done BEFORE setting pipeline state to ensure we catch the message
+    // CRITICAL: Set the sync handler BEFORE setting the pipeline state so that
+    // prepare-window-handle is never missed. Every other message is handed to the GUI
+    // thread right away, so state changes, EOS and seek completion cost no polling delay.
     gst_bus_set_sync_handler(m_bus,
         [](GstBus* bus, GstMessage* msg, gpointer user_data) -> GstBusSyncReply {
+            Q_UNUSED(bus);
             GStreamerPlayer* player = static_cast<GStreamerPlayer*>(user_data);
 
-            // Handle prepare-window-handle message synchronously
-            if (GST_MESSAGE_TYPE(msg) == GST_MESSAGE_ELEMENT &&
-                gst_is_video_overlay_prepare_window_handle_message(msg)) {
-
-                qInfo() << "[GStreamerPlayer] Sync handler: prepare-window-handle message";
-
-                if (player->m_videoWidget) {
-                    GstElement* sink = GST_ELEMENT(GST_MESSAGE_SRC(msg));
-                    WId windowId = player->m_videoWidget->winId();
-
-                    if (windowId && GST_IS_VIDEO_OVERLAY(sink)) {
-#ifdef Q_OS_WIN
-                        gst_video_overlay_set_window_handle(GST_VIDEO_OVERLAY(sink), (guintptr)windowId);
-#else
-                        gst_video_overlay_set_window_handle(GST_VIDEO_OVERLAY(sink), windowId);
-#endif
-                        qInfo() << "[GStreamerPlayer] Sync handler set window handle:" << windowId
-                                << "on element:" << GST_ELEMENT_NAME(sink);
-
-                        // Set render rectangle
-                        gst_video_overlay_set_render_rectangle(GST_VIDEO_OVERLAY(sink),
-                                                                0, 0,
-                                                                player->m_videoWidget->width(),
-                                                                player->m_videoWidget->height());
-                    }
+            // The sink waits for its window on this (streaming) thread; answer from the cache
+            if (gst_is_video_overlay_prepare_window_handle_message(msg)) {
+                GstElement* sink = GST_ELEMENT(GST_MESSAGE_SRC(msg));
+                const quintptr windowId = player->m_windowId.load();
+                if (windowId && GST_IS_VIDEO_OVERLAY(sink)) {
+                    gst_video_overlay_set_window_handle(GST_VIDEO_OVERLAY(sink), guintptr(windowId));
+                    gst_video_overlay_set_render_rectangle(GST_VIDEO_OVERLAY(sink), 0, 0,
+                                                           player->m_windowWidth.load(),
+                                                           player->m_windowHeight.load());
+                    qInfo() << "[GStreamerPlayer] Sync handler set window handle:" << windowId
+                            << "on element:" << GST_ELEMENT_NAME(sink);
                 }
-
-                // Drop the message, we've handled it
                 gst_message_unref(msg);
                 return GST_BUS_DROP;
             }
 
-            // Pass all other messages to the async handler
-            return GST_BUS_PASS;
+            // Queued to the player's thread; the shared_ptr releases the message even
+            // if the player is gone before the event is delivered
+            std::shared_ptr<GstMessage> message(msg, gst_message_unref);
+            const quint64 generation = player->m_busGeneration.load();
+            QMetaObject::invokeMethod(player, [player, message, generation]() {
+                player->handleBusMessage(message.get(), generation);
+            }, Qt::QueuedConnection);
+            return GST_BUS_DROP;
         },
         this,
         nullptr);
@@ -293,13 +475,10 @@ void GStreamerPlayer::setupPipeline(const QString& uri)
         return;
     }
 
-    // Start bus message processing
-    m_busTimer->start();
-
     // PERFORMANCE FIX: Do NOT wait for preroll here - it blocks the UI!
     // Instead, preroll happens asynchronously in the background.
     // When preroll completes, we'll get GST_MESSAGE_ASYNC_DONE on the bus.
-    // The bus handler will call updateMediaInfo() when ready.
+    // handleBusMessage() will call updateMediaInfo() when ready.
 
     // Set window handle for video overlay immediately
     if (m_videoWidget) {
@@ -399,9 +578,22 @@ void GStreamerPlayer::setWindowHandle()
 #endif
 }
 
+void GStreamerPlayer::cacheWindowGeometry()
+{
+    if (!m_videoWidget) {
+        m_windowId = 0;
+        return;
+    }
+    const qreal dpr = m_videoWidget->devicePixelRatio();
+    m_windowId = quintptr(m_videoWidget->winId());
+    m_windowWidth = static_cast<int>(m_videoWidget->width() * dpr);
+    m_windowHeight = static_cast<int>(m_videoWidget->height() * dpr);
+}
+
 void GStreamerPlayer::updateRenderRectangle()
 {
 #ifdef HAVE_GSTREAMER
+    cacheWindowGeometry();
     if (!m_pipeline || !m_videoWidget) return;
 
     // Get the video sink from playbin
@@ -517,11 +709,17 @@ void GStreamerPlayer::play()
 #ifdef HAVE_GSTREAMER
     QMutexLocker locker(&m_mutex);
 
+    stopReverse();
     if (m_playbackState.load() == PlaybackState::Playing) {
         return;
     }
 
     if (m_pipeline) {
+        if (m_showingMemoryFrame) {
+            // The sink still sits where stepping started; continue from the frame on screen
+            sendSeek(m_position.load(), SeekMode::Accurate);
+            clearMemoryFrame();
+        }
         GstStateChangeReturn ret = gst_element_set_state(m_pipeline, GST_STATE_PLAYING);
         if (ret == GST_STATE_CHANGE_FAILURE) {
             emit error("Failed to start playback");
@@ -529,6 +727,7 @@ void GStreamerPlayer::play()
         }
 
         m_playbackState = PlaybackState::Playing;
+        m_anchorValid = false; // set again once the pipeline reports PLAYING
         emit playbackStateChanged(PlaybackState::Playing);
         m_positionTimer->start();
 
@@ -542,11 +741,16 @@ void GStreamerPlayer::pause()
 #ifdef HAVE_GSTREAMER
     QMutexLocker locker(&m_mutex);
 
+    if (m_reversePlaying) {
+        stopReverse();
+        m_resyncTimer->start();
+    }
     if (m_playbackState.load() == PlaybackState::Stopped) {
         return;
     }
 
     if (m_pipeline) {
+        const bool wasPlaying = m_playbackState.load() == PlaybackState::Playing;
         GstStateChangeReturn ret = gst_element_set_state(m_pipeline, GST_STATE_PAUSED);
         if (ret == GST_STATE_CHANGE_FAILURE) {
             emit error("Failed to pause playback");
@@ -554,9 +758,13 @@ void GStreamerPlayer::pause()
         }
 
         m_playbackState = PlaybackState::Paused;
+        m_anchorValid = false;
         emit playbackStateChanged(PlaybackState::Paused);
         m_positionTimer->stop();
 
+        // Decode the GOP behind the pause point so the first step back is instant
+        if (wasPlaying && queryPosition()) fillFrameRing(m_position.load());
+
         qDebug() << "[GStreamerPlayer] Playback paused";
     }
 #endif
@@ -567,9 +775,15 @@ void GStreamerPlayer::stop()
 #ifdef HAVE_GSTREAMER
     QMutexLocker locker(&m_mutex);
 
+    stopReverse();
+    clearMemoryFrame();
+    resetFrameRing();
+
     if (m_pipeline) {
         gst_element_set_state(m_pipeline, GST_STATE_NULL);
+        ++m_busGeneration; // an EOS or error still queued must not outlive the stop
         m_playbackState = PlaybackState::Stopped;
+        m_anchorValid = false;
         emit playbackStateChanged(PlaybackState::Stopped);
         m_positionTimer->stop();
         m_position = 0;
@@ -580,32 +794,120 @@ void GStreamerPlayer::stop()
 #endif
 }
 
-void GStreamerPlayer::seek(qint64 positionMs)
+void GStreamerPlayer::seek(qint64 positionMs, SeekMode mode)
 {
 #ifdef HAVE_GSTREAMER
     if (!m_pipeline) return;
+    stopReverse();
+    clearMemoryFrame();
+
+    if (mode == SeekMode::Accurate) {
+        // The final position wins over anything still queued from a drag
+        m_queuedSeekMs = -1;
+        m_lastKeyframeSeekMs = -1;
+        sendSeek(positionMs, SeekMode::Accurate);
+        return;
+    }
+
+    const qint64 target = m_keyframes.nearest(positionMs);
+    if (target == m_lastKeyframeSeekMs) {
+        m_queuedSeekMs = -1; // back on the keyframe already shown (or on its way)
+        return;
+    }
 
+    constexpr qint64 kSeekTimeoutMs = 500;
+    if (m_seekInFlight && m_seekTimer.elapsed() < kSeekTimeoutMs) {
+        m_queuedSeekMs = target;
+        return;
+    }
+    m_queuedSeekMs = -1;
+    sendSeek(target, SeekMode::Keyframe);
+#else
+    Q_UNUSED(positionMs);
+    Q_UNUSED(mode);
+#endif
+}
+
+bool GStreamerPlayer::sendSeek(qint64 positionMs, SeekMode mode)
+{
+#ifdef HAVE_GSTREAMER
+    if (!m_pipeline) return false;
     gint64 position = positionMs * GST_MSECOND;
 
-    // Use accurate seeking for smooth scrubbing
-    if (gst_element_seek_simple(m_pipeline, GST_FORMAT_TIME,
-                               static_cast<GstSeekFlags>(GST_SEEK_FLAG_FLUSH | GST_SEEK_FLAG_ACCURATE),
-                               position)) {
+    // Keyframe seeks only decode one GOP head and are cheap enough to keep up with a drag.
+    // Intra-only media can stop on any frame, so accurate costs nothing extra there.
+    GstSeekFlags flags = GST_SEEK_FLAG_FLUSH;
+    if (mode == SeekMode::Keyframe && !m_keyframes.allIntra) {
+        flags = static_cast<GstSeekFlags>(flags | GST_SEEK_FLAG_KEY_UNIT | GST_SEEK_FLAG_SNAP_NEAREST);
+    } else {
+        flags = static_cast<GstSeekFlags>(flags | GST_SEEK_FLAG_ACCURATE);
+    }
+
+    if (gst_element_seek_simple(m_pipeline, GST_FORMAT_TIME, flags, position)) {
+        m_seekInFlight = true;
+        m_anchorValid = false;
+        m_seekMode = mode;
+        m_seekTimer.start();
+        if (mode == SeekMode::Keyframe) m_lastKeyframeSeekMs = positionMs;
         m_position = positionMs;
         emit positionChanged(positionMs);
-        qDebug() << "[GStreamerPlayer] Seeked to:" << positionMs << "ms";
-    } else {
-        qWarning() << "[GStreamerPlayer] Seek failed to:" << positionMs << "ms";
+        qDebug() << "[GStreamerPlayer] Seeked to:" << positionMs << "ms"
+                 << (mode == SeekMode::Keyframe ? "(keyframe)" : "(accurate)");
+        return true;
     }
+    qWarning() << "[GStreamerPlayer] Seek failed to:" << positionMs << "ms";
 #else
     Q_UNUSED(positionMs);
+    Q_UNUSED(mode);
 #endif
+    return false;
+}
+
+void GStreamerPlayer::buildKeyframeIndex(const QString& filePath)
+{
+    m_keyframes = KeyframeIndex();
+    const quint64 generation = ++m_mediaGeneration;
+
+    // Reads packet headers of the whole file on first use; cached afterwards
+    auto* watcher = new QFutureWatcher<KeyframeIndex>(this);
+    connect(watcher, &QFutureWatcher<KeyframeIndex>::finished, this, [this, watcher, generation]() {
+        watcher->deleteLater();
+        if (generation != m_mediaGeneration) return; // another file was loaded meanwhile
+        m_keyframes = watcher->result();
+        if (!m_keyframes.valid) return;
+        qDebug() << "[GStreamerPlayer] Keyframe index ready:"
+                 << (m_keyframes.allIntra ? QStringLiteral("intra-only") : QString::number(m_keyframes.keyframesMs.size()));
+        emit keyframeIndexReady(m_keyframes.keyframesMs.size());
+    });
+    watcher->setFuture(QtConcurrent::run([filePath]() {
+        KeyframeIndex index;
+        QString error;
+        if (!MediaProbeCache::instance().keyframeIndex(filePath, index, &error)) {
+            qDebug() << "[GStreamerPlayer] No keyframe index for" << filePath << ":" << error;
+        }
+        return index;
+    }));
 }
 
 void GStreamerPlayer::stepForward()
 {
 #ifdef HAVE_GSTREAMER
     if (!m_pipeline) return;
+    stopReverse();
+
+    if (m_showingMemoryFrame && m_mediaInfo.fps > 0) {
+        // Stepping back through the ring left the sink behind; stay in memory while we can
+        const qint64 frameDuration = frameDurationMs();
+        qint64 frameMs = 0;
+        QImage frame;
+        if (m_frameRing.frameAfter(m_position.load(), frameDuration / 2, frameMs, frame)
+            && frameMs - m_position.load() <= frameDuration * 3 / 2) {
+            showMemoryFrame(frameMs, frame);
+        } else {
+            seek(m_position.load() + frameDuration);
+        }
+        return;
+    }
 
     // Use GStreamer's step event for frame-accurate stepping
     // This is THE professional way to do frame stepping
@@ -628,17 +930,176 @@ void GStreamerPlayer::stepBackward()
 {
 #ifdef HAVE_GSTREAMER
     if (!m_pipeline || m_mediaInfo.fps <= 0) return;
+    stopReverse();
+    if (stepBackwardFromRing()) return;
 
-    // GStreamer doesn't have native backward stepping, so we seek backward by one frame
-    qint64 frameDuration = static_cast<qint64>(1000.0 / m_mediaInfo.fps);
+    // Not decoded yet: seek back one frame (re-decodes from the previous keyframe)
+    // and fill the ring so the following steps come from memory
+    qint64 frameDuration = frameDurationMs();
     qint64 currentPos = m_position.load();
     qint64 newPos = (currentPos > frameDuration) ? (currentPos - frameDuration) : 0;
     seek(newPos);
+    fillFrameRing(newPos);
 
     qDebug() << "[GStreamerPlayer] Step backward to:" << newPos;
 #endif
 }
 
+void GStreamerPlayer::playReverse()
+{
+#ifdef HAVE_GSTREAMER
+    if (!m_pipeline || m_mediaInfo.fps <= 0) return;
+    if (m_playbackState.load() == PlaybackState::Playing) pause();
+    m_resyncTimer->stop();
+    m_reversePlaying = true;
+    m_reverseTimer->setInterval(qMax(1, int(frameDurationMs())));
+    m_reverseTimer->start();
+    fillFrameRing(m_position.load());
+    qDebug() << "[GStreamerPlayer] Reverse playback from" << m_position.load() << "ms";
+#endif
+}
+
+void GStreamerPlayer::stopReverse()
+{
+    if (!m_reversePlaying) return;
+    m_reversePlaying = false;
+    if (m_reverseTimer) m_reverseTimer->stop();
+}
+
+void GStreamerPlayer::onReverseTick()
+{
+    if (!m_reversePlaying) return;
+    if (m_position.load() <= 0) {
+        stopReverse();
+        if (m_resyncTimer) m_resyncTimer->start();
+        emit playbackStateChanged(m_playbackState.load()); // reached the first frame
+        return;
+    }
+    // A miss means the decoder is behind; hold this frame until the fill lands
+    if (!stepBackwardFromRing() && !m_ringFill.isRunning()) fillFrameRing(m_position.load());
+}
+
+void GStreamerPlayer::setFrameRingBudget(qint64 bytes)
+{
+    m_frameRing.setBudgetBytes(bytes);
+}
+
+qint64 GStreamerPlayer::frameDurationMs() const
+{
+    return m_mediaInfo.fps > 0 ? qMax<qint64>(1, qint64(1000.0 / m_mediaInfo.fps)) : 40;
+}
+
+bool GStreamerPlayer::stepBackwardFromRing()
+{
+    const qint64 frameDuration = frameDurationMs();
+    const qint64 current = m_position.load();
+    qint64 frameMs = 0;
+    QImage frame;
+    // Only the frame right before the playhead will do; an older GOP is not a step back
+    if (!m_frameRing.frameBefore(current, frameDuration / 2, frameMs, frame)
+        || current - frameMs > frameDuration * 3 / 2) {
+        return false;
+    }
+    showMemoryFrame(frameMs, frame);
+
+    // Start on the previous GOP before the ring runs dry
+    const qint64 earliest = m_frameRing.earliestMs();
+    const qint64 margin = qMax<qint64>(4 * frameDuration, 500);
+    if (earliest > 0 && frameMs - earliest <= margin) fillFrameRing(earliest);
+    return true;
+}
+
+void GStreamerPlayer::showMemoryFrame(qint64 positionMs, const QImage& frame)
+{
+    m_showingMemoryFrame = true;
+    m_position = positionMs;
+    emit memoryFrameReady(frame, positionMs);
+    emit positionChanged(positionMs);
+    // Once stepping stops, bring the sink to this frame at full quality
+    if (!m_reversePlaying && m_resyncTimer) m_resyncTimer->start();
+}
+
+void GStreamerPlayer::clearMemoryFrame()
+{
+    if (m_resyncTimer) m_resyncTimer->stop();
+    m_resyncSeekPending = false;
+    if (!m_showingMemoryFrame) return;
+    m_showingMemoryFrame = false;
+    emit memoryFrameCleared();
+}
+
+void GStreamerPlayer::onResyncTimeout()
+{
+    if (!m_showingMemoryFrame || m_reversePlaying || !m_pipeline) return;
+    // memoryFrameCleared() follows on ASYNC_DONE, when the sink shows the same frame
+    if (sendSeek(m_position.load(), SeekMode::Accurate)) m_resyncSeekPending = true;
+    else clearMemoryFrame();
+}
+
+void GStreamerPlayer::resetFrameRing()
+{
+    ++m_ringGeneration; // cancels a running fill
+    m_ringPendingFillMs = -1;
+    m_frameRing.clear();
+}
+
+void GStreamerPlayer::fillFrameRing(qint64 untilMs)
+{
+#ifdef HAVE_GSTREAMER
+    if (m_currentPath.isEmpty() || m_mediaInfo.width <= 0 || m_mediaInfo.height <= 0 || untilMs <= 0) return;
+    if (m_ringFill.isRunning()) {
+        m_ringPendingFillMs = untilMs;
+        return;
+    }
+    m_ringPendingFillMs = -1;
+
+    const qint64 frameDuration = frameDurationMs();
+    qint64 startMs = m_keyframes.atOrBefore(untilMs - 1);
+    const qint64 gopMs = startMs >= 0 ? untilMs - startMs : 2000;
+
+    // Size frames so that at least one GOP fits the budget, and never above the display
+    const int gopFrames = int(qMin<qint64>(gopMs / frameDuration + 1, 1000));
+    QSize display;
+    if (m_videoWidget) display = m_videoWidget->size() * m_videoWidget->devicePixelRatioF();
+    const QSize size = VideoFrameRing::frameSize(QSize(m_mediaInfo.width, m_mediaInfo.height), display,
+                                                 m_frameRing.budgetBytes(), qMax(24, gopFrames));
+    const int capacity = m_frameRing.capacity(size);
+    if (size.isEmpty() || capacity <= 0) return;
+    // Intra-only or not indexed yet: any window works, the decoder snaps to a keyframe before it
+    if (startMs < 0) startMs = qMax<qint64>(0, untilMs - qMin<qint64>(capacity, gopFrames) * frameDuration);
+
+    // Nothing to do when this span is already in memory
+    if (m_frameRing.contains(untilMs - frameDuration, frameDuration / 2) && m_frameRing.earliestMs() >= 0
+        && m_frameRing.earliestMs() <= startMs + frameDuration / 2) {
+        return;
+    }
+
+    if (!m_gopDecoder) m_gopDecoder = std::make_unique<GopDecoder>();
+    const quint64 generation = m_ringGeneration.load();
+    const QString uri = QUrl::fromLocalFile(m_currentPath).toString();
+    GopDecoder* decoder = m_gopDecoder.get();
+    const std::atomic<quint64>* latest = &m_ringGeneration;
+
+    auto* watcher = new QFutureWatcher<QVector<DecodedFrame>>(this);
+    connect(watcher, &QFutureWatcher<QVector<DecodedFrame>>::finished, this, [this, watcher, generation]() {
+        watcher->deleteLater();
+        if (generation == m_ringGeneration.load()) {
+            const QVector<DecodedFrame> frames = watcher->result();
+            for (const DecodedFrame& f : frames) m_frameRing.insert(f.timeMs, f.image, m_position.load());
+            qDebug() << "[GStreamerPlayer] Frame ring:" << frames.size() << "frames decoded," << m_frameRing.count()
+                     << "held," << m_frameRing.bytes() / (1024 * 1024) << "MB";
+        }
+        if (m_ringPendingFillMs >= 0) fillFrameRing(m_ringPendingFillMs);
+    });
+    m_ringFill = QtConcurrent::run([=]() {
+        return decoder->decode(uri, size, startMs, untilMs, capacity, *latest, generation);
+    });
+    watcher->setFuture(m_ringFill);
+#else
+    Q_UNUSED(untilMs);
+#endif
+}
+
 void GStreamerPlayer::setVolume(double volume)
 {
 #ifdef HAVE_GSTREAMER
@@ -701,107 +1162,150 @@ GStreamerPlayer::MediaInfo GStreamerPlayer::mediaInfo() const
     return m_mediaInfo;
 }
 
-void GStreamerPlayer::onBusMessage()
+void GStreamerPlayer::handleBusMessage(GstMessage* msg, quint64 generation)
 {
 #ifdef HAVE_GSTREAMER
-    if (!m_bus) return;
-
-    GstMessage* msg;
-    while ((msg = gst_bus_pop(m_bus)) != nullptr) {
-        switch (GST_MESSAGE_TYPE(msg)) {
-            case GST_MESSAGE_ERROR: {
-                GError* err;
-                gchar* debug_info;
-                gst_message_parse_error(msg, &err, &debug_info);
-                QString errorMsg = QString("GStreamer error: %1").arg(err->message);
-                qWarning() << "[GStreamerPlayer]" << errorMsg;
-                if (debug_info) {
-                    qDebug() << "[GStreamerPlayer] Debug info:" << debug_info;
-                }
-                g_clear_error(&err);
-                g_free(debug_info);
-                emit error(errorMsg);
-                break;
+    // Queued from a pipeline that has been torn down, or before the current file/run
+    if (!m_pipeline || generation != m_busGeneration.load()) return;
+
+    switch (GST_MESSAGE_TYPE(msg)) {
+        case GST_MESSAGE_ERROR: {
+            GError* err;
+            gchar* debug_info;
+            gst_message_parse_error(msg, &err, &debug_info);
+            QString errorMsg = QString("GStreamer error: %1").arg(err->message);
+            qWarning() << "[GStreamerPlayer]" << errorMsg;
+            if (debug_info) {
+                qDebug() << "[GStreamerPlayer] Debug info:" << debug_info;
             }
-            case GST_MESSAGE_EOS:
-                qInfo() << "[GStreamerPlayer] End of stream";
-                m_playbackState = PlaybackState::Paused;
-                emit playbackStateChanged(PlaybackState::Paused);
-                emit endOfStream();
-                break;
-            case GST_MESSAGE_STATE_CHANGED: {
-                if (GST_MESSAGE_SRC(msg) == GST_OBJECT(m_pipeline)) {
-                    GstState oldState, newState, pending;
-                    gst_message_parse_state_changed(msg, &oldState, &newState, &pending);
-                    qDebug() << "[GStreamerPlayer] State changed from"
-                             << gst_element_state_get_name(oldState)
-                             << "to" << gst_element_state_get_name(newState);
-                }
-                break;
-            }
-            case GST_MESSAGE_ASYNC_DONE:
-                qDebug() << "[GStreamerPlayer] Async operation done (preroll/seek completed)";
-                // Update media info now that preroll is complete
-                updateMediaInfo();
-
-                // CRITICAL: Update render rectangle after preroll completes
-                // This ensures video is properly sized on HiDPI displays
-                updateRenderRectangle();
-                break;
-            case GST_MESSAGE_BUFFERING: {
-                gint percent = 0;
-                gst_message_parse_buffering(msg, &percent);
-                qDebug() << "[GStreamerPlayer] Buffering:" << percent << "%";
-                break;
+            g_clear_error(&err);
+            g_free(debug_info);
+            emit error(errorMsg);
+            break;
+        }
+        case GST_MESSAGE_EOS:
+            qInfo() << "[GStreamerPlayer] End of stream";
+            m_playbackState = PlaybackState::Paused;
+            m_positionTimer->stop();
+            m_anchorValid = false;
+            emit playbackStateChanged(PlaybackState::Paused);
+            emit endOfStream();
+            break;
+        case GST_MESSAGE_STATE_CHANGED: {
+            if (GST_MESSAGE_SRC(msg) == GST_OBJECT(m_pipeline)) {
+                GstState oldState, newState, pending;
+                gst_message_parse_state_changed(msg, &oldState, &newState, &pending);
+                qDebug() << "[GStreamerPlayer] State changed from"
+                         << gst_element_state_get_name(oldState)
+                         << "to" << gst_element_state_get_name(newState);
+                // The clock runs from here; anchor the playhead to it
+                if (newState == GST_STATE_PLAYING) anchorPosition();
             }
-            case GST_MESSAGE_ELEMENT: {
-                // CRITICAL: Handle prepare-window-handle message
-                // This is the PROPER way to set window handle in GStreamer
-                // The video sink sends this message when it's ready to receive a window handle
-                if (gst_is_video_overlay_prepare_window_handle_message(msg)) {
-                    qInfo() << "[GStreamerPlayer] Received prepare-window-handle message";
-
-                    if (m_videoWidget) {
-                        // Get the video sink element from the message
-                        GstElement* sink = GST_ELEMENT(GST_MESSAGE_SRC(msg));
-
-                        // Ensure widget has a valid window handle
-                        WId windowId = m_videoWidget->winId();
-                        if (windowId && GST_IS_VIDEO_OVERLAY(sink)) {
-#ifdef Q_OS_WIN
-                            gst_video_overlay_set_window_handle(GST_VIDEO_OVERLAY(sink), (guintptr)windowId);
-#else
-                            gst_video_overlay_set_window_handle(GST_VIDEO_OVERLAY(sink), windowId);
-#endif
-                            qInfo() << "[GStreamerPlayer] Set window handle via prepare-window-handle:" << windowId
-                                    << "on element:" << GST_ELEMENT_NAME(sink);
-
-                            // Set render rectangle
-                            gst_video_overlay_set_render_rectangle(GST_VIDEO_OVERLAY(sink),
-                                                                    0, 0,
-                                                                    m_videoWidget->width(),
-                                                                    m_videoWidget->height());
-                        } else {
-                            qWarning() << "[GStreamerPlayer] Invalid window handle or sink doesn't support overlay";
-                        }
+            break;
+        }
+        case GST_MESSAGE_ASYNC_DONE:
+            qDebug() << "[GStreamerPlayer] Async operation done (preroll/seek completed)";
+            if (m_seekInFlight) {
+                m_seekInFlight = false;
+                qDebug() << "[GStreamerPlayer] Seek settled in" << m_seekTimer.elapsed() << "ms";
+                if (m_queuedSeekMs >= 0) {
+                    // The drag moved on while this seek ran; go straight to the latest target
+                    const qint64 next = m_queuedSeekMs;
+                    m_queuedSeekMs = -1;
+                    sendSeek(next, SeekMode::Keyframe);
+                } else if (m_resyncSeekPending) {
+                    // The sink caught up with the frame served from the ring
+                    m_resyncSeekPending = false;
+                    if (!m_resyncTimer->isActive() && !m_reversePlaying) clearMemoryFrame();
+                } else {
+                    // Show the timestamp of the frame that was actually reached
+                    queryPosition();
+                    // Parked on an exact frame: get the GOP behind it ready for stepping back
+                    if (m_seekMode == SeekMode::Accurate && m_playbackState.load() != PlaybackState::Playing) {
+                        fillFrameRing(m_position.load());
                     }
                 }
-                break;
             }
-            default:
-                break;
+            // A seek while playing restarts the running time
+            if (m_playbackState.load() == PlaybackState::Playing) anchorPosition();
+
+            // Update media info now that preroll is complete
+            updateMediaInfo();
+
+            // CRITICAL: Update render rectangle after preroll completes
+            // This ensures video is properly sized on HiDPI displays
+            updateRenderRectangle();
+            break;
+        case GST_MESSAGE_STEP_DONE:
+            // Frame steps move the paused pipeline; keep the playhead on the new frame
+            queryPosition();
+            break;
+        case GST_MESSAGE_BUFFERING: {
+            gint percent = 0;
+            gst_message_parse_buffering(msg, &percent);
+            qDebug() << "[GStreamerPlayer] Buffering:" << percent << "%";
+            // The clock does not advance the stream while buffering
+            if (percent < 100) m_anchorValid = false;
+            else if (m_playbackState.load() == PlaybackState::Playing) anchorPosition();
+            break;
         }
-        gst_message_unref(msg);
+        default:
+            break;
     }
+#else
+    Q_UNUSED(msg);
+    Q_UNUSED(generation);
 #endif
 }
 
 void GStreamerPlayer::onPositionUpdate()
 {
 #ifdef HAVE_GSTREAMER
-    if (m_pipeline && m_playbackState.load() == PlaybackState::Playing) {
+    if (!m_pipeline || m_playbackState.load() != PlaybackState::Playing) return;
+    // Hold the playhead while a seek is landing; ASYNC_DONE re-anchors it
+    if (m_seekInFlight) return;
+    if (!m_anchorValid && !anchorPosition()) {
+        queryPosition();
+        return;
+    }
+
+    GstClock* clock = gst_pipeline_get_clock(GST_PIPELINE(m_pipeline));
+    if (!clock) {
         queryPosition();
+        return;
+    }
+    const GstClockTime now = gst_clock_get_time(clock);
+    gst_object_unref(clock);
+    qint64 positionMs = m_anchorPositionMs;
+    if (now != GST_CLOCK_TIME_NONE && now > m_anchorClockNs) {
+        positionMs += qint64((now - m_anchorClockNs) / GST_MSECOND);
     }
+    const qint64 durationMs = m_duration.load();
+    if (durationMs > 0) positionMs = qMin(positionMs, durationMs);
+    m_position = positionMs;
+    emit positionChanged(positionMs);
+#endif
+}
+
+bool GStreamerPlayer::anchorPosition()
+{
+#ifdef HAVE_GSTREAMER
+    m_anchorValid = false;
+    if (!m_pipeline) return false;
+    GstClock* clock = gst_pipeline_get_clock(GST_PIPELINE(m_pipeline));
+    if (!clock) return false;
+    gint64 pos = 0;
+    const bool havePosition = gst_element_query_position(m_pipeline, GST_FORMAT_TIME, &pos);
+    const GstClockTime now = gst_clock_get_time(clock);
+    gst_object_unref(clock);
+    if (!havePosition || now == GST_CLOCK_TIME_NONE) return false;
+    m_anchorPositionMs = pos / GST_MSECOND;
+    m_anchorClockNs = now;
+    m_anchorValid = true;
+    m_position = m_anchorPositionMs;
+    return true;
+#else
+    return false;
 #endif
 }
 
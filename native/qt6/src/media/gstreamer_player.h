@@ -7,12 +7,19 @@
 #include <QString>
 #include <QMutex>
 #include <QTimer>
+#include <QElapsedTimer>
+#include <QFuture>
 #include <QSize>
+#include <QVector>
 #include <atomic>
+#include <memory>
+#include "../media_probe_cache.h"
+#include "video_frame_ring.h"
 
 // Forward declarations for GStreamer types
 typedef struct _GstElement GstElement;
 typedef struct _GstBus GstBus;
+typedef struct _GstMessage GstMessage;
 
 /**
  * @brief Professional GStreamer-based video player for Qt applications
@@ -53,6 +60,11 @@ public:
         Paused
     };
 
+    enum class SeekMode {
+        Accurate, // decode up to the exact position (slider release, frame stepping)
+        Keyframe  // snap to the nearest keyframe, coalescing bursts (slider drag)
+    };
+
     struct MediaInfo {
         int width = 0;
         int height = 0;
@@ -81,12 +93,20 @@ public:
     void play();
     void pause();
     void stop();
-    void seek(qint64 positionMs);
+    void seek(qint64 positionMs, SeekMode mode = SeekMode::Accurate);
 
-    // Frame stepping (uses GStreamer's step events)
+    // Frame stepping (uses GStreamer's step events; backward steps come from the frame ring)
     void stepForward();
     void stepBackward();
 
+    // Reverse shuttle (J): steps backward at the media frame rate from the frame ring.
+    // play(), pause(), stop(), seek() and loadMedia() end it.
+    void playReverse();
+    bool isPlayingReverse() const { return m_reversePlaying; }
+
+    // Memory budget of the decoded frame ring used for backward stepping
+    void setFrameRingBudget(qint64 bytes);
+
     // Audio control
     void setVolume(double volume); // 0.0 to 1.0
     void setMuted(bool muted);
@@ -115,10 +135,16 @@ signals:
     void mediaInfoReady(const MediaInfo& info);
     void error(const QString& errorString);
     void endOfStream();
+    void keyframeIndexReady(int keyframeCount); // 0 for intra-only media
+    // A frame served from the frame ring; the video sink still shows an older frame,
+    // so the view should display this image until memoryFrameCleared()
+    void memoryFrameReady(const QImage& frame, qint64 positionMs);
+    void memoryFrameCleared();
 
 private slots:
-    void onBusMessage();
     void onPositionUpdate();
+    void onReverseTick();
+    void onResyncTimeout();
 
 private:
     void cleanup();
@@ -127,10 +153,26 @@ private:
     bool queryDuration();
     void updateMediaInfo();
     void setWindowHandle();
+    void cacheWindowGeometry();
+    // `generation` is m_busGeneration when the message was posted; stale ones are dropped
+    void handleBusMessage(GstMessage* msg, quint64 generation);
+    bool anchorPosition();
+    void buildKeyframeIndex(const QString& filePath);
+    bool sendSeek(qint64 positionMs, SeekMode mode);
+    qint64 frameDurationMs() const;
+    bool stepBackwardFromRing();
+    void showMemoryFrame(qint64 positionMs, const QImage& frame);
+    void clearMemoryFrame();
+    void stopReverse();
+    void fillFrameRing(qint64 untilMs);
+    void resetFrameRing();
 
     // GStreamer elements
     GstElement* m_pipeline = nullptr;
     GstBus* m_bus = nullptr;
+    // Bumped by loadMedia() and stop(): messages queued before then belong to the old
+    // file or run and must not drive the current one
+    std::atomic<quint64> m_busGeneration{0};
 
     // Video output widget
     QWidget* m_videoWidget = nullptr;
@@ -146,9 +188,52 @@ private:
     MediaInfo m_mediaInfo;
     QString m_currentUri;
 
-    // Timers
+    // Scrubbing: keyframe index of the current file (built in the background) and
+    // the seek pipeline. While a keyframe seek is in flight only the latest target
+    // is kept; it is sent when ASYNC_DONE reports the previous one finished.
+    KeyframeIndex m_keyframes;
+    quint64 m_mediaGeneration = 0;
+    bool m_seekInFlight = false;
+    QElapsedTimer m_seekTimer; // guards against a seek whose ASYNC_DONE never arrives
+    qint64 m_queuedSeekMs = -1;
+    qint64 m_lastKeyframeSeekMs = -1;
+    SeekMode m_seekMode = SeekMode::Accurate;
+
+    // Backward stepping: frames of the GOPs behind the playhead, decoded forward by a
+    // second headless pipeline on a worker thread. One fill runs at a time; a newer
+    // request waits in m_ringPendingFillMs, and bumping the generation cancels.
+    class GopDecoder;
+    struct DecodedFrame {
+        qint64 timeMs = 0;
+        QImage image;
+    };
+    std::unique_ptr<GopDecoder> m_gopDecoder;
+    VideoFrameRing m_frameRing;
+    QFuture<QVector<DecodedFrame>> m_ringFill;
+    std::atomic<quint64> m_ringGeneration{0};
+    qint64 m_ringPendingFillMs = -1;
+    QString m_currentPath;
+    bool m_showingMemoryFrame = false;
+    bool m_resyncSeekPending = false;
+    bool m_reversePlaying = false;
+    QTimer* m_reverseTimer = nullptr;
+    QTimer* m_resyncTimer = nullptr; // moves the pipeline to the ring frame once stepping pauses
+
+    // Bus messages arrive through a sync handler on GStreamer's streaming threads and
+    // are queued to the GUI thread as they happen; nothing polls the bus. The sink's
+    // prepare-window-handle request is answered on the streaming thread itself, from
+    // the window id and size cached here on the GUI thread.
+    std::atomic<quintptr> m_windowId{0};
+    std::atomic<int> m_windowWidth{0};
+    std::atomic<int> m_windowHeight{0};
+
+    // Position while playing is extrapolated from the pipeline clock, anchored to a
+    // real position query whenever playback (re)starts or a seek lands. The timer
+    // only repaints the playhead and runs only while playing.
     QTimer* m_positionTimer = nullptr;
-    QTimer* m_busTimer = nullptr;
+    bool m_anchorValid = false;
+    qint64 m_anchorPositionMs = 0;
+    quint64 m_anchorClockNs = 0;
 
     // Initialization flag
     static bool s_gstInitialized;
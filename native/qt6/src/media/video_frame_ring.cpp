@@ -0,0 +1,95 @@
+#include "video_frame_ring.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <iterator>
+
+void VideoFrameRing::setBudgetBytes(qint64 bytes)
+{
+    m_budget = qMax<qint64>(0, bytes);
+    // Shrink from the ends; without a playhead the oldest frames go first
+    while (m_bytes > m_budget && !m_frames.isEmpty()) {
+        m_bytes -= m_frames.first().sizeInBytes();
+        m_frames.erase(m_frames.begin());
+    }
+}
+
+bool VideoFrameRing::insert(qint64 timeMs, const QImage& frame, qint64 playheadMs)
+{
+    const qint64 cost = frame.sizeInBytes();
+    if (frame.isNull() || cost > m_budget) return false;
+
+    auto existing = m_frames.find(timeMs);
+    if (existing != m_frames.end()) {
+        m_bytes -= existing->sizeInBytes();
+        m_frames.erase(existing);
+    }
+    while (m_bytes + cost > m_budget && !m_frames.isEmpty()) {
+        // Evict whichever end lies farther from the playhead
+        auto first = m_frames.begin();
+        auto last = std::prev(m_frames.end());
+        auto victim = std::llabs(first.key() - playheadMs) >= std::llabs(last.key() - playheadMs) ? first : last;
+        if (std::llabs(victim.key() - playheadMs) < std::llabs(timeMs - playheadMs)) {
+            return false; // everything kept is closer to the playhead than the new frame
+        }
+        m_bytes -= victim->sizeInBytes();
+        m_frames.erase(victim);
+    }
+    m_frames.insert(timeMs, frame);
+    m_bytes += cost;
+    return true;
+}
+
+bool VideoFrameRing::frameBefore(qint64 timeMs, qint64 toleranceMs, qint64& frameMs, QImage& frame) const
+{
+    auto it = m_frames.lowerBound(timeMs - toleranceMs);
+    if (it == m_frames.constBegin()) return false;
+    --it;
+    frameMs = it.key();
+    frame = it.value();
+    return true;
+}
+
+bool VideoFrameRing::frameAfter(qint64 timeMs, qint64 toleranceMs, qint64& frameMs, QImage& frame) const
+{
+    auto it = m_frames.upperBound(timeMs + toleranceMs);
+    if (it == m_frames.constEnd()) return false;
+    frameMs = it.key();
+    frame = it.value();
+    return true;
+}
+
+bool VideoFrameRing::contains(qint64 timeMs, qint64 toleranceMs) const
+{
+    auto it = m_frames.lowerBound(timeMs - toleranceMs);
+    return it != m_frames.constEnd() && it.key() <= timeMs + toleranceMs;
+}
+
+void VideoFrameRing::clear()
+{
+    m_frames.clear();
+    m_bytes = 0;
+}
+
+int VideoFrameRing::capacity(const QSize& frameSize) const
+{
+    const qint64 cost = qint64(frameSize.width()) * frameSize.height() * 4;
+    return cost > 0 ? int(qMin<qint64>(m_budget / cost, 1 << 20)) : 0;
+}
+
+QSize VideoFrameRing::frameSize(const QSize& source, const QSize& display, qint64 budgetBytes, int minFrames)
+{
+    if (source.isEmpty()) return QSize();
+    QSize size = source;
+    if (!display.isEmpty() && (size.width() > display.width() || size.height() > display.height())) {
+        size = source.scaled(display, Qt::KeepAspectRatio);
+    }
+    const qint64 perFrame = budgetBytes / qMax(1, minFrames);
+    const qint64 cost = qint64(size.width()) * size.height() * 4;
+    if (cost > perFrame && perFrame > 0) {
+        const double scale = std::sqrt(double(perFrame) / double(cost));
+        size = QSize(int(size.width() * scale), int(size.height() * scale));
+    }
+    // Even dimensions keep chroma-subsampled scalers happy
+    return QSize(qMax(2, size.width() & ~1), qMax(2, size.height() & ~1));
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <QImage>
+#include <QMap>
+#include <QSize>
+
+/**
+ * VideoFrameRing - decoded frames around the video playhead, bounded by memory
+ *
+ * Long-GOP media can only be decoded forward from a keyframe, so stepping back
+ * one frame through the pipeline re-decodes the whole GOP every time. The ring
+ * keeps frames that were decoded forward in the background, keyed by their
+ * presentation time, so backward steps and reverse shuttle are served from
+ * memory. When the budget is exceeded the frames farthest from the playhead are
+ * dropped first. Not thread-safe; owned and used by the GUI thread.
+ */
+class VideoFrameRing {
+public:
+    void setBudgetBytes(qint64 bytes);
+    qint64 budgetBytes() const { return m_budget; }
+
+    // Stores a frame; returns false when it is not kept (larger than the budget, or
+    // farther from the playhead than everything already held)
+    bool insert(qint64 timeMs, const QImage& frame, qint64 playheadMs);
+    // Latest frame strictly before timeMs - toleranceMs
+    bool frameBefore(qint64 timeMs, qint64 toleranceMs, qint64& frameMs, QImage& frame) const;
+    // Earliest frame strictly after timeMs + toleranceMs
+    bool frameAfter(qint64 timeMs, qint64 toleranceMs, qint64& frameMs, QImage& frame) const;
+    bool contains(qint64 timeMs, qint64 toleranceMs) const;
+
+    void clear();
+    int count() const { return m_frames.size(); }
+    qint64 bytes() const { return m_bytes; }
+    qint64 earliestMs() const { return m_frames.isEmpty() ? -1 : m_frames.firstKey(); }
+    qint64 latestMs() const { return m_frames.isEmpty() ? -1 : m_frames.lastKey(); }
+
+    // Frames of this size that fit the budget
+    int capacity(const QSize& frameSize) const;
+
+    // Decode size for the ring: the source fitted into the display (never upscaled),
+    // shrunk further until at least minFrames fit the budget
+    static QSize frameSize(const QSize& source, const QSize& display, qint64 budgetBytes, int minFrames);
+
+private:
+    QMap<qint64, QImage> m_frames;
+    qint64 m_bytes = 0;
+    qint64 m_budget = 512LL * 1024 * 1024;
+};
@@ -0,0 +1,271 @@
+#include "waveform_cache.h"
+
+#include "gstreamer_player.h"
+#include "media_probe_cache.h"
+
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFileInfo>
+#include <QMetaObject>
+#include <QSettings>
+#include <QStandardPaths>
+#include <QThread>
+#include <QUrl>
+
+#ifdef HAVE_GSTREAMER
+#include <gst/gst.h>
+#include <gst/app/gstappsink.h>
+#endif
+
+namespace {
+// Decoder stalls longer than this (in 250 ms polls) abort the build
+constexpr int kMaxStalledPolls = 40;
+
+int costKb(const WaveformPeaks& peaks)
+{
+    return int(qMax<qint64>(1, peaks.bytes() / 1024));
+}
+}
+
+WaveformCache& WaveformCache::instance()
+{
+    static WaveformCache inst;
+    return inst;
+}
+
+WaveformCache::WaveformCache(QObject* parent)
+    : QObject(parent)
+    , m_cancel(std::make_shared<std::atomic_bool>(false))
+{
+    QSettings s("AugmentCode", "KAssetManager");
+    m_cacheDir = s.value("Waveforms/CacheDir").toString();
+
+    // One build at a time; runBuild() drops the worker below playback and interactive decoding
+    m_pool.setMaxThreadCount(1);
+}
+
+WaveformCache::~WaveformCache()
+{
+    cancelAll();
+    m_pool.waitForDone();
+}
+
+QString WaveformCache::cacheDir() const
+{
+    QMutexLocker lk(&m_mutex);
+    if (!m_cacheDir.isEmpty()) return m_cacheDir;
+    return QDir(QStandardPaths::writableLocation(QStandardPaths::AppDataLocation)).filePath("waveforms");
+}
+
+void WaveformCache::setCacheDir(const QString& dir)
+{
+    QMutexLocker lk(&m_mutex);
+    m_cacheDir = dir;
+    m_memory.clear();
+}
+
+QString WaveformCache::peakPath(const QString& filePath) const
+{
+    const QString key = QFileInfo(filePath).absoluteFilePath();
+    const QByteArray hash = QCryptographicHash::hash(key.toUtf8(), QCryptographicHash::Sha1).toHex().left(16);
+    return QDir(cacheDir()).filePath(QString::fromLatin1(hash) + ".peaks");
+}
+
+std::shared_ptr<const WaveformPeaks> WaveformCache::peaks(const QString& filePath)
+{
+    const QString key = QFileInfo(filePath).absoluteFilePath();
+    {
+        QMutexLocker lk(&m_mutex);
+        if (auto* cached = m_memory.object(key)) {
+            if ((*cached)->matches(key)) return *cached;
+            m_memory.remove(key);
+        }
+    }
+    WaveformPeaks loaded;
+    if (!WaveformPeaks::load(peakPath(key), key, loaded)) return nullptr;
+    auto shared = std::make_shared<const WaveformPeaks>(std::move(loaded));
+    QMutexLocker lk(&m_mutex);
+    m_memory.insert(key, new std::shared_ptr<const WaveformPeaks>(shared), costKb(*shared));
+    return shared;
+}
+
+void WaveformCache::request(const QString& filePath)
+{
+    const QFileInfo fi(filePath);
+    if (!fi.exists()) return;
+    const QString key = fi.absoluteFilePath();
+    if (peaks(key)) return;
+
+    const QString path = peakPath(key);
+    QMutexLocker lk(&m_mutex);
+    if (m_pending.contains(key)) return;
+    if (m_silent.value(key, -1) == fi.lastModified().toMSecsSinceEpoch()) return;
+    m_pending.insert(key);
+    auto cancel = m_cancel;
+    m_pool.start([this, key, path, cancel]() { runBuild(key, path, cancel); });
+}
+
+void WaveformCache::cancelAll()
+{
+    m_pool.clear();
+    QMutexLocker lk(&m_mutex);
+    m_cancel->store(true);
+    m_cancel = std::make_shared<std::atomic_bool>(false);
+    m_pending.clear();
+}
+
+bool WaveformCache::waitForDone(int msecs)
+{
+    return m_pool.waitForDone(msecs);
+}
+
+void WaveformCache::runBuild(const QString& filePath, const QString& peakPath, std::shared_ptr<std::atomic_bool> cancel)
+{
+    QThread::currentThread()->setPriority(QThread::LowestPriority);
+    const qint64 mtime = QFileInfo(filePath).lastModified().toMSecsSinceEpoch();
+    WaveformPeaks built;
+    QString error;
+    bool ok = false;
+    bool silent = false;
+
+    MediaProbeInfo probe;
+    if (cancel->load()) {
+        error = QStringLiteral("Cancelled");
+    } else if (MediaProbeCache::instance().probe(filePath, probe) && probe.audioCodec.isEmpty()) {
+        silent = true;
+        error = QStringLiteral("No audio stream");
+    } else {
+        QElapsedTimer timer;
+        timer.start();
+        ok = buildPeaks(filePath, built, &error, cancel.get());
+        if (ok) {
+            const qint64 elapsed = qMax<qint64>(1, timer.elapsed());
+            qInfo() << "[WaveformCache] Built peaks for" << filePath << "in" << elapsed << "ms ("
+                    << QString::number(double(built.durationMs()) / elapsed, 'f', 1) << "x real time)";
+            QString saveError;
+            if (!built.save(peakPath, &saveError)) qWarning() << "[WaveformCache]" << saveError;
+        }
+    }
+    auto shared = ok ? std::make_shared<const WaveformPeaks>(std::move(built)) : nullptr;
+
+    QMetaObject::invokeMethod(this, [this, filePath, shared, error, silent, mtime, cancel]() {
+        {
+            QMutexLocker lk(&m_mutex);
+            if (cancel->load()) return; // cancelAll() already dropped the request
+            m_pending.remove(filePath);
+            if (shared) m_memory.insert(filePath, new std::shared_ptr<const WaveformPeaks>(shared), costKb(*shared));
+            if (silent) m_silent.insert(filePath, mtime);
+        }
+        if (shared) {
+            emit waveformReady(filePath);
+        } else {
+            if (!silent) qWarning() << "[WaveformCache] Failed to build peaks for" << filePath << ":" << error;
+            emit waveformFailed(filePath, error);
+        }
+    }, Qt::QueuedConnection);
+}
+
+bool WaveformCache::buildPeaks(const QString& filePath, WaveformPeaks& out, QString* errorOut,
+                               const std::atomic_bool* cancel)
+{
+    out = WaveformPeaks();
+    const QFileInfo fi(filePath);
+    if (!fi.exists()) {
+        if (errorOut) *errorOut = QString("File not found: %1").arg(filePath);
+        return false;
+    }
+#ifdef HAVE_GSTREAMER
+    GStreamerPlayer::initialize();
+
+    GstElement* pipeline = gst_element_factory_make("playbin", nullptr);
+    GstElement* sink = gst_element_factory_make("appsink", nullptr);
+    if (!pipeline || !sink) {
+        if (errorOut) *errorOut = QStringLiteral("Failed to create playbin/appsink");
+        if (sink) gst_object_unref(sink);
+        if (pipeline) gst_object_unref(pipeline);
+        return false;
+    }
+    // Unsynchronised: buffers are pulled as fast as the decoder produces them
+    g_object_set(sink, "emit-signals", FALSE, "sync", FALSE, "drop", FALSE, "max-buffers", 16, nullptr);
+    // playsink's converters downmix to mono; the rate is left to the source
+    GstCaps* caps = gst_caps_new_simple("audio/x-raw",
+                                        "format", G_TYPE_STRING, "S16LE",
+                                        "channels", G_TYPE_INT, 1,
+                                        "layout", G_TYPE_STRING, "interleaved",
+                                        nullptr);
+    gst_app_sink_set_caps(GST_APP_SINK(sink), caps);
+    gst_caps_unref(caps);
+    // Audio only (GST_PLAY_FLAG_AUDIO): the video stream is never decoded
+    const QString uri = QUrl::fromLocalFile(fi.absoluteFilePath()).toString();
+    g_object_set(pipeline, "uri", uri.toUtf8().constData(), "audio-sink", sink, "flags", 0x2, nullptr);
+
+    GstBus* bus = gst_element_get_bus(pipeline);
+    std::unique_ptr<WaveformPeakBuilder> builder;
+    QString error;
+    if (gst_element_set_state(pipeline, GST_STATE_PLAYING) == GST_STATE_CHANGE_FAILURE) {
+        error = QStringLiteral("Failed to start audio decode");
+    }
+    int stalled = 0;
+    while (error.isEmpty()) {
+        if (cancel && cancel->load()) {
+            error = QStringLiteral("Cancelled");
+            break;
+        }
+        GstSample* sample = gst_app_sink_try_pull_sample(GST_APP_SINK(sink), 250 * GST_MSECOND);
+        if (!sample) {
+            if (gst_app_sink_is_eos(GST_APP_SINK(sink))) break;
+            if (GstMessage* msg = gst_bus_pop_filtered(bus, GST_MESSAGE_ERROR)) {
+                GError* gerr = nullptr;
+                gst_message_parse_error(msg, &gerr, nullptr);
+                error = gerr ? QString::fromUtf8(gerr->message) : QStringLiteral("Decoder error");
+                if (gerr) g_error_free(gerr);
+                gst_message_unref(msg);
+            } else if (++stalled >= kMaxStalledPolls) {
+                error = QStringLiteral("Audio decode stalled");
+            }
+            continue;
+        }
+        stalled = 0;
+        if (!builder) {
+            int rate = 0;
+            GstCaps* sampleCaps = gst_sample_get_caps(sample);
+            if (sampleCaps) gst_structure_get_int(gst_caps_get_structure(sampleCaps, 0), "rate", &rate);
+            if (rate <= 0) {
+                gst_sample_unref(sample);
+                error = QStringLiteral("Unknown audio sample rate");
+                break;
+            }
+            builder = std::make_unique<WaveformPeakBuilder>(rate);
+        }
+        GstBuffer* buffer = gst_sample_get_buffer(sample);
+        GstMapInfo map;
+        if (buffer && gst_buffer_map(buffer, &map, GST_MAP_READ)) {
+            builder->addSamples(reinterpret_cast<const qint16*>(map.data), qint64(map.size / sizeof(qint16)));
+            gst_buffer_unmap(buffer, &map);
+        }
+        gst_sample_unref(sample);
+    }
+
+    gst_element_set_state(pipeline, GST_STATE_NULL);
+    gst_object_unref(bus);
+    gst_object_unref(pipeline); // owns the sink once it is set as audio-sink
+
+    if (error.isEmpty() && (!builder || builder->sampleCount() == 0)) error = QStringLiteral("No audio decoded");
+    if (!error.isEmpty()) {
+        if (errorOut) *errorOut = error;
+        return false;
+    }
+    out = builder->finish();
+    // Taken before decoding, so a file rewritten meanwhile reads as stale
+    out.sourceSize = fi.size();
+    out.sourceMtimeMs = fi.lastModified().toMSecsSinceEpoch();
+    return true;
+#else
+    Q_UNUSED(cancel);
+    if (errorOut) *errorOut = QStringLiteral("GStreamer support not compiled in");
+    return false;
+#endif
+}
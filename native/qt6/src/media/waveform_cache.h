@@ -0,0 +1,64 @@
+#pragma once
+
+#include <QCache>
+#include <QHash>
+#include <QMutex>
+#include <QObject>
+#include <QSet>
+#include <QThreadPool>
+#include <atomic>
+#include <memory>
+
+#include "waveform_peaks.h"
+
+/**
+ * WaveformCache - background builder and cache for clip waveforms
+ *
+ * Peaks are built once per file by decoding only the audio stream (headless
+ * playbin, no clock sync, so it runs as fast as the decoder allows) on a single
+ * low-priority worker, then written next to the proxies under
+ * AppDataLocation/waveforms. Lookups are served from memory or the peak file and
+ * are invalidated when the source's size or mtime changes.
+ */
+class WaveformCache : public QObject {
+    Q_OBJECT
+public:
+    static WaveformCache& instance();
+
+    // Up-to-date peaks from memory or disk; null when they still need building
+    std::shared_ptr<const WaveformPeaks> peaks(const QString& filePath);
+    // Queues a build unless the peaks are current or already queued; waveformReady follows
+    void request(const QString& filePath);
+    void cancelAll();
+    // Blocks until queued builds are done (tests, shutdown)
+    bool waitForDone(int msecs = -1);
+
+    QString cacheDir() const;
+    void setCacheDir(const QString& dir);
+    QString peakPath(const QString& filePath) const;
+
+    // Decodes the audio of `filePath` into peaks (blocking)
+    static bool buildPeaks(const QString& filePath, WaveformPeaks& out, QString* errorOut = nullptr,
+                           const std::atomic_bool* cancel = nullptr);
+
+signals:
+    void waveformReady(const QString& filePath);
+    void waveformFailed(const QString& filePath, const QString& error);
+
+private:
+    explicit WaveformCache(QObject* parent = nullptr);
+    ~WaveformCache() override;
+    Q_DISABLE_COPY(WaveformCache)
+
+    void runBuild(const QString& filePath, const QString& peakPath, std::shared_ptr<std::atomic_bool> cancel);
+
+    mutable QMutex m_mutex;
+    QString m_cacheDir;
+    // Cost in KB
+    QCache<QString, std::shared_ptr<const WaveformPeaks>> m_memory{64 * 1024};
+    QSet<QString> m_pending;
+    // Files without an audio stream (path -> mtime), so they are not probed again on every request
+    QHash<QString, qint64> m_silent;
+    QThreadPool m_pool;
+    std::shared_ptr<std::atomic_bool> m_cancel;
+};
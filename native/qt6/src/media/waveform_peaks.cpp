@@ -0,0 +1,199 @@
+#include "waveform_peaks.h"
+
+#include <QDataStream>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <cmath>
+
+namespace {
+constexpr quint32 kPeakMagic = 0x4b574650; // "KWFP"
+constexpr quint32 kPeakVersion = 1;
+constexpr qint32 kMaxLevels = 48;
+
+// Halves the resolution of one level
+QVector<qint16> downsample(const QVector<qint16>& level)
+{
+    const int pairs = level.size() / 2;
+    QVector<qint16> out;
+    out.reserve(((pairs + 1) / 2) * 2);
+    for (int i = 0; i < pairs; i += 2) {
+        qint16 mn = level[i * 2];
+        qint16 mx = level[i * 2 + 1];
+        if (i + 1 < pairs) {
+            mn = qMin(mn, level[i * 2 + 2]);
+            mx = qMax(mx, level[i * 2 + 3]);
+        }
+        out.append(mn);
+        out.append(mx);
+    }
+    return out;
+}
+}
+
+qint64 WaveformPeaks::bytes() const
+{
+    qint64 total = 0;
+    for (const auto& level : levels) total += qint64(level.size()) * qint64(sizeof(qint16));
+    return total;
+}
+
+int WaveformPeaks::levelFor(double samplesPerColumn) const
+{
+    int level = 0;
+    while (level + 1 < levels.size() && double(qint64(kBaseSamplesPerPeak) << (level + 1)) <= samplesPerColumn) {
+        ++level;
+    }
+    return level;
+}
+
+QVector<qint16> WaveformPeaks::range(qint64 startMs, qint64 endMs, int columns) const
+{
+    QVector<qint16> out(qMax(0, columns) * 2, 0);
+    if (!isValid() || columns <= 0 || endMs <= startMs) return out;
+
+    const double samplesPerMs = sampleRate / 1000.0;
+    const double samplesPerColumn = double(endMs - startMs) * samplesPerMs / columns;
+    const int level = levelFor(samplesPerColumn);
+    const QVector<qint16>& peaks = levels[level];
+    const qint64 pairs = peaks.size() / 2;
+    const double samplesPerPeak = double(qint64(kBaseSamplesPerPeak) << level);
+
+    // The chosen level has at most ~2 pairs per column, so this is O(columns)
+    for (int c = 0; c < columns; ++c) {
+        const double s0 = startMs * samplesPerMs + c * samplesPerColumn;
+        const double s1 = s0 + samplesPerColumn;
+        if (s0 >= double(sampleCount)) break;
+        if (s1 <= 0.0) continue;
+        qint64 p0 = qMax<qint64>(0, qint64(std::floor(s0 / samplesPerPeak)));
+        qint64 p1 = qMin<qint64>(pairs, qMax<qint64>(p0 + 1, qint64(std::ceil(s1 / samplesPerPeak))));
+        if (p0 >= p1) continue;
+        qint16 mn = peaks[p0 * 2];
+        qint16 mx = peaks[p0 * 2 + 1];
+        for (qint64 p = p0 + 1; p < p1; ++p) {
+            mn = qMin(mn, peaks[p * 2]);
+            mx = qMax(mx, peaks[p * 2 + 1]);
+        }
+        out[c * 2] = mn;
+        out[c * 2 + 1] = mx;
+    }
+    return out;
+}
+
+bool WaveformPeaks::matches(const QString& sourcePath) const
+{
+    const QFileInfo fi(sourcePath);
+    return fi.exists() && fi.size() == sourceSize && fi.lastModified().toMSecsSinceEpoch() == sourceMtimeMs;
+}
+
+bool WaveformPeaks::save(const QString& peakPath, QString* errorOut) const
+{
+    if (!isValid()) {
+        if (errorOut) *errorOut = QStringLiteral("No peaks to save");
+        return false;
+    }
+    QDir().mkpath(QFileInfo(peakPath).absolutePath());
+    QSaveFile f(peakPath);
+    if (!f.open(QIODevice::WriteOnly)) {
+        if (errorOut) *errorOut = QString("Cannot write %1").arg(peakPath);
+        return false;
+    }
+    QDataStream out(&f);
+    out.setVersion(QDataStream::Qt_6_0);
+    out << kPeakMagic << kPeakVersion << sourceSize << sourceMtimeMs << qint32(sampleRate) << sampleCount
+        << qint32(levels.size());
+    for (const auto& level : levels) out << level;
+    if (!f.commit()) {
+        if (errorOut) *errorOut = QString("Failed to save %1").arg(peakPath);
+        return false;
+    }
+    return true;
+}
+
+bool WaveformPeaks::load(const QString& peakPath, const QString& sourcePath, WaveformPeaks& out, QString* errorOut)
+{
+    out = WaveformPeaks();
+    QFile f(peakPath);
+    if (!f.open(QIODevice::ReadOnly)) {
+        if (errorOut) *errorOut = QString("No peak file %1").arg(peakPath);
+        return false;
+    }
+    QDataStream in(&f);
+    in.setVersion(QDataStream::Qt_6_0);
+    quint32 magic = 0, version = 0;
+    qint32 rate = 0, levelCount = 0;
+    WaveformPeaks peaks;
+    in >> magic >> version >> peaks.sourceSize >> peaks.sourceMtimeMs >> rate >> peaks.sampleCount >> levelCount;
+    if (in.status() != QDataStream::Ok || magic != kPeakMagic || version != kPeakVersion
+        || levelCount <= 0 || levelCount > kMaxLevels) {
+        if (errorOut) *errorOut = QString("Incompatible peak file %1").arg(peakPath);
+        return false;
+    }
+    if (!sourcePath.isEmpty() && !peaks.matches(sourcePath)) {
+        if (errorOut) *errorOut = QString("Peak file is stale for %1").arg(sourcePath);
+        return false;
+    }
+    peaks.sampleRate = rate;
+    peaks.levels.resize(levelCount);
+    for (auto& level : peaks.levels) in >> level;
+    if (in.status() != QDataStream::Ok || !peaks.isValid()) {
+        if (errorOut) *errorOut = QString("Truncated peak file %1").arg(peakPath);
+        return false;
+    }
+    out = std::move(peaks);
+    return true;
+}
+
+WaveformPeakBuilder::WaveformPeakBuilder(int sampleRate)
+    : m_sampleRate(sampleRate)
+{
+}
+
+void WaveformPeakBuilder::push(int value)
+{
+    if (m_pending == 0) {
+        m_min = m_max = value;
+    } else {
+        m_min = qMin(m_min, value);
+        m_max = qMax(m_max, value);
+    }
+    if (++m_pending == WaveformPeaks::kBaseSamplesPerPeak) {
+        m_base.append(qint16(m_min));
+        m_base.append(qint16(m_max));
+        m_pending = 0;
+    }
+}
+
+void WaveformPeakBuilder::addSamples(const float* samples, qint64 count)
+{
+    for (qint64 i = 0; i < count; ++i) {
+        push(qBound(-32768, int(std::lround(samples[i] * 32767.0f)), 32767));
+    }
+    m_samples += qMax<qint64>(0, count);
+}
+
+void WaveformPeakBuilder::addSamples(const qint16* samples, qint64 count)
+{
+    for (qint64 i = 0; i < count; ++i) push(samples[i]);
+    m_samples += qMax<qint64>(0, count);
+}
+
+WaveformPeaks WaveformPeakBuilder::finish()
+{
+    if (m_pending > 0) {
+        m_base.append(qint16(m_min));
+        m_base.append(qint16(m_max));
+        m_pending = 0;
+    }
+    WaveformPeaks peaks;
+    peaks.sampleRate = m_sampleRate;
+    peaks.sampleCount = m_samples;
+    if (m_base.isEmpty()) return peaks;
+    peaks.levels.append(std::move(m_base));
+    while (peaks.levels.last().size() > 2) peaks.levels.append(downsample(peaks.levels.last()));
+    m_base = QVector<qint16>();
+    m_samples = 0;
+    return peaks;
+}
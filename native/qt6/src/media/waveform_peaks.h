@@ -0,0 +1,68 @@
+#pragma once
+
+#include <QString>
+#include <QVector>
+
+/**
+ * WaveformPeaks - multi-resolution min/max peaks of a clip's audio
+ *
+ * Level 0 holds one min/max pair per kBaseSamplesPerPeak mono samples; every
+ * further level halves the resolution of the one below, down to a single pair.
+ * Drawing any zoom reads the coarsest level that still has a peak per pixel
+ * column, so the cost depends on the widget width, never on the clip length.
+ * Peaks are stored as signed 16-bit values (full scale = 32767).
+ */
+struct WaveformPeaks {
+    static constexpr int kBaseSamplesPerPeak = 256;
+
+    // Source file the peaks were built from; a mismatch makes them stale
+    qint64 sourceSize = 0;
+    qint64 sourceMtimeMs = 0;
+    int sampleRate = 0;
+    qint64 sampleCount = 0; // mono samples
+    // levels[k] is interleaved min,max with (kBaseSamplesPerPeak << k) samples per pair
+    QVector<QVector<qint16>> levels;
+
+    bool isValid() const { return sampleRate > 0 && !levels.isEmpty() && !levels.first().isEmpty(); }
+    qint64 durationMs() const { return sampleRate > 0 ? sampleCount * 1000 / sampleRate : 0; }
+    qint64 bytes() const;
+
+    // Interleaved min,max per column for [startMs, endMs); columns past the end are 0,0
+    QVector<qint16> range(qint64 startMs, qint64 endMs, int columns) const;
+    // Level range() reads for this many samples per column
+    int levelFor(double samplesPerColumn) const;
+
+    // Peak files carry the source size/mtime; loading checks them against `sourcePath`
+    bool save(const QString& peakPath, QString* errorOut = nullptr) const;
+    static bool load(const QString& peakPath, const QString& sourcePath, WaveformPeaks& out, QString* errorOut = nullptr);
+    // True when the peaks were built from the file as it is now
+    bool matches(const QString& sourcePath) const;
+};
+
+/**
+ * WaveformPeakBuilder - accumulates decoded mono samples into WaveformPeaks
+ *
+ * Samples arrive in decode order, in chunks of any size; only the current
+ * base-level pair is kept besides the output, so memory stays proportional to
+ * the peak data rather than the audio.
+ */
+class WaveformPeakBuilder {
+public:
+    explicit WaveformPeakBuilder(int sampleRate);
+
+    void addSamples(const float* samples, qint64 count);
+    void addSamples(const qint16* samples, qint64 count);
+    qint64 sampleCount() const { return m_samples; }
+    // Flushes the partial pair and derives the coarser levels
+    WaveformPeaks finish();
+
+private:
+    void push(int value);
+
+    int m_sampleRate = 0;
+    qint64 m_samples = 0;
+    QVector<qint16> m_base;
+    int m_min = 0;
+    int m_max = 0;
+    int m_pending = 0;
+};
@@ -8,8 +8,11 @@
 #include <QApplication>
 #include <QStyle>
 #include <QMessageBox>
+#include <QHeaderView>
+#include <QMenu>
 
 #include "sequence_detector.h"
+#include "utils.h"
 
 #include <algorithm>
 
@@ -30,7 +33,7 @@ MediaConvertDialog::MediaConvertDialog(const QStringList& sourcePaths, QWidget*
     m_magick = locateMagick();
     QStringList notices;
     if (m_ffmpeg.isEmpty()) notices << "FFmpeg not found (video/sequence conversions unavailable)";
-    if (m_magick.isEmpty()) notices << "ImageMagick not found (single-image conversions unavailable)";
+    if (m_magick.isEmpty()) notices << "ImageMagick not found (only needed for formats the built-in image converter can't read)";
     if (!notices.isEmpty()) m_status->setText(notices.join(" · "));
 }
 
@@ -95,6 +98,10 @@ void MediaConvertDialog::buildUi()
     m_conflictCombo->addItem("Overwrite", (int)MediaConverterWorker::ConflictAction::Overwrite);
     m_conflictCombo->addItem("Skip", (int)MediaConverterWorker::ConflictAction::Skip);
     confRow->addWidget(new QLabel("If file exists:")); confRow->addWidget(m_conflictCombo);
+    m_segmentedCheck = new QCheckBox("Encode long sequences in parallel chunks", this);
+    m_segmentedCheck->setToolTip("Splits image sequences going to video into GOP-aligned chunks that encode concurrently and are joined without re-encoding");
+    m_segmentedCheck->setChecked(true);
+    confRow->addWidget(m_segmentedCheck);
 
     // Settings stack
     m_settingsStack = new QStackedWidget(this);
@@ -204,7 +211,8 @@ void MediaConvertDialog::buildUi()
         m_targetCombo->addItem("MP4 (H.264/H.265)", (int)MediaConverterWorker::TargetKind::VideoMP4);
         m_targetCombo->addItem("MOV (H.264/ProRes/Animation)", (int)MediaConverterWorker::TargetKind::VideoMOV);
     }
-    if (hasVideo) {
+    // Image sequences are re-encoded frame by frame in process
+    if (hasVideo || hasSequence) {
         m_targetCombo->addItem("JPG Sequence", (int)MediaConverterWorker::TargetKind::JpgSequence);
         m_targetCombo->addItem("PNG Sequence", (int)MediaConverterWorker::TargetKind::PngSequence);
         m_targetCombo->addItem("TIF Sequence", (int)MediaConverterWorker::TargetKind::TifSequence);
@@ -235,26 +243,38 @@ void MediaConvertDialog::buildUi()
     // Progress and log
     m_status = new QLabel("Idle", this);
     m_overallBar = new QProgressBar(this); m_overallBar->setRange(0,100);
-    m_fileBar = new QProgressBar(this); m_fileBar->setRange(0,100);
+    // One row per task: conversions run concurrently, so progress and logs are tracked per task
+    m_taskList = new QTreeWidget(this);
+    m_taskList->setColumnCount(3);
+    m_taskList->setHeaderLabels({"File", "Status", "Progress"});
+    m_taskList->setRootIsDecorated(false);
+    m_taskList->setContextMenuPolicy(Qt::CustomContextMenu);
+    m_taskList->header()->setSectionResizeMode(0, QHeaderView::Stretch);
+    connect(m_taskList, &QTreeWidget::customContextMenuRequested, this, &MediaConvertDialog::onTaskContextMenu);
+    connect(m_taskList, &QTreeWidget::itemDoubleClicked, this, [this](QTreeWidgetItem* item){ showTaskLog(m_taskList->indexOfTopLevelItem(item)); });
     m_log = new QPlainTextEdit(this); m_log->setReadOnly(true);
     v->addWidget(m_status);
     v->addWidget(new QLabel("Overall:")); v->addWidget(m_overallBar);
-    v->addWidget(new QLabel("Current file:")); v->addWidget(m_fileBar);
+    v->addWidget(new QLabel("Tasks (right-click to retry/cancel, double-click for log):")); v->addWidget(m_taskList, 1);
     v->addWidget(new QLabel("Output:")); v->addWidget(m_log, 1);
 
     // Buttons
     QHBoxLayout* btns = new QHBoxLayout();
     m_startBtn = new QPushButton(style()->standardIcon(QStyle::SP_MediaPlay), "Start", this);
     m_cancelBtn = new QPushButton("Cancel", this);
+    m_retryFailedBtn = new QPushButton("Retry Failed", this);
     m_closeBtn = new QPushButton("Close", this);
     m_cancelBtn->setEnabled(false);
+    m_retryFailedBtn->setEnabled(false);
 
     connect(m_startBtn, &QPushButton::clicked, this, &MediaConvertDialog::onStart);
     connect(m_cancelBtn, &QPushButton::clicked, this, &MediaConvertDialog::onCancel);
+    connect(m_retryFailedBtn, &QPushButton::clicked, this, &MediaConvertDialog::onRetryFailed);
     connect(m_closeBtn, &QPushButton::clicked, this, &QDialog::close);
 
     btns->addWidget(m_startBtn);
     btns->addWidget(m_cancelBtn);
+    btns->addWidget(m_retryFailedBtn);
     btns->addStretch();
     btns->addWidget(m_closeBtn);
     v->addLayout(btns);
@@ -278,6 +298,7 @@ void MediaConvertDialog::loadSettings()
     m_scaleH->setValue(s.value("MediaConvert/ScaleH", 0).toInt());
     m_lockAspect->setChecked(s.value("MediaConvert/LockAspect", true).toBool());
     m_conflictCombo->setCurrentIndex(s.value("MediaConvert/Conflict", 0).toInt());
+    m_segmentedCheck->setChecked(s.value("MediaConvert/Segmented", true).toBool());
     // Video FPS defaults (persisted if present)
     int mp4Fps = s.value("MediaConvert/MP4/Fps", 24).toInt(); if (m_mp4Fps) m_mp4Fps->setValue(mp4Fps);
     int movFps = s.value("MediaConvert/MOV/Fps", 24).toInt(); if (m_movFps) m_movFps->setValue(movFps);
@@ -291,28 +312,14 @@ void MediaConvertDialog::saveSettings()
     s.setValue("MediaConvert/ScaleH", m_scaleH->value());
     s.setValue("MediaConvert/LockAspect", m_lockAspect->isChecked());
     s.setValue("MediaConvert/Conflict", m_conflictCombo->currentIndex());
+    s.setValue("MediaConvert/Segmented", m_segmentedCheck->isChecked());
     if (m_mp4Fps) s.setValue("MediaConvert/MP4/Fps", m_mp4Fps->value());
     if (m_movFps) s.setValue("MediaConvert/MOV/Fps", m_movFps->value());
 }
 
 QString MediaConvertDialog::locateFfmpeg() const
 {
-    // 1) Next to app
-    QString d = QCoreApplication::applicationDirPath();
-#ifdef Q_OS_WIN
-    QString cand = QDir(d).filePath("ffmpeg.exe"); if (QFileInfo::exists(cand)) return cand;
-#endif
-    // 2) third_party
-    cand = QDir(QCoreApplication::applicationDirPath()).filePath("../../third_party/ffmpeg/bin/ffmpeg.exe");
-    if (QFileInfo::exists(cand)) return QFileInfo(cand).absoluteFilePath();
-    // 3) FFMPEG_ROOT
-    QString env = qEnvironmentVariable("FFMPEG_ROOT");
-    if (!env.isEmpty()) {
-        cand = QDir(env).filePath("bin/ffmpeg.exe"); if (QFileInfo::exists(cand)) return QFileInfo(cand).absoluteFilePath();
-    }
-    // 4) PATH
-    return "ffmpeg";
-
+    return Utils::locateFfmpeg();
 }
 
 
@@ -403,17 +410,6 @@ bool MediaConvertDialog::validateAndBuildTasks(QVector<MediaConverterWorker::Tas
     const int targetData = m_targetCombo->currentData().toInt();
     const auto target = static_cast<MediaConverterWorker::TargetKind>(targetData);
 
-    // Validate external tool availability for the selected target
-    if ((target == MediaConverterWorker::TargetKind::VideoMP4 || target == MediaConverterWorker::TargetKind::VideoMOV ||
-         target == MediaConverterWorker::TargetKind::JpgSequence || target == MediaConverterWorker::TargetKind::PngSequence ||
-         target == MediaConverterWorker::TargetKind::TifSequence) && m_ffmpeg.isEmpty()) {
-        error = "FFmpeg not found. Install it or set FFMPEG_ROOT to convert videos/sequences."; return false;
-    }
-    if ((target == MediaConverterWorker::TargetKind::ImageJpg || target == MediaConverterWorker::TargetKind::ImagePng ||
-         target == MediaConverterWorker::TargetKind::ImageTif) && m_magick.isEmpty()) {
-        error = "ImageMagick (magick) not found. Bundle it in third_party or set MAGICK_ROOT to convert single images."; return false;
-    }
-
     int W = m_scaleW->value(); int H = m_scaleH->value();
     if (m_lockAspect->isChecked()) {
         if (W > 0 && H > 0) H = 0; // keep width, infer height to preserve AR
@@ -422,6 +418,7 @@ bool MediaConvertDialog::validateAndBuildTasks(QVector<MediaConverterWorker::Tas
         MediaConverterWorker::Task t; t.sourcePath = s; t.outputDir = outDir; t.target = target;
         t.scaleWidth = W; t.scaleHeight = H;
         t.conflict = static_cast<MediaConverterWorker::ConflictAction>(m_conflictCombo->currentData().toInt());
+        t.allowSegments = m_segmentedCheck->isChecked();
         if (t.conflict == MediaConverterWorker::ConflictAction::AutoRename && QFileInfo::exists(s)) {
             // handled by worker
         }
@@ -456,6 +453,19 @@ bool MediaConvertDialog::validateAndBuildTasks(QVector<MediaConverterWorker::Tas
             t.tif.compression = m_tifCompression->currentText();
             t.tif.includeAlpha = m_tifIncludeAlpha->isChecked();
         }
+        // External tools are only needed for what the in-process image engine can't handle
+        if (!MediaConverterWorker::usesImageEngine(t)) {
+            const bool singleImage = (target == MediaConverterWorker::TargetKind::ImageJpg || target == MediaConverterWorker::TargetKind::ImagePng ||
+                                      target == MediaConverterWorker::TargetKind::ImageTif);
+            if (singleImage && m_magick.isEmpty()) {
+                error = QString("ImageMagick (magick) not found and %1 is not readable by the built-in converter. Bundle it in third_party or set MAGICK_ROOT.")
+                            .arg(QFileInfo(s).fileName());
+                return false;
+            }
+            if (!singleImage && m_ffmpeg.isEmpty()) {
+                error = "FFmpeg not found. Install it or set FFMPEG_ROOT to convert videos/sequences."; return false;
+            }
+        }
         outTasks.push_back(t);
     }
     return true;
@@ -476,6 +486,7 @@ void MediaConvertDialog::onStart()
         connect(m_worker, &MediaConverterWorker::queueStarted, this, &MediaConvertDialog::onQueueStarted);
         connect(m_worker, &MediaConverterWorker::fileStarted, this, &MediaConvertDialog::onFileStarted);
         connect(m_worker, &MediaConverterWorker::logLine, this, &MediaConvertDialog::onLogLine);
+        connect(m_worker, &MediaConverterWorker::taskLogLine, this, &MediaConvertDialog::onTaskLogLine);
         connect(m_worker, &MediaConverterWorker::currentFileProgress, this, &MediaConvertDialog::onCurProgress);
         connect(m_worker, &MediaConverterWorker::overallProgress, this, &MediaConvertDialog::onOverall);
         connect(m_worker, &MediaConverterWorker::fileFinished, this, &MediaConvertDialog::onFileFinished);
@@ -487,6 +498,10 @@ void MediaConvertDialog::onStart()
     m_worker->setFfmpegPath(m_ffmpeg);
     m_worker->setMagickPath(m_magick);
 
+    // Fresh queue: drop rows from a previous run
+    m_taskList->clear();
+    m_taskLogs.clear();
+
     // invoke start on worker's thread
     QMetaObject::invokeMethod(m_worker, [this, tasks](){ m_worker->start(tasks); }, Qt::QueuedConnection);
 
@@ -504,14 +519,36 @@ void MediaConvertDialog::onCancel()
 
 void MediaConvertDialog::onQueueStarted(int total)
 {
-    m_total = total; m_overallBar->setValue(0); m_fileBar->setValue(0);
+    m_total = total; m_overallBar->setValue(0);
+    m_running = true;
+    m_startBtn->setEnabled(false); m_cancelBtn->setEnabled(true); m_retryFailedBtn->setEnabled(false);
+    if (m_taskList->topLevelItemCount() == total) return; // retry of an existing queue keeps its rows
+    m_taskList->clear();
+    m_taskLogs = QVector<QStringList>(total);
+    for (int i = 0; i < total; ++i) {
+        const QString name = i < m_sources.size() ? QFileInfo(m_sources[i]).fileName() : QString::number(i + 1);
+        auto* item = new QTreeWidgetItem(m_taskList, {name, "Queued", QString()});
+        item->setData(0, Qt::UserRole, int(TaskStatus::Queued));
+    }
+}
+
+void MediaConvertDialog::setTaskStatus(int index, TaskStatus status, const QString& text)
+{
+    QTreeWidgetItem* item = m_taskList->topLevelItem(index);
+    if (!item) return;
+    item->setData(0, Qt::UserRole, int(status));
+    item->setText(1, text);
 }
 
 void MediaConvertDialog::onFileStarted(int index, const QString& src, const QString& out, qint64 durationMs)
 {
-    Q_UNUSED(index);
+    Q_UNUSED(durationMs);
+    setTaskStatus(index, TaskStatus::Running, "Running");
+    if (QTreeWidgetItem* item = m_taskList->topLevelItem(index)) {
+        item->setText(2, "0%");
+        item->setToolTip(0, QString("%1 -> %2").arg(src, out));
+    }
     m_status->setText(QString("Converting: %1 -> %2").arg(QFileInfo(src).fileName(), QFileInfo(out).fileName()));
-    if (durationMs <= 0) m_fileBar->setRange(0,0); else { m_fileBar->setRange(0,100); m_fileBar->setValue(0); }
 }
 
 void MediaConvertDialog::onLogLine(const QString& line)
@@ -519,10 +556,14 @@ void MediaConvertDialog::onLogLine(const QString& line)
     m_log->appendPlainText(line.trimmed());
 }
 
-void MediaConvertDialog::onCurProgress(int, int percent, qint64, qint64)
+void MediaConvertDialog::onTaskLogLine(int index, const QString& line)
+{
+    if (index >= 0 && index < m_taskLogs.size()) m_taskLogs[index] << line.trimmed();
+}
+
+void MediaConvertDialog::onCurProgress(int index, int percent, qint64, qint64)
 {
-    if (m_fileBar->maximum() == 0) m_fileBar->setRange(0, 100);
-    m_fileBar->setValue(percent);
+    if (QTreeWidgetItem* item = m_taskList->topLevelItem(index)) item->setText(2, QString("%1%").arg(percent));
 }
 
 void MediaConvertDialog::onOverall(int percent)
@@ -530,29 +571,20 @@ void MediaConvertDialog::onOverall(int percent)
     m_overallBar->setValue(percent);
 }
 
-void MediaConvertDialog::onFileFinished(int, bool success, const QString& errorMsg)
+void MediaConvertDialog::onFileFinished(int index, bool success, const QString& errorMsg)
 {
-    if (!success) {
-        const QString msg = errorMsg.isEmpty() ? QStringLiteral("Conversion failed.") : errorMsg.left(500);
-        m_status->setText(QString("Error: %1").arg(msg.left(200)));
-        // Ask user how to proceed
-        QMessageBox box(this);
-        box.setWindowTitle("Conversion Error");
-        box.setText(QString("%1\n\nChoose an action:").arg(msg));
-        QPushButton *retryB = box.addButton("Retry", QMessageBox::AcceptRole);
-        QPushButton *skipB = box.addButton("Skip", QMessageBox::DestructiveRole);
-        QPushButton *cancelB = box.addButton("Cancel All", QMessageBox::RejectRole);
-        box.setIcon(QMessageBox::Warning);
-        box.exec();
-        if (box.clickedButton() == retryB) {
-            if (m_worker) QMetaObject::invokeMethod(m_worker, &MediaConverterWorker::retryCurrent, Qt::QueuedConnection);
-        } else if (box.clickedButton() == skipB) {
-            if (m_worker) QMetaObject::invokeMethod(m_worker, &MediaConverterWorker::continueAfterFailure, Qt::QueuedConnection);
-        } else if (box.clickedButton() == cancelB) {
-            if (m_worker) QMetaObject::invokeMethod(m_worker, &MediaConverterWorker::cancelAll, Qt::QueuedConnection);
-        }
+    QTreeWidgetItem* item = m_taskList->topLevelItem(index);
+    if (success) {
+        setTaskStatus(index, TaskStatus::Succeeded, "Done");
+        if (item) item->setText(2, "100%");
         return;
     }
+    // Failures no longer stall the queue; the row can be retried once the user has looked at it
+    const bool cancelled = (errorMsg == QLatin1String("Cancelled"));
+    const QString msg = errorMsg.isEmpty() ? QStringLiteral("Conversion failed.") : errorMsg.left(500);
+    setTaskStatus(index, cancelled ? TaskStatus::Cancelled : TaskStatus::Failed, cancelled ? "Cancelled" : "Failed");
+    if (item) item->setToolTip(1, msg);
+    if (!cancelled) m_status->setText(QString("Error: %1").arg(msg.left(200)));
 }
 
 void MediaConvertDialog::onQueueFinished(bool allSuccess)
@@ -560,12 +592,68 @@ void MediaConvertDialog::onQueueFinished(bool allSuccess)
     m_status->setText(allSuccess ? "All conversions completed" : "Conversion finished with errors/cancelled");
     m_running = false;
     m_startBtn->setEnabled(true); m_cancelBtn->setEnabled(false);
+    bool anyFailed = false;
+    for (int i = 0; i < m_taskList->topLevelItemCount(); ++i) {
+        const int st = m_taskList->topLevelItem(i)->data(0, Qt::UserRole).toInt();
+        if (st == int(TaskStatus::Failed) || st == int(TaskStatus::Cancelled)) { anyFailed = true; break; }
+    }
+    m_retryFailedBtn->setEnabled(anyFailed);
     if (allSuccess) {
         // Auto-close on success to avoid lingering dialog after single-image conversions
         QMetaObject::invokeMethod(this, [this](){ this->accept(); }, Qt::QueuedConnection);
     }
 }
 
+void MediaConvertDialog::onTaskContextMenu(const QPoint& pos)
+{
+    QTreeWidgetItem* item = m_taskList->itemAt(pos);
+    if (!item || !m_worker) return;
+    const int index = m_taskList->indexOfTopLevelItem(item);
+    const auto st = TaskStatus(item->data(0, Qt::UserRole).toInt());
+
+    QMenu menu(this);
+    QAction* retryA = menu.addAction("Retry");
+    QAction* cancelA = menu.addAction("Cancel");
+    QAction* logA = menu.addAction("Show Log");
+    retryA->setEnabled(st == TaskStatus::Failed || st == TaskStatus::Cancelled);
+    cancelA->setEnabled(st == TaskStatus::Queued || st == TaskStatus::Running);
+    QAction* chosen = menu.exec(m_taskList->viewport()->mapToGlobal(pos));
+    if (chosen == retryA) {
+        setTaskStatus(index, TaskStatus::Queued, "Queued");
+        QMetaObject::invokeMethod(m_worker, [w = m_worker, index]{ w->retryTask(index); }, Qt::QueuedConnection);
+    } else if (chosen == cancelA) {
+        QMetaObject::invokeMethod(m_worker, [w = m_worker, index]{ w->cancelTask(index); }, Qt::QueuedConnection);
+    } else if (chosen == logA) {
+        showTaskLog(index);
+    }
+}
+
+void MediaConvertDialog::onRetryFailed()
+{
+    if (!m_worker) return;
+    for (int i = 0; i < m_taskList->topLevelItemCount(); ++i) {
+        const int st = m_taskList->topLevelItem(i)->data(0, Qt::UserRole).toInt();
+        if (st != int(TaskStatus::Failed) && st != int(TaskStatus::Cancelled)) continue;
+        setTaskStatus(i, TaskStatus::Queued, "Queued");
+        QMetaObject::invokeMethod(m_worker, [w = m_worker, i]{ w->retryTask(i); }, Qt::QueuedConnection);
+    }
+    m_retryFailedBtn->setEnabled(false);
+}
+
+void MediaConvertDialog::showTaskLog(int index)
+{
+    if (index < 0 || index >= m_taskLogs.size()) return;
+    QDialog dlg(this);
+    dlg.setWindowTitle(QString("Log: %1").arg(m_taskList->topLevelItem(index)->text(0)));
+    dlg.resize(800, 500);
+    auto* lay = new QVBoxLayout(&dlg);
+    auto* text = new QPlainTextEdit(&dlg);
+    text->setReadOnly(true);
+    text->setPlainText(m_taskLogs[index].join('\n'));
+    lay->addWidget(text);
+    dlg.exec();
+}
+
 void MediaConvertDialog::onVerifySequence()
 {
     // Find first image sequence among sources and perform a thorough scan
@@ -10,6 +10,7 @@
 #include <QSpinBox>
 #include <QProgressBar>
 #include <QPlainTextEdit>
+#include <QTreeWidget>
 #include <QPushButton>
 #include <QLabel>
 #include <QThread>
@@ -34,13 +35,20 @@ private slots:
     void onQueueStarted(int total);
     void onFileStarted(int index, const QString& src, const QString& out, qint64 durationMs);
     void onLogLine(const QString& line);
+    void onTaskLogLine(int index, const QString& line);
     void onCurProgress(int index, int percent, qint64 outMs, qint64 totalMs);
     void onOverall(int percent);
     void onFileFinished(int index, bool success, const QString& errorMsg);
     void onQueueFinished(bool allSuccess);
+    void onTaskContextMenu(const QPoint& pos);
+    void onRetryFailed();
 
 private:
+    enum class TaskStatus { Queued, Running, Succeeded, Failed, Cancelled };
+
     void buildUi();
+    void setTaskStatus(int index, TaskStatus status, const QString& text);
+    void showTaskLog(int index);
     void loadSettings();
     void saveSettings();
     QString locateFfmpeg() const;
@@ -84,12 +92,14 @@ private:
 
     // Conflict policy
     QComboBox* m_conflictCombo = nullptr;
+    QCheckBox* m_segmentedCheck = nullptr;
 
     // Progress
-    QProgressBar* m_overallBar = nullptr; QProgressBar* m_fileBar = nullptr; QLabel* m_status = nullptr; QPlainTextEdit* m_log = nullptr;
+    QProgressBar* m_overallBar = nullptr; QTreeWidget* m_taskList = nullptr; QLabel* m_status = nullptr; QPlainTextEdit* m_log = nullptr;
+    QVector<QStringList> m_taskLogs;
 
     // Buttons
-    QPushButton* m_startBtn = nullptr; QPushButton* m_cancelBtn = nullptr; QPushButton* m_closeBtn = nullptr;
+    QPushButton* m_startBtn = nullptr; QPushButton* m_cancelBtn = nullptr; QPushButton* m_retryFailedBtn = nullptr; QPushButton* m_closeBtn = nullptr;
 
     // Worker
     QThread m_thread; MediaConverterWorker* m_worker = nullptr;
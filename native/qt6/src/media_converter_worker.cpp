@@ -1,6 +1,8 @@
 #include "media_converter_worker.h"
 #include "utils.h"
+#include "media_probe_cache.h"
 
+#include <QFile>
 #include <QFileInfo>
 #include <QDir>
 #include <QStandardPaths>
@@ -8,12 +10,27 @@
 #include <QTextStream>
 #include <QRegularExpression>
 #include <QSet>
+#include <QSettings>
+#include <QThread>
+#include <QProcessEnvironment>
+#include <QtConcurrent/QtConcurrentRun>
 
 
 namespace {
 constexpr qint64 kSeqUpperSearchStart = 10000000; // 10M
 constexpr int kSeqUpperSearchMaxDoublings = 32;
 constexpr qint64 kSeqUpperSearchHardCap = 100000000; // 100M
+// Segmented encodes: chunks shorter than this spend too much of their time starting up
+constexpr qint64 kMinSegmentFrames = 240;
+constexpr int kMaxChunkAttempts = 3;
+// In-process image batches: enough files to keep the pipeline full, few enough that
+// later tasks in the queue still get a turn
+constexpr int kEngineBatchItems = 512;
+const QSet<QString>& stillImageExts()
+{
+    static const QSet<QString> exts = {"png","jpg","jpeg","tif","tiff","exr","iff","psd","bmp","tga","dds","webp","hdr","dpx"};
+    return exts;
+}
 }
 
 #include <algorithm>
@@ -24,77 +41,242 @@ static QString quote(const QString& p){
     return '"' + s + '"';
 }
 
-MediaConverterWorker::MediaConverterWorker(QObject* parent) : QObject(parent) {}
+MediaConverterWorker::MediaConverterWorker(QObject* parent) : QObject(parent), m_budget(defaultCpuBudget()) {}
+
+MediaConverterWorker::~MediaConverterWorker()
+{
+    // Engine batches call back into this object; stop them before it goes away
+    for (auto it = m_batches.begin(); it != m_batches.end(); ++it) it->cancel->store(true);
+    for (auto it = m_batches.begin(); it != m_batches.end(); ++it) it->future.waitForFinished();
+}
+
+int MediaConverterWorker::defaultCpuBudget()
+{
+    QSettings s("AugmentCode", "KAssetManager");
+    const int cores = qMax(1, QThread::idealThreadCount());
+    return qBound(1, s.value("MediaConverter/CpuBudget", cores).toInt(), 256);
+}
+
+int MediaConverterWorker::taskCost(const Task& t, int budget)
+{
+    // Rough cores each job keeps busy; the tool is capped to the same thread count
+    int cost = 1;
+    switch (t.target) {
+        case TargetKind::VideoMP4: {
+            const QString c = t.mp4.codec.toLower();
+            cost = (c == "hevc" || c == "h265" || c == "libx265") ? 8 : 4;
+            break;
+        }
+        case TargetKind::VideoMOV: {
+            const QString c = t.mov.codec.toLower();
+            if (c == "h264") cost = 4;
+            else if (c == "animation" || c == "qtrle") cost = 1; // qtrle is single threaded
+            else cost = t.mov.proresProfile >= 3 ? 4 : 3;       // prores_ks slice threads
+            break;
+        }
+        case TargetKind::JpgSequence:
+        case TargetKind::PngSequence:
+        case TargetKind::TifSequence:
+            cost = 2; // decoder threads + one image encoder
+            break;
+        case TargetKind::ImageJpg:
+        case TargetKind::ImagePng:
+        case TargetKind::ImageTif:
+            cost = 1;
+            break;
+    }
+    return std::clamp(cost, 1, qMax(1, budget));
+}
+
+QVector<MediaConverterWorker::Segment> MediaConverterWorker::planSegments(qint64 startNumber, qint64 totalFrames, int gop, int parallelJobs)
+{
+    if (totalFrames <= 0 || gop <= 0 || parallelJobs < 2) return {};
+    // Two chunks per parallel slot keeps cores busy while the slowest chunk finishes;
+    // lengths are whole GOPs so every chunk starts where a single encode would put a keyframe
+    qint64 len = (totalFrames + 2 * parallelJobs - 1) / (2 * parallelJobs);
+    len = qMax(len, kMinSegmentFrames);
+    len = ((len + gop - 1) / gop) * gop;
+    if (len >= totalFrames) return {};
+    QVector<Segment> out;
+    for (qint64 s = 0; s < totalFrames; s += len) out.push_back(Segment{startNumber + s, qMin(len, totalFrames - s)});
+    return out;
+}
+
+int MediaConverterWorker::segmentGop(const QStringList& args, int fps)
+{
+    const int c = args.indexOf("-c:v");
+    const QString codec = (c >= 0 && c + 1 < args.size()) ? args[c + 1] : QString();
+    // ProRes and Animation are intra-only, any frame can start a chunk
+    if (codec == "libx264" || codec == "libx265") return qMax(1, fps) * 2;
+    return 1;
+}
+
+QStringList MediaConverterWorker::segmentArgs(const QStringList& baseArgs, const Segment& range, int gop, const QString& chunkPath)
+{
+    QStringList a = baseArgs;
+    a.removeLast(); // final output path
+    const int sn = a.indexOf("-start_number");
+    if (sn >= 0 && sn + 1 < a.size()) a[sn + 1] = QString::number(range.startNumber);
+    const int mf = a.indexOf("-movflags");
+    if (mf >= 0 && mf + 1 < a.size()) a.remove(mf, 2); // faststart is applied once, by the join
+    a << "-frames:v" << QString::number(range.frames);
+    if (gop > 1) a << "-g" << QString::number(gop);
+    a << chunkPath;
+    return a;
+}
 
 void MediaConverterWorker::start(const QVector<Task>& tasks)
 {
     if (tasks.isEmpty()) { emit queueFinished(true); return; }
     m_tasks = tasks;
-    m_index = -1;
+    m_states = QVector<TaskState>(tasks.size(), TaskState::Pending);
+    m_percent = QVector<int>(tasks.size(), 0);
     m_cancelling = false;
+    m_queueActive = true;
+    for (auto it = m_segmented.constBegin(); it != m_segmented.constEnd(); ++it) QDir(it->chunkDir).removeRecursively();
+    m_segmented.clear();
+    m_claimedOutputs.clear();
+    m_outputOfTask.clear();
+    // Only used when built without libavformat: prefer the ffprobe shipped next to ffmpeg
+    if (!m_ffmpegPath.isEmpty()) {
+        const QString ffprobe = QFileInfo(m_ffmpegPath).dir().filePath(QFileInfo(m_ffmpegPath).suffix().isEmpty() ? "ffprobe" : "ffprobe.exe");
+        MediaProbeCache::instance().setFfprobePath(QFileInfo::exists(ffprobe) ? ffprobe : QStringLiteral("ffprobe"));
+    }
     emit queueStarted(m_tasks.size());
-    startNext();
+    schedule();
 }
 
-
 void MediaConverterWorker::cancelAll()
 {
     m_cancelling = true;
-    if (m_proc) {
-        m_proc->kill();
-    } else if (m_waitingOnError) {
-        m_waitingOnError = false;
-        emit queueFinished(false);
+    for (int i = 0; i < m_states.size(); ++i) {
+        if (m_states[i] == TaskState::Pending) finishTask(i, TaskState::Cancelled, QStringLiteral("Cancelled"));
+        // Segmented task whose chunks are all still waiting for budget
+        else if (m_states[i] == TaskState::Running && !hasJobs(i)) {
+            discardSegments(i);
+            finishTask(i, TaskState::Cancelled, QStringLiteral("Cancelled"));
+        }
     }
+    // Running jobs report through onProcessFinished / onEngineBatchFinished, which complete the queue
+    for (auto it = m_batches.begin(); it != m_batches.end(); ++it) it->cancel->store(true);
+    const auto procs = m_jobs.keys();
+    for (QProcess* p : procs) p->kill();
+    schedule();
 }
 
-void MediaConverterWorker::retryCurrent()
+void MediaConverterWorker::cancelTask(int index)
 {
-    if (m_index >= 0) {
-        // Restart current by decrementing index to re-run in startNext
-        m_waitingOnError = false;
-        m_index -= 1;
-        startNext();
+    if (index < 0 || index >= m_states.size()) return;
+    if (m_states[index] == TaskState::Pending) {
+        finishTask(index, TaskState::Cancelled, QStringLiteral("Cancelled"));
+        schedule();
+        return;
     }
+    if (m_states[index] != TaskState::Running) return;
+    if (m_batchOfTask.contains(index)) {
+        // Other tasks may share the batch; this one's remaining results are ignored
+        const int batchId = m_batchOfTask.take(index);
+        bool shared = false;
+        for (auto it = m_batchOfTask.constBegin(); it != m_batchOfTask.constEnd(); ++it) if (it.value() == batchId) { shared = true; break; }
+        if (!shared) m_batches[batchId].cancel->store(true);
+        finishTask(index, TaskState::Cancelled, QStringLiteral("Cancelled"));
+        return;
+    }
+    m_states[index] = TaskState::Cancelled; // onProcessFinished reports it
+    if (hasJobs(index)) {
+        const auto procs = m_jobs.keys();
+        for (QProcess* p : procs) if (m_jobs.value(p).index == index) p->kill();
+        return;
+    }
+    // A segmented task waiting for budget has nothing running to report back
+    discardSegments(index);
+    finishTask(index, TaskState::Cancelled, QStringLiteral("Cancelled"));
+    schedule();
 }
 
-void MediaConverterWorker::continueAfterFailure()
+void MediaConverterWorker::retryTask(int index)
 {
-    // Skip the failed item and continue with next
-    if (m_waitingOnError) {
-        m_waitingOnError = false;
-        startNext();
+    if (index < 0 || index >= m_states.size()) return;
+    if (m_states[index] != TaskState::Failed && m_states[index] != TaskState::Cancelled) return;
+    m_states[index] = TaskState::Pending;
+    m_percent[index] = 0;
+    m_cancelling = false;
+    if (!m_queueActive) {
+        m_queueActive = true;
+        emit queueStarted(m_tasks.size());
     }
+    schedule();
 }
 
-void MediaConverterWorker::startNext()
+void MediaConverterWorker::schedule()
 {
-    if (m_cancelling) { emit queueFinished(false); return; }
-    if (m_proc) { m_proc->deleteLater(); m_proc = nullptr; }
+    if (!m_queueActive) return;
+    // Start pending tasks in queue order while they fit in the budget; a task
+    // larger than the free budget waits, but one job always runs
+    for (int i = 0; i < m_states.size() && !m_cancelling; ++i) {
+        if (m_states[i] == TaskState::Running && m_segmented.contains(i)) {
+            if (!launchChunks(i)) break;
+            continue;
+        }
+        if (m_states[i] != TaskState::Pending) continue;
+        if (usesImageEngine(m_tasks[i])) {
+            if (anyRunning() && m_usedBudget >= m_budget) break;
+            launchEngineBatch(i);
+            continue;
+        }
+        const int cost = taskCost(m_tasks[i], m_budget);
+        if (anyRunning() && m_usedBudget + cost > m_budget) break;
+        if (launch(i)) m_usedBudget += cost;
+    }
 
-    m_index += 1;
-    if (m_index >= m_tasks.size()) { emit queueFinished(true); return; }
+    if (anyRunning()) return;
+    for (TaskState st : std::as_const(m_states)) if (st == TaskState::Pending) return;
+    bool allSuccess = true;
+    for (TaskState st : std::as_const(m_states)) if (st != TaskState::Succeeded) { allSuccess = false; break; }
+    m_queueActive = false;
+    emit queueFinished(allSuccess);
+}
 
-    const Task& t = m_tasks[m_index];
+bool MediaConverterWorker::launch(int index)
+{
+    const Task& t = m_tasks[index];
+
+    if (m_segmented.contains(index)) {
+        // Retry of a failed segmented task: chunks that already encoded are kept
+        SegmentedTask& seg = m_segmented[index];
+        int done = 0;
+        for (Chunk& ch : seg.chunks) {
+            if (ch.state == ChunkState::Done) ++done;
+            ch.attempts = 0;
+        }
+        m_states[index] = TaskState::Running;
+        emit fileStarted(index, t.sourcePath, seg.outPath, 0);
+        emitTaskLog(index, QString("[Segments] Resuming, %1 of %2 chunks already encoded").arg(done).arg(seg.chunks.size()));
+        launchChunks(index);
+        return false;
+    }
 
     QString err, program, outPath; QStringList args; qint64 durMs = 0;
     if (!buildCommand(t, program, outPath, args, durMs, err)) {
         emit logLine(QString("[ERROR] %1").arg(err));
-        emit fileFinished(m_index, false, err);
-        startNext();
-        return;
+        finishTask(index, TaskState::Failed, err);
+        return false;
     }
 
     if (t.conflict == ConflictAction::Skip && QFileInfo::exists(outPath)) {
         emit logLine(QString("[Skip] %1 exists").arg(outPath));
-        emit fileFinished(m_index, true, QString());
-        overallProgress(int(double(m_index+1) / double(m_tasks.size()) * 100.0));
-        startNext();
-        return;
+        finishTask(index, TaskState::Succeeded, QString());
+        return false;
     }
+    claimOutput(index, outPath);
+
+    Job job;
+    job.index = index;
+    job.cost = taskCost(t, m_budget);
+    job.durationMs = durMs;
 
     // Estimate total frames for frame-based progress when possible
-    m_estTotalFrames = 0;
+    qint64 seqFirst = -1, seqFrames = 0;
     if (t.target == TargetKind::VideoMP4 || t.target == TargetKind::VideoMOV) {
         QFileInfo inFi(t.sourcePath);
         static QRegularExpression rxDigits("(\\d+)(?!.*\\d)");
@@ -103,39 +285,410 @@ void MediaConverterWorker::startNext()
         static const QSet<QString> imgExts = {"png","jpg","jpeg","tif","tiff","exr","iff","psd","bmp","tga","dds","webp"};
         if (mm.hasMatch() && imgExts.contains(ext)) {
             const int pad = mm.captured(1).length();
-            m_estTotalFrames = countSequenceFrames(inFi, mm, pad);
+            qint64 last = -1;
+            job.estTotalFrames = countSequenceFrames(inFi, mm, pad, &last);
+            // ffmpeg reads from the picked frame onwards (-start_number). image2 only skips
+            // a few missing numbers at the start of its input, so a chunk starting inside
+            // a gap would fail: sequences with gaps are encoded in one process
+            if (t.allowSegments) {
+                const qint64 first = mm.captured(1).toLongLong();
+                if (isContiguousSequence(inFi, mm, first, last)) {
+                    seqFirst = first;
+                    seqFrames = last - first + 1;
+                } else {
+                    emitTaskLog(index, QStringLiteral("[Segments] Sequence has missing frames; encoding in one pass"));
+                }
+            }
         } else if (durMs > 0) {
-            const double fps = probeAvgFps(m_ffmpegPath, t.sourcePath);
-            if (fps > 0.0) m_estTotalFrames = qMax<qint64>(1, qint64((durMs/1000.0) * fps + 0.5));
+            const double fps = probeAvgFps(t.sourcePath);
+            if (fps > 0.0) job.estTotalFrames = qMax<qint64>(1, qint64((durMs/1000.0) * fps + 0.5));
         }
     } else if (t.target == TargetKind::JpgSequence || t.target == TargetKind::PngSequence || t.target == TargetKind::TifSequence) {
         if (durMs > 0) {
-            const double fps = probeAvgFps(m_ffmpegPath, t.sourcePath);
-            if (fps > 0.0) m_estTotalFrames = qMax<qint64>(1, qint64((durMs/1000.0) * fps + 0.5));
+            const double fps = probeAvgFps(t.sourcePath);
+            if (fps > 0.0) job.estTotalFrames = qMax<qint64>(1, qint64((durMs/1000.0) * fps + 0.5));
         }
     }
 
-    m_curDurationMs = durMs;
+    if (t.allowSegments && seqFirst >= 0 && beginSegmented(index, program, outPath, args, seqFirst, seqFrames)) {
+        emit fileStarted(index, t.sourcePath, outPath, durMs);
+        launchChunks(index);
+        return false; // chunks charge the budget themselves
+    }
 
-    emit fileStarted(m_index, t.sourcePath, outPath, durMs);
+    m_states[index] = TaskState::Running;
+    emit fileStarted(index, t.sourcePath, outPath, durMs);
+    startProcess(job, program, args);
+    return true;
+}
 
-    m_proc = new QProcess(this);
-    connect(m_proc, &QProcess::readyReadStandardOutput, this, &MediaConverterWorker::onReadyStdOut);
-    connect(m_proc, &QProcess::readyReadStandardError, this, &MediaConverterWorker::onReadyStdErr);
-    connect(m_proc, qOverload<int,QProcess::ExitStatus>(&QProcess::finished), this, &MediaConverterWorker::onFinished);
+bool MediaConverterWorker::beginSegmented(int index, const QString& program, const QString& outPath, const QStringList& args,
+                                          qint64 firstFrame, qint64 frames)
+{
+    const Task& t = m_tasks[index];
+    const int fps = (t.target == TargetKind::VideoMP4) ? t.mp4.fps : t.mov.fps;
+    const int gop = segmentGop(args, fps > 0 ? fps : 24);
+    const int parallel = m_budget / taskCost(t, m_budget);
+    const QVector<Segment> ranges = planSegments(firstFrame, frames, gop, parallel);
+    if (ranges.size() < 2) return false;
+
+    const QFileInfo outFi(outPath);
+    SegmentedTask seg;
+    seg.program = program;
+    seg.baseArgs = args;
+    seg.outPath = outPath;
+    seg.chunkDir = QDir(outFi.absolutePath()).filePath("." + outFi.completeBaseName() + "_segments");
+    seg.gop = gop;
+    seg.totalFrames = frames;
+    QDir(seg.chunkDir).removeRecursively();
+    if (!QDir().mkpath(seg.chunkDir)) return false;
+    for (int c = 0; c < ranges.size(); ++c) {
+        Chunk ch;
+        ch.range = ranges[c];
+        ch.path = QDir(seg.chunkDir).filePath(QString("chunk_%1.%2").arg(c, 4, 10, QChar('0')).arg(outFi.suffix()));
+        seg.chunks.push_back(ch);
+    }
+    m_states[index] = TaskState::Running;
+    m_segmented.insert(index, seg);
+    emitTaskLog(index, QString("[Segments] %1 frames in %2 chunks (GOP %3), up to %4 at a time")
+                           .arg(frames).arg(ranges.size()).arg(gop).arg(qMax(1, parallel)));
+    return true;
+}
 
-    m_proc->setProgram(program);
-    m_proc->setArguments(args);
-    emit logLine(QString("%1 %2").arg(QFileInfo(program).fileName(), args.join(' ')));
-    m_timer.restart();
-    m_proc->start();
+bool MediaConverterWorker::launchChunks(int index)
+{
+    SegmentedTask& seg = m_segmented[index];
+    if (seg.aborting || seg.concatRunning) return true;
+    const int cost = taskCost(m_tasks[index], m_budget);
+    bool allDone = true;
+    for (int c = 0; c < seg.chunks.size(); ++c) {
+        Chunk& ch = seg.chunks[c];
+        if (ch.state != ChunkState::Done) allDone = false;
+        if (ch.state != ChunkState::Pending) continue;
+        if (anyRunning() && m_usedBudget + cost > m_budget) return false;
+        Job job;
+        job.index = index;
+        job.cost = cost;
+        job.chunk = c;
+        job.estTotalFrames = ch.range.frames;
+        ch.state = ChunkState::Running;
+        ch.framesDone = 0;
+        m_usedBudget += cost;
+        startProcess(job, seg.program, segmentArgs(seg.baseArgs, ch.range, seg.gop, ch.path));
+    }
+    if (!allDone) return true;
+
+    // Every chunk is encoded: join them without re-encoding
+    const QString listPath = QDir(seg.chunkDir).filePath("concat.txt");
+    QFile list(listPath);
+    if (!list.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text)) {
+        seg.aborting = true;
+        seg.error = QString("Cannot write %1").arg(listPath);
+        discardSegments(index);
+        finishTask(index, TaskState::Failed, seg.error);
+        return true;
+    }
+    QTextStream ts(&list);
+    for (const Chunk& ch : std::as_const(seg.chunks)) ts << "file '" << QFileInfo(ch.path).fileName() << "'\n";
+    list.close();
+
+    QStringList args;
+    args << "-hide_banner" << "-nostdin" << "-y" << "-progress" << "pipe:1";
+    args << "-f" << "concat" << "-safe" << "0" << "-i" << listPath << "-c" << "copy";
+    if (seg.baseArgs.contains("-movflags")) args << "-movflags" << "+faststart";
+    args << seg.outPath;
+    Job job;
+    job.index = index;
+    job.cost = 1;
+    job.chunk = kConcatJob;
+    seg.concatRunning = true;
+    m_usedBudget += job.cost;
+    startProcess(job, seg.program, args);
+    return true;
+}
+
+bool MediaConverterWorker::hasJobs(int index) const
+{
+    if (m_batchOfTask.contains(index)) return true;
+    for (auto it = m_jobs.constBegin(); it != m_jobs.constEnd(); ++it) if (it->index == index) return true;
+    return false;
 }
 
-void MediaConverterWorker::onReadyStdOut()
+void MediaConverterWorker::discardSegments(int index)
 {
-    const QByteArray data = m_proc->readAllStandardOutput();
-    const QString s = QString::fromUtf8(data);
-    emit logLine(s);
+    auto it = m_segmented.find(index);
+    if (it == m_segmented.end()) return;
+    QDir(it->chunkDir).removeRecursively();
+    m_segmented.erase(it);
+    releaseOutput(index);
+}
+
+void MediaConverterWorker::claimOutput(int index, const QString& outPath)
+{
+    m_claimedOutputs.insert(outPath);
+    m_outputOfTask.insert(index, outPath);
+}
+
+void MediaConverterWorker::releaseOutput(int index)
+{
+    const auto it = m_outputOfTask.constFind(index);
+    if (it == m_outputOfTask.constEnd()) return;
+    m_claimedOutputs.remove(it.value());
+    m_outputOfTask.erase(it);
+}
+
+bool MediaConverterWorker::usesImageEngine(const Task& t)
+{
+    switch (t.target) {
+        case TargetKind::ImageJpg:
+        case TargetKind::ImagePng:
+        case TargetKind::ImageTif:
+            return ImageConvertEngine::canRead(t.sourcePath);
+        case TargetKind::JpgSequence:
+        case TargetKind::PngSequence:
+        case TargetKind::TifSequence:
+            // Videos still go through ffmpeg
+            return stillImageExts().contains(QFileInfo(t.sourcePath).suffix().toLower()) && ImageConvertEngine::canRead(t.sourcePath);
+        default:
+            return false;
+    }
+}
+
+ImageConvertEngine::Options MediaConverterWorker::engineOptions(const Task& t)
+{
+    using ImageConvertEngine::Format;
+    ImageConvertEngine::Options o;
+    o.scaleWidth = t.scaleWidth;
+    o.scaleHeight = t.scaleHeight;
+    switch (t.target) {
+        case TargetKind::ImageJpg: o.format = Format::Jpg; o.quality = t.jpg.quality; break;
+        case TargetKind::ImagePng: o.format = Format::Png; o.includeAlpha = t.png.includeAlpha; break;
+        case TargetKind::ImageTif: o.format = Format::Tif; o.compression = t.tif.compression; o.includeAlpha = t.tif.includeAlpha; break;
+        // ffmpeg qscale 2 (best) .. 31 (worst) mapped onto a JPEG quality
+        case TargetKind::JpgSequence: o.format = Format::Jpg; o.quality = std::clamp(100 - (t.jpgSeq.qscale - 1) * 3, 10, 100); break;
+        case TargetKind::PngSequence: o.format = Format::Png; o.includeAlpha = t.pngSeq.includeAlpha; break;
+        case TargetKind::TifSequence: o.format = Format::Tif; o.compression = t.tifSeq.compression; o.includeAlpha = t.tifSeq.includeAlpha; break;
+        default: break;
+    }
+    return o;
+}
+
+bool MediaConverterWorker::engineItems(const Task& t, QVector<ImageConvertEngine::Item>& items, QString& outPath,
+                                       QSet<QString>& reserved, QString& err) const
+{
+    items.clear();
+    const QFileInfo inFi(t.sourcePath);
+    if (!inFi.exists()) { err = QString("Source not found: %1").arg(t.sourcePath); return false; }
+    const QString outDir = t.outputDir.isEmpty() ? inFi.dir().absolutePath() : t.outputDir;
+    QDir().mkpath(outDir);
+    const QString ext = ImageConvertEngine::extensionFor(engineOptions(t).format);
+
+    if (t.target == TargetKind::ImageJpg || t.target == TargetKind::ImagePng || t.target == TargetKind::ImageTif) {
+        const QString base = inFi.completeBaseName();
+        outPath = QDir(outDir).filePath(base + "." + ext);
+        if (t.conflict == ConflictAction::Skip && QFileInfo::exists(outPath)) return true; // nothing to do
+        // Outputs of running tasks are not on disk yet, so check those too
+        if (t.conflict == ConflictAction::AutoRename) outPath = uniqueOutPath(outPath, reserved);
+        reserved.insert(outPath);
+        items.push_back(ImageConvertEngine::Item{inFi.absoluteFilePath(), outPath, -1});
+        return true;
+    }
+
+    // Image sequence -> image sequence: every frame of the source sequence
+    static QRegularExpression rxDigits("(\\d+)(?!.*\\d)");
+    const QRegularExpressionMatch mm = rxDigits.match(inFi.fileName());
+    QVector<QPair<qint64, QString>> frames;
+    QString base = inFi.completeBaseName();
+    if (mm.hasMatch()) {
+        const QString pre = inFi.fileName().left(mm.capturedStart(1));
+        const QString post = inFi.fileName().mid(mm.capturedEnd(1));
+        const QRegularExpression rxFrame("^" + QRegularExpression::escape(pre) + "(\\d+)" + QRegularExpression::escape(post) + "$");
+        const QDir dir = inFi.dir();
+        const QStringList names = dir.entryList({pre + "*" + post}, QDir::Files);
+        for (const QString& name : names) {
+            const QRegularExpressionMatch fm = rxFrame.match(name);
+            if (fm.hasMatch()) frames.push_back({fm.captured(1).toLongLong(), dir.filePath(name)});
+        }
+        std::sort(frames.begin(), frames.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+        base = pre;
+        while (!base.isEmpty() && QStringLiteral("._- ").contains(base.back())) base.chop(1);
+        if (base.isEmpty()) base = QStringLiteral("frame");
+    }
+    if (frames.isEmpty()) frames.push_back({0, inFi.absoluteFilePath()});
+
+    int pad = 4, start = 1;
+    if (t.target == TargetKind::JpgSequence) { pad = t.jpgSeq.padDigits; start = t.jpgSeq.startNumber; }
+    else if (t.target == TargetKind::PngSequence) { pad = t.pngSeq.padDigits; start = t.pngSeq.startNumber; }
+    else if (t.target == TargetKind::TifSequence) { pad = t.tifSeq.padDigits; start = t.tifSeq.startNumber; }
+    pad = std::clamp(pad, 1, 8);
+    start = std::max(0, start);
+
+    // Same layout ffmpeg produces for video -> sequence
+    const QString seqDir = QDir(outDir).filePath(base + "_" + ext + "_seq");
+    if (!QDir().mkpath(seqDir)) { err = QString("Cannot create %1").arg(seqDir); return false; }
+    outPath = QDir(seqDir).filePath(base + "_" + QString("%") + QString("0%1d").arg(pad) + "." + ext);
+    items.reserve(frames.size());
+    for (int i = 0; i < frames.size(); ++i) {
+        const QString dst = QDir(seqDir).filePath(base + "_" + QString::number(start + i).rightJustified(pad, QLatin1Char('0')) + "." + ext);
+        items.push_back(ImageConvertEngine::Item{frames[i].second, dst, -1});
+    }
+    return true;
+}
+
+void MediaConverterWorker::launchEngineBatch(int firstIndex)
+{
+    const ImageConvertEngine::Options opts = engineOptions(m_tasks[firstIndex]);
+    auto sameOptions = [&opts](const ImageConvertEngine::Options& o) {
+        return o.format == opts.format && o.quality == opts.quality && o.includeAlpha == opts.includeAlpha &&
+               o.compression == opts.compression && o.scaleWidth == opts.scaleWidth && o.scaleHeight == opts.scaleHeight;
+    };
+
+    const int batchId = m_nextBatchId++;
+    EngineBatch batch;
+    batch.cancel = std::make_shared<std::atomic_bool>(false);
+    // Consecutive pending tasks with the same settings share one pipeline
+    for (int i = firstIndex; i < m_tasks.size() && batch.items.size() < kEngineBatchItems; ++i) {
+        if (m_states[i] != TaskState::Pending) continue;
+        const Task& t = m_tasks[i];
+        if (!usesImageEngine(t) || !sameOptions(engineOptions(t))) break;
+
+        QVector<ImageConvertEngine::Item> taskItems;
+        QString outPath, err;
+        if (!engineItems(t, taskItems, outPath, m_claimedOutputs, err)) {
+            emit logLine(QString("[ERROR] %1").arg(err));
+            finishTask(i, TaskState::Failed, err);
+            continue;
+        }
+        if (taskItems.isEmpty()) {
+            emit logLine(QString("[Skip] %1 exists").arg(outPath));
+            finishTask(i, TaskState::Succeeded, QString());
+            continue;
+        }
+        for (ImageConvertEngine::Item& item : taskItems) {
+            item.tag = i;
+            batch.items.push_back(item);
+        }
+        // engineItems claimed single-image outputs; released when the batch stops writing
+        m_outputOfTask.insert(i, outPath);
+        batch.total.insert(i, taskItems.size());
+        batch.remaining.insert(i, taskItems.size());
+        m_states[i] = TaskState::Running;
+        m_percent[i] = 0;
+        m_batchOfTask.insert(i, batchId);
+        emit fileStarted(i, t.sourcePath, outPath, 0);
+        emitTaskLog(i, QString("[ImageEngine] %1 file(s): %2 -> %3").arg(QString::number(taskItems.size()), t.sourcePath, outPath));
+    }
+    if (batch.items.isEmpty()) return;
+
+    // A single file doesn't need the whole box; a big batch takes whatever is free
+    batch.cost = std::clamp(int(batch.items.size()), 1, qMax(1, m_budget - m_usedBudget));
+    m_usedBudget += batch.cost;
+    const QVector<ImageConvertEngine::Item> items = batch.items;
+    const auto cancel = batch.cancel;
+    // The engine runs on exactly this many threads, so the charge above is the real cost
+    const int threads = batch.cost;
+    m_batches.insert(batchId, batch);
+    m_batches[batchId].future = QtConcurrent::run([this, batchId, items, opts, threads, cancel] {
+        ImageConvertEngine::run(items, opts, threads, *cancel, [this, batchId](const ImageConvertEngine::Result& r) {
+            QMetaObject::invokeMethod(this, [this, batchId, r] { onEngineResult(batchId, r); }, Qt::QueuedConnection);
+        });
+        QMetaObject::invokeMethod(this, [this, batchId] { onEngineBatchFinished(batchId); }, Qt::QueuedConnection);
+    });
+}
+
+void MediaConverterWorker::onEngineResult(int batchId, const ImageConvertEngine::Result& r)
+{
+    auto bit = m_batches.find(batchId);
+    if (bit == m_batches.end()) return;
+    const int index = r.tag;
+    if (m_batchOfTask.value(index, -1) != batchId) return; // task was cancelled on its own
+
+    if (!r.ok) {
+        if (bit->failed[index]++ == 0) bit->firstError[index] = r.error;
+        emitTaskLog(index, QString("[ImageEngine] %1: %2").arg(bit->items[r.item].src, r.error));
+    }
+    const int total = bit->total.value(index);
+    const int left = --bit->remaining[index];
+    const int done = total - left;
+    m_percent[index] = total > 0 ? done * 100 / total : 100;
+    emit currentFileProgress(index, m_percent[index], done, total);
+    emitOverall();
+    if (left > 0) return;
+
+    m_batchOfTask.remove(index);
+    const int failed = bit->failed.value(index);
+    if (failed == 0) {
+        finishTask(index, TaskState::Succeeded, QString());
+    } else {
+        finishTask(index, TaskState::Failed, total == 1 ? bit->firstError.value(index)
+                   : QString("%1 of %2 files failed; first error: %3").arg(failed).arg(total).arg(bit->firstError.value(index)));
+    }
+}
+
+void MediaConverterWorker::onEngineBatchFinished(int batchId)
+{
+    if (!m_batches.contains(batchId)) return;
+    const EngineBatch batch = m_batches.take(batchId);
+    m_usedBudget -= batch.cost;
+    // Tasks cancelled on their own may still have had files written until now
+    for (auto it = batch.total.constBegin(); it != batch.total.constEnd(); ++it) releaseOutput(it.key());
+    // Tasks still attached were cut short by cancellation
+    const bool cancelled = batch.cancel->load() || m_cancelling;
+    const auto indices = m_batchOfTask.keys();
+    for (int index : indices) {
+        if (m_batchOfTask.value(index) != batchId) continue;
+        m_batchOfTask.remove(index);
+        finishTask(index, cancelled ? TaskState::Cancelled : TaskState::Failed,
+                   cancelled ? QStringLiteral("Cancelled") : QStringLiteral("Conversion stopped before all files were written"));
+    }
+    schedule();
+}
+
+void MediaConverterWorker::startProcess(const Job& job, const QString& program, QStringList args)
+{
+    // Keep each tool within its share of the budget
+    QProcess* proc = new QProcess(this);
+    const bool isMagick = (program == m_magickPath);
+    if (isMagick) {
+        QProcessEnvironment env = QProcessEnvironment::systemEnvironment();
+        env.insert("MAGICK_THREAD_LIMIT", QString::number(job.cost));
+        proc->setProcessEnvironment(env);
+    } else {
+        args.insert(args.size() - 1, "-threads");
+        args.insert(args.size() - 1, QString::number(job.cost));
+    }
+
+    connect(proc, &QProcess::readyReadStandardOutput, this, [this, proc]{ onProcessOutput(proc); });
+    connect(proc, &QProcess::readyReadStandardError, this, [this, proc]{
+        emitTaskLog(m_jobs.value(proc).index, QString::fromUtf8(proc->readAllStandardError()));
+    });
+    connect(proc, &QProcess::errorOccurred, this, [this, proc](QProcess::ProcessError e){
+        if (e == QProcess::FailedToStart) onProcessError(proc);
+    });
+    connect(proc, qOverload<int,QProcess::ExitStatus>(&QProcess::finished), this, [this, proc](int code, QProcess::ExitStatus st){
+        onProcessFinished(proc, code, st);
+    });
+
+    m_jobs.insert(proc, job);
+    emitTaskLog(job.index, QString("%1 %2").arg(QFileInfo(program).fileName(), args.join(' ')));
+    proc->setProgram(program);
+    proc->setArguments(args);
+    proc->start();
+}
+
+void MediaConverterWorker::emitTaskLog(int index, const QString& text)
+{
+    if (text.isEmpty()) return;
+    emit taskLogLine(index, text);
+    emit logLine(QString("[%1/%2] %3").arg(index + 1).arg(m_tasks.size()).arg(text));
+}
+
+void MediaConverterWorker::onProcessOutput(QProcess* proc)
+{
+    const QString s = QString::fromUtf8(proc->readAllStandardOutput());
+    const Job job = m_jobs.value(proc);
+    if (job.index < 0) return;
+    emitTaskLog(job.index, s);
 
     // Parse -progress output
     // Prefer frame-based progress when total frames are known; otherwise fall back to time-based.
@@ -149,110 +702,176 @@ void MediaConverterWorker::onReadyStdOut()
         latestFrame = mm.captured(1).toInt();
     }
 
-    if (latestFrame >= 0 && m_estTotalFrames > 0) {
-        int percent = int(std::min<qint64>(qint64(latestFrame) * 100 / m_estTotalFrames, 100));
-        emit currentFileProgress(m_index, percent, latestFrame, m_estTotalFrames);
-        int overall = int(((double(m_index) + (percent/100.0)) / double(m_tasks.size())) * 100.0);
-        emit overallProgress(std::clamp(overall, 0, 100));
+    if (job.chunk == kConcatJob) return;
+    if (job.chunk >= 0) {
+        if (latestFrame < 0 || !m_segmented.contains(job.index)) return;
+        SegmentedTask& seg = m_segmented[job.index];
+        seg.chunks[job.chunk].framesDone = qMin<qint64>(latestFrame, seg.chunks[job.chunk].range.frames);
+        qint64 done = 0;
+        for (const Chunk& ch : std::as_const(seg.chunks)) done += ch.framesDone;
+        // The join is quick but not free; leave the last percent for it
+        const int percent = int(std::min<qint64>(done * 100 / qMax<qint64>(1, seg.totalFrames), 99));
+        m_percent[job.index] = percent;
+        emit currentFileProgress(job.index, percent, done, seg.totalFrames);
+        emitOverall();
+        return;
+    }
+
+    if (latestFrame >= 0 && job.estTotalFrames > 0) {
+        const int percent = int(std::min<qint64>(qint64(latestFrame) * 100 / job.estTotalFrames, 100));
+        m_percent[job.index] = percent;
+        emit currentFileProgress(job.index, percent, latestFrame, job.estTotalFrames);
+        emitOverall();
         return;
     }
 
     QRegularExpressionMatch m = rxTime.match(s);
-    if (m.hasMatch() && m_curDurationMs > 0) {
-        qint64 outMs = m.captured(1).toLongLong();
-        int percent = int(std::min<qint64>(outMs * 100 / m_curDurationMs, 100));
-        emit currentFileProgress(m_index, percent, outMs, m_curDurationMs);
-        int overall = int(((double(m_index) + (percent/100.0)) / double(m_tasks.size())) * 100.0);
-        emit overallProgress(std::clamp(overall, 0, 100));
+    if (m.hasMatch() && job.durationMs > 0) {
+        const qint64 outMs = m.captured(1).toLongLong();
+        const int percent = int(std::min<qint64>(outMs * 100 / job.durationMs, 100));
+        m_percent[job.index] = percent;
+        emit currentFileProgress(job.index, percent, outMs, job.durationMs);
+        emitOverall();
     }
 }
 
-void MediaConverterWorker::onReadyStdErr()
+void MediaConverterWorker::onProcessError(QProcess* proc)
 {
-    const QByteArray data = m_proc->readAllStandardError();
-    const QString s = QString::fromUtf8(data);
-    emit logLine(s);
+    // FailedToStart never reaches finished(); everything else does
+    if (!m_jobs.contains(proc)) return;
+    const Job job = m_jobs.take(proc);
+    m_usedBudget -= job.cost;
+    proc->deleteLater();
+    if (job.chunk != -1) {
+        onSegmentFinished(job, false, QString("Failed to start %1: %2").arg(proc->program(), proc->errorString()));
+        schedule();
+        return;
+    }
+    releaseOutput(job.index);
+    finishTask(job.index, m_states[job.index] == TaskState::Cancelled ? TaskState::Cancelled : TaskState::Failed,
+               QString("Failed to start %1: %2").arg(proc->program(), proc->errorString()));
+    schedule();
 }
 
-void MediaConverterWorker::onFinished(int exitCode, QProcess::ExitStatus status)
+void MediaConverterWorker::onProcessFinished(QProcess* proc, int exitCode, QProcess::ExitStatus status)
 {
+    if (!m_jobs.contains(proc)) return;
+    const Job job = m_jobs.take(proc);
+    m_usedBudget -= job.cost;
+    const QString rest = QString::fromUtf8(proc->readAllStandardError());
+    proc->deleteLater();
+
     const bool ok = (status == QProcess::NormalExit && exitCode == 0);
-    if (!ok && !m_cancelling) {
-        emit fileFinished(m_index, false, QString::fromUtf8(m_proc->readAllStandardError()));
-        // Pause queue and wait for UI decision (retry/skip/cancel)
-        m_waitingOnError = true;
+    if (job.chunk != -1) {
+        onSegmentFinished(job, ok, rest.isEmpty() ? QString("Exit code %1").arg(exitCode) : rest);
+        schedule();
         return;
     }
-    emit fileFinished(m_index, ok, QString());
-    overallProgress(int(double(m_index+1) / double(m_tasks.size()) * 100.0));
-    startNext();
+    releaseOutput(job.index);
+    if (m_states[job.index] == TaskState::Cancelled || (m_cancelling && !ok)) {
+        finishTask(job.index, TaskState::Cancelled, QStringLiteral("Cancelled"));
+    } else if (!ok) {
+        finishTask(job.index, TaskState::Failed, rest.isEmpty() ? QString("Exit code %1").arg(exitCode) : rest);
+    } else {
+        finishTask(job.index, TaskState::Succeeded, QString());
+    }
+    schedule();
+}
+
+void MediaConverterWorker::onSegmentFinished(const Job& job, bool ok, const QString& err)
+{
+    if (!m_segmented.contains(job.index)) return;
+    SegmentedTask& seg = m_segmented[job.index];
+    const bool cancelled = m_states[job.index] == TaskState::Cancelled || (m_cancelling && !ok);
+    if (cancelled) seg.cancelled = true;
+
+    if (job.chunk == kConcatJob) {
+        seg.concatRunning = false;
+        if (ok && !cancelled) {
+            emitTaskLog(job.index, QString("[Segments] Joined %1 chunks into %2").arg(seg.chunks.size()).arg(seg.outPath));
+            discardSegments(job.index);
+            finishTask(job.index, TaskState::Succeeded, QString());
+            return;
+        }
+        if (!cancelled) seg.error = err;
+        seg.aborting = true;
+    } else {
+        Chunk& ch = seg.chunks[job.chunk];
+        if (ok && !cancelled) {
+            ch.state = ChunkState::Done;
+            ch.framesDone = ch.range.frames;
+            return; // schedule() starts the next chunk, or the join
+        }
+        ch.state = ChunkState::Pending;
+        ch.framesDone = 0;
+        if (!cancelled && !seg.aborting && ++ch.attempts < kMaxChunkAttempts) {
+            emitTaskLog(job.index, QString("[Segments] Chunk %1 failed, retrying (%2/%3)").arg(job.chunk + 1).arg(ch.attempts + 1).arg(kMaxChunkAttempts));
+            return;
+        }
+        if (!seg.aborting) {
+            seg.aborting = true;
+            if (!cancelled) seg.error = QString("Chunk %1 failed: %2").arg(job.chunk + 1).arg(err);
+            const auto procs = m_jobs.keys();
+            for (QProcess* p : procs) if (m_jobs.value(p).index == job.index) p->kill();
+        }
+    }
+
+    if (hasJobs(job.index)) return; // report once the other chunks have stopped
+    if (seg.cancelled) {
+        discardSegments(job.index);
+        finishTask(job.index, TaskState::Cancelled, QStringLiteral("Cancelled"));
+        return;
+    }
+    // Keep the encoded chunks so retryTask only redoes what is missing
+    const QString error = seg.error;
+    seg.aborting = false;
+    seg.error.clear();
+    finishTask(job.index, TaskState::Failed, error);
+}
+
+void MediaConverterWorker::finishTask(int index, TaskState state, const QString& err)
+{
+    m_states[index] = state;
+    if (state == TaskState::Succeeded) m_percent[index] = 100;
+    emit fileFinished(index, state == TaskState::Succeeded, err);
+    emitOverall();
+}
+
+void MediaConverterWorker::emitOverall()
+{
+    if (m_tasks.isEmpty()) return;
+    // Finished tasks (any outcome) count as complete for queue progress
+    qint64 sum = 0;
+    for (int i = 0; i < m_states.size(); ++i) {
+        const bool terminal = m_states[i] == TaskState::Succeeded || m_states[i] == TaskState::Failed || m_states[i] == TaskState::Cancelled;
+        sum += terminal ? 100 : m_percent[i];
+    }
+    emit overallProgress(std::clamp(int(sum / m_tasks.size()), 0, 100));
 }
 
-QString MediaConverterWorker::uniqueOutPath(const QString& basePath)
+QString MediaConverterWorker::uniqueOutPath(const QString& basePath, const QSet<QString>& claimed)
 {
-    if (!QFileInfo::exists(basePath)) return basePath;
+    auto taken = [&claimed](const QString& p) { return claimed.contains(p) || QFileInfo::exists(p); };
+    if (!taken(basePath)) return basePath;
     QFileInfo fi(basePath);
     QString base = fi.completeBaseName();
     QString ext = fi.suffix();
     QString dir = fi.dir().absolutePath();
     for (int i=1;i<10000;++i) {
         QString cand = QDir(dir).filePath(QString("%1_%2.%3").arg(base).arg(i,3,10,QChar('0')).arg(ext));
-        if (!QFileInfo::exists(cand)) return cand;
+        if (!taken(cand)) return cand;
     }
     return basePath;
 }
 
-bool MediaConverterWorker::probeDurationMs(const QString& ffmpeg, const QString& input, qint64& durMs, int& w, int& h, QString& err)
+double MediaConverterWorker::probeAvgFps(const QString& input)
 {
-    durMs = 0; w = 0; h = 0;
-    // Use ffprobe next to ffmpeg if possible
-    QString ffprobe = QFileInfo(ffmpeg).dir().filePath("ffprobe.exe");
-    if (!QFileInfo::exists(ffprobe)) ffprobe = "ffprobe"; // try PATH
-
-    QProcess p; QStringList a;
-    a << "-v" << "error" << "-select_streams" << "v:0" << "-show_entries" << "stream=width,height" << "-of" << "default=nw=1:nk=1" << input;
-    p.start(ffprobe, a); p.waitForFinished(5000);
-    if (p.exitStatus() == QProcess::NormalExit && p.exitCode() == 0) {
-        QList<QByteArray> lines = p.readAllStandardOutput().split('\n');
-        if (lines.size() >= 2) {
-            bool ok1=false, ok2=false; w = QString::fromUtf8(lines[0]).trimmed().toInt(&ok1); h = QString::fromUtf8(lines[1]).trimmed().toInt(&ok2);
-            Q_UNUSED(ok1); Q_UNUSED(ok2);
-        }
-    }
-
-    QProcess p2; QStringList a2; a2 << "-v" << "error" << "-show_entries" << "format=duration" << "-of" << "default=nw=1:nk=1" << input;
-    p2.start(ffprobe, a2); p2.waitForFinished(5000);
-    if (p2.exitStatus() == QProcess::NormalExit && p2.exitCode() == 0) {
-        bool ok=false; double sec = QString::fromUtf8(p2.readAllStandardOutput()).trimmed().toDouble(&ok);
-        if (ok && sec > 0.0) durMs = qint64(sec * 1000.0);
-    }
-    return true;
-}
-
-double MediaConverterWorker::probeAvgFps(const QString& ffmpeg, const QString& input)
-{
-    // Use ffprobe to fetch avg_frame_rate as a rational (e.g., 30000/1001)
-    QString ffprobe = QFileInfo(ffmpeg).dir().filePath("ffprobe.exe");
-    if (!QFileInfo::exists(ffprobe)) ffprobe = "ffprobe";
-    QProcess p; QStringList a;
-    a << "-v" << "error" << "-select_streams" << "v:0" << "-show_entries" << "stream=avg_frame_rate" << "-of" << "default=nw=1:nk=1" << input;
-    p.start(ffprobe, a); p.waitForFinished(5000);
-    if (p.exitStatus() == QProcess::NormalExit && p.exitCode() == 0) {
-        const QString line = QString::fromUtf8(p.readAllStandardOutput()).trimmed();
-        const QStringList parts = line.split('/');
-        bool ok1=false, ok2=false;
-        if (parts.size() == 2) {
-            const double num = parts[0].toDouble(&ok1);
-            const double den = parts[1].toDouble(&ok2);
-            if (ok1 && ok2 && den > 0.0) return num / den;
-        }
-        double val = line.toDouble(&ok1);
-        if (ok1 && val > 0.0) return val;
-    }
-    return 0.0;
+    MediaProbeInfo info;
+    MediaProbeCache::instance().probe(input, info);
+    return info.fps;
 }
 
-qint64 MediaConverterWorker::countSequenceFrames(const QFileInfo& inFi, const QRegularExpressionMatch& mm, int pad)
+qint64 MediaConverterWorker::countSequenceFrames(const QFileInfo& inFi, const QRegularExpressionMatch& mm, int pad, qint64* lastOut)
 {
     // Optimized: find first and last existing frame using existence checks only
     // Assumes gaps are acceptable for progress estimation. Prioritizes speed over perfect accuracy.
@@ -307,10 +926,28 @@ qint64 MediaConverterWorker::countSequenceFrames(const QFileInfo& inFi, const QR
     if (lastKnownNonExist <= lastKnownExist) lastKnownNonExist = lastKnownExist + 1;
     const qint64 last = Utils::binarySearchLastTrue(lastKnownExist, lastKnownNonExist, existsFrame);
 
+    if (lastOut) *lastOut = qMax(last, curN);
     const qint64 total = (last >= first) ? (last - first + 1) : 1;
     return total;
 }
 
+bool MediaConverterWorker::isContiguousSequence(const QFileInfo& inFi, const QRegularExpressionMatch& mm, qint64 first, qint64 last)
+{
+    if (last < first) return false;
+    const QString name = inFi.fileName();
+    const QString pre = name.left(mm.capturedStart(1));
+    const QString post = name.mid(mm.capturedEnd(1));
+    const QRegularExpression rxFrame("^" + QRegularExpression::escape(pre) + "(\\d+)" + QRegularExpression::escape(post) + "$");
+    QSet<qint64> present;
+    for (const QString& entry : inFi.dir().entryList({pre + "*" + post}, QDir::Files)) {
+        const QRegularExpressionMatch fm = rxFrame.match(entry);
+        if (!fm.hasMatch()) continue;
+        const qint64 n = fm.captured(1).toLongLong();
+        if (n >= first && n <= last) present.insert(n);
+    }
+    return present.size() == last - first + 1;
+}
+
 QString MediaConverterWorker::scaleFilterFor(const Task& t, bool isVideo)
 {
     if (t.scaleWidth <= 0 && t.scaleHeight <= 0) return QString();
@@ -379,7 +1016,7 @@ bool MediaConverterWorker::buildCommand(const Task& t, QString& program, QString
             if (!t.tif.includeAlpha) args << "-alpha" << "off";
         }
 
-        if (t.conflict == ConflictAction::AutoRename) outPath = uniqueOutPath(outPath);
+        if (t.conflict == ConflictAction::AutoRename) outPath = uniqueOutPath(outPath, m_claimedOutputs);
         args << safePath(outPath);
         return true;
     }
@@ -389,9 +1026,12 @@ bool MediaConverterWorker::buildCommand(const Task& t, QString& program, QString
     program = m_ffmpegPath;
 
     bool isVideo = (t.target == TargetKind::VideoMP4 || t.target == TargetKind::VideoMOV);
+    const bool isSeqTarget = (t.target == TargetKind::JpgSequence || t.target == TargetKind::PngSequence || t.target == TargetKind::TifSequence);
 
-    // Probe duration for progress (videos)
-    int inW = 0, inH = 0; probeDurationMs(m_ffmpegPath, t.sourcePath, estDurationMs, inW, inH, err);
+    // Probe duration for progress (videos); header-only and cached, see MediaProbeCache
+    MediaProbeInfo probe;
+    MediaProbeCache::instance().probe(t.sourcePath, probe);
+    estDurationMs = probe.durationMs;
 
     // Input
     args << "-hide_banner" << "-nostdin" << "-y"; // allow overwrite handling below
@@ -399,8 +1039,10 @@ bool MediaConverterWorker::buildCommand(const Task& t, QString& program, QString
 
     // If converting to video and the input path looks like an image sequence (e.g., contains a trailing number),
     // construct a printf-style pattern and supply -start_number and -framerate before -i.
+    // Sequence targets the image engine cannot read land here too and need the whole sequence as input
     bool usedSequenceInput = false;
-    if (isVideo) {
+    QString seqBase = baseName;
+    if (isVideo || isSeqTarget) {
         const QString name = inFi.fileName();
         static QRegularExpression rxDigits("(\\d+)(?!.*\\d)"); // last run of digits
         QRegularExpressionMatch mm = rxDigits.match(name);
@@ -410,15 +1052,40 @@ bool MediaConverterWorker::buildCommand(const Task& t, QString& program, QString
         if (mm.hasMatch() && imgExts.contains(ext)) {
             const QString digits = mm.captured(1);
             const int pad = digits.length();
-            const int startNum = digits.toInt();
+            qint64 startNum = digits.toLongLong();
             QString pattFile = name;
             pattFile.replace(mm.capturedStart(1), pad, QString("%") + QString("0%1d").arg(pad));
             const QString pattPath = QDir(inFi.dir().absolutePath()).filePath(pattFile);
-            // -framerate must appear before -i
-            int fps = (t.target == TargetKind::VideoMP4) ? t.mp4.fps : t.mov.fps;
-            if (fps <= 0) fps = 24;
-            args << "-framerate" << QString::number(fps);
-            args << "-start_number" << QString::number(std::max(0, startNum));
+            if (isVideo) {
+                // -framerate must appear before -i
+                int fps = (t.target == TargetKind::VideoMP4) ? t.mp4.fps : t.mov.fps;
+                if (fps <= 0) fps = 24;
+                args << "-framerate" << QString::number(fps);
+            } else {
+                // Convert every frame like the image engine does: start at the lowest frame on disk.
+                // image2 stops at the first missing number, so a sequence with gaps would be cut short
+                const QString pre = name.left(mm.capturedStart(1));
+                const QString post = name.mid(mm.capturedEnd(1));
+                const QRegularExpression rxFrame("^" + QRegularExpression::escape(pre) + "(\\d+)" + QRegularExpression::escape(post) + "$");
+                qint64 first = startNum, last = startNum;
+                for (const QString& entry : inFi.dir().entryList({pre + "*" + post}, QDir::Files)) {
+                    const QRegularExpressionMatch fm = rxFrame.match(entry);
+                    if (!fm.hasMatch()) continue;
+                    const qint64 n = fm.captured(1).toLongLong();
+                    first = std::min(first, n);
+                    last = std::max(last, n);
+                }
+                if (!isContiguousSequence(inFi, mm, first, last)) {
+                    err = QString("Sequence has missing frames between %1 and %2: %3").arg(first).arg(last).arg(pattPath);
+                    return false;
+                }
+                startNum = first;
+                // Same folder and file names the image engine uses
+                seqBase = pre;
+                while (!seqBase.isEmpty() && QStringLiteral("._- ").contains(seqBase.back())) seqBase.chop(1);
+                if (seqBase.isEmpty()) seqBase = QStringLiteral("frame");
+            }
+            args << "-start_number" << QString::number(std::max<qint64>(0, startNum));
             args << "-i" << pattPath;
             usedSequenceInput = true;
         }
@@ -456,25 +1123,13 @@ bool MediaConverterWorker::buildCommand(const Task& t, QString& program, QString
         if (vcodec == "prores_ks") args << "-profile:v" << QString::number(t.mov.proresProfile);
 
         // Determine if we should preserve alpha and set appropriate pixel format
-        auto ffprobeHasAlpha = [&](const QString& inputPath)->bool {
-            QString ffprobe = QFileInfo(m_ffmpegPath).dir().filePath("ffprobe.exe");
-            if (!QFileInfo::exists(ffprobe)) ffprobe = "ffprobe";
-            QProcess p; QStringList a;
-            a << "-v" << "error" << "-select_streams" << "v:0" << "-show_entries" << "stream=pix_fmt" << "-of" << "default=nw=1:nk=1" << inputPath;
-            p.start(ffprobe, a); p.waitForFinished(4000);
-            if (p.exitStatus() == QProcess::NormalExit && p.exitCode() == 0) {
-                const QString pf = QString::fromUtf8(p.readAllStandardOutput()).trimmed().toLower();
-                if (pf.contains("rgba") || pf.contains("bgra") || pf.contains("argb") || pf.contains("abgr") || pf.contains("yuva") || pf.startsWith("ya")) return true;
-            }
-            return false;
-        };
         bool inputHasAlpha = false;
         if (usedSequenceInput) {
             const QString ext = inFi.suffix().toLower();
             static const QSet<QString> alphaImgs = {"png","tif","tiff","exr","psd"};
             inputHasAlpha = alphaImgs.contains(ext);
         } else {
-            inputHasAlpha = ffprobeHasAlpha(inFi.absoluteFilePath());
+            inputHasAlpha = probe.hasAlpha;
         }
         const bool alphaCapable = ((vcodec == "prores_ks" && t.mov.proresProfile == 4) || (vcodec == "qtrle"));
         if (alphaCapable && inputHasAlpha) {
@@ -485,22 +1140,22 @@ bool MediaConverterWorker::buildCommand(const Task& t, QString& program, QString
         outPath = QDir(outDir).filePath(baseName + ".mov");
     } else if (t.target == TargetKind::JpgSequence) {
         // Create subfolder
-        QString seqDir = QDir(outDir).filePath(baseName + "_jpg_seq"); QDir().mkpath(seqDir);
+        QString seqDir = QDir(outDir).filePath(seqBase + "_jpg_seq"); QDir().mkpath(seqDir);
         const QString pat = QString("%") + QString("0%1d").arg(std::clamp(t.jpgSeq.padDigits,1,8));
-        outPath = QDir(seqDir).filePath(baseName + "_" + pat + ".jpg");
+        outPath = QDir(seqDir).filePath(seqBase + "_" + pat + ".jpg");
         args << "-start_number" << QString::number(std::max(0, t.jpgSeq.startNumber));
         args << "-qscale:v" << QString::number(std::clamp(t.jpgSeq.qscale, 2, 31));
     } else if (t.target == TargetKind::PngSequence) {
-        QString seqDir = QDir(outDir).filePath(baseName + "_png_seq"); QDir().mkpath(seqDir);
+        QString seqDir = QDir(outDir).filePath(seqBase + "_png_seq"); QDir().mkpath(seqDir);
         const QString pat = QString("%") + QString("0%1d").arg(std::clamp(t.pngSeq.padDigits,1,8));
-        outPath = QDir(seqDir).filePath(baseName + "_" + pat + ".png");
+        outPath = QDir(seqDir).filePath(seqBase + "_" + pat + ".png");
         args << "-start_number" << QString::number(std::max(0, t.pngSeq.startNumber));
         if (t.pngSeq.includeAlpha) args << "-pix_fmt" << "rgba"; else args << "-pix_fmt" << "rgb24";
         args << "-compression_level" << "9";
     } else if (t.target == TargetKind::TifSequence) {
-        QString seqDir = QDir(outDir).filePath(baseName + "_tif_seq"); QDir().mkpath(seqDir);
+        QString seqDir = QDir(outDir).filePath(seqBase + "_tif_seq"); QDir().mkpath(seqDir);
         const QString pat = QString("%") + QString("0%1d").arg(std::clamp(t.tifSeq.padDigits,1,8));
-        outPath = QDir(seqDir).filePath(baseName + "_" + pat + ".tif");
+        outPath = QDir(seqDir).filePath(seqBase + "_" + pat + ".tif");
         args << "-start_number" << QString::number(std::max(0, t.tifSeq.startNumber));
         args << "-c:v" << "tiff";
         if (!t.tifSeq.compression.isEmpty()) args << "-compression_algo" << t.tifSeq.compression.toLower();
@@ -511,7 +1166,7 @@ bool MediaConverterWorker::buildCommand(const Task& t, QString& program, QString
     // an exact printf-style pattern like filename_%05d.ext; adding suffixes breaks it.
     if (t.conflict == ConflictAction::AutoRename) {
         const bool isSeq = (t.target == TargetKind::JpgSequence || t.target == TargetKind::PngSequence || t.target == TargetKind::TifSequence);
-        if (!isSeq) outPath = uniqueOutPath(outPath);
+        if (!isSeq) outPath = uniqueOutPath(outPath, m_claimedOutputs);
     }
     // For Overwrite we rely on -y above; for Skip handled earlier
 
@@ -5,6 +5,13 @@
 #include <QVector>
 #include <QStringList>
 #include <QElapsedTimer>
+#include <QHash>
+#include <QSet>
+#include <QFuture>
+#include <atomic>
+#include <memory>
+
+#include "image_convert_engine.h"
 
 class QFileInfo;
 class QRegularExpressionMatch;
@@ -42,6 +49,7 @@ public:
         int scaleWidth = 0;
         int scaleHeight = 0;
         bool forceEven = true; // make dims divisible by 2 for video
+        bool allowSegments = true; // long image sequences -> video may encode as parallel chunks
         ConflictAction conflict = ConflictAction::AutoRename;
         // Per-target options
         OptionsMP4 mp4;
@@ -55,15 +63,40 @@ public:
     };
 
     explicit MediaConverterWorker(QObject* parent=nullptr);
+    ~MediaConverterWorker() override;
 
     void setFfmpegPath(const QString& path) { m_ffmpegPath = path; }
     void setMagickPath(const QString& path) { m_magickPath = path; }
 
+    // Conversions run concurrently within a CPU budget (in cores). Each task is
+    // charged taskCost() cores and its tool is told to use that many threads, so
+    // cheap JPEG exports run many-at-once while an HEVC encode gets most of the box.
+    void setCpuBudget(int cores) { m_budget = qMax(1, cores); }
+    static int defaultCpuBudget(); // QSettings MediaConverter/CpuBudget, default QThread::idealThreadCount()
+    static int taskCost(const Task& t, int budget);
+
+    // Long image sequences going to video are cut into GOP-aligned chunks that
+    // encode as separate jobs within the budget, then join losslessly with the
+    // concat demuxer (stream copy). A failed chunk is retried on its own.
+    struct Segment { qint64 startNumber = 0; qint64 frames = 0; };
+    // Empty when the range is too short to be worth splitting or only one job fits
+    static QVector<Segment> planSegments(qint64 startNumber, qint64 totalFrames, int gop, int parallelJobs);
+    // Only sequences where every frame number in [first, last] exists are segmented.
+    // mm matches the frame digits in inFi's name; one directory listing.
+    static bool isContiguousSequence(const QFileInfo& inFi, const QRegularExpressionMatch& mm, qint64 first, qint64 last);
+
+    // Still-image targets, and image sequences going to an image sequence, convert
+    // in process through ImageConvertEngine; consecutive tasks are batched into one
+    // pipeline. ImageMagick/FFmpeg are only needed for what the engine cannot read.
+    static bool usesImageEngine(const Task& t);
+    static ImageConvertEngine::Options engineOptions(const Task& t);
 
 signals:
     void queueStarted(int total);
     void fileStarted(int index, const QString& srcPath, const QString& outPath, qint64 durationMs);
     void logLine(const QString& line);
+    // Tool output of one task; logLine carries the same text prefixed with the task number
+    void taskLogLine(int index, const QString& line);
     void currentFileProgress(int index, int percent, qint64 outTimeMs, qint64 totalMs);
     void overallProgress(int percent);
     void fileFinished(int index, bool success, const QString& errorMsg);
@@ -72,37 +105,105 @@ signals:
 public slots:
     void start(const QVector<Task>& tasks);
     void cancelAll();
-    void retryCurrent();
-    void continueAfterFailure();
-
-private slots:
-    void onReadyStdOut();
-    void onReadyStdErr();
-    void onFinished(int exitCode, QProcess::ExitStatus status);
+    // Per-task control: a failed task does not stall the queue; retry re-queues it
+    void cancelTask(int index);
+    void retryTask(int index);
 
 private:
+    enum class TaskState { Pending, Running, Succeeded, Failed, Cancelled };
+    struct Job {
+        int index = -1;
+        int cost = 1;
+        qint64 durationMs = 0;
+        qint64 estTotalFrames = 0;
+        int chunk = -1; // >= 0: one chunk of a segmented task; kConcatJob: the final join
+    };
+    static constexpr int kConcatJob = -2;
+
+    enum class ChunkState { Pending, Running, Done };
+    struct Chunk {
+        Segment range;
+        QString path;
+        ChunkState state = ChunkState::Pending;
+        int attempts = 0;
+        qint64 framesDone = 0;
+    };
+    struct SegmentedTask {
+        QString program;
+        QStringList baseArgs;  // the single-process command; chunks are derived from it
+        QString outPath;
+        QString chunkDir;
+        int gop = 1;
+        qint64 totalFrames = 0;
+        QVector<Chunk> chunks;
+        bool concatRunning = false;
+        bool aborting = false; // a chunk gave up or the task was cancelled; waiting for the rest to stop
+        bool cancelled = false;
+        QString error;
+    };
+
     // Build external command (ffmpeg or ImageMagick) and compute output path for given task
     bool buildCommand(const Task& t, QString& program, QString& outPath, QStringList& args, qint64& estDurationMs, QString& err) const;
-    static bool probeDurationMs(const QString& ffmpeg, const QString& input, qint64& durMs, int& width, int& height, QString& err);
-    static QString uniqueOutPath(const QString& basePath);
+    // First of basePath, base_001.ext, ... that neither exists nor is claimed by another task
+    static QString uniqueOutPath(const QString& basePath, const QSet<QString>& claimed);
     static QString scaleFilterFor(const Task& t, bool isVideo);
-    static double probeAvgFps(const QString& ffmpeg, const QString& input);
-    static qint64 countSequenceFrames(const QFileInfo& inFi, const QRegularExpressionMatch& mm, int pad);
-
-
-    void startNext();
+    static double probeAvgFps(const QString& input);
+    static qint64 countSequenceFrames(const QFileInfo& inFi, const QRegularExpressionMatch& mm, int pad, qint64* lastOut = nullptr);
+    static int segmentGop(const QStringList& args, int fps);
+    static QStringList segmentArgs(const QStringList& baseArgs, const Segment& range, int gop, const QString& chunkPath);
+
+    void schedule();
+    bool launch(int index);
+    bool beginSegmented(int index, const QString& program, const QString& outPath, const QStringList& args, qint64 firstFrame, qint64 frames);
+    bool launchChunks(int index);
+    void startProcess(const Job& job, const QString& program, QStringList args);
+    void onSegmentFinished(const Job& job, bool ok, const QString& err);
+    void discardSegments(int index);
+    void claimOutput(int index, const QString& outPath);
+    void releaseOutput(int index);
+    bool hasJobs(int index) const;
+    bool anyRunning() const { return !m_jobs.isEmpty() || !m_batches.isEmpty(); }
+    bool engineItems(const Task& t, QVector<ImageConvertEngine::Item>& items, QString& outPath, QSet<QString>& reserved, QString& err) const;
+    void launchEngineBatch(int firstIndex);
+    void onEngineResult(int batchId, const ImageConvertEngine::Result& r);
+    void onEngineBatchFinished(int batchId);
+    void onProcessOutput(QProcess* proc);
+    void onProcessError(QProcess* proc);
+    void onProcessFinished(QProcess* proc, int exitCode, QProcess::ExitStatus status);
+    void finishTask(int index, TaskState state, const QString& err);
+    void emitOverall();
+    void emitTaskLog(int index, const QString& text);
 
     QString m_magickPath;
 
 private:
     QString m_ffmpegPath;
     QVector<Task> m_tasks;
-    int m_index = -1;
-    QProcess* m_proc = nullptr;
+    QVector<TaskState> m_states;
+    QVector<int> m_percent;
+    QHash<QProcess*, Job> m_jobs;
+    QHash<int, SegmentedTask> m_segmented;
+
+    struct EngineBatch {
+        int cost = 1;
+        std::shared_ptr<std::atomic_bool> cancel;
+        QFuture<void> future;
+        QVector<ImageConvertEngine::Item> items;
+        QHash<int, int> total;     // task index -> items
+        QHash<int, int> remaining;
+        QHash<int, int> failed;
+        QHash<int, QString> firstError;
+    };
+    QHash<int, EngineBatch> m_batches; // by batch id
+    QHash<int, int> m_batchOfTask;     // running task index -> batch id
+    int m_nextBatchId = 0;
+    // Outputs of tasks that are running (or hold encoded chunks for a retry). Tasks in the
+    // same folder with the same base name would otherwise pick the same free name and
+    // overwrite each other, since nothing is on disk until a task writes it.
+    QSet<QString> m_claimedOutputs;
+    QHash<int, QString> m_outputOfTask;
+    int m_budget = 1;
+    int m_usedBudget = 0;
     bool m_cancelling = false;
-    bool m_waitingOnError = false;
-    qint64 m_curDurationMs = 0;
-    qint64 m_estTotalFrames = 0;
-    QElapsedTimer m_timer;
+    bool m_queueActive = false;
 };
-
@@ -0,0 +1,665 @@
+#include "media_probe_cache.h"
+
+#include <QDataStream>
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QProcess>
+#include <QSaveFile>
+#include <QStandardPaths>
+
+#include <algorithm>
+
+#if defined(HAVE_FFMPEG) && HAVE_FFMPEG
+extern "C" {
+#include <libavformat/avformat.h>
+#include <libavcodec/avcodec.h>
+#include <libavutil/avutil.h>
+#include <libavutil/log.h>
+#include <libavutil/pixdesc.h>
+}
+#endif
+
+namespace {
+
+constexpr quint32 kCacheMagic = 0x4b4d5043; // "KMPC"
+constexpr quint32 kCacheVersion = 2;       // 2: keyframe indexes
+constexpr quint32 kCacheVersionNoIndex = 1; // still readable, entries come back without keyframes
+constexpr int kMaxEntries = 50000;
+constexpr int kSaveEvery = 64; // new entries between automatic saves
+
+void normalizeKeyframes(KeyframeIndex& index)
+{
+    std::sort(index.keyframesMs.begin(), index.keyframesMs.end());
+    index.keyframesMs.erase(std::unique(index.keyframesMs.begin(), index.keyframesMs.end()), index.keyframesMs.end());
+}
+
+#if defined(HAVE_FFMPEG) && HAVE_FFMPEG
+QString profileName(const AVCodecParameters* vp)
+{
+    QString name;
+    if (vp->profile != FF_PROFILE_UNKNOWN) {
+        switch (vp->codec_id) {
+            case AV_CODEC_ID_H264:
+                switch (vp->profile) {
+                    case FF_PROFILE_H264_BASELINE: name = "Baseline"; break;
+                    case FF_PROFILE_H264_MAIN:     name = "Main"; break;
+                    case FF_PROFILE_H264_HIGH:     name = "High"; break;
+                    case FF_PROFILE_H264_HIGH_10:  name = "High10"; break;
+                    case FF_PROFILE_H264_HIGH_422: name = "High 4:2:2"; break;
+                    case FF_PROFILE_H264_HIGH_444: name = "High 4:4:4"; break;
+                    default: break;
+                }
+                break;
+            case AV_CODEC_ID_HEVC:
+                switch (vp->profile) {
+                    case FF_PROFILE_HEVC_MAIN:    name = "Main"; break;
+                    case FF_PROFILE_HEVC_MAIN_10: name = "Main 10"; break;
+                    case FF_PROFILE_HEVC_REXT:    name = "RExt"; break;
+                    default: break;
+                }
+                break;
+            case AV_CODEC_ID_PRORES:
+                switch (vp->profile) {
+                    case FF_PROFILE_PRORES_PROXY:    name = "Proxy"; break;
+                    case FF_PROFILE_PRORES_LT:       name = "LT"; break;
+                    case FF_PROFILE_PRORES_STANDARD: name = "422"; break;
+                    case FF_PROFILE_PRORES_HQ:       name = "422 HQ"; break;
+                    case FF_PROFILE_PRORES_4444:     name = "4444"; break;
+                    case FF_PROFILE_PRORES_XQ:       name = "4444 XQ"; break;
+                    default: break;
+                }
+                break;
+            case AV_CODEC_ID_DNXHD:
+                switch (vp->profile) {
+                    case FF_PROFILE_DNXHD:       name = "DNxHD"; break;
+                    case FF_PROFILE_DNXHR_LB:    name = "DNxHR LB"; break;
+                    case FF_PROFILE_DNXHR_SQ:    name = "DNxHR SQ"; break;
+                    case FF_PROFILE_DNXHR_HQ:    name = "DNxHR HQ"; break;
+                    case FF_PROFILE_DNXHR_HQX:   name = "DNxHR HQX"; break;
+                    case FF_PROFILE_DNXHR_444:   name = "DNxHR 444"; break;
+                    default: break;
+                }
+                break;
+            case AV_CODEC_ID_MPEG2VIDEO:
+                switch (vp->profile) {
+                    case FF_PROFILE_MPEG2_SIMPLE: name = "Simple"; break;
+                    case FF_PROFILE_MPEG2_MAIN:   name = "Main"; break;
+                    case FF_PROFILE_MPEG2_HIGH:   name = "High"; break;
+                    case FF_PROFILE_MPEG2_422:    name = "4:2:2"; break;
+                    default: break;
+                }
+                break;
+            case AV_CODEC_ID_MPEG4:
+                switch (vp->profile) {
+                    case FF_PROFILE_MPEG4_SIMPLE:          name = "Simple"; break;
+                    case FF_PROFILE_MPEG4_MAIN:            name = "Main"; break;
+                    case FF_PROFILE_MPEG4_ADVANCED_SIMPLE: name = "Advanced Simple"; break;
+                    default: break;
+                }
+                break;
+            case AV_CODEC_ID_VP9:
+                switch (vp->profile) {
+                    case FF_PROFILE_VP9_0: name = "Profile 0"; break;
+                    case FF_PROFILE_VP9_1: name = "Profile 1"; break;
+                    case FF_PROFILE_VP9_2: name = "Profile 2"; break;
+                    case FF_PROFILE_VP9_3: name = "Profile 3"; break;
+                    default: break;
+                }
+                break;
+            case AV_CODEC_ID_AV1:
+                switch (vp->profile) {
+                    case FF_PROFILE_AV1_MAIN:         name = "Main"; break;
+                    case FF_PROFILE_AV1_HIGH:         name = "High"; break;
+                    case FF_PROFILE_AV1_PROFESSIONAL: name = "Professional"; break;
+                    default: break;
+                }
+                break;
+            default:
+                break;
+        }
+    }
+    return name;
+}
+
+bool probeWithAvformat(const QString& filePath, MediaProbeInfo& out, QString* errorOut)
+{
+    // Reduce FFmpeg logging noise
+    static bool logLevelSet = false;
+    if (!logLevelSet) {
+        av_log_set_level(AV_LOG_ERROR);
+        logLevelSet = true;
+    }
+
+    AVFormatContext* fmtCtx = nullptr;
+    const QByteArray localPath = QFile::encodeName(filePath);
+    int ret = avformat_open_input(&fmtCtx, localPath.constData(), nullptr, nullptr);
+    if (ret < 0) {
+        if (errorOut) *errorOut = QString("avformat_open_input failed (%1)").arg(ret);
+        return false;
+    }
+
+    // Most containers (MOV/MP4/MKV/MXF) carry everything we need in the header.
+    // Only analyse packets when they don't, and then keep the analysis short.
+    auto headerComplete = [&]() {
+        const int v = av_find_best_stream(fmtCtx, AVMEDIA_TYPE_VIDEO, -1, -1, nullptr, 0);
+        if (v < 0) return fmtCtx->nb_streams > 0 && fmtCtx->duration > 0; // audio-only
+        const AVCodecParameters* p = fmtCtx->streams[v]->codecpar;
+        return p->codec_id != AV_CODEC_ID_NONE && p->width > 0 && p->height > 0 && p->format >= 0
+            && (fmtCtx->duration > 0 || fmtCtx->streams[v]->duration > 0);
+    };
+    if (!headerComplete()) {
+        fmtCtx->probesize = 5 * 1024 * 1024;
+        fmtCtx->max_analyze_duration = 2 * AV_TIME_BASE;
+        ret = avformat_find_stream_info(fmtCtx, nullptr);
+        if (ret < 0) {
+            if (errorOut) *errorOut = QString("avformat_find_stream_info failed (%1)").arg(ret);
+            avformat_close_input(&fmtCtx);
+            return false;
+        }
+    }
+
+    if (fmtCtx->bit_rate > 0) out.bitrate = fmtCtx->bit_rate;
+    if (fmtCtx->duration > 0) out.durationMs = fmtCtx->duration / (AV_TIME_BASE / 1000);
+
+    const int vIdx = av_find_best_stream(fmtCtx, AVMEDIA_TYPE_VIDEO, -1, -1, nullptr, 0);
+    const int aIdx = av_find_best_stream(fmtCtx, AVMEDIA_TYPE_AUDIO, -1, -1, nullptr, 0);
+
+    if (vIdx >= 0) {
+        AVStream* vs = fmtCtx->streams[vIdx];
+        const AVCodecParameters* vp = vs->codecpar;
+        const AVCodec* vcodec = avcodec_find_decoder(vp->codec_id);
+        const char* vname = vcodec && vcodec->name ? vcodec->name : avcodec_get_name(vp->codec_id);
+        if (vname) out.videoCodec = QString::fromUtf8(vname);
+        out.videoProfile = profileName(vp);
+        out.width = vp->width;
+        out.height = vp->height;
+        if (vp->format >= 0) {
+            const AVPixFmtDescriptor* desc = av_pix_fmt_desc_get(static_cast<AVPixelFormat>(vp->format));
+            if (desc) {
+                out.pixelFormat = QString::fromUtf8(desc->name);
+                out.hasAlpha = (desc->flags & AV_PIX_FMT_FLAG_ALPHA) != 0;
+            }
+        }
+        const AVRational fr = vs->avg_frame_rate.num && vs->avg_frame_rate.den ? vs->avg_frame_rate : vs->r_frame_rate;
+        if (fr.num > 0 && fr.den > 0) out.fps = double(fr.num) / double(fr.den);
+        if (out.durationMs <= 0 && vs->duration > 0) out.durationMs = qint64(vs->duration * av_q2d(vs->time_base) * 1000.0);
+        if (out.bitrate <= 0 && vp->bit_rate > 0) out.bitrate = vp->bit_rate;
+
+        AVDictionaryEntry* tc = av_dict_get(vs->metadata, "timecode", nullptr, 0);
+        if (!tc) tc = av_dict_get(fmtCtx->metadata, "timecode", nullptr, 0);
+        if (tc && tc->value) out.timecodeStart = QString::fromUtf8(tc->value);
+    }
+
+    if (aIdx >= 0) {
+        const AVCodecParameters* ap = fmtCtx->streams[aIdx]->codecpar;
+        const AVCodec* acodec = avcodec_find_decoder(ap->codec_id);
+        const char* aname = acodec && acodec->name ? acodec->name : avcodec_get_name(ap->codec_id);
+        if (aname) out.audioCodec = QString::fromUtf8(aname);
+        if (out.bitrate <= 0 && ap->bit_rate > 0) out.bitrate = ap->bit_rate; // audio-only files
+    }
+
+    avformat_close_input(&fmtCtx);
+    out.valid = (vIdx >= 0 || aIdx >= 0);
+    if (!out.valid && errorOut) *errorOut = QStringLiteral("No audio or video streams");
+    return out.valid;
+}
+
+bool indexWithAvformat(const QString& filePath, KeyframeIndex& out, QString* errorOut)
+{
+    AVFormatContext* fmtCtx = nullptr;
+    const QByteArray localPath = QFile::encodeName(filePath);
+    int ret = avformat_open_input(&fmtCtx, localPath.constData(), nullptr, nullptr);
+    if (ret < 0) {
+        if (errorOut) *errorOut = QString("avformat_open_input failed (%1)").arg(ret);
+        return false;
+    }
+    const int vIdx = av_find_best_stream(fmtCtx, AVMEDIA_TYPE_VIDEO, -1, -1, nullptr, 0);
+    if (vIdx < 0) {
+        if (errorOut) *errorOut = QStringLiteral("No video stream");
+        avformat_close_input(&fmtCtx);
+        return false;
+    }
+    AVStream* vs = fmtCtx->streams[vIdx];
+    const qint64 startTs = vs->start_time != AV_NOPTS_VALUE ? vs->start_time : 0;
+    auto toMs = [&](int64_t ts) { return qint64(av_rescale_q(ts - startTs, vs->time_base, AVRational{1, 1000})); };
+
+    // Intra-only codecs can be cut anywhere; no need to read the file
+    const AVCodecDescriptor* desc = avcodec_descriptor_get(vs->codecpar->codec_id);
+    if (desc && (desc->props & AV_CODEC_PROP_INTRA_ONLY)) {
+        out.valid = true;
+        out.allIntra = true;
+        avformat_close_input(&fmtCtx);
+        return true;
+    }
+
+#if LIBAVFORMAT_VERSION_INT >= AV_VERSION_INT(58, 78, 100)
+    // MOV/MP4 build a full sample index from the header and MKV loads its cues;
+    // either one lists real keyframes without touching the packets
+    const int entries = avformat_index_get_entries_count(vs);
+    if (entries > 1) {
+        for (int i = 0; i < entries; ++i) {
+            const AVIndexEntry* e = avformat_index_get_entry(vs, i);
+            if (e && (e->flags & AVINDEX_KEYFRAME) && e->timestamp != AV_NOPTS_VALUE) {
+                out.keyframesMs.append(toMs(e->timestamp));
+            }
+        }
+    }
+#endif
+
+    if (out.keyframesMs.isEmpty()) {
+        // No usable index (MPEG-TS, raw streams): walk the video packets once
+        for (unsigned i = 0; i < fmtCtx->nb_streams; ++i) {
+            if (int(i) != vIdx) fmtCtx->streams[i]->discard = AVDISCARD_ALL;
+        }
+        AVPacket* pkt = av_packet_alloc();
+        while (pkt && av_read_frame(fmtCtx, pkt) >= 0) {
+            if (pkt->stream_index == vIdx && (pkt->flags & AV_PKT_FLAG_KEY)) {
+                const int64_t ts = pkt->pts != AV_NOPTS_VALUE ? pkt->pts : pkt->dts;
+                if (ts != AV_NOPTS_VALUE) out.keyframesMs.append(toMs(ts));
+            }
+            av_packet_unref(pkt);
+        }
+        av_packet_free(&pkt);
+    }
+    avformat_close_input(&fmtCtx);
+
+    normalizeKeyframes(out);
+    out.valid = !out.keyframesMs.isEmpty();
+    if (!out.valid && errorOut) *errorOut = QStringLiteral("No keyframes found");
+    return out.valid;
+}
+#else
+bool pixelFormatHasAlpha(const QString& pf)
+{
+    const QString p = pf.toLower();
+    return p.contains("rgba") || p.contains("bgra") || p.contains("argb") || p.contains("abgr")
+        || p.contains("yuva") || p.startsWith("ya") || p.startsWith("gbrap");
+}
+
+double parseRate(const QString& rate)
+{
+    const QStringList parts = rate.split('/');
+    bool ok1 = false, ok2 = false;
+    if (parts.size() == 2) {
+        const double num = parts[0].toDouble(&ok1);
+        const double den = parts[1].toDouble(&ok2);
+        if (ok1 && ok2 && den > 0.0) return num / den;
+        return 0.0;
+    }
+    const double v = rate.toDouble(&ok1);
+    return ok1 && v > 0.0 ? v : 0.0;
+}
+
+bool probeWithFfprobe(const QString& filePath, const QString& ffprobePath, MediaProbeInfo& out, QString* errorOut)
+{
+    // One process per file, everything in a single JSON document
+    QProcess p;
+    p.start(ffprobePath.isEmpty() ? QStringLiteral("ffprobe") : ffprobePath,
+            {"-v", "error", "-show_entries",
+             "format=duration,bit_rate:format_tags=timecode:stream=codec_type,codec_name,profile,width,height,"
+             "avg_frame_rate,r_frame_rate,pix_fmt,bit_rate:stream_tags=timecode",
+             "-of", "json", filePath});
+    if (!p.waitForFinished(10000) || p.exitStatus() != QProcess::NormalExit || p.exitCode() != 0) {
+        if (errorOut) *errorOut = QString("ffprobe failed for %1").arg(filePath);
+        p.kill();
+        return false;
+    }
+    const QJsonObject root = QJsonDocument::fromJson(p.readAllStandardOutput()).object();
+    const QJsonObject format = root.value("format").toObject();
+    out.durationMs = qint64(format.value("duration").toString().toDouble() * 1000.0);
+    out.bitrate = format.value("bit_rate").toString().toLongLong();
+    out.timecodeStart = format.value("tags").toObject().value("timecode").toString();
+
+    bool haveVideo = false, haveAudio = false;
+    for (const QJsonValue& v : root.value("streams").toArray()) {
+        const QJsonObject s = v.toObject();
+        const QString type = s.value("codec_type").toString();
+        if (type == "video" && !haveVideo) {
+            haveVideo = true;
+            out.videoCodec = s.value("codec_name").toString();
+            out.videoProfile = s.value("profile").toString();
+            out.width = s.value("width").toInt();
+            out.height = s.value("height").toInt();
+            out.pixelFormat = s.value("pix_fmt").toString();
+            out.hasAlpha = pixelFormatHasAlpha(out.pixelFormat);
+            out.fps = parseRate(s.value("avg_frame_rate").toString());
+            if (out.fps <= 0.0) out.fps = parseRate(s.value("r_frame_rate").toString());
+            if (out.bitrate <= 0) out.bitrate = s.value("bit_rate").toString().toLongLong();
+            const QString tc = s.value("tags").toObject().value("timecode").toString();
+            if (!tc.isEmpty()) out.timecodeStart = tc;
+        } else if (type == "audio" && !haveAudio) {
+            haveAudio = true;
+            out.audioCodec = s.value("codec_name").toString();
+            if (out.bitrate <= 0) out.bitrate = s.value("bit_rate").toString().toLongLong();
+        }
+    }
+    out.valid = haveVideo || haveAudio;
+    if (!out.valid && errorOut) *errorOut = QStringLiteral("No audio or video streams");
+    return out.valid;
+}
+
+bool indexWithFfprobe(const QString& filePath, const QString& ffprobePath, KeyframeIndex& out, QString* errorOut)
+{
+    // Packet headers only; nothing is decoded
+    QProcess p;
+    p.start(ffprobePath.isEmpty() ? QStringLiteral("ffprobe") : ffprobePath,
+            {"-v", "error", "-select_streams", "v:0", "-show_entries", "packet=pts_time,dts_time,flags",
+             "-of", "csv=p=0", filePath});
+    if (!p.waitForFinished(120000) || p.exitStatus() != QProcess::NormalExit || p.exitCode() != 0) {
+        if (errorOut) *errorOut = QString("ffprobe failed for %1").arg(filePath);
+        p.kill();
+        return false;
+    }
+    int packets = 0;
+    double firstTime = -1.0;
+    QVector<double> keyTimes;
+    const QList<QByteArray> lines = p.readAllStandardOutput().split('\n');
+    for (const QByteArray& line : lines) {
+        const QList<QByteArray> fields = line.trimmed().split(',');
+        if (fields.size() < 3) continue;
+        bool ok = false;
+        double t = fields[0].toDouble(&ok);
+        if (!ok) t = fields[1].toDouble(&ok);
+        if (!ok) continue;
+        ++packets;
+        if (firstTime < 0.0 || t < firstTime) firstTime = t;
+        if (fields[2].contains('K')) keyTimes.append(t);
+    }
+    if (packets == 0) {
+        if (errorOut) *errorOut = QStringLiteral("No video packets");
+        return false;
+    }
+    out.valid = true;
+    if (keyTimes.size() == packets) {
+        out.allIntra = true;
+        return true;
+    }
+    for (double t : keyTimes) out.keyframesMs.append(qint64((t - firstTime) * 1000.0 + 0.5));
+    normalizeKeyframes(out);
+    return true;
+}
+#endif
+
+QDataStream& operator<<(QDataStream& s, const MediaProbeInfo& i)
+{
+    return s << i.valid << i.durationMs << i.width << i.height << i.fps << i.videoCodec << i.videoProfile
+             << i.pixelFormat << i.hasAlpha << i.audioCodec << i.bitrate << i.timecodeStart;
+}
+
+QDataStream& operator>>(QDataStream& s, MediaProbeInfo& i)
+{
+    return s >> i.valid >> i.durationMs >> i.width >> i.height >> i.fps >> i.videoCodec >> i.videoProfile
+             >> i.pixelFormat >> i.hasAlpha >> i.audioCodec >> i.bitrate >> i.timecodeStart;
+}
+
+QDataStream& operator<<(QDataStream& s, const KeyframeIndex& k)
+{
+    return s << k.valid << k.allIntra << k.keyframesMs;
+}
+
+QDataStream& operator>>(QDataStream& s, KeyframeIndex& k)
+{
+    return s >> k.valid >> k.allIntra >> k.keyframesMs;
+}
+
+} // namespace
+
+qint64 KeyframeIndex::nearest(qint64 ms) const
+{
+    if (allIntra || keyframesMs.isEmpty()) return ms;
+    auto it = std::lower_bound(keyframesMs.constBegin(), keyframesMs.constEnd(), ms);
+    if (it == keyframesMs.constEnd()) return keyframesMs.last();
+    if (it == keyframesMs.constBegin()) return *it;
+    const qint64 after = *it;
+    const qint64 before = *(it - 1);
+    return (ms - before) <= (after - ms) ? before : after;
+}
+
+qint64 KeyframeIndex::atOrBefore(qint64 ms) const
+{
+    if (allIntra || keyframesMs.isEmpty()) return -1;
+    auto it = std::upper_bound(keyframesMs.constBegin(), keyframesMs.constEnd(), ms);
+    return it == keyframesMs.constBegin() ? keyframesMs.first() : *(it - 1);
+}
+
+MediaProbeCache& MediaProbeCache::instance()
+{
+    static MediaProbeCache inst;
+    return inst;
+}
+
+MediaProbeCache::~MediaProbeCache()
+{
+    QMutexLocker lk(&m_mutex);
+    if (m_unsaved > 0) saveLocked();
+}
+
+bool MediaProbeCache::probeFile(const QString& filePath, MediaProbeInfo& out, QString* errorOut, const QString& ffprobePath)
+{
+    out = MediaProbeInfo();
+#if defined(HAVE_FFMPEG) && HAVE_FFMPEG
+    Q_UNUSED(ffprobePath);
+    return probeWithAvformat(filePath, out, errorOut);
+#else
+    return probeWithFfprobe(filePath, ffprobePath, out, errorOut);
+#endif
+}
+
+bool MediaProbeCache::probe(const QString& filePath, MediaProbeInfo& out, QString* errorOut)
+{
+    const QFileInfo fi(filePath);
+    if (!fi.exists()) {
+        if (errorOut) *errorOut = QString("File not found: %1").arg(filePath);
+        out = MediaProbeInfo();
+        return false;
+    }
+    const QString key = fi.absoluteFilePath();
+    const qint64 size = fi.size();
+    const qint64 mtime = fi.lastModified().toMSecsSinceEpoch();
+
+    QString ffprobe;
+    {
+        QMutexLocker lk(&m_mutex);
+        ensureLoadedLocked();
+        auto it = m_entries.constFind(key);
+        if (it != m_entries.constEnd() && it->size == size && it->mtimeMs == mtime) {
+            out = it->info;
+            if (!out.valid && errorOut) *errorOut = QStringLiteral("Not a media file (cached)");
+            return out.valid;
+        }
+        ffprobe = m_ffprobePath;
+    }
+
+    // Probe outside the lock; two threads racing on the same file just probe twice
+    MediaProbeInfo info;
+    probeFile(key, info, errorOut, ffprobe);
+
+    QMutexLocker lk(&m_mutex);
+    if (m_entries.size() >= kMaxEntries) m_entries.clear();
+    m_entries.insert(key, Entry{size, mtime, info});
+    if (++m_unsaved >= kSaveEvery) saveLocked();
+    out = info;
+    return info.valid;
+}
+
+bool MediaProbeCache::indexKeyframes(const QString& filePath, KeyframeIndex& out, QString* errorOut, const QString& ffprobePath)
+{
+    out = KeyframeIndex();
+#if defined(HAVE_FFMPEG) && HAVE_FFMPEG
+    Q_UNUSED(ffprobePath);
+    return indexWithAvformat(filePath, out, errorOut);
+#else
+    return indexWithFfprobe(filePath, ffprobePath, out, errorOut);
+#endif
+}
+
+bool MediaProbeCache::keyframeIndex(const QString& filePath, KeyframeIndex& out, QString* errorOut)
+{
+    // Makes sure a fresh entry exists for the file, and tells us whether it has video
+    MediaProbeInfo info;
+    if (!probe(filePath, info, errorOut) || info.width <= 0) {
+        if (info.valid && errorOut) *errorOut = QStringLiteral("No video stream");
+        out = KeyframeIndex();
+        return false;
+    }
+    const QFileInfo fi(filePath);
+    const QString key = fi.absoluteFilePath();
+    const qint64 size = fi.size();
+    const qint64 mtime = fi.lastModified().toMSecsSinceEpoch();
+
+    QString ffprobe;
+    {
+        QMutexLocker lk(&m_mutex);
+        auto it = m_entries.constFind(key);
+        if (it != m_entries.constEnd() && it->keyframes.valid) {
+            out = it->keyframes;
+            return true;
+        }
+        ffprobe = m_ffprobePath;
+    }
+
+    KeyframeIndex index;
+    QElapsedTimer timer;
+    timer.start();
+    if (!indexKeyframes(key, index, errorOut, ffprobe)) {
+        out = index;
+        return false;
+    }
+    qDebug() << "[MediaProbeCache] Indexed" << (index.allIntra ? QStringLiteral("intra-only") : QString::number(index.keyframesMs.size()) + " keyframes")
+             << "for" << key << "in" << timer.elapsed() << "ms";
+
+    QMutexLocker lk(&m_mutex);
+    auto it = m_entries.find(key);
+    // Attach only if the file did not change while we were reading it
+    if (it != m_entries.end() && it->size == size && it->mtimeMs == mtime) {
+        it->keyframes = index;
+        if (++m_unsaved >= kSaveEvery) saveLocked();
+    }
+    out = index;
+    return true;
+}
+
+void MediaProbeCache::insert(const QString& filePath, const MediaProbeInfo& info)
+{
+    const QFileInfo fi(filePath);
+    if (!fi.exists()) return;
+    QMutexLocker lk(&m_mutex);
+    ensureLoadedLocked();
+    Entry& e = m_entries[fi.absoluteFilePath()];
+    const qint64 size = fi.size();
+    const qint64 mtime = fi.lastModified().toMSecsSinceEpoch();
+    if (e.size != size || e.mtimeMs != mtime) {
+        e = Entry{size, mtime, info};
+    } else {
+        // Same file: only fill in what the earlier probe could not tell
+        if (e.info.durationMs <= 0) e.info.durationMs = info.durationMs;
+        if (e.info.width <= 0) { e.info.width = info.width; e.info.height = info.height; }
+        if (e.info.fps <= 0.0) e.info.fps = info.fps;
+        e.info.valid = e.info.valid || info.valid;
+    }
+    ++m_unsaved;
+}
+
+void MediaProbeCache::setFfprobePath(const QString& path)
+{
+    QMutexLocker lk(&m_mutex);
+    m_ffprobePath = path;
+}
+
+void MediaProbeCache::setStoragePath(const QString& path)
+{
+    QMutexLocker lk(&m_mutex);
+    if (m_unsaved > 0) saveLocked();
+    m_storagePath = path;
+    m_entries.clear();
+    m_loaded = false;
+    m_unsaved = 0;
+}
+
+bool MediaProbeCache::save()
+{
+    QMutexLocker lk(&m_mutex);
+    return saveLocked();
+}
+
+void MediaProbeCache::clear()
+{
+    QMutexLocker lk(&m_mutex);
+    m_entries.clear();
+    m_loaded = true;
+    m_unsaved = 1; // persist the empty cache
+}
+
+int MediaProbeCache::size() const
+{
+    QMutexLocker lk(&m_mutex);
+    return m_entries.size();
+}
+
+void MediaProbeCache::ensureLoadedLocked()
+{
+    if (m_loaded) return;
+    m_loaded = true;
+    if (!resolveStoragePathLocked()) return;
+    QFile f(m_storagePath);
+    if (!f.open(QIODevice::ReadOnly)) return;
+    QDataStream in(&f);
+    in.setVersion(QDataStream::Qt_6_0);
+    quint32 magic = 0, version = 0;
+    qint32 count = 0;
+    in >> magic >> version >> count;
+    if (magic != kCacheMagic || (version != kCacheVersion && version != kCacheVersionNoIndex)
+        || count < 0 || count > kMaxEntries) {
+        qWarning() << "[MediaProbeCache] Ignoring incompatible cache file" << m_storagePath;
+        return;
+    }
+    m_entries.reserve(count);
+    for (qint32 i = 0; i < count && in.status() == QDataStream::Ok; ++i) {
+        QString path;
+        Entry e;
+        in >> path >> e.size >> e.mtimeMs >> e.info;
+        if (version >= kCacheVersion) in >> e.keyframes;
+        if (in.status() == QDataStream::Ok) m_entries.insert(path, e);
+    }
+    qDebug() << "[MediaProbeCache] Loaded" << m_entries.size() << "entries from" << m_storagePath;
+}
+
+bool MediaProbeCache::resolveStoragePathLocked()
+{
+    if (!m_storagePath.isEmpty()) return true;
+    const QString dir = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
+    if (dir.isEmpty()) return false;
+    m_storagePath = QDir(dir).filePath("media_probe_cache.dat");
+    return true;
+}
+
+bool MediaProbeCache::saveLocked()
+{
+    ensureLoadedLocked();
+    if (!resolveStoragePathLocked()) return false;
+    QDir().mkpath(QFileInfo(m_storagePath).absolutePath());
+    QSaveFile f(m_storagePath);
+    if (!f.open(QIODevice::WriteOnly)) {
+        qWarning() << "[MediaProbeCache] Cannot write" << m_storagePath;
+        return false;
+    }
+    QDataStream out(&f);
+    out.setVersion(QDataStream::Qt_6_0);
+    out << kCacheMagic << kCacheVersion << qint32(m_entries.size());
+    for (auto it = m_entries.constBegin(); it != m_entries.constEnd(); ++it) {
+        out << it.key() << it->size << it->mtimeMs << it->info << it->keyframes;
+    }
+    if (!f.commit()) {
+        qWarning() << "[MediaProbeCache] Failed to save" << m_storagePath;
+        return false;
+    }
+    m_unsaved = 0;
+    return true;
+}
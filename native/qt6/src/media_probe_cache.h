@@ -0,0 +1,97 @@
+#pragma once
+
+#include <QHash>
+#include <QMutex>
+#include <QString>
+#include <QVector>
+
+// Header-level facts about a media file (no frames are decoded to get these)
+struct MediaProbeInfo {
+    bool valid = false;        // false: probed, but not a readable media file
+    qint64 durationMs = 0;
+    int width = 0;
+    int height = 0;
+    double fps = 0.0;          // avg_frame_rate, falling back to r_frame_rate
+    QString videoCodec;
+    QString videoProfile;      // e.g. High, 422 HQ, 4444 XQ, Main 10
+    QString pixelFormat;
+    bool hasAlpha = false;
+    QString audioCodec;
+    qint64 bitrate = 0;
+    QString timecodeStart;     // empty when the file carries no timecode
+};
+
+// Presentation times of the video stream's keyframes, used to snap scrub seeks
+struct KeyframeIndex {
+    bool valid = false;        // false: not built yet (or the file has no video)
+    bool allIntra = false;     // every frame is a keyframe (ProRes, DNxHD, MJPEG...); list stays empty
+    QVector<qint64> keyframesMs; // ascending, relative to the stream start
+
+    // Keyframe closest to ms (ms itself for intra-only files or an empty index)
+    qint64 nearest(qint64 ms) const;
+    // Last keyframe at or before ms; -1 when unknown (empty or intra-only index)
+    qint64 atOrBefore(qint64 ms) const;
+};
+
+/**
+ * MediaProbeCache - process-wide, persistent cache of media probe results
+ *
+ * Entries are keyed by absolute path and validated against file size and
+ * modification time, so an edited or replaced clip is re-probed automatically.
+ * Probing runs in process through libavformat when built with HAVE_FFMPEG
+ * (container header only; stream info is analysed only when the header lacks
+ * dimensions, pixel format or duration). Without FFmpeg a single ffprobe call
+ * per file is the fallback. Keyframe indexes for scrubbing are built on demand
+ * and persisted with the entry. Shared by MediaConverterWorker, MediaInfo and
+ * LivePreviewManager; all methods are thread-safe.
+ */
+class MediaProbeCache {
+public:
+    static MediaProbeCache& instance();
+
+    // Cached lookup, probing on miss. Returns info.valid.
+    bool probe(const QString& filePath, MediaProbeInfo& out, QString* errorOut = nullptr);
+    // Adds/merges knowledge obtained elsewhere (e.g. a GStreamer duration query)
+    void insert(const QString& filePath, const MediaProbeInfo& info);
+
+    // Cached keyframe index, built on miss. Building reads every video packet
+    // header of the file, so call this from a worker thread. Returns out.valid.
+    bool keyframeIndex(const QString& filePath, KeyframeIndex& out, QString* errorOut = nullptr);
+
+    // Uncached probe
+    static bool probeFile(const QString& filePath, MediaProbeInfo& out, QString* errorOut, const QString& ffprobePath);
+    // Uncached keyframe scan
+    static bool indexKeyframes(const QString& filePath, KeyframeIndex& out, QString* errorOut, const QString& ffprobePath);
+
+    // Used by the non-FFmpeg fallback; defaults to "ffprobe" on PATH
+    void setFfprobePath(const QString& path);
+
+    // Persistence (AppDataLocation/media_probe_cache.dat by default)
+    void setStoragePath(const QString& path);
+    bool save();
+    void clear();
+    int size() const;
+
+private:
+    MediaProbeCache() = default;
+    ~MediaProbeCache();
+    Q_DISABLE_COPY(MediaProbeCache)
+
+    struct Entry {
+        qint64 size = 0;
+        qint64 mtimeMs = 0;
+        MediaProbeInfo info;
+        KeyframeIndex keyframes;
+    };
+
+    void ensureLoadedLocked();
+    bool resolveStoragePathLocked();
+    bool saveLocked();
+
+    mutable QMutex m_mutex;
+    QHash<QString, Entry> m_entries;
+    QString m_storagePath;
+    QString m_ffprobePath;
+    bool m_loaded = false;
+    int m_unsaved = 0;
+};
@@ -0,0 +1,207 @@
+#include "natural_sort.h"
+
+#include <QStringView>
+
+namespace {
+// Separates base name, extension and frame; below every text byte so "a.exr" < "ab.exr"
+constexpr char kPartSeparator = '\x01';
+// Starts a digit run; numbers sort ahead of text at the same position
+constexpr char kNumberMarker = '\x02';
+// Digit count is stored as one printable byte after the marker
+constexpr int kMaxDigitCount = 0x7e - 0x20;
+
+inline bool isDigit(QChar c)
+{
+    return c.unicode() >= u'0' && c.unicode() <= u'9';
+}
+
+inline bool isFrameSeparator(QChar c)
+{
+    return c == u'.' || c == u'_' || c == u'-' || c == u' ';
+}
+
+// Shorter (leading zeros stripped) numbers first, then digit by digit: value order
+void appendNumber(QByteArray& out, QStringView digits)
+{
+    qsizetype start = 0;
+    while (start < digits.size() && digits[start] == u'0') ++start;
+    out.append(kNumberMarker);
+    out.append(char(0x20 + qMin<qsizetype>(digits.size() - start, kMaxDigitCount)));
+    for (qsizetype i = start; i < digits.size(); ++i) out.append(char(digits[i].unicode()));
+}
+
+void appendText(QByteArray& out, QStringView text)
+{
+    qsizetype i = 0;
+    while (i < text.size()) {
+        qsizetype j = i;
+        const bool digits = isDigit(text[i]);
+        while (j < text.size() && isDigit(text[j]) == digits) ++j;
+        if (digits) appendNumber(out, text.sliced(i, j - i));
+        else out.append(text.sliced(i, j - i).toString().toCaseFolded().toUtf8());
+        i = j;
+    }
+}
+
+// Base name and frame number split the way key() splits them
+struct NameParts {
+    QStringView text;
+    QStringView ext;
+    QStringView frame;
+};
+
+NameParts splitName(QStringView name)
+{
+    // A leading dot (".hidden") is part of the name, not an extension
+    const qsizetype dot = name.lastIndexOf(u'.');
+    const QStringView base = dot > 0 ? name.first(dot) : name;
+    const QStringView ext = dot > 0 ? name.sliced(dot + 1) : QStringView();
+
+    // Trailing digits set off by a separator ("shot.0101", "plate_12") are the frame number
+    qsizetype frameStart = base.size();
+    while (frameStart > 0 && isDigit(base[frameStart - 1])) --frameStart;
+    if (frameStart > 0 && !isFrameSeparator(base[frameStart - 1])) frameStart = base.size();
+    return {base.first(frameStart), ext, base.sliced(frameStart)};
+}
+
+// Produces the bytes of key() one at a time, so compare() can stop at the first
+// difference without building either key (it runs once per comparison in SQLite sorts)
+class KeyReader {
+public:
+    explicit KeyReader(QStringView name) : m_parts(splitName(name)), m_cur(m_parts.text) {}
+
+    // Next key byte, or -1 past the end
+    int next()
+    {
+        for (;;) {
+            if (m_pendingPos < m_pendingLen) return uchar(m_pending[m_pendingPos++]);
+            if (m_digitPos < m_digits.size()) return m_digits[m_digitPos++].unicode();
+            if (!refill()) return -1;
+        }
+    }
+
+private:
+    enum class Stage { Text, Ext, Frame, Done };
+
+    bool refill()
+    {
+        m_pendingPos = m_pendingLen = 0;
+        switch (m_stage) {
+        case Stage::Text:
+        case Stage::Ext:
+            if (m_pos < m_cur.size()) {
+                readTextUnit();
+            } else if (m_stage == Stage::Text) {
+                push(kPartSeparator);
+                m_stage = Stage::Ext;
+                m_cur = m_parts.ext;
+                m_pos = 0;
+            } else if (!m_parts.frame.isEmpty()) {
+                push(kPartSeparator);
+                m_stage = Stage::Frame;
+            } else {
+                m_stage = Stage::Done;
+            }
+            break;
+        case Stage::Frame:
+            beginNumber(m_parts.frame);
+            m_stage = Stage::Done;
+            break;
+        case Stage::Done:
+            break;
+        }
+        return m_pendingLen > 0 || m_digitPos < m_digits.size();
+    }
+
+    // A whole digit run, or one case-folded character as UTF-8
+    void readTextUnit()
+    {
+        if (isDigit(m_cur[m_pos])) {
+            qsizetype end = m_pos;
+            while (end < m_cur.size() && isDigit(m_cur[end])) ++end;
+            beginNumber(m_cur.sliced(m_pos, end - m_pos));
+            m_pos = end;
+            return;
+        }
+        char32_t ucs = m_cur[m_pos].unicode();
+        ++m_pos;
+        if (QChar::isHighSurrogate(ucs) && m_pos < m_cur.size() && m_cur[m_pos].isLowSurrogate()) {
+            ucs = QChar::surrogateToUcs4(char16_t(ucs), m_cur[m_pos].unicode());
+            ++m_pos;
+        } else if (QChar::isSurrogate(ucs)) {
+            push('?'); // what toUtf8() writes for an unpaired surrogate
+            return;
+        }
+        ucs = QChar::toCaseFolded(ucs);
+        if (ucs < 0x80) {
+            push(char(ucs));
+        } else if (ucs < 0x800) {
+            push(char(0xc0 | (ucs >> 6)));
+            push(char(0x80 | (ucs & 0x3f)));
+        } else if (ucs < 0x10000) {
+            push(char(0xe0 | (ucs >> 12)));
+            push(char(0x80 | ((ucs >> 6) & 0x3f)));
+            push(char(0x80 | (ucs & 0x3f)));
+        } else {
+            push(char(0xf0 | (ucs >> 18)));
+            push(char(0x80 | ((ucs >> 12) & 0x3f)));
+            push(char(0x80 | ((ucs >> 6) & 0x3f)));
+            push(char(0x80 | (ucs & 0x3f)));
+        }
+    }
+
+    // Same layout as appendNumber(): marker, digit count, digits without leading zeros
+    void beginNumber(QStringView digits)
+    {
+        qsizetype start = 0;
+        while (start < digits.size() && digits[start] == u'0') ++start;
+        push(kNumberMarker);
+        push(char(0x20 + qMin<qsizetype>(digits.size() - start, kMaxDigitCount)));
+        m_digits = digits.sliced(start);
+        m_digitPos = 0;
+    }
+
+    void push(char c) { m_pending[m_pendingLen++] = c; }
+
+    NameParts m_parts;
+    Stage m_stage = Stage::Text;
+    QStringView m_cur;
+    qsizetype m_pos = 0;
+    char m_pending[4] = {};
+    int m_pendingLen = 0;
+    int m_pendingPos = 0;
+    QStringView m_digits;
+    qsizetype m_digitPos = 0;
+};
+}
+
+namespace NaturalSort {
+
+QByteArray key(const QString& fileName)
+{
+    const NameParts parts = splitName(fileName);
+    QByteArray out;
+    out.reserve(fileName.size() + 8);
+    appendText(out, parts.text);
+    out.append(kPartSeparator);
+    appendText(out, parts.ext);
+    if (!parts.frame.isEmpty()) {
+        out.append(kPartSeparator);
+        appendNumber(out, parts.frame);
+    }
+    return out;
+}
+
+int compare(QStringView a, QStringView b)
+{
+    KeyReader ka(a);
+    KeyReader kb(b);
+    for (;;) {
+        const int ca = ka.next();
+        const int cb = kb.next();
+        if (ca != cb) return ca < cb ? -1 : 1;
+        if (ca < 0) return 0;
+    }
+}
+
+}
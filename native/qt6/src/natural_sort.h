@@ -0,0 +1,24 @@
+#pragma once
+#include <QByteArray>
+#include <QString>
+#include <QStringView>
+
+/**
+ * NaturalSort - frame-aware natural ordering of file names
+ *
+ * key() turns a name into bytes whose plain byte order (memcmp, SQLite BINARY)
+ * is the natural order: case-insensitive, digit runs compared by value
+ * ("img2" < "img10"), and a trailing frame number split off so that every
+ * frame of "shot.####.exr" sorts together, by frame, ahead of "shot_b.####.exr".
+ * AssetRow keeps the key from load time; DB registers the same comparison as
+ * the NATURAL SQLite collation so queried rows come back in this order.
+ */
+namespace NaturalSort {
+
+QByteArray key(const QString& fileName);
+
+// <0, 0, >0; same result as comparing key(a) with key(b), without building the keys
+int compare(QStringView a, QStringView b);
+inline int compare(const QString& a, const QString& b) { return compare(QStringView(a), QStringView(b)); }
+
+}
@@ -1,6 +1,11 @@
 #include "oiio_image_loader.h"
+#include <QBuffer>
 #include <QFileInfo>
+#include <QImageReader>
+#include <qfloat16.h>
 #include <cmath>
+#include <memory>
+#include <vector>
 
 
 
@@ -8,6 +13,7 @@
 #include <OpenImageIO/imageio.h>
 #include <OpenImageIO/imagebuf.h>
 #include <OpenImageIO/imagebufalgo.h>
+#include <OpenImageIO/filesystem.h>
 using namespace OIIO;
 #endif
 
@@ -137,6 +143,169 @@ QImage OIIOImageLoader::loadImage(const QString& filePath, int maxWidth, int max
 #endif
 }
 
+// Largest power-of-two reduction of `full` that still covers `minSize`
+static int reductionDivisor(const QSize& full, const QSize& minSize) {
+    if (!minSize.isValid() || minSize.isEmpty() || !full.isValid()) return 1;
+    int divisor = 1;
+    while (divisor < 16 && full.width() / (divisor * 2) >= minSize.width()
+           && full.height() / (divisor * 2) >= minSize.height()) {
+        divisor *= 2;
+    }
+    return divisor;
+}
+
+#if defined(HAVE_OPENIMAGEIO) && HAVE_OPENIMAGEIO
+static QImage loadReducedOIIO(const QString& filePath, const QByteArray* encoded, const QSize& minSize, QSize* fullSize) {
+    // Decode from memory through an IOProxy; readers without proxy support reopen the file
+    std::unique_ptr<Filesystem::IOMemReader> memReader;
+    ImageInput::unique_ptr in;
+    if (encoded && !encoded->isEmpty()) {
+        memReader.reset(new Filesystem::IOMemReader(const_cast<char*>(encoded->constData()), size_t(encoded->size())));
+        in = ImageInput::open(filePath.toStdString(), nullptr, memReader.get());
+    }
+    if (!in) in = ImageInput::open(filePath.toStdString());
+    if (!in) {
+        qWarning() << "[OIIOImageLoader] Failed to open" << filePath << QString::fromStdString(OIIO::geterror());
+        return QImage();
+    }
+    const QSize full(in->spec().width, in->spec().height);
+    if (fullSize) *fullSize = full;
+    int divisor = reductionDivisor(full, minSize);
+
+    // MIP-mapped files already store the reduced levels, each half the size of the previous one
+    int miplevel = 0;
+    while (divisor > 1 && in->seek_subimage(0, miplevel + 1)) {
+        ++miplevel;
+        divisor /= 2;
+    }
+    if (!in->seek_subimage(0, miplevel)) {
+        qWarning() << "[OIIOImageLoader] Failed to select MIP level" << miplevel << "of" << filePath;
+        return QImage();
+    }
+
+    const ImageSpec spec = in->spec();
+    const int w = spec.width, h = spec.height;
+    const int nch = std::min(spec.nchannels, 4);
+    // Gray and gray+alpha are expanded to RGB(A)
+    const int outCh = (nch == 4 || nch == 2) ? 4 : 3;
+    const int ow = std::max(1, w / divisor), oh = std::max(1, h / divisor);
+    const bool isHDR = (spec.format == TypeDesc::FLOAT || spec.format == TypeDesc::HALF ||
+                        spec.format == TypeDesc::DOUBLE);
+    std::vector<float> out(size_t(ow) * oh * outCh);
+
+    // Box-filters `rows` source scanlines (divisor px wide boxes) into output row oy
+    auto boxRow = [&](const float* src, int rows, int oy) {
+        float* dst = &out[size_t(oy) * ow * outCh];
+        const float norm = 1.0f / float(rows * divisor);
+        for (int ox = 0; ox < ow; ++ox, dst += outCh) {
+            float acc[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+            for (int r = 0; r < rows; ++r) {
+                const float* p = src + (size_t(r) * w + size_t(ox) * divisor) * nch;
+                for (int x = 0; x < divisor; ++x, p += nch) {
+                    for (int c = 0; c < nch; ++c) acc[c] += p[c];
+                }
+            }
+            if (nch <= 2) {
+                dst[0] = dst[1] = dst[2] = acc[0] * norm;
+                if (nch == 2) dst[3] = acc[1] * norm;
+            } else {
+                for (int c = 0; c < nch; ++c) dst[c] = acc[c] * norm;
+            }
+        }
+    };
+
+    std::vector<float> strip;
+    if (spec.tile_width > 0) {
+        // Tiled without a suitable MIP level: decode the level, then reduce
+        strip.resize(size_t(w) * h * nch);
+        if (!in->read_image(0, miplevel, 0, nch, TypeDesc::FLOAT, strip.data())) {
+            qWarning() << "[OIIOImageLoader] Failed to read" << filePath << QString::fromStdString(in->geterror());
+            return QImage();
+        }
+        for (int oy = 0; oy < oh; ++oy) boxRow(&strip[size_t(oy) * divisor * w * nch], divisor, oy);
+    } else if (divisor > 1 && (spec.format == TypeDesc::UINT16 || spec.format == TypeDesc::UINT8 || spec.format == TypeDesc::UINT32)
+               && (std::string(in->format_name()) == "dpx" || std::string(in->format_name()) == "cineon")) {
+        // Uncompressed film scans: read only the sampled scanlines
+        strip.resize(size_t(w) * nch);
+        for (int oy = 0; oy < oh; ++oy) {
+            const int y = spec.y + oy * divisor + divisor / 2;
+            if (!in->read_scanlines(0, miplevel, y, y + 1, 0, 0, nch, TypeDesc::FLOAT, strip.data())) {
+                qWarning() << "[OIIOImageLoader] Failed to read" << filePath << QString::fromStdString(in->geterror());
+                return QImage();
+            }
+            boxRow(strip.data(), 1, oy);
+        }
+    } else {
+        // Strips of whole output rows, tall enough to cover the compressed blocks of EXR files
+        const int stripRows = std::max(divisor, (256 / divisor) * divisor);
+        strip.resize(size_t(w) * stripRows * nch);
+        for (int oy = 0; oy < oh; oy += stripRows / divisor) {
+            const int y0 = oy * divisor;
+            const int rows = std::min(stripRows, oh * divisor - y0);
+            if (!in->read_scanlines(0, miplevel, spec.y + y0, spec.y + y0 + rows, 0, 0, nch, TypeDesc::FLOAT, strip.data())) {
+                qWarning() << "[OIIOImageLoader] Failed to read" << filePath << QString::fromStdString(in->geterror());
+                return QImage();
+            }
+            for (int r = 0; r < rows / divisor; ++r) {
+                boxRow(&strip[size_t(r) * divisor * w * nch], divisor, oy + r);
+            }
+        }
+    }
+    in->close();
+
+    if (isHDR) return OIIOImageLoader::toLinearHalf(out.data(), ow, oh, outCh);
+    QImage image(ow, oh, outCh == 4 ? QImage::Format_RGBA8888 : QImage::Format_RGB888);
+    for (int y = 0; y < oh; ++y) {
+        uint8_t* scanline = image.scanLine(y);
+        const float* src = &out[size_t(y) * ow * outCh];
+        for (int i = 0; i < ow * outCh; ++i) {
+            scanline[i] = uint8_t(std::min(std::max(src[i], 0.0f), 1.0f) * 255.0f + 0.5f);
+        }
+    }
+    return image;
+}
+#endif
+
+QImage OIIOImageLoader::loadImageReducedLinear(const QString& filePath, const QSize& minSize, QSize* fullSize) {
+    return loadReduced(filePath, nullptr, minSize, fullSize);
+}
+
+QImage OIIOImageLoader::loadImageReducedLinear(const QString& filePath, const QByteArray& encoded, const QSize& minSize,
+                                               QSize* fullSize) {
+    return loadReduced(filePath, &encoded, minSize, fullSize);
+}
+
+QImage OIIOImageLoader::loadReduced(const QString& filePath, const QByteArray* encoded, const QSize& minSize, QSize* fullSize) {
+#if defined(HAVE_OPENIMAGEIO) && HAVE_OPENIMAGEIO
+    if (isOIIOSupported(filePath)) {
+        QImage image = loadReducedOIIO(filePath, encoded, minSize, fullSize);
+        if (!image.isNull()) return image;
+    }
+#endif
+    // Qt decoders: JPEG scales while decoding, others are scaled after
+    QBuffer buffer;
+    QImageReader reader;
+    if (encoded && !encoded->isEmpty()) {
+        buffer.setData(*encoded);
+        buffer.open(QIODevice::ReadOnly);
+        reader.setDevice(&buffer);
+        reader.setFormat(QFileInfo(filePath).suffix().toLower().toLatin1());
+    } else {
+        reader.setFileName(filePath);
+    }
+    const QSize full = reader.size();
+    if (fullSize) *fullSize = full;
+    const int divisor = reductionDivisor(full, minSize);
+    if (divisor > 1) {
+        reader.setScaledSize(QSize(std::max(1, full.width() / divisor), std::max(1, full.height() / divisor)));
+    }
+    QImage image = reader.read();
+    if (image.isNull()) {
+        qWarning() << "[OIIOImageLoader] Failed to load" << filePath << reader.errorString();
+    }
+    return image;
+}
+
 QImage OIIOImageLoader::toneMapHDR(const float* data, int width, int height, int channels, ColorSpace colorSpace, float exposure) {
 #if defined(HAVE_OPENIMAGEIO) && HAVE_OPENIMAGEIO
     QString colorSpaceName;
@@ -207,6 +376,29 @@ QImage OIIOImageLoader::toneMapHDR(const float* data, int width, int height, int
 #endif
 }
 
+QImage OIIOImageLoader::toLinearHalf(const float* data, int width, int height, int channels) {
+    QImage image(width, height, channels == 4 ? QImage::Format_RGBA16FPx4 : QImage::Format_RGBX16FPx4);
+    if (image.isNull()) {
+        qWarning() << "[OIIOImageLoader] Failed to allocate" << width << "x" << height << "half-float image";
+        return image;
+    }
+    std::vector<float> row(channels == 4 ? 0 : size_t(width) * 4);
+    for (int y = 0; y < height; ++y) {
+        const float* src = data + size_t(y) * width * channels;
+        if (channels != 4) {
+            for (int x = 0; x < width; ++x) {
+                row[size_t(x) * 4 + 0] = src[size_t(x) * 3 + 0];
+                row[size_t(x) * 4 + 1] = src[size_t(x) * 3 + 1];
+                row[size_t(x) * 4 + 2] = src[size_t(x) * 3 + 2];
+                row[size_t(x) * 4 + 3] = 1.0f;
+            }
+            src = row.data();
+        }
+        qFloatToFloat16(reinterpret_cast<qfloat16*>(image.scanLine(y)), src, qsizetype(width) * 4);
+    }
+    return image;
+}
+
 float OIIOImageLoader::reinhardToneMap(float value) {
 #if defined(HAVE_OPENIMAGEIO) && HAVE_OPENIMAGEIO
     // Simple Reinhard tone mapping: x / (1 + x)
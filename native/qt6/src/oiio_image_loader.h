@@ -1,6 +1,8 @@
 #pragma once
 #include <QString>
+#include <QByteArray>
 #include <QImage>
+#include <QSize>
 #include <QDebug>
 
 /**
@@ -25,6 +27,30 @@ public:
      */
     static QImage loadImage(const QString& filePath, int maxWidth = 0, int maxHeight = 0, ColorSpace colorSpace = ColorSpace::sRGB);
 
+    /**
+     * Decode an image at reduced resolution for playback
+     * Picks the smallest power-of-two reduction that still covers minSize: MIP levels of
+     * tiled EXR/TIFF files are used when present, DPX/Cineon read only the sampled scanlines,
+     * and other files are box-filtered strip by strip while decoding. Formats OIIO does not
+     * handle go through QImageReader's scaled decode (JPEG scales in the DCT).
+     * HDR (half/float) sources stay scene-linear: they are returned as half-float
+     * Format_RGBA16FPx4 / Format_RGBX16FPx4 images for a DisplayTransform to map at
+     * display time. Other sources decode to 8-bit.
+     * @param filePath Path to the image file
+     * @param minSize Smallest acceptable size; an invalid size decodes at full resolution
+     * @param fullSize Receives the full-resolution size of the image (optional)
+     * @return QImage at full / 2^n resolution, or null QImage on failure
+     */
+    static QImage loadImageReducedLinear(const QString& filePath, const QSize& minSize, QSize* fullSize = nullptr);
+
+    /**
+     * Same as above, decoding from bytes already read into memory (e.g. by SequenceReadAhead)
+     * @param filePath Path the bytes were read from; selects the decoder by extension
+     * @param encoded Complete contents of the file
+     */
+    static QImage loadImageReducedLinear(const QString& filePath, const QByteArray& encoded, const QSize& minSize,
+                                         QSize* fullSize = nullptr);
+
     /**
      * Check if a file format is supported by OIIO
      * @param filePath Path to check
@@ -44,7 +70,18 @@ public:
      */
     static QImage toneMapHDR(const float* data, int width, int height, int channels, ColorSpace colorSpace = ColorSpace::sRGB, float exposure = 0.0f);
 
+    /**
+     * Store float image data as scene-linear half floats, without any display transform
+     * @param data Float image data (RGB or RGBA)
+     * @param channels Number of channels (3 or 4)
+     * @return Format_RGBA16FPx4 (4 channels) or Format_RGBX16FPx4 (3 channels) image
+     */
+    static QImage toLinearHalf(const float* data, int width, int height, int channels);
+
 private:
+    // Shared by the loadImageReducedLinear overloads; `encoded` may be null
+    static QImage loadReduced(const QString& filePath, const QByteArray* encoded, const QSize& minSize, QSize* fullSize);
+
     /**
      * Simple Reinhard tone mapping operator
      */
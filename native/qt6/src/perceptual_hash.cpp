@@ -0,0 +1,115 @@
+#include "perceptual_hash.h"
+
+#include <QSet>
+#include <algorithm>
+
+namespace {
+
+// All 16-bit masks grouped by popcount, used to enumerate chunk neighbourhoods
+const QVector<quint16>& masksWithBits(int bits)
+{
+    static const QVector<QVector<quint16>> kMasks = [] {
+        QVector<QVector<quint16>> masks(17);
+        for (int m = 0; m <= 0xFFFF; ++m) masks[std::popcount(unsigned(m))].append(quint16(m));
+        return masks;
+    }();
+    return kMasks[qBound(0, bits, 16)];
+}
+
+} // namespace
+
+quint64 PerceptualHash::dHash(const QImage& image)
+{
+    if (image.isNull()) return 0;
+    // Two-step downscale: smooth scaling straight to 9x8 from a 4K frame skips most source pixels
+    QImage small = image;
+    if (small.width() > 64 || small.height() > 64) {
+        small = small.scaled(64, 64, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+    }
+    small = small.scaled(9, 8, Qt::IgnoreAspectRatio, Qt::SmoothTransformation)
+                 .convertToFormat(QImage::Format_Grayscale8);
+
+    quint64 hash = 0;
+    int bit = 0;
+    for (int y = 0; y < 8; ++y) {
+        const uchar* row = small.constScanLine(y);
+        for (int x = 0; x < 8; ++x, ++bit) {
+            if (row[x] < row[x + 1]) hash |= (quint64(1) << bit);
+        }
+    }
+    return hash;
+}
+
+void PerceptualHashIndex::insert(int id, quint64 hash)
+{
+    auto it = m_hashes.find(id);
+    if (it != m_hashes.end()) {
+        if (it.value() == hash) return;
+        remove(id);
+    }
+    m_hashes.insert(id, hash);
+    for (int i = 0; i < kChunks; ++i) m_tables[i][chunk(hash, i)].append(id);
+}
+
+bool PerceptualHashIndex::remove(int id)
+{
+    auto it = m_hashes.find(id);
+    if (it == m_hashes.end()) return false;
+    const quint64 hash = it.value();
+    m_hashes.erase(it);
+    for (int i = 0; i < kChunks; ++i) {
+        auto bucket = m_tables[i].find(chunk(hash, i));
+        if (bucket == m_tables[i].end()) continue;
+        QVector<int>& ids = bucket.value();
+        const int pos = ids.indexOf(id);
+        if (pos >= 0) {
+            ids[pos] = ids.last();
+            ids.removeLast();
+        }
+        if (ids.isEmpty()) m_tables[i].erase(bucket);
+    }
+    return true;
+}
+
+void PerceptualHashIndex::clear()
+{
+    m_hashes.clear();
+    for (auto& table : m_tables) table.clear();
+}
+
+QVector<PerceptualHashIndex::Match> PerceptualHashIndex::nearest(quint64 query, int k, int maxDistance, int excludeId) const
+{
+    QVector<Match> found;
+    if (k <= 0 || m_hashes.isEmpty()) return found;
+    maxDistance = qBound(0, maxDistance, 64);
+
+    QSet<int> seen;
+    const int maxRadius = maxDistance / kChunks;
+    for (int r = 0; r <= maxRadius; ++r) {
+        const QVector<quint16>& masks = masksWithBits(r);
+        for (int i = 0; i < kChunks; ++i) {
+            const quint16 q = chunk(query, i);
+            for (quint16 m : masks) {
+                auto bucket = m_tables[i].constFind(quint16(q ^ m));
+                if (bucket == m_tables[i].constEnd()) continue;
+                for (int id : bucket.value()) {
+                    if (id == excludeId || seen.contains(id)) continue;
+                    seen.insert(id);
+                    const int d = PerceptualHash::distance(query, m_hashes.value(id));
+                    if (d <= maxDistance) found.append({ id, d });
+                }
+            }
+        }
+        // Everything within kChunks*(r+1)-1 has now been visited; stop once the top k are settled
+        const int settled = kChunks * (r + 1) - 1;
+        int certain = 0;
+        for (const Match& m : std::as_const(found)) if (m.distance <= settled) ++certain;
+        if (certain >= k) break;
+    }
+
+    std::sort(found.begin(), found.end(), [](const Match& a, const Match& b) {
+        return a.distance != b.distance ? a.distance < b.distance : a.id < b.id;
+    });
+    if (found.size() > k) found.resize(k);
+    return found;
+}
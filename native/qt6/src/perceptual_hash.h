@@ -0,0 +1,60 @@
+#pragma once
+
+#include <QHash>
+#include <QImage>
+#include <QVector>
+#include <QtGlobal>
+#include <bit>
+
+/**
+ * 64-bit perceptual hashing for near-duplicate / similar image search.
+ *
+ * dHash compares horizontally adjacent pixels of a 9x8 grayscale thumbnail, so it
+ * survives resizes, re-encodes and moderate grades while staying cheap enough to
+ * compute on every decoded preview.
+ */
+namespace PerceptualHash {
+
+quint64 dHash(const QImage& image);
+
+inline int distance(quint64 a, quint64 b)
+{
+    return std::popcount(a ^ b);
+}
+
+} // namespace PerceptualHash
+
+/**
+ * Multi-index hash table over 64-bit hashes for k-nearest Hamming queries.
+ *
+ * Each hash is split into four 16-bit chunks with one table per chunk. Two hashes
+ * within distance d share at least one chunk within distance d/4 (pigeonhole), so
+ * a query probes chunk neighbourhoods of growing radius and stops as soon as the
+ * k best candidates are provably final. Inserts and removals are O(1) amortized.
+ * Not thread-safe; owned by a single thread.
+ */
+class PerceptualHashIndex {
+public:
+    struct Match {
+        int id = 0;
+        int distance = 0;
+    };
+
+    void insert(int id, quint64 hash);
+    bool remove(int id);
+    void clear();
+
+    int size() const { return m_hashes.size(); }
+    bool contains(int id) const { return m_hashes.contains(id); }
+    quint64 hashOf(int id) const { return m_hashes.value(id); }
+
+    // Up to k matches with distance <= maxDistance, nearest first; excludeId is skipped
+    QVector<Match> nearest(quint64 query, int k, int maxDistance, int excludeId = 0) const;
+
+private:
+    static constexpr int kChunks = 4;
+    static quint16 chunk(quint64 hash, int i) { return quint16(hash >> (16 * i)); }
+
+    QHash<int, quint64> m_hashes;
+    QHash<quint16, QVector<int>> m_tables[kChunks];
+};
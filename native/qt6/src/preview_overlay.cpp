@@ -1,6 +1,9 @@
 #include "preview_overlay.h"
 #include "media/gstreamer_player.h"
 #include "oiio_image_loader.h"
+#include "proxy_manager.h"
+#include "media/waveform_cache.h"
+#include "waveform_widget.h"
 #include <QMessageBox>
 #include <QVBoxLayout>
 #include <QHBoxLayout>
@@ -49,6 +52,7 @@
 #endif
 
 #include <atomic>
+#include <cmath>
 #include <QMediaMetaData>
 
 #include <QSettings>
@@ -134,6 +138,15 @@ PreviewOverlay::PreviewOverlay(QWidget *parent)
     connect(m_gstreamerPlayer, &GStreamerPlayer::playbackStateChanged, this, &PreviewOverlay::onGStreamerPlaybackStateChanged);
     connect(m_gstreamerPlayer, &GStreamerPlayer::error, this, &PreviewOverlay::onGStreamerError);
     connect(m_gstreamerPlayer, &GStreamerPlayer::endOfStream, this, &PreviewOverlay::onGStreamerEndOfStream);
+    connect(m_gstreamerPlayer, &GStreamerPlayer::memoryFrameReady, this, &PreviewOverlay::onGStreamerMemoryFrame);
+    connect(m_gstreamerPlayer, &GStreamerPlayer::memoryFrameCleared, this, &PreviewOverlay::onGStreamerMemoryFrameCleared);
+
+    connect(&WaveformCache::instance(), &WaveformCache::waveformReady, this, &PreviewOverlay::onWaveformReady);
+
+    // Pick up proxies that finish while their source is on screen
+    connect(&ProxyManager::instance(), &ProxyManager::proxyReady, this, [this](const ProxyInfo& info) {
+        applyProxyAvailability(info.sourceKey);
+    });
 
     qDebug() << "[PreviewOverlay] GStreamerPlayer initialized with hardware-accelerated playback";
 
@@ -146,10 +159,11 @@ PreviewOverlay::PreviewOverlay(QWidget *parent)
     controlsTimer->setInterval(3000);
     connect(controlsTimer, &QTimer::timeout, this, &PreviewOverlay::hideControls);
 
-    // Sequence playback timer (target 25 fps minimum for realtime)
+    // Sequence playback timer: ticks several times per frame period and the playback
+    // clock decides which frame is due, so timer jitter never accumulates into drift
     sequenceTimer = new QTimer(this);
     sequenceTimer->setTimerType(Qt::PreciseTimer);
-    sequenceTimer->setInterval(40); // 25 fps
+    sequenceTimer->setInterval(qMax(1, int(250.0 / sequenceFps)));
     connect(sequenceTimer, &QTimer::timeout, this, &PreviewOverlay::onSequenceTimerTick);
 
     // Initialize frame cache for image sequence playback
@@ -371,6 +385,18 @@ void PreviewOverlay::setupUi()
         controlsLayout->addLayout(cacheRow);
     }
 
+    // ========== ROW 1b: Audio waveform (videos with audio, once peaks are built) ==========
+    waveformWidget = new WaveformWidget(this);
+    waveformWidget->setFixedHeight(44);
+    waveformWidget->hide();
+    connect(waveformWidget, &WaveformWidget::seekRequested, this, [this](qint64 ms, bool scrubbing) {
+        if (isSequence) return;
+        // Same as the slider: keyframes while dragging, an exact seek on click and release
+        m_gstreamerPlayer->seek(ms, scrubbing ? GStreamerPlayer::SeekMode::Keyframe : GStreamerPlayer::SeekMode::Accurate);
+        controlsTimer->start();
+    });
+    controlsLayout->addWidget(waveformWidget);
+
     // ========== ROW 2: Timeline (Current | Slider | Duration | FPS) ==========
     currentTimeLabel = new QLabel("00:00:00:00", this);
     currentTimeLabel->setStyleSheet("QLabel { color: white; font-size: 14px; padding: 0 8px; }");
@@ -416,6 +442,45 @@ void PreviewOverlay::setupUi()
     colorSpaceCombo->hide();
     connect(colorSpaceCombo, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &PreviewOverlay::onColorSpaceChanged);
 
+    // Exposure and display gamma for HDR content; applied at display time, no re-decode
+    viewTransformControls = new QWidget(this);
+    QHBoxLayout *viewTransformLayout = new QHBoxLayout(viewTransformControls);
+    viewTransformLayout->setContentsMargins(0, 0, 0, 0);
+    viewTransformLayout->setSpacing(6);
+    exposureLabel = new QLabel("EV +0.0", viewTransformControls);
+    exposureLabel->setStyleSheet("QLabel { color: white; font-size: 12px; padding: 0 5px; }");
+    exposureLabel->setMinimumWidth(56);
+    exposureSlider = new QSlider(Qt::Horizontal, viewTransformControls);
+    exposureSlider->setRange(-80, 80); // tenths of a stop
+    exposureSlider->setValue(0);
+    exposureSlider->setFixedWidth(120);
+    exposureSlider->setFocusPolicy(Qt::NoFocus);
+    exposureSlider->setToolTip("Exposure (stops); double-click the value to reset");
+    gammaSpin = new QDoubleSpinBox(viewTransformControls);
+    gammaSpin->setRange(0.2, 4.0);
+    gammaSpin->setSingleStep(0.1);
+    gammaSpin->setDecimals(2);
+    gammaSpin->setValue(1.0);
+    gammaSpin->setPrefix("\u03B3 ");
+    gammaSpin->setFocusPolicy(Qt::ClickFocus);
+    gammaSpin->setToolTip("Display gamma");
+    gammaSpin->setStyleSheet("QDoubleSpinBox { background-color: #333; color: white; border: 1px solid #555; padding: 3px; border-radius: 3px; }");
+    viewTransformLayout->addWidget(exposureLabel);
+    viewTransformLayout->addWidget(exposureSlider);
+    viewTransformLayout->addWidget(gammaSpin);
+    viewTransformControls->hide();
+    exposureLabel->installEventFilter(this);
+    connect(exposureSlider, &QSlider::valueChanged, this, [this](int value) {
+        const float stops = value / 10.0f;
+        exposureLabel->setText(QString::asprintf("EV %+.1f", stops));
+        displayTransform.setExposure(stops);
+        refreshDisplayTransform();
+    });
+    connect(gammaSpin, QOverload<double>::of(&QDoubleSpinBox::valueChanged), this, [this](double gamma) {
+        displayTransform.setGamma(float(gamma));
+        refreshDisplayTransform();
+    });
+
     // ========== ROW 3: Playback (center) + Audio (right) ==========
     // Transport (Prev - Play/Pause - Next)
     QWidget *transport = new QWidget(this);
@@ -507,6 +572,7 @@ void PreviewOverlay::setupUi()
     csLayout->setSpacing(6);
     csLayout->addWidget(colorSpaceLabel);
     csLayout->addWidget(colorSpaceCombo);
+    csLayout->addWidget(viewTransformControls);
     // Do not forcibly hide the container; children visibility will control it
     bottomGrid->addWidget(csGroup, 0, 2, Qt::AlignVCenter);
 
@@ -562,6 +628,7 @@ void PreviewOverlay::showAsset(const QString &filePath, const QString &fileName,
 {
     // First, stop any ongoing playback (video, fallback, or sequence)
     stopPlayback();
+    setWaveformVisible(false);
 
     // Reset sequence state
     isSequence = false;
@@ -688,11 +755,14 @@ void PreviewOverlay::showImage(const QString &filePath)
     // Try loading with OpenImageIO first for advanced formats
     QImage image;
     QPixmap newPixmap;
+    displayedLinearImage = QImage();
     if (OIIOImageLoader::isOIIOSupported(filePath)) {
-        // Load at full resolution for preview (no size limit) with current color space
-        image = OIIOImageLoader::loadImage(filePath, 0, 0, currentColorSpace);
+        // Load at full resolution for preview (no size limit); HDR stays scene-linear
+        // so colour space and exposure changes only re-run the view transform
+        image = OIIOImageLoader::loadImageReducedLinear(filePath, QSize());
         if (!image.isNull()) {
-            newPixmap = QPixmap::fromImage(image);
+            newPixmap = toDisplayPixmap(image);
+            if (DisplayTransform::isLinear(image)) isHDRImage = true; // e.g. float TIFF
         } else {
             qWarning() << "[PreviewOverlay::showImage] OIIO failed to load:" << filePath;
         }
@@ -702,6 +772,7 @@ void PreviewOverlay::showImage(const QString &filePath)
     if (newPixmap.isNull()) {
         newPixmap = QPixmap(filePath);
         isHDRImage = false; // Qt loader doesn't support HDR
+        displayedLinearImage = QImage();
     }
 
 
@@ -738,10 +809,12 @@ void PreviewOverlay::showImage(const QString &filePath)
     if (isHDRImage) {
         colorSpaceLabel->show();
         colorSpaceCombo->show();
+        viewTransformControls->show();
         controlsWidget->show();
     } else {
         colorSpaceLabel->hide();
         colorSpaceCombo->hide();
+        viewTransformControls->hide();
         controlsWidget->hide();
     }
     } else {
@@ -755,6 +828,11 @@ void PreviewOverlay::showVideo(const QString &filePath)
 {
     // Stop any existing playback
     m_gstreamerPlayer->stop();
+    videoMemoryFrameShown = false;
+    {
+        QSettings s("AugmentCode", "KAssetManager");
+        m_gstreamerPlayer->setFrameRingBudget(qint64(qBound(64, s.value("VideoPlayback/ReverseBufferMB", 512).toInt(), 16384)) * 1024 * 1024);
+    }
 
     // Hide other content and show video widget
     if (textView) textView->hide();
@@ -794,12 +872,33 @@ void PreviewOverlay::showVideo(const QString &filePath)
     // Hide colorspace selector for videos (GStreamer handles colorspace automatically)
     if (colorSpaceLabel) colorSpaceLabel->hide();
     if (colorSpaceCombo) colorSpaceCombo->hide();
+    if (viewTransformControls) viewTransformControls->hide();
 
     originalPixmap = QPixmap(); // Clear the pixmap
+    displayedLinearImage = QImage();
     fitPending = true;
 
+    // Play from the proxy when there is one; pausing switches to the source
+    ProxyManager& proxies = ProxyManager::instance();
+    videoSourcePath = filePath;
+    videoProxyPath = proxies.videoProxy(filePath);
+    if (videoProxyPath.isEmpty() && proxies.autoGenerate()) proxies.requestVideo(filePath);
+    videoOnProxy = !videoProxyPath.isEmpty();
+    pendingVideoSeekMs = -1;
+
+    // Waveform of the source's audio: instant when the peak file exists, otherwise built
+    // in the background and shown from onWaveformReady()
+    if (auto peaks = WaveformCache::instance().peaks(filePath)) {
+        waveformWidget->setPeaks(peaks);
+        setWaveformVisible(true);
+    } else {
+        waveformWidget->clear();
+        setWaveformVisible(false);
+        WaveformCache::instance().request(filePath);
+    }
+
     // Load and play video with GStreamer
-    m_gstreamerPlayer->loadMedia(filePath);
+    m_gstreamerPlayer->loadMedia(videoOnProxy ? videoProxyPath : filePath);
     m_gstreamerPlayer->play();
 
     controlsTimer->start();
@@ -816,8 +915,15 @@ void PreviewOverlay::onPlayPauseClicked()
         }
     } else {
         // Handle video playback with GStreamer
-        if (m_gstreamerPlayer->state() == GStreamerPlayer::PlaybackState::Playing) {
+        if (m_gstreamerPlayer->isPlayingReverse()) {
+            m_gstreamerPlayer->pause();
+            updatePlayPauseButton();
+        } else if (m_gstreamerPlayer->state() == GStreamerPlayer::PlaybackState::Playing) {
             m_gstreamerPlayer->pause();
+            // Paused: show the full-resolution source at the same position
+            if (videoOnProxy) switchVideoSource(false, false);
+        } else if (!videoOnProxy && !videoProxyPath.isEmpty()) {
+            switchVideoSource(true, true);
         } else {
             m_gstreamerPlayer->play();
         }
@@ -834,8 +940,8 @@ void PreviewOverlay::onSliderMoved(int position)
         return;
     }
 
-    // GStreamer path - always do live scrubbing
-    m_gstreamerPlayer->seek(position);
+    // GStreamer path - live scrubbing lands on keyframes; the release does the exact seek
+    m_gstreamerPlayer->seek(position, GStreamerPlayer::SeekMode::Keyframe);
     controlsTimer->start();
 }
 
@@ -866,6 +972,8 @@ void PreviewOverlay::onSliderPressed()
 
     wasPlayingBeforeSeek = (m_gstreamerPlayer->state() == GStreamerPlayer::PlaybackState::Playing);
     m_gstreamerPlayer->pause();
+    // Scrub the proxy; onSliderReleased() returns to the source if playback stays paused
+    if (!videoOnProxy && !videoProxyPath.isEmpty()) switchVideoSource(true, false);
 }
 
 void PreviewOverlay::onSliderReleased()
@@ -879,8 +987,9 @@ void PreviewOverlay::onSliderReleased()
         return;
     }
 
-    m_gstreamerPlayer->seek(pos);
+    m_gstreamerPlayer->seek(pos, GStreamerPlayer::SeekMode::Accurate);
     if (wasPlayingBeforeSeek) m_gstreamerPlayer->play();
+    else if (videoOnProxy) switchVideoSource(false, false);
     userSeeking = false;
     controlsTimer->start();
 }
@@ -889,7 +998,7 @@ void PreviewOverlay::onStepNextFrame()
 {
     if (isSequence) {
         // Always pause playback when stepping frames
-        if (sequencePlaying) pauseSequence();
+        if (sequencePlaying) pauseSequence(false);
         int nextIdx = qMin(positionSlider->value() + 1, positionSlider->maximum());
         loadSequenceFrame(nextIdx);
         // Keep paused after stepping
@@ -904,7 +1013,7 @@ void PreviewOverlay::onStepPrevFrame()
 {
     if (isSequence) {
         // Always pause playback when stepping frames
-        if (sequencePlaying) pauseSequence();
+        if (sequencePlaying) pauseSequence(false);
         int prevIdx = qMax(positionSlider->value() - 1, positionSlider->minimum());
         loadSequenceFrame(prevIdx);
         // Keep paused after stepping
@@ -946,7 +1055,9 @@ void PreviewOverlay::updatePlayPauseButton()
     if (isSequence) {
         playPauseBtn->setIcon(sequencePlaying ? pauseIcon : playIcon);
     } else {
-        playPauseBtn->setIcon(m_gstreamerPlayer->state() == GStreamerPlayer::PlaybackState::Playing ? pauseIcon : playIcon);
+        const bool running = m_gstreamerPlayer->state() == GStreamerPlayer::PlaybackState::Playing
+                             || m_gstreamerPlayer->isPlayingReverse();
+        playPauseBtn->setIcon(running ? pauseIcon : playIcon);
     }
 }
 void PreviewOverlay::positionNavButtons(QWidget* container)
@@ -1128,6 +1239,45 @@ void PreviewOverlay::keyPressEvent(QKeyEvent *event)
         case Qt::Key_Comma: // ',' previous frame
             if (isVideo || isSequence) { onStepPrevFrame(); return; }
             break;
+        case Qt::Key_J: // play backward
+        case Qt::Key_L: // play forward
+            if (isVideo && !isSequence) {
+                const bool playing = m_gstreamerPlayer->state() == GStreamerPlayer::PlaybackState::Playing;
+                if (event->key() == Qt::Key_J) {
+                    if (playing) onPlayPauseClicked(); // may switch from the proxy to the source
+                    if (pendingVideoSeekMs >= 0) pendingVideoReverse = true;
+                    else m_gstreamerPlayer->playReverse();
+                } else if (!playing) {
+                    onPlayPauseClicked();
+                }
+                updatePlayPauseButton();
+                return;
+            }
+            if (isSequence) {
+                sequenceDirection = event->key() == Qt::Key_J ? -1 : 1;
+                if (sequencePlaying && frameCache && useCacheForSequences) frameCache->setPlaybackDirection(sequenceDirection);
+                if (!sequencePlaying) playSequence();
+                return;
+            }
+            break;
+        case Qt::Key_K: // pause
+            if (isVideo && !isSequence) {
+                pendingVideoReverse = false;
+                if (m_gstreamerPlayer->state() == GStreamerPlayer::PlaybackState::Playing) onPlayPauseClicked();
+                else m_gstreamerPlayer->pause(); // ends reverse playback
+                updatePlayPauseButton();
+                return;
+            }
+            if (isSequence) { if (sequencePlaying) pauseSequence(); return; }
+            break;
+        case Qt::Key_P: // toggle ping-pong looping
+            if (isSequence) {
+                sequencePingPong = !sequencePingPong;
+                if (frameCache && useCacheForSequences) frameCache->setPingPong(sequencePingPong);
+                qDebug() << "[PreviewOverlay] Ping-pong playback" << (sequencePingPong ? "on" : "off");
+                return;
+            }
+            break;
 #ifdef HAVE_QT_PDF
         case Qt::Key_Up:
             if ((currentFileType == "pdf" || currentFileType == "ai") && pdfDoc && pdfDoc->pageCount() > 1) {
@@ -1220,6 +1370,12 @@ bool PreviewOverlay::eventFilter(QObject* watched, QEvent* event)
         }
     }
 
+    // Double-clicking the exposure value resets it
+    if (watched == exposureLabel && event->type() == QEvent::MouseButtonDblClick) {
+        if (exposureSlider) exposureSlider->setValue(0);
+        return true;
+    }
+
     // Drag-and-drop from overlay preview is disabled
     // (User requested to disable DnD from full screen preview player)
 
@@ -1248,7 +1404,10 @@ bool PreviewOverlay::eventFilter(QObject* watched, QEvent* event)
             keyEvent->key() == Qt::Key_Left ||
             keyEvent->key() == Qt::Key_Right ||
             keyEvent->key() == Qt::Key_Period ||
-            keyEvent->key() == Qt::Key_Comma) {
+            keyEvent->key() == Qt::Key_Comma ||
+            keyEvent->key() == Qt::Key_J ||
+            keyEvent->key() == Qt::Key_K ||
+            keyEvent->key() == Qt::Key_L) {
             keyPressEvent(keyEvent);
             return true; // consume event
         }
@@ -1303,10 +1462,21 @@ void PreviewOverlay::showSequence(const QStringList &framePaths, const QString &
     isSequence = true;
     isVideo = false;
     sequenceFramePaths = framePaths;
+    sequenceSourceSize = QSize();
+    sequenceProxyPaths = ProxyManager::instance().sequenceProxyFrames(framePaths);
+    if (sequenceProxyPaths.isEmpty() && ProxyManager::instance().autoGenerate()) {
+        ProxyManager::instance().requestSequence(framePaths);
+    }
+    videoSourcePath.clear();
+    videoProxyPath.clear();
+    videoOnProxy = false;
+    pendingVideoSeekMs = -1;
+    setWaveformVisible(false);
     sequenceStartFrame = startFrame;
     sequenceEndFrame = endFrame;
     currentSequenceFrame = 0;
     sequencePlaying = false;
+    sequenceDirection = 1;
 
     // Check if this is an HDR/EXR sequence
     if (!framePaths.isEmpty()) {
@@ -1373,17 +1543,22 @@ void PreviewOverlay::showSequence(const QStringList &framePaths, const QString &
             colorSpaceCombo->blockSignals(false);
         }
     }
+    displayTransform.setColorSpace(currentColorSpace);
+    if (viewTransformControls) viewTransformControls->setVisible(isHDRImage);
 
     // Clear cached frame visualization
     positionSlider->clearCachedFrames();
 
     // Initialize frame cache for this sequence (only if enabled)
     if (frameCache && useCacheForSequences) {
-        frameCache->setSequence(framePaths, currentColorSpace);
-        qDebug() << "[PreviewOverlay] Frame cache initialized for sequence with" << framePaths.size() << "frames";
+        frameCache->setSequence(sequencePlaybackPaths());
+        qDebug() << "[PreviewOverlay] Frame cache initialized for sequence with" << framePaths.size() << "frames"
+                 << (sequenceProxyPaths.isEmpty() ? "" : "(proxy)");
 
         // Prepare to receive cache progress updates (disconnect to avoid duplicates)
         disconnect(frameCache, &SequenceFrameCache::frameCached, nullptr, nullptr);
+        disconnect(frameCache, &SequenceFrameCache::cacheSnapshot, nullptr, nullptr);
+        disconnect(frameCache, &SequenceFrameCache::statsChanged, nullptr, nullptr);
         // We no longer paint cache on the slider; only the cache bar reflects caching
 
         // Update the separate cache bar as frames are cached (incremental)
@@ -1403,6 +1578,26 @@ void PreviewOverlay::showSequence(const QStringList &framePaths, const QString &
             cacheBar->setCachedFrames(frames);
             cacheBar->show();
         });
+        // Hit rate, decode latency and memory use are shown on the cache bar's tooltip
+        connect(frameCache, &SequenceFrameCache::statsChanged, this, [this](const SequenceFrameCache::Stats& st){
+            if (!cacheBar) return;
+            const qint64 lookups = st.hits + st.misses;
+            cacheBar->setToolTip(QString("Cache: %1 frames, %2 / %3 MB, %4 ahead\n"
+                                         "Hits: %5 of %6 (%7%)\n"
+                                         "Decode: %8 ms/frame, ~%9 fps (target %10)")
+                                     .arg(st.cachedFrames)
+                                     .arg(st.bytes / (1024 * 1024))
+                                     .arg(st.budgetBytes / (1024 * 1024))
+                                     .arg(st.leadFrames)
+                                     .arg(st.hits)
+                                     .arg(lookups)
+                                     .arg(lookups > 0 ? 100.0 * st.hits / lookups : 0.0, 0, 'f', 1)
+                                     .arg(st.avgDecodeMs, 0, 'f', 1)
+                                     .arg(st.decodeFps, 0, 'f', 1)
+                                     .arg(st.targetFps, 0, 'f', 0));
+        });
+        frameCache->setPingPong(sequencePingPong);
+        frameCache->setTargetFps(sequenceFps);
         // Start pre-fetching immediately (this will load frames in background)
         frameCache->startPrefetch(0);
         qDebug() << "[PreviewOverlay] Started pre-fetching frames from index 0";
@@ -1419,19 +1614,15 @@ void PreviewOverlay::showSequence(const QStringList &framePaths, const QString &
     if (!sequenceFramePaths.isEmpty()) {
         // For the first frame, load it directly (not from cache) to ensure immediate display
         QString framePath = sequenceFramePaths[0];
-        QImage image;
-        if (OIIOImageLoader::isOIIOSupported(framePath)) {
-            image = OIIOImageLoader::loadImage(framePath, 0, 0, currentColorSpace);
-            if (!image.isNull()) {
-                originalPixmap = QPixmap::fromImage(image);
-            }
-        }
-        if (originalPixmap.isNull()) {
-            originalPixmap = QPixmap(framePath);
+        originalPixmap = QPixmap();
+        const QImage image = OIIOImageLoader::loadImageReducedLinear(framePath, QSize());
+        if (!image.isNull()) {
+            originalPixmap = toDisplayPixmap(image);
         }
 
         // Display the first frame
         if (!originalPixmap.isNull()) {
+            sequenceSourceSize = originalPixmap.size();
             imageScene->clear();
             imageItem = imageScene->addPixmap(originalPixmap);
     // Initialize cache bar for sequence
@@ -1442,6 +1633,8 @@ void PreviewOverlay::showSequence(const QStringList &framePaths, const QString &
     }
             imageScene->setSceneRect(originalPixmap.rect());
             fitImageToView();
+            // Prefetch at the resolution the fitted view actually shows
+            if (frameCache && useCacheForSequences) frameCache->setDecodeSize(sequenceDecodeSize());
         }
     }
 
@@ -1468,17 +1661,24 @@ void PreviewOverlay::loadSequenceFrame(int frameIndex)
     }
 
     currentSequenceFrame = frameIndex;
-    QPixmap newPixmap;
+    QImage cachedFrame;
+
+    // Playback runs from proxies and reduced-resolution decodes; a paused view always
+    // shows the full-resolution source frame for pixel inspection
+    const bool paused = !sequencePlaying && !userSeeking;
+    const bool useCache = frameCache && useCacheForSequences;
+    bool inspectSource = paused && !sequenceProxyPaths.isEmpty();
 
     // Try to get frame from cache first (only if cache is enabled)
-    if (frameCache && useCacheForSequences) {
-        newPixmap = frameCache->getFrame(frameIndex);
+    if (useCache && !inspectSource) {
+        if (!paused) frameCache->setDecodeSize(sequenceDecodeSize());
+        cachedFrame = frameCache->getFrame(frameIndex);
 
         // Update cache's current frame position for pre-fetching
         frameCache->setCurrentFrame(frameIndex);
 
-        // If cache returned empty pixmap (frame not ready), pause playback and wait
-        if (newPixmap.isNull()) {
+        // If cache returned a null frame (not ready), pause playback and wait
+        if (cachedFrame.isNull()) {
             // Keep realtime cadence: do NOT pause the timer.
             // Maintain last displayed frame and just update UI positions.
             positionSlider->blockSignals(true);
@@ -1488,40 +1688,44 @@ void PreviewOverlay::loadSequenceFrame(int frameIndex)
             return; // skip displaying until frame becomes ready; timer continues
         }
 
-        // Frame is ready from cache, use it
-        originalPixmap = newPixmap;
-    } else {
-        // Original implementation: load directly from disk
-        QString framePath = sequenceFramePaths[frameIndex];
-        QImage image;
-        if (OIIOImageLoader::isOIIOSupported(framePath)) {
-            image = OIIOImageLoader::loadImage(framePath, 0, 0, currentColorSpace);
-            if (!image.isNull()) {
-                originalPixmap = QPixmap::fromImage(image);
-            } else {
-                qWarning() << "[PreviewOverlay::loadSequenceFrame] OIIO failed to load frame";
-            }
+        if (paused && sequenceSourceSize.isValid() && cachedFrame.width() < sequenceSourceSize.width()) {
+            inspectSource = true;
+        } else {
+            // Frame is ready from cache, use it
+            originalPixmap = toDisplayPixmap(cachedFrame);
         }
+    }
 
-        // Fall back to Qt loader
-        if (originalPixmap.isNull()) {
-            originalPixmap = QPixmap(framePath);
-            if (originalPixmap.isNull()) {
-                qWarning() << "[PreviewOverlay::loadSequenceFrame] Qt failed to load frame";
-            }
+    if (!useCache || inspectSource) {
+        // Load directly from disk
+        const QString framePath = inspectSource || sequenceProxyPaths.isEmpty() ? sequenceFramePaths[frameIndex]
+                                                                                : sequenceProxyPaths[frameIndex];
+        QElapsedTimer decodeTimer;
+        decodeTimer.start();
+        const QImage image = OIIOImageLoader::loadImageReducedLinear(framePath, paused ? QSize() : sequenceDecodeSize());
+        if (sequencePlaying) playbackStats.addDecodeTime(decodeTimer.nsecsElapsed() / 1.0e6);
+        if (!image.isNull()) {
+            originalPixmap = toDisplayPixmap(image);
+        } else {
+            qWarning() << "[PreviewOverlay::loadSequenceFrame] Failed to load frame:" << framePath;
         }
     }
 
     if (!originalPixmap.isNull()) {
+        // Proxy and reduced-resolution frames are drawn scaled up to the source size, so
+        // zoom and pan carry over when the paused view switches to the full-resolution frame
+        const bool upscaled = sequenceSourceSize.isValid() && originalPixmap.width() < sequenceSourceSize.width();
+        const QSize shownSize = upscaled ? sequenceSourceSize : originalPixmap.size();
         if (!imageItem) {
             imageItem = imageScene->addPixmap(originalPixmap);
         } else {
             imageItem->setPixmap(originalPixmap);
         }
+        imageItem->setScale(upscaled ? qreal(sequenceSourceSize.width()) / originalPixmap.width() : 1.0);
         // Only update scene rect if size changed
-        if (lastFrameSize != originalPixmap.size()) {
-            imageScene->setSceneRect(originalPixmap.rect());
-            lastFrameSize = originalPixmap.size();
+        if (lastFrameSize != shownSize) {
+            imageScene->setSceneRect(QRectF(QPointF(0, 0), QSizeF(shownSize)));
+            lastFrameSize = shownSize;
             // Ensure fit on first frame or when dimensions change
             fitPending = true;
         }
@@ -1544,7 +1748,12 @@ void PreviewOverlay::loadSequenceFrame(int frameIndex)
             if (elapsed >= 500) { // update twice per second
                 double fps = (sequenceFpsFrames * 1000.0) / qMax<qint64>(1, elapsed);
                 currentPlaybackFps = fps;
-                if (fpsLabel) fpsLabel->setText(QString::number(fps, 'f', 1) + " fps");
+                if (fpsLabel) {
+                    QString text = QString::number(fps, 'f', 1) + " fps";
+                    if (playbackStats.dropped > 0) text += QString(" \u00B7 %1 dropped").arg(playbackStats.dropped);
+                    fpsLabel->setText(text);
+                    fpsLabel->setToolTip(playbackStats.summary(sequenceFps, frameCache ? frameCache->stats().avgDecodeMs : 0.0));
+                }
                 sequenceFpsFrames = 0;
                 sequenceFpsTimer.restart();
             }
@@ -1581,7 +1790,7 @@ void PreviewOverlay::playSequence()
     if (requireFullWarm) {
         // If RAM cache is enabled, warm the FULL cache window before starting
         if (frameCache && useCacheForSequences) {
-            const int target = qMin(frameCache->maxCacheSize(), positionSlider ? (positionSlider->maximum()+1) : sequenceFramePaths.size());
+            const int target = frameCache->capacityFrames();
             if (frameCache->cachedFrameCount() < target) {
                 frameCache->startPrefetch(currentSequenceFrame);
                 QTimer::singleShot(15, this, &PreviewOverlay::playSequence);
@@ -1590,16 +1799,26 @@ void PreviewOverlay::playSequence()
         }
     }
 
+    {
+        QSettings s("AugmentCode", "KAssetManager");
+        sequenceDropFrames = s.value("SequencePlayback/DropFrames", true).toBool();
+    }
+
     sequencePlaying = true;
+    restartSequenceClock();
     sequenceTimer->start();
     updatePlayPauseButton();
 
     // Keep prefetching while playing (only if cache is enabled)
     if (frameCache && useCacheForSequences) {
+        frameCache->setDecodeSize(sequenceDecodeSize());
+        frameCache->setPlaybackDirection(sequenceDirection);
+        frameCache->setPingPong(sequencePingPong);
         frameCache->startPrefetch(currentSequenceFrame);
-        qDebug() << "[PreviewOverlay] Playing sequence at 25 fps with pre-fetching enabled";
+        qDebug() << "[PreviewOverlay] Playing sequence at" << sequenceFps << "fps with pre-fetching enabled"
+                 << (sequenceDropFrames ? "(drop frames)" : "(wait for frames)");
     } else {
-        qDebug() << "[PreviewOverlay] Playing sequence at 25 fps (cache disabled)";
+        qDebug() << "[PreviewOverlay] Playing sequence at" << sequenceFps << "fps (cache disabled)";
     }
 
     // Start FPS measurement
@@ -1608,12 +1827,20 @@ void PreviewOverlay::playSequence()
     if (fpsLabel) fpsLabel->setText("-- fps");
 }
 
-void PreviewOverlay::pauseSequence()
+void PreviewOverlay::pauseSequence(bool showSource)
 {
+    if (sequencePlaying) reportPlaybackStats();
     sequencePlaying = false;
     sequenceTimer->stop();
     updatePlayPauseButton();
 
+    // Swap the proxy or reduced-resolution frame on screen for the full-resolution source
+    const bool reducedOnScreen = !sequenceProxyPaths.isEmpty()
+        || (sequenceSourceSize.isValid() && originalPixmap.width() < sequenceSourceSize.width());
+    if (showSource && reducedOnScreen && !userSeeking && isVisible()) {
+        loadSequenceFrame(currentSequenceFrame);
+    }
+
     // Keep pre-fetching running when paused so frames continue to load in background
     // This allows smooth scrubbing and instant resume
 
@@ -1621,8 +1848,58 @@ void PreviewOverlay::pauseSequence()
     if (fpsLabel) fpsLabel->setText("Paused");
 }
 
+const QStringList& PreviewOverlay::sequencePlaybackPaths() const
+{
+    return sequenceProxyPaths.isEmpty() ? sequenceFramePaths : sequenceProxyPaths;
+}
+
+QSize PreviewOverlay::sequenceDecodeSize() const
+{
+    if (!imageView || !sequenceSourceSize.isValid()) return QSize();
+    // Device pixels per source pixel; from 100% zoom on every source pixel is visible
+    const qreal coverage = imageView->transform().m11() * imageView->devicePixelRatioF();
+    int divisor = 1;
+    while (divisor < 16 && coverage * divisor * 2 <= 1.0) divisor *= 2;
+    if (divisor == 1) return QSize();
+    return QSize(qMax(1, sequenceSourceSize.width() / divisor), qMax(1, sequenceSourceSize.height() / divisor));
+}
+
+void PreviewOverlay::applyProxyAvailability(const QString& sourceKey)
+{
+    if (isSequence && !sequenceFramePaths.isEmpty() && sequenceProxyPaths.isEmpty()
+        && ProxyManager::sourceKey(sequenceFramePaths.first(), true) == sourceKey) {
+        sequenceProxyPaths = ProxyManager::instance().sequenceProxyFrames(sequenceFramePaths);
+        if (sequenceProxyPaths.isEmpty()) return;
+        qDebug() << "[PreviewOverlay] Proxy ready; sequence playback switches to it";
+        if (frameCache && useCacheForSequences) {
+            frameCache->setSequence(sequencePlaybackPaths());
+            if (cacheBar) {
+                cacheBar->clearCachedFrames();
+                cacheBar->setTotalFrames(sequenceFramePaths.size());
+            }
+            frameCache->startPrefetch(currentSequenceFrame);
+        }
+    } else if (!isSequence && !videoSourcePath.isEmpty() && videoProxyPath.isEmpty()
+               && ProxyManager::sourceKey(videoSourcePath, false) == sourceKey) {
+        // Used from the next play or scrub on
+        videoProxyPath = ProxyManager::instance().videoProxy(videoSourcePath);
+    }
+}
+
+void PreviewOverlay::switchVideoSource(bool toProxy, bool play)
+{
+    const QString path = toProxy ? videoProxyPath : videoSourcePath;
+    if (path.isEmpty()) return;
+    pendingVideoSeekMs = m_gstreamerPlayer->position();
+    pendingVideoPlay = play;
+    pendingVideoReverse = false;
+    videoOnProxy = toProxy;
+    m_gstreamerPlayer->loadMedia(path);
+}
+
 void PreviewOverlay::stopSequence()
 {
+    if (sequencePlaying) reportPlaybackStats();
     sequencePlaying = false;
     sequenceTimer->stop();
     currentSequenceFrame = 0;
@@ -1639,27 +1916,81 @@ void PreviewOverlay::stopSequence()
 
 void PreviewOverlay::onSequenceTimerTick()
 {
-    if (!isSequence || !sequencePlaying) {
+    if (!isSequence || !sequencePlaying || sequenceFramePaths.isEmpty()) {
         return;
     }
 
-    // Advance to next frame
-    currentSequenceFrame++;
+    // Frame periods elapsed on the playback clock that have not been shown yet
+    const qint64 due = qint64(sequenceClock.nsecsElapsed() * sequenceFps / 1.0e9);
+    const qint64 steps = due - sequenceClockFramesDone;
+    if (steps <= 0) {
+        return;
+    }
 
-    // Loop back to start if at end
-    if (currentSequenceFrame >= sequenceFramePaths.size()) {
-        currentSequenceFrame = 0;
-        // When looping, only kick prefetch if cache isn’t already full
-        if (frameCache && useCacheForSequences) {
-            const int need = qMin(frameCache->maxCacheSize(), sequenceFramePaths.size());
-            if (frameCache->cachedFrameCount() < need) {
-                qDebug() << "[PreviewOverlay] Sequence looped; cache not full, restarting prefetch";
-                frameCache->startPrefetch(0);
-            }
+    const bool useCache = frameCache && useCacheForSequences;
+    const int from = currentSequenceFrame;
+    int direction = sequenceDirection;
+    int target = 0;
+    if (sequenceDropFrames) {
+        // Hold real time: jump to the frame the clock says is due. Frames passed over,
+        // and a due frame the cache has not decoded yet, count as dropped.
+        target = sequenceFrameAfter(from, steps, direction);
+        playbackStats.dropped += int(steps - 1);
+        if (useCache && !frameCache->hasFrame(target)) ++playbackStats.dropped;
+    } else {
+        // Show every frame: the clock holds while the next one is not decoded yet
+        target = sequenceFrameAfter(from, 1, direction);
+        if (useCache && !frameCache->hasFrame(target)) {
+            return;
+        }
+        if (steps > 1) ++playbackStats.late;
+    }
+    sequenceClockFramesDone = due;
+
+    if (direction != sequenceDirection) {
+        // Bounced off an end in ping-pong mode
+        sequenceDirection = direction;
+        if (useCache) frameCache->setPlaybackDirection(sequenceDirection);
+    } else if (!sequencePingPong && (direction > 0 ? target < from : target > from)) {
+        // Looped back to the other end; only kick prefetch if the cache isn't already full
+        if (useCache && frameCache->cachedFrameCount() < frameCache->capacityFrames()) {
+            qDebug() << "[PreviewOverlay] Sequence looped; cache not full, restarting prefetch";
+            frameCache->startPrefetch(target);
         }
     }
 
-    loadSequenceFrame(currentSequenceFrame);
+    const bool shown = !useCache || frameCache->hasFrame(target);
+    loadSequenceFrame(target);
+    if (shown) {
+        if (sequenceFrameShownTimer.isValid()) {
+            playbackStats.addFrameTime(sequenceFrameShownTimer.nsecsElapsed() / 1.0e6);
+        } else {
+            ++playbackStats.displayed;
+        }
+        sequenceFrameShownTimer.start();
+    }
+}
+
+int PreviewOverlay::sequenceFrameAfter(int frame, qint64 steps, int& direction) const
+{
+    return SequencePlayback::frameAfter(frame, steps, direction, int(sequenceFramePaths.size()), sequencePingPong);
+}
+
+void PreviewOverlay::restartSequenceClock()
+{
+    sequenceClock.start();
+    sequenceClockFramesDone = 0;
+    sequenceFrameShownTimer.invalidate();
+    playbackStats.reset();
+}
+
+void PreviewOverlay::reportPlaybackStats()
+{
+    if (playbackStats.displayed <= 0) return;
+    const double cacheDecodeMs = frameCache ? frameCache->stats().avgDecodeMs : 0.0;
+    const QString summary = playbackStats.summary(sequenceFps, cacheDecodeMs);
+    qInfo().noquote() << "[PreviewOverlay] Playback stats:" << summary;
+    if (fpsLabel) fpsLabel->setToolTip(summary);
 }
 
 void PreviewOverlay::onColorSpaceChanged(int index)
@@ -1685,27 +2016,28 @@ void PreviewOverlay::onColorSpaceChanged(int index)
             break;
     }
 
-    // Reload current frame/image with new color space
-    if (isSequence) {
-        qDebug() << "[PreviewOverlay] Reloading sequence frame with new color space";
-
-        // Clear cache and reinitialize with new color space (only if cache is enabled)
-        if (frameCache && useCacheForSequences) {
-            frameCache->setSequence(sequenceFramePaths, currentColorSpace);
-            // Clear cache bar visualization and restart prefetch for accurate redraw
-            if (cacheBar) {
-                cacheBar->clearCachedFrames();
-                cacheBar->setTotalFrames(sequenceFramePaths.size());
-                cacheBar->show();
-            }
-            frameCache->startPrefetch(currentSequenceFrame);
-        }
+    // Decoded HDR pixels are scene-linear: only the view transform runs again
+    displayTransform.setColorSpace(currentColorSpace);
+    refreshDisplayTransform();
+}
 
-        loadSequenceFrame(currentSequenceFrame);
-    } else if (!currentFilePath.isEmpty() && isHDRImage) {
-        qDebug() << "[PreviewOverlay] Reloading image with new color space";
-        showImage(currentFilePath);
+QPixmap PreviewOverlay::toDisplayPixmap(const QImage& image)
+{
+    if (!DisplayTransform::isLinear(image)) {
+        displayedLinearImage = QImage();
+        return QPixmap::fromImage(image);
     }
+    displayedLinearImage = image;
+    return QPixmap::fromImage(displayTransform.apply(image));
+}
+
+void PreviewOverlay::refreshDisplayTransform()
+{
+    if (displayedLinearImage.isNull() || !imageItem) return;
+    originalPixmap = QPixmap::fromImage(displayTransform.apply(displayedLinearImage));
+    // The alpha view doesn't depend on the view transform
+    if (!(alphaOnlyMode && previewHasAlpha)) imageItem->setPixmap(originalPixmap);
+    imageView->viewport()->update();
 }
 
 void PreviewOverlay::stopPlayback()
@@ -1714,10 +2046,11 @@ void PreviewOverlay::stopPlayback()
 
     // Stop GStreamer video playback
     m_gstreamerPlayer->stop();
+    pendingVideoSeekMs = -1;
 
     // Stop sequence playback
     if (sequencePlaying) {
-        pauseSequence();
+        pauseSequence(false);
     }
 
     // Stop pre-fetching but keep cache intact (only if cache is enabled)
@@ -1753,6 +2086,7 @@ void PreviewOverlay::onGStreamerPositionChanged(qint64 positionMs)
     if (!positionSlider->isSliderDown()) {
         positionSlider->setValue(static_cast<int>(positionMs));
     }
+    if (waveformWidget->isVisibleTo(controlsWidget)) waveformWidget->setPosition(positionMs);
 
     qint64 durationMs = m_gstreamerPlayer->duration();
     updateVideoTimeDisplays(positionMs, durationMs);
@@ -1763,6 +2097,24 @@ void PreviewOverlay::onGStreamerDurationChanged(qint64 durationMs)
     positionSlider->setRange(0, static_cast<int>(durationMs));
 }
 
+void PreviewOverlay::onWaveformReady(const QString& filePath)
+{
+    if (isSequence || videoSourcePath.isEmpty()) return;
+    if (QFileInfo(videoSourcePath).absoluteFilePath() != filePath) return;
+    auto peaks = WaveformCache::instance().peaks(filePath);
+    if (!peaks) return;
+    waveformWidget->setPeaks(peaks);
+    waveformWidget->setPosition(m_gstreamerPlayer->position());
+    setWaveformVisible(true);
+}
+
+void PreviewOverlay::setWaveformVisible(bool visible)
+{
+    if (!waveformWidget || waveformWidget->isVisibleTo(controlsWidget) == visible) return;
+    waveformWidget->setVisible(visible);
+    controlsWidget->setFixedHeight(visible ? 110 + waveformWidget->height() + 2 : 110);
+}
+
 void PreviewOverlay::onGStreamerMediaInfo(const GStreamerPlayer::MediaInfo& info)
 {
     qDebug() << "[PreviewOverlay] GStreamer media info:"
@@ -1783,6 +2135,17 @@ void PreviewOverlay::onGStreamerMediaInfo(const GStreamerPlayer::MediaInfo& info
         detectedFps = info.fps;
         if (fpsLabel) fpsLabel->setText(QString::number(info.fps, 'f', 1) + " fps");
     }
+
+    // Finish a proxy/source switch now that the new clip has prerolled
+    if (pendingVideoSeekMs >= 0) {
+        const qint64 pos = pendingVideoSeekMs;
+        pendingVideoSeekMs = -1;
+        m_gstreamerPlayer->seek(pos);
+        if (pendingVideoPlay) m_gstreamerPlayer->play();
+        else if (pendingVideoReverse) m_gstreamerPlayer->playReverse();
+        pendingVideoReverse = false;
+        updatePlayPauseButton();
+    }
 }
 
 void PreviewOverlay::onGStreamerPlaybackStateChanged(GStreamerPlayer::PlaybackState state)
@@ -1819,6 +2182,45 @@ void PreviewOverlay::onGStreamerEndOfStream()
     if (playPauseBtn) playPauseBtn->setIcon(playIcon);
 }
 
+void PreviewOverlay::onGStreamerMemoryFrame(const QImage& frame, qint64 positionMs)
+{
+    Q_UNUSED(positionMs);
+    if (!isVideo || isSequence || frame.isNull()) return;
+
+    const QPixmap pixmap = QPixmap::fromImage(frame);
+    if (imageItem) {
+        imageItem->setPixmap(pixmap);
+    } else {
+        imageScene->clear();
+        imageItem = imageScene->addPixmap(pixmap);
+    }
+    originalPixmap = pixmap;
+    if (!videoMemoryFrameShown) {
+        // The native video window cannot be painted over; swap to the image view
+        videoMemoryFrameShown = true;
+        videoWidget->hide();
+        imageView->setBackgroundBrush(QColor("#000000"));
+        imageView->show();
+        imageScene->setSceneRect(pixmap.rect());
+        fitImageToView();
+        positionNavButtons(imageView->viewport());
+    }
+    imageView->viewport()->update();
+}
+
+void PreviewOverlay::onGStreamerMemoryFrameCleared()
+{
+    if (!videoMemoryFrameShown) return;
+    videoMemoryFrameShown = false;
+    originalPixmap = QPixmap();
+    // Only swap back while the video is still the thing on screen
+    if (!isVideo || isSequence) return;
+    imageView->hide();
+    videoWidget->show();
+    m_gstreamerPlayer->updateRenderRectangle();
+    positionNavButtons(videoWidget);
+}
+
 void PreviewOverlay::showText(const QString &filePath)
 {
     // Hide other content
@@ -2068,46 +2470,40 @@ void PreviewOverlay::moveEvent(QMoveEvent *event)
 // SequenceFrameCache Implementation
 // ============================================================================
 
+// Upper bound on cached frames when sizing automatically; the byte budget is the real limit
+static constexpr int kAutoMaxCachedFrames = 2000;
+
 SequenceFrameCache::SequenceFrameCache(QObject *parent)
     : QObject(parent)
-    , m_colorSpace(OIIOImageLoader::ColorSpace::sRGB)
-    , m_cache(100 * 50 * 1024) // Max cost in KB: will be updated based on settings
     , m_threadPool(QThreadPool::globalInstance())
-    , m_maxCacheSize(100)
+    , m_maxCacheSize(kAutoMaxCachedFrames)
     , m_currentFrame(0)
     , m_prefetchActive(false)
     , m_epoch(1)
 {
     // Using global thread pool; do not modify its thread count here to avoid side effects.
+    qRegisterMetaType<SequenceFrameCache::Stats>("SequenceFrameCache::Stats");
 
-    // Load cache size from settings
+    // Frames are charged at their real size against a share of available RAM;
+    // a manual size additionally caps the number of frames
     QSettings s("AugmentCode", "KAssetManager");
-    bool autoSize = s.value("SequenceCache/AutoSize", true).toBool();
-
-    if (autoSize) {
-        // Calculate based on available RAM
-        int autoPercent = s.value("SequenceCache/AutoPercent", 70).toInt();
-        m_maxCacheSize = calculateOptimalCacheSize(autoPercent);
-    } else {
-        // Use manual size
-        m_maxCacheSize = s.value("SequenceCache/ManualSize", 100).toInt();
+    const bool autoSize = s.value("SequenceCache/AutoSize", true).toBool();
+    const int autoPercent = qBound(10, s.value("SequenceCache/AutoPercent", 70).toInt(), 90);
+    if (!autoSize) {
+        m_maxCacheSize = qMax(1, s.value("SequenceCache/ManualSize", 100).toInt());
     }
+    setMemoryBudgetMB(getAvailableRAM() * autoPercent / 100);
 
-    // Update cache max cost based on calculated size
-    // Assume 50MB per frame average
-    int maxCostKB = m_maxCacheSize * 50 * 1024;
-    m_cache.setMaxCost(maxCostKB);
+    // Encoded frames read ahead of the decoders; compressed frames are far smaller than decoded ones
+    m_readAhead = std::make_shared<SequenceReadAhead>(s.value("SequenceCache/ReadAheadThreads", 2).toInt());
+    m_readAhead->setLimits(qint64(s.value("SequenceCache/ReadAheadMB", 512).toInt()) * 1024 * 1024, 32);
 
     qDebug() << "[SequenceFrameCache] ========================================";
     qDebug() << "[SequenceFrameCache] INITIALIZATION:";
     qDebug() << "[SequenceFrameCache]   Max cache size:" << m_maxCacheSize << "frames";
-    qDebug() << "[SequenceFrameCache]   Max cost:" << maxCostKB << "KB (" << (maxCostKB / 1024) << "MB)";
+    qDebug() << "[SequenceFrameCache]   Memory budget:" << (m_budgetKB / 1024) << "MB (" << autoPercent << "% of available RAM )";
     qDebug() << "[SequenceFrameCache]   Worker threads:" << m_threadPool->maxThreadCount();
     qDebug() << "[SequenceFrameCache]   Auto-size:" << (autoSize ? "YES" : "NO");
-    if (autoSize) {
-        int autoPercent = s.value("SequenceCache/AutoPercent", 70).toInt();
-        qDebug() << "[SequenceFrameCache]   RAM percentage:" << autoPercent << "%";
-    }
     qDebug() << "[SequenceFrameCache] ========================================";
 }
 
@@ -2131,23 +2527,27 @@ SequenceFrameCache::~SequenceFrameCache()
     qDebug() << "[SequenceFrameCache::~SequenceFrameCache] Destructor complete";
 }
 
-void SequenceFrameCache::setSequence(const QStringList &framePaths, OIIOImageLoader::ColorSpace colorSpace)
+void SequenceFrameCache::setSequence(const QStringList &framePaths)
 {
     QMutexLocker locker(&m_mutex);
     stopPrefetch();
     clearCache();
     m_framePaths = framePaths;
-    m_colorSpace = colorSpace;
     m_currentFrame = 0;
-    m_windowStart = 0;
-    m_windowEnd = qMax(-1, qMin((int)framePaths.size()-1, m_maxCacheSize-1));
-    m_nextToEnqueue = m_windowStart;
+    m_direction = 1;
+    // Frame size and decode speed are measured afresh for every sequence
+    m_avgFrameKB = 0.0;
+    m_avgDecodeMs = 0.0;
+    m_hits = 0;
+    m_misses = 0;
+    m_readAhead->clear();
     // Load optional concurrency setting
     {
         QSettings s("AugmentCode", "KAssetManager");
         int conc = s.value("SequenceCache/PrefetchConcurrency", 4).toInt();
         m_prefetchConcurrency = qMax(1, conc);
     }
+    updateWindowLocked();
     qDebug() << "[SequenceFrameCache] Set sequence with" << framePaths.size() << "frames";
 }
 
@@ -2160,25 +2560,28 @@ void SequenceFrameCache::clearCache()
     emit cacheSnapshot(QSet<int>());
 }
 
-QPixmap SequenceFrameCache::getFrame(int frameIndex)
+QImage SequenceFrameCache::getFrame(int frameIndex)
 {
-    QMutexLocker locker(&m_mutex);
+    QImage frame;
+    {
+        QMutexLocker locker(&m_mutex);
 
-    if (frameIndex < 0 || frameIndex >= m_framePaths.size()) {
-        qWarning() << "[SequenceFrameCache::getFrame] Invalid frame index:" << frameIndex;
-        return QPixmap();
-    }
+        if (frameIndex < 0 || frameIndex >= m_framePaths.size()) {
+            qWarning() << "[SequenceFrameCache::getFrame] Invalid frame index:" << frameIndex;
+            return QImage();
+        }
 
-    // Check if frame is in cache
-    QPixmap *cached = m_cache.object(frameIndex);
-    if (cached) {
-        // Cache hit - return the frame
-        return *cached;
+        // Cache miss returns a null image (non-blocking);
+        // the pre-fetcher will load this frame in the background
+        if (QImage *cached = m_cache.object(frameIndex)) {
+            frame = *cached;
+            ++m_hits;
+        } else {
+            ++m_misses;
+        }
     }
-
-    // Cache miss - return empty pixmap (non-blocking)
-    // The pre-fetcher will load this frame in the background
-    return QPixmap();
+    emitStatsThrottled();
+    return frame;
 }
 
 bool SequenceFrameCache::hasFrame(int frameIndex) const
@@ -2192,6 +2595,7 @@ void SequenceFrameCache::startPrefetch(int currentFrame)
     QMutexLocker locker(&m_mutex);
     m_prefetchActive = true;
     m_currentFrame = currentFrame;
+    updateWindowLocked();
     locker.unlock();
 
     prefetchFrames(currentFrame);
@@ -2204,65 +2608,178 @@ void SequenceFrameCache::stopPrefetch()
     m_prefetchActive = false;
     m_pendingFrames.clear();
     m_epoch.fetch_add(1, std::memory_order_relaxed);
+    m_readAhead->setQueue(QStringList());
 }
 
 void SequenceFrameCache::setCurrentFrame(int frameIndex)
 {
     QMutexLocker locker(&m_mutex);
 
-    // Detect if we've jumped backwards significantly (e.g., looping from end to start)
-    bool hasLooped = (m_currentFrame > frameIndex) && (m_currentFrame - frameIndex > 50);
+    const int total = m_framePaths.size();
+    const int delta = frameIndex - m_currentFrame;
+    if (delta == 0) return;
 
-    if (hasLooped) {
-        // Don't clear cache on loop - just let it continue with existing frames
-        // The prefetch will load any missing frames from the new position
+    // Steps and scrubs reveal the direction; loop wraps and long jumps don't
+    if (qAbs(delta) <= qMax(1, total / 2)) {
+        m_direction = delta > 0 ? 1 : -1;
     }
+    m_currentFrame = frameIndex;
 
-    // Strict sliding window forward: [windowStart .. windowEnd]
-    const int total = m_framePaths.size();
-    const int window = qMin(m_maxCacheSize, total);
-    int desiredStart = qBound(0, frameIndex, qMax(0, total - window));
-    int desiredEnd = qMin(total - 1, desiredStart + window - 1);
-    if (desiredStart != m_windowStart || desiredEnd != m_windowEnd) {
-        m_windowStart = desiredStart;
-        m_windowEnd = desiredEnd;
-        // Ensure next enqueue pointer is at least current frame
-        m_nextToEnqueue = qMax(m_nextToEnqueue, m_windowStart);
-        // Hard-evict anything outside the window to prevent fragmentation
-        QList<int> keys;
-        for (int i = 0; i < total; ++i) {
-            if (m_cache.contains(i) && (i < m_windowStart || i > m_windowEnd)) keys.append(i);
-        }
-        for (int k : keys) m_cache.remove(k);
-        m_pendingFrames.clear();
-        // Emit fresh snapshot limited to window
-        QSet<int> snap;
-        for (int i = m_windowStart; i <= m_windowEnd; ++i) {
-            if (m_cache.contains(i)) snap.insert(i);
-        }
-        emit cacheSnapshot(snap);
+    if (updateWindowLocked()) {
+        emit cacheSnapshot(cachedFramesLocked());
     }
 
-    m_currentFrame = frameIndex;
-
     if (m_prefetchActive) {
         locker.unlock();
         prefetchFrames(frameIndex);
     }
 }
 
+void SequenceFrameCache::setPlaybackDirection(int direction)
+{
+    QMutexLocker locker(&m_mutex);
+    direction = direction < 0 ? -1 : 1;
+    if (direction == m_direction) return;
+    m_direction = direction;
+    if (updateWindowLocked()) {
+        emit cacheSnapshot(cachedFramesLocked());
+    }
+    if (m_prefetchActive) {
+        locker.unlock();
+        prefetchFrames(m_currentFrame);
+    }
+}
+
+int SequenceFrameCache::playbackDirection() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_direction;
+}
+
+void SequenceFrameCache::setPingPong(bool enabled)
+{
+    QMutexLocker locker(&m_mutex);
+    if (m_pingPong == enabled) return;
+    m_pingPong = enabled;
+    if (updateWindowLocked()) {
+        emit cacheSnapshot(cachedFramesLocked());
+    }
+}
+
+void SequenceFrameCache::setTargetFps(double fps)
+{
+    QMutexLocker locker(&m_mutex);
+    m_targetFps = fps > 0.0 ? fps : 25.0;
+}
+
+void SequenceFrameCache::setDecodeSize(const QSize& size)
+{
+    QMutexLocker locker(&m_mutex);
+    const QSize decodeSize = size.isValid() && !size.isEmpty() ? size : QSize();
+    if (decodeSize == m_decodeSize) return;
+    // Cached frames stay usable when fewer pixels are needed, not when more are
+    const bool needsMorePixels = m_decodeSize.isValid()
+        && (!decodeSize.isValid() || decodeSize.width() > m_decodeSize.width() || decodeSize.height() > m_decodeSize.height());
+    m_decodeSize = decodeSize;
+    // Frame size and decode time change with the resolution
+    m_avgFrameKB = 0.0;
+    m_avgDecodeMs = 0.0;
+    if (!needsMorePixels) return;
+
+    m_cache.clear();
+    m_pendingFrames.clear();
+    m_epoch.fetch_add(1, std::memory_order_relaxed);
+    updateWindowLocked();
+    emit cacheSnapshot(QSet<int>());
+    if (m_prefetchActive) {
+        locker.unlock();
+        prefetchFrames(m_currentFrame);
+    }
+}
+
+QSize SequenceFrameCache::decodeSize() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_decodeSize;
+}
+
 void SequenceFrameCache::setMaxCacheSize(int maxFrames)
 {
     QMutexLocker locker(&m_mutex);
-    m_maxCacheSize = maxFrames;
-    m_cache.setMaxCost(maxFrames * 50 * 1024); // Assume ~50MB per frame (4K images can be large)
+    m_maxCacheSize = qMax(1, maxFrames);
+    if (updateWindowLocked()) {
+        emit cacheSnapshot(cachedFramesLocked());
+    }
+}
+
+void SequenceFrameCache::setMemoryBudgetMB(qint64 mb)
+{
+    QMutexLocker locker(&m_mutex);
+    // Never less than a couple of 4K float frames
+    m_budgetKB = qMax<qint64>(256, mb) * 1024;
+    m_cache.setMaxCost(m_budgetKB);
+    if (updateWindowLocked()) {
+        emit cacheSnapshot(cachedFramesLocked());
+    }
+}
+
+int SequenceFrameCache::capacityFrames() const
+{
+    QMutexLocker locker(&m_mutex);
+    return capacityFramesLocked();
+}
+
+int SequenceFrameCache::capacityFramesLocked() const
+{
+    qint64 capacity = qMin<qint64>(m_maxCacheSize, m_framePaths.size());
+    // Until the first frame is measured only the frame cap applies; QCache enforces the budget
+    if (m_avgFrameKB > 0.0) {
+        capacity = qMin<qint64>(capacity, qMax<qint64>(1, static_cast<qint64>(m_budgetKB / m_avgFrameKB)));
+    }
+    return static_cast<int>(capacity);
+}
+
+int SequenceFrameCache::leadFramesLocked(int capacity) const
+{
+    const int workers = qMax(1, qMin(m_prefetchConcurrency, m_threadPool->maxThreadCount()));
+    return SequencePlayback::leadFrames(capacity, workers, m_avgDecodeMs, m_targetFps);
+}
+
+bool SequenceFrameCache::updateWindowLocked()
+{
+    m_window.clear();
+    m_windowSet.clear();
+    m_leadFrames = 0;
+    const int total = m_framePaths.size();
+    if (total > 0) {
+        const int capacity = capacityFramesLocked();
+        m_leadFrames = leadFramesLocked(capacity);
+        m_window = SequencePlayback::window(m_currentFrame, m_direction, total, m_pingPong, m_leadFrames, capacity);
+        m_windowSet = QSet<int>(m_window.cbegin(), m_window.cend());
+    }
+
+    // Evict everything that fell out of the window
+    bool evicted = false;
+    const QList<int> keys = m_cache.keys();
+    for (int key : keys) {
+        if (!m_windowSet.contains(key)) {
+            m_cache.remove(key);
+            evicted = true;
+        }
+    }
+    return evicted;
+}
+
+QSet<int> SequenceFrameCache::cachedFramesLocked() const
+{
+    const QList<int> keys = m_cache.keys();
+    return QSet<int>(keys.begin(), keys.end());
 }
 
 qint64 SequenceFrameCache::currentMemoryUsageMB() const
 {
     QMutexLocker locker(&m_mutex);
-    // Estimate memory usage: number of cached frames * average frame size (30MB)
-    return static_cast<qint64>(m_cache.count() * 30);
+    return static_cast<qint64>(m_cache.totalCost() / 1024);
 }
 
 int SequenceFrameCache::cachedFrameCount() const
@@ -2271,6 +2788,33 @@ int SequenceFrameCache::cachedFrameCount() const
     return m_cache.count();
 }
 
+SequenceFrameCache::Stats SequenceFrameCache::stats() const
+{
+    QMutexLocker locker(&m_mutex);
+    Stats st;
+    st.hits = m_hits;
+    st.misses = m_misses;
+    st.avgDecodeMs = m_avgDecodeMs;
+    const int workers = qMax(1, qMin(m_prefetchConcurrency, m_threadPool->maxThreadCount()));
+    st.decodeFps = m_avgDecodeMs > 0.0 ? workers * 1000.0 / m_avgDecodeMs : 0.0;
+    st.targetFps = m_targetFps;
+    st.cachedFrames = m_cache.count();
+    st.leadFrames = m_leadFrames;
+    st.bytes = static_cast<qint64>(m_cache.totalCost()) * 1024;
+    st.budgetBytes = m_budgetKB * 1024;
+    return st;
+}
+
+void SequenceFrameCache::emitStatsThrottled()
+{
+    {
+        QMutexLocker locker(&m_mutex);
+        if (m_statsTimer.isValid() && m_statsTimer.elapsed() < 250) return;
+        m_statsTimer.restart();
+    }
+    emit statsChanged(stats());
+}
+
 void SequenceFrameCache::prefetchFrames(int startFrame)
 {
     QMutexLocker locker(&m_mutex);
@@ -2279,33 +2823,28 @@ void SequenceFrameCache::prefetchFrames(int startFrame)
     if (!m_prefetchActive || m_framePaths.isEmpty()) {
         return;
     }
+    if (startFrame != m_currentFrame) {
+        m_currentFrame = startFrame;
+        updateWindowLocked();
+    }
 
-    // Strict sequential fill within [m_windowStart..m_windowEnd]
-    const int totalFrames = m_framePaths.size();
-    if (m_windowEnd < m_windowStart || totalFrames == 0) return;
-
-    // Back up nextToEnqueue to current frame if user seeked backwards
-    if (startFrame < m_nextToEnqueue) m_nextToEnqueue = qMax(m_windowStart, startFrame);
-
+    // Fill the window in priority order: nearest lead frames first
     int inFlight = m_pendingFrames.size();
-    while (inFlight < m_prefetchConcurrency && m_nextToEnqueue <= m_windowEnd) {
-        const int idx = m_nextToEnqueue;
-        ++m_nextToEnqueue;
+    for (int pos = 0; pos < m_window.size() && inFlight < m_prefetchConcurrency; ++pos) {
+        const int idx = m_window.at(pos);
         if (m_cache.contains(idx) || m_pendingFrames.contains(idx)) continue;
-        scheduleFrameIfNeeded(idx, epoch, /*highPriority*/true);
+        scheduleFrameIfNeeded(idx, epoch, /*highPriority*/pos <= m_leadFrames);
         ++inFlight;
     }
-}
 
-bool SequenceFrameCache::isRangeMostlyCached(int start, int end, double threshold) const
-{
-    int total = qMax(0, end - start + 1);
-    if (total == 0) return true;
-    int cached = 0;
-    for (int i=start; i<=end; ++i) {
-        if (m_cache.contains(i)) ++cached;
+    // The I/O stage reads the next frames to decode, in the same order
+    const int readAheadFrames = m_prefetchConcurrency + m_readAhead->maxFrames();
+    QStringList upcoming;
+    for (int pos = 0; pos < m_window.size() && upcoming.size() < readAheadFrames; ++pos) {
+        const int idx = m_window.at(pos);
+        if (!m_cache.contains(idx)) upcoming.append(m_framePaths.at(idx));
     }
-    return (static_cast<double>(cached) / total) >= threshold;
+    m_readAhead->setQueue(upcoming);
 }
 
 void SequenceFrameCache::scheduleFrameIfNeeded(int frameIndex, quint64 epoch, bool highPriority)
@@ -2313,33 +2852,36 @@ void SequenceFrameCache::scheduleFrameIfNeeded(int frameIndex, quint64 epoch, bo
     if (m_cache.contains(frameIndex) || m_pendingFrames.contains(frameIndex) || frameIndex < 0 || frameIndex >= m_framePaths.size()) return;
     m_pendingFrames.insert(frameIndex);
     QString framePath = m_framePaths[frameIndex];
-    FrameLoaderWorker *worker = new FrameLoaderWorker(this, frameIndex, framePath, m_colorSpace, epoch);
+    FrameLoaderWorker *worker = new FrameLoaderWorker(this, frameIndex, framePath, m_decodeSize, m_readAhead, epoch);
     
     // CRITICAL: Use Qt::QueuedConnection with context object to ensure auto-disconnect
     // This prevents crashes when SequenceFrameCache is destroyed while workers are running
-    connect(worker, &FrameLoaderWorker::frameLoaded, this, [this](int idx, QPixmap pixmap) {
+    connect(worker, &FrameLoaderWorker::frameLoaded, this, [this](int idx, QImage image, double decodeMs) {
         // SAFETY: This lambda won't execute if 'this' is destroyed (Qt auto-disconnect)
+        QSet<int> snap;
         {
             QMutexLocker locker(&m_mutex);
             m_pendingFrames.remove(idx);
-            if (!pixmap.isNull() && m_prefetchActive) {
-                int cost = pixmap.width() * pixmap.height() * 4 / 1024; // KB
-                m_cache.insert(idx, new QPixmap(pixmap), cost);
-            } else if (pixmap.isNull()) {
+            if (decodeMs > 0.0) {
+                m_avgDecodeMs = m_avgDecodeMs > 0.0 ? m_avgDecodeMs * 0.8 + decodeMs * 0.2 : decodeMs;
+            }
+            if (image.isNull()) {
                 qWarning() << "[SequenceFrameCache] Failed to load frame" << idx;
+            } else if (m_prefetchActive && m_windowSet.contains(idx)) {
+                // Charge the real pixel size (8 bytes per pixel for half-float HDR frames);
+                // the running average turns the byte budget into a frame count
+                const qint64 costKB = qMax<qint64>(1, image.sizeInBytes() / 1024);
+                m_avgFrameKB = m_avgFrameKB > 0.0 ? m_avgFrameKB * 0.9 + costKB * 0.1 : double(costKB);
+                m_cache.insert(idx, new QImage(image), costKB);
+                // Frame size and decode speed feed back into the window
+                updateWindowLocked();
             }
+            snap = cachedFramesLocked();
         }
         emit frameCached(idx);
-        // Optional: emit a throttled snapshot for accurate UI; keep cheap by limiting to window
-        {
-            QSet<int> snap;
-            QMutexLocker locker(&m_mutex);
-            for (int i = m_windowStart; i <= m_windowEnd; ++i) {
-                if (m_cache.contains(i)) snap.insert(i);
-            }
-            locker.unlock();
-            emit cacheSnapshot(snap);
-        }
+        // Snapshot keeps the UI accurate when frames were evicted
+        emit cacheSnapshot(snap);
+        emitStatsThrottled();
         // Queue more work to respect concurrency limit
         QMetaObject::invokeMethod(this, [this](){ prefetchFrames(m_currentFrame); }, Qt::QueuedConnection);
     }, Qt::QueuedConnection); // EXPLICIT QueuedConnection for proper cleanup
@@ -2347,43 +2889,18 @@ void SequenceFrameCache::scheduleFrameIfNeeded(int frameIndex, quint64 epoch, bo
     m_threadPool->start(worker, highPriority ? QThread::HighestPriority : QThread::LowPriority);
 }
 
-QPixmap SequenceFrameCache::loadFrame(int frameIndex)
-{
-    if (frameIndex < 0 || frameIndex >= m_framePaths.size()) {
-        return QPixmap();
-    }
-
-    QString framePath = m_framePaths[frameIndex];
-    QImage image;
-
-    // Try OpenImageIO first for supported formats
-    if (OIIOImageLoader::isOIIOSupported(framePath)) {
-        image = OIIOImageLoader::loadImage(framePath, 0, 0, m_colorSpace);
-    }
-
-    // Fall back to Qt loader
-    if (image.isNull()) {
-        image.load(framePath);
-    }
-
-    if (image.isNull()) {
-        qWarning() << "[SequenceFrameCache] Failed to load frame:" << framePath;
-        return QPixmap();
-    }
-
-    return QPixmap::fromImage(image);
-}
-
 // ============================================================================
 // FrameLoaderWorker Implementation
 // ============================================================================
 
 FrameLoaderWorker::FrameLoaderWorker(SequenceFrameCache *cache, int frameIndex,
-                                     const QString &framePath, OIIOImageLoader::ColorSpace colorSpace, quint64 epoch)
+                                     const QString &framePath, const QSize &decodeSize,
+                                     std::shared_ptr<SequenceReadAhead> readAhead, quint64 epoch)
     : m_cache(cache)
     , m_frameIndex(frameIndex)
     , m_framePath(framePath)
-    , m_colorSpace(colorSpace)
+    , m_decodeSize(decodeSize)
+    , m_readAhead(std::move(readAhead))
     , m_epoch(epoch)
 {
     setAutoDelete(true);
@@ -2402,41 +2919,41 @@ void FrameLoaderWorker::run()
         return;
     }
 
-    QImage image;
-
-    // Try OpenImageIO first for supported formats
-    if (OIIOImageLoader::isOIIOSupported(m_framePath)) {
-        image = OIIOImageLoader::loadImage(m_framePath, 0, 0, m_colorSpace);
-        // Re-check cancellation after potentially expensive I/O
-        if (!cache->isEpochCurrent(m_epoch)) {
-            return;
-        }
-    }
-
-    // Fall back to Qt loader if needed
-    if (image.isNull()) {
-        image.load(m_framePath);
-        if (!cache->isEpochCurrent(m_epoch)) {
-            return;
-        }
+    QElapsedTimer decodeTimer;
+    decodeTimer.start();
+    // Decode from the bytes the I/O stage read ahead, or read the file here when it didn't get to it.
+    // Either way at the playback resolution; OIIO formats fall back to Qt's loaders.
+    // HDR frames stay scene-linear: the view transform is applied at display time
+    const QByteArray encoded = m_readAhead ? m_readAhead->take(m_framePath) : QByteArray();
+    if (!cache->isEpochCurrent(m_epoch)) {
+        return;
     }
+    QImage image = encoded.isEmpty()
+        ? OIIOImageLoader::loadImageReducedLinear(m_framePath, m_decodeSize)
+        : OIIOImageLoader::loadImageReducedLinear(m_framePath, encoded, m_decodeSize);
 
     if (!cache->isEpochCurrent(m_epoch)) {
         return;
     }
 
     if (!image.isNull()) {
-        QPixmap pixmap = QPixmap::fromImage(image);
+        // 8-bit frames are stored in the pixmap's native format, so display is a plain copy
+        if (!DisplayTransform::isLinear(image) && image.format() != QImage::Format_RGB32
+            && image.format() != QImage::Format_ARGB32_Premultiplied) {
+            image = image.convertToFormat(image.hasAlphaChannel() ? QImage::Format_ARGB32_Premultiplied
+                                                                   : QImage::Format_RGB32);
+        }
+        const double decodeMs = decodeTimer.nsecsElapsed() / 1e6;
         // Final check before emitting to avoid enqueuing into a stale cache
         if (cache->isEpochCurrent(m_epoch)) {
-            emit frameLoaded(m_frameIndex, pixmap);
+            emit frameLoaded(m_frameIndex, image, decodeMs);
         }
     } else {
         qWarning() << "[FrameLoaderWorker] Failed to load frame:" << m_framePath;
         // Only notify failure if still current; otherwise earlier stopPrefetch()
         // already cleared pending state for this frame.
         if (cache->isEpochCurrent(m_epoch)) {
-            emit frameLoaded(m_frameIndex, QPixmap());
+            emit frameLoaded(m_frameIndex, QImage(), 0.0);
         }
     }
 }
@@ -2485,27 +3002,3 @@ qint64 SequenceFrameCache::getAvailableRAM()
     qWarning() << "[SequenceFrameCache] Could not detect available RAM, using 8GB default";
     return 8192;
 }
-
-int SequenceFrameCache::calculateOptimalCacheSize(int percentOfFreeRAM)
-{
-    qint64 availableRAM = getAvailableRAM();
-    qDebug() << "[SequenceFrameCache] Available RAM:" << availableRAM << "MB";
-
-    // Calculate cache size based on percentage of available RAM
-    // Assume average frame size of 30MB (conservative for 4K EXR)
-    const int avgFrameSizeMB = 30;
-    qint64 cacheRAM = (availableRAM * percentOfFreeRAM) / 100;
-    int cacheFrames = static_cast<int>(cacheRAM / avgFrameSizeMB);
-
-    // Clamp to reasonable range: 10-500 frames
-    cacheFrames = qMax(10, qMin(500, cacheFrames));
-
-    qDebug() << "[SequenceFrameCache] Calculated optimal cache size:" << cacheFrames
-             << "frames (" << (cacheFrames * avgFrameSizeMB) << "MB) using"
-             << percentOfFreeRAM << "% of available RAM";
-
-    return cacheFrames;
-}
-
-
-
@@ -14,6 +14,7 @@
 #include <QGraphicsSvgItem>
 #include <QComboBox>
 #include <QCheckBox>
+#include <QDoubleSpinBox>
 #ifdef HAVE_QT_PDF
 #include <QPdfDocument>
 #include <QPdfView>
@@ -32,16 +33,21 @@
 #include <QSet>
 #include <QPointer>
 #include <atomic>
+#include <memory>
 #include <QElapsedTimer>
 
 
+#include "display_transform.h"
 #include "oiio_image_loader.h"
+#include "sequence_playback.h"
+#include "sequence_read_ahead.h"
 #include "media/gstreamer_player.h"
 
 // Forward declarations
 class SequenceFrameCache;
 
 class CacheBarWidget;
+class WaveformWidget;
 /**
  * @brief Custom timeline slider with visual cache indicators for image sequences
  *
@@ -292,6 +298,9 @@ private slots:
     void onGStreamerPlaybackStateChanged(GStreamerPlayer::PlaybackState state);
     void onGStreamerError(const QString& errorString);
     void onGStreamerEndOfStream();
+    void onGStreamerMemoryFrame(const QImage& frame, qint64 positionMs);
+    void onGStreamerMemoryFrameCleared();
+    void onWaveformReady(const QString& filePath);
 
 private:
     void setupUi();
@@ -309,14 +318,32 @@ private:
     QString formatTime(qint64 milliseconds);
     void updateVideoTimeDisplays(qint64 positionMs, qint64 durationMs);
     void updateSequenceTimeDisplays(int frameIndex, bool caching=false);
+    // Display pixmap for a decoded image; scene-linear images go through the view transform
+    // and are kept so a view change can re-map them without decoding again
+    QPixmap toDisplayPixmap(const QImage& image);
+    void refreshDisplayTransform();
+    // Frame reached after `steps` frames of playback in `direction`, wrapping or bouncing
+    // (flipping `direction`) at the ends like playback does
+    int sequenceFrameAfter(int frame, qint64 steps, int& direction) const;
+    void restartSequenceClock();
+    void reportPlaybackStats();
     void zoomImage(double factor);
     void fitImageToView();
     void resetImageZoom();
     void loadSequenceFrame(int frameIndex);
     void positionNavButtons(QWidget* container);
+    // Shows the waveform row and grows the controls bar to fit it
+    void setWaveformVisible(bool visible);
     void playSequence();
-    void pauseSequence();
+    void pauseSequence(bool showSource = true);
     void stopSequence();
+    // Frames the cache plays from: the proxy's when there is one
+    const QStringList& sequencePlaybackPaths() const;
+    // Smallest decode size that still covers the view at the current zoom (invalid: full resolution)
+    QSize sequenceDecodeSize() const;
+    void applyProxyAvailability(const QString& sourceKey);
+    // Reloads the clip from the proxy or the source at the current position
+    void switchVideoSource(bool toProxy, bool play);
     // Seeking helpers
     double frameDurationMs() const; // based on detectedFps (from metadata) or fallbackFps
     void updateDetectedFps();
@@ -333,6 +360,7 @@ private:
     QPushButton *nextFrameBtn;
     CacheBarWidget *cacheBar;
     CachedFrameSlider *positionSlider;
+    WaveformWidget *waveformWidget = nullptr; // audio peaks of the current video, hidden until built
     QLabel *currentTimeLabel;
     QLabel *durationTimeLabel;
     QLabel *fpsLabel;
@@ -343,6 +371,11 @@ private:
     QLabel *fileNameLabel;
     QComboBox *colorSpaceCombo;
     QLabel *colorSpaceLabel;
+    // Exposure (stops) and display gamma for HDR content, shown with the colour space selector
+    QWidget *viewTransformControls = nullptr;
+    QSlider *exposureSlider = nullptr;
+    QLabel *exposureLabel = nullptr;
+    QDoubleSpinBox *gammaSpin = nullptr;
     QCheckBox *alphaCheck;
     QPlainTextEdit *textView;
 
@@ -399,13 +432,32 @@ private:
     int sequenceEndFrame;
     QTimer *sequenceTimer;
     bool sequencePlaying;
+    int sequenceDirection = 1;     // +1 forward, -1 reverse (J/L keys)
+    bool sequencePingPong = false; // bounce at the ends instead of looping (P key)
     SequenceFrameCache *frameCache;
     bool useCacheForSequences; // Flag to enable/disable cache (disabled by default)
 
-
-    // Color space for HDR/EXR images
+    // Playback proxies (ProxyManager) drive playback and scrubbing; whenever playback
+    // is paused the full-resolution source is shown so pixels can be inspected
+    QStringList sequenceProxyPaths; // parallel to sequenceFramePaths; empty without a proxy
+    QSize sequenceSourceSize;       // proxy frames are drawn scaled up to this size
+    QString videoSourcePath;
+    QString videoProxyPath;
+    bool videoOnProxy = false;
+    qint64 pendingVideoSeekMs = -1; // applied once the switched clip has prerolled
+    bool pendingVideoPlay = false;
+    bool pendingVideoReverse = false; // J pressed while switching from the proxy to the source
+    // Backward steps and reverse shuttle show frames from GStreamerPlayer's frame ring
+    // in imageView until the video sink has caught up with them
+    bool videoMemoryFrameShown = false;
+
+
+    // Color space for HDR/EXR images. HDR frames are decoded once to scene-linear half
+    // floats; the view transform maps them to 8-bit at display time
     OIIOImageLoader::ColorSpace currentColorSpace;
     bool isHDRImage;
+    DisplayTransform displayTransform;
+    QImage displayedLinearImage; // scene-linear source of originalPixmap; null for 8-bit content
 
     // Alpha channel toggle state
     bool alphaOnlyMode = false;
@@ -419,6 +471,16 @@ private:
     int sequenceFpsFrames = 0;
     double currentPlaybackFps = 0.0;
 
+    // Playback clock for sequences: the frame shown is picked from monotonic wall-clock
+    // time, so slow decoding drops frames (or, with DropFrames off, waits) instead of
+    // silently playing slower
+    double sequenceFps = 25.0;
+    bool sequenceDropFrames = true;      // SequencePlayback/DropFrames
+    QElapsedTimer sequenceClock;
+    qint64 sequenceClockFramesDone = 0;  // frame periods consumed since the clock started
+    QElapsedTimer sequenceFrameShownTimer;
+    SequencePlaybackStats playbackStats;
+
     // UI throttling to avoid heavy repaints
     QElapsedTimer uiUpdateTimer; // for slider/time label throttling
     QSize lastFrameSize; // track to avoid resetting scene rect
@@ -430,37 +492,70 @@ private:
 
 // ============================================================================
 // SequenceFrameCache: RAM-based pre-fetch cache for image sequence playback
+//
+// Frames are charged at their real pixel size against a byte budget (a share
+// of available RAM), and the cache keeps a window around the current frame
+// that leads in the playback direction - forward, reverse or ping-pong - with
+// a shorter trail behind it for direction changes and scrubbing back. The
+// lead grows when measured decode throughput falls short of the target fps.
+// Decoding is fed by a SequenceReadAhead I/O stage that reads frames' bytes
+// ahead of the decoders, so storage latency doesn't stall decode threads.
 // ============================================================================
 class SequenceFrameCache : public QObject
 {
     Q_OBJECT
 
 public:
+    struct Stats {
+        qint64 hits = 0;
+        qint64 misses = 0;
+        double avgDecodeMs = 0.0;   // moving average per frame
+        double decodeFps = 0.0;     // estimated throughput across prefetch workers
+        double targetFps = 0.0;
+        int cachedFrames = 0;
+        int leadFrames = 0;         // current prefetch lead in the playback direction
+        qint64 bytes = 0;
+        qint64 budgetBytes = 0;
+    };
+
     explicit SequenceFrameCache(QObject *parent = nullptr);
     ~SequenceFrameCache();
 
     // Cache operations
-    void setSequence(const QStringList &framePaths, OIIOImageLoader::ColorSpace colorSpace);
+    void setSequence(const QStringList &framePaths);
     void clearCache();
-    QPixmap getFrame(int frameIndex);
+    // Display-referred 8-bit, or scene-linear half float for HDR sources (see DisplayTransform);
+    // counts a hit or miss
+    QImage getFrame(int frameIndex);
     bool hasFrame(int frameIndex) const;
 
     // Pre-fetching control
     void startPrefetch(int currentFrame);
     void stopPrefetch();
+    // Moving to a neighbouring frame also updates the prefetch direction
     void setCurrentFrame(int frameIndex);
+    void setPlaybackDirection(int direction); // +1 forward, -1 reverse
+    int playbackDirection() const;
+    void setPingPong(bool enabled);           // prefetch bounces at the ends instead of wrapping
+    void setTargetFps(double fps);
+    // Frames are decoded at the smallest power-of-two reduction covering `size`
+    // (an invalid size decodes at full resolution); asking for more pixels flushes the cache
+    void setDecodeSize(const QSize& size);
+    QSize decodeSize() const;
     // Tunables
     void setPrefetchConcurrency(int n) { m_prefetchConcurrency = qMax(1, n); }
     int prefetchConcurrency() const { return m_prefetchConcurrency; }
 
     // Configuration
-    void setMaxCacheSize(int maxFrames); // Default: 100 frames
+    void setMaxCacheSize(int maxFrames); // Upper bound on cached frames; the byte budget also applies
     int maxCacheSize() const { return m_maxCacheSize; }
+    void setMemoryBudgetMB(qint64 mb);
+    // Frames that fit the budget at the measured frame size (capped by maxCacheSize and sequence length)
+    int capacityFrames() const;
     int cachedFrameCount() const;
     qint64 currentMemoryUsageMB() const; // Returns current cache memory usage in MB
+    Stats stats() const;
 
-    // Calculate optimal cache size based on available RAM
-    static int calculateOptimalCacheSize(int percentOfFreeRAM = 70);
     static qint64 getAvailableRAM(); // Returns available RAM in MB
 
     // Cancellation epoch (thread-safe)
@@ -470,16 +565,19 @@ public:
 signals:
     void frameCached(int frameIndex);
     void cacheSnapshot(const QSet<int>& frames);
+    void statsChanged(const SequenceFrameCache::Stats& stats);
 
 private:
     void prefetchFrames(int startFrame);
-    bool isRangeMostlyCached(int start, int end, double threshold) const;
+    bool updateWindowLocked(); // true when frames were evicted
+    int leadFramesLocked(int capacity) const;
+    int capacityFramesLocked() const;
     void scheduleFrameIfNeeded(int frameIndex, quint64 epoch, bool highPriority);
-    QPixmap loadFrame(int frameIndex);
+    QSet<int> cachedFramesLocked() const;
+    void emitStatsThrottled();
 
     QStringList m_framePaths;
-    OIIOImageLoader::ColorSpace m_colorSpace;
-    QCache<int, QPixmap> m_cache;
+    QCache<int, QImage> m_cache; // cost in KB
     mutable QRecursiveMutex m_mutex; // Use recursive mutex to allow same thread to lock multiple times
     QThreadPool *m_threadPool;
     int m_maxCacheSize;
@@ -489,12 +587,28 @@ private:
     std::atomic<quint64> m_epoch; // cancellation epoch; increment to invalidate in-flight workers
     int m_prefetchConcurrency = 4; // default limited concurrency for near-sequential fills
 
-    // Strict sequential sliding window state
-    int m_windowStart = 0;
-    int m_windowEnd = -1;
-    int m_nextToEnqueue = 0;
+    // Window around the current frame, in prefetch priority order (lead first, then trail)
+    QVector<int> m_window;
+    QSet<int> m_windowSet;
+    int m_leadFrames = 0;
+    int m_direction = 1;
+    bool m_pingPong = false;
+    double m_targetFps = 25.0;
+    QSize m_decodeSize; // invalid: full resolution
+    // I/O stage: reads upcoming frames' bytes so decoders work from memory
+    std::shared_ptr<SequenceReadAhead> m_readAhead;
+
+    // Measurements
+    qint64 m_budgetKB = 0;
+    double m_avgFrameKB = 0.0;
+    double m_avgDecodeMs = 0.0;
+    qint64 m_hits = 0;
+    qint64 m_misses = 0;
+    QElapsedTimer m_statsTimer;
 };
 
+Q_DECLARE_METATYPE(SequenceFrameCache::Stats)
+
 // Worker for loading frames in background
 class FrameLoaderWorker : public QObject, public QRunnable
 {
@@ -502,17 +616,18 @@ class FrameLoaderWorker : public QObject, public QRunnable
 
 public:
     FrameLoaderWorker(SequenceFrameCache *cache, int frameIndex, const QString &framePath,
-                      OIIOImageLoader::ColorSpace colorSpace, quint64 epoch);
+                      const QSize &decodeSize, std::shared_ptr<SequenceReadAhead> readAhead, quint64 epoch);
     void run() override;
 
 signals:
-    void frameLoaded(int frameIndex, QPixmap pixmap);
+    void frameLoaded(int frameIndex, QImage image, double decodeMs);
 
 private:
     QPointer<SequenceFrameCache> m_cache;
     int m_frameIndex;
     QString m_framePath;
-    OIIOImageLoader::ColorSpace m_colorSpace;
+    QSize m_decodeSize;
+    std::shared_ptr<SequenceReadAhead> m_readAhead;
     quint64 m_epoch;
 };
 
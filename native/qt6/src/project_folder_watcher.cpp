@@ -51,16 +51,28 @@ void ProjectFolderWatcher::addProjectFolder(int projectFolderId, const QString&
         QDirIterator it(path, QDir::Dirs | QDir::NoDotAndDotDot, QDirIterator::Subdirectories);
         while (it.hasNext()) {
             QString subDir = it.next();
-            if (m_watcher->addPath(subDir)) {
-                m_pathToProjectId[subDir] = projectFolderId;
-                qDebug() << "ProjectFolderWatcher: Also watching subdirectory" << subDir;
-            }
+            if (m_watcher->addPath(subDir)) m_pathToProjectId[subDir] = projectFolderId;
         }
     } else {
         qWarning() << "ProjectFolderWatcher: Failed to watch" << path;
     }
 }
 
+void ProjectFolderWatcher::watchDirectories(int projectFolderId, const QString& root, const QStringList& dirs)
+{
+    removeProjectFolder(projectFolderId);
+    QStringList paths = dirs;
+    if (!paths.contains(root)) paths.prepend(root);
+    const QStringList failed = m_watcher->addPaths(paths);
+    const QSet<QString> failedSet(failed.cbegin(), failed.cend());
+    for (const QString& p : std::as_const(paths)) {
+        if (!failedSet.contains(p)) m_pathToProjectId[p] = projectFolderId;
+    }
+    m_projectIdToPath[projectFolderId] = root;
+    qDebug() << "ProjectFolderWatcher: Watching" << paths.size() - failed.size() << "folder(s) under" << root;
+    if (!failed.isEmpty()) qWarning() << "ProjectFolderWatcher: Failed to watch" << failed.size() << "folder(s) under" << root;
+}
+
 void ProjectFolderWatcher::removeProjectFolder(int projectFolderId)
 {
     qDebug() << "ProjectFolderWatcher::removeProjectFolder" << projectFolderId;
@@ -126,6 +138,7 @@ void ProjectFolderWatcher::onDirectoryChanged(const QString& path)
     }
     
     int projectFolderId = m_pathToProjectId[path];
+    emit directoryChanged(path);
     
     // Check if new subdirectories were added (only immediate children)
     if (QDir(path).exists()) {
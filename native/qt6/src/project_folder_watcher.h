@@ -18,6 +18,9 @@ public:
     // Add a project folder to watch
     void addProjectFolder(int projectFolderId, const QString& path);
     
+    // Watch `root` and the given directories below it, without walking the tree
+    void watchDirectories(int projectFolderId, const QString& root, const QStringList& dirs);
+
     // Remove a project folder from watching
     void removeProjectFolder(int projectFolderId);
     
@@ -30,6 +33,8 @@ public:
 signals:
     // Emitted when changes are detected in a project folder
     void projectFolderChanged(int projectFolderId, const QString& path);
+    // Raw notification for one watched directory, before debouncing (FilenameIndex)
+    void directoryChanged(const QString& path);
 
 private slots:
     void onDirectoryChanged(const QString& path);
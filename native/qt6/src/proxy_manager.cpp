@@ -0,0 +1,684 @@
+#include "proxy_manager.h"
+
+#include "image_convert_engine.h"
+#include "media_probe_cache.h"
+#include "utils.h"
+
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QDirIterator>
+#include <QFile>
+#include <QFileInfo>
+#include <QMetaObject>
+#include <QProcess>
+#include <QRegularExpression>
+#include <QSaveFile>
+#include <QSettings>
+#include <QStandardPaths>
+#include <QThread>
+#include <algorithm>
+
+namespace {
+
+constexpr quint32 kIndexMagic = 0x4b4d5058; // "KMPX"
+constexpr quint32 kIndexVersion = 1;
+constexpr char kIndexFile[] = "index.dat";
+// Dropped into every job directory so cleanup never touches folders it didn't create
+constexpr char kJobMarker[] = ".kasset-proxy";
+constexpr int kDefaultBudgetGB = 50;
+constexpr int kVideoWidthLimit = 2048;
+constexpr qint64 kVideoBitrateLimit = 250000000; // bits/s
+constexpr int kSequenceThreads = 2;
+constexpr int kJpegQuality = 85;
+
+// Frame number = last run of digits in the base name (shot_v2.0101.exr -> 0101)
+const QRegularExpression& frameDigits()
+{
+    static const QRegularExpression re(R"((\d+)(?!.*\d))");
+    return re;
+}
+
+qint64 dirSize(const QString& dir)
+{
+    qint64 total = 0;
+    QDirIterator it(dir, QDir::Files | QDir::NoDotAndDotDot, QDirIterator::Subdirectories);
+    while (it.hasNext()) {
+        it.next();
+        total += it.fileInfo().size();
+    }
+    return total;
+}
+
+qint64 mtimeMs(const QFileInfo& fi) { return fi.lastModified().toMSecsSinceEpoch(); }
+
+QDataStream& operator<<(QDataStream& out, const ProxyInfo& p)
+{
+    return out << p.sourceKey << p.sourcePath << p.proxyPath << qint32(p.kind) << qint32(p.scale)
+               << qint32(p.frameCount) << p.byteSize << p.sourceSize << p.sourceMtimeMs
+               << p.createdAt << p.lastUsedAt << qint32(p.assetId);
+}
+
+QDataStream& operator>>(QDataStream& in, ProxyInfo& p)
+{
+    qint32 kind = 0, scale = 0, frames = 0, assetId = 0;
+    in >> p.sourceKey >> p.sourcePath >> p.proxyPath >> kind >> scale >> frames >> p.byteSize
+       >> p.sourceSize >> p.sourceMtimeMs >> p.createdAt >> p.lastUsedAt >> assetId;
+    p.kind = static_cast<ProxyInfo::Kind>(std::clamp<qint32>(kind, 0, qint32(ProxyInfo::Kind::H264Intra)));
+    p.scale = scale;
+    p.frameCount = frames;
+    p.assetId = assetId;
+    return in;
+}
+
+} // namespace
+
+QString ProxyInfo::kindName(Kind kind)
+{
+    switch (kind) {
+        case Kind::JpegSequence: return QStringLiteral("jpeg_sequence");
+        case Kind::ExrSequence: return QStringLiteral("exr_sequence");
+        case Kind::Mjpeg: return QStringLiteral("mjpeg");
+        case Kind::H264Intra: return QStringLiteral("h264_intra");
+    }
+    return QString();
+}
+
+ProxyManager& ProxyManager::instance()
+{
+    static ProxyManager inst;
+    return inst;
+}
+
+ProxyManager::ProxyManager(QObject* parent)
+    : QObject(parent)
+    , m_cancel(std::make_shared<std::atomic_bool>(false))
+{
+    qRegisterMetaType<ProxyInfo>("ProxyInfo");
+
+    QSettings s("AugmentCode", "KAssetManager");
+    m_enabled = s.value("Proxies/Enabled", true).toBool();
+    m_autoGenerate = s.value("Proxies/AutoGenerate", true).toBool();
+    m_budgetBytes = qint64(qMax(1, s.value("Proxies/BudgetGB", kDefaultBudgetGB).toInt())) << 30;
+    m_scale = s.value("Proxies/Scale", 2).toInt() == 4 ? 4 : 2;
+    m_sequenceFormat = s.value("Proxies/SequenceFormat", "jpeg").toString() == "exr" ? SequenceFormat::HalfExr : SequenceFormat::Jpeg;
+    m_videoCodec = s.value("Proxies/VideoCodec", "mjpeg").toString() == "h264" ? VideoCodec::H264Intra : VideoCodec::Mjpeg;
+    m_cacheDir = s.value("Proxies/CacheDir").toString();
+
+    // One job at a time; runJob() drops the worker below interactive decoding and playback
+    m_pool.setMaxThreadCount(1);
+}
+
+ProxyManager::~ProxyManager()
+{
+    cancelAll();
+    m_pool.waitForDone();
+    save();
+}
+
+bool ProxyManager::isEnabled() const { QMutexLocker lk(&m_mutex); return m_enabled; }
+void ProxyManager::setEnabled(bool enabled) { QMutexLocker lk(&m_mutex); m_enabled = enabled; }
+bool ProxyManager::autoGenerate() const { QMutexLocker lk(&m_mutex); return m_autoGenerate; }
+void ProxyManager::setAutoGenerate(bool enabled) { QMutexLocker lk(&m_mutex); m_autoGenerate = enabled; }
+qint64 ProxyManager::budgetBytes() const { QMutexLocker lk(&m_mutex); return m_budgetBytes; }
+int ProxyManager::scale() const { QMutexLocker lk(&m_mutex); return m_scale; }
+void ProxyManager::setScale(int scale) { QMutexLocker lk(&m_mutex); m_scale = scale >= 4 ? 4 : 2; }
+ProxyManager::SequenceFormat ProxyManager::sequenceFormat() const { QMutexLocker lk(&m_mutex); return m_sequenceFormat; }
+void ProxyManager::setSequenceFormat(SequenceFormat format) { QMutexLocker lk(&m_mutex); m_sequenceFormat = format; }
+ProxyManager::VideoCodec ProxyManager::videoCodec() const { QMutexLocker lk(&m_mutex); return m_videoCodec; }
+void ProxyManager::setVideoCodec(VideoCodec codec) { QMutexLocker lk(&m_mutex); m_videoCodec = codec; }
+void ProxyManager::setFfmpegPath(const QString& path) { QMutexLocker lk(&m_mutex); m_ffmpegPath = path; }
+
+void ProxyManager::setBudgetBytes(qint64 bytes)
+{
+    {
+        QMutexLocker lk(&m_mutex);
+        m_budgetBytes = qMax<qint64>(0, bytes);
+    }
+    enforceBudget();
+}
+
+QString ProxyManager::cacheDir() const
+{
+    QMutexLocker lk(&m_mutex);
+    return const_cast<ProxyManager*>(this)->proxyDirLocked(QString());
+}
+
+void ProxyManager::setCacheDir(const QString& dir)
+{
+    QMutexLocker lk(&m_mutex);
+    const QString cleaned = dir.isEmpty() ? QString() : QDir::cleanPath(QFileInfo(dir).absoluteFilePath());
+    if (cleaned == m_cacheDir && m_loaded) return;
+    if (m_loaded && m_dirty) saveLocked();
+    m_cacheDir = cleaned;
+    m_proxies.clear();
+    m_loaded = false;
+    m_dirty = false;
+}
+
+QString ProxyManager::sourceKey(const QString& path, bool sequence)
+{
+    const QFileInfo fi(path);
+    if (!sequence) return fi.absoluteFilePath();
+    const QString base = fi.completeBaseName();
+    const QRegularExpressionMatch m = frameDigits().match(base);
+    if (!m.hasMatch()) return fi.absoluteFilePath();
+    // Same prefix, different extension (EXR + JPEG renders side by side) are different sequences
+    return fi.absolutePath() + "/" + base.left(m.capturedStart(1)) + "#" + base.mid(m.capturedEnd(1))
+           + "." + fi.suffix().toLower();
+}
+
+QString ProxyManager::proxyFramePath(const QString& proxyFirstFrame, const QString& sourceFrame)
+{
+    const QFileInfo proxy(proxyFirstFrame);
+    const QRegularExpressionMatch m = frameDigits().match(QFileInfo(sourceFrame).completeBaseName());
+    if (!m.hasMatch()) return QString();
+    return proxy.absolutePath() + "/proxy." + m.captured(1) + "." + proxy.suffix();
+}
+
+QStringList ProxyManager::sequenceFrames(const QString& anyFrame)
+{
+    const QFileInfo fi(anyFrame);
+    const QString base = fi.completeBaseName();
+    const QRegularExpressionMatch m = frameDigits().match(base);
+    if (!m.hasMatch()) return fi.exists() ? QStringList{fi.absoluteFilePath()} : QStringList();
+
+    const QString prefix = base.left(m.capturedStart(1));
+    const QString tail = base.mid(m.capturedEnd(1)) + "." + fi.suffix();
+    const QRegularExpression member("^" + QRegularExpression::escape(prefix) + R"((\d+))"
+                                    + QRegularExpression::escape(tail) + "$",
+                                    QRegularExpression::CaseInsensitiveOption);
+    QDir dir(fi.absolutePath());
+    QVector<QPair<qint64, QString>> numbered;
+    const QStringList names = dir.entryList({prefix + "*" + tail}, QDir::Files);
+    for (const QString& name : names) {
+        const QRegularExpressionMatch mm = member.match(name);
+        if (mm.hasMatch()) numbered.append({mm.captured(1).toLongLong(), dir.filePath(name)});
+    }
+    std::sort(numbered.begin(), numbered.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+    QStringList out;
+    out.reserve(numbered.size());
+    for (const auto& n : numbered) out.append(n.second);
+    return out;
+}
+
+bool ProxyManager::sequenceNeedsProxy(const QString& framePath)
+{
+    // Float/high bit depth or uncompressed formats that decode too slowly for real-time playback
+    static const QSet<QString> heavy = { "exr", "sxr", "dpx", "cin", "tif", "tiff", "hdr", "psd" };
+    return heavy.contains(QFileInfo(framePath).suffix().toLower());
+}
+
+bool ProxyManager::videoNeedsProxy(const MediaProbeInfo& info)
+{
+    if (!info.valid) return false;
+    if (info.width > kVideoWidthLimit) return true;
+    if (info.videoCodec.contains("prores", Qt::CaseInsensitive) && info.videoProfile.contains("4444")) return true;
+    return info.bitrate > kVideoBitrateLimit;
+}
+
+bool ProxyManager::lookup(const QString& key, ProxyInfo& out)
+{
+    {
+        QMutexLocker lk(&m_mutex);
+        if (!m_enabled) return false;
+        ensureLoadedLocked();
+        auto it = m_proxies.constFind(key);
+        if (it == m_proxies.constEnd()) return false;
+        out = *it;
+    }
+    // File checks outside the lock; lookups come from decode threads
+    const QFileInfo src(out.sourcePath);
+    if (!src.exists() || mtimeMs(src) != out.sourceMtimeMs) return false;
+    if (!out.isSequence() && src.size() != out.sourceSize) return false;
+    if (!QFileInfo::exists(out.proxyPath)) return false;
+
+    QMutexLocker lk(&m_mutex);
+    auto it = m_proxies.find(key);
+    if (it != m_proxies.end()) {
+        it->lastUsedAt = QDateTime::currentMSecsSinceEpoch();
+        m_dirty = true;
+    }
+    return true;
+}
+
+QString ProxyManager::videoProxy(const QString& videoPath)
+{
+    ProxyInfo info;
+    return lookup(sourceKey(videoPath, false), info) && !info.isSequence() ? info.proxyPath : QString();
+}
+
+QString ProxyManager::sequenceProxy(const QString& anyFrame)
+{
+    ProxyInfo info;
+    return lookup(sourceKey(anyFrame, true), info) && info.isSequence() ? info.proxyPath : QString();
+}
+
+QStringList ProxyManager::sequenceProxyFrames(const QStringList& sourceFrames)
+{
+    if (sourceFrames.isEmpty()) return {};
+    ProxyInfo info;
+    if (!lookup(sourceKey(sourceFrames.first(), true), info) || !info.isSequence()) return {};
+    // Frames were added or removed since the proxy was made
+    if (info.frameCount != sourceFrames.size()) return {};
+    QStringList out;
+    out.reserve(sourceFrames.size());
+    for (const QString& frame : sourceFrames) {
+        const QString p = proxyFramePath(info.proxyPath, frame);
+        if (p.isEmpty()) return {};
+        out.append(p);
+    }
+    return out;
+}
+
+bool ProxyManager::requestVideo(const QString& videoPath, int assetId, bool force)
+{
+    const QFileInfo fi(videoPath);
+    if (!fi.exists() || !isEnabled()) return false;
+    Job job;
+    job.key = sourceKey(videoPath, false);
+    job.sourcePath = fi.absoluteFilePath();
+    job.assetId = assetId;
+    job.force = force;
+    ProxyInfo existing;
+    if (lookup(job.key, existing)) return false;
+    return enqueue(job);
+}
+
+bool ProxyManager::requestSequence(const QStringList& frames, int assetId, bool force)
+{
+    if (frames.isEmpty() || !isEnabled()) return false;
+    if (!force && !sequenceNeedsProxy(frames.first())) return false;
+    Job job;
+    job.key = sourceKey(frames.first(), true);
+    job.sourcePath = QFileInfo(frames.first()).absoluteFilePath();
+    job.frames = frames;
+    job.assetId = assetId;
+    job.force = force;
+    ProxyInfo existing;
+    if (lookup(job.key, existing) && existing.frameCount == frames.size()) return false;
+    return enqueue(job);
+}
+
+bool ProxyManager::enqueue(const Job& queued)
+{
+    Job job = queued;
+    std::shared_ptr<std::atomic_bool> cancel;
+    int pending = 0;
+    {
+        QMutexLocker lk(&m_mutex);
+        ensureLoadedLocked();
+        if (m_pending.contains(job.key)) return false;
+        job.proxyDir = proxyDirLocked(job.key);
+        if (job.proxyDir.isEmpty()) return false;
+        job.ffmpegPath = m_ffmpegPath;
+        job.scale = m_scale;
+        job.sequenceFormat = m_sequenceFormat;
+        job.videoCodec = m_videoCodec;
+        m_pending.insert(job.key);
+        pending = m_pending.size();
+        cancel = m_cancel;
+    }
+    m_pool.start([this, job, cancel]() { runJob(job, cancel); });
+    emit queueChanged(pending);
+    return true;
+}
+
+int ProxyManager::pendingCount() const
+{
+    QMutexLocker lk(&m_mutex);
+    return m_pending.size();
+}
+
+void ProxyManager::cancelAll()
+{
+    m_pool.clear();
+    {
+        QMutexLocker lk(&m_mutex);
+        m_cancel->store(true);
+        m_cancel = std::make_shared<std::atomic_bool>(false);
+        if (m_pending.isEmpty()) return;
+        m_pending.clear();
+    }
+    emit queueChanged(0);
+}
+
+bool ProxyManager::waitForDone(int msecs)
+{
+    return m_pool.waitForDone(msecs);
+}
+
+void ProxyManager::runJob(const Job& job, std::shared_ptr<std::atomic_bool> cancel)
+{
+    QThread::currentThread()->setPriority(QThread::LowestPriority);
+    ProxyInfo info;
+    QString error;
+    JobStatus status = JobStatus::Done;
+
+    if (cancel->load()) {
+        status = JobStatus::Cancelled;
+    } else if (job.frames.isEmpty() && !job.force) {
+        // Cheap header probe (cached) decides whether the clip is heavy at all
+        MediaProbeInfo probe;
+        if (!MediaProbeCache::instance().probe(job.sourcePath, probe) || !videoNeedsProxy(probe)) status = JobStatus::Skipped;
+    }
+
+    if (status == JobStatus::Done) {
+        QDir(job.proxyDir).removeRecursively();
+        QDir().mkpath(job.proxyDir);
+        QFile marker(QDir(job.proxyDir).filePath(kJobMarker));
+        if (!marker.open(QIODevice::WriteOnly)) qWarning() << "[ProxyManager] Cannot mark proxy directory" << job.proxyDir;
+        marker.close();
+        const bool ok = job.frames.isEmpty() ? generateVideo(job, info, *cancel, &error)
+                                             : generateSequence(job, info, *cancel, &error);
+        if (!ok) {
+            status = cancel->load() ? JobStatus::Cancelled : JobStatus::Failed;
+            QDir(job.proxyDir).removeRecursively();
+        } else {
+            info.sourceKey = job.key;
+            info.sourcePath = job.sourcePath;
+            info.scale = job.scale;
+            info.assetId = job.assetId;
+            info.byteSize = dirSize(job.proxyDir);
+            const QFileInfo src(job.sourcePath);
+            info.sourceSize = src.size();
+            info.sourceMtimeMs = mtimeMs(src);
+            info.createdAt = info.lastUsedAt = QDateTime::currentMSecsSinceEpoch();
+        }
+    }
+
+    QMetaObject::invokeMethod(this, [this, key = job.key, sourcePath = job.sourcePath, status, info, error]() {
+        onJobFinished(key, sourcePath, status, info, error);
+    }, Qt::QueuedConnection);
+}
+
+bool ProxyManager::generateSequence(const Job& job, ProxyInfo& info, const std::atomic_bool& cancel, QString* errorOut)
+{
+    ImageConvertEngine::Options opts;
+    opts.downscale = job.scale;
+    opts.includeAlpha = false;
+    if (job.sequenceFormat == SequenceFormat::HalfExr && ImageConvertEngine::canWrite(ImageConvertEngine::Format::Exr)) {
+        opts.format = ImageConvertEngine::Format::Exr;
+        info.kind = ProxyInfo::Kind::ExrSequence;
+    } else {
+        opts.format = ImageConvertEngine::Format::Jpg;
+        opts.quality = kJpegQuality;
+        info.kind = ProxyInfo::Kind::JpegSequence;
+    }
+
+    const QString first = QDir(job.proxyDir).filePath("proxy.0." + ImageConvertEngine::extensionFor(opts.format));
+    QVector<ImageConvertEngine::Item> items;
+    items.reserve(job.frames.size());
+    for (const QString& frame : job.frames) {
+        ImageConvertEngine::Item item;
+        item.src = frame;
+        item.dst = proxyFramePath(first, frame);
+        if (item.dst.isEmpty()) {
+            if (errorOut) *errorOut = QString("Not a numbered frame: %1").arg(frame);
+            return false;
+        }
+        items.append(item);
+    }
+
+    QString firstError;
+    QMutex errorMutex;
+    const bool ok = ImageConvertEngine::run(items, opts, kSequenceThreads, cancel,
+        [&](const ImageConvertEngine::Result& r) {
+            if (r.ok) return;
+            QMutexLocker lk(&errorMutex);
+            if (firstError.isEmpty()) firstError = items[r.item].src + ": " + r.error;
+        });
+    if (!ok) {
+        if (errorOut) *errorOut = cancel.load() ? QStringLiteral("Cancelled") : firstError;
+        return false;
+    }
+    info.proxyPath = items.first().dst;
+    info.frameCount = items.size();
+    qInfo() << "[ProxyManager] Sequence proxy ready:" << items.size() << "frames in" << job.proxyDir;
+    return true;
+}
+
+bool ProxyManager::generateVideo(const Job& job, ProxyInfo& info, const std::atomic_bool& cancel, QString* errorOut)
+{
+    const QString out = QDir(job.proxyDir).filePath("proxy.mov");
+    const QString partial = QDir(job.proxyDir).filePath("proxy.partial.mov");
+    // Even dimensions keep 4:2:x chroma subsampling happy
+    const QString scaleFilter = QString("scale=trunc(iw/%1/2)*2:trunc(ih/%1/2)*2").arg(job.scale);
+
+    QStringList args{"-hide_banner", "-nostdin", "-y", "-i", job.sourcePath,
+                     "-map", "0:v:0", "-map", "0:a:0?", "-vf", scaleFilter};
+    if (job.videoCodec == VideoCodec::H264Intra) {
+        // Every frame a keyframe: seeks and reverse scrubbing never decode a GOP
+        args << "-c:v" << "libx264" << "-preset" << "veryfast" << "-crf" << "18" << "-g" << "1" << "-pix_fmt" << "yuv420p";
+        info.kind = ProxyInfo::Kind::H264Intra;
+    } else {
+        args << "-c:v" << "mjpeg" << "-q:v" << "3" << "-pix_fmt" << "yuvj422p";
+        info.kind = ProxyInfo::Kind::Mjpeg;
+    }
+    args << "-c:a" << "aac" << "-b:a" << "192k" << partial;
+
+    QProcess proc;
+    proc.setProcessChannelMode(QProcess::MergedChannels);
+    proc.start(job.ffmpegPath.isEmpty() ? Utils::locateFfmpeg() : job.ffmpegPath, args);
+    if (!proc.waitForStarted(10000)) {
+        if (errorOut) *errorOut = QString("Failed to start ffmpeg: %1").arg(proc.errorString());
+        return false;
+    }
+    QByteArray log;
+    while (!proc.waitForFinished(200)) {
+        log += proc.readAll();
+        if (log.size() > 64 * 1024) log = log.right(16 * 1024);
+        if (cancel.load()) {
+            proc.kill();
+            proc.waitForFinished(5000);
+            if (errorOut) *errorOut = QStringLiteral("Cancelled");
+            return false;
+        }
+        if (proc.state() == QProcess::NotRunning) break;
+    }
+    log += proc.readAll();
+    if (proc.exitStatus() != QProcess::NormalExit || proc.exitCode() != 0) {
+        if (errorOut) *errorOut = QString("ffmpeg failed: %1").arg(QString::fromLocal8Bit(log.right(2048)).trimmed());
+        return false;
+    }
+    if (!QFile::rename(partial, out)) {
+        if (errorOut) *errorOut = QString("Cannot finalize proxy %1").arg(out);
+        return false;
+    }
+    info.proxyPath = out;
+    qInfo() << "[ProxyManager] Video proxy ready:" << out;
+    return true;
+}
+
+void ProxyManager::onJobFinished(const QString& key, const QString& sourcePath, JobStatus status,
+                                 const ProxyInfo& info, const QString& error)
+{
+    int pending = 0;
+    {
+        QMutexLocker lk(&m_mutex);
+        m_pending.remove(key);
+        pending = m_pending.size();
+        if (status == JobStatus::Done) {
+            m_proxies.insert(key, info);
+            m_dirty = true;
+            saveLocked();
+        }
+    }
+    if (status == JobStatus::Done) {
+        emit proxyReady(info);
+        enforceBudget();
+    } else if (status == JobStatus::Failed) {
+        qWarning() << "[ProxyManager] Proxy generation failed for" << sourcePath << ":" << error;
+        emit proxyFailed(sourcePath, error);
+    }
+    emit queueChanged(pending);
+}
+
+QVector<ProxyInfo> ProxyManager::proxies() const
+{
+    QMutexLocker lk(&m_mutex);
+    const_cast<ProxyManager*>(this)->ensureLoadedLocked();
+    QVector<ProxyInfo> out;
+    out.reserve(m_proxies.size());
+    for (const ProxyInfo& p : m_proxies) out.append(p);
+    return out;
+}
+
+qint64 ProxyManager::totalBytes() const
+{
+    QMutexLocker lk(&m_mutex);
+    const_cast<ProxyManager*>(this)->ensureLoadedLocked();
+    qint64 total = 0;
+    for (const ProxyInfo& p : m_proxies) total += p.byteSize;
+    return total;
+}
+
+void ProxyManager::removeProxy(const QString& sourceKey)
+{
+    QVector<QPair<QString, int>> removed;
+    {
+        QMutexLocker lk(&m_mutex);
+        ensureLoadedLocked();
+        removeLocked(sourceKey, &removed);
+        if (!removed.isEmpty()) saveLocked();
+    }
+    for (const auto& r : removed) emit proxyRemoved(r.first, r.second);
+}
+
+void ProxyManager::clearAll()
+{
+    cancelAll();
+    QVector<QPair<QString, int>> removed;
+    {
+        QMutexLocker lk(&m_mutex);
+        ensureLoadedLocked();
+        const QStringList keys = m_proxies.keys();
+        for (const QString& key : keys) removeLocked(key, &removed);
+        saveLocked();
+    }
+    for (const auto& r : removed) emit proxyRemoved(r.first, r.second);
+}
+
+void ProxyManager::enforceBudget()
+{
+    QVector<QPair<QString, int>> removed;
+    {
+        QMutexLocker lk(&m_mutex);
+        ensureLoadedLocked();
+        qint64 total = 0;
+        QVector<const ProxyInfo*> byAge;
+        byAge.reserve(m_proxies.size());
+        for (const ProxyInfo& p : m_proxies) {
+            total += p.byteSize;
+            byAge.append(&p);
+        }
+        if (total <= m_budgetBytes) return;
+        std::sort(byAge.begin(), byAge.end(), [](const ProxyInfo* a, const ProxyInfo* b) {
+            return a->lastUsedAt != b->lastUsedAt ? a->lastUsedAt < b->lastUsedAt : a->createdAt < b->createdAt;
+        });
+        // The most recently used proxy always survives, even when it alone exceeds the budget
+        QStringList victims;
+        for (int i = 0; i + 1 < byAge.size() && total > m_budgetBytes; ++i) {
+            total -= byAge[i]->byteSize;
+            victims.append(byAge[i]->sourceKey);
+        }
+        for (const QString& key : victims) removeLocked(key, &removed);
+        saveLocked();
+    }
+    if (!removed.isEmpty()) qInfo() << "[ProxyManager] Evicted" << removed.size() << "proxies to stay within budget";
+    for (const auto& r : removed) emit proxyRemoved(r.first, r.second);
+}
+
+bool ProxyManager::save()
+{
+    QMutexLocker lk(&m_mutex);
+    if (!m_loaded || !m_dirty) return true;
+    return saveLocked();
+}
+
+void ProxyManager::removeLocked(const QString& key, QVector<QPair<QString, int>>* removed)
+{
+    auto it = m_proxies.find(key);
+    if (it == m_proxies.end()) return;
+    QDir(QFileInfo(it->proxyPath).absolutePath()).removeRecursively();
+    if (removed) removed->append({key, it->assetId});
+    m_proxies.erase(it);
+    m_dirty = true;
+}
+
+QString ProxyManager::proxyDirLocked(const QString& key)
+{
+    if (m_cacheDir.isEmpty()) {
+        const QString base = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
+        if (base.isEmpty()) return QString();
+        m_cacheDir = QDir(base).filePath("proxies");
+    }
+    if (key.isEmpty()) return m_cacheDir;
+    const QByteArray hash = QCryptographicHash::hash(key.toUtf8(), QCryptographicHash::Sha1).toHex().left(16);
+    return QDir(m_cacheDir).filePath(QString::fromLatin1(hash));
+}
+
+void ProxyManager::ensureLoadedLocked()
+{
+    if (m_loaded) return;
+    m_loaded = true;
+    const QString root = proxyDirLocked(QString());
+    if (root.isEmpty()) return;
+
+    QFile f(QDir(root).filePath(kIndexFile));
+    if (f.open(QIODevice::ReadOnly)) {
+        QDataStream in(&f);
+        in.setVersion(QDataStream::Qt_6_0);
+        quint32 magic = 0, version = 0;
+        qint32 count = 0;
+        in >> magic >> version >> count;
+        if (magic == kIndexMagic && version == kIndexVersion && count >= 0) {
+            for (qint32 i = 0; i < count && in.status() == QDataStream::Ok; ++i) {
+                ProxyInfo p;
+                in >> p;
+                if (in.status() == QDataStream::Ok && QFileInfo::exists(p.proxyPath)) m_proxies.insert(p.sourceKey, p);
+            }
+        } else {
+            qWarning() << "[ProxyManager] Ignoring incompatible proxy index in" << root;
+        }
+    }
+
+    // Marked directories the index does not know about are leftovers of interrupted jobs;
+    // anything else in the cache root belongs to someone else
+    QSet<QString> known;
+    for (const ProxyInfo& p : m_proxies) known.insert(QFileInfo(p.proxyPath).absolutePath());
+    for (const QString& key : std::as_const(m_pending)) known.insert(proxyDirLocked(key));
+    static const QRegularExpression jobDir("^[0-9a-f]{16}$");
+    const QFileInfoList dirs = QDir(root).entryInfoList(QDir::Dirs | QDir::NoDotAndDotDot);
+    for (const QFileInfo& d : dirs) {
+        if (jobDir.match(d.fileName()).hasMatch() && !known.contains(d.absoluteFilePath())
+            && QFileInfo::exists(QDir(d.absoluteFilePath()).filePath(kJobMarker))) {
+            QDir(d.absoluteFilePath()).removeRecursively();
+        }
+    }
+    qDebug() << "[ProxyManager] Loaded" << m_proxies.size() << "proxies from" << root;
+}
+
+bool ProxyManager::saveLocked()
+{
+    const QString root = proxyDirLocked(QString());
+    if (root.isEmpty()) return false;
+    QDir().mkpath(root);
+    QSaveFile f(QDir(root).filePath(kIndexFile));
+    if (!f.open(QIODevice::WriteOnly)) {
+        qWarning() << "[ProxyManager] Cannot write proxy index in" << root;
+        return false;
+    }
+    QDataStream out(&f);
+    out.setVersion(QDataStream::Qt_6_0);
+    out << kIndexMagic << kIndexVersion << qint32(m_proxies.size());
+    for (const ProxyInfo& p : m_proxies) out << p;
+    if (!f.commit()) {
+        qWarning() << "[ProxyManager] Failed to save proxy index in" << root;
+        return false;
+    }
+    m_dirty = false;
+    return true;
+}
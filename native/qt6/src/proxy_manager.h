@@ -0,0 +1,175 @@
+#pragma once
+
+#include <QObject>
+#include <QHash>
+#include <QMutex>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+#include <QThreadPool>
+#include <QVector>
+#include <atomic>
+#include <memory>
+
+struct MediaProbeInfo;
+
+// One generated proxy. Sequence proxy frames keep the source's frame numbers
+// (proxy.0101.jpg for shot.0101.exr), so gaps and ranges line up with the source.
+struct ProxyInfo {
+    enum class Kind { JpegSequence, ExrSequence, Mjpeg, H264Intra };
+
+    QString sourceKey;       // see ProxyManager::sourceKey()
+    QString sourcePath;      // video file, or first frame of the source sequence
+    QString proxyPath;       // movie file, or first frame of the proxy sequence
+    Kind kind = Kind::JpegSequence;
+    int scale = 2;           // 1/scale of the source resolution
+    int frameCount = 0;      // sequences only
+    qint64 byteSize = 0;
+    qint64 sourceSize = 0;   // video: bytes of the source file
+    qint64 sourceMtimeMs = 0; // video file, or first source frame
+    qint64 createdAt = 0;    // ms since epoch
+    qint64 lastUsedAt = 0;
+    int assetId = 0;         // catalog asset the proxy was requested for, 0 if none
+
+    bool isSequence() const { return kind == Kind::JpegSequence || kind == Kind::ExrSequence; }
+    static QString kindName(Kind kind);
+};
+
+/**
+ * ProxyManager - background generation and lookup of reduced-resolution playback proxies
+ *
+ * Heavy sources (EXR/DPX/TIFF sequences, video wider than 2K, ProRes 4444 or
+ * above ~250 Mb/s) get a half- or quarter-resolution proxy: a JPEG or half-float
+ * EXR sequence written by ImageConvertEngine, or an intra-only MJPEG/H.264 movie
+ * encoded by ffmpeg. Jobs run one at a time on a private thread pool at the
+ * lowest thread priority so they never compete with interactive decoding.
+ *
+ * Proxies live in a managed cache directory (one sub-directory per source, plus
+ * an index file) bounded by a byte budget; the least recently used proxies are
+ * evicted first. Lookups validate the source's size/mtime, so an edited source
+ * silently falls back to full resolution until its proxy is regenerated.
+ *
+ * The manager knows nothing about the catalog: MainWindow links proxies to
+ * assets through proxyReady/proxyRemoved. Lookups and requests are thread-safe;
+ * proxyReady/proxyRemoved are emitted on the manager's (GUI) thread.
+ */
+class ProxyManager : public QObject {
+    Q_OBJECT
+
+public:
+    enum class SequenceFormat { Jpeg, HalfExr };
+    enum class VideoCodec { Mjpeg, H264Intra };
+
+    static ProxyManager& instance();
+
+    // Configuration; initial values come from the Proxies/ settings group
+    bool isEnabled() const;
+    void setEnabled(bool enabled);
+    // Generate automatically when heavy media is previewed (otherwise only on request)
+    bool autoGenerate() const;
+    void setAutoGenerate(bool enabled);
+    qint64 budgetBytes() const;
+    void setBudgetBytes(qint64 bytes);
+    int scale() const;
+    void setScale(int scale); // 2 or 4
+    SequenceFormat sequenceFormat() const;
+    void setSequenceFormat(SequenceFormat format);
+    VideoCodec videoCodec() const;
+    void setVideoCodec(VideoCodec codec);
+    void setFfmpegPath(const QString& path);
+
+    // Cache location (AppDataLocation/proxies by default); switching reloads the index
+    QString cacheDir() const;
+    void setCacheDir(const QString& dir);
+
+    // Sequences are keyed by directory + prefix + extension, videos by absolute path
+    static QString sourceKey(const QString& path, bool sequence);
+    // Proxy frame for one source frame of a sequence proxy rooted at `proxyFirstFrame`
+    static QString proxyFramePath(const QString& proxyFirstFrame, const QString& sourceFrame);
+    // All frames of the sequence `anyFrame` belongs to, in frame order
+    static QStringList sequenceFrames(const QString& anyFrame);
+    static bool sequenceNeedsProxy(const QString& framePath);
+    static bool videoNeedsProxy(const MediaProbeInfo& info);
+
+    // Lookups return empty when no up-to-date proxy exists and mark the proxy used.
+    QString videoProxy(const QString& videoPath);
+    // First proxy frame for the sequence containing `anyFrame`
+    QString sequenceProxy(const QString& anyFrame);
+    // Proxy frame paths parallel to `sourceFrames`
+    QStringList sequenceProxyFrames(const QStringList& sourceFrames);
+
+    // Queue background generation; no-op when disabled, already queued or up to date.
+    // Without `force`, sources that play fine at full resolution are skipped.
+    bool requestVideo(const QString& videoPath, int assetId = 0, bool force = false);
+    bool requestSequence(const QStringList& frames, int assetId = 0, bool force = false);
+    int pendingCount() const;
+    void cancelAll();
+    // Blocks until queued jobs are done (tests, shutdown)
+    bool waitForDone(int msecs = -1);
+
+    QVector<ProxyInfo> proxies() const;
+    qint64 totalBytes() const;
+    void removeProxy(const QString& sourceKey);
+    void clearAll();
+    // Evicts least recently used proxies until the cache fits the budget
+    void enforceBudget();
+    bool save();
+
+signals:
+    void proxyReady(const ProxyInfo& info);
+    void proxyRemoved(const QString& sourceKey, int assetId);
+    void proxyFailed(const QString& sourcePath, const QString& error);
+    void queueChanged(int pending);
+
+private:
+    explicit ProxyManager(QObject* parent = nullptr);
+    ~ProxyManager() override;
+    Q_DISABLE_COPY(ProxyManager)
+
+    struct Job {
+        QString key;
+        QString sourcePath;
+        QStringList frames; // sequences
+        int assetId = 0;
+        bool force = false;
+        // Settings snapshot taken when the job was queued
+        QString proxyDir;
+        QString ffmpegPath;
+        int scale = 2;
+        SequenceFormat sequenceFormat = SequenceFormat::Jpeg;
+        VideoCodec videoCodec = VideoCodec::Mjpeg;
+    };
+    enum class JobStatus { Done, Skipped, Failed, Cancelled };
+
+    bool enqueue(const Job& job);
+    void runJob(const Job& job, std::shared_ptr<std::atomic_bool> cancel);
+    static bool generateSequence(const Job& job, ProxyInfo& info, const std::atomic_bool& cancel, QString* errorOut);
+    static bool generateVideo(const Job& job, ProxyInfo& info, const std::atomic_bool& cancel, QString* errorOut);
+    void onJobFinished(const QString& key, const QString& sourcePath, JobStatus status,
+                       const ProxyInfo& info, const QString& error);
+
+    bool lookup(const QString& key, ProxyInfo& out);
+    void removeLocked(const QString& key, QVector<QPair<QString, int>>* removed);
+    QString proxyDirLocked(const QString& key);
+    void ensureLoadedLocked();
+    bool saveLocked();
+
+    mutable QMutex m_mutex;
+    QHash<QString, ProxyInfo> m_proxies;
+    QSet<QString> m_pending;
+    QString m_cacheDir;
+    QString m_ffmpegPath;
+    qint64 m_budgetBytes = 0;
+    int m_scale = 2;
+    SequenceFormat m_sequenceFormat = SequenceFormat::Jpeg;
+    VideoCodec m_videoCodec = VideoCodec::Mjpeg;
+    bool m_enabled = true;
+    bool m_autoGenerate = true;
+    bool m_loaded = false;
+    bool m_dirty = false;
+
+    QThreadPool m_pool;
+    std::shared_ptr<std::atomic_bool> m_cancel;
+};
+
+Q_DECLARE_METATYPE(ProxyInfo)
@@ -0,0 +1,329 @@
+#include "roaring_bitmap.h"
+
+#include <algorithm>
+#include <iterator>
+
+namespace {
+// Containers with more entries than this are stored as bitmaps (8 KB either way)
+constexpr int kArrayMax = 4096;
+constexpr int kBitmapWords = 65536 / 64;
+
+inline bool testBit(const QVector<quint64>& bits, quint16 low)
+{
+    return (bits[low >> 6] >> (low & 63)) & 1;
+}
+
+int popcount(const QVector<quint64>& bits)
+{
+    int total = 0;
+    for (quint64 w : bits) total += std::popcount(w);
+    return total;
+}
+}
+
+// ---- Container -------------------------------------------------------------
+
+bool RoaringBitmap::Container::contains(quint16 low) const
+{
+    if (isBitmap()) return testBit(bits, low);
+    return std::binary_search(array.constBegin(), array.constEnd(), low);
+}
+
+void RoaringBitmap::Container::add(quint16 low)
+{
+    if (!isBitmap()) {
+        // Ids usually arrive in ascending order (bulk loads): append without searching
+        if (array.isEmpty() || array.last() < low) {
+            if (array.size() < kArrayMax) {
+                array.append(low);
+                ++cardinality;
+                return;
+            }
+        } else {
+            auto it = std::lower_bound(array.begin(), array.end(), low);
+            if (it != array.end() && *it == low) return;
+            if (array.size() < kArrayMax) {
+                array.insert(it, low);
+                ++cardinality;
+                return;
+            }
+        }
+        toBitmap();
+    }
+    quint64& word = bits[low >> 6];
+    const quint64 mask = quint64(1) << (low & 63);
+    if (!(word & mask)) {
+        word |= mask;
+        ++cardinality;
+    }
+}
+
+bool RoaringBitmap::Container::remove(quint16 low)
+{
+    if (isBitmap()) {
+        quint64& word = bits[low >> 6];
+        const quint64 mask = quint64(1) << (low & 63);
+        if (!(word & mask)) return false;
+        word &= ~mask;
+        --cardinality;
+        normalize();
+        return true;
+    }
+    auto it = std::lower_bound(array.begin(), array.end(), low);
+    if (it == array.end() || *it != low) return false;
+    array.erase(it);
+    --cardinality;
+    return true;
+}
+
+void RoaringBitmap::Container::normalize()
+{
+    if (isBitmap() && cardinality <= kArrayMax) toArray();
+    else if (!isBitmap() && cardinality > kArrayMax) toBitmap();
+}
+
+void RoaringBitmap::Container::toBitmap()
+{
+    if (isBitmap()) return;
+    bits = QVector<quint64>(kBitmapWords, 0);
+    for (quint16 low : array) bits[low >> 6] |= quint64(1) << (low & 63);
+    array = QVector<quint16>();
+}
+
+void RoaringBitmap::Container::toArray()
+{
+    if (!isBitmap()) return;
+    QVector<quint16> values;
+    values.reserve(cardinality);
+    for (int w = 0; w < kBitmapWords; ++w) {
+        quint64 word = bits[w];
+        while (word) {
+            values.append(quint16(w * 64 + std::countr_zero(word)));
+            word &= word - 1;
+        }
+    }
+    array = std::move(values);
+    bits = QVector<quint64>();
+}
+
+bool RoaringBitmap::Container::operator==(const Container& other) const
+{
+    // Representation is canonical (array iff cardinality <= kArrayMax)
+    return cardinality == other.cardinality && array == other.array && bits == other.bits;
+}
+
+// ---- RoaringBitmap ---------------------------------------------------------
+
+int RoaringBitmap::indexOf(quint16 key) const
+{
+    auto it = std::lower_bound(m_keys.constBegin(), m_keys.constEnd(), key);
+    const int pos = int(it - m_keys.constBegin());
+    return (it != m_keys.constEnd() && *it == key) ? pos : -(pos + 1);
+}
+
+void RoaringBitmap::add(quint32 value)
+{
+    const quint16 key = quint16(value >> 16);
+    int idx = indexOf(key);
+    if (idx < 0) {
+        idx = -idx - 1;
+        m_keys.insert(idx, key);
+        m_containers.insert(idx, Container());
+    }
+    m_containers[idx].add(quint16(value & 0xFFFF));
+}
+
+bool RoaringBitmap::remove(quint32 value)
+{
+    const int idx = indexOf(quint16(value >> 16));
+    if (idx < 0 || !m_containers[idx].remove(quint16(value & 0xFFFF))) return false;
+    if (m_containers[idx].cardinality == 0) {
+        m_keys.removeAt(idx);
+        m_containers.removeAt(idx);
+    }
+    return true;
+}
+
+bool RoaringBitmap::contains(quint32 value) const
+{
+    const int idx = indexOf(quint16(value >> 16));
+    return idx >= 0 && m_containers[idx].contains(quint16(value & 0xFFFF));
+}
+
+void RoaringBitmap::clear()
+{
+    m_keys.clear();
+    m_containers.clear();
+}
+
+qint64 RoaringBitmap::cardinality() const
+{
+    qint64 total = 0;
+    for (const Container& c : m_containers) total += c.cardinality;
+    return total;
+}
+
+qint64 RoaringBitmap::andCardinality(const RoaringBitmap& other) const
+{
+    qint64 total = 0;
+    qsizetype i = 0, j = 0;
+    while (i < m_keys.size() && j < other.m_keys.size()) {
+        if (m_keys[i] < other.m_keys[j]) { ++i; continue; }
+        if (other.m_keys[j] < m_keys[i]) { ++j; continue; }
+        const Container& a = m_containers[i++];
+        const Container& b = other.m_containers[j++];
+        if (a.isBitmap() && b.isBitmap()) {
+            for (int w = 0; w < kBitmapWords; ++w) total += std::popcount(a.bits[w] & b.bits[w]);
+        } else if (a.isBitmap() || b.isBitmap()) {
+            const Container& bitmap = a.isBitmap() ? a : b;
+            const Container& array = a.isBitmap() ? b : a;
+            for (quint16 low : array.array) total += testBit(bitmap.bits, low);
+        } else {
+            qsizetype x = 0, y = 0;
+            while (x < a.array.size() && y < b.array.size()) {
+                if (a.array[x] < b.array[y]) ++x;
+                else if (b.array[y] < a.array[x]) ++y;
+                else { ++total; ++x; ++y; }
+            }
+        }
+    }
+    return total;
+}
+
+RoaringBitmap& RoaringBitmap::operator&=(const RoaringBitmap& other)
+{
+    QVector<quint16> keys;
+    QVector<Container> containers;
+    qsizetype i = 0, j = 0;
+    while (i < m_keys.size() && j < other.m_keys.size()) {
+        if (m_keys[i] < other.m_keys[j]) { ++i; continue; }
+        if (other.m_keys[j] < m_keys[i]) { ++j; continue; }
+        Container& a = m_containers[i];
+        const Container& b = other.m_containers[j];
+        Container out;
+        if (a.isBitmap() && b.isBitmap()) {
+            out.bits = std::move(a.bits);
+            for (int w = 0; w < kBitmapWords; ++w) out.bits[w] &= b.bits[w];
+            out.cardinality = popcount(out.bits);
+            out.normalize();
+        } else if (a.isBitmap() || b.isBitmap()) {
+            const Container& bitmap = a.isBitmap() ? a : b;
+            const Container& array = a.isBitmap() ? b : a;
+            for (quint16 low : array.array) {
+                if (testBit(bitmap.bits, low)) out.array.append(low);
+            }
+            out.cardinality = int(out.array.size());
+        } else {
+            std::set_intersection(a.array.constBegin(), a.array.constEnd(), b.array.constBegin(), b.array.constEnd(),
+                                  std::back_inserter(out.array));
+            out.cardinality = int(out.array.size());
+        }
+        if (out.cardinality > 0) {
+            keys.append(m_keys[i]);
+            containers.append(std::move(out));
+        }
+        ++i;
+        ++j;
+    }
+    m_keys = std::move(keys);
+    m_containers = std::move(containers);
+    return *this;
+}
+
+RoaringBitmap& RoaringBitmap::operator|=(const RoaringBitmap& other)
+{
+    QVector<quint16> keys;
+    QVector<Container> containers;
+    keys.reserve(m_keys.size() + other.m_keys.size());
+    containers.reserve(m_keys.size() + other.m_keys.size());
+    qsizetype i = 0, j = 0;
+    while (i < m_keys.size() || j < other.m_keys.size()) {
+        if (j >= other.m_keys.size() || (i < m_keys.size() && m_keys[i] < other.m_keys[j])) {
+            keys.append(m_keys[i]);
+            containers.append(std::move(m_containers[i++]));
+            continue;
+        }
+        if (i >= m_keys.size() || other.m_keys[j] < m_keys[i]) {
+            keys.append(other.m_keys[j]);
+            containers.append(other.m_containers[j++]);
+            continue;
+        }
+        Container out = std::move(m_containers[i]);
+        const Container& b = other.m_containers[j];
+        if (!out.isBitmap() && !b.isBitmap()) {
+            QVector<quint16> merged;
+            merged.reserve(out.array.size() + b.array.size());
+            std::set_union(out.array.constBegin(), out.array.constEnd(), b.array.constBegin(), b.array.constEnd(),
+                           std::back_inserter(merged));
+            out.array = std::move(merged);
+            out.cardinality = int(out.array.size());
+        } else {
+            out.toBitmap();
+            if (b.isBitmap()) {
+                for (int w = 0; w < kBitmapWords; ++w) out.bits[w] |= b.bits[w];
+            } else {
+                for (quint16 low : b.array) out.bits[low >> 6] |= quint64(1) << (low & 63);
+            }
+            out.cardinality = popcount(out.bits);
+        }
+        out.normalize();
+        keys.append(m_keys[i]);
+        containers.append(std::move(out));
+        ++i;
+        ++j;
+    }
+    m_keys = std::move(keys);
+    m_containers = std::move(containers);
+    return *this;
+}
+
+RoaringBitmap& RoaringBitmap::andNot(const RoaringBitmap& other)
+{
+    QVector<quint16> keys;
+    QVector<Container> containers;
+    qsizetype j = 0;
+    for (qsizetype i = 0; i < m_keys.size(); ++i) {
+        while (j < other.m_keys.size() && other.m_keys[j] < m_keys[i]) ++j;
+        Container out = std::move(m_containers[i]);
+        if (j < other.m_keys.size() && other.m_keys[j] == m_keys[i]) {
+            const Container& b = other.m_containers[j];
+            if (out.isBitmap()) {
+                if (b.isBitmap()) {
+                    for (int w = 0; w < kBitmapWords; ++w) out.bits[w] &= ~b.bits[w];
+                } else {
+                    for (quint16 low : b.array) out.bits[low >> 6] &= ~(quint64(1) << (low & 63));
+                }
+                out.cardinality = popcount(out.bits);
+                out.normalize();
+            } else {
+                QVector<quint16> kept;
+                kept.reserve(out.array.size());
+                for (quint16 low : out.array) {
+                    if (!b.contains(low)) kept.append(low);
+                }
+                out.array = std::move(kept);
+                out.cardinality = int(out.array.size());
+            }
+        }
+        if (out.cardinality > 0) {
+            keys.append(m_keys[i]);
+            containers.append(std::move(out));
+        }
+    }
+    m_keys = std::move(keys);
+    m_containers = std::move(containers);
+    return *this;
+}
+
+bool RoaringBitmap::operator==(const RoaringBitmap& other) const
+{
+    return m_keys == other.m_keys && m_containers == other.m_containers;
+}
+
+QVector<quint32> RoaringBitmap::toVector() const
+{
+    QVector<quint32> out;
+    out.reserve(cardinality());
+    forEach([&out](quint32 value) { out.append(value); });
+    return out;
+}
@@ -0,0 +1,81 @@
+#pragma once
+#include <QVector>
+#include <QtGlobal>
+#include <bit>
+
+/**
+ * RoaringBitmap - compressed set of 32-bit ids (roaring layout)
+ *
+ * Ids are split by their high 16 bits into containers. A container holds a
+ * sorted array of low halves while it has at most 4096 entries and switches to
+ * a 65536-bit bitmap beyond that, so sparse and dense sets both stay small and
+ * intersections run container by container. Used for per-tag asset sets.
+ */
+class RoaringBitmap {
+public:
+    void add(quint32 value);
+    bool remove(quint32 value);
+    bool contains(quint32 value) const;
+    void clear();
+
+    bool isEmpty() const { return m_keys.isEmpty(); }
+    qint64 cardinality() const;
+    // |this & other| without materialising the intersection
+    qint64 andCardinality(const RoaringBitmap& other) const;
+
+    RoaringBitmap& operator&=(const RoaringBitmap& other);
+    RoaringBitmap& operator|=(const RoaringBitmap& other);
+    RoaringBitmap& andNot(const RoaringBitmap& other);
+    friend RoaringBitmap operator&(RoaringBitmap a, const RoaringBitmap& b) { return a &= b; }
+    friend RoaringBitmap operator|(RoaringBitmap a, const RoaringBitmap& b) { return a |= b; }
+
+    bool operator==(const RoaringBitmap& other) const;
+    bool operator!=(const RoaringBitmap& other) const { return !(*this == other); }
+
+    // Ascending
+    QVector<quint32> toVector() const;
+    template <typename Fn>
+    void forEach(Fn&& fn) const;
+
+private:
+    struct Container {
+        QVector<quint16> array; // sorted low halves, used while bits is empty
+        QVector<quint64> bits;  // 1024 words once the container outgrows the array limit
+        int cardinality = 0;
+
+        bool isBitmap() const { return !bits.isEmpty(); }
+        bool contains(quint16 low) const;
+        void add(quint16 low);
+        bool remove(quint16 low);
+        // Switches representation to whichever suits the current cardinality
+        void normalize();
+        void toBitmap();
+        void toArray();
+        bool operator==(const Container& other) const;
+    };
+
+    int indexOf(quint16 key) const;
+
+    QVector<quint16> m_keys; // ascending high halves, parallel to m_containers
+    QVector<Container> m_containers;
+};
+
+template <typename Fn>
+void RoaringBitmap::forEach(Fn&& fn) const
+{
+    for (qsizetype c = 0; c < m_keys.size(); ++c) {
+        const quint32 high = quint32(m_keys[c]) << 16;
+        const Container& container = m_containers[c];
+        if (container.isBitmap()) {
+            for (int w = 0; w < container.bits.size(); ++w) {
+                quint64 word = container.bits[w];
+                while (word) {
+                    fn(high | quint32(w * 64 + std::countr_zero(word)));
+                    word &= word - 1;
+                }
+            }
+        } else {
+            for (quint16 low : container.array) fn(high | low);
+        }
+    }
+}
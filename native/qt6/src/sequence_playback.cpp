@@ -0,0 +1,139 @@
+#include "sequence_playback.h"
+
+#include <QSet>
+#include <cmath>
+
+namespace SequencePlayback {
+
+int step(int index, int& direction, int total, bool pingPong)
+{
+    if (total <= 1) return 0;
+    int next = index + direction;
+    if (next >= 0 && next < total) return next;
+    if (!pingPong) return next < 0 ? total - 1 : 0;
+    direction = -direction;
+    return index + direction;
+}
+
+int frameAfter(int frame, qint64 steps, int& direction, int total, bool pingPong)
+{
+    if (total <= 1) return 0;
+    if (!pingPong) {
+        const qint64 next = (frame + direction * (steps % total)) % total;
+        return int(next < 0 ? next + total : next);
+    }
+    // Ping-pong walks a cycle of 2*(total-1) positions: forward over 0..last, then back
+    const qint64 period = 2 * qint64(total - 1);
+    const qint64 start = direction > 0 ? frame : period - frame;
+    const qint64 pos = (start + steps) % period;
+    if (pos < total - 1) {
+        direction = 1;
+        return int(pos);
+    }
+    direction = -1;
+    return int(period - pos);
+}
+
+int leadFrames(int capacity, int workers, double avgDecodeMs, double targetFps)
+{
+    if (capacity <= 1) return 0;
+    // Always keep some frames behind the play head for reversing and scrubbing back
+    const int maxLead = capacity - qMax(1, capacity / 8);
+    workers = qMax(1, workers);
+    const int minLead = qMin(maxLead, 2 * workers);
+    if (avgDecodeMs <= 0.0) {
+        return qMax(minLead, capacity / 2);
+    }
+    const double decodeFps = workers * 1000.0 / avgDecodeMs;
+    if (decodeFps < targetFps * 1.1) {
+        // Decoding can't keep up: buffer as far ahead as memory allows
+        return maxLead;
+    }
+    // Fast enough: cover one decode latency plus a second of jitter margin
+    const int lead = static_cast<int>(std::ceil(targetFps * (avgDecodeMs / 1000.0 + 1.0))) + workers;
+    return qBound(minLead, lead, maxLead);
+}
+
+QVector<int> window(int current, int direction, int total, bool pingPong, int lead, int capacity)
+{
+    QVector<int> frames;
+    if (total <= 0 || capacity <= 0) return frames;
+    QSet<int> seen;
+    auto add = [&](int index) {
+        if (seen.contains(index)) return;
+        seen.insert(index);
+        frames.append(index);
+    };
+    current = qBound(0, current, total - 1);
+    add(current);
+    // Lead: the frames playback reaches next, wrapping or bouncing at the ends
+    int index = current;
+    int dir = direction;
+    for (int s = 0; frames.size() <= lead && frames.size() < capacity && s < 2 * total; ++s) {
+        index = step(index, dir, total, pingPong);
+        add(index);
+    }
+    // Trail: the frames just played
+    index = current;
+    dir = -direction;
+    for (int s = 0; frames.size() < capacity && s < 2 * total; ++s) {
+        index = step(index, dir, total, pingPong);
+        add(index);
+    }
+    return frames;
+}
+
+}
+
+void SequencePlaybackStats::reset()
+{
+    frameTimeHistogram = QVector<int>(kHistogramMs + 1, 0);
+    displayed = 0;
+    dropped = 0;
+    late = 0;
+    frameTimeMaxMs = 0.0;
+    decodeMsTotal = 0.0;
+    decodeSamples = 0;
+}
+
+void SequencePlaybackStats::addFrameTime(double ms)
+{
+    if (frameTimeHistogram.size() != kHistogramMs + 1) frameTimeHistogram = QVector<int>(kHistogramMs + 1, 0);
+    ++frameTimeHistogram[qBound(0, int(ms), kHistogramMs)];
+    ++displayed;
+    frameTimeMaxMs = qMax(frameTimeMaxMs, ms);
+}
+
+void SequencePlaybackStats::addDecodeTime(double ms)
+{
+    decodeMsTotal += ms;
+    ++decodeSamples;
+}
+
+double SequencePlaybackStats::frameTimePercentile(double p) const
+{
+    qint64 samples = 0;
+    for (int count : frameTimeHistogram) samples += count;
+    if (samples == 0) return 0.0;
+    const qint64 rank = qMax<qint64>(1, qint64(std::ceil(samples * p / 100.0)));
+    qint64 seen = 0;
+    for (int ms = 0; ms < frameTimeHistogram.size(); ++ms) {
+        seen += frameTimeHistogram[ms];
+        if (seen >= rank) return ms == kHistogramMs ? frameTimeMaxMs : ms + 1;
+    }
+    return frameTimeMaxMs;
+}
+
+QString SequencePlaybackStats::summary(double targetFps, double cacheDecodeMs) const
+{
+    QString text = QString("%1 frames shown, %2 dropped, %3 late; frame time p50 %4 / p95 %5 / p99 %6 / max %7 ms (target %8 ms)")
+        .arg(displayed).arg(dropped).arg(late)
+        .arg(frameTimePercentile(50), 0, 'f', 0)
+        .arg(frameTimePercentile(95), 0, 'f', 0)
+        .arg(frameTimePercentile(99), 0, 'f', 0)
+        .arg(frameTimeMaxMs, 0, 'f', 1)
+        .arg(targetFps > 0 ? 1000.0 / targetFps : 0.0, 0, 'f', 1);
+    if (cacheDecodeMs > 0) text += QString("; cache decode %1 ms").arg(cacheDecodeMs, 0, 'f', 1);
+    if (decodeSamples > 0) text += QString("; direct decode %1 ms").arg(decodeMsTotal / decodeSamples, 0, 'f', 1);
+    return text;
+}
@@ -0,0 +1,50 @@
+#pragma once
+#include <QString>
+#include <QVector>
+
+/**
+ * SequencePlayback - playback order and pacing of image sequences
+ *
+ * Widget-free pieces shared by PreviewOverlay's playback clock and
+ * SequenceFrameCache's prefetch window: which frame playback reaches next
+ * (looping, or bouncing at the ends in ping-pong), which frames the cache
+ * keeps around the play head, and the per-run frame pacing statistics
+ * logged when playback stops.
+ */
+namespace SequencePlayback {
+
+// Next frame in playback order: wraps at the ends, or bounces (flipping `direction`) in ping-pong
+int step(int index, int& direction, int total, bool pingPong);
+// Frame reached after `steps` frames of playback in `direction`; same as calling step()
+// `steps` times, in constant time
+int frameAfter(int frame, qint64 steps, int& direction, int total, bool pingPong);
+
+// Frames to keep ahead of the play head out of `capacity`: half the cache until decoding
+// is measured, everything but a short trail when `workers` can't keep up with targetFps,
+// otherwise one decode latency plus a second of margin
+int leadFrames(int capacity, int workers, double avgDecodeMs, double targetFps);
+// Up to `capacity` frames in prefetch priority: `current`, then `lead` frames in playback
+// order, then the frames just played
+QVector<int> window(int current, int direction, int total, bool pingPong, int lead, int capacity);
+
+}
+
+// Real-time pacing statistics of one sequence playback run (play to pause/stop)
+struct SequencePlaybackStats {
+    static constexpr int kHistogramMs = 100; // 1 ms buckets; the last one holds everything slower
+
+    QVector<int> frameTimeHistogram;  // time between consecutive displayed frames
+    int displayed = 0;
+    int dropped = 0;                  // skipped to hold real time, or not decoded in time
+    int late = 0;                     // shown at least one frame period late (wait mode)
+    double frameTimeMaxMs = 0.0;
+    double decodeMsTotal = 0.0;       // direct (uncached) loads
+    int decodeSamples = 0;
+
+    void reset();
+    void addFrameTime(double ms);
+    void addDecodeTime(double ms);
+    // Upper bound (1 ms resolution) of the p-th percentile frame time; 0 without samples
+    double frameTimePercentile(double p) const;
+    QString summary(double targetFps, double cacheDecodeMs) const;
+};
@@ -0,0 +1,204 @@
+#include "sequence_read_ahead.h"
+
+#include <QDeadlineTimer>
+#include <QDebug>
+#include <QFile>
+#include <QObject>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+// Large requests amortise per-request latency on network shares
+constexpr qint64 kReadChunk = 8LL * 1024 * 1024;
+// Queued frames past the reads in flight that get a WILLNEED hint
+constexpr int kAdviseAhead = 4;
+
+} // namespace
+
+SequenceReadAhead::SequenceReadAhead(int ioThreads)
+{
+    m_pool.setMaxThreadCount(qMax(1, ioThreads));
+}
+
+SequenceReadAhead::~SequenceReadAhead()
+{
+    {
+        QMutexLocker lk(&m_mutex);
+        m_shutdown = true;
+        m_queue.clear();
+        m_readDone.wakeAll();
+    }
+    m_pool.waitForDone();
+}
+
+void SequenceReadAhead::setLimits(qint64 maxBytes, int maxFrames)
+{
+    QMutexLocker lk(&m_mutex);
+    m_maxBytes = qMax<qint64>(0, maxBytes);
+    m_maxFrames = qMax(0, maxFrames);
+    pumpLocked();
+}
+
+qint64 SequenceReadAhead::maxBytes() const
+{
+    QMutexLocker lk(&m_mutex);
+    return m_maxBytes;
+}
+
+int SequenceReadAhead::maxFrames() const
+{
+    QMutexLocker lk(&m_mutex);
+    return m_maxFrames;
+}
+
+void SequenceReadAhead::setQueue(const QStringList& paths)
+{
+    QMutexLocker lk(&m_mutex);
+    m_wanted = QSet<QString>(paths.begin(), paths.end());
+    // Frames stay consumed (and advised) only while they stay queued
+    m_consumed.intersect(m_wanted);
+    m_advised.intersect(m_wanted);
+    m_queue.clear();
+    for (const QString& path : paths) {
+        if (!m_buffers.contains(path) && !m_inFlight.contains(path) && !m_consumed.contains(path)) {
+            m_queue.append(path);
+        }
+    }
+    for (auto it = m_buffers.begin(); it != m_buffers.end();) {
+        if (m_wanted.contains(it.key())) {
+            ++it;
+        } else {
+            m_bufferedBytes -= it.value().size();
+            it = m_buffers.erase(it);
+        }
+    }
+    pumpLocked();
+}
+
+QByteArray SequenceReadAhead::take(const QString& path, int timeoutMs)
+{
+    QMutexLocker lk(&m_mutex);
+    QDeadlineTimer deadline(timeoutMs);
+    while (m_inFlight.contains(path) && !m_shutdown) {
+        if (!m_readDone.wait(&m_mutex, deadline)) break;
+    }
+    m_consumed.insert(path);
+    auto it = m_buffers.find(path);
+    if (it == m_buffers.end()) {
+        // Not read yet: the decoder reads it now, so don't read it again
+        m_queue.removeOne(path);
+        return QByteArray();
+    }
+    const QByteArray data = it.value();
+    m_bufferedBytes -= data.size();
+    m_buffers.erase(it);
+    pumpLocked();
+    return data;
+}
+
+void SequenceReadAhead::clear()
+{
+    QMutexLocker lk(&m_mutex);
+    ++m_generation; // reads in flight are dropped when they land
+    m_queue.clear();
+    m_wanted.clear();
+    m_consumed.clear();
+    m_advised.clear();
+    m_buffers.clear();
+    m_bufferedBytes = 0;
+}
+
+int SequenceReadAhead::bufferedFrames() const
+{
+    QMutexLocker lk(&m_mutex);
+    return m_buffers.size();
+}
+
+qint64 SequenceReadAhead::bufferedBytes() const
+{
+    QMutexLocker lk(&m_mutex);
+    return m_bufferedBytes;
+}
+
+void SequenceReadAhead::pumpLocked()
+{
+    if (m_shutdown) return;
+    // One read per I/O thread: a frame a decoder waits for never queues behind others
+    while (!m_queue.isEmpty()
+           && m_inFlight.size() < m_pool.maxThreadCount()
+           && m_buffers.size() + m_inFlight.size() < m_maxFrames
+           && m_bufferedBytes + m_inFlight.size() * m_avgFrameBytes < m_maxBytes) {
+        const QString path = m_queue.takeFirst();
+        m_inFlight.insert(path);
+        const quint64 generation = m_generation;
+        m_pool.start([this, path, generation]() { readOne(path, generation); });
+    }
+}
+
+void SequenceReadAhead::readOne(const QString& path, quint64 generation)
+{
+    QString error;
+    const QByteArray data = readFile(path, &error);
+    QStringList advise;
+    {
+        QMutexLocker lk(&m_mutex);
+        m_inFlight.remove(path);
+        if (data.isEmpty()) {
+            qWarning() << "[SequenceReadAhead]" << error;
+        } else if (generation == m_generation && m_wanted.contains(path) && !m_consumed.contains(path)) {
+            m_buffers.insert(path, data);
+            m_bufferedBytes += data.size();
+            m_avgFrameBytes = m_avgFrameBytes > 0 ? (m_avgFrameBytes * 7 + data.size()) / 8 : data.size();
+        }
+        m_readDone.wakeAll();
+        pumpLocked();
+        // Let the OS start on the frames after the ones being read
+        for (const QString& next : std::as_const(m_queue)) {
+            if (advise.size() >= kAdviseAhead) break;
+            if (m_advised.contains(next)) continue;
+            m_advised.insert(next);
+            advise.append(next);
+        }
+    }
+    for (const QString& next : std::as_const(advise)) adviseWillNeed(next);
+}
+
+QByteArray SequenceReadAhead::readFile(const QString& path, QString* errorOut)
+{
+    QFile f(path);
+    if (!f.open(QIODevice::ReadOnly | QIODevice::Unbuffered)) {
+        if (errorOut) *errorOut = QObject::tr("Failed to open %1").arg(path);
+        return QByteArray();
+    }
+#if defined(POSIX_FADV_SEQUENTIAL)
+    ::posix_fadvise(f.handle(), 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+    const qint64 size = f.size();
+    QByteArray data(size, Qt::Uninitialized);
+    qint64 done = 0;
+    while (done < size) {
+        const qint64 n = f.read(data.data() + done, qMin(kReadChunk, size - done));
+        if (n <= 0) {
+            if (errorOut) *errorOut = QObject::tr("Failed to read %1").arg(path);
+            return QByteArray();
+        }
+        done += n;
+    }
+    return data;
+}
+
+void SequenceReadAhead::adviseWillNeed(const QString& path)
+{
+#if defined(POSIX_FADV_WILLNEED)
+    const int fd = ::open(QFile::encodeName(path).constData(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return;
+    ::posix_fadvise(fd, 0, 0, POSIX_FADV_WILLNEED);
+    ::close(fd);
+#else
+    Q_UNUSED(path);
+#endif
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <QByteArray>
+#include <QHash>
+#include <QMutex>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+#include <QThreadPool>
+#include <QWaitCondition>
+
+/**
+ * SequenceReadAhead - I/O stage of the image sequence playback pipeline
+ *
+ * Reads the encoded bytes of upcoming frames into a bounded in-memory pool
+ * ahead of the decoders, with large sequential reads on a couple of dedicated
+ * I/O threads. Frames queued beyond the reads in flight get a WILLNEED hint,
+ * so the kernel (or NFS/SMB client) starts fetching them early too. Decoders
+ * take() a frame's bytes and decode from memory, which keeps network latency
+ * off the decode threads: playback becomes decode-bound.
+ *
+ * The queue is replaced wholesale by the frame cache as its window moves;
+ * buffered frames that leave the queue are dropped. All methods are thread-safe.
+ */
+class SequenceReadAhead {
+public:
+    explicit SequenceReadAhead(int ioThreads = 2);
+    ~SequenceReadAhead();
+
+    // Pool bounds; reads stop while either is reached
+    void setLimits(qint64 maxBytes, int maxFrames);
+    qint64 maxBytes() const;
+    int maxFrames() const;
+
+    // Frames to read, in priority order
+    void setQueue(const QStringList& paths);
+    // Bytes of `path`, removed from the pool. Waits up to timeoutMs while its read is
+    // in flight; empty when the frame is not buffered (the caller reads it itself).
+    QByteArray take(const QString& path, int timeoutMs = 5000);
+    void clear();
+
+    int bufferedFrames() const;
+    qint64 bufferedBytes() const;
+
+    // Whole file in large sequential reads
+    static QByteArray readFile(const QString& path, QString* errorOut = nullptr);
+    // Asks the OS to start fetching `path` (no-op where unsupported)
+    static void adviseWillNeed(const QString& path);
+
+private:
+    void pumpLocked();
+    void readOne(const QString& path, quint64 generation);
+
+    mutable QMutex m_mutex;
+    QWaitCondition m_readDone;
+    QStringList m_queue;          // not yet started, priority order
+    QSet<QString> m_wanted;       // everything in the latest queue
+    QSet<QString> m_inFlight;
+    QSet<QString> m_consumed;     // taken by a decoder while queued; not read again
+    QSet<QString> m_advised;
+    QHash<QString, QByteArray> m_buffers;
+    qint64 m_bufferedBytes = 0;
+    qint64 m_avgFrameBytes = 0;
+    qint64 m_maxBytes = 512LL * 1024 * 1024;
+    int m_maxFrames = 32;
+    quint64 m_generation = 0;
+    bool m_shutdown = false;
+    QThreadPool m_pool;
+};
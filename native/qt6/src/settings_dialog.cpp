@@ -1,6 +1,7 @@
 #include "settings_dialog.h"
 #include "db.h"
 #include "live_preview_manager.h"
+#include "proxy_manager.h"
 #include <QFileDialog>
 #include <QMessageBox>
 #include <QDir>
@@ -205,6 +206,13 @@ void SettingsDialog::setupCacheTab()
     sequenceCacheMemoryLabel->setStyleSheet("color: #aaaaaa; font-style: italic;");
     seqCacheLayout->addWidget(sequenceCacheMemoryLabel);
 
+    // Playback pacing: drop late frames (real-time speed) or wait for every frame
+    sequenceDropFramesCheck = new QCheckBox("Drop late frames to hold real-time playback speed", seqCacheGroup);
+    sequenceDropFramesCheck->setChecked(s.value("SequencePlayback/DropFrames", true).toBool());
+    sequenceDropFramesCheck->setToolTip("When off, playback shows every frame and slows down while frames are still decoding");
+    sequenceDropFramesCheck->setStyleSheet("QCheckBox { color: #ffffff; }");
+    seqCacheLayout->addWidget(sequenceDropFramesCheck);
+
     // Connect signals to update UI
     connect(autoSequenceCacheCheck, &QCheckBox::toggled, [this](bool checked) {
         autoSequenceCachePercentSpin->setEnabled(checked);
@@ -222,6 +230,108 @@ void SettingsDialog::setupCacheTab()
 
     layout->addWidget(seqCacheGroup);
 
+    // Video playback
+    QGroupBox* videoGroup = new QGroupBox("Video Playback", cacheTab);
+    videoGroup->setStyleSheet("QGroupBox { color: #ffffff; border: 1px solid #333; padding: 10px; margin-top: 10px; } QGroupBox::title { subcontrol-origin: margin; left: 10px; padding: 0 5px; }");
+    QVBoxLayout* videoLayout = new QVBoxLayout(videoGroup);
+    QHBoxLayout* reverseBufferLayout = new QHBoxLayout();
+    QLabel* reverseBufferLabel = new QLabel("Backward step buffer:", videoGroup);
+    reverseBufferLabel->setStyleSheet("color: #ffffff;");
+    reverseBufferLayout->addWidget(reverseBufferLabel);
+    reverseBufferSpin = new QSpinBox(videoGroup);
+    reverseBufferSpin->setRange(64, 16384);
+    reverseBufferSpin->setSingleStep(64);
+    reverseBufferSpin->setValue(s.value("VideoPlayback/ReverseBufferMB", 512).toInt());
+    reverseBufferSpin->setSuffix(" MB");
+    reverseBufferSpin->setToolTip("Memory for decoded frames behind the playhead, used by frame stepping backward and reverse playback (J)");
+    reverseBufferSpin->setStyleSheet("QSpinBox { background-color: #1e1e1e; color: #ffffff; border: 1px solid #333; padding: 4px; }");
+    reverseBufferLayout->addWidget(reverseBufferSpin);
+    reverseBufferLayout->addStretch();
+    videoLayout->addLayout(reverseBufferLayout);
+    layout->addWidget(videoGroup);
+
+    // Playback proxies
+    QGroupBox* proxyGroup = new QGroupBox("Playback Proxies", cacheTab);
+    proxyGroup->setStyleSheet("QGroupBox { color: #ffffff; border: 1px solid #333; padding: 10px; margin-top: 10px; } QGroupBox::title { subcontrol-origin: margin; left: 10px; padding: 0 5px; }");
+    QVBoxLayout* proxyLayout = new QVBoxLayout(proxyGroup);
+    ProxyManager& proxies = ProxyManager::instance();
+    const QString comboStyle = "QComboBox { background-color: #1e1e1e; color: #ffffff; border: 1px solid #333; padding: 4px; }";
+
+    proxiesEnabledCheck = new QCheckBox("Play and scrub heavy media from reduced-resolution proxies", proxyGroup);
+    proxiesEnabledCheck->setChecked(proxies.isEnabled());
+    proxiesEnabledCheck->setStyleSheet("QCheckBox { color: #ffffff; }");
+    proxyLayout->addWidget(proxiesEnabledCheck);
+
+    proxiesAutoCheck = new QCheckBox("Generate proxies automatically when heavy media is previewed", proxyGroup);
+    proxiesAutoCheck->setChecked(proxies.autoGenerate());
+    proxiesAutoCheck->setStyleSheet("QCheckBox { color: #ffffff; }");
+    proxyLayout->addWidget(proxiesAutoCheck);
+
+    QHBoxLayout* proxyFormatLayout = new QHBoxLayout();
+    QLabel* proxyScaleLabel = new QLabel("Resolution:", proxyGroup);
+    proxyScaleLabel->setStyleSheet("color: #ffffff;");
+    proxyFormatLayout->addWidget(proxyScaleLabel);
+    proxyScaleCombo = new QComboBox(proxyGroup);
+    proxyScaleCombo->addItem("Half", 2);
+    proxyScaleCombo->addItem("Quarter", 4);
+    proxyScaleCombo->setCurrentIndex(proxies.scale() == 4 ? 1 : 0);
+    proxyScaleCombo->setStyleSheet(comboStyle);
+    proxyFormatLayout->addWidget(proxyScaleCombo);
+
+    QLabel* proxySeqLabel = new QLabel("Sequences:", proxyGroup);
+    proxySeqLabel->setStyleSheet("color: #ffffff;");
+    proxyFormatLayout->addWidget(proxySeqLabel);
+    proxySequenceFormatCombo = new QComboBox(proxyGroup);
+    proxySequenceFormatCombo->addItem("JPEG", "jpeg");
+    proxySequenceFormatCombo->addItem("Half-float EXR", "exr");
+    proxySequenceFormatCombo->setCurrentIndex(proxies.sequenceFormat() == ProxyManager::SequenceFormat::HalfExr ? 1 : 0);
+    proxySequenceFormatCombo->setStyleSheet(comboStyle);
+    proxyFormatLayout->addWidget(proxySequenceFormatCombo);
+
+    QLabel* proxyVideoLabel = new QLabel("Video:", proxyGroup);
+    proxyVideoLabel->setStyleSheet("color: #ffffff;");
+    proxyFormatLayout->addWidget(proxyVideoLabel);
+    proxyVideoCodecCombo = new QComboBox(proxyGroup);
+    proxyVideoCodecCombo->addItem("MJPEG", "mjpeg");
+    proxyVideoCodecCombo->addItem("H.264 (intra)", "h264");
+    proxyVideoCodecCombo->setCurrentIndex(proxies.videoCodec() == ProxyManager::VideoCodec::H264Intra ? 1 : 0);
+    proxyVideoCodecCombo->setStyleSheet(comboStyle);
+    proxyFormatLayout->addWidget(proxyVideoCodecCombo);
+    proxyFormatLayout->addStretch();
+    proxyLayout->addLayout(proxyFormatLayout);
+
+    QHBoxLayout* proxyBudgetLayout = new QHBoxLayout();
+    QLabel* proxyBudgetLabel = new QLabel("Cache budget:", proxyGroup);
+    proxyBudgetLabel->setStyleSheet("color: #ffffff;");
+    proxyBudgetLayout->addWidget(proxyBudgetLabel);
+    proxyBudgetSpin = new QSpinBox(proxyGroup);
+    proxyBudgetSpin->setRange(1, 4096);
+    proxyBudgetSpin->setValue(int(qMax<qint64>(1, proxies.budgetBytes() >> 30)));
+    proxyBudgetSpin->setSuffix(" GB");
+    proxyBudgetSpin->setStyleSheet("QSpinBox { background-color: #1e1e1e; color: #ffffff; border: 1px solid #333; padding: 4px; }");
+    proxyBudgetLayout->addWidget(proxyBudgetSpin);
+    proxyBudgetLayout->addStretch();
+    proxyLayout->addLayout(proxyBudgetLayout);
+
+    proxyUsageLabel = new QLabel(proxyGroup);
+    proxyUsageLabel->setStyleSheet("color: #aaaaaa; font-style: italic;");
+    proxyUsageLabel->setText(QString("%1 proxies, %2 MB in %3")
+                                 .arg(proxies.proxies().size())
+                                 .arg(proxies.totalBytes() / (1024 * 1024))
+                                 .arg(QDir::toNativeSeparators(proxies.cacheDir())));
+    proxyUsageLabel->setWordWrap(true);
+    proxyLayout->addWidget(proxyUsageLabel);
+
+    QPushButton* clearProxiesBtn = new QPushButton("Clear Proxies", proxyGroup);
+    clearProxiesBtn->setStyleSheet(
+        "QPushButton { background-color: #d73a49; color: #ffffff; border: none; padding: 8px 16px; border-radius: 4px; }"
+        "QPushButton:hover { background-color: #b52a3a; }"
+    );
+    connect(clearProxiesBtn, &QPushButton::clicked, this, &SettingsDialog::onClearProxies);
+    proxyLayout->addWidget(clearProxiesBtn);
+
+    layout->addWidget(proxyGroup);
+
     // Database management
     QGroupBox* dbGroup = new QGroupBox("Database", cacheTab);
     dbGroup->setStyleSheet("QGroupBox { color: #ffffff; border: 1px solid #333; padding: 10px; margin-top: 10px; } QGroupBox::title { subcontrol-origin: margin; left: 10px; padding: 0 5px; }");
@@ -537,6 +647,31 @@ void SettingsDialog::saveSettings()
     if (sequenceCacheSizeSpin) {
         s.setValue("SequenceCache/ManualSize", sequenceCacheSizeSpin->value());
     }
+    if (sequenceDropFramesCheck) {
+        s.setValue("SequencePlayback/DropFrames", sequenceDropFramesCheck->isChecked());
+    }
+    if (reverseBufferSpin) {
+        s.setValue("VideoPlayback/ReverseBufferMB", reverseBufferSpin->value());
+    }
+
+    // Save playback proxy settings
+    if (proxiesEnabledCheck) {
+        ProxyManager& proxies = ProxyManager::instance();
+        s.setValue("Proxies/Enabled", proxiesEnabledCheck->isChecked());
+        s.setValue("Proxies/AutoGenerate", proxiesAutoCheck->isChecked());
+        s.setValue("Proxies/Scale", proxyScaleCombo->currentData().toInt());
+        s.setValue("Proxies/SequenceFormat", proxySequenceFormatCombo->currentData().toString());
+        s.setValue("Proxies/VideoCodec", proxyVideoCodecCombo->currentData().toString());
+        s.setValue("Proxies/BudgetGB", proxyBudgetSpin->value());
+        proxies.setEnabled(proxiesEnabledCheck->isChecked());
+        proxies.setAutoGenerate(proxiesAutoCheck->isChecked());
+        proxies.setScale(proxyScaleCombo->currentData().toInt());
+        proxies.setSequenceFormat(proxySequenceFormatCombo->currentIndex() == 1 ? ProxyManager::SequenceFormat::HalfExr
+                                                                                : ProxyManager::SequenceFormat::Jpeg);
+        proxies.setVideoCodec(proxyVideoCodecCombo->currentIndex() == 1 ? ProxyManager::VideoCodec::H264Intra
+                                                                        : ProxyManager::VideoCodec::Mjpeg);
+        proxies.setBudgetBytes(qint64(proxyBudgetSpin->value()) << 30);
+    }
 
     // Persist File Manager shortcuts
     if (fmShortcutsTable) {
@@ -579,6 +714,22 @@ void SettingsDialog::saveSettings()
     accept();
 }
 
+void SettingsDialog::onClearProxies()
+{
+    QMessageBox::StandardButton reply = QMessageBox::question(
+        this,
+        "Clear Proxies",
+        "Delete all generated playback proxies? They are regenerated when needed.",
+        QMessageBox::Yes | QMessageBox::No
+    );
+    if (reply != QMessageBox::Yes) return;
+
+    ProxyManager::instance().clearAll();
+    if (proxyUsageLabel) {
+        proxyUsageLabel->setText(QString("0 proxies, 0 MB in %1").arg(QDir::toNativeSeparators(ProxyManager::instance().cacheDir())));
+    }
+}
+
 void SettingsDialog::updateSequenceCacheMemoryLabel()
 {
     if (!sequenceCacheMemoryLabel || !autoSequenceCacheCheck ||
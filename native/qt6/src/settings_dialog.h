@@ -28,6 +28,7 @@ private slots:
     void onImportDatabase();
     void saveSettings();
     void updateSequenceCacheMemoryLabel();
+    void onClearProxies();
 
 private:
     void setupGeneralTab();
@@ -51,6 +52,19 @@ private:
     QLabel* sequenceCacheMemoryLabel;
     QCheckBox* autoSequenceCacheCheck;
     QSpinBox* autoSequenceCachePercentSpin;
+    QCheckBox* sequenceDropFramesCheck = nullptr;
+
+    // Video playback settings
+    QSpinBox* reverseBufferSpin = nullptr;
+
+    // Playback proxy settings
+    QCheckBox* proxiesEnabledCheck = nullptr;
+    QCheckBox* proxiesAutoCheck = nullptr;
+    QComboBox* proxyScaleCombo = nullptr;
+    QComboBox* proxySequenceFormatCombo = nullptr;
+    QComboBox* proxyVideoCodecCombo = nullptr;
+    QSpinBox* proxyBudgetSpin = nullptr;
+    QLabel* proxyUsageLabel = nullptr;
 
     // View tab
     QComboBox* viewModeCombo;
@@ -0,0 +1,85 @@
+#include "similarity_index.h"
+
+#include "db.h"
+#include "live_preview_manager.h"
+
+#include <QDebug>
+#include <QElapsedTimer>
+
+SimilarityIndex& SimilarityIndex::instance()
+{
+    static SimilarityIndex s;
+    return s;
+}
+
+SimilarityIndex::SimilarityIndex()
+{
+    // Hashes are computed on preview worker threads; AutoConnection queues them onto this thread
+    connect(&LivePreviewManager::instance(), &LivePreviewManager::perceptualHashReady,
+            this, &SimilarityIndex::onPerceptualHashReady);
+    connect(&DB::instance(), &DB::perceptualHashChanged, this, &SimilarityIndex::onPerceptualHashChanged);
+    connect(&DB::instance(), &DB::assetsRemoved, this, &SimilarityIndex::onAssetsRemoved);
+}
+
+void SimilarityIndex::reload()
+{
+    QElapsedTimer t; t.start();
+    m_index.clear();
+    const QHash<int, quint64> hashes = DB::instance().perceptualHashes();
+    for (auto it = hashes.constBegin(); it != hashes.constEnd(); ++it) m_index.insert(it.key(), it.value());
+    m_loaded = true;
+    qInfo() << "[SimilarityIndex] Loaded" << m_index.size() << "hashes in" << t.elapsed() << "ms";
+}
+
+void SimilarityIndex::ensureLoaded()
+{
+    if (!m_loaded) reload();
+}
+
+bool SimilarityIndex::hasHash(int assetId)
+{
+    ensureLoaded();
+    return m_index.contains(assetId);
+}
+
+QVector<PerceptualHashIndex::Match> SimilarityIndex::findSimilar(int assetId, int maxResults, int maxDistance)
+{
+    ensureLoaded();
+    QVector<PerceptualHashIndex::Match> out;
+    if (!m_index.contains(assetId)) return out;
+
+    const quint64 query = m_index.hashOf(assetId);
+    // Over-fetch a little so dropping stale rows still fills the page
+    const auto matches = m_index.nearest(query, maxResults + 16, maxDistance, assetId);
+    for (const auto& m : matches) {
+        if (DB::instance().getAssetFilePath(m.id).isEmpty()) {
+            m_index.remove(m.id);
+            continue;
+        }
+        out.append(m);
+        if (out.size() >= maxResults) break;
+    }
+    return out;
+}
+
+void SimilarityIndex::onPerceptualHashReady(const QString& filePath, quint64 hash)
+{
+    const int assetId = DB::instance().getAssetIdByPath(filePath);
+    if (assetId <= 0) return; // File Manager preview of an uncatalogued file
+    ensureLoaded();
+    if (m_index.contains(assetId) && m_index.hashOf(assetId) == hash) return;
+    DB::instance().setPerceptualHash(assetId, hash); // index updated via perceptualHashChanged
+}
+
+void SimilarityIndex::onPerceptualHashChanged(int assetId, bool hasHash, quint64 hash)
+{
+    if (!m_loaded) return; // picked up by the initial load
+    if (hasHash) m_index.insert(assetId, hash);
+    else m_index.remove(assetId);
+}
+
+void SimilarityIndex::onAssetsRemoved(const QList<int>& assetIds)
+{
+    if (!m_loaded) return;
+    for (int id : assetIds) m_index.remove(id);
+}
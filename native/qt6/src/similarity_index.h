@@ -0,0 +1,44 @@
+#pragma once
+
+#include <QObject>
+#include <QString>
+#include <QVector>
+
+#include "perceptual_hash.h"
+
+/**
+ * Catalog-wide similar-image index.
+ *
+ * Collects poster-frame dHashes reported by LivePreviewManager, persists them in
+ * assets.perceptual_hash and keeps an in-memory PerceptualHashIndex in sync with
+ * DB signals (hash set/cleared, assets removed). Lives on the GUI/DB thread.
+ */
+class SimilarityIndex : public QObject {
+    Q_OBJECT
+
+public:
+    static SimilarityIndex& instance();
+
+    // Load all stored hashes (cheap; called lazily on first query)
+    void reload();
+
+    bool hasHash(int assetId);
+    // Nearest assets to assetId, nearest first; stale ids (deleted via folder cascade) are dropped
+    QVector<PerceptualHashIndex::Match> findSimilar(int assetId, int maxResults = 50, int maxDistance = 12);
+
+private slots:
+    void onPerceptualHashReady(const QString& filePath, quint64 hash);
+    void onPerceptualHashChanged(int assetId, bool hasHash, quint64 hash);
+    void onAssetsRemoved(const QList<int>& assetIds);
+
+private:
+    SimilarityIndex();
+    ~SimilarityIndex() = default;
+    SimilarityIndex(const SimilarityIndex&) = delete;
+    SimilarityIndex& operator=(const SimilarityIndex&) = delete;
+
+    void ensureLoaded();
+
+    PerceptualHashIndex m_index;
+    bool m_loaded = false;
+};
@@ -0,0 +1,128 @@
+#include "tag_index.h"
+#include "db.h"
+
+#include <QDebug>
+#include <QElapsedTimer>
+
+TagIndex& TagIndex::instance()
+{
+    static TagIndex inst;
+    return inst;
+}
+
+TagIndex::TagIndex(QObject* parent)
+    : QObject(parent)
+{
+    DB& db = DB::instance();
+    connect(&db, &DB::tagsChanged, this, &TagIndex::invalidate);
+    connect(&db, &DB::assetTagsAssigned, this, &TagIndex::onAssetTagsAssigned);
+    connect(&db, &DB::assetsRemoved, this, &TagIndex::onAssetsRemoved);
+}
+
+void TagIndex::ensureLoaded() const
+{
+    if (m_loaded) return;
+    m_loaded = true;
+    QElapsedTimer timer;
+    timer.start();
+    m_assetsByTag.clear();
+    m_idByName.clear();
+    for (const auto& tag : DB::instance().listTags()) {
+        m_idByName.insert(tag.second, tag.first);
+        m_assetsByTag.insert(tag.first, RoaringBitmap());
+    }
+    // Ordered by tag then asset, so every bitmap is filled by appends
+    const QVector<QPair<int, int>> pairs = DB::instance().listAssetTagPairs();
+    RoaringBitmap* current = nullptr;
+    int currentTag = -1;
+    for (const auto& pair : pairs) {
+        if (pair.second != currentTag) {
+            currentTag = pair.second;
+            current = &m_assetsByTag[currentTag];
+        }
+        current->add(quint32(pair.first));
+    }
+    qDebug() << "[TagIndex] Loaded" << m_idByName.size() << "tags," << pairs.size() << "assignments in"
+             << timer.elapsed() << "ms";
+}
+
+void TagIndex::invalidate()
+{
+    m_loaded = false;
+    m_assetsByTag.clear();
+    m_idByName.clear();
+    emit changed();
+}
+
+int TagIndex::tagId(const QString& name) const
+{
+    ensureLoaded();
+    return m_idByName.value(name, -1);
+}
+
+RoaringBitmap TagIndex::assetsWithTag(int tagId) const
+{
+    ensureLoaded();
+    return m_assetsByTag.value(tagId);
+}
+
+RoaringBitmap TagIndex::match(const RoaringBitmap& scope, const QList<int>& all, const QList<int>& any,
+                              const QList<int>& none) const
+{
+    ensureLoaded();
+    RoaringBitmap result = scope;
+    for (int id : all) {
+        auto it = m_assetsByTag.constFind(id);
+        if (it == m_assetsByTag.constEnd()) return RoaringBitmap();
+        result &= *it;
+        if (result.isEmpty()) return result;
+    }
+    if (!any.isEmpty()) {
+        RoaringBitmap either;
+        for (int id : any) {
+            auto it = m_assetsByTag.constFind(id);
+            if (it != m_assetsByTag.constEnd()) either |= *it;
+        }
+        result &= either;
+    }
+    for (int id : none) {
+        auto it = m_assetsByTag.constFind(id);
+        if (it != m_assetsByTag.constEnd()) result.andNot(*it);
+    }
+    return result;
+}
+
+QHash<int, int> TagIndex::countsWithin(const RoaringBitmap& scope) const
+{
+    ensureLoaded();
+    QHash<int, int> counts;
+    for (auto it = m_assetsByTag.constBegin(); it != m_assetsByTag.constEnd(); ++it) {
+        const qint64 n = it->andCardinality(scope);
+        if (n > 0) counts.insert(it.key(), int(n));
+    }
+    return counts;
+}
+
+void TagIndex::onAssetTagsAssigned(const QList<int>& assetIds, const QList<int>& tagIds)
+{
+    if (!m_loaded) return; // picked up by the next load
+    for (int tagId : tagIds) {
+        auto it = m_assetsByTag.find(tagId);
+        if (it == m_assetsByTag.end()) {
+            // A tag this index has not seen yet: reload rather than guess its name
+            invalidate();
+            return;
+        }
+        for (int assetId : assetIds) it->add(quint32(assetId));
+    }
+    emit changed();
+}
+
+void TagIndex::onAssetsRemoved(const QList<int>& assetIds)
+{
+    if (!m_loaded) return;
+    for (auto it = m_assetsByTag.begin(); it != m_assetsByTag.end(); ++it) {
+        for (int assetId : assetIds) it->remove(quint32(assetId));
+    }
+    emit changed();
+}
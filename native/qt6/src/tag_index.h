@@ -0,0 +1,51 @@
+#pragma once
+#include <QObject>
+#include <QHash>
+#include <QList>
+#include <QString>
+#include <QStringList>
+
+#include "roaring_bitmap.h"
+
+/**
+ * TagIndex - in-memory asset sets per tag for filtering and counts
+ *
+ * Holds one RoaringBitmap of asset ids per tag id, loaded from asset_tags on
+ * first use and kept in step with DB notifications: assignments and asset
+ * removals are applied in place, tag create/rename/delete/merge reload it.
+ * Tag filters resolve names to ids once and then work on bitmaps only.
+ * GUI thread only, like DB.
+ */
+class TagIndex : public QObject {
+    Q_OBJECT
+public:
+    static TagIndex& instance();
+
+    // -1 when no tag has this exact name
+    int tagId(const QString& name) const;
+    RoaringBitmap assetsWithTag(int tagId) const;
+    // Assets of `scope` carrying every tag in `all`, at least one in `any` (when given)
+    // and none in `none`
+    RoaringBitmap match(const RoaringBitmap& scope, const QList<int>& all, const QList<int>& any,
+                        const QList<int>& none = {}) const;
+    // Per tag id: how many assets of `scope` carry it (tags with no hits are left out)
+    QHash<int, int> countsWithin(const RoaringBitmap& scope) const;
+
+    // Drops everything; the next query reloads from the database
+    void invalidate();
+
+signals:
+    void changed();
+
+private:
+    explicit TagIndex(QObject* parent = nullptr);
+    Q_DISABLE_COPY(TagIndex)
+
+    void ensureLoaded() const;
+    void onAssetTagsAssigned(const QList<int>& assetIds, const QList<int>& tagIds);
+    void onAssetsRemoved(const QList<int>& assetIds);
+
+    mutable bool m_loaded = false;
+    mutable QHash<int, RoaringBitmap> m_assetsByTag;
+    mutable QHash<QString, int> m_idByName;
+};
@@ -18,7 +18,11 @@ public:
         if (!idx.isValid() || idx.row()<0 || idx.row()>=m_rows.size()) return {};
         const auto &p = m_rows[idx.row()];
         if (role == IdRole) return p.first;
-        if (role == NameRole || role == Qt::DisplayRole) return p.second;
+        if (role == NameRole) return p.second;
+        if (role == Qt::DisplayRole) {
+            if (!m_hasCounts) return p.second;
+            return QString("%1 (%2)").arg(p.second).arg(m_counts.value(p.first));
+        }
         return {};
     }
     QHash<int,QByteArray> roleNames() const override { QHash<int,QByteArray> r; r[IdRole]="id"; r[NameRole]="name"; return r; }
@@ -27,6 +31,15 @@ public:
     Q_INVOKABLE bool renameTag(int id, const QString& name) { bool ok=DB::instance().renameTag(id,name); if (ok) reload(); return ok; }
     Q_INVOKABLE bool deleteTag(int id) { bool ok=DB::instance().deleteTag(id); if (ok) reload(); return ok; }
 
+    // Assets per tag id shown next to each name (AssetsModel facet counts); rows keep
+    // their selection since only the display text changes
+    void setCounts(const QHash<int,int>& counts) {
+        if (m_hasCounts && counts == m_counts) return;
+        m_counts = counts;
+        m_hasCounts = true;
+        if (!m_rows.isEmpty()) emit dataChanged(index(0), index(m_rows.size() - 1), {Qt::DisplayRole});
+    }
+
 public slots:
     void reload() {
         beginResetModel();
@@ -36,4 +49,6 @@ public slots:
 
 private:
     QVector<QPair<int,QString>> m_rows;
+    QHash<int,int> m_counts;
+    bool m_hasCounts = false;
 };
@@ -0,0 +1,572 @@
+#include "transfer_scheduler.h"
+
+#include "copy_engine.h"
+#include "file_utils.h"
+
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QDirIterator>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QHash>
+#include <QMutex>
+#include <QObject>
+#include <QSet>
+#include <QSaveFile>
+#include <QSemaphore>
+#include <QSettings>
+#include <QStorageInfo>
+#include <QSysInfo>
+#include <QThreadPool>
+#include <QXmlStreamWriter>
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#ifndef _WIN32
+#include <cerrno>
+#include <climits>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+constexpr int kProgressIntervalMs = 50;
+constexpr int kDeleteBatchSize = 256;
+
+// Serializes and throttles progress reports coming from many worker threads
+class ProgressAggregator {
+public:
+    ProgressAggregator(const TransferScheduler::ProgressFn& fn, qint64 bytesTotal, int filesTotal)
+        : m_fn(fn), m_bytesTotal(bytesTotal), m_filesTotal(filesTotal) { m_clock.start(); }
+
+    void addBytes(qint64 n) { m_bytes.fetch_add(n); }
+    void fileDone(const QString& path) { m_files.fetch_add(1); report(path, false); }
+
+    void report(const QString& path, bool force)
+    {
+        if (!m_fn) return;
+        QMutexLocker lk(&m_mutex);
+        if (!force && m_clock.elapsed() < kProgressIntervalMs) return;
+        m_clock.restart();
+        TransferScheduler::Progress p;
+        p.bytesDone = m_bytes.load();
+        p.bytesTotal = m_bytesTotal;
+        p.filesDone = m_files.load();
+        p.filesTotal = m_filesTotal;
+        p.currentFile = path;
+        m_fn(p);
+    }
+
+private:
+    const TransferScheduler::ProgressFn& m_fn;
+    const qint64 m_bytesTotal;
+    const int m_filesTotal;
+    std::atomic<qint64> m_bytes{0};
+    std::atomic<int> m_files{0};
+    QMutex m_mutex;
+    QElapsedTimer m_clock;
+};
+
+// First error wins; later workers see failed() and skip their work
+class ErrorSlot {
+public:
+    void set(const QString& msg)
+    {
+        QMutexLocker lk(&m_mutex);
+        if (m_failed.exchange(true)) return;
+        m_message = msg;
+    }
+    bool failed() const { return m_failed.load(); }
+    QString message() const { QMutexLocker lk(&m_mutex); return m_message; }
+
+private:
+    std::atomic_bool m_failed{false};
+    mutable QMutex m_mutex;
+    QString m_message;
+};
+
+QString uniqueTarget(const QString& dir, const QString& baseName, QSet<QString>& reserved)
+{
+    QString path = QDir(dir).filePath(baseName);
+    const QString stem = QFileInfo(baseName).completeBaseName();
+    const QString ext = QFileInfo(baseName).suffix();
+    int i = 2;
+    while (FileUtils::pathExists(path) || reserved.contains(path)) {
+        const QString name = ext.isEmpty() ? QString("%1 (%2)").arg(stem).arg(i++)
+                                           : QString("%1 (%2).%3").arg(stem).arg(i++).arg(ext);
+        path = QDir(dir).filePath(name);
+    }
+    reserved.insert(path);
+    return path;
+}
+
+bool isInside(const QString& path, const QString& dir)
+{
+    const QString d = QDir::cleanPath(QFileInfo(dir).absoluteFilePath());
+    const QString p = QDir::cleanPath(QFileInfo(path).absoluteFilePath());
+    return p == d || p.startsWith(d + QLatin1Char('/'));
+}
+
+// A link to a folder (or to nothing) has no content to copy; the link itself is recreated
+bool isContentlessLink(const QFileInfo& fi)
+{
+    return fi.isSymLink() && (fi.isDir() || !fi.exists());
+}
+
+// Raw link text, so relative links stay relative at the destination
+QString readLinkText(const QString& path)
+{
+#ifndef _WIN32
+    QByteArray buf(PATH_MAX, Qt::Uninitialized);
+    const ssize_t n = ::readlink(QFile::encodeName(path).constData(), buf.data(), size_t(buf.size()));
+    return n > 0 ? QFile::decodeName(buf.left(int(n))) : QString();
+#else
+    return QFileInfo(path).symLinkTarget();
+#endif
+}
+
+bool createLink(const QString& text, const QString& linkPath, QString* errorOut)
+{
+#ifndef _WIN32
+    if (::symlink(QFile::encodeName(text).constData(), QFile::encodeName(linkPath).constData()) == 0) return true;
+    if (errorOut) *errorOut = QObject::tr("Failed to create link %1: %2").arg(linkPath, QString::fromLocal8Bit(std::strerror(errno)));
+    return false;
+#else
+    // Creating links needs Developer Mode or elevation on Windows; leave it out rather than fail the job
+    Q_UNUSED(errorOut);
+    qWarning() << "[TransferScheduler] Skipping symbolic link" << linkPath << "->" << text;
+    return true;
+#endif
+}
+
+bool removeFileAt(int dirFd, const QString& dirPath, const QString& name, QString* errorOut)
+{
+#ifndef _WIN32
+    const QByteArray n = QFile::encodeName(name);
+    if (::unlinkat(dirFd, n.constData(), 0) == 0 || errno == ENOENT) return true;
+    if (errorOut) *errorOut = QObject::tr("Failed to delete %1: %2").arg(QDir(dirPath).filePath(name), QString::fromLocal8Bit(std::strerror(errno)));
+    return false;
+#else
+    Q_UNUSED(dirFd);
+    const QString path = QDir(dirPath).filePath(name);
+    if (QFile::remove(path) || !FileUtils::pathExists(path)) return true;
+    if (errorOut) *errorOut = QObject::tr("Failed to delete %1").arg(path);
+    return false;
+#endif
+}
+
+} // namespace
+
+int TransferScheduler::defaultConcurrency()
+{
+    QSettings s("AugmentCode", "KAssetManager");
+    return qBound(1, s.value("FileOps/ParallelTransfersPerDevice", 4).toInt(), 32);
+}
+
+quint64 TransferScheduler::deviceOf(const QString& path)
+{
+    // Destinations may not exist yet: use the nearest existing ancestor
+    QString p = QFileInfo(path).absoluteFilePath();
+    while (!p.isEmpty() && !FileUtils::pathExists(p)) {
+        const QString parent = QFileInfo(p).absolutePath();
+        if (parent == p) break;
+        p = parent;
+    }
+#ifndef _WIN32
+    struct stat st {};
+    if (::stat(QFile::encodeName(p).constData(), &st) == 0) return quint64(st.st_dev);
+    return 0;
+#else
+    return qHash(QStorageInfo(p).rootPath().toLower());
+#endif
+}
+
+TransferScheduler::Plan TransferScheduler::planCopy(const QStringList& sources, const QString& destDir)
+{
+    Plan plan;
+    const quint64 dstDev = deviceOf(destDir);
+    QSet<QString> reserved;
+    for (const QString& s : sources) {
+        const QFileInfo sfi(s);
+        if (!sfi.exists() && !sfi.isSymLink()) { plan.error = QObject::tr("Source not found: %1").arg(s); return plan; }
+        if (sfi.isDir() && !sfi.isSymLink() && isInside(destDir, s)) {
+            plan.error = QObject::tr("Cannot copy folder %1 into itself").arg(s);
+            return plan;
+        }
+        const QString target = uniqueTarget(destDir, sfi.fileName(), reserved);
+        plan.topLevelTargets << target;
+        const quint64 srcDev = deviceOf(s);
+
+        if (isContentlessLink(sfi)) {
+            plan.symlinks.append({ readLinkText(sfi.absoluteFilePath()), target });
+            continue;
+        }
+        if (!sfi.isDir()) {
+            plan.files.append({ sfi.absoluteFilePath(), target, sfi.size(), srcDev, dstDev });
+            plan.totalBytes += sfi.size();
+            continue;
+        }
+
+        // One walk per source; QDirIterator does not follow symlinked directories
+        plan.dirsToCreate << target;
+        const QDir srcDir(sfi.absoluteFilePath());
+        QDirIterator it(srcDir.absolutePath(), QDir::AllEntries | QDir::NoDotAndDotDot | QDir::Hidden | QDir::System,
+                        QDirIterator::Subdirectories);
+        while (it.hasNext()) {
+            it.next();
+            const QFileInfo fi = it.fileInfo();
+            const QString dst = target + QLatin1Char('/') + srcDir.relativeFilePath(fi.absoluteFilePath());
+            if (isContentlessLink(fi)) {
+                plan.symlinks.append({ readLinkText(fi.absoluteFilePath()), dst });
+            } else if (fi.isDir()) {
+                plan.dirsToCreate << dst;
+            } else {
+                plan.files.append({ fi.absoluteFilePath(), dst, fi.size(), srcDev, dstDev });
+                plan.totalBytes += fi.size();
+            }
+        }
+    }
+    // Parents first (mkpath would cope either way, this keeps the syscalls minimal)
+    std::sort(plan.dirsToCreate.begin(), plan.dirsToCreate.end(), [](const QString& a, const QString& b) {
+        return a.count(QLatin1Char('/')) < b.count(QLatin1Char('/'));
+    });
+    return plan;
+}
+
+TransferScheduler::Plan TransferScheduler::planDelete(const QStringList& sources)
+{
+    Plan plan;
+    for (const QString& s : sources) {
+        const QFileInfo sfi(s);
+        if (!sfi.exists() && !sfi.isSymLink()) continue;
+        if (!sfi.isDir() || sfi.isSymLink()) {
+            plan.files.append({ sfi.absoluteFilePath(), QString(), sfi.size(), 0, 0 });
+            plan.totalBytes += sfi.size();
+            continue;
+        }
+        QDirIterator it(sfi.absoluteFilePath(), QDir::AllEntries | QDir::NoDotAndDotDot | QDir::Hidden | QDir::System,
+                        QDirIterator::Subdirectories);
+        while (it.hasNext()) {
+            it.next();
+            const QFileInfo fi = it.fileInfo();
+            if (fi.isDir() && !fi.isSymLink()) {
+                plan.dirsToRemove << fi.absoluteFilePath();
+            } else {
+                plan.files.append({ fi.absoluteFilePath(), QString(), fi.size(), 0, 0 });
+                plan.totalBytes += fi.size();
+            }
+        }
+        plan.dirsToRemove << sfi.absoluteFilePath();
+    }
+    // Children before parents
+    std::stable_sort(plan.dirsToRemove.begin(), plan.dirsToRemove.end(), [](const QString& a, const QString& b) {
+        return a.count(QLatin1Char('/')) > b.count(QLatin1Char('/'));
+    });
+    return plan;
+}
+
+namespace {
+
+// At most perDevice copies touch any one storage device at a time. A copy holds a
+// slot on its source and on its destination device, taken in device order so two
+// copies never wait on each other.
+class DeviceSlots {
+public:
+    DeviceSlots(const QVector<TransferScheduler::FileTask>& files, int perDevice)
+    {
+        for (const TransferScheduler::FileTask& f : files) {
+            m_slots.try_emplace(f.srcDevice, perDevice);
+            m_slots.try_emplace(f.dstDevice, perDevice);
+        }
+    }
+
+    void acquire(quint64 a, quint64 b)
+    {
+        if (a > b) std::swap(a, b);
+        m_slots.at(a).acquire();
+        if (b != a) m_slots.at(b).acquire();
+    }
+    void release(quint64 a, quint64 b)
+    {
+        m_slots.at(a).release();
+        if (b != a) m_slots.at(b).release();
+    }
+
+private:
+    std::map<quint64, QSemaphore> m_slots; // filled up front, only looked up by workers
+};
+
+// Copies every file of the plan through perFile. Files are queued on one pool per
+// (source device, destination device) pair so a busy device only stalls the copies
+// that use it; DeviceSlots caps the copies per device across all pairs.
+using PerFileFn = std::function<bool(int index, const TransferScheduler::FileTask&, ProgressAggregator&, QString* err)>;
+
+bool runCopyPlan(const TransferScheduler::Plan& plan, std::atomic_bool& cancel, int perDeviceConcurrency,
+                 ProgressAggregator& progress, const PerFileFn& perFile, QString* errorOut)
+{
+    if (!plan.error.isEmpty()) { if (errorOut) *errorOut = plan.error; return false; }
+
+    for (const QString& d : plan.dirsToCreate) {
+        if (cancel.load()) return false;
+        if (!QDir().mkpath(d)) { if (errorOut) *errorOut = QObject::tr("Failed to create folder %1").arg(d); return false; }
+    }
+    for (const auto& [text, dst] : plan.symlinks) {
+        if (cancel.load()) return false;
+        if (!createLink(text, dst, errorOut)) return false;
+    }
+
+    ErrorSlot error;
+    const int limit = qMax(1, perDeviceConcurrency);
+    DeviceSlots deviceSlots(plan.files, limit);
+    QHash<QPair<quint64, quint64>, QVector<int>> groups;
+    for (int i = 0; i < plan.files.size(); ++i) {
+        groups[qMakePair(plan.files[i].srcDevice, plan.files[i].dstDevice)].append(i);
+    }
+    std::vector<std::unique_ptr<QThreadPool>> pools;
+    for (auto it = groups.constBegin(); it != groups.constEnd(); ++it) {
+        auto pool = std::make_unique<QThreadPool>();
+        pool->setMaxThreadCount(limit);
+        for (int idx : it.value()) {
+            pool->start([&plan, &cancel, &progress, &error, &perFile, &deviceSlots, idx] {
+                if (cancel.load() || error.failed()) return;
+                const TransferScheduler::FileTask& task = plan.files[idx];
+                deviceSlots.acquire(task.srcDevice, task.dstDevice);
+                // Re-check: the wait for a slot can be long
+                if (cancel.load() || error.failed()) { deviceSlots.release(task.srcDevice, task.dstDevice); return; }
+                QString err;
+                const bool ok = perFile(idx, task, progress, &err);
+                deviceSlots.release(task.srcDevice, task.dstDevice);
+                if (!ok) {
+                    if (!cancel.load()) error.set(err);
+                    return;
+                }
+                progress.fileDone(task.src);
+            });
+        }
+        pools.push_back(std::move(pool));
+    }
+    for (auto& pool : pools) pool->waitForDone();
+
+    progress.report(QString(), true);
+    if (error.failed()) { if (errorOut) *errorOut = error.message(); return false; }
+    return !cancel.load();
+}
+
+// Adapts a per-file (copied, total) callback into aggregated byte progress
+CopyEngine::ProgressFn byteReporter(ProgressAggregator& progress, const QString& file, qint64& reported)
+{
+    return [&progress, file, &reported](qint64 copied, qint64) {
+        progress.addBytes(copied - reported);
+        reported = copied;
+        progress.report(file, false);
+    };
+}
+
+} // namespace
+
+bool TransferScheduler::executeCopy(const Plan& plan, std::atomic_bool& cancel, int perDeviceConcurrency,
+                                    const ProgressFn& onProgress, QString* errorOut)
+{
+    ProgressAggregator progress(onProgress, plan.totalBytes, int(plan.files.size()));
+    return runCopyPlan(plan, cancel, perDeviceConcurrency, progress,
+                       [&cancel](int, const FileTask& task, ProgressAggregator& progress, QString* err) {
+        qint64 reported = 0;
+        return CopyEngine::copyFile(task.src, task.dst, cancel, byteReporter(progress, task.src, reported), err);
+    }, errorOut);
+}
+
+bool TransferScheduler::executeVerifiedCopy(const Plan& plan, std::atomic_bool& cancel, int perDeviceConcurrency,
+                                            const ProgressFn& onProgress, QVector<VerifiedFile>* verifiedOut,
+                                            QString* errorOut)
+{
+    // Every byte is moved once by the copy and read once more by the verification pass
+    ProgressAggregator progress(onProgress, plan.totalBytes * 2, int(plan.files.size()));
+    QVector<VerifiedFile> results(plan.files.size());
+    const bool ok = runCopyPlan(plan, cancel, perDeviceConcurrency, progress,
+                                [&cancel, &results](int idx, const FileTask& task, ProgressAggregator& progress, QString* err) {
+        qint64 reported = 0;
+        QString sourceHash;
+        if (!CopyEngine::copyFileHashed(task.src, task.dst, cancel, byteReporter(progress, task.src, reported), &sourceHash, err)) return false;
+        qint64 verified = 0;
+        QString destHash;
+        if (!CopyEngine::hashFile(task.dst, cancel, true, byteReporter(progress, task.dst, verified), &destHash, err)) return false;
+        if (destHash != sourceHash) {
+            qWarning() << "[TransferScheduler] Verification mismatch" << task.src << sourceHash << task.dst << destHash;
+            if (err) *err = QObject::tr("Verification failed: %1 does not match its source").arg(task.dst);
+            return false;
+        }
+        VerifiedFile& r = results[idx];
+        r.src = task.src;
+        r.dst = task.dst;
+        r.size = reported;
+        r.sha256 = sourceHash;
+        r.modified = QFileInfo(task.dst).lastModified();
+        r.verifiedAt = QDateTime::currentDateTime();
+        return true;
+    }, errorOut);
+    if (ok && verifiedOut) *verifiedOut = results;
+    return ok;
+}
+
+QString TransferScheduler::writeManifest(const QString& rootDir, const QVector<VerifiedFile>& files,
+                                         const QDateTime& startedAt, QString* errorOut)
+{
+    const QDir root(rootDir);
+    const QString folderName = root.dirName().isEmpty() ? QStringLiteral("delivery") : root.dirName();
+    QString path = root.filePath(QString("%1_%2.mhl").arg(folderName, startedAt.toString("yyyy-MM-dd_HHmmss")));
+    for (int i = 2; FileUtils::pathExists(path); ++i) {
+        path = root.filePath(QString("%1_%2_%3.mhl").arg(folderName, startedAt.toString("yyyy-MM-dd_HHmmss")).arg(i));
+    }
+
+    QSaveFile f(path);
+    if (!f.open(QIODevice::WriteOnly)) {
+        if (errorOut) *errorOut = QObject::tr("Failed to write manifest %1").arg(path);
+        return QString();
+    }
+    // MHL 1.1 layout (hashlist / creatorinfo / hash); digests are SHA-256 to match the catalog
+    QXmlStreamWriter xml(&f);
+    xml.setAutoFormatting(true);
+    xml.writeStartDocument();
+    xml.writeStartElement("hashlist");
+    xml.writeAttribute("version", "1.1");
+    xml.writeStartElement("creatorinfo");
+    xml.writeTextElement("name", qEnvironmentVariable("USER", qEnvironmentVariable("USERNAME")));
+    xml.writeTextElement("username", qEnvironmentVariable("USER", qEnvironmentVariable("USERNAME")));
+    xml.writeTextElement("hostname", QSysInfo::machineHostName());
+    xml.writeTextElement("tool", QCoreApplication::applicationName().isEmpty() ? QStringLiteral("KAssetManager")
+                                                                              : QCoreApplication::applicationName());
+    xml.writeTextElement("startdate", startedAt.toUTC().toString(Qt::ISODate));
+    xml.writeTextElement("finishdate", QDateTime::currentDateTimeUtc().toString(Qt::ISODate));
+    xml.writeEndElement(); // creatorinfo
+    for (const VerifiedFile& v : files) {
+        xml.writeStartElement("hash");
+        xml.writeTextElement("file", root.relativeFilePath(v.dst));
+        xml.writeTextElement("size", QString::number(v.size));
+        xml.writeTextElement("lastmodificationdate", v.modified.toUTC().toString(Qt::ISODate));
+        xml.writeTextElement("sha256", v.sha256);
+        xml.writeTextElement("hashdate", v.verifiedAt.toUTC().toString(Qt::ISODate));
+        xml.writeEndElement(); // hash
+    }
+    xml.writeEndElement(); // hashlist
+    xml.writeEndDocument();
+    if (xml.hasError() || !f.commit()) {
+        if (errorOut) *errorOut = QObject::tr("Failed to write manifest %1").arg(path);
+        return QString();
+    }
+    return path;
+}
+
+bool TransferScheduler::executeDelete(const Plan& plan, std::atomic_bool& cancel, int concurrency,
+                                      const ProgressFn& onProgress, QString* errorOut)
+{
+    ProgressAggregator progress(onProgress, plan.totalBytes, int(plan.files.size()));
+    ErrorSlot error;
+
+    // Batch file names per parent directory so each batch resolves the directory once
+    struct Batch { QString dir; QVector<int> files; };
+    QVector<Batch> batches;
+    {
+        QHash<QString, int> openBatch;
+        for (int i = 0; i < plan.files.size(); ++i) {
+            const QString dir = QFileInfo(plan.files[i].src).absolutePath();
+            auto it = openBatch.find(dir);
+            if (it == openBatch.end() || batches[it.value()].files.size() >= kDeleteBatchSize) {
+                batches.append({ dir, {} });
+                it = openBatch.insert(dir, int(batches.size()) - 1);
+            }
+            batches[it.value()].files.append(i);
+        }
+    }
+
+    QThreadPool pool;
+    pool.setMaxThreadCount(qMax(1, concurrency));
+    for (const Batch& batch : std::as_const(batches)) {
+        pool.start([&plan, &cancel, &progress, &error, batch] {
+            if (cancel.load() || error.failed()) return;
+            int dirFd = -1;
+#ifndef _WIN32
+            dirFd = ::open(QFile::encodeName(batch.dir).constData(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+            if (dirFd < 0) { error.set(QObject::tr("Failed to open folder %1").arg(batch.dir)); return; }
+#endif
+            for (int idx : batch.files) {
+                if (cancel.load()) break;
+                const FileTask& task = plan.files[idx];
+                QString err;
+                if (!removeFileAt(dirFd, batch.dir, QFileInfo(task.src).fileName(), &err)) { error.set(err); break; }
+                progress.addBytes(task.size);
+                progress.fileDone(task.src);
+            }
+#ifndef _WIN32
+            ::close(dirFd);
+#endif
+        });
+    }
+    pool.waitForDone();
+    progress.report(QString(), true);
+    if (error.failed()) { if (errorOut) *errorOut = error.message(); return false; }
+    if (cancel.load()) return false;
+
+    for (const QString& d : plan.dirsToRemove) {
+        if (cancel.load()) return false;
+        if (!QDir().rmdir(d) && FileUtils::pathExists(d)) {
+            if (errorOut) *errorOut = QObject::tr("Failed to delete folder %1").arg(d);
+            return false;
+        }
+    }
+    return true;
+}
+
+bool TransferScheduler::move(const QStringList& sources, const QString& destDir, std::atomic_bool& cancel,
+                             int perDeviceConcurrency, const ProgressFn& onProgress, QString* errorOut)
+{
+    const quint64 dstDev = deviceOf(destDir);
+    const QString destAbs = QDir::cleanPath(QFileInfo(destDir).absoluteFilePath());
+    QDir().mkpath(destAbs);
+
+    QStringList crossDevice;
+    QSet<QString> reserved;
+    int renamed = 0;
+    for (const QString& s : sources) {
+        if (cancel.load()) return false;
+        const QFileInfo sfi(s);
+        if (!sfi.exists() && !sfi.isSymLink()) continue;
+        if (sfi.absolutePath() == destAbs) { ++renamed; continue; } // already there
+        if (sfi.isDir() && !sfi.isSymLink() && isInside(destAbs, s)) {
+            if (errorOut) *errorOut = QObject::tr("Cannot move folder %1 into itself").arg(s);
+            return false;
+        }
+        if (deviceOf(s) == dstDev) {
+            // Same filesystem: a rename moves the whole tree without touching data
+            const QString target = uniqueTarget(destAbs, sfi.fileName(), reserved);
+            if (QDir().rename(sfi.absoluteFilePath(), target)) {
+                ++renamed;
+                if (onProgress) {
+                    Progress p;
+                    p.filesDone = renamed;
+                    p.filesTotal = int(sources.size());
+                    p.currentFile = s;
+                    onProgress(p);
+                }
+                continue;
+            }
+            reserved.remove(target);
+        }
+        crossDevice << s;
+    }
+    if (crossDevice.isEmpty()) return true;
+
+    // Cross-device: copy everything first, delete sources only once all data is safely written
+    const Plan copyPlan = planCopy(crossDevice, destAbs);
+    if (!executeCopy(copyPlan, cancel, perDeviceConcurrency, onProgress, errorOut)) return false;
+    const Plan deletePlan = planDelete(crossDevice);
+    return executeDelete(deletePlan, cancel, perDeviceConcurrency, ProgressFn(), errorOut);
+}
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <QDateTime>
+#include <QPair>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <atomic>
+#include <functional>
+
+/**
+ * TransferScheduler - planned, parallel copy/move/delete for FileOpsQueue
+ *
+ * A job is planned once up front (single directory walk) into a manifest of
+ * directories and files with byte totals, then executed:
+ *   - copy:   at most perDeviceConcurrency copies read or write any one storage
+ *             device at once, each holding a slot on its source and destination
+ *             device; files queue per (source, destination) pair so one slow disk
+ *             can't starve another, while thousands of sequence frames on
+ *             NVMe/10GbE overlap their latency
+ *   - move:   same-device sources are rename()d (instant); the rest are copied
+ *             through the copy plan and then deleted
+ *   - delete: files are unlinked in parallel, batched per parent directory
+ *             (unlinkat on an open dirfd), then directories are removed deepest first
+ * Progress is aggregated in bytes across all workers.
+ *
+ * Verified copies hash the source while copying (CopyEngine::copyFileHashed),
+ * re-read each destination with its cached pages dropped, and compare digests;
+ * the results can be written out as an MHL-style manifest.
+ */
+namespace TransferScheduler {
+
+struct FileTask {
+    QString src;
+    QString dst;          // empty for delete plans
+    qint64 size = 0;
+    quint64 srcDevice = 0;
+    quint64 dstDevice = 0;
+};
+
+struct Plan {
+    QStringList dirsToCreate;   // parents before children
+    QVector<FileTask> files;    // in walk order (keeps sequence frames sequential per worker)
+    QVector<QPair<QString, QString>> symlinks; // (link text, destination): links to folders and dangling links
+    QStringList dirsToRemove;   // children before parents (delete plans)
+    QStringList topLevelTargets; // resolved destination of each source (copy/move)
+    qint64 totalBytes = 0;
+    QString error;
+};
+
+struct Progress {
+    qint64 bytesDone = 0;
+    qint64 bytesTotal = 0;
+    int filesDone = 0;
+    int filesTotal = 0;
+    QString currentFile;
+};
+using ProgressFn = std::function<void(const Progress&)>;
+
+struct VerifiedFile {
+    QString src;
+    QString dst;
+    qint64 size = 0;
+    QString sha256;       // lowercase hex, same form as assets.checksum
+    QDateTime modified;
+    QDateTime verifiedAt;
+};
+
+// Destination names that already exist get a " (n)" suffix. Symlinks to files are
+// copied as files; links to folders and dangling links are recreated as links.
+Plan planCopy(const QStringList& sources, const QString& destDir);
+Plan planDelete(const QStringList& sources);
+
+bool executeCopy(const Plan& plan, std::atomic_bool& cancel, int perDeviceConcurrency,
+                 const ProgressFn& onProgress, QString* errorOut);
+// Like executeCopy, but every file is hashed in flight and read back from the
+// destination; any mismatch fails the job. verifiedOut follows plan.files order.
+bool executeVerifiedCopy(const Plan& plan, std::atomic_bool& cancel, int perDeviceConcurrency,
+                         const ProgressFn& onProgress, QVector<VerifiedFile>* verifiedOut, QString* errorOut);
+bool executeDelete(const Plan& plan, std::atomic_bool& cancel, int concurrency,
+                   const ProgressFn& onProgress, QString* errorOut);
+bool move(const QStringList& sources, const QString& destDir, std::atomic_bool& cancel, int perDeviceConcurrency,
+          const ProgressFn& onProgress, QString* errorOut);
+
+// Writes <folder>_<yyyy-MM-dd_HHmmss>.mhl into rootDir (paths relative to it).
+// Returns the manifest path, or an empty string on failure.
+QString writeManifest(const QString& rootDir, const QVector<VerifiedFile>& files, const QDateTime& startedAt,
+                      QString* errorOut);
+
+quint64 deviceOf(const QString& path);
+int defaultConcurrency(); // QSettings FileOps/ParallelTransfersPerDevice, default 4
+
+} // namespace TransferScheduler
@@ -1,7 +1,34 @@
 #include "utils.h"
 
+#include <QCoreApplication>
+#include <QDir>
+#include <QFileInfo>
+
 namespace Utils {
-// Definitions kept inline in header for performance and simplicity.
-// This TU exists to allow future non-inline utilities without changing build files.
+// Most definitions are kept inline in the header for performance and simplicity.
+
+QString locateFfmpeg()
+{
+#ifdef Q_OS_WIN
+    const QString exe = QStringLiteral("ffmpeg.exe");
+#else
+    const QString exe = QStringLiteral("ffmpeg");
+#endif
+    const QString appDir = QCoreApplication::applicationDirPath();
+    // 1) Next to app
+    QString cand = QDir(appDir).filePath(exe);
+    if (QFileInfo::exists(cand)) return cand;
+    // 2) third_party
+    cand = QDir(appDir).filePath("../../third_party/ffmpeg/bin/" + exe);
+    if (QFileInfo::exists(cand)) return QFileInfo(cand).absoluteFilePath();
+    // 3) FFMPEG_ROOT
+    const QString env = qEnvironmentVariable("FFMPEG_ROOT");
+    if (!env.isEmpty()) {
+        cand = QDir(env).filePath("bin/" + exe);
+        if (QFileInfo::exists(cand)) return QFileInfo(cand).absoluteFilePath();
+    }
+    // 4) PATH
+    return QStringLiteral("ffmpeg");
 }
 
+} // namespace Utils
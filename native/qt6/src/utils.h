@@ -1,5 +1,6 @@
 #pragma once
 #include <QtGlobal>
+#include <QString>
 #include <functional>
 
 namespace Utils {
@@ -24,5 +25,9 @@ inline qint64 binarySearchLastTrue(qint64 lowTrue, qint64 highFalse, const std::
     return lowTrue;
 }
 
+// Path of the ffmpeg executable: next to the app, the dev checkout's third_party,
+// $FFMPEG_ROOT/bin, else plain "ffmpeg" resolved through PATH.
+QString locateFfmpeg();
+
 } // namespace Utils
 
@@ -0,0 +1,157 @@
+#include "waveform_widget.h"
+#include <QPainter>
+#include <QMouseEvent>
+#include <QWheelEvent>
+#include <QResizeEvent>
+#include <cmath>
+
+WaveformWidget::WaveformWidget(QWidget *parent)
+    : QWidget(parent)
+{
+    setMinimumHeight(40);
+    setMaximumHeight(64);
+    setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Fixed);
+    setCursor(Qt::PointingHandCursor);
+    setToolTip(tr("Click to seek, scroll to zoom, double-click to show the whole clip"));
+}
+
+void WaveformWidget::setPeaks(std::shared_ptr<const WaveformPeaks> peaks)
+{
+    m_peaks = std::move(peaks);
+    m_durationMs = m_peaks ? m_peaks->durationMs() : 0;
+    resetZoom();
+}
+
+void WaveformWidget::clear()
+{
+    setPeaks(nullptr);
+    m_positionMs = 0;
+}
+
+void WaveformWidget::setPosition(qint64 ms)
+{
+    if (ms == m_positionMs) return;
+    m_positionMs = ms;
+    // When zoomed in, page the window along with playback
+    const qint64 span = m_endMs - m_startMs;
+    if (m_peaks && span > 0 && span < m_durationMs && (ms < m_startMs || ms >= m_endMs)) {
+        setVisibleRange(ms - span / 10, ms - span / 10 + span);
+        return;
+    }
+    update();
+}
+
+void WaveformWidget::setVisibleRange(qint64 startMs, qint64 endMs)
+{
+    const qint64 span = qMax<qint64>(1, qMin(endMs - startMs, m_durationMs));
+    m_startMs = qBound<qint64>(0, startMs, qMax<qint64>(0, m_durationMs - span));
+    m_endMs = m_startMs + span;
+    invalidateColumns();
+}
+
+void WaveformWidget::resetZoom()
+{
+    m_startMs = 0;
+    m_endMs = m_durationMs;
+    invalidateColumns();
+}
+
+void WaveformWidget::invalidateColumns()
+{
+    m_columnsValid = false;
+    update();
+}
+
+qint64 WaveformWidget::timeAt(double x) const
+{
+    if (width() <= 0) return m_startMs;
+    return m_startMs + qint64(std::llround(qBound(0.0, x / width(), 1.0) * double(m_endMs - m_startMs)));
+}
+
+double WaveformWidget::xAt(qint64 ms) const
+{
+    const qint64 span = m_endMs - m_startMs;
+    return span > 0 ? double(ms - m_startMs) * width() / double(span) : 0.0;
+}
+
+void WaveformWidget::paintEvent(QPaintEvent *)
+{
+    QPainter painter(this);
+    painter.fillRect(rect(), QColor(24, 24, 24));
+    if (!m_peaks || m_endMs <= m_startMs) return;
+
+    const qreal dpr = devicePixelRatioF();
+    const int columns = qMax(1, int(std::ceil(width() * dpr)));
+    if (!m_columnsValid || m_columns.size() != columns * 2) {
+        m_columns = m_peaks->range(m_startMs, m_endMs, columns);
+        m_columnsValid = true;
+    }
+
+    // Draw in device pixels so every column is exactly one line
+    painter.save();
+    painter.scale(1.0 / dpr, 1.0 / dpr);
+    const double mid = height() * dpr / 2.0;
+    const double scale = (height() * dpr / 2.0 - 1.0) / 32768.0;
+    painter.setPen(QColor(88, 166, 255));
+    for (int c = 0; c < columns; ++c) {
+        const int top = int(std::floor(mid - m_columns[c * 2 + 1] * scale));
+        const int bottom = int(std::ceil(mid - m_columns[c * 2] * scale));
+        painter.drawLine(c, top, c, qMax(top, bottom));
+    }
+    painter.restore();
+
+    painter.setPen(QColor(255, 255, 255, 40));
+    painter.drawLine(0, height() / 2, width(), height() / 2);
+
+    if (m_positionMs >= m_startMs && m_positionMs <= m_endMs) {
+        const int x = int(xAt(m_positionMs));
+        painter.setPen(QColor(255, 80, 80));
+        painter.drawLine(x, 0, x, height());
+    }
+}
+
+void WaveformWidget::resizeEvent(QResizeEvent *event)
+{
+    QWidget::resizeEvent(event);
+    m_columnsValid = false;
+}
+
+void WaveformWidget::wheelEvent(QWheelEvent *event)
+{
+    if (!m_peaks || m_durationMs <= 0) return;
+    const double steps = event->angleDelta().y() / 120.0;
+    if (steps == 0.0) return;
+    const double x = event->position().x();
+    const qint64 anchor = timeAt(x);
+    const qint64 span = m_endMs - m_startMs;
+    // Zooming stops at roughly one audio sample per pixel
+    const qint64 minSpan = qMax<qint64>(10, qint64(width()) * 1000 / qMax(1, m_peaks->sampleRate));
+    const qint64 newSpan = qBound<qint64>(minSpan, qint64(span * std::pow(0.8, steps)), m_durationMs);
+    const qint64 newStart = anchor - qint64(x / qMax(1, width()) * newSpan);
+    setVisibleRange(newStart, newStart + newSpan);
+    event->accept();
+}
+
+void WaveformWidget::mousePressEvent(QMouseEvent *event)
+{
+    if (event->button() == Qt::LeftButton && m_peaks) emit seekRequested(timeAt(event->position().x()), false);
+}
+
+void WaveformWidget::mouseMoveEvent(QMouseEvent *event)
+{
+    if (!(event->buttons() & Qt::LeftButton) || !m_peaks) return;
+    m_dragging = true;
+    emit seekRequested(timeAt(event->position().x()), true);
+}
+
+void WaveformWidget::mouseReleaseEvent(QMouseEvent *event)
+{
+    if (event->button() != Qt::LeftButton || !m_dragging) return;
+    m_dragging = false;
+    if (m_peaks) emit seekRequested(timeAt(event->position().x()), false);
+}
+
+void WaveformWidget::mouseDoubleClickEvent(QMouseEvent *event)
+{
+    if (event->button() == Qt::LeftButton) resetZoom();
+}
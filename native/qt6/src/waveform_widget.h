@@ -0,0 +1,57 @@
+#pragma once
+#include <QWidget>
+#include <QVector>
+#include <memory>
+
+#include "media/waveform_peaks.h"
+
+/**
+ * WaveformWidget - audio waveform strip for the video controls
+ *
+ * Draws min/max peaks for the visible time range with the playhead on top.
+ * Column data is only recomputed when the peaks, range or width change, so
+ * playhead updates cost a repaint and nothing else. The mouse wheel zooms
+ * around the cursor, double-click shows the whole clip, click/drag seeks.
+ * Drags report `scrubbing` so the player can snap to keyframes until release.
+ */
+class WaveformWidget : public QWidget
+{
+    Q_OBJECT
+public:
+    explicit WaveformWidget(QWidget *parent = nullptr);
+
+    void setPeaks(std::shared_ptr<const WaveformPeaks> peaks);
+    void clear();
+    bool hasPeaks() const { return m_peaks != nullptr; }
+
+    void setPosition(qint64 ms);
+    // Visible window; the whole clip after setPeaks()
+    void setVisibleRange(qint64 startMs, qint64 endMs);
+    void resetZoom();
+
+signals:
+    void seekRequested(qint64 ms, bool scrubbing);
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+    void resizeEvent(QResizeEvent *event) override;
+    void wheelEvent(QWheelEvent *event) override;
+    void mousePressEvent(QMouseEvent *event) override;
+    void mouseMoveEvent(QMouseEvent *event) override;
+    void mouseReleaseEvent(QMouseEvent *event) override;
+    void mouseDoubleClickEvent(QMouseEvent *event) override;
+
+private:
+    qint64 timeAt(double x) const;
+    double xAt(qint64 ms) const;
+    void invalidateColumns();
+
+    std::shared_ptr<const WaveformPeaks> m_peaks;
+    qint64 m_durationMs = 0;
+    qint64 m_startMs = 0;
+    qint64 m_endMs = 0;
+    qint64 m_positionMs = 0;
+    QVector<qint16> m_columns; // interleaved min,max per device pixel
+    bool m_columnsValid = false;
+    bool m_dragging = false;
+};
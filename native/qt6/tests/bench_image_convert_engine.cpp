@@ -0,0 +1,62 @@
+#include <QtTest>
+#include <QTemporaryDir>
+#include <QImage>
+#include <QElapsedTimer>
+#include <QThread>
+#include "../src/image_convert_engine.h"
+
+// Throughput of the in-process converter on a synthetic 2K plate sequence.
+// Reports frames/second per thread count; QBENCHMARK gives the per-batch time.
+class BenchImageConvertEngine : public QObject {
+    Q_OBJECT
+
+private:
+    QTemporaryDir tempDir;
+    QVector<ImageConvertEngine::Item> items;
+
+private slots:
+    void initTestCase() {
+        const int frames = qEnvironmentVariableIntValue("KAM_BENCH_FRAMES") > 0 ? qEnvironmentVariableIntValue("KAM_BENCH_FRAMES") : 200;
+        QImage plate(2048, 1080, QImage::Format_ARGB32);
+        for (int y = 0; y < plate.height(); ++y) {
+            QRgb* line = reinterpret_cast<QRgb*>(plate.scanLine(y));
+            for (int x = 0; x < plate.width(); ++x) line[x] = qRgba(x & 0xff, y & 0xff, (x ^ y) & 0xff, 255);
+        }
+        const QString src = tempDir.path() + "/plate.0001.png";
+        QVERIFY(plate.save(src));
+        for (int i = 0; i < frames; ++i) {
+            const QString frame = tempDir.path() + QString("/plate.%1.png").arg(i + 1, 4, 10, QChar('0'));
+            if (i > 0) QVERIFY(QFile::copy(src, frame));
+            items.push_back({frame, tempDir.path() + QString("/out.%1.jpg").arg(i + 1, 4, 10, QChar('0')), i});
+        }
+    }
+
+    void benchmarkBatch_data() {
+        QTest::addColumn<int>("threads");
+        for (int t = 1; t <= qMax(1, QThread::idealThreadCount()); t *= 2) QTest::newRow(qPrintable(QString("threads=%1").arg(t))) << t;
+    }
+
+    void benchmarkBatch() {
+        QFETCH(int, threads);
+        ImageConvertEngine::Options opts;
+        opts.format = ImageConvertEngine::Format::Jpg;
+        opts.scaleWidth = 1920;
+        std::atomic_bool cancel{false};
+        QElapsedTimer timer;
+        qint64 elapsed = 0;
+        int runs = 0;
+        QBENCHMARK {
+            timer.start();
+            QVERIFY(ImageConvertEngine::run(items, opts, threads, cancel, nullptr));
+            elapsed += timer.elapsed();
+            ++runs;
+        }
+        if (elapsed > 0) {
+            qInfo().noquote() << QString("[Bench] threads=%1: %2 frames/s").arg(threads)
+                                     .arg(double(items.size()) * runs * 1000.0 / elapsed, 0, 'f', 1);
+        }
+    }
+};
+
+QTEST_GUILESS_MAIN(BenchImageConvertEngine)
+#include "bench_image_convert_engine.moc"
@@ -0,0 +1,16 @@
+#pragma once
+#include <QByteArray>
+#include <QFile>
+#include <QString>
+
+// Shared by the copy engine and transfer scheduler tests
+namespace FileTestHelpers {
+
+// Whole file contents, empty if it cannot be opened
+inline QByteArray readAll(const QString& path)
+{
+    QFile f(path);
+    return f.open(QIODevice::ReadOnly) ? f.readAll() : QByteArray();
+}
+
+} // namespace FileTestHelpers
@@ -0,0 +1,130 @@
+#include <QtTest>
+#include <QTemporaryDir>
+#include <QFile>
+#include <QRandomGenerator>
+#include <QCryptographicHash>
+#include "../src/copy_engine.h"
+#include "file_test_helpers.h"
+
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+using FileTestHelpers::readAll;
+
+class TestCopyEngine : public QObject {
+    Q_OBJECT
+
+private:
+    QTemporaryDir tempDir;
+
+    QString writeRandom(const QString& name, qint64 size) {
+        const QString path = tempDir.path() + "/" + name;
+        QFile f(path);
+        if (!f.open(QIODevice::WriteOnly)) return QString();
+        QByteArray chunk(1024 * 1024, Qt::Uninitialized);
+        qint64 left = size;
+        while (left > 0) {
+            const qint64 n = qMin<qint64>(left, chunk.size());
+            for (qint64 i = 0; i < n; i += 4) {
+                const quint32 v = QRandomGenerator::global()->generate();
+                memcpy(chunk.data() + i, &v, size_t(qMin<qint64>(4, n - i)));
+            }
+            f.write(chunk.constData(), n);
+            left -= n;
+        }
+        return path;
+    }
+
+private slots:
+    void testCopyMatchesSource() {
+        const QString src = writeRandom("src.bin", 20 * 1024 * 1024 + 123);
+        const QString dst = tempDir.path() + "/nested/dir/dst.bin";
+        std::atomic_bool cancel{false};
+        qint64 last = -1, total = -1;
+        bool monotonic = true;
+        CopyEngine::Method method = CopyEngine::Method::None;
+        QString err;
+        QVERIFY2(CopyEngine::copyFile(src, dst, cancel, [&](qint64 c, qint64 t) {
+            if (c < last) monotonic = false;
+            last = c; total = t;
+        }, &err, &method), qPrintable(err));
+        QVERIFY(method != CopyEngine::Method::None);
+        QVERIFY(monotonic);
+        QCOMPARE(last, total);
+        QCOMPARE(QFileInfo(dst).size(), QFileInfo(src).size());
+        QCOMPARE(readAll(dst), readAll(src));
+    }
+
+    void testEmptyFile() {
+        const QString src = writeRandom("empty.bin", 0);
+        const QString dst = tempDir.path() + "/empty_copy.bin";
+        std::atomic_bool cancel{false};
+        QVERIFY(CopyEngine::copyFile(src, dst, cancel, nullptr, nullptr));
+        QVERIFY(QFileInfo::exists(dst));
+        QCOMPARE(QFileInfo(dst).size(), qint64(0));
+    }
+
+    void testCancelRemovesDestination() {
+        const QString src = writeRandom("cancel.bin", 4 * 1024 * 1024);
+        const QString dst = tempDir.path() + "/cancel_copy.bin";
+        std::atomic_bool cancel{true};
+        QString err;
+        const bool ok = CopyEngine::copyFile(src, dst, cancel, nullptr, &err);
+        // A reflink completes before the first cancellation point; anything else must clean up
+        if (!ok) {
+            QVERIFY(!QFileInfo::exists(dst));
+            QVERIFY(!err.isEmpty());
+        }
+    }
+
+    void testMissingSource() {
+        std::atomic_bool cancel{false};
+        QString err;
+        QVERIFY(!CopyEngine::copyFile(tempDir.path() + "/nope.bin", tempDir.path() + "/nope_copy.bin", cancel, nullptr, &err));
+        QVERIFY(!err.isEmpty());
+    }
+
+    void testCopyOntoItselfFails() {
+        const QString src = writeRandom("self.bin", 64 * 1024);
+        const QByteArray before = readAll(src);
+        std::atomic_bool cancel{false};
+        QString err;
+        QVERIFY(!CopyEngine::copyFile(src, src, cancel, nullptr, &err));
+        QVERIFY(!err.isEmpty());
+        // Same file through another spelling of the path
+        const QString other = tempDir.path() + "/./self.bin";
+        QVERIFY(!CopyEngine::copyFileHashed(src, other, cancel, nullptr, nullptr, &err));
+        QCOMPARE(readAll(src), before);
+#ifndef _WIN32
+        const QString link = tempDir.path() + "/self_hardlink.bin";
+        QVERIFY(::link(QFile::encodeName(src).constData(), QFile::encodeName(link).constData()) == 0);
+        QVERIFY(!CopyEngine::copyFile(src, link, cancel, nullptr, &err));
+        QCOMPARE(readAll(src), before);
+#endif
+    }
+
+    void testHashedCopyMatchesDigest() {
+        const QString src = writeRandom("hashed.bin", 13 * 1024 * 1024 + 7);
+        const QString dst = tempDir.path() + "/hashed_copy.bin";
+        std::atomic_bool cancel{false};
+        QString srcHash, dstHash, err;
+        QVERIFY2(CopyEngine::copyFileHashed(src, dst, cancel, nullptr, &srcHash, &err), qPrintable(err));
+        const QString expected = QString::fromLatin1(QCryptographicHash::hash(readAll(src), QCryptographicHash::Sha256).toHex());
+        QCOMPARE(srcHash, expected);
+        QCOMPARE(readAll(dst), readAll(src));
+        QVERIFY2(CopyEngine::hashFile(dst, cancel, true, nullptr, &dstHash, &err), qPrintable(err));
+        QCOMPARE(dstHash, expected);
+    }
+
+    void testHashedCopyCancelRemovesDestination() {
+        const QString src = writeRandom("hashed_cancel.bin", 6 * 1024 * 1024);
+        const QString dst = tempDir.path() + "/hashed_cancel_copy.bin";
+        std::atomic_bool cancel{true};
+        QVERIFY(!CopyEngine::copyFileHashed(src, dst, cancel, nullptr, nullptr, nullptr));
+        QVERIFY(!QFileInfo::exists(dst));
+    }
+};
+
+QTEST_APPLESS_MAIN(TestCopyEngine)
+#include "test_copy_engine.moc"
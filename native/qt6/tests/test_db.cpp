@@ -136,6 +136,45 @@ private slots:
         QVERIFY(ok);
     }
 
+    void testAssetProxies() {
+        DB& db = DB::instance();
+
+        QString testFile = tempDir.path() + "/proxy_source.mov";
+        QFile f(testFile);
+        QVERIFY(f.open(QIODevice::WriteOnly));
+        f.write("proxy source");
+        f.close();
+
+        int assetId = db.upsertAsset(testFile);
+        QVERIFY(assetId > 0);
+
+        AssetProxyRow row;
+        row.assetId = assetId;
+        row.sourceKey = testFile;
+        row.proxyPath = tempDir.path() + "/proxies/proxy.mov";
+        row.kind = "mjpeg";
+        row.scale = 2;
+        row.byteSize = 1234;
+        QVERIFY(db.setAssetProxy(row));
+        // One proxy per asset: a regenerated proxy replaces the row
+        row.scale = 4;
+        QVERIFY(db.setAssetProxy(row));
+
+        QVector<AssetProxyRow> rows = db.listAssetProxies();
+        QCOMPARE(rows.size(), 1);
+        QCOMPARE(rows.first().assetId, assetId);
+        QCOMPARE(rows.first().scale, 4);
+        QCOMPARE(rows.first().byteSize, qint64(1234));
+
+        QVERIFY(db.removeAssetProxyBySourceKey(testFile));
+        QVERIFY(db.listAssetProxies().isEmpty());
+
+        // Removing the asset drops its proxy row
+        QVERIFY(db.setAssetProxy(row));
+        QVERIFY(db.removeAssets({assetId}));
+        QVERIFY(db.listAssetProxies().isEmpty());
+    }
+
     void cleanupTestCase() {
         // Cleanup is automatic with QTemporaryDir
     }
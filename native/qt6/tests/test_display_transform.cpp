@@ -0,0 +1,94 @@
+#include <QtTest>
+#include <QImage>
+#include <vector>
+#include "../src/display_transform.h"
+#include "../src/oiio_image_loader.h"
+
+class TestDisplayTransform : public QObject {
+    Q_OBJECT
+
+private:
+    static QImage linearImage(int width, int height, int channels, float r, float g, float b, float a = 1.0f) {
+        std::vector<float> pixels(size_t(width) * height * channels);
+        for (size_t i = 0; i < pixels.size(); i += channels) {
+            pixels[i] = r;
+            pixels[i + 1] = g;
+            pixels[i + 2] = b;
+            if (channels == 4) pixels[i + 3] = a;
+        }
+        return OIIOImageLoader::toLinearHalf(pixels.data(), width, height, channels);
+    }
+
+    static QRgb pixel(const QImage& image, int x = 0, int y = 0) {
+        return image.convertToFormat(QImage::Format_ARGB32).pixel(x, y);
+    }
+
+private slots:
+    void testLinearHalfStorage() {
+        const QImage rgb = linearImage(4, 2, 3, 0.5f, 2.0f, -1.0f);
+        QCOMPARE(rgb.format(), QImage::Format_RGBX16FPx4);
+        QVERIFY(DisplayTransform::isLinear(rgb));
+        const QImage rgba = linearImage(4, 2, 4, 0.5f, 0.5f, 0.5f, 0.25f);
+        QCOMPARE(rgba.format(), QImage::Format_RGBA16FPx4);
+
+        // Values above 1.0 and below 0.0 survive until display
+        const qfloat16* px = reinterpret_cast<const qfloat16*>(rgb.constScanLine(1));
+        QCOMPARE(float(px[1]), 2.0f);
+        QCOMPARE(float(px[2]), -1.0f);
+        QCOMPARE(float(px[3]), 1.0f);
+    }
+
+    void testColorSpaceAndExposure() {
+        const QImage image = linearImage(2, 2, 3, 1.0f, 0.0f, -1.0f);
+        DisplayTransform transform;
+
+        // Reinhard maps 1.0 to 0.5, then the transfer curve applies
+        transform.setColorSpace(OIIOImageLoader::ColorSpace::Linear);
+        QCOMPARE(qRed(pixel(transform.apply(image))), 128);
+        transform.setColorSpace(OIIOImageLoader::ColorSpace::sRGB);
+        QCOMPARE(qRed(pixel(transform.apply(image))), 188);
+        transform.setColorSpace(OIIOImageLoader::ColorSpace::Rec709);
+        QCOMPARE(qRed(pixel(transform.apply(image))), 180);
+        QCOMPARE(qGreen(pixel(transform.apply(image))), 0);
+        QCOMPARE(qBlue(pixel(transform.apply(image))), 0);
+        QCOMPARE(qAlpha(pixel(transform.apply(image))), 255);
+
+        // +1 stop doubles the linear value before tone mapping
+        transform.setColorSpace(OIIOImageLoader::ColorSpace::Linear);
+        transform.setExposure(1.0f);
+        QCOMPARE(qRed(pixel(transform.apply(image))), 170);
+
+        transform.setExposure(0.0f);
+        transform.setGamma(2.0f);
+        QCOMPARE(qRed(pixel(transform.apply(image))), 180);
+    }
+
+    void testAlphaAndPassThrough() {
+        DisplayTransform transform;
+        const QImage shown = transform.apply(linearImage(2, 2, 4, 0.0f, 0.0f, 0.0f, 0.5f));
+        QCOMPARE(shown.format(), QImage::Format_RGBA8888);
+        QCOMPARE(qAlpha(pixel(shown)), 128);
+
+        // Display-referred images are not touched
+        QImage ldr(3, 3, QImage::Format_RGB32);
+        ldr.fill(QColor(10, 20, 30));
+        const QImage same = transform.apply(ldr);
+        QCOMPARE(same.format(), QImage::Format_RGB32);
+        QCOMPARE(same.pixel(1, 1), ldr.pixel(1, 1));
+    }
+
+    void testLargeFramesMatchSmallOnes() {
+        // Large frames are mapped in parallel row bands
+        DisplayTransform transform;
+        transform.setExposure(-0.5f);
+        const QImage large = transform.apply(linearImage(1024, 300, 3, 0.18f, 1.0f, 4.0f));
+        const QImage small = transform.apply(linearImage(1, 1, 3, 0.18f, 1.0f, 4.0f));
+        QCOMPARE(large.size(), QSize(1024, 300));
+        QCOMPARE(pixel(large, 0, 0), pixel(small));
+        QCOMPARE(pixel(large, 1023, 299), pixel(small));
+        QCOMPARE(pixel(large, 511, 150), pixel(small));
+    }
+};
+
+QTEST_GUILESS_MAIN(TestDisplayTransform)
+#include "test_display_transform.moc"
@@ -0,0 +1,135 @@
+#include <QtTest>
+#include <QTemporaryDir>
+#include <QFile>
+#include <QSignalSpy>
+#include <QSqlQuery>
+#include "duplicate_finder.h"
+#include "db.h"
+
+class TestDuplicateFinder : public QObject {
+    Q_OBJECT
+
+private:
+    QTemporaryDir tempDir;
+
+    QString writeFile(const QString& name, const QByteArray& data) {
+        const QString path = tempDir.path() + "/" + name;
+        QFile f(path);
+        if (!f.open(QIODevice::WriteOnly)) return QString();
+        f.write(data);
+        f.close();
+        return path;
+    }
+
+    DuplicateFinder::Entry entryFor(const QString& path, int assetId = 0) {
+        DuplicateFinder::Entry e;
+        e.assetId = assetId;
+        e.filePath = path;
+        e.size = QFileInfo(path).size();
+        return e;
+    }
+
+    static QString storedChecksum(int assetId) {
+        QSqlQuery q(DB::instance().database());
+        q.prepare("SELECT COALESCE(checksum,'') FROM assets WHERE id=?");
+        q.addBindValue(assetId);
+        return q.exec() && q.next() ? q.value(0).toString() : QString();
+    }
+
+private slots:
+    void initTestCase() {
+        QVERIFY(tempDir.isValid());
+        QVERIFY(DB::instance().init(tempDir.path() + "/test.db"));
+    }
+
+    void testGroupsIdenticalFiles() {
+        const QByteArray payload(300 * 1024, 'a');
+        QVector<DuplicateFinder::Entry> entries;
+        entries << entryFor(writeFile("a1.bin", payload))
+                << entryFor(writeFile("a2.bin", payload))
+                << entryFor(writeFile("unique.bin", QByteArray(10, 'z')));
+
+        const auto groups = DuplicateFinder::findDuplicates(entries, DuplicateFinder::Options());
+        QCOMPARE(groups.size(), 1);
+        QCOMPARE(groups[0].filePaths.size(), 2);
+        QCOMPARE(groups[0].fileSize, qint64(payload.size()));
+        QVERIFY(entries[0].checksumComputed);
+        QVERIFY(!entries[2].checksumComputed); // unique size never hashed
+    }
+
+    void testSameSizeDifferentContent() {
+        // Large enough for the partial pass; differs only in the middle block
+        QByteArray a(1024 * 1024, 'x');
+        QByteArray b = a;
+        b[b.size() / 2] = 'y';
+        QVector<DuplicateFinder::Entry> entries;
+        entries << entryFor(writeFile("m1.bin", a)) << entryFor(writeFile("m2.bin", b));
+
+        const auto groups = DuplicateFinder::findDuplicates(entries, DuplicateFinder::Options());
+        QVERIFY(groups.isEmpty());
+        QVERIFY(!entries[0].checksumComputed); // rejected by partial hash
+    }
+
+    void testReusesKnownChecksum() {
+        const QByteArray payload(2 * 1024, 'k');
+        QVector<DuplicateFinder::Entry> entries;
+        entries << entryFor(writeFile("k1.bin", payload), 1) << entryFor(writeFile("k2.bin", payload), 2);
+        entries[0].checksum = entries[1].checksum = QStringLiteral("stored");
+
+        const auto groups = DuplicateFinder::findDuplicates(entries, DuplicateFinder::Options());
+        QCOMPARE(groups.size(), 1);
+        QCOMPARE(groups[0].checksum, QStringLiteral("stored"));
+        QVERIFY(!entries[0].checksumComputed);
+        QVERIFY(!entries[1].checksumComputed);
+    }
+
+    void testPersistGroups() {
+        DB& db = DB::instance();
+        const QString p1 = writeFile("db1.bin", "same");
+        const QString p2 = writeFile("db2.bin", "same");
+        const int id1 = db.upsertAsset(p1);
+        QVERIFY(id1 > 0);
+
+        DuplicateGroupRow row;
+        row.checksum = QStringLiteral("abc");
+        row.fileSize = 4;
+        row.assetIds = { id1, 0 };
+        row.filePaths = { p1, p2 };
+        QVERIFY(db.replaceDuplicateGroups({ row }));
+
+        const auto stored = db.listDuplicateGroups();
+        QCOMPARE(stored.size(), 1);
+        QCOMPARE(stored[0].filePaths.size(), 2);
+        QVERIFY(stored[0].assetIds.contains(id1));
+        QVERIFY(stored[0].assetIds.contains(0));
+
+        QVERIFY(db.replaceDuplicateGroups({}));
+        QVERIFY(db.listDuplicateGroups().isEmpty());
+    }
+
+    void testSameSizeRewriteIsNotTrusted() {
+        DB& db = DB::instance();
+        const QString pa = writeFile("rewrite_a.bin", "AAAA");
+        const QString pb = writeFile("rewrite_b.bin", "BBBB");
+        const int ida = db.upsertAsset(pa);
+        const int idb = db.upsertAsset(pb);
+        QVERIFY(ida > 0 && idb > 0);
+        QTRY_VERIFY(!storedChecksum(ida).isEmpty() && !storedChecksum(idb).isEmpty());
+
+        // Both rewritten in place to different content of the same size: the stored
+        // checksums say "equal" but were taken at another mtime
+        QSqlQuery q(db.database());
+        QVERIFY(q.exec(QString("UPDATE assets SET checksum='stale', checksum_mtime=1 WHERE id IN (%1,%2)").arg(ida).arg(idb)));
+
+        QSignalSpy finished(&DuplicateFinder::instance(), &DuplicateFinder::scanFinished);
+        QVERIFY(DuplicateFinder::instance().start(true));
+        QVERIFY(finished.wait(10000));
+        for (const DuplicateGroupRow& g : db.listDuplicateGroups()) {
+            QVERIFY(!g.filePaths.contains(pa));
+            QVERIFY(g.checksum != QStringLiteral("stale"));
+        }
+    }
+};
+
+QTEST_MAIN(TestDuplicateFinder)
+#include "test_duplicate_finder.moc"
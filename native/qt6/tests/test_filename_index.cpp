@@ -0,0 +1,166 @@
+#include <QtTest>
+#include <QTemporaryDir>
+#include <QDir>
+#include <QFile>
+#include <QSignalSpy>
+#include <QStandardPaths>
+#include "filename_index.h"
+
+class TestFilenameIndex : public QObject {
+    Q_OBJECT
+
+private:
+    QTemporaryDir tempDir;
+    QTemporaryDir dataDir;
+
+    QString root() const { return tempDir.path() + "/root"; }
+
+    bool makeFile(const QString& relativePath) {
+        const QString path = root() + "/" + relativePath;
+        if (!QDir().mkpath(QFileInfo(path).path())) return false;
+        QFile f(path);
+        if (!f.open(QIODevice::WriteOnly)) return false;
+        f.write(relativePath.toUtf8());
+        return true;
+    }
+
+    static QStringList names(const QVector<EverythingResult>& results) {
+        QStringList out;
+        for (const EverythingResult& r : results) out << r.fileName;
+        out.sort();
+        return out;
+    }
+
+private slots:
+    void initTestCase() {
+        // Keeps the user's own indexed folders (QSettings) out of the test
+        QStandardPaths::setTestMode(true);
+        QVERIFY(makeFile("shots/sh010/plate_v001.exr"));
+        QVERIFY(makeFile("shots/sh010/plate_v002.exr"));
+        QVERIFY(makeFile("shots/sh020/Comp_Final.dpx"));
+        QVERIFY(makeFile("shots/sh020/notes.txt"));
+        QVERIFY(makeFile("refs/plate_reference.jpg"));
+
+        FilenameIndex& index = FilenameIndex::instance();
+        index.setIndexPath(dataDir.path() + "/filename_index.dat");
+        index.setProjectRoots({root()});
+        index.start();
+        QVERIFY(index.waitForDone(10000));
+        // 5 files, 5 folders (shots, sh010, sh020, refs) plus the root itself
+        QCOMPARE(index.entryCount(), qint64(10));
+    }
+
+    void testSubstringIsCaseInsensitive() {
+        FilenameIndex& index = FilenameIndex::instance();
+        QCOMPARE(names(index.search("PLATE")),
+                 (QStringList{"plate_reference.jpg", "plate_v001.exr", "plate_v002.exr"}));
+        QCOMPARE(names(index.search("comp_final")), (QStringList{"Comp_Final.dpx"}));
+        QVERIFY(index.search("nothing_like_this").isEmpty());
+    }
+
+    void testAllTermsMustMatch() {
+        FilenameIndex& index = FilenameIndex::instance();
+        QCOMPARE(names(index.search("plate v002")), (QStringList{"plate_v002.exr"}));
+        QCOMPARE(names(index.search("plate *.exr")), (QStringList{"plate_v001.exr", "plate_v002.exr"}));
+    }
+
+    void testGlobAndExtension() {
+        FilenameIndex& index = FilenameIndex::instance();
+        QCOMPARE(names(index.search("*.exr")), (QStringList{"plate_v001.exr", "plate_v002.exr"}));
+        QCOMPARE(names(index.search("plate_v00?.exr")), (QStringList{"plate_v001.exr", "plate_v002.exr"}));
+        QCOMPARE(names(index.search("ext:exr;dpx")),
+                 (QStringList{"Comp_Final.dpx", "plate_v001.exr", "plate_v002.exr"}));
+        QCOMPARE(names(index.search("ext:.TXT")), (QStringList{"notes.txt"}));
+    }
+
+    void testPathTerm() {
+        FilenameIndex& index = FilenameIndex::instance();
+        // Crosses from the directory into the name
+        QCOMPARE(names(index.search("sh010/plate")), (QStringList{"plate_v001.exr", "plate_v002.exr"}));
+        QCOMPARE(names(index.search("shots/ ext:dpx")), (QStringList{"Comp_Final.dpx"}));
+
+        const QVector<EverythingResult> folders = index.search("sh020");
+        QCOMPARE(folders.size(), 1);
+        QVERIFY(folders.first().isFolder);
+        QCOMPARE(folders.first().fullPath, root() + "/shots/sh020");
+    }
+
+    void testMaxResults() {
+        QCOMPARE(FilenameIndex::instance().search("plate", 2).size(), 2);
+    }
+
+    void testRefreshPicksUpChanges() {
+        FilenameIndex& index = FilenameIndex::instance();
+        QVERIFY(makeFile("shots/sh030/layout_v001.abc"));
+        index.refreshDirectory(root() + "/shots");
+        QVERIFY(index.waitForDone(10000));
+        QCOMPARE(names(index.search("layout")), (QStringList{"layout_v001.abc"}));
+
+        QVERIFY(makeFile("shots/sh010/plate_v003.exr"));
+        QSignalSpy changed(&index, &FilenameIndex::indexChanged);
+        index.refreshDirectory(root() + "/shots/sh010");
+        QVERIFY(index.waitForDone(10000));
+        QTRY_VERIFY(changed.count() > 0);
+        QCOMPARE(index.search("*.exr").size(), 3);
+
+        // A removed folder takes its contents along
+        const qint64 before = index.entryCount();
+        QVERIFY(QDir(root() + "/shots/sh030").removeRecursively());
+        index.refreshDirectory(root() + "/shots");
+        QVERIFY(index.waitForDone(10000));
+        QCOMPARE(index.entryCount(), before - 2);
+        QVERIFY(index.search("layout").isEmpty());
+    }
+
+    void testSaveAndLoad() {
+        FilenameIndex& index = FilenameIndex::instance();
+        const qint64 count = index.entryCount();
+        QVERIFY(index.save());
+        QVERIFY(QFile::exists(index.indexPath()));
+        QVERIFY(index.load());
+        QCOMPARE(index.entryCount(), count);
+        QCOMPARE(names(index.search("ext:exr")), (QStringList{"plate_v001.exr", "plate_v002.exr", "plate_v003.exr"}));
+
+        // A damaged file is rejected and leaves the index as it was
+        QFile f(index.indexPath());
+        QVERIFY(f.open(QIODevice::WriteOnly | QIODevice::Truncate));
+        f.write("not an index");
+        f.close();
+        QVERIFY(!index.load());
+        QCOMPARE(index.entryCount(), count);
+    }
+
+    void testNestedChangesAfterCompaction() {
+        FilenameIndex& index = FilenameIndex::instance();
+        const qint64 before = index.entryCount();
+        QVERIFY(makeFile("deep/a/b/c/leaf_1.txt"));
+        index.refreshDirectory(root());
+        QVERIFY(index.waitForDone(10000));
+        QCOMPARE(index.entryCount(), before + 5);
+
+        // Saving compacts and renumbers; refreshes must still find each folder's children
+        QVERIFY(index.save());
+        QVERIFY(makeFile("deep/a/b/c/leaf_2.txt"));
+        index.refreshDirectory(root() + "/deep/a/b/c");
+        QVERIFY(index.waitForDone(10000));
+        QCOMPARE(names(index.search("leaf_")), (QStringList{"leaf_1.txt", "leaf_2.txt"}));
+
+        QVERIFY(QDir(root() + "/deep").removeRecursively());
+        index.refreshDirectory(root());
+        QVERIFY(index.waitForDone(10000));
+        QCOMPARE(index.entryCount(), before);
+        QVERIFY(index.search("leaf_").isEmpty());
+        QVERIFY(index.search("deep/a").isEmpty());
+    }
+
+    void testRemoveRoot() {
+        FilenameIndex& index = FilenameIndex::instance();
+        index.removeProjectRoot(root());
+        QVERIFY(index.waitForDone(10000));
+        QCOMPARE(index.entryCount(), qint64(0));
+        QVERIFY(index.search("plate").isEmpty());
+    }
+};
+
+#include "test_filename_index.moc"
+QTEST_MAIN(TestFilenameIndex)
@@ -0,0 +1,107 @@
+#include <QtTest>
+#include <QTemporaryDir>
+#include <QImage>
+#include <QImageReader>
+#include "../src/image_convert_engine.h"
+
+class TestImageConvertEngine : public QObject {
+    Q_OBJECT
+
+private:
+    QTemporaryDir tempDir;
+
+    QString makeImage(const QString& name, int w, int h, bool alpha) {
+        QImage img(w, h, alpha ? QImage::Format_ARGB32 : QImage::Format_RGB32);
+        img.fill(alpha ? QColor(200, 40, 40, 128) : QColor(40, 200, 40));
+        const QString path = tempDir.path() + "/" + name;
+        return img.save(path) ? path : QString();
+    }
+
+private slots:
+    void testBatchResizesAndDropsAlpha() {
+        QVector<ImageConvertEngine::Item> items;
+        for (int i = 0; i < 24; ++i) {
+            const QString src = makeImage(QString("src_%1.png").arg(i), 64, 32, true);
+            QVERIFY(!src.isEmpty());
+            items.push_back({src, tempDir.path() + QString("/out_%1.png").arg(i), i});
+        }
+        ImageConvertEngine::Options opts;
+        opts.format = ImageConvertEngine::Format::Png;
+        opts.includeAlpha = false;
+        opts.scaleWidth = 32;
+
+        std::atomic_bool cancel{false};
+        QMutex mutex;
+        QSet<int> tags;
+        const bool ok = ImageConvertEngine::run(items, opts, 4, cancel, [&](const ImageConvertEngine::Result& r) {
+            QMutexLocker lk(&mutex);
+            if (r.ok) tags.insert(r.tag);
+        });
+        QVERIFY(ok);
+        QCOMPARE(tags.size(), 24);
+        for (const auto& item : items) {
+            QImageReader reader(item.dst);
+            const QImage out = reader.read();
+            QCOMPARE(out.size(), QSize(32, 16));
+            QVERIFY(!out.hasAlphaChannel());
+        }
+    }
+
+    void testFailuresAreReportedPerItem() {
+        const QString good = makeImage("good.png", 16, 16, false);
+        QVector<ImageConvertEngine::Item> items = {
+            {good, tempDir.path() + "/good_out.png", 0},
+            {tempDir.path() + "/missing.png", tempDir.path() + "/missing_out.png", 1},
+        };
+        ImageConvertEngine::Options opts;
+        opts.format = ImageConvertEngine::Format::Png;
+        std::atomic_bool cancel{false};
+        QMutex mutex;
+        QHash<int, bool> results;
+        QVERIFY(!ImageConvertEngine::run(items, opts, 2, cancel, [&](const ImageConvertEngine::Result& r) {
+            QMutexLocker lk(&mutex);
+            results.insert(r.tag, r.ok);
+        }));
+        QCOMPARE(results.size(), 2);
+        QVERIFY(results.value(0));
+        QVERIFY(!results.value(1));
+        QVERIFY(QFileInfo::exists(tempDir.path() + "/good_out.png"));
+    }
+
+    void testJpegQuality() {
+        if (!ImageConvertEngine::canRead("probe.jpg")) QSKIP("No JPEG support in this build");
+        const QString src = makeImage("photo.png", 128, 128, true);
+        QString err;
+        ImageConvertEngine::Options opts;
+        opts.format = ImageConvertEngine::Format::Jpg;
+        opts.quality = 80;
+        QVERIFY2(ImageConvertEngine::convert(src, tempDir.path() + "/photo.jpg", opts, &err), qPrintable(err));
+        QCOMPARE(QImageReader(tempDir.path() + "/photo.jpg").size(), QSize(128, 128));
+    }
+
+    void testCancelledRunStops() {
+        const QString src = makeImage("cancel.png", 16, 16, false);
+        QVector<ImageConvertEngine::Item> items;
+        for (int i = 0; i < 10; ++i) items.push_back({src, tempDir.path() + QString("/cancel_%1.png").arg(i), i});
+        std::atomic_bool cancel{true};
+        QVERIFY(!ImageConvertEngine::run(items, ImageConvertEngine::Options(), 2, cancel, nullptr));
+        QVERIFY(!QFileInfo::exists(tempDir.path() + "/cancel_0.png"));
+    }
+
+    void testStagesStayWithinBudget() {
+        for (int threads = 1; threads <= 64; ++threads) {
+            const auto s = ImageConvertEngine::stageThreads(threads);
+            QCOMPARE(s.readers + s.transformers + s.writers + s.whole, threads);
+            if (s.whole == 0) {
+                QVERIFY(s.readers >= 1);
+                QVERIFY(s.transformers >= 1);
+                QVERIFY(s.writers >= 1);
+            }
+        }
+        QCOMPARE(ImageConvertEngine::stageThreads(2).whole, 2);
+        QCOMPARE(ImageConvertEngine::stageThreads(0).whole, 1);
+    }
+};
+
+QTEST_GUILESS_MAIN(TestImageConvertEngine)
+#include "test_image_convert_engine.moc"
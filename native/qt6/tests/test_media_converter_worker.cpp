@@ -12,6 +12,11 @@ class TestMediaConverterWorker : public QObject {
     Q_OBJECT
 private slots:
     void testEmptyQueueFinishesImmediately();
+    void testTaskCostRespectsBudget();
+    void testPlanSegments();
+    void testAutoRenameClaimsAcrossRunningTasks();
+    void testContiguousSequence();
+    void testSequenceFallbackReadsWholeSequence();
 };
 
 void TestMediaConverterWorker::testEmptyQueueFinishesImmediately()
@@ -30,6 +35,180 @@ void TestMediaConverterWorker::testEmptyQueueFinishesImmediately()
     QVERIFY(args.at(0).toBool());
 }
 
+void TestMediaConverterWorker::testTaskCostRespectsBudget()
+{
+    using W = MediaConverterWorker;
+    W::Task jpg; jpg.target = W::TargetKind::ImageJpg;
+    W::Task seq; seq.target = W::TargetKind::JpgSequence;
+    W::Task hevc; hevc.target = W::TargetKind::VideoMP4; hevc.mp4.codec = "hevc";
+    W::Task prores; prores.target = W::TargetKind::VideoMOV; prores.mov.codec = "prores_ks"; prores.mov.proresProfile = 3;
+
+    // Cheap exports are charged less than encodes, so more of them run at once
+    QCOMPARE(W::taskCost(jpg, 16), 1);
+    QVERIFY(W::taskCost(seq, 16) < W::taskCost(prores, 16));
+    QVERIFY(W::taskCost(prores, 16) < W::taskCost(hevc, 16));
+
+    // Never more than the budget, never less than one core
+    QCOMPARE(W::taskCost(hevc, 2), 2);
+    QCOMPARE(W::taskCost(hevc, 0), 1);
+    QVERIFY(W::defaultCpuBudget() >= 1);
+}
+
+void TestMediaConverterWorker::testPlanSegments()
+{
+    using W = MediaConverterWorker;
+    // 20k frames, GOP 48, 8 parallel jobs
+    const auto segs = W::planSegments(1001, 20000, 48, 8);
+    QVERIFY(segs.size() >= 8);
+    qint64 next = 1001, total = 0;
+    for (int i = 0; i < segs.size(); ++i) {
+        QCOMPARE(segs[i].startNumber, next);          // contiguous, no gaps or overlap
+        if (i + 1 < segs.size()) QCOMPARE(segs[i].frames % 48, qint64(0)); // GOP aligned
+        next += segs[i].frames;
+        total += segs[i].frames;
+    }
+    QCOMPARE(total, qint64(20000));
+
+    // Too short to split, or only one job fits
+    QVERIFY(W::planSegments(1, 200, 48, 8).isEmpty());
+    QVERIFY(W::planSegments(1, 20000, 48, 1).isEmpty());
+    // Intra codecs split anywhere
+    QCOMPARE(W::planSegments(0, 1000, 1, 2).size(), 4);
+}
+
+void TestMediaConverterWorker::testAutoRenameClaimsAcrossRunningTasks()
+{
+#ifdef Q_OS_WIN
+    QSKIP("Uses a shell script in place of ImageMagick");
+#else
+    using W = MediaConverterWorker;
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    // Stand-in for magick: writes its last argument after a delay, so both tasks run at once
+    const QString tool = dir.filePath("fake_magick.sh");
+    {
+        QFile f(tool);
+        QVERIFY(f.open(QIODevice::WriteOnly));
+        f.write("#!/bin/sh\nfor out; do :; done\nsleep 0.3\nprintf x > \"$out\"\n");
+    }
+    QFile::setPermissions(tool, QFile::permissions(tool) | QFileDevice::ExeOwner);
+
+    // Same base name from two folders into one output folder; the extension keeps
+    // them away from the in-process image engine
+    QVector<W::Task> tasks;
+    for (const QString sub : {"a", "b"}) {
+        QDir().mkpath(dir.filePath(sub));
+        QFile src(dir.filePath(sub + "/plate.raw"));
+        QVERIFY(src.open(QIODevice::WriteOnly));
+        W::Task t;
+        t.sourcePath = src.fileName();
+        t.outputDir = dir.filePath("out");
+        t.target = W::TargetKind::ImageJpg;
+        t.conflict = W::ConflictAction::AutoRename;
+        tasks << t;
+    }
+
+    W worker;
+    worker.setMagickPath(tool);
+    worker.setCpuBudget(4);
+    QStringList outputs;
+    connect(&worker, &W::fileStarted, this, [&outputs](int, const QString&, const QString& out, qint64) { outputs << out; });
+    QSignalSpy finished(&worker, &W::queueFinished);
+    worker.start(tasks);
+    QVERIFY(finished.wait(10000));
+    QVERIFY(finished.first().at(0).toBool());
+    QCOMPARE(outputs.size(), 2);
+    QVERIFY(outputs[0] != outputs[1]);
+    for (const QString& out : outputs) QVERIFY(QFileInfo::exists(out));
+#endif
+}
+
+void TestMediaConverterWorker::testContiguousSequence()
+{
+    using W = MediaConverterWorker;
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    auto touch = [&dir](int frame) {
+        QFile f(dir.filePath(QString("shot.%1.exr").arg(frame, 4, 10, QChar('0'))));
+        return f.open(QIODevice::WriteOnly);
+    };
+    for (int frame = 1001; frame <= 1020; ++frame) QVERIFY(touch(frame));
+    QVERIFY(touch(1030)); // after a 9-frame gap
+
+    const QFileInfo first(dir.filePath("shot.1001.exr"));
+    const QRegularExpressionMatch mm = QRegularExpression("(\\d+)(?!.*\\d)").match(first.fileName());
+    QVERIFY(mm.hasMatch());
+    QVERIFY(W::isContiguousSequence(first, mm, 1001, 1020));
+    QVERIFY(!W::isContiguousSequence(first, mm, 1001, 1030));
+    QVERIFY(!W::isContiguousSequence(first, mm, 1000, 1020));
+}
+
+void TestMediaConverterWorker::testSequenceFallbackReadsWholeSequence()
+{
+#ifdef Q_OS_WIN
+    QSKIP("Uses a shell script in place of FFmpeg");
+#else
+    using W = MediaConverterWorker;
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    // Stand-in for ffmpeg: records its arguments, one per line
+    const QString tool = dir.filePath("fake_ffmpeg.sh");
+    const QString argsFile = dir.filePath("args.txt");
+    {
+        QFile f(tool);
+        QVERIFY(f.open(QIODevice::WriteOnly));
+        f.write(QString("#!/bin/sh\nprintf '%s\\n' \"$@\" > '%1'\n").arg(argsFile).toUtf8());
+    }
+    QFile::setPermissions(tool, QFile::permissions(tool) | QFileDevice::ExeOwner);
+
+    // IFF is not read by the image engine, so the sequence goes to ffmpeg
+    QDir().mkpath(dir.filePath("src"));
+    auto touch = [&dir](int frame) {
+        QFile f(dir.filePath(QString("src/shot.%1.iff").arg(frame, 4, 10, QChar('0'))));
+        return f.open(QIODevice::WriteOnly);
+    };
+    for (int frame = 1001; frame <= 1003; ++frame) QVERIFY(touch(frame));
+
+    W::Task t;
+    t.sourcePath = dir.filePath("src/shot.1002.iff");
+    t.outputDir = dir.filePath("out");
+    t.target = W::TargetKind::PngSequence;
+    QVERIFY(!W::usesImageEngine(t));
+
+    auto run = [&](bool& ok, QString& error) {
+        W worker;
+        worker.setFfmpegPath(tool);
+        connect(&worker, &W::fileFinished, this, [&](int, bool success, const QString& msg) { ok = success; error = msg; });
+        QSignalSpy finished(&worker, &W::queueFinished);
+        worker.start({t});
+        return finished.count() > 0 || finished.wait(10000);
+    };
+
+    bool ok = false;
+    QString error;
+    QVERIFY(run(ok, error));
+    QVERIFY2(ok, qPrintable(error));
+    QFile f(argsFile);
+    QVERIFY(f.open(QIODevice::ReadOnly));
+    const QStringList args = QString::fromUtf8(f.readAll()).split('\n', Qt::SkipEmptyParts);
+    // The input is the whole sequence from its first frame, not the picked file
+    const int in = args.indexOf("-i");
+    QVERIFY(in > 1);
+    QCOMPARE(args[in + 1], QDir(dir.filePath("src")).filePath("shot.%04d.iff"));
+    QCOMPARE(args[in - 2], QString("-start_number"));
+    QCOMPARE(args[in - 1], QString("1001"));
+    QVERIFY(args.last().endsWith("shot_png_seq/shot_%04d.png"));
+
+    // ffmpeg would stop at the gap, so the task is refused instead
+    QVERIFY(touch(1005));
+    QFile::remove(argsFile);
+    QVERIFY(run(ok, error));
+    QVERIFY(!ok);
+    QVERIFY(error.contains("missing frames"));
+    QVERIFY(!QFileInfo::exists(argsFile));
+#endif
+}
+
 QTEST_MAIN(TestMediaConverterWorker)
 #include "test_media_converter_worker.moc"
 
@@ -0,0 +1,144 @@
+#include <QtTest>
+#include <QTemporaryDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QDateTime>
+#include <QDataStream>
+#include "../src/media_probe_cache.h"
+
+class TestMediaProbeCache : public QObject {
+    Q_OBJECT
+
+private:
+    QTemporaryDir tempDir;
+
+    QString writeFile(const QString& name, const QByteArray& data) {
+        const QString path = tempDir.path() + "/" + name;
+        QFile f(path);
+        if (!f.open(QIODevice::WriteOnly)) return QString();
+        f.write(data);
+        return path;
+    }
+
+private slots:
+    void init() {
+        MediaProbeCache::instance().setStoragePath(tempDir.path() + "/probe_cache.dat");
+        MediaProbeCache::instance().clear();
+        // Make sure the fallback never finds a real ffprobe; these tests exercise the cache only
+        MediaProbeCache::instance().setFfprobePath(tempDir.path() + "/no-ffprobe");
+    }
+
+    void testNonMediaIsCachedAsInvalid() {
+        const QString path = writeFile("notes.txt", "not a video");
+        MediaProbeInfo info;
+        QVERIFY(!MediaProbeCache::instance().probe(path, info));
+        QVERIFY(!info.valid);
+        QCOMPARE(MediaProbeCache::instance().size(), 1);
+        // Second lookup is answered from the cache
+        QString err;
+        QVERIFY(!MediaProbeCache::instance().probe(path, info, &err));
+        QVERIFY(err.contains("cached"));
+        QCOMPARE(MediaProbeCache::instance().size(), 1);
+    }
+
+    void testInsertMergesAndPersists() {
+        const QString path = writeFile("clip.mov", QByteArray(1024, 'x'));
+        MediaProbeInfo info;
+        MediaProbeCache::instance().probe(path, info);
+
+        MediaProbeInfo learned;
+        learned.valid = true;
+        learned.durationMs = 4000;
+        MediaProbeCache::instance().insert(path, learned);
+        QVERIFY(MediaProbeCache::instance().probe(path, info));
+        QCOMPARE(info.durationMs, qint64(4000));
+
+        QVERIFY(MediaProbeCache::instance().save());
+        // Reload from disk
+        MediaProbeCache::instance().setStoragePath(tempDir.path() + "/probe_cache.dat");
+        QVERIFY(MediaProbeCache::instance().probe(path, info));
+        QCOMPARE(info.durationMs, qint64(4000));
+    }
+
+    void testChangedFileIsReprobed() {
+        const QString path = writeFile("replaced.mov", QByteArray(10, 'a'));
+        MediaProbeInfo learned;
+        learned.valid = true;
+        learned.durationMs = 1000;
+        MediaProbeCache::instance().insert(path, learned);
+
+        // Different size: the cached entry no longer applies
+        writeFile("replaced.mov", QByteArray(20, 'b'));
+        MediaProbeInfo info;
+        QVERIFY(!MediaProbeCache::instance().probe(path, info));
+        QCOMPARE(info.durationMs, qint64(0));
+    }
+
+    void testKeyframeNearest() {
+        KeyframeIndex index;
+        QCOMPARE(index.nearest(1234), qint64(1234)); // empty index leaves the target alone
+        index.valid = true;
+        index.keyframesMs = {0, 2000, 4000, 6000};
+        QCOMPARE(index.nearest(-50), qint64(0));
+        QCOMPARE(index.nearest(900), qint64(0));
+        QCOMPARE(index.nearest(1000), qint64(0));
+        QCOMPARE(index.nearest(1001), qint64(2000));
+        QCOMPARE(index.nearest(4000), qint64(4000));
+        QCOMPARE(index.nearest(99999), qint64(6000));
+        QCOMPARE(index.atOrBefore(3999), qint64(2000));
+        QCOMPARE(index.atOrBefore(4000), qint64(4000));
+        QCOMPARE(index.atOrBefore(-10), qint64(0));
+        index.allIntra = true;
+        index.keyframesMs.clear();
+        QCOMPARE(index.nearest(1234), qint64(1234));
+        QCOMPARE(index.atOrBefore(1234), qint64(-1));
+    }
+
+    void testKeyframeIndexNeedsVideo() {
+        const QString path = writeFile("audio.txt", "not a video");
+        KeyframeIndex index;
+        QString err;
+        QVERIFY(!MediaProbeCache::instance().keyframeIndex(path, index, &err));
+        QVERIFY(!index.valid);
+        QVERIFY(!err.isEmpty());
+    }
+
+    void testReadsCacheWithoutKeyframes() {
+        // Files written before keyframe indexes existed still load
+        const QString clip = writeFile("old.mov", QByteArray(64, 'o'));
+        const QFileInfo fi(clip);
+        const QString cachePath = tempDir.path() + "/old_cache.dat";
+        {
+            QFile f(cachePath);
+            QVERIFY(f.open(QIODevice::WriteOnly));
+            QDataStream out(&f);
+            out.setVersion(QDataStream::Qt_6_0);
+            out << quint32(0x4b4d5043) << quint32(1) << qint32(1);
+            out << fi.absoluteFilePath() << fi.size() << fi.lastModified().toMSecsSinceEpoch();
+            out << true << qint64(2500) << 1920 << 1080 << 25.0 << QString("h264") << QString("High")
+                << QString("yuv420p") << false << QString("aac") << qint64(8000000) << QString();
+        }
+        MediaProbeCache::instance().setStoragePath(cachePath);
+        MediaProbeInfo info;
+        QVERIFY(MediaProbeCache::instance().probe(clip, info));
+        QCOMPARE(info.durationMs, qint64(2500));
+        QCOMPARE(info.width, 1920);
+
+        // Round trip in the current format
+        QVERIFY(MediaProbeCache::instance().save());
+        MediaProbeCache::instance().setStoragePath(cachePath);
+        QVERIFY(MediaProbeCache::instance().probe(clip, info));
+        QCOMPARE(info.videoCodec, QString("h264"));
+    }
+
+    void testMissingFile() {
+        MediaProbeInfo info;
+        QString err;
+        QVERIFY(!MediaProbeCache::instance().probe(tempDir.path() + "/missing.mov", info, &err));
+        QVERIFY(!err.isEmpty());
+        QCOMPARE(MediaProbeCache::instance().size(), 0);
+    }
+};
+
+QTEST_APPLESS_MAIN(TestMediaProbeCache)
+#include "test_media_probe_cache.moc"
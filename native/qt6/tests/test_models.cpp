@@ -3,8 +3,14 @@
 #include <QTemporaryDir>
 #include <QFile>
 #include <QDateTime>
+#include <algorithm>
 #include "../src/db.h"
 #include "../src/assets_model.h"
+#include "../src/filter_bitset.h"
+#include "../src/assets_table_model.h"
+#include "../src/natural_sort.h"
+#include "../src/asset_query.h"
+#include "../src/tag_index.h"
 
 class TestModels : public QObject {
     Q_OBJECT
@@ -86,6 +92,234 @@ private slots:
         QCOMPARE(model.rowCount({}), 2);
     }
 
+    void testAssetsModelFilterUpdatesRowsInPlace() {
+        AssetsModel model;
+        model.setFolderId(folderId);
+        model.reload();
+        QCOMPARE(model.rowCount({}), 2);
+
+        QSignalSpy resets(&model, &QAbstractItemModel::modelReset);
+        QSignalSpy removed(&model, &QAbstractItemModel::rowsRemoved);
+        QSignalSpy inserted(&model, &QAbstractItemModel::rowsInserted);
+
+        // Rows come back ordered by file name: clip1.mp4, img1.png
+        model.setFilters(AssetsModel::Images, AssetsModel::AllRatings, {}, AssetsModel::And);
+        QCOMPARE(model.rowCount({}), 1);
+        QCOMPARE(model.data(model.index(0, 0), AssetsModel::FilePathRole).toString(), imgPath);
+        QCOMPARE(removed.count(), 1);
+        QCOMPARE(removed.first().at(1).toInt(), 0);
+
+        model.setFilters(AssetsModel::All, AssetsModel::AllRatings, {}, AssetsModel::And);
+        QCOMPARE(model.rowCount({}), 2);
+        QCOMPARE(inserted.count(), 1);
+        QCOMPARE(resets.count(), 0);
+
+        // Unchanged result: no signals at all
+        model.setSearchQuery("1");
+        QCOMPARE(model.rowCount({}), 2);
+        QCOMPARE(removed.count() + inserted.count() + resets.count(), 2);
+    }
+
+    void testAssetsModelFacetCounts() {
+        AssetsModel model;
+        model.setFolderId(folderId);
+        model.reload();
+        const AssetsModel::FacetCounts& f = model.facetCounts();
+        QCOMPARE(f.images, 1);
+        QCOMPARE(f.videos, 1);
+        QCOMPARE(f.others, 0);
+        QCOMPARE(f.ratings[0], 2);
+        QCOMPARE(f.extensions.value("png"), 1);
+        QCOMPARE(f.extensions.value("mp4"), 1);
+        QCOMPARE(f.singles, 2);
+
+        // A facet ignores its own filter, everything else follows the visible rows
+        QSignalSpy changed(&model, &AssetsModel::facetCountsChanged);
+        model.setFilters(AssetsModel::Images, AssetsModel::AllRatings, {}, AssetsModel::And);
+        QVERIFY(changed.count() >= 1);
+        QCOMPARE(f.images, 1);
+        QCOMPARE(f.videos, 1);
+        QCOMPARE(f.ratings[0], 1);
+        QCOMPARE(f.extensions.size(), 1);
+        QCOMPARE(f.extensions.value("png"), 1);
+        QCOMPARE(f.singles, 1);
+
+        model.setFilters(AssetsModel::Images, AssetsModel::FiveStars, {}, AssetsModel::And);
+        QCOMPARE(f.images, 0);
+        QCOMPARE(f.ratings[0], 1);
+        QVERIFY(f.extensions.isEmpty());
+        QCOMPARE(model.facetCountsMap().value("images").toInt(), 0);
+    }
+
+    void testNaturalSortKeys() {
+        const QStringList expected = {
+            "img2.png", "IMG10.png", "img10b.png",
+            "shot.999.exr", "shot.1000.exr", "shot.1001.jpg", "shot_b.0001.exr",
+        };
+        QStringList names = {expected[6], expected[4], expected[1], expected[5], expected[0], expected[3], expected[2]};
+        std::sort(names.begin(), names.end(), [](const QString& a, const QString& b) {
+            return NaturalSort::key(a) < NaturalSort::key(b);
+        });
+        QCOMPARE(names, expected);
+        QCOMPARE(NaturalSort::compare("a.exr", "A.EXR"), 0);
+        QVERIFY(NaturalSort::compare("frame_09.exr", "frame_10.exr") < 0);
+
+        // compare() walks the keys in place; it must agree with the keys themselves
+        const QStringList tricky = {
+            "", "a", "a.", ".hidden", "A.b", "ab.exr", "a.exr", "x00y", "x0y", "x7y",
+            "shot.0101.exr", "shot.101.exr", "shot.0101", "plate_12", "plate12", "plate_012.dpx",
+            QString::fromUtf8("\xc3\x84rger.png"), QString::fromUtf8("\xc3\xa4rger.PNG"),
+            QString::fromUtf8("\xf0\x9d\x92\x9c.png"), QString::fromUtf8("\xce\xa3\xcf\x82.tif"),
+            QString(100, QLatin1Char('7')), QString(99, QLatin1Char('7')) + "8.exr", "0007.exr",
+        };
+        for (const QString& a : tricky) {
+            for (const QString& b : tricky) {
+                const QByteArray ka = NaturalSort::key(a);
+                const QByteArray kb = NaturalSort::key(b);
+                const int expected = ka < kb ? -1 : (kb < ka ? 1 : 0);
+                const int actual = NaturalSort::compare(a, b);
+                QVERIFY2((actual > 0) - (actual < 0) == expected, qPrintable(a + " vs " + b));
+            }
+        }
+    }
+
+    void testAssetsTableModelSort() {
+        AssetsModel model;
+        model.setFolderId(folderId);
+        model.reload();
+        AssetsTableModel table(&model);
+        QCOMPARE(table.rowCount(), 2);
+
+        // Name ascending: clip1.mp4, img1.png
+        table.sort(AssetsTableModel::NameColumn, Qt::AscendingOrder);
+        QCOMPARE(table.data(table.index(0, 0), Qt::UserRole + 1).toString(), vidPath);
+        table.sort(AssetsTableModel::ExtensionColumn, Qt::DescendingOrder);
+        QCOMPARE(table.data(table.index(0, 0), Qt::UserRole + 1).toString(), imgPath);
+        QCOMPARE(model.data(model.index(table.mapToSource(0), 0), AssetsModel::FilePathRole).toString(), imgPath);
+        QCOMPARE(table.mapFromSource(table.mapToSource(1)), 1);
+
+        // Filtering the source keeps the table's order and mapping consistent
+        model.setFilters(AssetsModel::Images, AssetsModel::AllRatings, {}, AssetsModel::And);
+        QCOMPARE(table.rowCount(), 1);
+        QCOMPARE(table.data(table.index(0, 0), Qt::UserRole + 1).toString(), imgPath);
+        model.setFilters(AssetsModel::All, AssetsModel::AllRatings, {}, AssetsModel::And);
+        QCOMPARE(table.rowCount(), 2);
+        QCOMPARE(table.data(table.index(0, 0), Qt::UserRole + 1).toString(), imgPath);
+        QCOMPARE(table.data(table.index(1, 0), Qt::UserRole + 1).toString(), vidPath);
+    }
+
+    void testFilterBitset() {
+        FilterBitset a(130, true);
+        QCOMPARE(a.count(), 130);
+        QVERIFY(a.isAllSet());
+        FilterBitset b(130);
+        b.set(0); b.set(64); b.set(129);
+        QCOMPARE(b.indexes(), QVector<int>({0, 64, 129}));
+
+        FilterBitset c = a;
+        c &= b;
+        QCOMPARE(c, b);
+        c.andNot(b);
+        QCOMPARE(c.count(), 0);
+        c |= b;
+        c.reset(64);
+        QCOMPARE(c.indexes(), QVector<int>({0, 129}));
+        QCOMPARE(c.andCount(b), 2);
+        QCOMPARE(a.andCount(b), 3);
+        QVERIFY(b.test(129) && !b.test(128));
+        // Bits past the end never leak into counts
+        a.fill(true);
+        QCOMPARE(a.count(), 130);
+    }
+
+    void testAssetQueryParse() {
+        QString error;
+        const AssetQuery q = AssetQuery::parse("ext:exr,DPX rating:>=4 size:>2GB frames:>100 path:/shows/abc plate", &error);
+        QVERIFY(error.isEmpty());
+        QCOMPARE(q.clauses().size(), 6);
+        QCOMPARE(q.clauses()[0][0].values, QStringList({"exr", "dpx"}));
+        QCOMPARE(q.clauses()[2][0].number, qint64(2) * 1024 * 1024 * 1024);
+        QVERIFY(q.clauses()[4][0].prefix);
+
+        // Every term here is answered by SQL, so each adds to the WHERE clause
+        QVariantList binds;
+        const QString where = q.sqlWhere(&binds);
+        QVERIFY(where.contains(DB::fileExtensionExpr()));
+        QVERIFY(where.contains("is_sequence=1"));
+        QCOMPARE(binds.size(), 2 + 1 + 1 + 1 + 2 + 2);
+
+        AssetRow row;
+        row.fileName = "plate.0001.exr";
+        row.filePath = "/shows/abc/plate.0001.exr";
+        row.fileSize = qint64(3) * 1024 * 1024 * 1024;
+        row.rating = 5;
+        row.isSequence = true;
+        row.sequenceFrameCount = 120;
+        QVERIFY(q.matches(row));
+        row.sequenceFrameCount = 50;
+        QVERIFY(!q.matches(row));
+
+        // Negation, OR, and modified: stay in memory; unknown fields are plain text
+        const AssetQuery mixed = AssetQuery::parse("-ext:exr OR rating:0 modified:<7d C:/shows");
+        QCOMPARE(mixed.clauses().size(), 3);
+        QCOMPARE(mixed.clauses()[0].size(), 2);
+        QCOMPARE(mixed.clauses()[2][0].field, AssetQuery::Field::Text);
+        binds.clear();
+        QVERIFY(!mixed.sqlWhere(&binds).contains("rating"));
+        row.rating = -1;
+        row.lastModified = QDateTime::currentDateTime().addDays(-1);
+        row.filePath = "C:/shows/abc/plate.0001.exr";
+        QVERIFY(mixed.matches(row));
+        row.lastModified = QDateTime::currentDateTime().addDays(-30);
+        QVERIFY(!mixed.matches(row));
+
+        // Malformed values fall back to text and say so
+        const AssetQuery bad = AssetQuery::parse("rating:lots", &error);
+        QVERIFY(!error.isEmpty());
+        QCOMPARE(bad.clauses()[0][0].field, AssetQuery::Field::Text);
+    }
+
+    void testAssetsModelStructuredSearch() {
+        // Runs last: it rates and tags the shared fixture assets
+        AssetsModel model;
+        model.setFolderId(folderId);
+        model.setSearchEntireDatabase(true);
+        model.setSearchQuery("ext:png");
+        model.reload();
+        QCOMPARE(model.rowCount({}), 1);
+        QCOMPARE(model.data(model.index(0, 0), AssetsModel::FilePathRole).toString(), imgPath);
+
+        model.setSearchQuery("ext:png OR ext:mp4");
+        QCOMPARE(model.rowCount({}), 2);
+        model.setSearchQuery("-ext:png clip");
+        QCOMPARE(model.rowCount({}), 1);
+        model.setSearchQuery("size:>1MB");
+        QCOMPARE(model.rowCount({}), 0);
+
+        const int imgId = DB::instance().getAssetIdByPath(imgPath);
+        QVERIFY(DB::instance().setAssetsRating({imgId}, 4));
+        model.setSearchQuery("rating:>=4");
+        QCOMPARE(model.rowCount({}), 1);
+        model.setSearchQuery("rating:0");
+        QCOMPARE(model.rowCount({}), 1);
+        QCOMPARE(model.data(model.index(0, 0), AssetsModel::FilePathRole).toString(), vidPath);
+
+        const int hero = DB::instance().createTag("hero");
+        QVERIFY(hero > 0);
+        QVERIFY(DB::instance().assignTagsToAssets({imgId}, {hero}));
+        model.setSearchQuery("tag:hero modified:<1d");
+        QCOMPARE(model.rowCount({}), 1);
+        QCOMPARE(model.data(model.index(0, 0), AssetsModel::FilePathRole).toString(), imgPath);
+
+        // Folder scope filters the loaded rows with the same language
+        model.setSearchEntireDatabase(false);
+        model.reload();
+        QCOMPARE(model.rowCount({}), 1);
+        model.setSearchQuery("-tag:hero");
+        QCOMPARE(model.rowCount({}), 1);
+        QCOMPARE(model.data(model.index(0, 0), AssetsModel::FilePathRole).toString(), vidPath);
+    }
+
 private:
     static bool writeDummy(const QString& p) {
         QFile f(p);
@@ -0,0 +1,128 @@
+#include <QtTest>
+#include <QTemporaryDir>
+#include <QFile>
+#include <QImage>
+#include "../src/oiio_image_loader.h"
+
+#if defined(HAVE_OPENIMAGEIO) && HAVE_OPENIMAGEIO
+#include <OpenImageIO/imageio.h>
+#include <vector>
+#endif
+
+class TestOIIOImageLoader : public QObject {
+    Q_OBJECT
+
+private:
+    QTemporaryDir tempDir;
+
+    // Left half red, right half blue
+    QString writeSplitImage(const QString& name, int width, int height) {
+        QImage img(width, height, QImage::Format_RGB32);
+        for (int y = 0; y < height; ++y) {
+            for (int x = 0; x < width; ++x) img.setPixel(x, y, x < width / 2 ? qRgb(255, 0, 0) : qRgb(0, 0, 255));
+        }
+        const QString path = tempDir.filePath(name);
+        return img.save(path) ? path : QString();
+    }
+
+    static QRgb pixel(const QImage& image, int x, int y) {
+        return image.convertToFormat(QImage::Format_ARGB32).pixel(x, y);
+    }
+
+private slots:
+    void testPicksSmallestCoveringReduction_data() {
+        QTest::addColumn<QString>("name");
+        QTest::newRow("qt decoder") << "split.png";
+        QTest::newRow("oiio decoder") << "split.bmp";
+    }
+
+    void testPicksSmallestCoveringReduction() {
+        QFETCH(QString, name);
+        const QString path = writeSplitImage(name, 256, 128);
+        QVERIFY(!path.isEmpty());
+
+        // 256x128 / 4 = 64x32 still covers 60x30; / 8 would not
+        QSize full;
+        const QImage reduced = OIIOImageLoader::loadImageReducedLinear(path, QSize(60, 30), &full);
+        QCOMPARE(full, QSize(256, 128));
+        QCOMPARE(reduced.size(), QSize(64, 32));
+        QCOMPARE(qRed(pixel(reduced, 4, 16)), 255);
+        QCOMPARE(qBlue(pixel(reduced, 4, 16)), 0);
+        QCOMPARE(qBlue(pixel(reduced, 60, 16)), 255);
+        QCOMPARE(qRed(pixel(reduced, 60, 16)), 0);
+
+        // Exactly half still covers; one pixel more does not
+        QCOMPARE(OIIOImageLoader::loadImageReducedLinear(path, QSize(128, 64)).size(), QSize(128, 64));
+        QCOMPARE(OIIOImageLoader::loadImageReducedLinear(path, QSize(129, 64)).size(), QSize(256, 128));
+        // No size: full resolution; a tiny size stops at 1/16
+        QCOMPARE(OIIOImageLoader::loadImageReducedLinear(path, QSize()).size(), QSize(256, 128));
+        QCOMPARE(OIIOImageLoader::loadImageReducedLinear(path, QSize(1, 1)).size(), QSize(16, 8));
+    }
+
+    void testDecodesFromMemory() {
+        const QString path = writeSplitImage("memory.bmp", 128, 64);
+        QVERIFY(!path.isEmpty());
+        QFile f(path);
+        QVERIFY(f.open(QIODevice::ReadOnly));
+        const QByteArray encoded = f.readAll();
+
+        QSize full;
+        const QImage fromMemory = OIIOImageLoader::loadImageReducedLinear(path, encoded, QSize(32, 16), &full);
+        QCOMPARE(full, QSize(128, 64));
+        const QImage fromFile = OIIOImageLoader::loadImageReducedLinear(path, QSize(32, 16));
+        QCOMPARE(fromMemory.size(), QSize(32, 16));
+        QCOMPARE(fromMemory.convertToFormat(QImage::Format_ARGB32), fromFile.convertToFormat(QImage::Format_ARGB32));
+
+        // Bytes read from a file that was replaced since: still decodes what was read
+        QVERIFY(QFile::remove(path));
+        QCOMPARE(OIIOImageLoader::loadImageReducedLinear(path, encoded, QSize(32, 16)).size(), QSize(32, 16));
+    }
+
+    void testKeepsAlpha() {
+        QImage img(64, 64, QImage::Format_ARGB32);
+        img.fill(qRgba(0, 255, 0, 0));
+        const QString path = tempDir.filePath("alpha.png");
+        QVERIFY(img.save(path));
+        const QImage reduced = OIIOImageLoader::loadImageReducedLinear(path, QSize(16, 16));
+        QCOMPARE(reduced.size(), QSize(16, 16));
+        QVERIFY(reduced.hasAlphaChannel());
+        QCOMPARE(qAlpha(pixel(reduced, 8, 8)), 0);
+    }
+
+    void testMissingFileFails() {
+        QSize full(1, 1);
+        QVERIFY(OIIOImageLoader::loadImageReducedLinear(tempDir.filePath("missing.png"), QSize(8, 8), &full).isNull());
+        QVERIFY(OIIOImageLoader::loadImageReducedLinear(tempDir.filePath("missing.exr"), QSize()).isNull());
+    }
+
+#if defined(HAVE_OPENIMAGEIO) && HAVE_OPENIMAGEIO
+    void testHdrIsBoxFilteredAndStaysLinear() {
+        // 64x32 float RGB: columns alternate 0.0 and 4.0, so 2x2 boxes average to 2.0
+        const int w = 64, h = 32;
+        std::vector<float> pixels(size_t(w) * h * 3);
+        for (int y = 0; y < h; ++y) {
+            for (int x = 0; x < w; ++x) {
+                for (int c = 0; c < 3; ++c) pixels[(size_t(y) * w + x) * 3 + c] = (x % 2) ? 4.0f : 0.0f;
+            }
+        }
+        const QString path = tempDir.filePath("hdr.exr");
+        auto out = OIIO::ImageOutput::create(path.toStdString());
+        QVERIFY(out);
+        QVERIFY(out->open(path.toStdString(), OIIO::ImageSpec(w, h, 3, OIIO::TypeDesc::HALF)));
+        QVERIFY(out->write_image(OIIO::TypeDesc::FLOAT, pixels.data()));
+        QVERIFY(out->close());
+
+        QSize full;
+        const QImage linear = OIIOImageLoader::loadImageReducedLinear(path, QSize(32, 16), &full);
+        QCOMPARE(full, QSize(w, h));
+        QCOMPARE(linear.size(), QSize(32, 16));
+        QCOMPARE(linear.format(), QImage::Format_RGBX16FPx4);
+        const qfloat16* px = reinterpret_cast<const qfloat16*>(linear.constScanLine(5));
+        QCOMPARE(float(px[4 * 7]), 2.0f);
+        QCOMPARE(float(px[4 * 7 + 3]), 1.0f);
+    }
+#endif
+};
+
+QTEST_GUILESS_MAIN(TestOIIOImageLoader)
+#include "test_oiio_image_loader.moc"
@@ -0,0 +1,90 @@
+#include <QtTest>
+#include <QImage>
+#include <QPainter>
+#include <QRandomGenerator>
+#include <algorithm>
+#include "../src/perceptual_hash.h"
+
+class TestPerceptualHash : public QObject {
+    Q_OBJECT
+private slots:
+    void testResizeIsStable();
+    void testDifferentImagesDiffer();
+    void testIndexNearestMatchesBruteForce();
+    void testIndexRemove();
+
+private:
+    static QImage gradientImage(int w, int h, bool flip);
+};
+
+QImage TestPerceptualHash::gradientImage(int w, int h, bool flip)
+{
+    QImage img(w, h, QImage::Format_RGB32);
+    QPainter p(&img);
+    QLinearGradient g(0, 0, w, h);
+    g.setColorAt(0, flip ? Qt::white : Qt::black);
+    g.setColorAt(1, flip ? Qt::black : Qt::white);
+    p.fillRect(img.rect(), g);
+    p.fillRect(QRect(w / 4, h / 4, w / 3, h / 3), Qt::red);
+    return img;
+}
+
+void TestPerceptualHash::testResizeIsStable()
+{
+    const QImage big = gradientImage(1920, 1080, false);
+    const QImage small = big.scaled(480, 270, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+    QVERIFY(PerceptualHash::distance(PerceptualHash::dHash(big), PerceptualHash::dHash(small)) <= 5);
+}
+
+void TestPerceptualHash::testDifferentImagesDiffer()
+{
+    const quint64 a = PerceptualHash::dHash(gradientImage(640, 360, false));
+    const quint64 b = PerceptualHash::dHash(gradientImage(640, 360, true));
+    QVERIFY(PerceptualHash::distance(a, b) > 12);
+}
+
+void TestPerceptualHash::testIndexNearestMatchesBruteForce()
+{
+    QRandomGenerator rng(42);
+    PerceptualHashIndex index;
+    QHash<int, quint64> all;
+    for (int id = 1; id <= 5000; ++id) {
+        const quint64 h = rng.generate64();
+        all.insert(id, h);
+        index.insert(id, h);
+    }
+    // Plant near neighbours of a query
+    const quint64 query = rng.generate64();
+    index.insert(9001, query ^ 0x1);
+    index.insert(9002, query ^ 0x8000000000000003ULL);
+    all.insert(9001, query ^ 0x1);
+    all.insert(9002, query ^ 0x8000000000000003ULL);
+
+    const auto result = index.nearest(query, 5, 24);
+    QVector<int> brute;
+    for (auto it = all.constBegin(); it != all.constEnd(); ++it) brute.append(PerceptualHash::distance(query, it.value()));
+    std::sort(brute.begin(), brute.end());
+
+    QVERIFY(!result.isEmpty());
+    QCOMPARE(result[0].id, 9001);
+    QCOMPARE(result[0].distance, 1);
+    QCOMPARE(result[1].id, 9002);
+    for (int i = 0; i < result.size(); ++i) QCOMPARE(result[i].distance, brute[i]);
+}
+
+void TestPerceptualHash::testIndexRemove()
+{
+    PerceptualHashIndex index;
+    index.insert(1, 0xFFULL);
+    index.insert(2, 0xFEULL);
+    QCOMPARE(index.nearest(0xFFULL, 10, 4, 1).size(), 1);
+    QVERIFY(index.remove(2));
+    QVERIFY(!index.remove(2));
+    QVERIFY(index.nearest(0xFFULL, 10, 4, 1).isEmpty());
+    index.insert(1, 0x0ULL); // re-insert replaces the old hash
+    QCOMPARE(index.size(), 1);
+    QCOMPARE(index.nearest(0x0ULL, 1, 0).size(), 1);
+}
+
+QTEST_MAIN(TestPerceptualHash)
+#include "test_perceptual_hash.moc"
@@ -0,0 +1,182 @@
+#include <QtTest>
+#include <QTemporaryDir>
+#include <QDir>
+#include <QFile>
+#include <QImage>
+#include <QImageReader>
+#include "../src/proxy_manager.h"
+#include "../src/media_probe_cache.h"
+
+class TestProxyManager : public QObject {
+    Q_OBJECT
+
+private:
+    QTemporaryDir tempDir;
+
+    QStringList writeSequence(const QString& dirName, const QString& prefix, int count) {
+        QDir().mkpath(tempDir.path() + "/" + dirName);
+        QStringList frames;
+        for (int i = 1; i <= count; ++i) {
+            const QString path = QString("%1/%2/%3.%4.png").arg(tempDir.path(), dirName, prefix).arg(i, 4, 10, QLatin1Char('0'));
+            QImage img(64, 32, QImage::Format_RGB32);
+            img.fill(QColor(40 * i, 80, 120));
+            if (!img.save(path)) return {};
+            frames << path;
+        }
+        return frames;
+    }
+
+    ProxyInfo generate(const QStringList& frames, int assetId) {
+        QSignalSpy ready(&ProxyManager::instance(), &ProxyManager::proxyReady);
+        if (!ProxyManager::instance().requestSequence(frames, assetId, true)) return {};
+        if (!ready.wait(10000) && ready.isEmpty()) return {};
+        return ready.first().first().value<ProxyInfo>();
+    }
+
+private slots:
+    void init() {
+        ProxyManager& pm = ProxyManager::instance();
+        pm.cancelAll();
+        pm.waitForDone();
+        pm.setCacheDir(tempDir.path() + "/proxies");
+        pm.clearAll();
+        pm.setEnabled(true);
+        pm.setScale(2);
+        pm.setSequenceFormat(ProxyManager::SequenceFormat::Jpeg);
+        pm.setBudgetBytes(qint64(1) << 30);
+        MediaProbeCache::instance().setStoragePath(tempDir.path() + "/probe_cache.dat");
+    }
+
+    void testSourceKey() {
+        const QString a = ProxyManager::sourceKey("/shots/sh010/comp.0001.exr", true);
+        QCOMPARE(ProxyManager::sourceKey("/shots/sh010/comp.0101.exr", true), a);
+        QVERIFY(ProxyManager::sourceKey("/shots/sh010/comp.0001.jpg", true) != a);
+        QVERIFY(ProxyManager::sourceKey("/shots/sh010/comp_v2.0001.exr", true) != a);
+        QCOMPARE(ProxyManager::proxyFramePath("/cache/ab/proxy.0.jpg", "/shots/sh010/comp.0101.exr"),
+                 QString("/cache/ab/proxy.0101.jpg"));
+    }
+
+    void testSequenceFrames() {
+        const QStringList frames = writeSequence("frames", "shot", 3);
+        QCOMPARE(frames.size(), 3);
+        writeSequence("frames", "other", 2);
+        const QStringList found = ProxyManager::sequenceFrames(frames.at(1));
+        QCOMPARE(found.size(), 3);
+        QCOMPARE(QFileInfo(found.first()).fileName(), QString("shot.0001.png"));
+        QCOMPARE(QFileInfo(found.last()).fileName(), QString("shot.0003.png"));
+    }
+
+    void testNeedsProxy() {
+        QVERIFY(ProxyManager::sequenceNeedsProxy("/a/comp.0001.exr"));
+        QVERIFY(ProxyManager::sequenceNeedsProxy("/a/scan.0001.dpx"));
+        QVERIFY(!ProxyManager::sequenceNeedsProxy("/a/preview.0001.jpg"));
+
+        MediaProbeInfo info;
+        QVERIFY(!ProxyManager::videoNeedsProxy(info));
+        info.valid = true;
+        info.width = 1920;
+        info.videoCodec = "h264";
+        info.bitrate = 20000000;
+        QVERIFY(!ProxyManager::videoNeedsProxy(info));
+        info.width = 3840;
+        QVERIFY(ProxyManager::videoNeedsProxy(info));
+        info.width = 1920;
+        info.videoCodec = "prores";
+        info.videoProfile = "4444 XQ";
+        QVERIFY(ProxyManager::videoNeedsProxy(info));
+    }
+
+    void testSequenceProxyGeneration() {
+        const QStringList frames = writeSequence("gen", "plate", 3);
+        // PNG plays fine at full resolution: only generated on explicit request
+        QVERIFY(!ProxyManager::instance().requestSequence(frames));
+
+        const ProxyInfo info = generate(frames, 7);
+        QCOMPARE(info.frameCount, 3);
+        QCOMPARE(info.assetId, 7);
+        QCOMPARE(info.kind, ProxyInfo::Kind::JpegSequence);
+        QVERIFY(info.byteSize > 0);
+
+        const QStringList proxies = ProxyManager::instance().sequenceProxyFrames(frames);
+        QCOMPARE(proxies.size(), 3);
+        QCOMPARE(QFileInfo(proxies.at(1)).fileName(), QString("proxy.0002.jpg"));
+        QCOMPARE(QImageReader(proxies.at(1)).size(), QSize(32, 16));
+        QCOMPARE(ProxyManager::instance().sequenceProxy(frames.last()), proxies.first());
+
+        // Up to date: nothing to do
+        QVERIFY(!ProxyManager::instance().requestSequence(frames, 7, true));
+
+        // An edited source no longer matches its proxy
+        QFile f(frames.first());
+        QVERIFY(f.open(QIODevice::ReadWrite));
+        QVERIFY(f.setFileTime(QDateTime::currentDateTime().addSecs(60), QFileDevice::FileModificationTime));
+        f.close();
+        QVERIFY(ProxyManager::instance().sequenceProxyFrames(frames).isEmpty());
+    }
+
+    void testBudgetEvictsLeastRecentlyUsed() {
+        const QStringList a = writeSequence("lru_a", "a", 2);
+        const QStringList b = writeSequence("lru_b", "b", 2);
+        const ProxyInfo pa = generate(a, 1);
+        const ProxyInfo pb = generate(b, 2);
+        QVERIFY(!pa.proxyPath.isEmpty());
+        QVERIFY(!pb.proxyPath.isEmpty());
+
+        // Use A after B was made: B is now the least recently used
+        QTest::qWait(5);
+        QVERIFY(!ProxyManager::instance().sequenceProxy(a.first()).isEmpty());
+
+        QSignalSpy removed(&ProxyManager::instance(), &ProxyManager::proxyRemoved);
+        ProxyManager::instance().setBudgetBytes(pa.byteSize);
+        QCOMPARE(removed.count(), 1);
+        QCOMPARE(removed.first().at(0).toString(), pb.sourceKey);
+        QCOMPARE(removed.first().at(1).toInt(), 2);
+        QVERIFY(!QFileInfo::exists(pb.proxyPath));
+        QVERIFY(!ProxyManager::instance().sequenceProxy(a.first()).isEmpty());
+        QCOMPARE(ProxyManager::instance().totalBytes(), pa.byteSize);
+    }
+
+    void testIndexPersistsAndOrphansAreRemoved() {
+        const QStringList frames = writeSequence("persist", "p", 2);
+        const ProxyInfo info = generate(frames, 3);
+        QVERIFY(!info.proxyPath.isEmpty());
+        QVERIFY(ProxyManager::instance().save());
+
+        const QString orphan = tempDir.path() + "/proxies/0123456789abcdef";
+        QVERIFY(QDir().mkpath(orphan));
+        QFile marker(orphan + "/.kasset-proxy");
+        QVERIFY(marker.open(QIODevice::WriteOnly));
+        marker.close();
+        // Same naming scheme but not created by the manager: must survive
+        const QString foreign = tempDir.path() + "/proxies/fedcba9876543210";
+        QVERIFY(QDir().mkpath(foreign));
+
+        // Reload the index from disk
+        ProxyManager::instance().setCacheDir(tempDir.path() + "/elsewhere");
+        ProxyManager::instance().setCacheDir(tempDir.path() + "/proxies");
+        const QVector<ProxyInfo> loaded = ProxyManager::instance().proxies();
+        QCOMPARE(loaded.size(), 1);
+        QCOMPARE(loaded.first().sourceKey, info.sourceKey);
+        QCOMPARE(loaded.first().assetId, 3);
+        QVERIFY(!QFileInfo::exists(orphan));
+        QVERIFY(QFileInfo::exists(foreign));
+        QCOMPARE(ProxyManager::instance().sequenceProxyFrames(frames).size(), 2);
+    }
+
+    void testFailureReportsSourcePath() {
+        QDir().mkpath(tempDir.path() + "/broken");
+        const QString frame = tempDir.path() + "/broken/bad.0001.png";
+        QFile f(frame);
+        QVERIFY(f.open(QIODevice::WriteOnly));
+        f.write("not an image");
+        f.close();
+
+        QSignalSpy failed(&ProxyManager::instance(), &ProxyManager::proxyFailed);
+        QVERIFY(ProxyManager::instance().requestSequence({frame}, 4, true));
+        QVERIFY(failed.wait(10000) || !failed.isEmpty());
+        QCOMPARE(failed.first().first().toString(), QFileInfo(frame).absoluteFilePath());
+    }
+};
+
+QTEST_GUILESS_MAIN(TestProxyManager)
+#include "test_proxy_manager.moc"
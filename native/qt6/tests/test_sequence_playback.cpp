@@ -0,0 +1,132 @@
+#include <QtTest>
+#include "../src/sequence_playback.h"
+
+class TestSequencePlayback : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testStepWrapsAndBounces() {
+        int direction = 1;
+        QCOMPARE(SequencePlayback::step(3, direction, 5, false), 4);
+        QCOMPARE(SequencePlayback::step(4, direction, 5, false), 0);
+        QCOMPARE(direction, 1);
+        direction = -1;
+        QCOMPARE(SequencePlayback::step(0, direction, 5, false), 4);
+        QCOMPARE(direction, -1);
+
+        direction = 1;
+        QCOMPARE(SequencePlayback::step(4, direction, 5, true), 3);
+        QCOMPARE(direction, -1);
+        QCOMPARE(SequencePlayback::step(0, direction, 5, true), 1);
+        QCOMPARE(direction, 1);
+
+        QCOMPARE(SequencePlayback::step(0, direction, 1, true), 0);
+        QCOMPARE(SequencePlayback::step(0, direction, 0, false), 0);
+    }
+
+    void testFrameAfterMatchesSteppedPlayback() {
+        for (int total = 1; total <= 6; ++total) {
+            for (bool pingPong : {false, true}) {
+                for (int startDirection : {1, -1}) {
+                    for (int frame = 0; frame < total; ++frame) {
+                        int stepped = frame;
+                        int steppedDirection = startDirection;
+                        for (qint64 steps = 1; steps <= 3 * total + 2; ++steps) {
+                            stepped = SequencePlayback::step(stepped, steppedDirection, total, pingPong);
+                            int direction = startDirection;
+                            const int jumped = SequencePlayback::frameAfter(frame, steps, direction, total, pingPong);
+                            QCOMPARE(jumped, stepped);
+                            // At the ends the direction is ambiguous (about to bounce vs. bounced)
+                            if (stepped > 0 && stepped < total - 1) QCOMPARE(direction, steppedDirection);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    void testFrameAfterLargeJumps() {
+        int direction = 1;
+        QCOMPARE(SequencePlayback::frameAfter(2, 1000003, direction, 10, false), 5);
+        direction = -1;
+        QCOMPARE(SequencePlayback::frameAfter(2, 13, direction, 10, false), 9);
+        // Ping-pong period over 10 frames is 18
+        direction = 1;
+        QCOMPARE(SequencePlayback::frameAfter(0, 18 * 1000 + 12, direction, 10, true), 6);
+        QCOMPARE(direction, -1);
+    }
+
+    void testLeadFrames() {
+        QCOMPARE(SequencePlayback::leadFrames(1, 4, 0.0, 25.0), 0);
+        // Unmeasured: half the cache
+        QCOMPARE(SequencePlayback::leadFrames(100, 4, 0.0, 25.0), 50);
+        // 4 workers at 200 ms = 20 fps, short of 25: lead with all but the trail (100 / 8)
+        QCOMPARE(SequencePlayback::leadFrames(100, 4, 200.0, 25.0), 88);
+        // 400 fps: one decode latency plus a second at 25 fps, plus the workers
+        QCOMPARE(SequencePlayback::leadFrames(100, 4, 10.0, 25.0), 30);
+        // Never below two frames per worker, never into the trail
+        QCOMPARE(SequencePlayback::leadFrames(100, 20, 1.0, 1.0), 40);
+        QCOMPARE(SequencePlayback::leadFrames(8, 4, 0.0, 25.0), 7);
+        QCOMPARE(SequencePlayback::leadFrames(1000, 4, 10.0, 1000.0), 875);
+    }
+
+    void testWindowLeadsInPlaybackDirection() {
+        QCOMPARE(SequencePlayback::window(5, 1, 10, false, 3, 6), (QVector<int>{5, 6, 7, 8, 4, 3}));
+        QCOMPARE(SequencePlayback::window(5, -1, 10, false, 3, 6), (QVector<int>{5, 4, 3, 2, 6, 7}));
+        // Looping playback leads across the end
+        QCOMPARE(SequencePlayback::window(8, 1, 10, false, 3, 5), (QVector<int>{8, 9, 0, 1, 7}));
+        // Ping-pong leads back down after the last frame
+        QCOMPARE(SequencePlayback::window(8, 1, 10, true, 3, 5), (QVector<int>{8, 9, 7, 6, 5}));
+        QCOMPARE(SequencePlayback::window(0, -1, 10, true, 3, 5), (QVector<int>{0, 1, 2, 3, 4}));
+    }
+
+    void testWindowBounds() {
+        // Capacity beyond the sequence: every frame once
+        QCOMPARE(SequencePlayback::window(2, 1, 4, false, 2, 100), (QVector<int>{2, 3, 0, 1}));
+        // Out-of-range play head is clamped
+        QCOMPARE(SequencePlayback::window(20, 1, 10, false, 2, 4), (QVector<int>{9, 0, 1, 8}));
+        QCOMPARE(SequencePlayback::window(0, 1, 10, false, 0, 1), (QVector<int>{0}));
+        QVERIFY(SequencePlayback::window(0, 1, 0, false, 3, 5).isEmpty());
+        QVERIFY(SequencePlayback::window(0, 1, 10, false, 3, 0).isEmpty());
+    }
+
+    void testStatsPercentiles() {
+        SequencePlaybackStats stats;
+        stats.reset();
+        QCOMPARE(stats.frameTimePercentile(50), 0.0);
+
+        for (int i = 0; i < 10; ++i) stats.addFrameTime(4.2);
+        stats.addFrameTime(250.0); // beyond the histogram: reported as the max
+        QCOMPARE(stats.displayed, 11);
+        QCOMPARE(stats.frameTimePercentile(50), 5.0);
+        QCOMPARE(stats.frameTimePercentile(90), 5.0);
+        QCOMPARE(stats.frameTimePercentile(95), 250.0);
+        QCOMPARE(stats.frameTimePercentile(100), 250.0);
+        QCOMPARE(stats.frameTimeMaxMs, 250.0);
+
+        stats.dropped = 2;
+        stats.addDecodeTime(10.0);
+        stats.addDecodeTime(20.0);
+        const QString summary = stats.summary(25.0, 0.0);
+        QVERIFY(summary.startsWith("11 frames shown, 2 dropped, 0 late"));
+        QVERIFY(summary.contains("(target 40.0 ms)"));
+        QVERIFY(summary.contains("direct decode 15.0 ms"));
+        QVERIFY(!summary.contains("cache decode"));
+
+        stats.reset();
+        QCOMPARE(stats.displayed, 0);
+        QCOMPARE(stats.frameTimePercentile(99), 0.0);
+    }
+
+    void testStatsWithoutReset() {
+        // A default-constructed run still records frame times
+        SequencePlaybackStats stats;
+        stats.addFrameTime(0.5);
+        stats.addFrameTime(16.9);
+        QCOMPARE(stats.frameTimePercentile(50), 1.0);
+        QCOMPARE(stats.frameTimePercentile(100), 17.0);
+    }
+};
+
+QTEST_GUILESS_MAIN(TestSequencePlayback)
+#include "test_sequence_playback.moc"
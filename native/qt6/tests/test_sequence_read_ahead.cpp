@@ -0,0 +1,86 @@
+#include <QtTest>
+#include <QTemporaryDir>
+#include <QFile>
+#include "../src/sequence_read_ahead.h"
+
+class TestSequenceReadAhead : public QObject {
+    Q_OBJECT
+
+private:
+    QTemporaryDir tempDir;
+
+    QStringList writeFrames(const QString& prefix, int count, int bytes) {
+        QStringList paths;
+        for (int i = 0; i < count; ++i) {
+            const QString path = tempDir.path() + "/" + prefix + QString(".%1.bin").arg(i, 4, 10, QLatin1Char('0'));
+            QFile f(path);
+            if (!f.open(QIODevice::WriteOnly)) return {};
+            f.write(QByteArray(bytes, char('a' + i % 26)));
+            paths << path;
+        }
+        return paths;
+    }
+
+private slots:
+    void testReadFile() {
+        const QStringList frames = writeFrames("read", 1, 3 * 1024 * 1024 + 17);
+        QString error;
+        const QByteArray data = SequenceReadAhead::readFile(frames.first(), &error);
+        QCOMPARE(data.size(), 3 * 1024 * 1024 + 17);
+        QCOMPARE(data.at(0), 'a');
+        QVERIFY(SequenceReadAhead::readFile(tempDir.path() + "/missing.bin", &error).isEmpty());
+        QVERIFY(!error.isEmpty());
+    }
+
+    void testQueuedFramesAreServedFromMemory() {
+        const QStringList frames = writeFrames("queue", 6, 1024);
+        SequenceReadAhead readAhead(2);
+        readAhead.setQueue(frames);
+        QTRY_COMPARE(readAhead.bufferedFrames(), 6);
+        QCOMPARE(readAhead.bufferedBytes(), qint64(6 * 1024));
+
+        const QByteArray third = readAhead.take(frames.at(2));
+        QCOMPARE(third, QByteArray(1024, 'c'));
+        QCOMPARE(readAhead.bufferedFrames(), 5);
+        // Taken frames are not read again while they stay queued
+        readAhead.setQueue(frames);
+        QTest::qWait(50);
+        QCOMPARE(readAhead.bufferedFrames(), 5);
+        QVERIFY(readAhead.take(frames.at(2), 0).isEmpty());
+    }
+
+    void testPoolIsBounded() {
+        const QStringList frames = writeFrames("bounded", 10, 4096);
+        SequenceReadAhead readAhead(2);
+        readAhead.setLimits(1024 * 1024, 3);
+        readAhead.setQueue(frames);
+        QTRY_COMPARE(readAhead.bufferedFrames(), 3);
+        QTest::qWait(50);
+        QCOMPARE(readAhead.bufferedFrames(), 3);
+
+        // Taking a frame makes room for the next one in queue order
+        QVERIFY(!readAhead.take(frames.at(0)).isEmpty());
+        QTRY_COMPARE(readAhead.bufferedFrames(), 3);
+        QVERIFY(!readAhead.take(frames.at(3), 0).isEmpty());
+    }
+
+    void testDroppedAndUnqueuedFrames() {
+        const QStringList frames = writeFrames("drop", 4, 512);
+        SequenceReadAhead readAhead(1);
+        readAhead.setQueue(frames);
+        QTRY_COMPARE(readAhead.bufferedFrames(), 4);
+
+        // Frames that leave the queue are released
+        readAhead.setQueue(frames.mid(2));
+        QCOMPARE(readAhead.bufferedFrames(), 2);
+        QCOMPARE(readAhead.bufferedBytes(), qint64(2 * 512));
+        QVERIFY(readAhead.take(frames.at(0), 0).isEmpty());
+
+        readAhead.clear();
+        QCOMPARE(readAhead.bufferedFrames(), 0);
+        QCOMPARE(readAhead.bufferedBytes(), qint64(0));
+    }
+};
+
+QTEST_GUILESS_MAIN(TestSequenceReadAhead)
+#include "test_sequence_read_ahead.moc"
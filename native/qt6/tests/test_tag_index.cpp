@@ -0,0 +1,130 @@
+#include <QtTest>
+#include <QTemporaryDir>
+#include <QFile>
+#include <QSignalSpy>
+#include <set>
+#include "db.h"
+#include "roaring_bitmap.h"
+#include "tag_index.h"
+
+class TestTagIndex : public QObject {
+    Q_OBJECT
+
+private:
+    QTemporaryDir tempDir;
+
+    int makeAsset(const QString& name) {
+        const QString path = tempDir.path() + "/" + name;
+        QFile f(path);
+        if (!f.open(QIODevice::WriteOnly)) return 0;
+        f.write(name.toUtf8());
+        f.close();
+        return DB::instance().upsertAsset(path);
+    }
+
+    static RoaringBitmap bitmapOf(const QList<int>& ids) {
+        RoaringBitmap b;
+        for (int id : ids) b.add(quint32(id));
+        return b;
+    }
+
+private slots:
+    void initTestCase() {
+        QVERIFY(DB::instance().init(tempDir.path() + "/test.db"));
+    }
+
+    void testRoaringBasics() {
+        RoaringBitmap b;
+        QVERIFY(b.isEmpty());
+        b.add(5);
+        b.add(70000); // second container
+        b.add(5);
+        QCOMPARE(b.cardinality(), qint64(2));
+        QVERIFY(b.contains(5));
+        QVERIFY(b.contains(70000));
+        QVERIFY(!b.contains(6));
+        QCOMPARE(b.toVector(), (QVector<quint32>{5, 70000}));
+        QVERIFY(b.remove(70000));
+        QVERIFY(!b.remove(70000));
+        QCOMPARE(b.toVector(), (QVector<quint32>{5}));
+    }
+
+    void testRoaringDenseContainer() {
+        // Past 4096 entries a container turns into a bitmap and back again when it shrinks
+        RoaringBitmap evens, threes;
+        for (quint32 v = 0; v < 20000; v += 2) evens.add(v);
+        for (quint32 v = 0; v < 20000; v += 3) threes.add(v);
+        QCOMPARE(evens.cardinality(), qint64(10000));
+
+        std::set<quint32> expected;
+        for (quint32 v = 0; v < 20000; v += 6) expected.insert(v);
+        QCOMPARE(evens.andCardinality(threes), qint64(expected.size()));
+        const RoaringBitmap both = evens & threes;
+        QCOMPARE(both.cardinality(), qint64(expected.size()));
+        both.forEach([&](quint32 v) { QVERIFY(expected.count(v)); });
+
+        RoaringBitmap either = evens | threes;
+        QCOMPARE(either.cardinality(), qint64(10000 + 6667 - 3334));
+
+        RoaringBitmap onlyEvens = evens;
+        onlyEvens.andNot(threes);
+        QCOMPARE(onlyEvens.cardinality(), qint64(10000 - 3334));
+        QVERIFY(!onlyEvens.contains(6));
+        QVERIFY(onlyEvens.contains(4));
+
+        // Shrinking back below the array limit must compare equal to a freshly built set
+        RoaringBitmap shrunk = evens;
+        for (quint32 v = 200; v < 20000; v += 2) shrunk.remove(v);
+        RoaringBitmap small;
+        for (quint32 v = 0; v < 200; v += 2) small.add(v);
+        QVERIFY(shrunk == small);
+    }
+
+    void testMatchAndCounts() {
+        DB& db = DB::instance();
+        const int a = makeAsset("a.txt");
+        const int b = makeAsset("b.txt");
+        const int c = makeAsset("c.txt");
+        QVERIFY(a > 0 && b > 0 && c > 0);
+        const int red = db.createTag("red");
+        const int blue = db.createTag("blue");
+        QVERIFY(red > 0 && blue > 0);
+        QVERIFY(db.assignTagsToAssets({a, b}, {red}));
+        QVERIFY(db.assignTagsToAssets({b, c}, {blue}));
+
+        TagIndex& index = TagIndex::instance();
+        QCOMPARE(index.tagId("red"), red);
+        QCOMPARE(index.tagId("missing"), -1);
+
+        const RoaringBitmap scope = bitmapOf({a, b, c});
+        QCOMPARE(index.match(scope, {red, blue}, {}).toVector(), (QVector<quint32>{quint32(b)}));
+        QCOMPARE(index.match(scope, {}, {red, blue}).cardinality(), qint64(3));
+        QCOMPARE(index.match(scope, {red}, {}, {blue}).toVector(), (QVector<quint32>{quint32(a)}));
+        QVERIFY(index.match(bitmapOf({c}), {red}, {}).isEmpty());
+
+        QHash<int, int> counts = index.countsWithin(bitmapOf({a, b}));
+        QCOMPARE(counts.value(red), 2);
+        QCOMPARE(counts.value(blue), 1);
+
+        // Incremental updates from DB notifications
+        QSignalSpy spy(&index, &TagIndex::changed);
+        QVERIFY(db.assignTagsToAssets({c}, {red}));
+        QVERIFY(spy.count() >= 1);
+        QCOMPARE(index.countsWithin(scope).value(red), 3);
+
+        QVERIFY(db.removeAssets({b}));
+        counts = index.countsWithin(scope);
+        QCOMPARE(counts.value(red), 2);
+        QCOMPARE(counts.value(blue), 1);
+        QVERIFY(!index.assetsWithTag(blue).contains(quint32(b)));
+
+        // Tag renames reload the name lookup
+        QVERIFY(db.renameTag(blue, "navy"));
+        QCOMPARE(index.tagId("blue"), -1);
+        QCOMPARE(index.tagId("navy"), blue);
+        QCOMPARE(index.assetsWithTag(blue).toVector(), (QVector<quint32>{quint32(c)}));
+    }
+};
+
+#include "test_tag_index.moc"
+QTEST_MAIN(TestTagIndex)
@@ -0,0 +1,183 @@
+#include <QtTest>
+#include <QTemporaryDir>
+#include <QDir>
+#include <QFile>
+#include <QCryptographicHash>
+#include <QDateTime>
+#include "../src/transfer_scheduler.h"
+#include "file_test_helpers.h"
+
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+using FileTestHelpers::readAll;
+
+class TestTransferScheduler : public QObject {
+    Q_OBJECT
+
+private:
+    QTemporaryDir tempDir;
+
+    QString makeTree(const QString& name, int frames, int subdirs) {
+        const QString root = tempDir.path() + "/" + name;
+        for (int d = 0; d < subdirs; ++d) {
+            const QString dir = root + QString("/shot_%1").arg(d);
+            QDir().mkpath(dir);
+            for (int i = 0; i < frames; ++i) {
+                QFile f(dir + QString("/frame.%1.exr").arg(i, 4, 10, QChar('0')));
+                if (!f.open(QIODevice::WriteOnly)) return QString();
+                f.write(QByteArray(100 + i, char('a' + d)));
+            }
+        }
+        QDir().mkpath(root + "/empty");
+        return root;
+    }
+
+private slots:
+    void testPlanTotals() {
+        const QString src = makeTree("plan_src", 10, 3);
+        const QString dst = tempDir.path() + "/plan_dst";
+        QDir().mkpath(dst);
+        const auto plan = TransferScheduler::planCopy({src}, dst);
+        QVERIFY(plan.error.isEmpty());
+        QCOMPARE(plan.files.size(), 30);
+        qint64 expected = 0;
+        for (int i = 0; i < 10; ++i) expected += 100 + i;
+        QCOMPARE(plan.totalBytes, expected * 3);
+        QCOMPARE(plan.topLevelTargets, QStringList{dst + "/plan_src"});
+        QVERIFY(plan.dirsToCreate.contains(dst + "/plan_src/empty"));
+    }
+
+    void testPlanRejectsCopyIntoSelf() {
+        const QString src = makeTree("self_src", 1, 1);
+        const auto plan = TransferScheduler::planCopy({src}, src + "/shot_0");
+        QVERIFY(!plan.error.isEmpty());
+    }
+
+    void testPlanRenamesOnConflict() {
+        const QString src = makeTree("conflict", 1, 1);
+        const auto plan = TransferScheduler::planCopy({src}, tempDir.path());
+        QCOMPARE(plan.topLevelTargets, QStringList{tempDir.path() + "/conflict (2)"});
+    }
+
+    void testParallelCopy() {
+        const QString src = makeTree("copy_src", 200, 4);
+        const QString dst = tempDir.path() + "/copy_dst";
+        QDir().mkpath(dst);
+        const auto plan = TransferScheduler::planCopy({src}, dst);
+        std::atomic_bool cancel{false};
+        TransferScheduler::Progress last;
+        QString err;
+        QVERIFY2(TransferScheduler::executeCopy(plan, cancel, 8, [&](const TransferScheduler::Progress& p) { last = p; }, &err),
+                 qPrintable(err));
+        QCOMPARE(last.filesDone, 800);
+        QCOMPARE(last.bytesDone, plan.totalBytes);
+        for (const auto& f : plan.files) QCOMPARE(readAll(f.dst), readAll(f.src));
+        QVERIFY(QDir(dst + "/copy_src/empty").exists());
+    }
+
+#ifndef _WIN32
+    void testCrossingDevicePairsShareSlots() {
+        // Devices are taken from the plan: A->B and B->A jobs contend for the same
+        // two devices, with one slot each, and must neither deadlock nor skip files
+        const QString src = makeTree("pairs_src", 50, 2);
+        const QString dst = tempDir.path() + "/pairs_dst";
+        QDir().mkpath(dst);
+        auto plan = TransferScheduler::planCopy({src}, dst);
+        QCOMPARE(plan.files.size(), 100);
+        for (int i = 0; i < plan.files.size(); ++i) {
+            plan.files[i].srcDevice = (i % 2) ? 1 : 2;
+            plan.files[i].dstDevice = (i % 2) ? 2 : 1;
+        }
+        std::atomic_bool cancel{false};
+        QString err;
+        QVERIFY2(TransferScheduler::executeCopy(plan, cancel, 1, {}, &err), qPrintable(err));
+        for (const auto& f : plan.files) QCOMPARE(readAll(f.dst), readAll(f.src));
+    }
+
+    void testCopyRecreatesFolderLinks() {
+        const QString src = makeTree("link_src", 3, 1);
+        QVERIFY(::symlink("shot_0", QFile::encodeName(src + "/shot_link").constData()) == 0);
+        QVERIFY(::symlink("missing", QFile::encodeName(src + "/dangling").constData()) == 0);
+        const QString dst = tempDir.path() + "/link_dst";
+        QDir().mkpath(dst);
+
+        const auto plan = TransferScheduler::planCopy({src}, dst);
+        QVERIFY(plan.error.isEmpty());
+        QCOMPARE(plan.files.size(), 3); // the frames once, not again through the link
+        QCOMPARE(plan.symlinks.size(), 2);
+        std::atomic_bool cancel{false};
+        QString err;
+        QVERIFY2(TransferScheduler::executeCopy(plan, cancel, 4, nullptr, &err), qPrintable(err));
+
+        const QFileInfo link(dst + "/link_src/shot_link");
+        QVERIFY(link.isSymLink());
+        QCOMPARE(QFile::symLinkTarget(link.filePath()), QFileInfo(dst + "/link_src/shot_0").absoluteFilePath());
+        QCOMPARE(QDir(link.filePath()).entryList(QDir::Files).size(), 3);
+        QVERIFY(QFileInfo(dst + "/link_src/dangling").isSymLink());
+    }
+#endif
+
+    void testMoveSameDeviceRenames() {
+        const QString src = makeTree("move_src", 5, 2);
+        const QString dst = tempDir.path() + "/move_dst";
+        QDir().mkpath(dst);
+        std::atomic_bool cancel{false};
+        QString err;
+        QVERIFY2(TransferScheduler::move({src}, dst, cancel, 4, nullptr, &err), qPrintable(err));
+        QVERIFY(!QFileInfo::exists(src));
+        QCOMPARE(QDir(dst + "/move_src/shot_1").entryList(QDir::Files).size(), 5);
+    }
+
+    void testParallelDelete() {
+        const QString root = makeTree("delete_src", 300, 3);
+        const auto plan = TransferScheduler::planDelete({root});
+        QCOMPARE(plan.files.size(), 900);
+        QCOMPARE(plan.dirsToRemove.last(), QFileInfo(root).absoluteFilePath());
+        std::atomic_bool cancel{false};
+        QString err;
+        QVERIFY2(TransferScheduler::executeDelete(plan, cancel, 4, nullptr, &err), qPrintable(err));
+        QVERIFY(!QFileInfo::exists(root));
+    }
+
+    void testVerifiedCopyWritesManifest() {
+        const QString src = makeTree("verify_src", 20, 2);
+        const QString dst = tempDir.path() + "/verify_dst";
+        QDir().mkpath(dst);
+        const auto plan = TransferScheduler::planCopy({src}, dst);
+        std::atomic_bool cancel{false};
+        QVector<TransferScheduler::VerifiedFile> verified;
+        TransferScheduler::Progress last;
+        QString err;
+        QVERIFY2(TransferScheduler::executeVerifiedCopy(plan, cancel, 4, [&](const TransferScheduler::Progress& p) { last = p; },
+                                                        &verified, &err), qPrintable(err));
+        QCOMPARE(verified.size(), 40);
+        QCOMPARE(last.bytesDone, plan.totalBytes * 2);
+        for (const auto& v : verified) {
+            QCOMPARE(v.sha256, QString::fromLatin1(QCryptographicHash::hash(readAll(v.src), QCryptographicHash::Sha256).toHex()));
+            QCOMPARE(readAll(v.dst), readAll(v.src));
+        }
+
+        const QString manifest = TransferScheduler::writeManifest(dst, verified, QDateTime::currentDateTime(), &err);
+        QVERIFY2(!manifest.isEmpty(), qPrintable(err));
+        QVERIFY(manifest.endsWith(".mhl"));
+        const QString xml = QString::fromUtf8(readAll(manifest));
+        QVERIFY(xml.contains("<hashlist version=\"1.1\">"));
+        QCOMPARE(xml.count("<hash>"), 40);
+        QVERIFY(xml.contains("<file>verify_src/shot_1/frame.0019.exr</file>"));
+        QVERIFY(xml.contains(QString("<sha256>%1</sha256>").arg(verified.first().sha256)));
+    }
+
+    void testCancelledCopyStops() {
+        const QString src = makeTree("cancel_src", 50, 1);
+        const QString dst = tempDir.path() + "/cancel_dst";
+        QDir().mkpath(dst);
+        const auto plan = TransferScheduler::planCopy({src}, dst);
+        std::atomic_bool cancel{true};
+        QVERIFY(!TransferScheduler::executeCopy(plan, cancel, 4, nullptr, nullptr));
+    }
+};
+
+QTEST_APPLESS_MAIN(TestTransferScheduler)
+#include "test_transfer_scheduler.moc"
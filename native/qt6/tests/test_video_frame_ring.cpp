@@ -0,0 +1,89 @@
+#include <QtTest>
+#include <QImage>
+#include "../src/media/video_frame_ring.h"
+
+class TestVideoFrameRing : public QObject {
+    Q_OBJECT
+
+private:
+    // 10x10 RGB32: 400 bytes per frame
+    static QImage frame(int shade) {
+        QImage image(10, 10, QImage::Format_RGB32);
+        image.fill(QColor(shade, shade, shade));
+        return image;
+    }
+
+private slots:
+    void testLookupAroundPlayhead() {
+        VideoFrameRing ring;
+        for (int i = 0; i < 10; ++i) QVERIFY(ring.insert(i * 40, frame(i), 360));
+        QCOMPARE(ring.count(), 10);
+        QCOMPARE(ring.bytes(), qint64(10 * 400));
+
+        qint64 ms = 0;
+        QImage image;
+        QVERIFY(ring.frameBefore(200, 20, ms, image));
+        QCOMPARE(ms, qint64(160));
+        QCOMPARE(qRed(image.pixel(0, 0)), 4);
+        // A timestamp a little off the grid still finds its neighbour
+        QVERIFY(ring.frameBefore(201, 20, ms, image));
+        QCOMPARE(ms, qint64(160));
+        QVERIFY(!ring.frameBefore(0, 20, ms, image));
+
+        QVERIFY(ring.frameAfter(200, 20, ms, image));
+        QCOMPARE(ms, qint64(240));
+        QVERIFY(!ring.frameAfter(360, 20, ms, image));
+
+        QVERIFY(ring.contains(121, 20));
+        QVERIFY(!ring.contains(400, 20));
+        QCOMPARE(ring.earliestMs(), qint64(0));
+        QCOMPARE(ring.latestMs(), qint64(360));
+    }
+
+    void testBudgetEvictsFarthestFromPlayhead() {
+        VideoFrameRing ring;
+        ring.setBudgetBytes(4 * 400);
+        QCOMPARE(ring.capacity(QSize(10, 10)), 4);
+
+        // Playhead moving backward from 400: later frames are farther away and go first
+        for (int t = 400; t >= 0; t -= 40) ring.insert(t, frame(t / 40), t);
+        QCOMPARE(ring.count(), 4);
+        QCOMPARE(ring.earliestMs(), qint64(0));
+        QCOMPARE(ring.latestMs(), qint64(120));
+
+        // A frame farther away than everything kept is refused
+        QVERIFY(!ring.insert(2000, frame(1), 0));
+        QCOMPARE(ring.count(), 4);
+        QVERIFY(ring.bytes() <= ring.budgetBytes());
+
+        // Replacing a timestamp does not double count
+        QVERIFY(ring.insert(40, frame(9), 40));
+        QCOMPARE(ring.bytes(), qint64(4 * 400));
+
+        ring.setBudgetBytes(2 * 400);
+        QCOMPARE(ring.count(), 2);
+        QVERIFY(!ring.insert(0, QImage(100, 100, QImage::Format_RGB32), 0)); // larger than the budget
+
+        ring.clear();
+        QCOMPARE(ring.count(), 0);
+        QCOMPARE(ring.bytes(), qint64(0));
+        QCOMPARE(ring.earliestMs(), qint64(-1));
+    }
+
+    void testFrameSize() {
+        const qint64 budget = 512LL * 1024 * 1024;
+        // Fits the display, keeps the aspect ratio
+        QCOMPARE(VideoFrameRing::frameSize(QSize(3840, 2160), QSize(1920, 1200), budget, 24), QSize(1920, 1080));
+        // Never upscaled
+        QCOMPARE(VideoFrameRing::frameSize(QSize(640, 360), QSize(1920, 1080), budget, 24), QSize(640, 360));
+        // A long GOP shrinks frames until the whole GOP fits
+        const QSize small = VideoFrameRing::frameSize(QSize(1920, 1080), QSize(), 64LL * 1024 * 1024, 250);
+        QVERIFY(small.width() < 1920);
+        QVERIFY(qint64(small.width()) * small.height() * 4 * 250 <= 64LL * 1024 * 1024);
+        QCOMPARE(small.width() % 2, 0);
+        QVERIFY(VideoFrameRing::frameSize(QSize(), QSize(100, 100), budget, 24).isEmpty());
+    }
+};
+
+QTEST_GUILESS_MAIN(TestVideoFrameRing)
+#include "test_video_frame_ring.moc"
@@ -0,0 +1,136 @@
+#include <QtTest>
+#include <QTemporaryDir>
+#include <QFile>
+#include <QDateTime>
+#include <vector>
+#include "../src/media/waveform_peaks.h"
+
+class TestWaveformPeaks : public QObject {
+    Q_OBJECT
+
+private:
+    // Four base-level blocks alternating +/-0.2, 0.4, 0.6, 0.8 at 1024 Hz: one second
+    static WaveformPeaks blocks() {
+        WaveformPeakBuilder builder(1024);
+        std::vector<float> samples(WaveformPeaks::kBaseSamplesPerPeak);
+        for (int b = 0; b < 4; ++b) {
+            const float v = 0.2f * (b + 1);
+            for (size_t i = 0; i < samples.size(); ++i) samples[i] = (i % 2) ? -v : v;
+            // Uneven chunks: pairs must not depend on how the decoder splits buffers
+            builder.addSamples(samples.data(), 100);
+            builder.addSamples(samples.data() + 100, qint64(samples.size()) - 100);
+        }
+        return builder.finish();
+    }
+
+    static qint16 full(float v) { return qint16(qRound(v * 32767.0f)); }
+
+private slots:
+    void testPyramid() {
+        const WaveformPeaks peaks = blocks();
+        QVERIFY(peaks.isValid());
+        QCOMPARE(peaks.sampleCount, qint64(1024));
+        QCOMPARE(peaks.durationMs(), qint64(1000));
+        QCOMPARE(peaks.levels.size(), 3);
+        QCOMPARE(peaks.levels[0].size(), 8);
+        QCOMPARE(peaks.levels[1].size(), 4);
+        QCOMPARE(peaks.levels[2].size(), 2);
+        QCOMPARE(peaks.levels[0][2], full(-0.4f));
+        QCOMPARE(peaks.levels[0][3], full(0.4f));
+        QCOMPARE(peaks.levels[1][1], full(0.4f));
+        QCOMPARE(peaks.levels[1][3], full(0.8f));
+        QCOMPARE(peaks.levels[2][0], full(-0.8f));
+        QCOMPARE(peaks.levels[2][1], full(0.8f));
+
+        // A trailing partial block still gets its own pair; out-of-range input clips
+        WaveformPeakBuilder builder(48000);
+        const qint16 loud[3] = {-32768, 12, 32767};
+        const float clipped[2] = {2.0f, -3.0f};
+        builder.addSamples(loud, 3);
+        builder.addSamples(clipped, 2);
+        const WaveformPeaks partial = builder.finish();
+        QCOMPARE(partial.levels.size(), 1);
+        QCOMPARE(partial.levels[0][0], qint16(-32768));
+        QCOMPARE(partial.levels[0][1], qint16(32767));
+        QVERIFY(!WaveformPeakBuilder(48000).finish().isValid());
+    }
+
+    void testRangePicksLevelPerColumn() {
+        const WaveformPeaks peaks = blocks();
+        QCOMPARE(peaks.levelFor(256), 0);
+        QCOMPARE(peaks.levelFor(600), 1);
+        QCOMPARE(peaks.levelFor(1e9), 2);
+
+        const QVector<qint16> four = peaks.range(0, 1000, 4);
+        QCOMPARE(four.size(), 8);
+        for (int c = 0; c < 4; ++c) {
+            QCOMPARE(four[c * 2], full(-0.2f * (c + 1)));
+            QCOMPARE(four[c * 2 + 1], full(0.2f * (c + 1)));
+        }
+        const QVector<qint16> one = peaks.range(0, 1000, 1);
+        QCOMPARE(one[0], full(-0.8f));
+        QCOMPARE(one[1], full(0.8f));
+
+        // Zoomed into the second half; columns past the end stay silent
+        const QVector<qint16> tail = peaks.range(500, 1500, 2);
+        QCOMPARE(tail[1], full(0.8f));
+        QCOMPARE(tail[2], qint16(0));
+        QCOMPARE(tail[3], qint16(0));
+
+        // Zoomed in far beyond the base level: neighbouring columns share a pair
+        const QVector<qint16> zoomed = peaks.range(0, 10, 8);
+        QCOMPARE(zoomed[1], full(0.2f));
+        QCOMPARE(zoomed[15], full(0.2f));
+
+        QVERIFY(WaveformPeaks().range(0, 1000, 4).size() == 8);
+        QCOMPARE(peaks.range(1000, 0, 4).at(1), qint16(0));
+    }
+
+    void testSaveLoadAndInvalidation() {
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        const QString source = dir.filePath("clip.mov");
+        {
+            QFile f(source);
+            QVERIFY(f.open(QIODevice::WriteOnly));
+            f.write(QByteArray(64, 'x'));
+        }
+        const QFileInfo fi(source);
+        WaveformPeaks peaks = blocks();
+        peaks.sourceSize = fi.size();
+        peaks.sourceMtimeMs = fi.lastModified().toMSecsSinceEpoch();
+        QVERIFY(peaks.matches(source));
+
+        const QString peakPath = dir.filePath("cache/clip.peaks");
+        QString error;
+        QVERIFY2(peaks.save(peakPath, &error), qPrintable(error));
+
+        WaveformPeaks loaded;
+        QVERIFY2(WaveformPeaks::load(peakPath, source, loaded, &error), qPrintable(error));
+        QCOMPARE(loaded.sampleRate, 1024);
+        QCOMPARE(loaded.sampleCount, qint64(1024));
+        QCOMPARE(loaded.levels, peaks.levels);
+
+        // Same size, new mtime: stale
+        {
+            QFile f(source);
+            QVERIFY(f.open(QIODevice::ReadWrite));
+            QVERIFY(f.setFileTime(fi.lastModified().addSecs(10), QFileDevice::FileModificationTime));
+        }
+        QVERIFY(!WaveformPeaks::load(peakPath, source, loaded, &error));
+        QVERIFY(!loaded.isValid());
+        // Without a source to check, the file still reads
+        QVERIFY(WaveformPeaks::load(peakPath, QString(), loaded));
+
+        // Garbage is rejected
+        {
+            QFile f(peakPath);
+            QVERIFY(f.open(QIODevice::WriteOnly));
+            f.write("not a peak file");
+        }
+        QVERIFY(!WaveformPeaks::load(peakPath, QString(), loaded, &error));
+    }
+};
+
+QTEST_GUILESS_MAIN(TestWaveformPeaks)
+#include "test_waveform_peaks.moc"